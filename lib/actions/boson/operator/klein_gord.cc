@@ -5,6 +5,8 @@
 #include "chromabase.h"
 #include "actions/boson/operator/klein_gord.h"
 
+#include <cstring>
+
 
 namespace Chroma
 {
@@ -50,13 +52,420 @@ namespace Chroma
   }
 
 
+#ifndef QDP_IS_QDPJIT
+  // Utility functions
+  namespace
+  {
+    //! Where the color vectors of a site sit in a field
+    /*!
+     * A site of the field holds site_reals reals. Column j is a color
+     * vector whose color c starts at base[j] + c*cstride, real then imag.
+     */
+    struct ColumnLayout
+    {
+      int               site_reals;
+      int               cstride;
+      std::vector<int>  base;
+    };
+
+    ColumnLayout columns(const LatticeColorVector*)
+    {
+      ColumnLayout lay;
+      lay.site_reals = 2*Nc;
+      lay.cstride = 2;
+      lay.base.push_back(0);
+      return lay;
+    }
+
+    ColumnLayout columns(const LatticeFermion*)
+    {
+      ColumnLayout lay;
+      lay.site_reals = 2*Nc*Ns;
+      lay.cstride = 2;
+      for(int s=0; s < Ns; ++s)
+	lay.base.push_back(2*Nc*s);
+      return lay;
+    }
+
+    ColumnLayout columns(const LatticeStaggeredPropagator*)
+    {
+      ColumnLayout lay;
+      lay.site_reals = 2*Nc*Nc;
+      lay.cstride = 2*Nc;
+      for(int c2=0; c2 < Nc; ++c2)
+	lay.base.push_back(2*c2);
+      return lay;
+    }
+
+    ColumnLayout columns(const LatticePropagator*)
+    {
+      ColumnLayout lay;
+      lay.site_reals = 2*Nc*Nc*Ns*Ns;
+      lay.cstride = 2*Nc;
+      for(int s=0; s < Ns*Ns; ++s)
+	for(int c2=0; c2 < Nc; ++c2)
+	  lay.base.push_back(2*Nc*Nc*s + 2*c2);
+      return lay;
+    }
+
+
+    //! Sites whose neighbour one step along sign*mu is on another node
+    class FaceFunc : public SetFunc
+    {
+    public:
+      FaceFunc(int mu_, int sign_) : mu(mu_), sign(sign_) {}
+
+      int operator() (const multi1d<int>& coordinate) const
+      {
+	const multi1d<int>& nrow = Layout::lattSize();
+	multi1d<int> nb = coordinate;
+	nb[mu] = (coordinate[mu] + sign + nrow[mu]) % nrow[mu];
+
+	return (Layout::nodeNumber(nb) != Layout::nodeNumber(coordinate)) ? 1 : 0;
+      }
+
+      int numSubsets() const {return 2;}
+
+    private:
+      FaceFunc() {}  // hide default constructor
+
+      int mu;
+      int sign;
+    };
+
+
+    //! Neighbour tables of the sites on this node
+    /*!
+     * A neighbour on this node is given by its site index. One on another
+     * node is given as -1-k, where k is the position of the site in the
+     * site table of subset 1 of the face set, which is where its values
+     * are found after the faces are gathered.
+     */
+    struct Neighbours
+    {
+      multi1d<int>                 nrow;      /*!< the layout the tables were built for */
+      multi1d<int>                 subgrid;
+      int                          node;
+
+      multi1d< std::vector<int> >  fwd;       /*!< site of x+mu */
+      multi1d< std::vector<int> >  bwd;       /*!< site of x-mu */
+      multi1d<bool>                split;     /*!< some neighbour in mu is on another node, on any node */
+      multi1d<Set>                 fwd_face;  /*!< subset 1 holds the sites whose x+mu is on another node */
+      multi1d<Set>                 bwd_face;  /*!< subset 1 holds the sites whose x-mu is on another node */
+    };
+
+    //! Were the tables built for the current layout?
+    bool sameLayout(const Neighbours& nb)
+    {
+      if (nb.nrow.size() != Nd || nb.node != Layout::nodeNumber())
+	return false;
+
+      for(int mu=0; mu < Nd; ++mu)
+	if (nb.nrow[mu] != Layout::lattSize()[mu] || nb.subgrid[mu] != Layout::subgridLattSize()[mu])
+	  return false;
+
+      return true;
+    }
+
+    //! Position of each site in the site table of a subset, -1 if not in it
+    std::vector<int> sitePositions(const Subset& sub)
+    {
+      std::vector<int> pos(Layout::sitesOnNode(), -1);
+      const int* tab = sub.siteTable().slice();
+
+      for(int k=0; k < sub.numSiteTable(); ++k)
+	pos[tab[k]] = k;
+
+      return pos;
+    }
+
+    //! The tables of the current layout, rebuilt whenever the layout changes
+    const Neighbours& neighbours()
+    {
+      static Neighbours nb;
+
+      if (! sameLayout(nb))
+      {
+	const int nsites = Layout::sitesOnNode();
+	const int node   = Layout::nodeNumber();
+	const multi1d<int>& nrow = Layout::lattSize();
+
+	nb.nrow    = nrow;
+	nb.subgrid = Layout::subgridLattSize();
+	nb.node    = node;
+
+	nb.fwd.resize(Nd);
+	nb.bwd.resize(Nd);
+	nb.split.resize(Nd);
+	nb.fwd_face.resize(Nd);
+	nb.bwd_face.resize(Nd);
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  nb.fwd_face[mu].make(FaceFunc(mu, +1));
+	  nb.bwd_face[mu].make(FaceFunc(mu, -1));
+
+	  const std::vector<int> fk = sitePositions(nb.fwd_face[mu][1]);
+	  const std::vector<int> bk = sitePositions(nb.bwd_face[mu][1]);
+
+	  nb.fwd[mu].resize(nsites);
+	  nb.bwd[mu].resize(nsites);
+
+	  for(int site=0; site < nsites; ++site)
+	  {
+	    multi1d<int> coord = Layout::siteCoords(node, site);
+	    multi1d<int> cf = coord;
+	    multi1d<int> cb = coord;
+	    cf[mu] = (coord[mu] + 1) % nrow[mu];
+	    cb[mu] = (coord[mu] - 1 + nrow[mu]) % nrow[mu];
+
+	    nb.fwd[mu][site] = (fk[site] >= 0) ? -1 - fk[site] : Layout::linearSiteIndex(cf);
+	    nb.bwd[mu][site] = (bk[site] >= 0) ? -1 - bk[site] : Layout::linearSiteIndex(cb);
+	  }
+
+	  // Every node must take part in the same face gathers
+	  int off = (nb.fwd_face[mu][1].numSiteTable() + nb.bwd_face[mu][1].numSiteTable() > 0) ? 1 : 0;
+	  QDPInternal::globalSum(off);
+	  nb.split[mu] = (off > 0);
+	}
+      }
+
+      return nb;
+    }
+
+
+    //! Copy the sites of a face out of a field, in site table order
+    template<typename T>
+    void packFace(std::vector<REAL>& buf, const T& field, const Subset& face, int site_reals)
+    {
+      const int* tab = face.siteTable().slice();
+      buf.resize(size_t(site_reals)*face.numSiteTable());
+
+      for(int k=0; k < face.numSiteTable(); ++k)
+	memcpy(&buf[size_t(site_reals)*k], &(field.elem(tab[k])), site_reals*sizeof(REAL));
+    }
+
+    //! Start of a face buffer, null if this node has no sites on the face
+    const REAL* faceData(const std::vector<REAL>& buf)
+    {
+      return buf.empty() ? 0 : &buf[0];
+    }
+
+
+    struct KleinGordArgs
+    {
+      const REAL* const*   u;       /*!< the links of each direction */
+      const REAL* const*   u_bwd;   /*!< U_mu(x-mu) for the backward face of each direction */
+      const REAL* const*   psi;     /*!< the source fields */
+      const REAL* const*   psi_fwd; /*!< psi(x+mu) on the forward faces, [mu*nfield + field] */
+      const REAL* const*   psi_bwd; /*!< psi(x-mu) on the backward faces, [mu*nfield + field] */
+      REAL* const*         chi;     /*!< the result fields */
+      int                  nfield;
+      const ColumnLayout*  lay;
+      const int* const*    fwd;
+      const int* const*    bwd;
+      const int*           dirs;    /*!< the directions of the hopping term */
+      int                  ndir;
+      REAL                 diag;
+    };
+
+    //! The operator on the sites [lo,hi) of every field of the block
+    /*! Each pair of links is loaded once and applied to all the columns of all the fields */
+    void kleinGordSiteLoop(int lo, int hi, int my_id, KleinGordArgs* a)
+    {
+      const int ncol = a->lay->base.size();
+      const int cs   = a->lay->cstride;
+      const int sr   = a->lay->site_reals;
+      const int nvec = a->nfield * ncol;
+
+      std::vector<REAL> out(2*Nc*nvec);
+      REAL uf[Nc][Nc][2], ub[Nc][Nc][2];
+
+      for(int site=lo; site < hi; ++site)
+      {
+	for(int f=0; f < a->nfield; ++f)
+	  for(int j=0; j < ncol; ++j)
+	  {
+	    const REAL* p = a->psi[f] + size_t(sr)*site + a->lay->base[j];
+	    REAL* o = &out[2*Nc*(f*ncol + j)];
+	    for(int c=0; c < Nc; ++c)
+	    {
+	      o[2*c]   = a->diag * p[c*cs];
+	      o[2*c+1] = a->diag * p[c*cs+1];
+	    }
+	  }
+
+	for(int d=0; d < a->ndir; ++d)
+	{
+	  const int mu = a->dirs[d];
+	  const int xp = a->fwd[mu][site];
+	  const int xm = a->bwd[mu][site];
+
+	  memcpy(uf, a->u[mu] + size_t(2*Nc*Nc)*site, sizeof(uf));
+
+	  if (xm >= 0)
+	    memcpy(ub, a->u[mu] + size_t(2*Nc*Nc)*xm, sizeof(ub));
+	  else
+	    memcpy(ub, a->u_bwd[mu] + size_t(2*Nc*Nc)*(-1-xm), sizeof(ub));
+
+	  for(int f=0; f < a->nfield; ++f)
+	  {
+	    // The neighbours, on this node or from the gathered faces
+	    const REAL* pp = (xp >= 0) ? a->psi[f] + size_t(sr)*xp
+	                               : a->psi_fwd[mu*a->nfield + f] + size_t(sr)*(-1-xp);
+	    const REAL* qq = (xm >= 0) ? a->psi[f] + size_t(sr)*xm
+	                               : a->psi_bwd[mu*a->nfield + f] + size_t(sr)*(-1-xm);
+
+	    for(int j=0; j < ncol; ++j)
+	    {
+	      const REAL* p = pp + a->lay->base[j];
+	      const REAL* q = qq + a->lay->base[j];
+	      REAL* o = &out[2*Nc*(f*ncol + j)];
+
+	      // o -= U_mu(x) psi(x+mu) + U_mu(x-mu)^dag psi(x-mu)
+	      for(int i=0; i < Nc; ++i)
+	      {
+		REAL re = 0, im = 0;
+		for(int k=0; k < Nc; ++k)
+		{
+		  re += uf[i][k][0]*p[k*cs] - uf[i][k][1]*p[k*cs+1];
+		  im += uf[i][k][0]*p[k*cs+1] + uf[i][k][1]*p[k*cs];
+		  re += ub[k][i][0]*q[k*cs] + ub[k][i][1]*q[k*cs+1];
+		  im += ub[k][i][0]*q[k*cs+1] - ub[k][i][1]*q[k*cs];
+		}
+		o[2*i]   -= re;
+		o[2*i+1] -= im;
+	      }
+	    }
+	  }
+	}
+
+	for(int f=0; f < a->nfield; ++f)
+	  for(int j=0; j < ncol; ++j)
+	  {
+	    REAL* p = a->chi[f] + size_t(sr)*site + a->lay->base[j];
+	    const REAL* o = &out[2*Nc*(f*ncol + j)];
+	    for(int c=0; c < Nc; ++c)
+	    {
+	      p[c*cs]   = o[2*c];
+	      p[c*cs+1] = o[2*c+1];
+	    }
+	  }
+      }
+    }
+
+
+    //! The fused operator on a block of fields
+    /*!
+     * For a direction split across nodes the faces are gathered once per
+     * application, before the site loop: the links behind the backward face,
+     * and each field of the block beyond both faces. Only the face sites are
+     * shifted and kept.
+     */
+    template<typename T>
+    void kleinGordBlock(const multi1d<LatticeColorMatrix>& u, 
+			const std::vector<const T*>& psi,
+			const std::vector<T*>& chi,
+			const Real& mass_sq, int j_decay)
+    {
+      const Neighbours& nb = neighbours();
+      const int nfield = psi.size();
+
+      std::vector<int> dirs;
+      for(int mu=0; mu < Nd; ++mu)
+	if (mu != j_decay)
+	  dirs.push_back(mu);
+
+      if (nfield == 0)
+	return;
+
+      ColumnLayout lay = columns((const T*)0);
+
+      // Face buffers: the links, then the fields beyond the forward and the backward faces
+      std::vector< std::vector<REAL> > u_face(Nd), fwd_face(Nd*nfield), bwd_face(Nd*nfield);
+
+      for(int d=0; d < dirs.size(); ++d)
+      {
+	const int mu = dirs[d];
+	if (! nb.split[mu])
+	  continue;
+
+	const Subset& ff = nb.fwd_face[mu][1];
+	const Subset& bf = nb.bwd_face[mu][1];
+
+	LatticeColorMatrix u_tmp;
+	u_tmp[bf] = shift(u[mu], BACKWARD, mu);
+	packFace(u_face[mu], u_tmp, bf, 2*Nc*Nc);
+
+	T tmp;
+	for(int f=0; f < nfield; ++f)
+	{
+	  tmp[ff] = shift(*psi[f], FORWARD, mu);
+	  packFace(fwd_face[mu*nfield + f], tmp, ff, lay.site_reals);
+
+	  tmp[bf] = shift(*psi[f], BACKWARD, mu);
+	  packFace(bwd_face[mu*nfield + f], tmp, bf, lay.site_reals);
+	}
+      }
+
+      std::vector<const REAL*> u_ptr(Nd), u_bwd(Nd), psi_ptr(nfield);
+      std::vector<const REAL*> psi_fwd(Nd*nfield), psi_bwd(Nd*nfield);
+      std::vector<REAL*> chi_ptr(nfield);
+      std::vector<const int*> fwd(Nd), bwd(Nd);
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	u_ptr[mu] = (const REAL*)&(u[mu].elem(0));
+	u_bwd[mu] = faceData(u_face[mu]);
+	fwd[mu] = &(nb.fwd[mu][0]);
+	bwd[mu] = &(nb.bwd[mu][0]);
+
+	for(int f=0; f < nfield; ++f)
+	{
+	  psi_fwd[mu*nfield + f] = faceData(fwd_face[mu*nfield + f]);
+	  psi_bwd[mu*nfield + f] = faceData(bwd_face[mu*nfield + f]);
+	}
+      }
+      for(int f=0; f < nfield; ++f)
+      {
+	psi_ptr[f] = (const REAL*)&(psi[f]->elem(0));
+	chi_ptr[f] = (REAL*)&(chi[f]->elem(0));
+      }
+
+      // The same diagonal term as the template above
+      REAL diag = toDouble(mass_sq) + ((j_decay < Nd) ? 2*Nd-2 : 2*Nd);
+
+      KleinGordArgs args = {&(u_ptr[0]), &(u_bwd[0]), &(psi_ptr[0]), &(psi_fwd[0]), &(psi_bwd[0]),
+			    &(chi_ptr[0]), nfield, &lay,
+			    &(fwd[0]), &(bwd[0]), (dirs.size() > 0) ? &(dirs[0]) : 0, int(dirs.size()), diag};
+      dispatch_to_threads(Layout::sitesOnNode(), args, kleinGordSiteLoop);
+    }
+
+    //! The fused operator on one field
+    template<typename T>
+    void kleinGordFused(const multi1d<LatticeColorMatrix>& u, 
+			const T& psi, T& chi,
+			const Real& mass_sq, int j_decay)
+    {
+      std::vector<const T*> p(1, &psi);
+      std::vector<T*> c(1, &chi);
+      kleinGordBlock(u, p, c, mass_sq, j_decay);
+    }
+  }
+#endif
+
+
   //! Compute the covariant Klein-Gordon operator on a color std::vector
   void klein_gord(const multi1d<LatticeColorMatrix>& u, 
 		  const LatticeColorVector& psi, 
 		  LatticeColorVector& chi, 
 		  const Real& mass_sq, int j_decay)
   {
+#ifndef QDP_IS_QDPJIT
+    kleinGordFused(u, psi, chi, mass_sq, j_decay);
+#else
     klein_gord<LatticeColorVector>(u, psi, chi, mass_sq, j_decay);
+#endif
   }
 
   //! Compute the covariant Klein-Gordon operator on a color std::vector
@@ -65,7 +474,11 @@ namespace Chroma
 		  LatticeFermion& chi, 
 		  const Real& mass_sq, int j_decay)
   {
+#ifndef QDP_IS_QDPJIT
+    kleinGordFused(u, psi, chi, mass_sq, j_decay);
+#else
     klein_gord<LatticeFermion>(u, psi, chi, mass_sq, j_decay);
+#endif
   }
 
   //! Compute the covariant Klein-Gordon operator on a propagator
@@ -74,7 +487,11 @@ namespace Chroma
 		  LatticeStaggeredPropagator& chi, 
 		  const Real& mass_sq, int j_decay)
   {
+#ifndef QDP_IS_QDPJIT
+    kleinGordFused(u, psi, chi, mass_sq, j_decay);
+#else
     klein_gord<LatticeStaggeredPropagator>(u, psi, chi, mass_sq, j_decay);
+#endif
   }
 
   //! Compute the covariant Klein-Gordon operator on a propagator
@@ -83,7 +500,35 @@ namespace Chroma
 		  LatticePropagator& chi, 
 		  const Real& mass_sq, int j_decay)
   {
+#ifndef QDP_IS_QDPJIT
+    kleinGordFused(u, psi, chi, mass_sq, j_decay);
+#else
     klein_gord<LatticePropagator>(u, psi, chi, mass_sq, j_decay);
+#endif
+  }
+
+  //! Compute the covariant Klein-Gordon operator on a block of color vectors
+  void klein_gord(const multi1d<LatticeColorMatrix>& u, 
+		  const multi1d<LatticeColorVector>& psi, 
+		  multi1d<LatticeColorVector>& chi, 
+		  const Real& mass_sq, int j_decay)
+  {
+    chi.resize(psi.size());
+
+#ifndef QDP_IS_QDPJIT
+    std::vector<const LatticeColorVector*> p(psi.size());
+    std::vector<LatticeColorVector*> c(psi.size());
+    for(int n=0; n < psi.size(); ++n)
+    {
+      p[n] = &psi[n];
+      c[n] = &chi[n];
+    }
+
+    kleinGordBlock(u, p, c, mass_sq, j_decay);
+#else
+    for(int n=0; n < psi.size(); ++n)
+      klein_gord<LatticeColorVector>(u, psi[n], chi[n], mass_sq, j_decay);
+#endif
   }
 
 }
@@ -36,6 +36,17 @@ namespace Chroma
 		  const LatticePropagator& psi, 
 		  LatticePropagator& chi, 
 		  const Real& mass_sq, int j_decay);
+
+  //! Klein-Gordon operator on a block of color vectors
+  /*! @ingroup boson
+   *
+   * Each link is loaded once per site and applied to every vector of the
+   * block. chi must not share fields with psi.
+   */
+  void klein_gord(const multi1d<LatticeColorMatrix>& u, 
+		  const multi1d<LatticeColorVector>& psi, 
+		  multi1d<LatticeColorVector>& chi, 
+		  const Real& mass_sq, int j_decay);
 }
 
 
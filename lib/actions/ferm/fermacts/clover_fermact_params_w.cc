@@ -20,6 +20,7 @@ namespace Chroma
     max_norm_usedP=false;
     twisted_m_usedP = false;
     twisted_m = Real(0);
+    soa_layoutP = false;
 
   }
 
@@ -96,6 +97,13 @@ namespace Chroma
       twisted_m_usedP = false;
     }
 
+    if( paramtop.count("SoALayout") != 0 ) {
+      read(paramtop, "SoALayout", soa_layoutP);
+    }
+    else {
+      soa_layoutP = false;
+    }
+
   }
 
   //! Read parameters
@@ -133,6 +141,10 @@ namespace Chroma
       write(xml, "TwistedM", param.twisted_m);
     }
 
+    if (param.soa_layoutP) {
+      write(xml, "SoALayout", param.soa_layoutP);
+    }
+
     pop(xml);
   }
 
@@ -32,6 +32,9 @@ namespace Chroma
     Real twisted_m;
     bool twisted_m_usedP;
 
+    // Optional site blocked (SoA) storage for the QDP clover term
+    bool soa_layoutP;
+
   };
 
 
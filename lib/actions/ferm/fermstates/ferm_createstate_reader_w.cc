@@ -4,6 +4,8 @@
 
 #include "chromabase.h"
 
+#include <map>
+
 #include "actions/ferm/fermstates/simple_fermstate.h"
 #include "actions/ferm/fermstates/simple_fermstate_w.h"
 #include "actions/ferm/fermstates/ferm_createstate_factory_w.h"
@@ -16,6 +18,31 @@ namespace Chroma
   // State reader
   namespace CreateFermStateEnv
   {
+    //! Anonymous namespace
+    namespace
+    {
+      typedef CreateFermState<LatticeFermion,
+			      multi1d<LatticeColorMatrix>, 
+			      multi1d<LatticeColorMatrix> >  CFS;
+
+      //! Every creator made by the reader, keyed on its params
+      /*! Never destroyed, so the creator addresses stay unique */
+      std::map< std::string, Handle<CFS> >& theCreators()
+      {
+	static std::map< std::string, Handle<CFS> >* creators = new std::map< std::string, Handle<CFS> >;
+	return *creators;
+      }
+
+      //! The xml of a group as a std::string
+      std::string groupXML(XMLReader& top, const std::string& path)
+      {
+	XMLReader xml_tmp(top, path);
+	std::ostringstream os;
+	xml_tmp.print(os);
+	return os.str();
+      }
+    }
+
 
     // Helper function for the FermAction readers
     Handle< CreateFermState<LatticeFermion,
@@ -27,10 +54,12 @@ namespace Chroma
 
       std::string fermstate;
       std::string fermstate_path;
+      std::string key;
       if (top.count("FermState") != 0)
       {
 	fermstate_path = "FermState";
 	read(top, fermstate_path + "/Name", fermstate);
+	key = groupXML(top, fermstate_path);
       }
       else
       {
@@ -39,17 +68,39 @@ namespace Chroma
 
 	fermstate_path = ".";
 	fermstate = Chroma::CreateSimpleFermStateEnv::name;
+	key = (top.count("FermionBC") != 0) ? groupXML(top, "FermionBC") : groupXML(top, ".");
       }
 
-      Handle< CreateFermState<
-	LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > 
-	cgs(TheCreateFermStateFactory::Instance().createObject(fermstate,
-							       top,
-							       fermstate_path));
+      // Actions with the same state params share one creator
+      key = fermstate + "\n" + key;
+
+      std::map< std::string, Handle<CFS> >::const_iterator it = theCreators().find(key);
+      if (it != theCreators().end())
+	return it->second;
+
+      Handle<CFS> cgs(TheCreateFermStateFactory::Instance().createObject(fermstate,
+									  top,
+									  fermstate_path));
+      theCreators()[key] = cgs;
 
       return cgs;
     }
 
+
+    // Is this creator shared by all actions with its params
+    bool isShared(const CreateFermState<LatticeFermion,
+		                        multi1d<LatticeColorMatrix>, 
+		                        multi1d<LatticeColorMatrix> >& cfs)
+    {
+      for(std::map< std::string, Handle<CFS> >::const_iterator it = theCreators().begin();
+	  it != theCreators().end(); ++it)
+      {
+	if (&(*(it->second)) == &cfs)
+	  return true;
+      }
+      return false;
+    }
+
   }
 
 } // end chroma namespace
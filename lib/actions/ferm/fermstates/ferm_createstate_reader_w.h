@@ -20,6 +20,16 @@ namespace Chroma
 			     multi1d<LatticeColorMatrix>, 
 			     multi1d<LatticeColorMatrix> > > reader(XMLReader& xml_in, 
 								    const std::string& path);
+
+    //! Is this creator shared by all actions with its params
+    /*! 
+     * The reader hands out one creator per distinct set of state params
+     * and keeps it for the rest of the run, so the states such a
+     * creator makes can be shared between actions.
+     */
+    bool isShared(const CreateFermState< LatticeFermion,
+		                         multi1d<LatticeColorMatrix>, 
+		                         multi1d<LatticeColorMatrix> >& cfs);
   }
 
 }
@@ -0,0 +1,92 @@
+/*! \file
+ *  \brief Cache of fermion states shared between HMC monomials
+ */
+
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
+#include "actions/ferm/fermstates/ferm_createstate_reader_w.h"
+
+namespace Chroma
+{
+
+  // Empty cache
+  FermStateCache::FermStateCache() : version(0)
+  {
+    resetStats();
+  }
+
+
+  // State of an action on the gauge field q which has the given version
+  Handle< FermState<FermStateCache::T,FermStateCache::P,FermStateCache::Q> >
+  FermStateCache::createState(const FermionAction<T,P,Q>& S_f,
+			      const Q& q, unsigned long version_)
+  {
+    const CreateFermState<T,P,Q>& cfs = S_f.getCreateState();
+
+    // Only creators from the reader are shared; other actions
+    // (e.g. overlap) build their own kind of state
+    if (! CreateFermStateEnv::isShared(cfs))
+      return Handle< FermState<T,P,Q> >(S_f.createState(q));
+
+    if (version_ != version)
+    {
+      flush();
+      version = version_;
+    }
+
+    std::map< const CreateFermState<T,P,Q>*, Handle< FermState<T,P,Q> > >::const_iterator it = states.find(&cfs);
+    if (it != states.end())
+    {
+      ++state_hits;
+      return it->second;
+    }
+
+    ++state_misses;
+    Handle< FermState<T,P,Q> > fs(S_f.createState(q));
+    states[&cfs] = fs;
+
+    return fs;
+  }
+
+
+  // Count a lookup of data attached to a state
+  void FermStateCache::countAttachment(bool hit)
+  {
+    if (hit)
+      ++attach_hits;
+    else
+      ++attach_misses;
+  }
+
+
+  // Drop all states
+  void FermStateCache::flush()
+  {
+    states.clear();
+  }
+
+
+  // Write the hit/miss statistics
+  void FermStateCache::writeStats(XMLWriter& xml, const std::string& path) const
+  {
+    push(xml, path);
+    write(xml, "StateHits", state_hits);
+    write(xml, "StateMisses", state_misses);
+    write(xml, "AttachmentHits", attach_hits);
+    write(xml, "AttachmentMisses", attach_misses);
+    pop(xml);
+
+    QDPIO::cout << "FERMSTATE_CACHE: states " << state_hits << " hits " << state_misses << " misses"
+		<< ", attachments " << attach_hits << " hits " << attach_misses << " misses" << std::endl;
+  }
+
+
+  // Reset the statistics
+  void FermStateCache::resetStats()
+  {
+    state_hits = 0;
+    state_misses = 0;
+    attach_hits = 0;
+    attach_misses = 0;
+  }
+
+}
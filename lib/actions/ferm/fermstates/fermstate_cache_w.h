@@ -0,0 +1,88 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Cache of fermion states shared between HMC monomials
+ */
+
+#ifndef __fermstate_cache_w_h__
+#define __fermstate_cache_w_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "state.h"
+#include "fermact.h"
+#include "singleton.h"
+
+#include <map>
+
+namespace Chroma
+{
+
+  //! Cache of fermion states shared between HMC monomials
+  /*! @ingroup fermstates
+   *
+   * Several monomials usually use actions with the same state params,
+   * e.g. the pieces of a Hasenbusch chain, and each of them makes its
+   * state from the same gauge field at every force evaluation. For
+   * smeared states that repeats all the smearing.
+   *
+   * Actions whose state creator came from CreateFermStateEnv::reader
+   * share the creator when their state params agree. This cache keeps
+   * one state per shared creator for the current version of the gauge
+   * field (see AbsFieldState::getQVersion) and drops them all when the
+   * version changes. Data linear operators attach to the states, e.g.
+   * clover terms, is reused along with them.
+   */
+  class FermStateCache
+  {
+  public:
+    typedef LatticeFermion               T;
+    typedef multi1d<LatticeColorMatrix>  P;
+    typedef multi1d<LatticeColorMatrix>  Q;
+
+    //! Empty cache
+    FermStateCache();
+
+    //! State of an action on the coordinates of a field state
+    template<typename S>
+    Handle< FermState<T,P,Q> > createState(const FermionAction<T,P,Q>& S_f, const S& s)
+    {
+      return createState(S_f, s.getQ(), s.getQVersion());
+    }
+
+    //! State of an action on the gauge field q which has the given version
+    Handle< FermState<T,P,Q> > createState(const FermionAction<T,P,Q>& S_f,
+					   const Q& q, unsigned long version);
+
+    //! Count a lookup of data attached to a state
+    void countAttachment(bool hit);
+
+    //! Drop all states
+    void flush();
+
+    //! Write the hit/miss statistics since the last reset
+    void writeStats(XMLWriter& xml, const std::string& path) const;
+
+    //! Reset the statistics
+    void resetStats();
+
+  private:
+    unsigned long version;
+    std::map< const CreateFermState<T,P,Q>*, Handle< FermState<T,P,Q> > > states;
+
+    int state_hits;
+    int state_misses;
+    int attach_hits;
+    int attach_misses;
+  };
+
+
+  //! The fermion state cache
+  /*! @ingroup fermstates */
+  typedef SingletonHolder<FermStateCache,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheFermStateCache;
+
+}
+
+#endif
@@ -89,7 +89,8 @@ namespace Chroma
       
       for(int level=params.n_smear; level > 0; level--) {
 	
-	Stouting::deriv_recurse(F_thin, params.smear_in_this_dirP, params.rho, smeared_links[level-1]);
+	Stouting::deriv_recurse(F_thin, params.smear_in_this_dirP, params.rho, smeared_links[level-1],
+				smear_data[level-1]);
 	
 	fbc->zero(F_thin);
 	
@@ -148,6 +149,7 @@ namespace Chroma
       for(int i=0; i <= params.n_smear; i++) { 
 	smeared_links[i].resize(Nd);
       }
+      smear_data.resize(params.n_smear);
       
       
       // Copy thin links into smeared_links[0]
@@ -162,7 +164,8 @@ namespace Chroma
       // Iterate up the smearings
       for(int i=1; i <= params.n_smear; i++) {
 	
-	Stouting::smear_links(smeared_links[i-1], smeared_links[i], params.smear_in_this_dirP, params.rho);
+	Stouting::smear_links(smeared_links[i-1], smeared_links[i], params.smear_in_this_dirP, params.rho,
+			      smear_data[i-1]);
 	if( fbc->nontrivialP() ) {
 	  fbc->modify( smeared_links[i] );    
 	}
@@ -185,6 +188,9 @@ namespace Chroma
     // smeared_links[0] are the thin links smeared_links[params.n_smear] 
     // are the smeared links.
     multi1d< Q > smeared_links;
+
+    // smear_data[i] is what smearing smeared_links[i] left for the force
+    multi1d<Stouting::StoutLevelData> smear_data;
     Q fat_links_with_bc;
     
     
@@ -0,0 +1,289 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Small dense helpers for the block Krylov solvers
+ */
+
+#ifndef __block_krylov_h__
+#define __block_krylov_h__
+
+#include "chromabase.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Helpers shared by the block Krylov solvers
+  /*! \ingroup invert
+   *
+   * A block of n lattice vectors is a multi1d<T> and the small matrices
+   * acting on it from the right are multi2d<DComplex> indexed (row,col).
+   * All the dense algebra is in double precision whatever T is.
+   */
+  namespace BlockKrylov
+  {
+    //! |a|^2 of a complex number
+    inline double absSq(const DComplex& a)
+    {
+      return toDouble(real(a)*real(a) + imag(a)*imag(a));
+    }
+
+
+    //! Drop tolerance of the rank revealing QR for vectors of type T
+    /*! About the square root of the working precision */
+    template<typename T>
+    double rankTolerance()
+    {
+      typedef typename WordType<T>::Type_t  REALT;
+      return std::sqrt(double(std::numeric_limits<REALT>::epsilon()));
+    }
+
+
+    //! m(i,j) = <x[i], y[j]>
+    template<typename T>
+    void innerProducts(multi2d<DComplex>& m,
+		       const multi1d<T>& x, const multi1d<T>& y,
+		       const Subset& s)
+    {
+      m.resize(x.size(), y.size());
+
+      for(int i=0; i < x.size(); ++i)
+	for(int j=0; j < y.size(); ++j)
+	  m(i,j) = innerProduct(x[i], y[j], s);
+    }
+
+
+    //! m(i,j) = <x[i], x[j]>, using that m is hermitian
+    template<typename T>
+    void gram(multi2d<DComplex>& m, const multi1d<T>& x, const Subset& s)
+    {
+      m.resize(x.size(), x.size());
+
+      for(int i=0; i < x.size(); ++i)
+      {
+	m(i,i) = Double(norm2(x[i], s));
+
+	for(int j=i+1; j < x.size(); ++j)
+	{
+	  m(i,j) = innerProduct(x[i], x[j], s);
+	  m(j,i) = conj(m(i,j));
+	}
+      }
+    }
+
+
+    //! y[j] += sum_i x[i] c(i,j)
+    template<typename T, typename CR>
+    void mulAdd(multi1d<T>& y, const multi1d<T>& x, const multi2d<DComplex>& c,
+		const Subset& s)
+    {
+      for(int j=0; j < y.size(); ++j)
+	for(int i=0; i < x.size(); ++i)
+	{
+	  CR c_r = c(i,j);
+	  y[j][s] += c_r * x[i];
+	}
+    }
+
+
+    //! y[j] -= sum_i x[i] c(i,j)
+    template<typename T, typename CR>
+    void mulSub(multi1d<T>& y, const multi1d<T>& x, const multi2d<DComplex>& c,
+		const Subset& s)
+    {
+      for(int j=0; j < y.size(); ++j)
+	for(int i=0; i < x.size(); ++i)
+	{
+	  CR c_r = c(i,j);
+	  y[j][s] -= c_r * x[i];
+	}
+    }
+
+
+    //! Drop the elements v[i] with keep[i] false
+    template<typename T>
+    void compact(multi1d<T>& v, const multi1d<bool>& keep)
+    {
+      int n = 0;
+      for(int i=0; i < v.size(); ++i)
+	if (keep[i])
+	  ++n;
+
+      multi1d<T> tmp(n);
+      n = 0;
+      for(int i=0; i < v.size(); ++i)
+	if (keep[i])
+	  tmp[n++] = v[i];
+
+      v = tmp;
+    }
+
+
+    //! x = a^-1 b by Gaussian elimination with partial pivoting
+    /*!
+     * a is n x n and b is n x m. Returns false if a is numerically singular.
+     */
+    inline bool solve(multi2d<DComplex>& x, const multi2d<DComplex>& a_in,
+		      const multi2d<DComplex>& b)
+    {
+      const int n = a_in.size1();
+      const int m = b.size1();
+
+      multi2d<DComplex> a(n,n);
+      x.resize(n,m);
+
+      double amax = 0;
+      for(int i=0; i < n; ++i)
+      {
+	for(int j=0; j < n; ++j)
+	{
+	  a(i,j) = a_in(i,j);
+	  amax = std::max(amax, absSq(a(i,j)));
+	}
+
+	for(int j=0; j < m; ++j)
+	  x(i,j) = b(i,j);
+      }
+
+      const double eps = std::numeric_limits<double>::epsilon();
+
+      for(int k=0; k < n; ++k)
+      {
+	// Pivot
+	int piv = k;
+	for(int i=k+1; i < n; ++i)
+	  if (absSq(a(i,k)) > absSq(a(piv,k)))
+	    piv = i;
+
+	if (absSq(a(piv,k)) <= eps*eps*amax || amax == 0)
+	  return false;
+
+	if (piv != k)
+	{
+	  for(int j=0; j < n; ++j)
+	    std::swap(a(k,j), a(piv,j));
+	  for(int j=0; j < m; ++j)
+	    std::swap(x(k,j), x(piv,j));
+	}
+
+	// Eliminate below
+	for(int i=k+1; i < n; ++i)
+	{
+	  DComplex f = a(i,k) / a(k,k);
+
+	  for(int j=k+1; j < n; ++j)
+	    a(i,j) -= f * a(k,j);
+	  for(int j=0; j < m; ++j)
+	    x(i,j) -= f * x(k,j);
+	}
+      }
+
+      // Back substitution
+      for(int k=n-1; k >= 0; --k)
+	for(int j=0; j < m; ++j)
+	{
+	  DComplex t = x(k,j);
+	  for(int l=k+1; l < n; ++l)
+	    t -= a(k,l) * x(l,j);
+	  x(k,j) = t / a(k,k);
+	}
+
+      return true;
+    }
+
+
+    //! Rank revealing QR of a block by modified Gram-Schmidt with column pivoting
+    /*!
+     * On return w = q r up to columns of relative size below tol, where q
+     * has orthonormal columns and r is rank x w.size(). The columns of w are
+     * scaled to unit norm before pivoting, so a residual that is small but
+     * independent of the others is kept. w is overwritten.
+     *
+     * \return the rank, which is q.size()
+     */
+    template<typename T, typename CR>
+    int orthonormalize(multi1d<T>& q, multi2d<DComplex>& r, multi1d<T>& w,
+		       const Subset& s, double tol)
+    {
+      const int n = w.size();
+
+      multi1d<Double> scale(n);
+      multi1d<Double> nrm(n);
+      multi1d<bool>   done(n);
+
+      for(int j=0; j < n; ++j)
+      {
+	scale[j] = sqrt(norm2(w[j], s));
+	done[j]  = toBool(scale[j] == Double(0));
+
+	if (! done[j])
+	{
+	  DComplex f = Double(1) / scale[j];
+	  CR f_r = f;
+	  w[j][s] = f_r * w[j];
+	}
+	nrm[j] = 1;
+      }
+
+      std::vector<int> piv;
+      multi2d<DComplex> rr(n,n);
+      rr = zero;
+
+      for(int k=0; k < n; ++k)
+      {
+	// The remaining column of largest norm
+	int jmax = -1;
+	for(int j=0; j < n; ++j)
+	  if (! done[j] && (jmax < 0 || toBool(nrm[j] > nrm[jmax])))
+	    jmax = j;
+
+	if (jmax < 0 || toDouble(nrm[jmax]) <= tol*tol)
+	  break;
+
+	done[jmax] = true;
+	piv.push_back(jmax);
+
+	Double len = sqrt(nrm[jmax]);
+	rr(k,jmax) = len;
+
+	DComplex f = Double(1) / len;
+	CR f_r = f;
+	w[jmax][s] = f_r * w[jmax];
+
+	// Project it out of the rest
+	for(int j=0; j < n; ++j)
+	{
+	  if (done[j])
+	    continue;
+
+	  rr(k,j) = innerProduct(w[jmax], w[j], s);
+	  CR c_r = rr(k,j);
+	  w[j][s] -= c_r * w[jmax];
+	  nrm[j] = norm2(w[j], s);
+	}
+      }
+
+      const int rank = piv.size();
+
+      q.resize(rank);
+      r.resize(rank,n);
+
+      for(int k=0; k < rank; ++k)
+      {
+	q[k][s] = w[piv[k]];
+
+	// Undo the column scaling
+	for(int j=0; j < n; ++j)
+	  r(k,j) = rr(k,j) * scale[j];
+      }
+
+      return rank;
+    }
+
+  }  // end namespace BlockKrylov
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,126 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Fused vector updates and reductions for the CG family of solvers
+ */
+
+#ifndef __cg_kernels_h__
+#define __cg_kernels_h__
+
+#include "chromabase.h"
+#include "chroma_config.h"
+
+namespace Chroma
+{
+
+  //! Fused CG recurrences
+  /*! \ingroup invert
+   *
+   * Each CG iteration updates the solution, residual and direction and
+   * takes the norm of the new residual. Done as separate QDP expressions
+   * these read and write every field several times. The functions here do
+   * the same work in single passes over the sites.
+   *
+   * The templates are the plain QDP versions and work for any type. For
+   * Dirac fermions on ordered subsets there are overloads that run
+   * threaded single pass kernels, with AVX2 variants when chroma is
+   * configured with --enable-avx2-cg-kernels.
+   */
+  namespace CGKernels
+  {
+
+    //! x += a*p,  r -= a*ap,  norm_r = |r|^2
+    template<typename T, typename R>
+    inline
+    void xr_update_normr(T& x, T& r, const T& p, const T& ap, const R& a,
+			 Double& norm_r, const Subset& s)
+    {
+      x[s] += a*p;
+      r[s] -= a*ap;
+      norm_r = norm2(r,s);
+    }
+
+    //! r -= a*ap,  norm_r = |r|^2
+    template<typename T, typename R>
+    inline
+    void r_update_normr(T& r, const T& ap, const R& a,
+			Double& norm_r, const Subset& s)
+    {
+      r[s] -= a*ap;
+      norm_r = norm2(r,s);
+    }
+
+    //! p = r + b*p
+    template<typename T, typename R>
+    inline
+    void p_update(T& p, const T& r, const R& b, const Subset& s)
+    {
+      p[s] = r + b*p;
+    }
+
+    //! The updates of all the shifted systems of multi-shift CG in one go
+    /*!
+     * For every shift i
+     *
+     *    psi[i] -= bs[i] * p[i]             if do_psi[i]
+     *    p[i]    = zs[i] * r + as[i] * p[i]  if do_p[i]
+     *
+     * in that order.
+     */
+    template<typename T, typename R>
+    inline
+    void shift_updates(multi1d<T>& psi, multi1d<T>& p, const T& r,
+		       const multi1d<R>& bs, const multi1d<R>& zs, const multi1d<R>& as,
+		       const multi1d<bool>& do_psi, const multi1d<bool>& do_p,
+		       const Subset& s)
+    {
+      for(int i=0; i < p.size(); ++i)
+      {
+	if (do_psi[i])
+	  psi[i][s] -= bs[i]*p[i];
+
+	if (do_p[i])
+	  p[i][s] = zs[i]*r + as[i]*p[i];
+      }
+    }
+
+
+#ifndef QDP_IS_QDPJIT
+    //! Single pass versions
+    void xr_update_normr(LatticeDiracFermionF& x, LatticeDiracFermionF& r,
+			 const LatticeDiracFermionF& p, const LatticeDiracFermionF& ap,
+			 const RealF& a, Double& norm_r, const Subset& s);
+
+    void xr_update_normr(LatticeDiracFermionD& x, LatticeDiracFermionD& r,
+			 const LatticeDiracFermionD& p, const LatticeDiracFermionD& ap,
+			 const RealD& a, Double& norm_r, const Subset& s);
+
+    void r_update_normr(LatticeDiracFermionF& r, const LatticeDiracFermionF& ap,
+			const RealF& a, Double& norm_r, const Subset& s);
+
+    void r_update_normr(LatticeDiracFermionD& r, const LatticeDiracFermionD& ap,
+			const RealD& a, Double& norm_r, const Subset& s);
+
+    void p_update(LatticeDiracFermionF& p, const LatticeDiracFermionF& r,
+		  const RealF& b, const Subset& s);
+
+    void p_update(LatticeDiracFermionD& p, const LatticeDiracFermionD& r,
+		  const RealD& b, const Subset& s);
+
+    void shift_updates(multi1d<LatticeDiracFermionF>& psi, multi1d<LatticeDiracFermionF>& p,
+		       const LatticeDiracFermionF& r,
+		       const multi1d<RealF>& bs, const multi1d<RealF>& zs, const multi1d<RealF>& as,
+		       const multi1d<bool>& do_psi, const multi1d<bool>& do_p,
+		       const Subset& s);
+
+    void shift_updates(multi1d<LatticeDiracFermionD>& psi, multi1d<LatticeDiracFermionD>& p,
+		       const LatticeDiracFermionD& r,
+		       const multi1d<RealD>& bs, const multi1d<RealD>& zs, const multi1d<RealD>& as,
+		       const multi1d<bool>& do_psi, const multi1d<bool>& do_p,
+		       const Subset& s);
+#endif
+
+  }  // end namespace CGKernels
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,253 @@
+/*! \file
+ *  \brief Fused vector updates and reductions for the CG family of solvers
+ */
+
+#include "actions/ferm/invert/cg_kernels.h"
+
+#ifndef QDP_IS_QDPJIT
+
+#ifdef BUILD_AVX2_CG_KERNELS
+#include <immintrin.h>
+#endif
+#include <vector>
+
+namespace Chroma
+{
+  namespace CGKernels
+  {
+    //! Per thread partial norms are a cache line apart
+    const int CG_NORM_STRIDE = 8;
+
+    template<typename REAL>
+    struct ord_xr_update_normr_arg
+    {
+      REAL*        x_ptr;
+      REAL*        r_ptr;
+      const REAL*  p_ptr;
+      const REAL*  ap_ptr;
+      REAL         a;
+      REAL64*      norm_space;
+      int          atom;
+    };
+
+    template<typename REAL>
+    struct ord_p_update_arg
+    {
+      REAL*        p_ptr;
+      const REAL*  r_ptr;
+      REAL         b;
+      int          atom;
+    };
+
+    template<typename REAL>
+    struct ord_shift_updates_arg
+    {
+      int          n_shift;
+      REAL**       psi_ptr;
+      REAL**       p_ptr;
+      const REAL*  r_ptr;
+      const REAL*  bs;
+      const REAL*  zs;
+      const REAL*  as;
+      const int*   do_psi;
+      const int*   do_p;
+      int          atom;
+    };
+
+#include "actions/ferm/invert/ord_cg_kernels.h"
+
+
+    // Utility functions
+    namespace
+    {
+      //! Reals per site of a Dirac fermion
+      const int dirac_atom = 4*Nc*2;
+
+      //! The first real of x on an ordered subset
+      template<typename REAL, typename T>
+      REAL* firstReal(const T& x, const Subset& s)
+      {
+	return (REAL*)&(x.elem(s.start()).elem(0).elem(0).real());
+      }
+
+      //! The per thread norms summed over threads and nodes
+      Double sumNorms(const std::vector<REAL64>& norm_space)
+      {
+	REAL64 norm = 0;
+	for(int i=0; i < qdpNumThreads(); ++i)
+	  norm += norm_space[CG_NORM_STRIDE*i];
+
+	QDPInternal::globalSum(norm);
+	return Double(norm);
+      }
+
+      //! x += a*p (if x is given), r -= a*ap, |r|^2
+      template<typename REAL, typename T, typename R>
+      void ordUpdateNormr(T* x, T& r, const T& p, const T& ap, const R& a,
+			  Double& norm_r, const Subset& s)
+      {
+	std::vector<REAL64> norm_space(CG_NORM_STRIDE*qdpNumThreads(), 0.0);
+	int len = s.numSiteTable();
+
+	if (len > 0)
+	{
+	  ord_xr_update_normr_arg<REAL> arg = {(x != 0) ? firstReal<REAL>(*x,s) : 0,
+					       firstReal<REAL>(r,s),
+					       firstReal<REAL>(p,s),
+					       firstReal<REAL>(ap,s),
+					       REAL(a.elem().elem().elem().elem()),
+					       &(norm_space[0]),
+					       dirac_atom};
+	  if (x != 0)
+	    dispatch_to_threads(len, arg, ord_xr_update_normr_kernel);
+	  else
+	    dispatch_to_threads(len, arg, ord_r_update_normr_kernel);
+	}
+
+	norm_r = sumNorms(norm_space);
+      }
+
+      //! p = r + b*p
+      template<typename REAL, typename T, typename R>
+      void ordPUpdate(T& p, const T& r, const R& b, const Subset& s)
+      {
+	int len = s.numSiteTable();
+	if (len == 0)
+	  return;
+
+	ord_p_update_arg<REAL> arg = {firstReal<REAL>(p,s),
+				      firstReal<REAL>(r,s),
+				      REAL(b.elem().elem().elem().elem()),
+				      dirac_atom};
+
+	dispatch_to_threads(len, arg, ord_p_update_kernel);
+      }
+
+      //! The shifted updates
+      template<typename REAL, typename T, typename R>
+      void ordShiftUpdates(multi1d<T>& psi, multi1d<T>& p, const T& r,
+			   const multi1d<R>& bs, const multi1d<R>& zs, const multi1d<R>& as,
+			   const multi1d<bool>& do_psi, const multi1d<bool>& do_p,
+			   const Subset& s)
+      {
+	int len = s.numSiteTable();
+	int n_shift = p.size();
+	if (len == 0 || n_shift == 0)
+	  return;
+
+	std::vector<REAL*> psi_ptr(n_shift, (REAL*)0);
+	std::vector<REAL*> p_ptr(n_shift);
+	std::vector<REAL>  bs_r(n_shift), zs_r(n_shift), as_r(n_shift);
+	std::vector<int>   psi_on(n_shift), p_on(n_shift);
+
+	for(int i=0; i < n_shift; ++i)
+	{
+	  if (do_psi[i])
+	    psi_ptr[i] = firstReal<REAL>(psi[i],s);
+
+	  p_ptr[i]  = firstReal<REAL>(p[i],s);
+	  bs_r[i]   = bs[i].elem().elem().elem().elem();
+	  zs_r[i]   = zs[i].elem().elem().elem().elem();
+	  as_r[i]   = as[i].elem().elem().elem().elem();
+	  psi_on[i] = do_psi[i];
+	  p_on[i]   = do_p[i];
+	}
+
+	ord_shift_updates_arg<REAL> arg = {n_shift, &(psi_ptr[0]), &(p_ptr[0]), firstReal<REAL>(r,s),
+					   &(bs_r[0]), &(zs_r[0]), &(as_r[0]),
+					   &(psi_on[0]), &(p_on[0]), dirac_atom};
+
+	dispatch_to_threads(len, arg, ord_shift_updates_kernel);
+      }
+    }
+
+
+    //----------------------------------------------------------------------------
+    void xr_update_normr(LatticeDiracFermionF& x, LatticeDiracFermionF& r,
+			 const LatticeDiracFermionF& p, const LatticeDiracFermionF& ap,
+			 const RealF& a, Double& norm_r, const Subset& s)
+    {
+      if (s.hasOrderedRep())
+	ordUpdateNormr<REAL32>(&x, r, p, ap, a, norm_r, s);
+      else
+	xr_update_normr<LatticeDiracFermionF,RealF>(x, r, p, ap, a, norm_r, s);
+    }
+
+    void xr_update_normr(LatticeDiracFermionD& x, LatticeDiracFermionD& r,
+			 const LatticeDiracFermionD& p, const LatticeDiracFermionD& ap,
+			 const RealD& a, Double& norm_r, const Subset& s)
+    {
+      if (s.hasOrderedRep())
+	ordUpdateNormr<REAL64>(&x, r, p, ap, a, norm_r, s);
+      else
+	xr_update_normr<LatticeDiracFermionD,RealD>(x, r, p, ap, a, norm_r, s);
+    }
+
+
+    void r_update_normr(LatticeDiracFermionF& r, const LatticeDiracFermionF& ap,
+			const RealF& a, Double& norm_r, const Subset& s)
+    {
+      if (s.hasOrderedRep())
+	ordUpdateNormr<REAL32>((LatticeDiracFermionF*)0, r, ap, ap, a, norm_r, s);
+      else
+	r_update_normr<LatticeDiracFermionF,RealF>(r, ap, a, norm_r, s);
+    }
+
+    void r_update_normr(LatticeDiracFermionD& r, const LatticeDiracFermionD& ap,
+			const RealD& a, Double& norm_r, const Subset& s)
+    {
+      if (s.hasOrderedRep())
+	ordUpdateNormr<REAL64>((LatticeDiracFermionD*)0, r, ap, ap, a, norm_r, s);
+      else
+	r_update_normr<LatticeDiracFermionD,RealD>(r, ap, a, norm_r, s);
+    }
+
+
+    void p_update(LatticeDiracFermionF& p, const LatticeDiracFermionF& r,
+		  const RealF& b, const Subset& s)
+    {
+      if (s.hasOrderedRep())
+	ordPUpdate<REAL32>(p, r, b, s);
+      else
+	p_update<LatticeDiracFermionF,RealF>(p, r, b, s);
+    }
+
+    void p_update(LatticeDiracFermionD& p, const LatticeDiracFermionD& r,
+		  const RealD& b, const Subset& s)
+    {
+      if (s.hasOrderedRep())
+	ordPUpdate<REAL64>(p, r, b, s);
+      else
+	p_update<LatticeDiracFermionD,RealD>(p, r, b, s);
+    }
+
+
+    void shift_updates(multi1d<LatticeDiracFermionF>& psi, multi1d<LatticeDiracFermionF>& p,
+		       const LatticeDiracFermionF& r,
+		       const multi1d<RealF>& bs, const multi1d<RealF>& zs, const multi1d<RealF>& as,
+		       const multi1d<bool>& do_psi, const multi1d<bool>& do_p,
+		       const Subset& s)
+    {
+      if (s.hasOrderedRep())
+	ordShiftUpdates<REAL32>(psi, p, r, bs, zs, as, do_psi, do_p, s);
+      else
+	shift_updates<LatticeDiracFermionF,RealF>(psi, p, r, bs, zs, as, do_psi, do_p, s);
+    }
+
+    void shift_updates(multi1d<LatticeDiracFermionD>& psi, multi1d<LatticeDiracFermionD>& p,
+		       const LatticeDiracFermionD& r,
+		       const multi1d<RealD>& bs, const multi1d<RealD>& zs, const multi1d<RealD>& as,
+		       const multi1d<bool>& do_psi, const multi1d<bool>& do_p,
+		       const Subset& s)
+    {
+      if (s.hasOrderedRep())
+	ordShiftUpdates<REAL64>(psi, p, r, bs, zs, as, do_psi, do_p, s);
+      else
+	shift_updates<LatticeDiracFermionD,RealD>(psi, p, r, bs, zs, as, do_psi, do_p, s);
+    }
+
+  }  // end namespace CGKernels
+
+}  // end namespace Chroma
+
+#endif
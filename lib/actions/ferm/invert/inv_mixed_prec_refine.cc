@@ -0,0 +1,102 @@
+/*! \file
+ *  \brief Mixed precision defect correction
+ */
+
+#include "actions/ferm/invert/inv_mixed_prec_refine.h"
+
+namespace Chroma
+{
+
+  //! Anonymous namespace
+  namespace
+  {
+    //! Report one correction, returns false if it made no progress
+    bool checkProgress(int k, int inner, const Double& r_norm_old, const Double& r_norm, const Double& rsd_t)
+    {
+      QDPIO::cout << "MIXED_PREC_REFINE: correction " << k
+		  << " inner iters = " << inner
+		  << "  || r || = " << r_norm
+		  << "  || r_target || = " << rsd_t << std::endl;
+
+      if (toBool(r_norm >= r_norm_old))
+      {
+	QDPIO::cout << "MIXED_PREC_REFINE: residual did not decrease, stopping" << std::endl;
+	return false;
+      }
+      return true;
+    }
+  }
+
+
+  //! Mixed precision defect correction
+  template<typename T, typename TL, typename RT>
+  SystemSolverResults_t InvMixedPrecRefine_a(const SystemSolver<TL>& DInv,
+					     const LinearOperator<T>& A,
+					     const T& chi,
+					     T& psi,
+					     const RT& RsdTarget,
+					     int MaxIter)
+  {
+    START_CODE();
+
+    const Subset& s = A.subset();
+    SystemSolverResults_t res;
+    res.n_count = 0;
+
+    Double rsd_t = Double(RsdTarget) * sqrt(norm2(chi, s));
+
+    T  r, tmp;
+    A(tmp, psi, PLUS);
+    r[s] = chi - tmp;
+    Double r_norm = sqrt(norm2(r, s));
+
+    QDPIO::cout << "MIXED_PREC_REFINE: correction 0  || r || = " << r_norm
+		<< "  || r_target || = " << rsd_t << std::endl;
+
+    for(int k = 1; k <= MaxIter && toBool(r_norm > rsd_t); ++k)
+    {
+      // Solve for the normalised defect in single precision
+      TL r_l, dx_l;
+      tmp[s] = (Double(1) / r_norm) * r;
+      r_l[s] = tmp;
+      dx_l[s] = zero;
+
+      SystemSolverResults_t res_l = DInv(dx_l, r_l);
+      res.n_count += res_l.n_count;
+
+      // Accumulate the correction and recompute the true residual in double
+      tmp[s] = dx_l;
+      psi[s] += r_norm * tmp;
+
+      A(tmp, psi, PLUS);
+      r[s] = chi - tmp;
+
+      Double r_norm_old = r_norm;
+      r_norm = sqrt(norm2(r, s));
+
+      if (! checkProgress(k, res_l.n_count, r_norm_old, r_norm, rsd_t))
+	break;
+    }
+
+    if (toBool(r_norm > rsd_t))
+      QDPIO::cout << "MIXED_PREC_REFINE: NONCONVERGENCE" << std::endl;
+
+    res.resid = Real(r_norm);
+
+    END_CODE();
+
+    return res;
+  }
+
+
+  SystemSolverResults_t InvMixedPrecRefine(const SystemSolver<LatticeFermionF>& DInv,
+					   const LinearOperator<LatticeFermion>& A,
+					   const LatticeFermion& chi,
+					   LatticeFermion& psi,
+					   const Real& RsdTarget,
+					   int MaxIter)
+  {
+    return InvMixedPrecRefine_a(DInv, A, chi, psi, RsdTarget, MaxIter);
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,51 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Mixed precision defect correction
+ */
+
+#ifndef __inv_mixed_prec_refine_h__
+#define __inv_mixed_prec_refine_h__
+
+#include "chromabase.h"
+#include "linearop.h"
+#include "syssolver.h"
+
+namespace Chroma
+{
+
+  //! Mixed precision defect correction
+  /*! \ingroup invert
+   *
+   * Solves  A psi = chi  to double precision accuracy with a single
+   * precision solver doing the work:
+   *
+   *  r     :=  chi - A psi                      in double
+   *  WHILE |r| > RsdTarget |chi| DO
+   *      dx    :=  |r| DInv (r / |r|)           in single
+   *      psi   +=  dx                           in double
+   *      r     :=  chi - A psi                  reliable update, in double
+   *
+   * The defect is normalised before it is rounded so the single
+   * precision solve always sees a unit source, however small the
+   * residual has become.
+   *
+   * \param DInv       single precision solver for A   ( Read )
+   * \param A          full precision operator         ( Read )
+   * \param chi        source                          ( Read )
+   * \param psi        initial guess and solution      ( Modify )
+   * \param RsdTarget  relative residual wanted        ( Read )
+   * \param MaxIter    maximum number of corrections   ( Read )
+   *
+   * \return n_count is the total of the inner iterations, resid the
+   *         final absolute residual in double precision
+   */
+  SystemSolverResults_t InvMixedPrecRefine(const SystemSolver<LatticeFermionF>& DInv,
+					   const LinearOperator<LatticeFermion>& A,
+					   const LatticeFermion& chi,
+					   LatticeFermion& psi,
+					   const Real& RsdTarget,
+					   int MaxIter);
+
+} // End namespace
+
+#endif
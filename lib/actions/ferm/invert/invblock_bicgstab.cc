@@ -0,0 +1,286 @@
+/*! \file
+ *  \brief Block BiCGStab algorithm for several sources
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/invblock_bicgstab.h"
+#include "actions/ferm/invert/block_krylov.h"
+
+namespace Chroma
+{
+
+  //! Block BiCGStab algorithm for several sources
+  /*! \ingroup invert
+   *
+   * See the description in invblock_bicgstab.h.
+   *
+   * Only the sources that have not converged are kept in the working
+   * array x, with idx mapping them back to the arguments.
+   */
+  template<typename T, typename CR>
+  multi1d<SystemSolverResults_t>
+  InvBlockBiCGStab_a(const LinearOperator<T>& A,
+		     const multi1d<T>& chi,
+		     multi1d<T>& psi,
+		     const Real& RsdBiCGStab,
+		     int MaxBiCGStab,
+		     enum PlusMinus isign)
+  {
+    START_CODE();
+
+    const Subset& s = A.subset();
+    const int N = chi.size();
+
+    if (psi.size() != N)
+    {
+      QDPIO::cerr << "InvBlockBiCGStab: number of solutions and sources differ" << std::endl;
+      QDP_abort(1);
+    }
+
+    multi1d<SystemSolverResults_t> res(N);
+
+    QDPIO::cout << "InvBlockBiCGStab: starting with " << N << " sources" << std::endl;
+    FlopCounter flopcount;
+    flopcount.reset();
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    multi1d<Double> rsd_sq(N);
+    multi1d<int> idx(N);
+    for(int n=0; n < N; ++n)
+    {
+      rsd_sq[n] = RsdBiCGStab * RsdBiCGStab * norm2(chi[n], s);
+      idx[n] = n;
+    }
+    flopcount.addSiteFlops(4*Nc*Ns*N,s);
+
+    multi1d<T> x(psi);
+
+    const double tol = BlockKrylov::rankTolerance<T>();
+    bool convP = false;
+    int k = 0;
+
+    while (true)
+    {
+      // True residuals of the sources left, r = chi - A x
+      multi1d<T> r(x.size());
+      multi1d<bool> keep(x.size());
+
+      for(int j=0; j < x.size(); ++j)
+      {
+	const int n = idx[j];
+
+	A(r[j], x[j], isign);
+	r[j][s] = chi[n] - r[j];
+	Double cp = norm2(r[j], s);
+
+	res[n].n_count = k;
+	res[n].resid   = sqrt(cp);
+	keep[j] = toBool(cp > rsd_sq[n]);
+
+	if (! keep[j])
+	{
+	  psi[n][s] = x[j];
+
+	  QDPIO::cout << "InvBlockBiCGStab: k = " << k << "  source " << n
+		      << " converged, resid = " << res[n].resid << std::endl;
+	}
+      }
+      flopcount.addFlops(x.size()*A.nFlops());
+      flopcount.addSiteFlops(6*Nc*Ns*x.size(),s);
+
+      BlockKrylov::compact(idx, keep);
+      BlockKrylov::compact(x, keep);
+      BlockKrylov::compact(r, keep);
+
+      convP = (x.size() == 0);
+      if (convP || k >= MaxBiCGStab)
+	break;
+
+      // r = q f, and the block iteration is on A y = q
+      multi1d<T> q;
+      multi2d<DComplex> f;
+      const int m = BlockKrylov::orthonormalize<T,CR>(q, f, r, s, tol);
+      flopcount.addSiteFlops(12*Nc*Ns*r.size()*r.size(), s);
+
+      if (m == 0)
+      {
+	QDPIO::cerr << "InvBlockBiCGStab: breakdown, the residuals have rank 0" << std::endl;
+	break;
+      }
+
+      multi1d<T> y(m);      // block solution
+      multi1d<T> rr(m);     // block residual
+      multi1d<T> p(m);
+      multi1d<T> v(m);
+      multi1d<T> t(m);
+      const multi1d<T>& r0 = q;    // shadow residuals
+
+      for(int i=0; i < m; ++i)
+      {
+	y[i][s]  = zero;
+	rr[i][s] = q[i];
+	p[i][s]  = q[i];
+      }
+
+      while (k < MaxBiCGStab)
+      {
+	++k;
+
+	// v = A p
+	for(int i=0; i < m; ++i)
+	  A(v[i], p[i], isign);
+	flopcount.addFlops(m*A.nFlops());
+
+	// alpha = (r0^dag v)^-1 r0^dag r
+	multi2d<DComplex> r0v, r0r, alpha;
+	BlockKrylov::innerProducts(r0v, r0, v, s);
+	BlockKrylov::innerProducts(r0r, r0, rr, s);
+
+	if (! BlockKrylov::solve(alpha, r0v, r0r))
+	{
+	  QDPIO::cerr << "InvBlockBiCGStab: breakdown, r0^dag v is singular, restarting" << std::endl;
+	  break;
+	}
+
+	// y += p alpha,  s = r - v alpha  (in rr)
+	BlockKrylov::mulAdd<T,CR>(y, p, alpha, s);
+	BlockKrylov::mulSub<T,CR>(rr, v, alpha, s);
+
+	// t = A s
+	for(int i=0; i < m; ++i)
+	  A(t[i], rr[i], isign);
+	flopcount.addFlops(m*A.nFlops());
+
+	// omega = <t,s> / <t,t>  in the Frobenius inner product
+	DComplex ts = zero;
+	Double   tt = zero;
+	for(int i=0; i < m; ++i)
+	{
+	  DComplex c = innerProduct(t[i], rr[i], s);
+	  Double   d = norm2(t[i], s);
+	  ts += c;
+	  tt += d;
+	}
+
+	if (toBool(tt == Double(0)))
+	{
+	  QDPIO::cerr << "InvBlockBiCGStab: breakdown, || A s || = 0, restarting" << std::endl;
+	  break;
+	}
+
+	DComplex omega = ts / tt;
+	CR omega_r = omega;
+
+	// y += omega s,  r = s - omega t
+	for(int i=0; i < m; ++i)
+	{
+	  y[i][s]  += omega_r * rr[i];
+	  rr[i][s] -= omega_r * t[i];
+	}
+
+	flopcount.addSiteFlops(8*Nc*Ns*m*(5*m + 5), s);
+
+	// |r f_j|^2 = f_j^dag (r^dag r) f_j for every source left
+	multi2d<DComplex> g;
+	BlockKrylov::gram(g, rr, s);
+	flopcount.addSiteFlops(4*Nc*Ns*m*(m + 1), s);
+
+	bool restart = false;
+	for(int j=0; j < x.size(); ++j)
+	{
+	  DComplex e = zero;
+	  for(int a=0; a < m; ++a)
+	    for(int b=0; b < m; ++b)
+	      e += conj(f(a,j)) * g(a,b) * f(b,j);
+
+	  if (toBool(real(e) <= rsd_sq[idx[j]]))
+	    restart = true;
+	}
+
+	if (restart)
+	  break;
+
+	// beta = -(r0^dag v)^-1 r0^dag t,  p = r + (p - omega v) beta
+	multi2d<DComplex> r0t, beta;
+	BlockKrylov::innerProducts(r0t, r0, t, s);
+
+	if (! BlockKrylov::solve(beta, r0v, r0t))
+	{
+	  QDPIO::cerr << "InvBlockBiCGStab: breakdown, r0^dag v is singular, restarting" << std::endl;
+	  break;
+	}
+
+	multi1d<T> pw(m);
+	for(int i=0; i < m; ++i)
+	{
+	  pw[i][s] = p[i] - omega_r * v[i];
+	  p[i][s]  = rr[i];
+	}
+	BlockKrylov::mulSub<T,CR>(p, pw, beta, s);
+
+	flopcount.addSiteFlops(8*Nc*Ns*m*(3*m + 2), s);
+      }
+
+      // x += y f
+      BlockKrylov::mulAdd<T,CR>(x, y, f, s);
+      flopcount.addSiteFlops(8*Nc*Ns*m*x.size(), s);
+    }
+
+    // Whatever did not converge
+    for(int j=0; j < x.size(); ++j)
+      psi[idx[j]][s] = x[j];
+
+    swatch.stop();
+    flopcount.report("invblockbicgstab", swatch.getTimeInSeconds());
+
+    if (! convP)
+    {
+      QDPIO::cerr << "Nonconvergence of block BiCGStab: " << x.size()
+		  << " sources did not converge in " << k << " iterations" << std::endl;
+    }
+
+    END_CODE();
+    return res;
+  }
+
+
+  template<>
+  multi1d<SystemSolverResults_t>
+  InvBlockBiCGStab(const LinearOperator<LatticeFermionF>& A,
+		   const multi1d<LatticeFermionF>& chi,
+		   multi1d<LatticeFermionF>& psi,
+		   const Real& RsdBiCGStab,
+		   int MaxBiCGStab,
+		   enum PlusMinus isign)
+  {
+    return InvBlockBiCGStab_a<LatticeFermionF, ComplexF>(A, chi, psi, RsdBiCGStab, MaxBiCGStab, isign);
+  }
+
+  template<>
+  multi1d<SystemSolverResults_t>
+  InvBlockBiCGStab(const LinearOperator<LatticeFermionD>& A,
+		   const multi1d<LatticeFermionD>& chi,
+		   multi1d<LatticeFermionD>& psi,
+		   const Real& RsdBiCGStab,
+		   int MaxBiCGStab,
+		   enum PlusMinus isign)
+  {
+    return InvBlockBiCGStab_a<LatticeFermionD, ComplexD>(A, chi, psi, RsdBiCGStab, MaxBiCGStab, isign);
+  }
+
+  // Staggered
+  template<>
+  multi1d<SystemSolverResults_t>
+  InvBlockBiCGStab(const LinearOperator<LatticeStaggeredFermion>& A,
+		   const multi1d<LatticeStaggeredFermion>& chi,
+		   multi1d<LatticeStaggeredFermion>& psi,
+		   const Real& RsdBiCGStab,
+		   int MaxBiCGStab,
+		   enum PlusMinus isign)
+  {
+    return InvBlockBiCGStab_a<LatticeStaggeredFermion, Complex>(A, chi, psi, RsdBiCGStab, MaxBiCGStab, isign);
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,54 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Block BiCGStab algorithm for several sources
+ */
+
+#ifndef __invblock_bicgstab_h__
+#define __invblock_bicgstab_h__
+
+#include "linearop.h"
+#include "syssolver.h"
+
+namespace Chroma
+{
+
+  //! Block BiCGStab algorithm for several sources
+  /*! \ingroup invert
+   *
+   * Solves  A . Psi[n] = Chi[n]  for all n with one Krylov space shared by
+   * all the sources, by the block BiCGStab of El Guennouni, Jbilou and
+   * Sadok (ETNA 16 (2003) 129).
+   *
+   * The residuals of the sources not converged yet are first factored as
+   * R = Q F by a rank revealing QR, and block BiCGStab is run on A Y = Q
+   * with the shadow residuals Q. So linearly dependent sources do not make
+   * the small matrices singular, and the block has at most as many columns
+   * as there are independent residuals. Whenever a source appears to have
+   * converged the block solution is added back, Psi += Y F, the true
+   * residuals are recomputed, the converged sources are deflated and the
+   * iteration restarts on the remaining ones.
+   *
+   *  \param A            Linear Operator             (Read)
+   *  \param chi          Sources                     (Read)
+   *  \param psi          Solutions                   (Modify)
+   *  \param RsdBiCGStab  residual accuracy           (Read)
+   *  \param MaxBiCGStab  Maximum iterations          (Read)
+   *  \param isign        solve with A or A^dag       (Read)
+   *  \return             for each source the iterations it took and its residual
+   *
+   * @{
+   */
+  template<typename T>
+  multi1d<SystemSolverResults_t>
+  InvBlockBiCGStab(const LinearOperator<T>& A,
+		   const multi1d<T>& chi,
+		   multi1d<T>& psi,
+		   const Real& RsdBiCGStab,
+		   int MaxBiCGStab,
+		   enum PlusMinus isign);
+
+  /*! @} */  // end of group invert
+
+}  // end namespace Chroma
+
+#endif
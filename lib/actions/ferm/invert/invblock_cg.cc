@@ -0,0 +1,248 @@
+/*! \file
+ *  \brief Block Conjugate-Gradient algorithm for several sources
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/invblock_cg.h"
+#include "actions/ferm/invert/block_krylov.h"
+
+namespace Chroma
+{
+
+  //! Block Conjugate-Gradient (CGNE) algorithm for several sources
+  /*! \ingroup invert
+   *
+   * See the description in invblock_cg.h.
+   *
+   * Only the sources that have not converged are kept in the working
+   * arrays x and r, with idx mapping them back to the arguments.
+   */
+  template<typename T, typename CR>
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2_a(const LinearOperator<T>& M,
+		const multi1d<T>& chi,
+		multi1d<T>& psi,
+		const Real& RsdCG,
+		int MaxCG)
+  {
+    START_CODE();
+
+    const Subset& s = M.subset();
+    const int N = chi.size();
+
+    if (psi.size() != N)
+    {
+      QDPIO::cerr << "InvBlockCG2: number of solutions and sources differ" << std::endl;
+      QDP_abort(1);
+    }
+
+    multi1d<SystemSolverResults_t> res(N);
+
+    QDPIO::cout << "InvBlockCG2: starting with " << N << " sources" << std::endl;
+    FlopCounter flopcount;
+    flopcount.reset();
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    T mp;
+
+    //                                            +
+    //  r[0]  :=  Chi - A . Psi[0]    where  A = M  . M
+    multi1d<Double> rsd_sq(N);
+    multi1d<T> r_all(N);
+    multi1d<bool> keep(N);
+
+    for(int n=0; n < N; ++n)
+    {
+      M(mp, psi[n], PLUS);
+      M(r_all[n], mp, MINUS);
+      r_all[n][s] = chi[n] - r_all[n];
+      flopcount.addFlops(2*M.nFlops());
+
+      rsd_sq[n] = (RsdCG * RsdCG) * norm2(chi[n], s);
+      Double cp = norm2(r_all[n], s);
+      flopcount.addSiteFlops(10*Nc*Ns,s);
+
+      res[n].n_count = 0;
+      res[n].resid   = sqrt(cp);
+      keep[n] = toBool(cp > rsd_sq[n]);
+    }
+
+    // The sources left to solve
+    multi1d<int> idx(N);
+    for(int n=0; n < N; ++n)
+      idx[n] = n;
+
+    multi1d<T> x(psi);
+    multi1d<T> r(r_all);
+
+    BlockKrylov::compact(idx, keep);
+    BlockKrylov::compact(x, keep);
+    BlockKrylov::compact(r, keep);
+
+    const double tol = BlockKrylov::rankTolerance<T>();
+
+    multi1d<T> p;              // search block, orthonormal columns
+    multi1d<T> ap;             // A . p
+    multi2d<DComplex> pap;     // p^dag A p
+    bool convP = (r.size() == 0);
+
+    int k = 0;
+    while( ! convP  &&  k < MaxCG )
+    {
+      //  w  :=  r - p (p^dag A p)^-1 (Ap)^dag r,  A-orthogonal to the last p
+      multi1d<T> w(r.size());
+      for(int j=0; j < r.size(); ++j)
+	w[j][s] = r[j];
+
+      if (p.size() > 0)
+      {
+	multi2d<DComplex> apr, beta;
+	BlockKrylov::innerProducts(apr, ap, r, s);
+
+	if (BlockKrylov::solve(beta, pap, apr))
+	  BlockKrylov::mulSub<T,CR>(w, p, beta, s);
+
+	flopcount.addSiteFlops(16*Nc*Ns*p.size()*r.size(), s);
+      }
+
+      //  p  :=  orth(w)
+      multi2d<DComplex> rfac;
+      int m = BlockKrylov::orthonormalize<T,CR>(p, rfac, w, s, tol);
+      flopcount.addSiteFlops(12*Nc*Ns*w.size()*w.size(), s);
+
+      if (m == 0)
+      {
+	QDPIO::cerr << "InvBlockCG2: breakdown, the residuals have rank 0" << std::endl;
+	break;
+      }
+
+      ++k;
+
+      ap.resize(m);
+      for(int i=0; i < m; ++i)
+      {
+	M(mp, p[i], PLUS);
+	M(ap[i], mp, MINUS);
+      }
+      flopcount.addFlops(2*m*M.nFlops());
+
+      //  alpha  :=  (p^dag A p)^-1 p^dag r
+      multi2d<DComplex> pr, alpha;
+      BlockKrylov::innerProducts(pap, p, ap, s);
+      BlockKrylov::innerProducts(pr, p, r, s);
+      flopcount.addSiteFlops(8*Nc*Ns*m*(m + r.size()), s);
+
+      if (! BlockKrylov::solve(alpha, pap, pr))
+      {
+	QDPIO::cerr << "InvBlockCG2: breakdown, p^dag A p is singular" << std::endl;
+	break;
+      }
+
+      //  Psi  +=  p alpha,   r  -=  A p alpha
+      BlockKrylov::mulAdd<T,CR>(x, p, alpha, s);
+      BlockKrylov::mulSub<T,CR>(r, ap, alpha, s);
+      flopcount.addSiteFlops(16*Nc*Ns*m*r.size(), s);
+
+      //  Deflate the sources with  |r[n]| <= RsdCG |Chi[n]|
+      keep.resize(r.size());
+      bool deflate = false;
+
+      for(int j=0; j < r.size(); ++j)
+      {
+	const int n = idx[j];
+	Double cp = norm2(r[j], s);
+
+	res[n].n_count = k;
+	res[n].resid   = sqrt(cp);
+	keep[j] = toBool(cp > rsd_sq[n]);
+
+	if (! keep[j])
+	{
+	  psi[n][s] = x[j];
+	  deflate = true;
+
+	  QDPIO::cout << "InvBlockCG2: k = " << k << "  source " << n
+		      << " converged, resid = " << res[n].resid << std::endl;
+	}
+      }
+      flopcount.addSiteFlops(4*Nc*Ns*r.size(), s);
+
+      if (deflate)
+      {
+	BlockKrylov::compact(idx, keep);
+	BlockKrylov::compact(x, keep);
+	BlockKrylov::compact(r, keep);
+      }
+
+      convP = (r.size() == 0);
+    }
+
+    // Whatever did not converge
+    for(int j=0; j < x.size(); ++j)
+      psi[idx[j]][s] = x[j];
+
+    swatch.stop();
+    flopcount.report("invblockcg2", swatch.getTimeInSeconds());
+
+    if (! convP)
+    {
+      QDPIO::cerr << "Nonconvergence Warning" << std::endl;
+      QDPIO::cerr << "InvBlockCG2: " << x.size() << " sources did not converge in "
+		  << k << " iterations" << std::endl;
+    }
+
+    END_CODE();
+    return res;
+  }
+
+
+  //
+  // Explicit versions
+  //
+  // Single precision
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2(const LinearOperator<LatticeFermionF>& M,
+	      const multi1d<LatticeFermionF>& chi,
+	      multi1d<LatticeFermionF>& psi,
+	      const Real& RsdCG,
+	      int MaxCG)
+  {
+    return InvBlockCG2_a<LatticeFermionF, ComplexF>(M, chi, psi, RsdCG, MaxCG);
+  }
+
+  // Double precision
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2(const LinearOperator<LatticeFermionD>& M,
+	      const multi1d<LatticeFermionD>& chi,
+	      multi1d<LatticeFermionD>& psi,
+	      const Real& RsdCG,
+	      int MaxCG)
+  {
+    return InvBlockCG2_a<LatticeFermionD, ComplexD>(M, chi, psi, RsdCG, MaxCG);
+  }
+
+  // Single precision
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2(const LinearOperator<LatticeStaggeredFermionF>& M,
+	      const multi1d<LatticeStaggeredFermionF>& chi,
+	      multi1d<LatticeStaggeredFermionF>& psi,
+	      const Real& RsdCG,
+	      int MaxCG)
+  {
+    return InvBlockCG2_a<LatticeStaggeredFermionF, ComplexF>(M, chi, psi, RsdCG, MaxCG);
+  }
+
+  // Double precision
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2(const LinearOperator<LatticeStaggeredFermionD>& M,
+	      const multi1d<LatticeStaggeredFermionD>& chi,
+	      multi1d<LatticeStaggeredFermionD>& psi,
+	      const Real& RsdCG,
+	      int MaxCG)
+  {
+    return InvBlockCG2_a<LatticeStaggeredFermionD, ComplexD>(M, chi, psi, RsdCG, MaxCG);
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,92 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Block Conjugate-Gradient algorithm for several sources
+ */
+
+#ifndef __invblock_cg_h__
+#define __invblock_cg_h__
+
+#include "linearop.h"
+#include "syssolver.h"
+
+namespace Chroma
+{
+
+  //! Block Conjugate-Gradient (CGNE) algorithm for several sources
+  /*! \ingroup invert
+   * This subroutine solves the set of linear equations
+   *
+   *   	    Chi[n]  =  A . Psi[n]     for all n
+   *
+   * where       A = M^dag . M
+   *
+   * with one Krylov space shared by all the sources. It is the breakdown
+   * free block CG of Ji and Li (arXiv:1602.00217):
+   *
+   *  R    :=  Chi - A . Psi ;                  Initial residuals
+   *  P    :=  orth(R) ;
+   *  REPEAT
+   *      Q      :=  A . P ;
+   *      Alpha  :=  (P^dag Q)^-1 (P^dag R) ;
+   *      Psi    +=  P Alpha ;
+   *      R      -=  Q Alpha ;
+   *      Beta   :=  -(P^dag Q)^-1 (Q^dag R) ;
+   *      P      :=  orth(R + P Beta) ;
+   *
+   * orth() is a rank revealing QR, so the search block keeps full rank
+   * even when the residuals become linearly dependent, and may have
+   * fewer columns than there are sources. A source whose residual satisfies
+   * |R[n]| <= RsdCG |Chi[n]| is deflated: its solution is frozen and its
+   * residual leaves the block. Each iteration costs one application of A
+   * per column of P, so for a block of N sources the total number of
+   * operator applications is much lower than N separate CG solves.
+   *
+   * Arguments:
+   *
+   *  \param M       Linear Operator    	       (Read)
+   *  \param chi     Sources	               (Read)
+   *  \param psi     Solutions    	    	       (Modify)
+   *  \param RsdCG   CG residual accuracy        (Read)
+   *  \param MaxCG   Maximum CG iterations       (Read)
+   *  \return        for each source the iterations it took and its residual
+   *
+   * @{
+   */
+
+  // Single precision
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2(const LinearOperator<LatticeFermionF>& M,
+	      const multi1d<LatticeFermionF>& chi,
+	      multi1d<LatticeFermionF>& psi,
+	      const Real& RsdCG,
+	      int MaxCG);
+
+  // Double precision
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2(const LinearOperator<LatticeFermionD>& M,
+	      const multi1d<LatticeFermionD>& chi,
+	      multi1d<LatticeFermionD>& psi,
+	      const Real& RsdCG,
+	      int MaxCG);
+
+  // Single precision
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2(const LinearOperator<LatticeStaggeredFermionF>& M,
+	      const multi1d<LatticeStaggeredFermionF>& chi,
+	      multi1d<LatticeStaggeredFermionF>& psi,
+	      const Real& RsdCG,
+	      int MaxCG);
+
+  // Double precision
+  multi1d<SystemSolverResults_t>
+  InvBlockCG2(const LinearOperator<LatticeStaggeredFermionD>& M,
+	      const multi1d<LatticeStaggeredFermionD>& chi,
+	      multi1d<LatticeStaggeredFermionD>& psi,
+	      const Real& RsdCG,
+	      int MaxCG);
+
+  /*! @} */  // end of group invert
+
+}  // end namespace Chroma
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invcg1_array.h"
+#include "actions/ferm/invert/cg_kernels.h"
 
 using namespace QDP::Hints;
 
@@ -73,6 +74,9 @@ void InvCG1_a(const LinearOperatorArray<T>& A,
 {
   START_CODE();
 
+  // Coefficients in the precision of the fields, for the fused updates
+  typedef OScalar< PScalar< PScalar< RScalar< typename WordType<T>::Type_t > > > > RT;
+
   const int N = psi.size();
   const Subset& s = A.subset();
 
@@ -155,16 +159,15 @@ void InvCG1_a(const LinearOperatorArray<T>& A,
     d = innerProductReal(p, Ap, s);	/* 2 Nc Ns  flops */
 
     a = Real(c)/Real(d);
+    RT ar = a;
 
-    //  Psi[k] += a[k] p[k]
+    //  Psi[k] += a[k] p[k],  r[k] -= a[k] A . p[k],  cp  =  | r[k] |**2
+    //  one pass over each slice
+    cp = zero;
     for(int n=0; n < N; ++n) {
-      psi[n][s] += a * p[n];	/* 2 Nc Ns  flops */
-    }
-
-    //  r[k] -= a[k] A . p[k] ;
-    //      	      
-    for(int n=0; n < N; ++n) {
-      r[n][s] -= a * Ap[n];
+      Double cp_n;
+      CGKernels::xr_update_normr(psi[n], r[n], p[n], Ap[n], ar, cp_n, s);
+      cp += cp_n;
     }
 
 #ifdef PRINT_5D_RESID
@@ -177,9 +180,6 @@ void InvCG1_a(const LinearOperatorArray<T>& A,
 
     //  IF |r[k]| <= RsdCG |Chi| THEN RETURN;
 
-    //  cp  =  | r[k] |**2
-    cp = norm2(r, s);	                /* 2 Nc Ns  flops */
-
     QDPIO::cout << "InvCG: k = " << k << "  cp = " << cp << std::endl;
 
     if ( toBool(cp  <=  rsd_sq) )
@@ -197,8 +197,9 @@ void InvCG1_a(const LinearOperatorArray<T>& A,
 #endif 
 
     //  p[k+1] := r[k] + b[k+1] p[k]
+    RT br = b;
     for(int n=0; n < N; ++n)
-      p[n][s] = r[n] + b*p[n];	/* Nc Ns  flops */
+      CGKernels::p_update(p[n], r[n], br, s);	/* Nc Ns  flops */
   }
   n_count = MaxCG;
   QDPIO::cerr << "Nonconvergence Warning" << std::endl;
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invcg2.h"
+#include "actions/ferm/invert/cg_kernels.h"
 
 using namespace QDP::Hints;
 #undef PAT
@@ -175,14 +176,9 @@ namespace Chroma
 
       RT ar = a;
 
-      r[s] -= ar * mmp;
-      flopcount.addSiteFlops(4*Nc*Ns, s);
-
-      //  cp  =  | r[k] |**2
-      cp = norm2(r, s);    flopcount.addSiteFlops(4*Nc*Ns,s);
-
-      //  Psi[k] += a[k] p[k]
-      psi[s] += ar * p;    flopcount.addSiteFlops(4*Nc*Ns,s);
+      //  Psi[k] += a[k] p[k],  r[k] -= a[k] A . p[k],  cp  =  | r[k] |**2
+      CGKernels::xr_update_normr(psi, r, p, mmp, ar, cp, s);
+      flopcount.addSiteFlops(12*Nc*Ns, s);
 
 
 
@@ -217,7 +213,7 @@ namespace Chroma
       RT br = b;
 
       //  p[k+1] := r[k] + b[k+1] p[k]
-      p[s] = r + br*p;    flopcount.addSiteFlops(4*Nc*Ns,s);
+      CGKernels::p_update(p, r, br, s);    flopcount.addSiteFlops(4*Nc*Ns,s);
     }
     res.n_count = MaxCG;
     res.resid   = sqrt(cp);
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invcg2_array.h"
+#include "actions/ferm/invert/cg_kernels.h"
 
 namespace Chroma 
 {
@@ -73,6 +74,9 @@ namespace Chroma
   {
     START_CODE();
 
+    // Coefficients in the precision of the fields, for the fused updates
+    typedef OScalar< PScalar< PScalar< RScalar< typename WordType<T>::Type_t > > > > RT;
+
     int N = M.size();
     // Subset subs = M.subset();
 
@@ -186,24 +190,23 @@ namespace Chroma
       d = norm2(mp, M.subset()); flopcount.addSiteFlops(4*Nc*Ns*N,M.subset());
 
       a = Real(c)/Real(d);
+      RT ar = a;
 
-      //  Psi[k] += a[k] p[k]
-      for(int n=0; n < N; ++n) {
-	psi[n][ M.subset() ] += a * p[n];	/* 4 Nc Ns  cbsite flops */
-      }
-      flopcount.addSiteFlops(4*Nc*Ns*N,M.subset());
-
-      //  r[k] -= a[k] A . p[k] ;
       //      	       +            +
-      //  r  =  r  -  M(u)  . Mp  =  M  . M . p  =  A . p
+      //  A . p  =  M(u)  . Mp  =  M  . M . p
 
       M(mmp, mp, MINUS);
       flopcount.addFlops(M.nFlops());
 
+      //  Psi[k] += a[k] p[k],  r[k] -= a[k] A . p[k],  cp  =  | r[k] |**2
+      //  one pass over each slice
+      cp = zero;
       for(int n=0; n < N; ++n) {
-	r[n][ M.subset() ] -= a * mmp[n];
+	Double cp_n;
+	CGKernels::xr_update_normr(psi[n], r[n], p[n], mmp[n], ar, cp_n, M.subset());
+	cp += cp_n;
       }
-      flopcount.addSiteFlops(4*Nc*Ns*N, M.subset());
+      flopcount.addSiteFlops(12*Nc*Ns*N, M.subset());
 
 #ifdef PRINT_5D_RESID
       for(int n=0; n < N; n++) {
@@ -215,10 +218,6 @@ namespace Chroma
 
       //  IF |r[k]| <= RsdCG |Chi| THEN RETURN;
 
-      //  cp  =  | r[k] |**2
-      cp = norm2(r, M.subset());	                /* 2 Nc Ns  flops */
-      flopcount.addSiteFlops(4*Nc*Ns*N,M.subset());
-
       //    QDPIO::cout << "InvCG: k = " << k << "  cp = " << cp << std::endl;
 
       if ( toBool(cp  <=  rsd_sq) )
@@ -255,8 +254,9 @@ namespace Chroma
       // QDPIO::cout << "InvCGev: k = " << k << "  alpha = " << a << "  beta = " << b << std::endl;
 #endif 
       //  p[k+1] := r[k] + b[k+1] p[k]
+      RT br = b;
       for(int n=0; n < N; ++n) {
-	p[n][ M.subset() ] = r[n] + b*p[n];	/* Nc Ns  flops */
+	CGKernels::p_update(p[n], r[n], br, M.subset());	/* Nc Ns  flops */
       }
       flopcount.addSiteFlops(4*Nc*Ns*N,M.subset());
     }
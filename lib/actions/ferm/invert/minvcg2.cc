@@ -5,6 +5,7 @@
 
 #include "linearop.h"
 #include "actions/ferm/invert/minvcg2.h"
+#include "actions/ferm/invert/cg_kernels.h"
 #undef PAT
 #ifdef PAT
 #include <pat_api.h>
@@ -247,6 +248,19 @@ namespace Chroma
     Double as;
     Double  bp;
     int k;
+
+    // The update  Psi[k+1] -= b[k] p[k]  of each shift is held back until
+    // the next iteration, where it is done in the same pass over the
+    // shifted p as their update
+    multi1d<R> bs_r(n_shift);
+    multi1d<R> zs_r(n_shift);
+    multi1d<R> as_r(n_shift);
+    multi1d<bool> psi_pending(n_shift);
+    multi1d<bool> do_p(n_shift);
+    for(s = 0; s < n_shift; ++s) {
+      psi_pending[s] = false;
+      bs_r[s] = zs_r[s] = as_r[s] = zero;
+    }
   
     for(k = 1; k <= MaxCG && !convP ; ++k)
     {
@@ -255,22 +269,29 @@ namespace Chroma
 
       // Update p
       R a_r = a;
-      p_0[sub] = r + a_r*p_0;                        flopcount.addSiteFlops(4*Nc*Ns,sub);
+      CGKernels::p_update(p_0, r, a_r, sub);          flopcount.addSiteFlops(4*Nc*Ns,sub);
       //  p[k+1] := r[k+1] + a[k+1] p[k]; 
       //  Compute the shifted as */
       //  ps[k+1] := zs[k+1] r[k+1] + a[k+1] ps[k];
       for(s = 0; s < n_shift; ++s) {
 
 	  // Don't update other p-s if converged.
-	if( ! convsP[s] ) {
+	do_p[s] = ! convsP[s];
+	if( do_p[s] ) {
 
 	  as = a * z[iz][s]*bs[s] / (z[1-iz][s]*b);
-	  R zizs= z[iz][s];
-	  R as_r = as;
-	  p[s][sub] = zizs*r + as_r*p[s];  flopcount.addSiteFlops(6*Nc*Ns,sub);
+	  zs_r[s] = z[iz][s];
+	  as_r[s] = as;
+	  flopcount.addSiteFlops(6*Nc*Ns,sub);
+	}
+	if( psi_pending[s] ) {
+	  flopcount.addSiteFlops(2*Nc*Ns,sub);
 	}
       }
 
+      // The held back Psi updates, then the new ps
+      CGKernels::shift_updates(psi, p, r, bs_r, zs_r, as_r, psi_pending, do_p, sub);
+
       //  cp  =  | r[k] |**2 
       cp = c;
 
@@ -287,10 +308,9 @@ namespace Chroma
       bp = b;
       b = -cp/d;
       //  r[k+1] += b[k] A . p[k] ; 
-      b_r = b;
-      r[sub] += b_r*MMp;                                flopcount.addSiteFlops(4*Nc*Ns,sub);
+      b_r = -b;
       //  c  =  | r[k] |**2 
-      c = norm2(r,sub);	                                   flopcount.addSiteFlops(4*Nc*Ns,sub);
+      CGKernels::r_update_normr(r, MMp, b_r, c, sub);      flopcount.addSiteFlops(8*Nc*Ns,sub);
 
       // Compute the shifted bs and z 
       iz = 1 - iz;
@@ -306,14 +326,13 @@ namespace Chroma
 
 
 
-      //  Psi[k+1] -= b[k] p[k] ; 
+      //  Psi[k+1] -= b[k] p[k] ;  held back until p is next touched
       for(s = 0; s < n_shift; ++s) 
       {
-	if (! convsP[s] ) 
+	psi_pending[s] = ! convsP[s];
+	if ( psi_pending[s] ) 
 	{
-	  R bs_r = bs[s];
-
-	  psi[s][sub] -= bs_r*p[s];                 flopcount.addSiteFlops(2*Nc*Ns,sub);
+	  bs_r[s] = bs[s];
 	}
       }
 
@@ -342,6 +361,15 @@ namespace Chroma
       n_count = k;
     }
 
+    // The last Psi updates
+    for(s = 0; s < n_shift; ++s) {
+      do_p[s] = false;
+      if( psi_pending[s] ) {
+	flopcount.addSiteFlops(2*Nc*Ns,sub);
+      }
+    }
+    CGKernels::shift_updates(psi, p, r, bs_r, zs_r, as_r, psi_pending, do_p, sub);
+
     swatch.stop();
 
 #if 0
@@ -5,6 +5,7 @@
 
 #include "linearop.h"
 #include "actions/ferm/invert/minvcg2_accum.h"
+#include "actions/ferm/invert/cg_kernels.h"
 
 namespace Chroma 
 {
@@ -256,7 +257,7 @@ namespace Chroma
       a = c/cp;
 
       // Update p
-      p_0[sub] = r + Real(a)*p_0;                        flopcount.addSiteFlops(4*Nc*Ns,sub);
+      CGKernels::p_update(p_0, r, Real(a), sub);         flopcount.addSiteFlops(4*Nc*Ns,sub);
       //  p[k+1] := r[k+1] + a[k+1] p[k]; 
       //  Compute the shifted as */
       //  ps[k+1] := zs[k+1] r[k+1] + a[k+1] ps[k];
@@ -286,9 +287,8 @@ namespace Chroma
       bp = b;
       b = -cp/d;
       //  r[k+1] += b[k] A . p[k] ; 
-      r[sub] += Real(b)*MMp;                                flopcount.addSiteFlops(4*Nc*Ns,sub);
       //  c  =  | r[k] |**2 
-      c = norm2(r,sub);	                                   flopcount.addSiteFlops(4*Nc*Ns,sub);
+      CGKernels::r_update_normr(r, MMp, Real(-b), c, sub); flopcount.addSiteFlops(8*Nc*Ns,sub);
 
       // Compute the shifted bs and z 
       iz = 1 - iz;
@@ -5,6 +5,7 @@
 
 #include "linearop.h"
 #include "actions/ferm/invert/minvcg_array.h"
+#include "actions/ferm/invert/cg_kernels.h"
 
 using namespace QDP::Hints;
 
@@ -81,6 +82,9 @@ namespace Chroma
   {
     START_CODE();
 
+    // Coefficients in the precision of the fields, for the fused updates
+    typedef OScalar< PScalar< PScalar< RScalar< typename WordType<T>::Type_t > > > > RT;
+
     // Setup
     const Subset& sub = A.subset();
     int n_shift = shifts.size();
@@ -299,8 +303,9 @@ namespace Chroma
 	// since the other p-s depend on it.
 	if (s == isz) {
 
+	  RT a_r = a;
 	  for(int n=0; n < N; ++n) {
-	    p[s][n][sub] = r[n] + Real(a)*p[s][n];
+	    CGKernels::p_update(p[s][n], r[n], a_r, sub);
 	    //      p[s][n][sub] *= Real(a);	        
 	    //	  p[s][n][sub] += r[n];	                
 	  }
@@ -358,11 +363,15 @@ namespace Chroma
 	}
       }
 
-      //  r[k+1] += b[k] A . p[k] ; 
+      //  r[k+1] += b[k] A . p[k] ;  c  =  | r[k] |**2  in one pass over each slice
+      RT b_r = -b;
+      c = zero;
       for(int n=0; n < N; ++n) {
-	r[n][sub] += Real(b)*Ap[n];
+	Double c_n;
+	CGKernels::r_update_normr(r[n], Ap[n], b_r, c_n, sub);
+	c += c_n;
       }
-      flopcount.addSiteFlops(4*Nc*Ns*N, sub);
+      flopcount.addSiteFlops(8*Nc*Ns*N, sub);
 
       //  Psi[k+1] -= b[k] p[k] ; 
       for(int s = 0; s < n_shift; ++s) {
@@ -374,10 +383,6 @@ namespace Chroma
 	}
       }
 
-      //  c  =  | r[k] |**2 
-      c = norm2(r,sub);	                
-      flopcount.addSiteFlops(4*Nc*Ns*N, sub);
-
       //    IF |psi[k+1] - psi[k]| <= RsdCG |psi[k+1]| THEN RETURN;
       // or IF |r[k+1]| <= RsdCG |chi| THEN RETURN;
       convP = true;
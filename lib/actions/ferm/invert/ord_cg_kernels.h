@@ -0,0 +1,11 @@
+#ifndef  ORD_CG_KERNELS_H
+#define  ORD_CG_KERNELS_H
+
+#ifdef BUILD_AVX2_CG_KERNELS
+#include "ord_cg_kernels_avx2.h"
+#warning "Using AVX2 for CG Kernels"
+#else
+#include "ord_cg_kernels_generic.h"
+#endif
+
+#endif
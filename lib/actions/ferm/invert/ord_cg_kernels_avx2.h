@@ -0,0 +1,264 @@
+// AVX2 single pass CG kernels over an ordered range of sites.
+// Included by cg_kernels_scalarsite.cc within namespace Chroma::CGKernels
+//
+// The site atom is a multiple of 8 floats and 4 doubles. Loads and stores
+// are unaligned, which costs nothing on aligned QDP fields.
+
+// Sum of the squares of v, widened to double before squaring
+inline
+__m256d sq_pd(__m256 v)
+{
+  __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+  __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v,1));
+  return _mm256_add_pd(_mm256_mul_pd(lo,lo), _mm256_mul_pd(hi,hi));
+}
+
+inline
+REAL64 hsum_pd(__m256d v)
+{
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v,1));
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s,s)));
+}
+
+
+inline
+void ord_xr_update_normr_kernel(int lo, int hi, int my_id, ord_xr_update_normr_arg<REAL32>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL32* x_ptr        = &(a->x_ptr[low]);
+  REAL32* r_ptr        = &(a->r_ptr[low]);
+  const REAL32* p_ptr  = &(a->p_ptr[low]);
+  const REAL32* ap_ptr = &(a->ap_ptr[low]);
+
+  __m256  coeff = _mm256_set1_ps(a->a);
+  __m256d norm  = _mm256_setzero_pd();
+
+  for(int count=0; count < len; count+=8)
+  {
+    __m256 x = _mm256_loadu_ps(&x_ptr[count]);
+    x = _mm256_add_ps(x, _mm256_mul_ps(coeff, _mm256_loadu_ps(&p_ptr[count])));
+    _mm256_storeu_ps(&x_ptr[count], x);
+
+    __m256 r = _mm256_loadu_ps(&r_ptr[count]);
+    r = _mm256_sub_ps(r, _mm256_mul_ps(coeff, _mm256_loadu_ps(&ap_ptr[count])));
+    _mm256_storeu_ps(&r_ptr[count], r);
+
+    norm = _mm256_add_pd(norm, sq_pd(r));
+  }
+
+  a->norm_space[CG_NORM_STRIDE*my_id] = hsum_pd(norm);
+}
+
+
+inline
+void ord_xr_update_normr_kernel(int lo, int hi, int my_id, ord_xr_update_normr_arg<REAL64>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL64* x_ptr        = &(a->x_ptr[low]);
+  REAL64* r_ptr        = &(a->r_ptr[low]);
+  const REAL64* p_ptr  = &(a->p_ptr[low]);
+  const REAL64* ap_ptr = &(a->ap_ptr[low]);
+
+  __m256d coeff = _mm256_set1_pd(a->a);
+  __m256d norm  = _mm256_setzero_pd();
+
+  for(int count=0; count < len; count+=4)
+  {
+    __m256d x = _mm256_loadu_pd(&x_ptr[count]);
+    x = _mm256_add_pd(x, _mm256_mul_pd(coeff, _mm256_loadu_pd(&p_ptr[count])));
+    _mm256_storeu_pd(&x_ptr[count], x);
+
+    __m256d r = _mm256_loadu_pd(&r_ptr[count]);
+    r = _mm256_sub_pd(r, _mm256_mul_pd(coeff, _mm256_loadu_pd(&ap_ptr[count])));
+    _mm256_storeu_pd(&r_ptr[count], r);
+
+    norm = _mm256_add_pd(norm, _mm256_mul_pd(r,r));
+  }
+
+  a->norm_space[CG_NORM_STRIDE*my_id] = hsum_pd(norm);
+}
+
+
+inline
+void ord_r_update_normr_kernel(int lo, int hi, int my_id, ord_xr_update_normr_arg<REAL32>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL32* r_ptr        = &(a->r_ptr[low]);
+  const REAL32* ap_ptr = &(a->ap_ptr[low]);
+
+  __m256  coeff = _mm256_set1_ps(a->a);
+  __m256d norm  = _mm256_setzero_pd();
+
+  for(int count=0; count < len; count+=8)
+  {
+    __m256 r = _mm256_loadu_ps(&r_ptr[count]);
+    r = _mm256_sub_ps(r, _mm256_mul_ps(coeff, _mm256_loadu_ps(&ap_ptr[count])));
+    _mm256_storeu_ps(&r_ptr[count], r);
+
+    norm = _mm256_add_pd(norm, sq_pd(r));
+  }
+
+  a->norm_space[CG_NORM_STRIDE*my_id] = hsum_pd(norm);
+}
+
+
+inline
+void ord_r_update_normr_kernel(int lo, int hi, int my_id, ord_xr_update_normr_arg<REAL64>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL64* r_ptr        = &(a->r_ptr[low]);
+  const REAL64* ap_ptr = &(a->ap_ptr[low]);
+
+  __m256d coeff = _mm256_set1_pd(a->a);
+  __m256d norm  = _mm256_setzero_pd();
+
+  for(int count=0; count < len; count+=4)
+  {
+    __m256d r = _mm256_loadu_pd(&r_ptr[count]);
+    r = _mm256_sub_pd(r, _mm256_mul_pd(coeff, _mm256_loadu_pd(&ap_ptr[count])));
+    _mm256_storeu_pd(&r_ptr[count], r);
+
+    norm = _mm256_add_pd(norm, _mm256_mul_pd(r,r));
+  }
+
+  a->norm_space[CG_NORM_STRIDE*my_id] = hsum_pd(norm);
+}
+
+
+inline
+void ord_p_update_kernel(int lo, int hi, int my_id, ord_p_update_arg<REAL32>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL32* p_ptr       = &(a->p_ptr[low]);
+  const REAL32* r_ptr = &(a->r_ptr[low]);
+
+  __m256 coeff = _mm256_set1_ps(a->b);
+
+  for(int count=0; count < len; count+=8)
+  {
+    __m256 p = _mm256_mul_ps(coeff, _mm256_loadu_ps(&p_ptr[count]));
+    _mm256_storeu_ps(&p_ptr[count], _mm256_add_ps(_mm256_loadu_ps(&r_ptr[count]), p));
+  }
+}
+
+
+inline
+void ord_p_update_kernel(int lo, int hi, int my_id, ord_p_update_arg<REAL64>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL64* p_ptr       = &(a->p_ptr[low]);
+  const REAL64* r_ptr = &(a->r_ptr[low]);
+
+  __m256d coeff = _mm256_set1_pd(a->b);
+
+  for(int count=0; count < len; count+=4)
+  {
+    __m256d p = _mm256_mul_pd(coeff, _mm256_loadu_pd(&p_ptr[count]));
+    _mm256_storeu_pd(&p_ptr[count], _mm256_add_pd(_mm256_loadu_pd(&r_ptr[count]), p));
+  }
+}
+
+
+// One site at a time, so r stays in cache while all the shifts use it
+inline
+void ord_shift_updates_kernel(int lo, int hi, int my_id, ord_shift_updates_arg<REAL32>* a)
+{
+  int atom = a->atom;
+
+  for(int site=lo; site < hi; ++site)
+  {
+    const REAL32* r_ptr = &(a->r_ptr[atom*site]);
+
+    for(int i=0; i < a->n_shift; ++i)
+    {
+      REAL32* p_ptr = &(a->p_ptr[i][atom*site]);
+
+      if (a->do_psi[i])
+      {
+	REAL32* psi_ptr = &(a->psi_ptr[i][atom*site]);
+	__m256 bs = _mm256_set1_ps(a->bs[i]);
+
+	for(int count=0; count < atom; count+=8)
+	{
+	  __m256 psi = _mm256_loadu_ps(&psi_ptr[count]);
+	  psi = _mm256_sub_ps(psi, _mm256_mul_ps(bs, _mm256_loadu_ps(&p_ptr[count])));
+	  _mm256_storeu_ps(&psi_ptr[count], psi);
+	}
+      }
+
+      if (a->do_p[i])
+      {
+	__m256 zs = _mm256_set1_ps(a->zs[i]);
+	__m256 as = _mm256_set1_ps(a->as[i]);
+
+	for(int count=0; count < atom; count+=8)
+	{
+	  __m256 p = _mm256_add_ps(_mm256_mul_ps(zs, _mm256_loadu_ps(&r_ptr[count])),
+				   _mm256_mul_ps(as, _mm256_loadu_ps(&p_ptr[count])));
+	  _mm256_storeu_ps(&p_ptr[count], p);
+	}
+      }
+    }
+  }
+}
+
+
+inline
+void ord_shift_updates_kernel(int lo, int hi, int my_id, ord_shift_updates_arg<REAL64>* a)
+{
+  int atom = a->atom;
+
+  for(int site=lo; site < hi; ++site)
+  {
+    const REAL64* r_ptr = &(a->r_ptr[atom*site]);
+
+    for(int i=0; i < a->n_shift; ++i)
+    {
+      REAL64* p_ptr = &(a->p_ptr[i][atom*site]);
+
+      if (a->do_psi[i])
+      {
+	REAL64* psi_ptr = &(a->psi_ptr[i][atom*site]);
+	__m256d bs = _mm256_set1_pd(a->bs[i]);
+
+	for(int count=0; count < atom; count+=4)
+	{
+	  __m256d psi = _mm256_loadu_pd(&psi_ptr[count]);
+	  psi = _mm256_sub_pd(psi, _mm256_mul_pd(bs, _mm256_loadu_pd(&p_ptr[count])));
+	  _mm256_storeu_pd(&psi_ptr[count], psi);
+	}
+      }
+
+      if (a->do_p[i])
+      {
+	__m256d zs = _mm256_set1_pd(a->zs[i]);
+	__m256d as = _mm256_set1_pd(a->as[i]);
+
+	for(int count=0; count < atom; count+=4)
+	{
+	  __m256d p = _mm256_add_pd(_mm256_mul_pd(zs, _mm256_loadu_pd(&r_ptr[count])),
+				    _mm256_mul_pd(as, _mm256_loadu_pd(&p_ptr[count])));
+	  _mm256_storeu_pd(&p_ptr[count], p);
+	}
+      }
+    }
+  }
+}
@@ -0,0 +1,111 @@
+// Generic single pass CG kernels over an ordered range of sites.
+// Included by cg_kernels_scalarsite.cc within namespace Chroma::CGKernels
+
+template<typename REAL>
+inline
+void ord_xr_update_normr_kernel(int lo, int hi, int my_id, ord_xr_update_normr_arg<REAL>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL* x_ptr        = &(a->x_ptr[low]);
+  REAL* r_ptr        = &(a->r_ptr[low]);
+  const REAL* p_ptr  = &(a->p_ptr[low]);
+  const REAL* ap_ptr = &(a->ap_ptr[low]);
+  const REAL  coeff  = a->a;
+
+  REAL64 norm = 0;
+
+  for(int count=0; count < len; ++count)
+  {
+    x_ptr[count] += coeff*p_ptr[count];
+
+    REAL rr = r_ptr[count] - coeff*ap_ptr[count];
+    r_ptr[count] = rr;
+
+    norm += REAL64(rr)*REAL64(rr);
+  }
+
+  a->norm_space[CG_NORM_STRIDE*my_id] = norm;
+}
+
+
+template<typename REAL>
+inline
+void ord_r_update_normr_kernel(int lo, int hi, int my_id, ord_xr_update_normr_arg<REAL>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL* r_ptr        = &(a->r_ptr[low]);
+  const REAL* ap_ptr = &(a->ap_ptr[low]);
+  const REAL  coeff  = a->a;
+
+  REAL64 norm = 0;
+
+  for(int count=0; count < len; ++count)
+  {
+    REAL rr = r_ptr[count] - coeff*ap_ptr[count];
+    r_ptr[count] = rr;
+
+    norm += REAL64(rr)*REAL64(rr);
+  }
+
+  a->norm_space[CG_NORM_STRIDE*my_id] = norm;
+}
+
+
+template<typename REAL>
+inline
+void ord_p_update_kernel(int lo, int hi, int my_id, ord_p_update_arg<REAL>* a)
+{
+  int atom = a->atom;
+  int low  = atom*lo;
+  int len  = atom*(hi-lo);
+
+  REAL* p_ptr       = &(a->p_ptr[low]);
+  const REAL* r_ptr = &(a->r_ptr[low]);
+  const REAL  coeff = a->b;
+
+  for(int count=0; count < len; ++count)
+    p_ptr[count] = r_ptr[count] + coeff*p_ptr[count];
+}
+
+
+// One site at a time, so r stays in cache while all the shifts use it
+template<typename REAL>
+inline
+void ord_shift_updates_kernel(int lo, int hi, int my_id, ord_shift_updates_arg<REAL>* a)
+{
+  int atom = a->atom;
+
+  for(int site=lo; site < hi; ++site)
+  {
+    const REAL* r_ptr = &(a->r_ptr[atom*site]);
+
+    for(int i=0; i < a->n_shift; ++i)
+    {
+      REAL* p_ptr = &(a->p_ptr[i][atom*site]);
+
+      if (a->do_psi[i])
+      {
+	REAL* psi_ptr = &(a->psi_ptr[i][atom*site]);
+	const REAL bs = a->bs[i];
+
+	for(int count=0; count < atom; ++count)
+	  psi_ptr[count] -= bs*p_ptr[count];
+      }
+
+      if (a->do_p[i])
+      {
+	const REAL zs = a->zs[i];
+	const REAL as = a->as[i];
+
+	for(int count=0; count < atom; ++count)
+	  p_ptr[count] = zs*r_ptr[count] + as*p_ptr[count];
+      }
+    }
+  }
+}
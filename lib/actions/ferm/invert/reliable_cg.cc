@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/reliable_cg.h"
+#include "actions/ferm/invert/cg_kernels.h"
 
 namespace Chroma {
 
@@ -84,7 +85,7 @@ RelInvCG_a(const LinearOperator<T>& A,
       else { 
 	Double beta = r_sq / c;
 	RF br = beta;
-	p[s] = r + br*p;  flopcount.addSiteFlops(4*Nc*Ns,s);
+	CGKernels::p_update(p, r, br, s);  flopcount.addSiteFlops(4*Nc*Ns,s);
       }
 
       c = r_sq;
@@ -96,10 +97,8 @@ RelInvCG_a(const LinearOperator<T>& A,
 
       a = c/d;
       RF ar = a;
-      x[s] += ar*p;  
-      r[s] -= ar*mmp; 
-
-      r_sq = norm2(r,s); 
+      //  x += a p,  r -= a A p,  r_sq = |r|^2  in one pass
+      CGKernels::xr_update_normr(x, r, p, mmp, ar, r_sq, s);
       
       //      flopcount.addSiteFlops(4*Nc*Ns,s); <mp, mp>
       //      flopcount.addSiteFlops(4*Nc*Ns,s); x += a * p
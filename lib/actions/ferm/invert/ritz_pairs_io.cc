@@ -0,0 +1,459 @@
+/*! \file
+ *  \brief Save and restore eigCG deflation spaces
+ */
+
+#include "actions/ferm/invert/ritz_pairs_io.h"
+#include "io/milc_io.h"
+#include "io/bulk_io.h"
+#include "qdp_util.h"    // from QDP
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Chroma
+{
+
+  namespace RitzPairsIO
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      const int magic   = 0x52495a50;   // "RIZP"
+      const int version = 1;
+
+      //! Vectors moved per bulk read or write
+      const int chunk = 8;
+
+      //! What the header says about a file
+      struct Header_t
+      {
+	Key_t                key;
+	int                  capacity;
+	int                  num;
+	std::vector<double>  evals;   /*!< of the num pairs */
+      };
+
+      //! Number of 32 bit words in the header
+      int headerWords() {return 9 + Nd;}
+
+      //! Bytes of a vector at one site
+      size_t siteBytes() {return size_t(Ns*Nc*2)*sizeof(REAL32);}
+
+      //! Where the eigenvalue of pair k is
+      size_t evalOffset(int k) {return 4*size_t(headerWords()) + 8*size_t(k);}
+
+      //! Where vector k is
+      size_t vecOffset(int capacity, int k) {return evalOffset(capacity) + size_t(k)*Layout::vol()*siteBytes();}
+
+      //! Append big endian copies of n words
+      template<typename W>
+      void putBig(std::vector<char>& buf, const W* w, int n)
+      {
+	const size_t at = buf.size();
+	buf.resize(at + n*sizeof(W));
+	std::memcpy(&buf[at], w, n*sizeof(W));
+	if (! QDPUtil::big_endian())
+	  QDPUtil::byte_swap((void *)&buf[at], sizeof(W), n);
+      }
+
+
+      //! What readHeader found
+      enum HeaderStatus_t
+      {
+	HEADER_OK,          /*!< a deflation space of this lattice and configuration */
+	HEADER_MISSING,     /*!< no file */
+	HEADER_INVALID,     /*!< not a deflation space of this lattice, or truncated */
+	HEADER_OTHER_KEY    /*!< a deflation space of another configuration */
+      };
+
+
+      //! Read the header and check it belongs to this lattice and configuration. Collective
+      HeaderStatus_t readHeader(Header_t& h, const std::string& file, const Key_t& key)
+      {
+	const long size = BulkIO::fileSize(file);
+	if (size < 0)
+	  return HEADER_MISSING;
+
+	if (size < long(evalOffset(0)))
+	{
+	  QDPIO::cout << "RitzPairsIO: " << file << " is too short for a header" << std::endl;
+	  return HEADER_INVALID;
+	}
+
+	// The reader broadcasts what the primary node reads
+	BinaryFileReader bin(file);
+
+	std::vector<int> w(headerWords());
+	for(int k=0; k < w.size(); ++k)
+	  read(bin, w[k]);
+
+	bool ok = (w[0] == magic) && (w[1] == version) && (w[2] == Nd);
+	for(int mu=0; ok && mu < Nd; ++mu)
+	  ok = (w[3+mu] == Layout::lattSize()[mu]);
+	ok = ok && (w[3+Nd] == Ns) && (w[4+Nd] == Nc);
+
+	if (! ok)
+	{
+	  bin.close();
+	  QDPIO::cout << "RitzPairsIO: " << file << " is not a deflation space of this lattice" << std::endl;
+	  return HEADER_INVALID;
+	}
+
+	h.key.sum29 = (unsigned int)(w[5+Nd]);
+	h.key.sum31 = (unsigned int)(w[6+Nd]);
+	h.capacity  = w[7+Nd];
+	h.num       = w[8+Nd];
+
+	if (h.num < 0 || h.num > h.capacity || size < long(vecOffset(h.capacity, h.num)))
+	{
+	  bin.close();
+	  QDPIO::cout << "RitzPairsIO: " << file << " is truncated" << std::endl;
+	  return HEADER_INVALID;
+	}
+
+	h.evals.resize(h.num);
+	for(int k=0; k < h.num; ++k)
+	  read(bin, h.evals[k]);
+
+	bin.close();
+
+	if (h.key.sum29 != key.sum29 || h.key.sum31 != key.sum31)
+	{
+	  QDPIO::cout << "RitzPairsIO: " << file << " belongs to another configuration" << std::endl;
+	  return HEADER_OTHER_KEY;
+	}
+
+	return HEADER_OK;
+      }
+
+
+      //! Write the header, and evals as the eigenvalues of the pairs from at on, on the primary node. Collective
+      bool writeHeader(const std::string& file, bool create, const Header_t& h,
+		       const std::vector<double>& evals, int at)
+      {
+	int ok = 1;
+
+	if (Layout::primaryNode())
+	{
+	  std::vector<int> w;
+	  w.push_back(magic);
+	  w.push_back(version);
+	  w.push_back(Nd);
+	  for(int mu=0; mu < Nd; ++mu)
+	    w.push_back(Layout::lattSize()[mu]);
+	  w.push_back(Ns);
+	  w.push_back(Nc);
+	  w.push_back(int(h.key.sum29));
+	  w.push_back(int(h.key.sum31));
+	  w.push_back(h.capacity);
+	  w.push_back(h.num);
+
+	  std::vector<char> head, vals;
+	  putBig(head, &w[0], w.size());
+	  if (! evals.empty())
+	    putBig(vals, &evals[0], evals.size());
+
+	  std::fstream f;
+	  if (create)
+	    f.open(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	  else
+	    f.open(file.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+
+	  ok = f.is_open() ? 1 : 0;
+	  if (ok)
+	  {
+	    f.write(&head[0], head.size());
+	    if (! vals.empty())
+	    {
+	      f.seekp(evalOffset(at));
+	      f.write(&vals[0], vals.size());
+	    }
+	    ok = f.good() ? 1 : 0;
+	    f.close();
+	  }
+	}
+
+	QDPInternal::broadcast(ok);
+	return ok != 0;
+      }
+
+
+      //! Holds an fcntl lock on file.lock, taken by the primary node, for as long as it lives. Collective
+      /*!
+       * Serializes the jobs that share a deflation file, as long as the file
+       * system honours fcntl locks. If the lock cannot be taken the file is
+       * used unlocked.
+       */
+      class FileLock
+      {
+      public:
+	FileLock(const std::string& file, bool exclusive) : fd(-1)
+	{
+	  if (Layout::primaryNode())
+	  {
+	    const std::string lock_file = file + ".lock";
+	    fd = ::open(lock_file.c_str(), O_RDWR | O_CREAT, 0644);
+
+	    struct flock fl;
+	    std::memset(&fl, 0, sizeof(fl));
+	    fl.l_type   = exclusive ? F_WRLCK : F_RDLCK;
+	    fl.l_whence = SEEK_SET;
+
+	    if (fd < 0 || ::fcntl(fd, F_SETLKW, &fl) != 0)
+	    {
+	      QDPIO::cout << "RitzPairsIO: could not lock " << lock_file << ", using " << file << " unlocked" << std::endl;
+	      if (fd >= 0)
+		::close(fd);
+	      fd = -1;
+	    }
+	  }
+
+	  // Nobody touches the file before the primary node holds the lock
+	  QDPInternal::broadcast(fd);
+	}
+
+	~FileLock()
+	{
+	  // Everybody is done with the file before it is released
+	  int done = 1;
+	  QDPInternal::broadcast(done);
+
+	  if (Layout::primaryNode() && fd >= 0)
+	    ::close(fd);
+	}
+
+      private:
+	FileLock(const FileLock&);
+	FileLock& operator=(const FileLock&);
+
+	int fd;
+      };
+
+
+#ifndef QDP_IS_QDPJIT
+      //! Pack the vectors [first, first+n) into [vec][site][spin][color][re,im] big endian floats
+      template<typename T>
+      void packVectors(std::vector<char>& buf, const multi1d<T>& vec, int first, int n)
+      {
+	const int    sites = Layout::sitesOnNode();
+	const size_t words = Ns*Nc*2;
+
+	buf.resize(size_t(n)*sites*siteBytes());
+	REAL32* p = reinterpret_cast<REAL32*>(&buf[0]);
+
+	for(int v=0; v < n; ++v)
+	  for(int site=0; site < sites; ++site)
+	  {
+	    REAL32* q = p + (size_t(v)*sites + site)*words;
+
+	    for(int s=0; s < Ns; ++s)
+	      for(int c=0; c < Nc; ++c)
+	      {
+		q[2*(s*Nc+c)]   = vec[first+v].elem(site).elem(s).elem(c).real();
+		q[2*(s*Nc+c)+1] = vec[first+v].elem(site).elem(s).elem(c).imag();
+	      }
+	  }
+
+	if (! QDPUtil::big_endian())
+	  QDPUtil::byte_swap((void *)p, sizeof(REAL32), size_t(n)*sites*words);
+      }
+
+      //! Unpack vector v of a buffer already in host byte order
+      template<typename T>
+      void unpackVector(T& x, const std::vector<char>& buf, int v)
+      {
+	const int    sites = Layout::sitesOnNode();
+	const size_t words = Ns*Nc*2;
+	const REAL32* p = reinterpret_cast<const REAL32*>(&buf[0]);
+
+	for(int site=0; site < sites; ++site)
+	{
+	  const REAL32* q = p + (size_t(v)*sites + site)*words;
+
+	  for(int s=0; s < Ns; ++s)
+	    for(int c=0; c < Nc; ++c)
+	    {
+	      x.elem(site).elem(s).elem(c).real() = q[2*(s*Nc+c)];
+	      x.elem(site).elem(s).elem(c).imag() = q[2*(s*Nc+c)+1];
+	    }
+	}
+      }
+#endif
+
+
+      //! Add the pairs of a file to a deflation space
+      template<typename T>
+      int readPairs(LinAlg::RitzPairs<T>& pairs, const std::string& file,
+		    const Key_t& key, const Subset& sub)
+      {
+#ifdef QDP_IS_QDPJIT
+	QDPIO::cout << "RitzPairsIO: deflation files are not supported in this build" << std::endl;
+	return 0;
+#else
+	FileLock lock(file, false);
+
+	Header_t h;
+	if (readHeader(h, file, key) != HEADER_OK)
+	  return 0;
+
+	const int n = std::min(h.num, pairs.evec.size() - pairs.Neig);
+	T x = zero;
+
+	for(int i=0; i < n; i += chunk)
+	{
+	  const int m = std::min(chunk, n - i);
+	  BulkFileLayout layout = {vecOffset(h.capacity, i), m, siteBytes(), BulkIO::lexicoIndex};
+
+	  std::vector<char> buf;
+	  if (! BulkIO::readBody(buf, file, layout))
+	  {
+	    QDPIO::cout << "RitzPairsIO: could not read the vectors of " << file << std::endl;
+	    return i;
+	  }
+
+	  if (! QDPUtil::big_endian())
+	    QDPUtil::byte_swap((void *)&buf[0], sizeof(REAL32), buf.size()/sizeof(REAL32));
+
+	  for(int k=0; k < m; ++k)
+	  {
+	    unpackVector(x, buf, k);
+	    pairs.AddVector(Double(h.evals[i+k]), x, sub);
+	  }
+	}
+
+	QDPIO::cout << "RitzPairsIO: read " << n << " of the " << h.num << " pairs in " << file << std::endl;
+	return n;
+#endif
+      }
+
+
+      //! Save the pairs [first, pairs.Neig) of a deflation space
+      template<typename T>
+      bool appendPairs(const std::string& file, const LinAlg::RitzPairs<T>& pairs,
+		       int first, const Key_t& key)
+      {
+#ifdef QDP_IS_QDPJIT
+	QDPIO::cout << "RitzPairsIO: deflation files are not supported in this build" << std::endl;
+	return false;
+#else
+	FileLock lock(file, true);
+
+	// Other jobs may have appended since this one read the file, so the
+	// new pairs go after whatever it holds now
+	Header_t h;
+	const HeaderStatus_t status = readHeader(h, file, key);
+
+	if (status == HEADER_OK)
+	{
+	  if (h.num == h.capacity)
+	  {
+	    QDPIO::cout << "RitzPairsIO: " << file << " is full, not adding the new pairs" << std::endl;
+	    return true;
+	  }
+	}
+	else
+	{
+	  // Only a missing file, or one of another lattice or configuration, is replaced
+	  if (status != HEADER_MISSING)
+	    QDPIO::cout << "RitzPairsIO: replacing " << file << std::endl;
+
+	  h.key      = key;
+	  h.capacity = pairs.evec.size();
+	  h.num      = 0;
+
+	  std::vector<double> none;
+	  if (! writeHeader(file, true, h, none, 0))
+	  {
+	    QDPIO::cout << "RitzPairsIO: could not create " << file << std::endl;
+	    return false;
+	  }
+	}
+
+	const int at = h.num;
+	const int num = std::min(pairs.Neig - first, h.capacity - at);
+	if (num < pairs.Neig - first)
+	  QDPIO::cout << "RitzPairsIO: only room for " << num << " of the "
+		      << pairs.Neig - first << " new pairs in " << file << std::endl;
+
+	for(int i=0; i < num; i += chunk)
+	{
+	  const int m = std::min(chunk, num - i);
+	  BulkFileLayout layout = {vecOffset(h.capacity, at + i), m, siteBytes(), BulkIO::lexicoIndex};
+
+	  std::vector<char> buf;
+	  packVectors(buf, pairs.evec.vec, first + i, m);
+
+	  if (! BulkIO::writeBody(file, layout, buf))
+	  {
+	    QDPIO::cout << "RitzPairsIO: could not write the vectors of " << file << std::endl;
+	    return false;
+	  }
+	}
+
+	// Only now count the new pairs, so a failed write leaves a usable file
+	std::vector<double> evals(num);
+	for(int k=0; k < num; ++k)
+	  evals[k] = toDouble(pairs.eval.vec[first + k]);
+
+	h.num = at + num;
+	if (! writeHeader(file, false, h, evals, at))
+	{
+	  QDPIO::cout << "RitzPairsIO: could not update the header of " << file << std::endl;
+	  return false;
+	}
+
+	QDPIO::cout << "RitzPairsIO: wrote pairs " << at << " to " << h.num-1 << " of " << file << std::endl;
+	return true;
+#endif
+      }
+    }
+
+
+    // Key of a configuration
+    Key_t configKey(const multi1d<LatticeColorMatrix>& u)
+    {
+      START_CODE();
+
+      multi1d<LatticeColorMatrixF> uf(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+	uf[mu] = u[mu];
+
+      Key_t key;
+      if (! milcChecksums(key.sum29, key.sum31, uf))
+	QDPIO::cout << "RitzPairsIO: no checksums in this build, deflation files are not tied to a configuration" << std::endl;
+
+      END_CODE();
+
+      return key;
+    }
+
+
+    int readRitzPairs(LinAlg::RitzPairs<LatticeFermionF>& pairs, const std::string& file,
+		      const Key_t& key, const Subset& s)
+    {
+      return readPairs(pairs, file, key, s);
+    }
+
+    int readRitzPairs(LinAlg::RitzPairs<LatticeFermionD>& pairs, const std::string& file,
+		      const Key_t& key, const Subset& s)
+    {
+      return readPairs(pairs, file, key, s);
+    }
+
+    bool appendRitzPairs(const std::string& file, const LinAlg::RitzPairs<LatticeFermionF>& pairs,
+			 int first, const Key_t& key)
+    {
+      return appendPairs(file, pairs, first, key);
+    }
+
+    bool appendRitzPairs(const std::string& file, const LinAlg::RitzPairs<LatticeFermionD>& pairs,
+			 int first, const Key_t& key)
+    {
+      return appendPairs(file, pairs, first, key);
+    }
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,82 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Save and restore eigCG deflation spaces
+ */
+
+#ifndef __ritz_pairs_io_h__
+#define __ritz_pairs_io_h__
+
+#include "chromabase.h"
+#include "actions/ferm/invert/containers.h"
+
+namespace Chroma
+{
+
+  //! Save and restore eigCG deflation spaces
+  /*!
+   * \ingroup invert
+   *
+   * A deflation space is kept in one file so that jobs solving on the same
+   * configuration can carry it over. The file starts with a header of big
+   * endian 32 bit words
+   *
+   *   magic, version, Nd, lattSize[Nd], Ns, Nc, sum29, sum31, capacity, num
+   *
+   * where sum29 and sum31 are the MILC checksums of the links the space was
+   * computed on. Then come capacity big endian doubles for the eigenvalues,
+   * and then the num vectors in single precision, each in lexicographic
+   * site order with spin and color inside the site.
+   *
+   * New pairs are appended after those already in the file and only the
+   * header and their eigenvalues are rewritten, so jobs sharing a file add
+   * to each other's pairs. The jobs take turns through an fcntl lock on
+   * file.lock. The vectors go through BulkIO, so the file has to be visible
+   * from every node.
+   */
+  namespace RitzPairsIO
+  {
+    //! Which gauge configuration a deflation space belongs to
+    struct Key_t
+    {
+      Key_t() : sum29(0), sum31(0) {}
+
+      unsigned int sum29;
+      unsigned int sum31;
+    };
+
+    //! Key of a configuration, from the MILC checksums of its links. Collective
+    Key_t configKey(const multi1d<LatticeColorMatrix>& u);
+
+    //! Add the pairs of a file to a deflation space. Collective
+    /*!
+     * Only as many pairs as fit are read. The vectors are only set on the subset.
+     *
+     * \return the number of pairs read, 0 if the file is missing, unreadable
+     *         or belongs to another configuration
+     */
+    int readRitzPairs(LinAlg::RitzPairs<LatticeFermionF>& pairs, const std::string& file,
+		      const Key_t& key, const Subset& s);
+
+    //! Add the pairs of a file to a deflation space. Collective
+    int readRitzPairs(LinAlg::RitzPairs<LatticeFermionD>& pairs, const std::string& file,
+		      const Key_t& key, const Subset& s);
+
+    //! Save the pairs [first, pairs.Neig) of a deflation space. Collective
+    /*!
+     * They are appended after the pairs the file holds, as far as it has
+     * room. Only a missing file, or one of another lattice or configuration,
+     * is written again from scratch.
+     *
+     * \return false if the file could not be written
+     */
+    bool appendRitzPairs(const std::string& file, const LinAlg::RitzPairs<LatticeFermionF>& pairs,
+			 int first, const Key_t& key);
+
+    //! Save the pairs [first, pairs.Neig) of a deflation space. Collective
+    bool appendRitzPairs(const std::string& file, const LinAlg::RitzPairs<LatticeFermionD>& pairs,
+			 int first, const Key_t& key);
+  }
+
+}  // end namespace Chroma
+
+#endif
@@ -28,7 +28,8 @@ namespace Chroma
     read(inputtop, "read", input.read);
     read(inputtop, "write", input.write);
     read(inputtop, "file_name", input.file_name);
-    read(inputtop, "file_volfmt", input.file_volfmt);
+    if (inputtop.count("file_volfmt") > 0)
+      read(inputtop, "file_volfmt", input.file_volfmt);
   }
 
 
@@ -55,8 +55,8 @@ namespace Chroma
    
     struct File_t
     {
-      bool read ; 
-      bool write ;
+      bool read ;                /*!< warm start the deflation space from file_name */
+      bool write ;               /*!< append new Ritz pairs to file_name */
       std::string   file_name;
       QDP_volfmt_t  file_volfmt;
     } file;
@@ -6,6 +6,8 @@
 #include "actions/ferm/invert/syssolver_linop_aggregate.h"
 
 #include "actions/ferm/invert/syssolver_linop_cg.h"
+#include "actions/ferm/invert/syssolver_linop_block_cg.h"
+#include "actions/ferm/invert/syssolver_linop_block_bicgstab.h"
 #include "actions/ferm/invert/syssolver_linop_bicgstab.h"
 #include "actions/ferm/invert/syssolver_linop_ibicgstab.h"
 #include "actions/ferm/invert/syssolver_linop_bicrstab.h"
@@ -18,6 +20,7 @@
 #include "actions/ferm/invert/syssolver_linop_rel_ibicgstab_clover.h"
 #include "actions/ferm/invert/syssolver_linop_rel_cg_clover.h"
 #include "actions/ferm/invert/syssolver_linop_fgmres_dr.h"
+#include "actions/ferm/invert/syssolver_linop_mixed_prec_refine.h"
 
 
 #include "chroma_config.h"
@@ -70,6 +73,8 @@ namespace Chroma
       {
 	// 4D system solvers
 	success &= LinOpSysSolverCGEnv::registerAll();
+	success &= LinOpSysSolverBlockCGEnv::registerAll();
+	success &= LinOpSysSolverBlockBiCGStabEnv::registerAll();
 	success &= LinOpSysSolverBiCGStabEnv::registerAll();
 	success &= LinOpSysSolverBiCRStabEnv::registerAll();
 	success &= LinOpSysSolverIBiCGStabEnv::registerAll();
@@ -82,6 +87,7 @@ namespace Chroma
 	success &= LinOpSysSolverReliableIBiCGStabCloverEnv::registerAll();
 	success &= LinOpSysSolverReliableCGCloverEnv::registerAll();
 	success &= LinOpSysSolverFGMRESDREnv::registerAll();
+	success &= LinOpSysSolverMixedPrecRefineEnv::registerAll();
 
 #ifdef BUILD_QUDA
 	success &= LinOpSysSolverQUDACloverEnv::registerAll();
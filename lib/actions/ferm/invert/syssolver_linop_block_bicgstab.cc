@@ -0,0 +1,53 @@
+/*! \file
+ *  \brief Solve M*psi=chi linear systems for several sources by block BiCGStab
+ */
+
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_aggregate.h"
+
+#include "actions/ferm/invert/syssolver_linop_block_bicgstab.h"
+
+namespace Chroma
+{
+
+  //! Block BiCGStab system solver namespace
+  namespace LinOpSysSolverBlockBiCGStabEnv
+  {
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverBlockBiCGStab<LatticeFermion>(A, SysSolverBiCGStabParams(xml_in, path));
+    }
+
+    //! Callback function
+    LinOpSystemSolver<LatticeFermionF>* createFermF(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermionF, multi1d<LatticeColorMatrixF>, multi1d<LatticeColorMatrixF> > > state,
+						  Handle< LinearOperator<LatticeFermionF> > A)
+    {
+      return new LinOpSysSolverBlockBiCGStab<LatticeFermionF>(A, SysSolverBiCGStabParams(xml_in, path));
+    }
+
+    //! Name to be used
+    const std::string name("BLOCK_BICGSTAB_INVERTER");
+
+    //! Local registration flag
+    static bool registered = false;
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	success &= Chroma::TheLinOpFFermSystemSolverFactory::Instance().registerObject(name, createFermF);
+	registered = true;
+      }
+      return success;
+    }
+  }
+}
@@ -0,0 +1,130 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve M*psi=chi linear systems for several sources by block BiCGStab
+ */
+
+#ifndef __syssolver_linop_block_bicgstab_h__
+#define __syssolver_linop_block_bicgstab_h__
+#include "chroma_config.h"
+#include "handle.h"
+#include "syssolver.h"
+#include "linearop.h"
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_bicgstab_params.h"
+#include "actions/ferm/invert/invblock_bicgstab.h"
+
+
+namespace Chroma
+{
+
+  //! Block BiCGStab system solver namespace
+  namespace LinOpSysSolverBlockBiCGStabEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve M*psi=chi linear systems for several sources by block BiCGStab
+  /*! \ingroup invert
+   *
+   * The sources of one call share a Krylov space, see InvBlockBiCGStab.
+   */
+  template<typename T>
+  class LinOpSysSolverBlockBiCGStab : public LinOpSystemSolver<T>
+  {
+  public:
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    LinOpSysSolverBlockBiCGStab(Handle< LinearOperator<T> > A_,
+				const SysSolverBiCGStabParams& invParam_) :
+      A(A_), invParam(invParam_)
+      {}
+
+    //! Destructor is automatic
+    ~LinOpSysSolverBlockBiCGStab() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! The sources share one Krylov space
+    bool blockP() const {return true;}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+    {
+      multi1d<T> psi_v(1);
+      multi1d<T> chi_v(1);
+      psi_v[0] = psi;
+      chi_v[0] = chi;
+
+      multi1d<SystemSolverResults_t> res = (*this)(psi_v, chi_v);
+
+      psi = psi_v[0];
+      return res[0];
+    }
+
+    //! Solver the linear systems
+    /*!
+     * \param psi      solutions ( Modify )
+     * \param chi      sources ( Read )
+     * \return syssolver results for each source
+     */
+    multi1d<SystemSolverResults_t> operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+    {
+      START_CODE();
+      StopWatch swatch;
+      swatch.start();
+
+      // For now solve with PLUS until we add a way to explicitly
+      // ask for MINUS
+      multi1d<SystemSolverResults_t> res = InvBlockBiCGStab(*A,
+							     chi,
+							     psi,
+							     invParam.RsdBiCGStab,
+							     invParam.MaxBiCGStab,
+							     PLUS);
+
+      swatch.stop();
+      double time = swatch.getTimeInSeconds();
+
+      for(int n=0; n < chi.size(); ++n)
+      {
+	T r;
+	r[A->subset()]=chi[n];
+	T tmp;
+	(*A)(tmp, psi[n], PLUS);
+	r[A->subset()] -= tmp;
+	res[n].resid = sqrt(norm2(r, A->subset()));
+
+	QDPIO::cout << "BLOCK_BICGSTAB_SOLVER: source " << n << ": " << res[n].n_count
+		    << " iterations. Rsd = " << res[n].resid
+		    << " Relative Rsd = " << res[n].resid/sqrt(norm2(chi[n],A->subset())) << std::endl;
+      }
+      QDPIO::cout << "BLOCK_BICGSTAB_SOLVER_TIME: "<<time<< " sec" << std::endl;
+
+      END_CODE();
+
+      return res;
+    }
+
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverBlockBiCGStab() {}
+
+    Handle< LinearOperator<T> > A;
+    SysSolverBiCGStabParams invParam;
+  };
+
+} // End namespace
+
+#endif
@@ -0,0 +1,129 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve M*psi=chi linear systems for several sources by block CG
+ */
+
+#ifndef __syssolver_linop_block_cg_h__
+#define __syssolver_linop_block_cg_h__
+#include "chroma_config.h"
+#include "handle.h"
+#include "syssolver.h"
+#include "linearop.h"
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_cg_params.h"
+#include "actions/ferm/invert/invblock_cg.h"
+
+
+namespace Chroma
+{
+
+  //! Block CG system solver namespace
+  namespace LinOpSysSolverBlockCGEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve M*psi=chi linear systems for several sources by block CG
+  /*! \ingroup invert
+   *
+   * The sources of one call share a Krylov space, see InvBlockCG2. A
+   * single source is a block of one, which is plain CG.
+   */
+  template<typename T>
+  class LinOpSysSolverBlockCG : public LinOpSystemSolver<T>
+  {
+  public:
+    //! Constructor
+    /*!
+     * \param M_        Linear operator ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    LinOpSysSolverBlockCG(Handle< LinearOperator<T> > A_,
+			  const SysSolverCGParams& invParam_) :
+      A(A_), invParam(invParam_)
+      {}
+
+    //! Destructor is automatic
+    ~LinOpSysSolverBlockCG() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! The sources share one Krylov space
+    bool blockP() const {return true;}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+      {
+	multi1d<T> psi_v(1);
+	multi1d<T> chi_v(1);
+	psi_v[0] = psi;
+	chi_v[0] = chi;
+
+	multi1d<SystemSolverResults_t> res = (*this)(psi_v, chi_v);
+
+	psi = psi_v[0];
+	return res[0];
+      }
+
+    //! Solver the linear systems
+    /*!
+     * \param psi      solutions ( Modify )
+     * \param chi      sources ( Read )
+     * \return syssolver results for each source
+     */
+    multi1d<SystemSolverResults_t> operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+      {
+	START_CODE();
+	StopWatch swatch;
+	swatch.reset();
+	swatch.start();
+
+	multi1d<T> chi_tmp(chi.size());
+	for(int n=0; n < chi.size(); ++n)
+	  (*A)(chi_tmp[n], chi[n], MINUS);
+
+	multi1d<SystemSolverResults_t> res = InvBlockCG2(*A, chi_tmp, psi, invParam.RsdCG, invParam.MaxCG);
+
+	swatch.stop();
+	double time = swatch.getTimeInSeconds();
+
+	for(int n=0; n < chi.size(); ++n)
+	{
+	  T r;
+	  r[A->subset()]=chi[n];
+	  T tmp;
+	  (*A)(tmp, psi[n], PLUS);
+	  r[A->subset()] -= tmp;
+	  res[n].resid = sqrt(norm2(r, A->subset()));
+
+	  QDPIO::cout << "BLOCK_CG_SOLVER: source " << n << ": " << res[n].n_count
+		      << " iterations. Rsd = " << res[n].resid
+		      << " Relative Rsd = " << res[n].resid/sqrt(norm2(chi[n],A->subset())) << std::endl;
+	}
+	QDPIO::cout << "BLOCK_CG_SOLVER_TIME: "<<time<< " sec" << std::endl;
+
+	END_CODE();
+
+	return res;
+      }
+
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverBlockCG() {}
+
+    Handle< LinearOperator<T> > A;
+    SysSolverCGParams invParam;
+  };
+
+} // End namespace
+
+#endif
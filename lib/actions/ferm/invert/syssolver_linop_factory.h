@@ -13,6 +13,7 @@
 #include "typelist.h"
 #include "objfactory.h"
 #include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_profile.h"
 
 namespace Chroma
 {
@@ -27,39 +28,36 @@ namespace Chroma
   //! LinOp system solver factory (foundry)
   /*! @ingroup invert */
   typedef SingletonHolder< 
-    ObjectFactory<LinOpSystemSolver<LatticeFermion>, 
-		  std::string,
+    ProfiledSolverFactory<LinOpSystemSolver<LatticeFermion>,
+		  ProfiledLinOpSystemSolver<LatticeFermion>,
 		  TYPELIST_4(XMLReader&, const std::string&, FSHandle,  Handle< LinearOperator<LatticeFermion> >),
 		  LinOpSystemSolver<LatticeFermion>* (*)(XMLReader&,
 							 const std::string&,
 
 							 FSHandle,
-							 Handle< LinearOperator<LatticeFermion> >), 
-		  StringFactoryError> >
+							 Handle< LinearOperator<LatticeFermion> >)> >
   TheLinOpFermSystemSolverFactory;
 
   typedef SingletonHolder< 
-    ObjectFactory<LinOpSystemSolver<LatticeFermionF>, 
-		  std::string,
+    ProfiledSolverFactory<LinOpSystemSolver<LatticeFermionF>,
+		  ProfiledLinOpSystemSolver<LatticeFermionF>,
 		  TYPELIST_4(XMLReader&, const std::string&, FSHandleF,  Handle< LinearOperator<LatticeFermionF> >),
 		  LinOpSystemSolver<LatticeFermionF>* (*)(XMLReader&,
 							 const std::string&,
 
 							 FSHandleF,
-							 Handle< LinearOperator<LatticeFermionF> >), 
-		  StringFactoryError> >
+							 Handle< LinearOperator<LatticeFermionF> >)> >
   TheLinOpFFermSystemSolverFactory;
 
   typedef SingletonHolder< 
-    ObjectFactory<LinOpSystemSolver<LatticeFermionD>, 
-		  std::string,
+    ProfiledSolverFactory<LinOpSystemSolver<LatticeFermionD>,
+		  ProfiledLinOpSystemSolver<LatticeFermionD>,
 		  TYPELIST_4(XMLReader&, const std::string&, FSHandleD,  Handle< LinearOperator<LatticeFermionD> >),
 		  LinOpSystemSolver<LatticeFermionD>* (*)(XMLReader&,
 							 const std::string&,
 
 							 FSHandleD,
-							 Handle< LinearOperator<LatticeFermionD> >), 
-		  StringFactoryError> >
+							 Handle< LinearOperator<LatticeFermionD> >)> >
   TheLinOpDFermSystemSolverFactory;
 
 
@@ -81,13 +79,12 @@ namespace Chroma
   //! LinOp system solver factory (foundry)
   /*! @ingroup invert */
   typedef SingletonHolder< 
-    ObjectFactory<LinOpSystemSolver<LatticeStaggeredFermion>, 
-		  std::string,
+    ProfiledSolverFactory<LinOpSystemSolver<LatticeStaggeredFermion>,
+		  ProfiledLinOpSystemSolver<LatticeStaggeredFermion>,
 		  TYPELIST_3(XMLReader&, const std::string&, Handle< LinearOperator<LatticeStaggeredFermion> >),
 		  LinOpSystemSolver<LatticeStaggeredFermion>* (*)(XMLReader&,
 								  const std::string&,
-								  Handle< LinearOperator<LatticeStaggeredFermion> >), 
-		  StringFactoryError> >
+								  Handle< LinearOperator<LatticeStaggeredFermion> >)> >
   TheLinOpStagFermSystemSolverFactory;
 
 
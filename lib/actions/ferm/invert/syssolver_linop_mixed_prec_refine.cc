@@ -0,0 +1,48 @@
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by mixed precision defect correction
+ */
+
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_aggregate.h"
+
+#include "actions/ferm/invert/syssolver_linop_mixed_prec_refine.h"
+
+namespace Chroma
+{
+
+  //! Mixed precision defect correction system solver namespace
+  namespace LinOpSysSolverMixedPrecRefineEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! Name to be used
+      const std::string name("MIXED_PREC_REFINE_INVERTER");
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverMixedPrecRefine(A, state, SysSolverMixedPrecRefineParams(xml_in, path));
+    }
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+}
@@ -0,0 +1,161 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by mixed precision defect correction
+ */
+
+#ifndef __syssolver_linop_mixed_prec_refine_h__
+#define __syssolver_linop_mixed_prec_refine_h__
+#include "chroma_config.h"
+
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+#include "actions/ferm/linop/eoprec_clover_dumb_linop_w.h"
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_mixed_prec_refine_params.h"
+#include "actions/ferm/invert/inv_mixed_prec_refine.h"
+
+namespace Chroma
+{
+
+  //! Mixed precision defect correction system solver namespace
+  namespace LinOpSysSolverMixedPrecRefineEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system by mixed precision defect correction
+  /*! \ingroup invert
+   *
+   * The inner solver named in InnerSolverParams comes from the single
+   * precision factory. The corrections are accumulated, and the residual
+   * recomputed, in full precision. See InvMixedPrecRefine.
+   *
+   * Only for 4D even-odd preconditioned clover or Wilson (clovCoeff 0)
+   * actions: the inner operator is built in single precision from the
+   * CloverParams and single precision links, so the whole inner solve
+   * runs in single precision. It is checked against the operator of the
+   * action once. There are no single precision operators for the other
+   * actions, 5D ones included, so they cannot use this solver.
+   */
+  class LinOpSysSolverMixedPrecRefine : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    typedef LatticeFermion T;
+    typedef multi1d<LatticeColorMatrix> Q;
+
+    typedef LatticeFermionF TF;
+    typedef multi1d<LatticeColorMatrixF> QF;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    LinOpSysSolverMixedPrecRefine(Handle< LinearOperator<T> > A_,
+				  Handle< FermState<T,Q,Q> > state_,
+				  const SysSolverMixedPrecRefineParams& invParam_) :
+      A(A_), invParam(invParam_)
+    {
+      // Single precision copy of the (possibly smeared, BC applied) links
+      QF links_single(Nd);
+      const Q& links = state_->getLinks();
+      for(int mu=0; mu < Nd; mu++)
+	links_single[mu] = links[mu];
+
+      fstate_single = new PeriodicFermState<TF,QF,QF>(links_single);
+
+      A_single = new EvenOddPrecDumbCloverFLinOp(fstate_single, invParam.clovParams);
+      checkSingle();
+
+      std::istringstream is(invParam.innerSolverParams.xml);
+      XMLReader paramtop(is);
+
+      DInv = TheLinOpFFermSystemSolverFactory::Instance().createObject(invParam.innerSolverParams.id,
+								       paramtop,
+								       invParam.innerSolverParams.path,
+								       fstate_single,
+								       A_single);
+    }
+
+    //! Destructor is automatic
+    ~LinOpSysSolverMixedPrecRefine() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+    {
+      START_CODE();
+      StopWatch swatch;
+      swatch.start();
+
+      SystemSolverResults_t res = InvMixedPrecRefine(*DInv, *A, chi, psi,
+						     invParam.RsdTarget, invParam.MaxIter);
+
+      swatch.stop();
+      double time = swatch.getTimeInSeconds();
+
+      QDPIO::cout << "MIXED_PREC_REFINE_SOLVER: " << res.n_count << " iterations. Rsd = " << res.resid
+		  << " Relative Rsd = " << res.resid/sqrt(norm2(chi,A->subset())) << std::endl;
+      QDPIO::cout << "MIXED_PREC_REFINE_SOLVER_TIME: "<<time<< " sec" << std::endl;
+
+      END_CODE();
+
+      return res;
+    }
+
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverMixedPrecRefine() {}
+
+    //! Abort unless the single precision operator is the one of the action
+    void checkSingle() const
+    {
+      const Subset& sub = A->subset();
+
+      TF psi_f, chi_f = zero;
+      gaussian(psi_f);
+
+      T psi, chi, chi_s = zero;
+      psi = psi_f;
+
+      (*A)(chi, psi, PLUS);
+      (*A_single)(chi_f, psi_f, PLUS);
+      chi_s[sub] = chi_f;
+
+      Double rel = sqrt(norm2(chi - chi_s, sub) / norm2(chi, sub));
+      if (toDouble(rel) > 1.0e-4)
+      {
+	QDPIO::cerr << "MIXED_PREC_REFINE_SOLVER: the operator built from CloverParams differs from the one of the action, relative difference = "
+		    << rel << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    Handle< LinearOperator<T> > A;
+    SysSolverMixedPrecRefineParams invParam;
+
+    // Created and initialized here.
+    Handle< FermState<TF,QF,QF> > fstate_single;
+    Handle< LinearOperator<TF> > A_single;
+    Handle< LinOpSystemSolver<TF> > DInv;
+  };
+
+} // End namespace
+
+#endif 
+
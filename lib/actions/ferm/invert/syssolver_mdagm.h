@@ -25,6 +25,8 @@ namespace Chroma
   class MdagMSystemSolver : public SystemSolver<T>
   {    
   public:
+    using SystemSolver<T>::operator();
+
     virtual SystemSolverResults_t operator() (T& psi, const T& chi) const = 0;
 
     //! Return the subset on which the operator acts
@@ -28,7 +28,14 @@ namespace Chroma
 
 						  Handle< LinearOperator<LatticeFermion> > A)
     {
-      return new MdagMSysSolverQDPEigCG<LatticeFermion>(A, SysSolverEigCGParams(xml_in, path));
+      SysSolverEigCGParams invParam(xml_in, path);
+
+      // Deflation files are tied to the configuration
+      RitzPairsIO::Key_t key;
+      if (invParam.file.read || invParam.file.write)
+	key = RitzPairsIO::configKey(state->getLinks());
+
+      return new MdagMSysSolverQDPEigCG<LatticeFermion>(A, invParam, key);
     }
 
 #if 0
@@ -76,7 +83,8 @@ namespace Chroma
     SystemSolverResults_t sysSolver(T& psi, const T& chi, 
 				    const LinearOperator<T>& A,
 				    const LinearOperator<T>& MdagM, 
-				    const SysSolverEigCGParams& invParam)
+				    const SysSolverEigCGParams& invParam,
+				    const RitzPairsIO::Key_t& key)
     {
       START_CODE();
 
@@ -119,6 +127,7 @@ namespace Chroma
 
 	    snoop.reset();
 	    snoop.start();
+	    int Nold = GoodEvecs.Neig;
 	    GoodEvecs.AddVectors(lambda, evec, MdagM.subset());
 	    snoop.stop();
 	    double Time = snoop.getTimeInSeconds() ;
@@ -128,6 +137,11 @@ namespace Chroma
 	    normGramSchmidt(GoodEvecs.evec.vec,GoodEvecs.Neig-invParam.Neig,GoodEvecs.Neig,MdagM.subset());
 	    snoop.stop();
 	    Time += snoop.getTimeInSeconds() ;
+
+	    // The new vectors are now orthogonal to the old ones, so they
+	    // extend what is already in the file
+	    if (invParam.file.write)
+	      RitzPairsIO::appendRitzPairs(invParam.file.file_name, GoodEvecs, Nold, key);
 	  
 	    snoop.start();
 	    LinAlg::Matrix<DComplex> Htmp(GoodEvecs.Neig) ;
@@ -229,9 +243,84 @@ namespace Chroma
       return res;
     }
 
+
+    //! Read the saved pairs and refine them
+    /*!
+     * The file holds single precision vectors that may have been appended
+     * by several jobs, so they are orthonormalized again and rotated onto
+     * the Ritz vectors of MdagM on the space they span.
+     */
+    template<typename T>
+    void readAndRefine(LinAlg::RitzPairs<T>& GoodEvecs,
+		       const LinearOperator<T>& MdagM,
+		       const SysSolverEigCGParams& invParam,
+		       const RitzPairsIO::Key_t& key)
+    {
+      START_CODE();
+
+      StopWatch snoop;
+      snoop.reset();
+      snoop.start();
+
+      int n = RitzPairsIO::readRitzPairs(GoodEvecs, invParam.file.file_name, key, MdagM.subset());
+      if (n == 0)
+      {
+	END_CODE();
+	return;
+      }
+
+      normGramSchmidt(GoodEvecs.evec.vec,0,GoodEvecs.Neig,MdagM.subset());
+      normGramSchmidt(GoodEvecs.evec.vec,0,GoodEvecs.Neig,MdagM.subset());
+
+      LinAlg::Matrix<DComplex> Htmp(GoodEvecs.Neig) ;
+      InvEigCG2Env::SubSpaceMatrix(Htmp,MdagM,GoodEvecs.evec.vec,GoodEvecs.Neig);
+
+      multi1d<Double> lambda ;
+      char V = 'V' ; char U = 'U' ;
+      QDPLapack::zheev(V,U,Htmp.mat,lambda);
+
+      multi1d<T> evec(GoodEvecs.Neig) ;
+      for(int k(0);k<GoodEvecs.Neig;k++){
+	GoodEvecs.eval[k] = lambda[k];
+	evec[k][MdagM.subset()] = zero ;
+	for(int j(0);j<GoodEvecs.Neig;j++)
+	  evec[k][MdagM.subset()] += conj(Htmp(k,j))*GoodEvecs.evec[j] ;
+      }
+      for(int k(0);k<GoodEvecs.Neig;k++)
+	GoodEvecs.evec[k][MdagM.subset()]  = evec[k] ;
+
+      snoop.stop();
+      QDPIO::cout << "EigCG warm start: " << GoodEvecs.Neig << " vectors, time = "
+		  << snoop.getTimeInSeconds() << " secs" << std::endl;
+
+      END_CODE();
+    }
+
   } // anonymous namespace
 
 
+  namespace MdagMSysSolverQDPEigCGEnv
+  {
+    // Warm start a deflation space
+    void warmStart(LinAlg::RitzPairs<LatticeFermionF>& pairs,
+		   const LinearOperator<LatticeFermionF>& MdagM,
+		   const SysSolverEigCGParams& invParam,
+		   const RitzPairsIO::Key_t& key)
+    {
+      readAndRefine(pairs, MdagM, invParam, key);
+    }
+
+    // Warm start a deflation space
+    void warmStart(LinAlg::RitzPairs<LatticeFermionD>& pairs,
+		   const LinearOperator<LatticeFermionD>& MdagM,
+		   const SysSolverEigCGParams& invParam,
+		   const RitzPairsIO::Key_t& key)
+    {
+      readAndRefine(pairs, MdagM, invParam, key);
+    }
+  }
+
+
   //
   // Wrappers
   //
@@ -241,7 +330,7 @@ namespace Chroma
   SystemSolverResults_t
   MdagMSysSolverQDPEigCG<LatticeFermionF>::operator()(LatticeFermionF& psi, const LatticeFermionF& chi) const
   {
-    return sysSolver(psi, chi, *A, *MdagM, invParam);
+    return sysSolver(psi, chi, *A, *MdagM, invParam, key);
   }
 
   // LatticeFermionD
@@ -249,7 +338,7 @@ namespace Chroma
   SystemSolverResults_t
   MdagMSysSolverQDPEigCG<LatticeFermionD>::operator()(LatticeFermionD& psi, const LatticeFermionD& chi) const
   {
-    return sysSolver(psi, chi, *A, *MdagM, invParam);
+    return sysSolver(psi, chi, *A, *MdagM, invParam, key);
   }
 
 #if 0
@@ -259,7 +348,7 @@ namespace Chroma
   SystemSolverResults_t
   MdagMSysSolverQDPEigCG<LatticeStaggeredFermionF>::operator()(LatticeStaggeredFermionF& psi, const LatticeStaggeredFermionF& chi) const
   {
-    return sysSolver(psi, chi, *A, *MdagM, invParam);
+    return sysSolver(psi, chi, *A, *MdagM, invParam, key);
   }
 
   // LatticeStaggeredFermionD
@@ -267,7 +356,7 @@ namespace Chroma
   SystemSolverResults_t
   MdagMSysSolverQDPEigCG<LatticeStaggeredFermionD>::operator()(LatticeStaggeredFermionD& psi, const LatticeStaggeredFermionD& chi) const
   {
-    return sysSolver(psi, chi, *A, *MdagM, invParam);
+    return sysSolver(psi, chi, *A, *MdagM, invParam, key);
   }
 #endif
 
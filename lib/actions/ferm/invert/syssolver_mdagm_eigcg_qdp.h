@@ -16,6 +16,7 @@
 #include "actions/ferm/invert/syssolver_mdagm.h"
 #include "actions/ferm/invert/syssolver_eigcg_params.h"
 #include "actions/ferm/invert/containers.h"
+#include "actions/ferm/invert/ritz_pairs_io.h"
 
 namespace Chroma
 {
@@ -25,11 +26,27 @@ namespace Chroma
   {
     //! Register the syssolver
     bool registerAll();
+
+    //! Warm start a deflation space from invParam.file and refine it with MdagM
+    void warmStart(LinAlg::RitzPairs<LatticeFermionF>& pairs,
+		   const LinearOperator<LatticeFermionF>& MdagM,
+		   const SysSolverEigCGParams& invParam,
+		   const RitzPairsIO::Key_t& key);
+
+    //! Warm start a deflation space from invParam.file and refine it with MdagM
+    void warmStart(LinAlg::RitzPairs<LatticeFermionD>& pairs,
+		   const LinearOperator<LatticeFermionD>& MdagM,
+		   const SysSolverEigCGParams& invParam,
+		   const RitzPairsIO::Key_t& key);
   }
 
 
   //! Solve a M*psi=chi linear system by CG2 with eigenvectors
   /*! \ingroup invert
+   *
+   * With FileIO/read the deflation space starts from the pairs saved in
+   * FileIO/file_name for the same configuration. With FileIO/write each
+   * batch of new pairs is appended to that file, see RitzPairsIO.
    */
   template<typename T>
   class MdagMSysSolverQDPEigCG : public MdagMSystemSolver<T>
@@ -39,10 +56,12 @@ namespace Chroma
     /*!
      * \param M_         Linear operator ( Read )
      * \param invParam_  inverter parameters ( Read )
+     * \param key_       configuration the deflation file belongs to ( Read )
      */
     MdagMSysSolverQDPEigCG(Handle< LinearOperator<T> > A_,
-			   const SysSolverEigCGParams& invParam_) : 
-      MdagM(new MdagMLinOp<T>(A_)), A(A_), invParam(invParam_) 
+			   const SysSolverEigCGParams& invParam_,
+			   const RitzPairsIO::Key_t& key_ = RitzPairsIO::Key_t()) : 
+      MdagM(new MdagMLinOp<T>(A_)), A(A_), invParam(invParam_), key(key_)
       {
 	// NEED to grab the eignvectors from the named buffer here
 	if (! TheNamedObjMap::Instance().check(invParam.eigen_id))
@@ -57,6 +76,9 @@ namespace Chroma
 	  else{
 	    GoodEvecs.init(invParam.Neig);
 	  }
+
+	  if (invParam.file.read)
+	    MdagMSysSolverQDPEigCGEnv::warmStart(GoodEvecs, *MdagM, invParam, key);
 	}
       }
 
@@ -119,6 +141,7 @@ namespace Chroma
     Handle< LinearOperator<T> > MdagM;
     Handle< LinearOperator<T> > A;
     SysSolverEigCGParams invParam;
+    RitzPairsIO::Key_t key;
   };
 
 } // End namespace
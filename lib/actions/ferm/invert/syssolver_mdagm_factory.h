@@ -13,6 +13,7 @@
 #include "linearop.h"
 #include "typelist.h"
 #include "actions/ferm/invert/syssolver_mdagm.h"
+#include "actions/ferm/invert/syssolver_profile.h"
 
 using namespace QDP;
 
@@ -28,36 +29,33 @@ namespace Chroma
   //! MdagM system solver factory (foundry)
   /*! @ingroup invert */
   typedef SingletonHolder< 
-    ObjectFactory<MdagMSystemSolver<LatticeFermion>, 
-		  std::string,
+    ProfiledSolverFactory<MdagMSystemSolver<LatticeFermion>,
+		  ProfiledMdagMSystemSolver<LatticeFermion>,
 		  TYPELIST_4(XMLReader&, const std::string&, FactoryEnv::FSHandle, Handle< LinearOperator<LatticeFermion> >),
 		  MdagMSystemSolver<LatticeFermion>* (*)(XMLReader&,
 							 const std::string&,
 							 FactoryEnv::FSHandle,
-							 Handle< LinearOperator<LatticeFermion> >), 
-		  StringFactoryError> >
+							 Handle< LinearOperator<LatticeFermion> >)> >
   TheMdagMFermSystemSolverFactory;
 
   typedef SingletonHolder< 
-    ObjectFactory<MdagMSystemSolver<LatticeFermionF>, 
-		  std::string,
+    ProfiledSolverFactory<MdagMSystemSolver<LatticeFermionF>,
+		  ProfiledMdagMSystemSolver<LatticeFermionF>,
 		  TYPELIST_4(XMLReader&, const std::string&, FactoryEnv::FSHandleF, Handle< LinearOperator<LatticeFermionF > >),
 		  MdagMSystemSolver<LatticeFermionF>* (*)(XMLReader&,
 							  const std::string&,
 							  FactoryEnv::FSHandleF, 
-							  Handle< LinearOperator<LatticeFermionF> >), 
-		  StringFactoryError> >
+							  Handle< LinearOperator<LatticeFermionF> >)> >
   TheMdagMFermFSystemSolverFactory;
 
   typedef SingletonHolder< 
-    ObjectFactory<MdagMSystemSolver<LatticeFermionD>, 
-		  std::string,
+    ProfiledSolverFactory<MdagMSystemSolver<LatticeFermionD>,
+		  ProfiledMdagMSystemSolver<LatticeFermionD>,
 		  TYPELIST_4(XMLReader&, const std::string&, FactoryEnv::FSHandleD, Handle< LinearOperator<LatticeFermionD> >),
 		  MdagMSystemSolver<LatticeFermionD>* (*)(XMLReader&,
 							  const std::string&,
 							  FactoryEnv::FSHandleD,
-							  Handle< LinearOperator<LatticeFermionD> >), 
-		  StringFactoryError> >
+							  Handle< LinearOperator<LatticeFermionD> >)> >
   TheMdagMFermDSystemSolverFactory;
 
 
@@ -78,13 +76,12 @@ namespace Chroma
   //! MdagM system solver factory (foundry)
   /*! @ingroup invert */
   typedef SingletonHolder< 
-    ObjectFactory<MdagMSystemSolver<LatticeStaggeredFermion>, 
-		  std::string,
+    ProfiledSolverFactory<MdagMSystemSolver<LatticeStaggeredFermion>,
+		  ProfiledMdagMSystemSolver<LatticeStaggeredFermion>,
 		  TYPELIST_3(XMLReader&, const std::string&, Handle< LinearOperator<LatticeStaggeredFermion> >),
 		  MdagMSystemSolver<LatticeStaggeredFermion>* (*)(XMLReader&,
 								  const std::string&,
-								  Handle< LinearOperator<LatticeStaggeredFermion> >), 
-		  StringFactoryError> >
+								  Handle< LinearOperator<LatticeStaggeredFermion> >)> >
   TheMdagMStagFermSystemSolverFactory;
 
 }
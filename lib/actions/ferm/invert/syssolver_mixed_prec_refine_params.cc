@@ -0,0 +1,47 @@
+/*! \file
+ *  \brief Params of the mixed precision defect correction solver
+ */
+
+#include "actions/ferm/invert/syssolver_mixed_prec_refine_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverMixedPrecRefineParams& param)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "RsdTarget", param.RsdTarget);
+    read(paramtop, "MaxIter", param.MaxIter);
+    param.innerSolverParams = readXMLGroup(paramtop, "InnerSolverParams", "invType");
+    read(paramtop, "CloverParams", param.clovParams);
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverMixedPrecRefineParams& param)
+  {
+    push(xml, path);
+
+    write(xml, "invType", "MIXED_PREC_REFINE_INVERTER");
+    write(xml, "RsdTarget", param.RsdTarget);
+    write(xml, "MaxIter", param.MaxIter);
+    xml << param.innerSolverParams.xml;
+    write(xml, "CloverParams", param.clovParams);
+    pop(xml);
+  }
+
+  //! Default constructor
+  SysSolverMixedPrecRefineParams::SysSolverMixedPrecRefineParams()
+  {
+    RsdTarget = zero;
+    MaxIter = 0;
+  }
+
+  //! Read parameters
+  SysSolverMixedPrecRefineParams::SysSolverMixedPrecRefineParams(XMLReader& xml, const std::string& path)
+  {
+    read(xml, path, *this);
+  }
+
+}
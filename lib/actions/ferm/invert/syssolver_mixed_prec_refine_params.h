@@ -0,0 +1,42 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the mixed precision defect correction solver
+ */
+
+#ifndef __syssolver_mixed_prec_refine_params_h__
+#define __syssolver_mixed_prec_refine_params_h__
+
+#include "chromabase.h"
+#include "io/xml_group_reader.h"
+#include "actions/ferm/fermacts/clover_fermact_params_w.h"
+
+
+namespace Chroma
+{
+
+  //! Params for the mixed precision defect correction solver
+  /*! \ingroup invert */
+  struct SysSolverMixedPrecRefineParams
+  {
+    SysSolverMixedPrecRefineParams();
+    SysSolverMixedPrecRefineParams(XMLReader& in, const std::string& path);
+
+    Real          RsdTarget;          /*!< Relative residual wanted in double precision */
+    int           MaxIter;            /*!< Maximum number of outer (double precision) corrections */
+    GroupXML_t    innerSolverParams;  /*!< Single precision solver used for each correction */
+
+    CloverFermActParams  clovParams;  /*!< Even-odd clover, or Wilson, params of the action */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const std::string& path, SysSolverMixedPrecRefineParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SysSolverMixedPrecRefineParams& param);
+
+} // End namespace
+
+#endif 
+
@@ -0,0 +1,154 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Record system solves in the run profile
+ */
+
+#ifndef __syssolver_profile_h__
+#define __syssolver_profile_h__
+
+#include "handle.h"
+#include "objfactory.h"
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_mdagm.h"
+#include "util/info/profile_registry.h"
+
+namespace Chroma
+{
+
+  //! Times a LinOp solver in the run profile
+  /*! @ingroup invert
+   *
+   * Each solve is a "solver:<id>" scope, so the operator applications made
+   * by the solver show up beneath it, with the iterations as a count.
+   */
+  template<typename T>
+  class ProfiledLinOpSystemSolver : public LinOpSystemSolver<T>
+  {
+  public:
+    //! Take ownership of a solver created for id
+    ProfiledLinOpSystemSolver(const std::string& id, LinOpSystemSolver<T>* solver_)
+      : name("solver:" + id), solver(solver_) {}
+
+    //! Destructor is automatic
+    ~ProfiledLinOpSystemSolver() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return solver->subset();}
+
+    //! Whether the wrapped solver shares work between sources
+    bool blockP() const {return solver->blockP();}
+
+    //! Solve
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+    {
+      ProfileScope scope(name);
+      SystemSolverResults_t res = (*solver)(psi, chi);
+      profileCount("iterations", res.n_count);
+      return res;
+    }
+
+    //! Solve for several sources
+    multi1d<SystemSolverResults_t> operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+    {
+      ProfileScope scope(name);
+      multi1d<SystemSolverResults_t> res = (*solver)(psi, chi);
+      for(int n=0; n < res.size(); ++n)
+	profileCount("iterations", res[n].n_count);
+      return res;
+    }
+
+  private:
+    std::string                         name;
+    Handle< LinOpSystemSolver<T> >      solver;
+  };
+
+
+  //! Times an MdagM solver in the run profile
+  /*! @ingroup invert */
+  template<typename T>
+  class ProfiledMdagMSystemSolver : public MdagMSystemSolver<T>
+  {
+  public:
+    //! Take ownership of a solver created for id
+    ProfiledMdagMSystemSolver(const std::string& id, MdagMSystemSolver<T>* solver_)
+      : name("solver:" + id), solver(solver_) {}
+
+    //! Destructor is automatic
+    ~ProfiledMdagMSystemSolver() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return solver->subset();}
+
+    //! Whether the wrapped solver shares work between sources
+    bool blockP() const {return solver->blockP();}
+
+    //! Solve
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+    {
+      ProfileScope scope(name);
+      SystemSolverResults_t res = (*solver)(psi, chi);
+      profileCount("iterations", res.n_count);
+      return res;
+    }
+
+    //! Solve for several sources
+    multi1d<SystemSolverResults_t> operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+    {
+      ProfileScope scope(name);
+      multi1d<SystemSolverResults_t> res = (*solver)(psi, chi);
+      for(int n=0; n < res.size(); ++n)
+	profileCount("iterations", res[n].n_count);
+      return res;
+    }
+
+    //! Solve with a chronological predictor
+    SystemSolverResults_t operator() (T& psi, const T& chi,
+				      AbsChronologicalPredictor4D<T>& predictor) const
+    {
+      ProfileScope scope(name);
+      SystemSolverResults_t res = (*solver)(psi, chi, predictor);
+      profileCount("iterations", res.n_count);
+      return res;
+    }
+
+  private:
+    std::string                         name;
+    Handle< MdagMSystemSolver<T> >      solver;
+  };
+
+
+  //! Solver factory whose products are timed in the run profile
+  /*! @ingroup invert
+   *
+   * Every solver it creates is wrapped in Profiled, so each solve is a
+   * "solver:<id>" scope whichever action, measurement or monomial asked
+   * for it, and solvers that build inner solvers show them beneath their
+   * own scope.
+   */
+  template<class Solver, class Profiled, class TList, typename ProductCreator>
+  class ProfiledSolverFactory : public ObjectFactory<Solver, std::string, TList, ProductCreator, StringFactoryError>
+  {
+    typedef ObjectFactory<Solver, std::string, TList, ProductCreator, StringFactoryError> Base;
+
+  public:
+    typedef typename Base::Parm1  Parm1;
+    typedef typename Base::Parm2  Parm2;
+    typedef typename Base::Parm3  Parm3;
+    typedef typename Base::Parm4  Parm4;
+
+    //! Create a timed solver
+    Solver* createObject(const std::string& id, Parm1 p1, Parm2 p2, Parm3 p3)
+    {
+      return new Profiled(id, Base::createObject(id, p1, p2, p3));
+    }
+
+    //! Create a timed solver
+    Solver* createObject(const std::string& id, Parm1 p1, Parm2 p2, Parm3 p3, Parm4 p4)
+    {
+      return new Profiled(id, Base::createObject(id, p1, p2, p3, p4));
+    }
+  };
+
+}
+
+#endif
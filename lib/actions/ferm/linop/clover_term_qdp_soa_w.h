@@ -0,0 +1,693 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Site blocked (structure of arrays) clover term storage and kernels
+ *
+ *  The clover term of CHROMA_CLOVER_SOA_LEN consecutive sites of a
+ *  checkerboard is stored with the site index running fastest. Every
+ *  inner loop below runs over these lanes, which are independent sites,
+ *  so the loops vectorize without any shuffles.
+ */
+
+#ifndef __clover_term_qdp_soa_w_h__
+#define __clover_term_qdp_soa_w_h__
+
+#include "chromabase.h"
+#include <cmath>
+#include <iostream>
+
+#ifndef CHROMA_CLOVER_SOA_LEN
+#define CHROMA_CLOVER_SOA_LEN 8
+#endif
+
+namespace Chroma
+{
+  template<typename R> struct PrimitiveClovTriang;
+
+  //! Clover term for a block of sites, one SIMD lane per site
+  template<typename R>
+  struct PrimitiveClovTriangSoA
+  {
+    enum { len = CHROMA_CLOVER_SOA_LEN };
+
+    R  diag[2][2*Nc][len];
+    R  offd_re[2][2*Nc*Nc-Nc][len];
+    R  offd_im[2][2*Nc*Nc-Nc][len];
+  };
+
+
+  namespace QDPCloverEnv
+  {
+    //! Number of blocks needed for the sites of checkerboard cb
+    inline
+    int numSoABlocks(int cb)
+    {
+      const int len = CHROMA_CLOVER_SOA_LEN;
+      return (rb[cb].numSiteTable() + len - 1)/len;
+    }
+
+
+    template<typename R>
+    struct SoAPackArgs {
+      PrimitiveClovTriang<R>* tri;
+      PrimitiveClovTriangSoA<R>* soa;
+      int cb;
+    };
+
+    //! Copy the triangular storage of cb into blocks [lo,hi)
+    /*! Unused lanes of the last block get the unit matrix so that the
+     *  inversion kernel does not produce NaNs there */
+    template<typename R>
+    void soaPackSiteLoop(int lo, int hi, int myId, SoAPackArgs<R>* a)
+    {
+      const int len = PrimitiveClovTriangSoA<R>::len;
+      const int* tab = rb[a->cb].siteTable().slice();
+      const int num_sites = rb[a->cb].numSiteTable();
+
+      for(int blk=lo; blk < hi; ++blk) {
+	PrimitiveClovTriangSoA<R>& c = a->soa[blk];
+
+	for(int l=0; l < len; ++l) {
+	  int ssite = blk*len + l;
+
+	  if( ssite < num_sites ) {
+	    const PrimitiveClovTriang<R>& t = a->tri[ tab[ssite] ];
+	    for(int s=0; s < 2; ++s) {
+	      for(int i=0; i < 2*Nc; ++i) {
+		c.diag[s][i][l] = t.diag[s][i].elem();
+	      }
+	      for(int i=0; i < 2*Nc*Nc-Nc; ++i) {
+		c.offd_re[s][i][l] = t.offd[s][i].real();
+		c.offd_im[s][i][l] = t.offd[s][i].imag();
+	      }
+	    }
+	  }
+	  else {
+	    for(int s=0; s < 2; ++s) {
+	      for(int i=0; i < 2*Nc; ++i) {
+		c.diag[s][i][l] = R(1);
+	      }
+	      for(int i=0; i < 2*Nc*Nc-Nc; ++i) {
+		c.offd_re[s][i][l] = R(0);
+		c.offd_im[s][i][l] = R(0);
+	      }
+	    }
+	  }
+	}
+      }
+    }
+
+    //! Copy blocks [lo,hi) back into the triangular storage of cb
+    template<typename R>
+    void soaUnpackSiteLoop(int lo, int hi, int myId, SoAPackArgs<R>* a)
+    {
+      const int len = PrimitiveClovTriangSoA<R>::len;
+      const int* tab = rb[a->cb].siteTable().slice();
+      const int num_sites = rb[a->cb].numSiteTable();
+
+      for(int blk=lo; blk < hi; ++blk) {
+	const PrimitiveClovTriangSoA<R>& c = a->soa[blk];
+
+	for(int l=0; l < len && blk*len + l < num_sites; ++l) {
+	  PrimitiveClovTriang<R>& t = a->tri[ tab[blk*len + l] ];
+	  for(int s=0; s < 2; ++s) {
+	    for(int i=0; i < 2*Nc; ++i) {
+	      t.diag[s][i].elem() = c.diag[s][i][l];
+	    }
+	    for(int i=0; i < 2*Nc*Nc-Nc; ++i) {
+	      t.offd[s][i].real() = c.offd_re[s][i][l];
+	      t.offd[s][i].imag() = c.offd_im[s][i][l];
+	    }
+	  }
+	}
+      }
+    }
+
+
+    template<typename T>
+    struct ApplySoAArgs {
+      typedef typename WordType<T>::Type_t REALT;
+      T& chi;
+      const T& psi;
+      const PrimitiveClovTriangSoA<REALT>* soa;
+      int cb;
+    };
+
+    //! chi = (L + D + L^dag) psi on blocks [lo,hi)
+    /*! The spinors stay in the QDP layout: they are gathered into
+     *  lanes, multiplied, and scattered back */
+    template<typename T>
+    void applySoASiteLoop(int lo, int hi, int myId, ApplySoAArgs<T>* arg)
+    {
+      typedef typename WordType<T>::Type_t REALT;
+      const int len = PrimitiveClovTriangSoA<REALT>::len;
+      const int n = 2*Nc;
+
+      T& chi = arg->chi;
+      const T& psi = arg->psi;
+      const int cb = arg->cb;
+      const int* tab = rb[cb].siteTable().slice();
+      const int num_sites = rb[cb].numSiteTable();
+
+      REALT psi_re[2][2*Nc][len] QDP_ALIGN16;
+      REALT psi_im[2][2*Nc][len] QDP_ALIGN16;
+      REALT chi_re[2][2*Nc][len] QDP_ALIGN16;
+      REALT chi_im[2][2*Nc][len] QDP_ALIGN16;
+
+      for(int blk=lo; blk < hi; ++blk) {
+	const PrimitiveClovTriangSoA<REALT>& c = arg->soa[blk];
+	int nl = num_sites - blk*len;
+	if( nl > len ) nl = len;
+
+	// Gather. Spin components 0,1 make up the first block, 2,3 the second
+	for(int l=0; l < len; ++l) {
+	  if( l < nl ) {
+	    const REALT* p = (const REALT *)&(psi.elem(tab[blk*len+l]).elem(0).elem(0).real());
+	    for(int k=0; k < 2*n; ++k) {
+	      psi_re[k/n][k%n][l] = p[2*k];
+	      psi_im[k/n][k%n][l] = p[2*k+1];
+	    }
+	  }
+	  else {
+	    for(int k=0; k < 2*n; ++k) {
+	      psi_re[k/n][k%n][l] = 0;
+	      psi_im[k/n][k%n][l] = 0;
+	    }
+	  }
+	}
+
+	for(int s=0; s < 2; ++s) {
+	  for(int i=0; i < n; ++i) {
+	    for(int l=0; l < len; ++l) {
+	      chi_re[s][i][l] = c.diag[s][i][l] * psi_re[s][i][l];
+	      chi_im[s][i][l] = c.diag[s][i][l] * psi_im[s][i][l];
+	    }
+	  }
+
+	  int kij = 0;
+	  for(int i=0; i < n; ++i) {
+	    for(int j=0; j < i; ++j) {
+	      for(int l=0; l < len; ++l) {
+		const REALT ore = c.offd_re[s][kij][l];
+		const REALT oim = c.offd_im[s][kij][l];
+
+		// chi_i += L_ij psi_j
+		chi_re[s][i][l] += ore*psi_re[s][j][l] - oim*psi_im[s][j][l];
+		chi_im[s][i][l] += ore*psi_im[s][j][l] + oim*psi_re[s][j][l];
+
+		// chi_j += conj(L_ij) psi_i
+		chi_re[s][j][l] += ore*psi_re[s][i][l] + oim*psi_im[s][i][l];
+		chi_im[s][j][l] += ore*psi_im[s][i][l] - oim*psi_re[s][i][l];
+	      }
+	      kij++;
+	    }
+	  }
+	}
+
+	// Scatter
+	for(int l=0; l < nl; ++l) {
+	  REALT* p = (REALT *)&(chi.elem(tab[blk*len+l]).elem(0).elem(0).real());
+	  for(int k=0; k < 2*n; ++k) {
+	    p[2*k]   = chi_re[k/n][k%n][l];
+	    p[2*k+1] = chi_im[k/n][k%n][l];
+	  }
+	}
+      }
+    }
+
+
+    template<typename U>
+    struct LDagDLInvSoAArgs {
+      typedef typename WordType<U>::Type_t REALT;
+      typedef OLattice< PScalar< PScalar< RScalar<REALT> > > > LatticeRealT;
+      LatticeRealT& tr_log_diag;
+      PrimitiveClovTriangSoA<REALT>* soa;
+      int cb;
+    };
+
+    //! LDL^dag decomposition and inversion of blocks [lo,hi), in place
+    /*! The same algorithm as LDagDLInvSiteLoop, with the complex
+     *  arithmetic written out so that it runs across the lanes */
+    template<typename U>
+    void LDagDLInvSoASiteLoop(int lo, int hi, int myId, LDagDLInvSoAArgs<U>* a)
+    {
+      typedef typename LDagDLInvSoAArgs<U>::REALT REALT;
+      const int len = PrimitiveClovTriangSoA<REALT>::len;
+      const int N = 2*Nc;
+      const int* tab = rb[a->cb].siteTable().slice();
+      const int num_sites = rb[a->cb].numSiteTable();
+
+      REALT inv_d[2*Nc][len] QDP_ALIGN16;
+      REALT diag_g[2*Nc][len] QDP_ALIGN16;
+      REALT v_re[2*Nc][len] QDP_ALIGN16;
+      REALT v_im[2*Nc][len] QDP_ALIGN16;
+      REALT tr_log[len] QDP_ALIGN16;
+      int neg_logdet[len];
+
+      for(int blk=lo; blk < hi; ++blk) {
+	PrimitiveClovTriangSoA<REALT>& c = a->soa[blk];
+
+	for(int l=0; l < len; ++l) {
+	  tr_log[l] = 0;
+	  neg_logdet[l] = 0;
+	}
+
+	for(int block=0; block < 2; ++block) {
+	  // Work directly on the off diagonal storage of the block
+	  REALT (*o_re)[len] = c.offd_re[block];
+	  REALT (*o_im)[len] = c.offd_im[block];
+
+	  for(int i=0; i < N; ++i) {
+	    for(int l=0; l < len; ++l) {
+	      inv_d[i][l] = c.diag[block][i][l];
+	    }
+	  }
+
+	  // Algorithm 4.1.2 LDL^\dagger Decomposition
+	  // From Golub, van Loan 3rd ed, page 139
+	  for(int j=0; j < N; ++j) {
+
+	    // v(i) = A(i,i) conj(A(j,i))
+	    for(int i=0; i < j; ++i) {
+	      int elem_ji = j*(j-1)/2 + i;
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] =  inv_d[i][l]*o_re[elem_ji][l];
+		v_im[i][l] = -inv_d[i][l]*o_im[elem_ji][l];
+	      }
+	    }
+
+	    // v(j) = A(j,j) - sum_k A(j,k) v(k)
+	    for(int l=0; l < len; ++l) {
+	      v_re[j][l] = inv_d[j][l];
+	      v_im[j][l] = 0;
+	    }
+	    for(int k=0; k < j; ++k) {
+	      int elem_jk = j*(j-1)/2 + k;
+	      for(int l=0; l < len; ++l) {
+		v_re[j][l] -= o_re[elem_jk][l]*v_re[k][l] - o_im[elem_jk][l]*v_im[k][l];
+		v_im[j][l] -= o_re[elem_jk][l]*v_im[k][l] + o_im[elem_jk][l]*v_re[k][l];
+	      }
+	    }
+
+	    for(int l=0; l < len; ++l) {
+	      inv_d[j][l] = v_re[j][l];
+	    }
+
+	    // A(k,j) = ( A(k,j) - sum_l A(k,l) v(l) ) / v(j)
+	    for(int k=j+1; k < N; ++k) {
+	      int elem_kj = k*(k-1)/2 + j;
+	      for(int m=0; m < j; ++m) {
+		int elem_km = k*(k-1)/2 + m;
+		for(int l=0; l < len; ++l) {
+		  o_re[elem_kj][l] -= o_re[elem_km][l]*v_re[m][l] - o_im[elem_km][l]*v_im[m][l];
+		  o_im[elem_kj][l] -= o_re[elem_km][l]*v_im[m][l] + o_im[elem_km][l]*v_re[m][l];
+		}
+	      }
+	      for(int l=0; l < len; ++l) {
+		REALT den = v_re[j][l]*v_re[j][l] + v_im[j][l]*v_im[j][l];
+		REALT re = ( o_re[elem_kj][l]*v_re[j][l] + o_im[elem_kj][l]*v_im[j][l] ) / den;
+		REALT im = ( o_im[elem_kj][l]*v_re[j][l] - o_re[elem_kj][l]*v_im[j][l] ) / den;
+		o_re[elem_kj][l] = re;
+		o_im[elem_kj][l] = im;
+	      }
+	    }
+	  }
+
+	  for(int i=0; i < N; ++i) {
+	    for(int l=0; l < len; ++l) {
+	      diag_g[i][l] = REALT(1)/inv_d[i][l];
+	      tr_log[l] += std::log(std::fabs(inv_d[i][l]));
+	      neg_logdet[l] += ( inv_d[i][l] < 0 ) ? 1 : 0;
+	    }
+	  }
+
+	  // Invert L D L^dag column by column: forward substitution
+	  // for L D X = 1, then back substitution for L^dag M^{-1} = X
+	  for(int k=0; k < N; ++k) {
+
+	    for(int i=0; i < k; ++i) {
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] = 0;
+		v_im[i][l] = 0;
+	      }
+	    }
+
+	    for(int l=0; l < len; ++l) {
+	      v_re[k][l] = diag_g[k][l];
+	      v_im[k][l] = 0;
+	    }
+
+	    for(int i=k+1; i < N; ++i) {
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] = 0;
+		v_im[i][l] = 0;
+	      }
+
+	      for(int j=k; j < i; ++j) {
+		int elem_ij = i*(i-1)/2 + j;
+		for(int l=0; l < len; ++l) {
+		  REALT xr = inv_d[j][l]*v_re[j][l];
+		  REALT xi = inv_d[j][l]*v_im[j][l];
+		  v_re[i][l] -= o_re[elem_ij][l]*xr - o_im[elem_ij][l]*xi;
+		  v_im[i][l] -= o_re[elem_ij][l]*xi + o_im[elem_ij][l]*xr;
+		}
+	      }
+
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] *= diag_g[i][l];
+		v_im[i][l] *= diag_g[i][l];
+	      }
+	    }
+
+	    for(int i=N-2; i >= k; --i) {
+	      for(int j=i+1; j < N; ++j) {
+		int elem_ji = j*(j-1)/2 + i;
+		for(int l=0; l < len; ++l) {
+		  // v(i) -= conj(A(j,i)) v(j)
+		  v_re[i][l] -= o_re[elem_ji][l]*v_re[j][l] + o_im[elem_ji][l]*v_im[j][l];
+		  v_im[i][l] -= o_re[elem_ji][l]*v_im[j][l] - o_im[elem_ji][l]*v_re[j][l];
+		}
+	      }
+	    }
+
+	    // Overwrite column k
+	    for(int l=0; l < len; ++l) {
+	      inv_d[k][l] = v_re[k][l];
+	    }
+	    for(int i=k+1; i < N; ++i) {
+	      int elem_ik = i*(i-1)/2 + k;
+	      for(int l=0; l < len; ++l) {
+		o_re[elem_ik][l] = v_re[i][l];
+		o_im[elem_ik][l] = v_im[i][l];
+	      }
+	    }
+	  }
+
+	  for(int i=0; i < N; ++i) {
+	    for(int l=0; l < len; ++l) {
+	      c.diag[block][i][l] = inv_d[i][l];
+	    }
+	  }
+	}
+
+	for(int l=0; l < len && blk*len + l < num_sites; ++l) {
+	  int site = tab[blk*len + l];
+	  a->tr_log_diag.elem(site).elem().elem().elem() += tr_log[l];
+
+	  if( neg_logdet[l] != 0 ) {
+	    // Report if site has any negative terms. (-ve def)
+	    std::cout << "WARNING: found " << neg_logdet[l]
+		      << " negative eigenvalues in Clover DET at site: " << site << std::endl;
+	  }
+	}
+      }
+    }
+
+
+    //! Cholesky decomposition and inversion of blocks [lo,hi), in place
+    /*! The same algorithm as cholesSiteLoop. Column j of the lower
+     *  triangle still holds A when step j reads it, so L and then A^{-1}
+     *  can overwrite the block as they are formed */
+    template<typename U>
+    void cholesSoASiteLoop(int lo, int hi, int myId, LDagDLInvSoAArgs<U>* a)
+    {
+      typedef typename LDagDLInvSoAArgs<U>::REALT REALT;
+      const int len = PrimitiveClovTriangSoA<REALT>::len;
+      const int N = 2*Nc;
+      const int* tab = rb[a->cb].siteTable().slice();
+      const int num_sites = rb[a->cb].numSiteTable();
+
+      REALT diag_g[2*Nc][len] QDP_ALIGN16;
+      REALT v_re[2*Nc][len] QDP_ALIGN16;
+      REALT v_im[2*Nc][len] QDP_ALIGN16;
+      REALT tr_log[len] QDP_ALIGN16;
+
+      for(int blk=lo; blk < hi; ++blk) {
+	PrimitiveClovTriangSoA<REALT>& c = a->soa[blk];
+
+	for(int l=0; l < len; ++l) {
+	  tr_log[l] = 0;
+	}
+
+	for(int block=0; block < 2; ++block) {
+	  REALT (*o_re)[len] = c.offd_re[block];
+	  REALT (*o_im)[len] = c.offd_im[block];
+
+	  // A = L L^dag, with 1/L(j,j) kept in diag_g
+	  for(int j=0; j < N; ++j) {
+
+	    // Column j of A
+	    for(int l=0; l < len; ++l) {
+	      v_re[j][l] = c.diag[block][j][l];
+	      v_im[j][l] = 0;
+	    }
+	    for(int i=j+1; i < N; ++i) {
+	      int elem_ij = i*(i-1)/2 + j;
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] = o_re[elem_ij][l];
+		v_im[i][l] = o_im[elem_ij][l];
+	      }
+	    }
+
+	    // v(i) -= conj(L(j,k)) L(i,k)
+	    for(int k=0; k < j; ++k) {
+	      int elem_jk = j*(j-1)/2 + k;
+	      for(int i=j; i < N; ++i) {
+		int elem_ik = i*(i-1)/2 + k;
+		for(int l=0; l < len; ++l) {
+		  v_re[i][l] -= o_re[elem_jk][l]*o_re[elem_ik][l] + o_im[elem_jk][l]*o_im[elem_ik][l];
+		  v_im[i][l] -= o_re[elem_jk][l]*o_im[elem_ik][l] - o_im[elem_jk][l]*o_re[elem_ik][l];
+		}
+	      }
+	    }
+
+	    // The diagonal is (should be!!) real and positive
+	    for(int l=0; l < len && blk*len + l < num_sites; ++l) {
+	      if( !( v_re[j][l] > 0 ) ) {
+		// Make sure any node can print this message
+		std::cerr << "Clover term has negative diagonal element: "
+			  << "diag_g[" << j << "]= " << v_re[j][l]
+			  << " at site: " << tab[blk*len + l] << std::endl;
+		QDP_abort(1);
+	      }
+	    }
+
+	    for(int l=0; l < len; ++l) {
+	      tr_log[l] += std::log(v_re[j][l]);
+	      diag_g[j][l] = REALT(1)/std::sqrt(v_re[j][l]);
+	    }
+
+	    for(int i=j+1; i < N; ++i) {
+	      int elem_ij = i*(i-1)/2 + j;
+	      for(int l=0; l < len; ++l) {
+		o_re[elem_ij][l] = v_re[i][l]*diag_g[j][l];
+		o_im[elem_ij][l] = v_im[i][l]*diag_g[j][l];
+	      }
+	    }
+	  }
+
+	  // Forward and back substitution for column k of A^{-1}
+	  for(int k=0; k < N; ++k) {
+
+	    for(int i=0; i < k; ++i) {
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] = 0;
+		v_im[i][l] = 0;
+	      }
+	    }
+
+	    for(int l=0; l < len; ++l) {
+	      v_re[k][l] = diag_g[k][l];
+	      v_im[k][l] = 0;
+	    }
+
+	    for(int i=k+1; i < N; ++i) {
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] = 0;
+		v_im[i][l] = 0;
+	      }
+
+	      for(int j=k; j < i; ++j) {
+		int elem_ij = i*(i-1)/2 + j;
+		for(int l=0; l < len; ++l) {
+		  v_re[i][l] -= o_re[elem_ij][l]*v_re[j][l] - o_im[elem_ij][l]*v_im[j][l];
+		  v_im[i][l] -= o_re[elem_ij][l]*v_im[j][l] + o_im[elem_ij][l]*v_re[j][l];
+		}
+	      }
+
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] *= diag_g[i][l];
+		v_im[i][l] *= diag_g[i][l];
+	      }
+	    }
+
+	    for(int l=0; l < len; ++l) {
+	      v_re[N-1][l] *= diag_g[N-1][l];
+	      v_im[N-1][l] *= diag_g[N-1][l];
+	    }
+
+	    for(int i=N-2; i >= k; --i) {
+	      for(int j=i+1; j < N; ++j) {
+		int elem_ji = j*(j-1)/2 + i;
+		for(int l=0; l < len; ++l) {
+		  // v(i) -= conj(L(j,i)) v(j)
+		  v_re[i][l] -= o_re[elem_ji][l]*v_re[j][l] + o_im[elem_ji][l]*v_im[j][l];
+		  v_im[i][l] -= o_re[elem_ji][l]*v_im[j][l] - o_im[elem_ji][l]*v_re[j][l];
+		}
+	      }
+	      for(int l=0; l < len; ++l) {
+		v_re[i][l] *= diag_g[i][l];
+		v_im[i][l] *= diag_g[i][l];
+	      }
+	    }
+
+	    // Overwrite column k
+	    for(int l=0; l < len; ++l) {
+	      c.diag[block][k][l] = v_re[k][l];
+	    }
+	    for(int i=k+1; i < N; ++i) {
+	      int elem_ik = i*(i-1)/2 + k;
+	      for(int l=0; l < len; ++l) {
+		o_re[elem_ik][l] = v_re[i][l];
+		o_im[elem_ik][l] = v_im[i][l];
+	      }
+	    }
+	  }
+	}
+
+	for(int l=0; l < len && blk*len + l < num_sites; ++l) {
+	  a->tr_log_diag.elem(tab[blk*len + l]).elem().elem().elem() += tr_log[l];
+	}
+      }
+    }
+
+
+    template<typename U>
+    struct TriaCntrSoAArgs {
+      typedef typename WordType<U>::Type_t REALT;
+
+      U& B;
+      const PrimitiveClovTriangSoA< REALT >* soa;
+      int mat;
+      int cb;
+    };
+
+    //! Tr_D ( Gamma_mat L ) on blocks [lo,hi)
+    /*! The eight Gamma matrices with non zero trace against the block
+     *  diagonal clover term fall into two patterns, see triaCntrSiteLoop.
+     *  For mat = 0, 3, 12 the colour diagonal comes from the diagonals of
+     *  both chiral blocks and the rest from their lower triangles. For
+     *  mat = 5, 6, 9, 10 all of B comes from the off diagonal Nc x Nc
+     *  sub-blocks. The patterns differ only in signs and an overall phase */
+    template<typename U>
+    void triaCntrSoASiteLoop(int lo, int hi, int myId, TriaCntrSoAArgs<U>* a)
+    {
+      typedef typename WordType<U>::Type_t REALT;
+      const int len = PrimitiveClovTriangSoA<REALT>::len;
+      const int mat = a->mat;
+      const int* tab = rb[a->cb].siteTable().slice();
+      const int num_sites = rb[a->cb].numSiteTable();
+      U& B = a->B;
+
+      // Signs of block 0 (upper, lower colour half), block 1 (upper, lower)
+      REALT sg[4];
+      // Overall phase: 1, i or -i
+      int phase = 0;
+      bool diag_type = true;
+
+      switch( mat ) {
+      case 0:  sg[0]= 1; sg[1]= 1; sg[2]= 1; sg[3]= 1; phase= 0; break;
+      case 3:  sg[0]=-1; sg[1]= 1; sg[2]=-1; sg[3]= 1; phase= 1; break;
+      case 12: sg[0]= 1; sg[1]=-1; sg[2]=-1; sg[3]= 1; phase= 1; break;
+      case 5:  sg[0]= 1; sg[1]=-1; sg[2]= 1; sg[3]=-1; phase= 0; diag_type=false; break;
+      case 6:  sg[0]= 1; sg[1]= 1; sg[2]= 1; sg[3]= 1; phase=-1; diag_type=false; break;
+      case 9:  sg[0]= 1; sg[1]= 1; sg[2]=-1; sg[3]=-1; phase= 1; diag_type=false; break;
+      case 10: sg[0]= 1; sg[1]=-1; sg[2]=-1; sg[3]= 1; phase= 0; diag_type=false; break;
+      default:
+	QDPIO::cout << __func__ << ": invalid Gamma matrix int" << std::endl;
+	QDP_abort(1);
+      }
+
+      REALT b_re[Nc][Nc][len] QDP_ALIGN16;
+      REALT b_im[Nc][Nc][len] QDP_ALIGN16;
+
+      for(int blk=lo; blk < hi; ++blk) {
+	const PrimitiveClovTriangSoA<REALT>& c = a->soa[blk];
+
+	if( diag_type ) {
+	  for(int i=0; i < Nc; ++i) {
+	    for(int l=0; l < len; ++l) {
+	      b_re[i][i][l] = sg[0]*c.diag[0][i][l] + sg[1]*c.diag[0][i+Nc][l]
+		+             sg[2]*c.diag[1][i][l] + sg[3]*c.diag[1][i+Nc][l];
+	      b_im[i][i][l] = 0;
+	    }
+	  }
+
+	  for(int i=1; i < Nc; ++i) {
+	    for(int j=0; j < i; ++j) {
+	      int elem_ij  = i*(i-1)/2 + j;
+	      int elem_ijb = (i+Nc)*(i+Nc-1)/2 + Nc + j;
+	      for(int l=0; l < len; ++l) {
+		REALT t_re = sg[0]*c.offd_re[0][elem_ij][l] + sg[1]*c.offd_re[0][elem_ijb][l]
+		  +          sg[2]*c.offd_re[1][elem_ij][l] + sg[3]*c.offd_re[1][elem_ijb][l];
+		REALT t_im = sg[0]*c.offd_im[0][elem_ij][l] + sg[1]*c.offd_im[0][elem_ijb][l]
+		  +          sg[2]*c.offd_im[1][elem_ij][l] + sg[3]*c.offd_im[1][elem_ijb][l];
+
+		// mat=0: B(j,i) = t,  B(i,j) = adj(t)
+		// else:  B(i,j) = t,  B(j,i) = adj(t), both times i below
+		if( phase == 0 ) {
+		  b_re[j][i][l] = t_re;  b_im[j][i][l] =  t_im;
+		  b_re[i][j][l] = t_re;  b_im[i][j][l] = -t_im;
+		}
+		else {
+		  b_re[i][j][l] = t_re;  b_im[i][j][l] =  t_im;
+		  b_re[j][i][l] = t_re;  b_im[j][i][l] = -t_im;
+		}
+	      }
+	    }
+	  }
+	}
+	else {
+	  for(int i=0; i < Nc; ++i) {
+	    for(int j=0; j < Nc; ++j) {
+	      int elem_ij = (i+Nc)*(i+Nc-1)/2 + j;
+	      int elem_ji = (j+Nc)*(j+Nc-1)/2 + i;
+	      for(int l=0; l < len; ++l) {
+		// adj(A(j,i)) terms then A(i,j) terms
+		b_re[i][j][l] = sg[0]*c.offd_re[0][elem_ji][l] + sg[1]*c.offd_re[0][elem_ij][l]
+		  +             sg[2]*c.offd_re[1][elem_ji][l] + sg[3]*c.offd_re[1][elem_ij][l];
+		b_im[i][j][l] = -sg[0]*c.offd_im[0][elem_ji][l] + sg[1]*c.offd_im[0][elem_ij][l]
+		  +             -sg[2]*c.offd_im[1][elem_ji][l] + sg[3]*c.offd_im[1][elem_ij][l];
+	      }
+	    }
+	  }
+	}
+
+	// Scatter, applying the phase
+	for(int l=0; l < len && blk*len + l < num_sites; ++l) {
+	  int site = tab[blk*len + l];
+	  for(int i=0; i < Nc; ++i) {
+	    for(int j=0; j < Nc; ++j) {
+	      RComplex<REALT>& b = B.elem(site).elem().elem(i,j);
+	      if( phase == 0 ) {
+		b.real() =  b_re[i][j][l];
+		b.imag() =  b_im[i][j][l];
+	      }
+	      else if( phase == 1 ) {
+		b.real() = -b_im[i][j][l];
+		b.imag() =  b_re[i][j][l];
+	      }
+	      else {
+		b.real() =  b_im[i][j][l];
+		b.imag() = -b_re[i][j][l];
+	      }
+	    }
+	  }
+	}
+      }
+    }
+
+  } // namespace QDPCloverEnv
+
+} // namespace Chroma
+
+#endif
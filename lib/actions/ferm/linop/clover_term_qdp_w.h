@@ -11,6 +11,8 @@
 #include "actions/ferm/fermacts/clover_fermact_params_w.h"
 #include "actions/ferm/linop/clover_term_base_w.h"
 #include "meas/glue/mesfield.h"
+#include "actions/ferm/linop/clover_term_qdp_soa_w.h"
+#include "util/info/profile_registry.h"
 #include <complex>
 namespace Chroma 
 { 
@@ -63,6 +65,7 @@ namespace Chroma
     	if ( tri != nullptr ) {
     		QDP::Allocator::theQDPAllocator::Instance().free(tri);
     	}
+    	freeSoA();
     }
 
     //! Creation routine
@@ -144,6 +147,12 @@ namespace Chroma
     //! Calculates Tr_D ( Gamma_mat L )
     Real getCloverCoeff(int mu, int nu) const;
 
+    //! Site blocked copy of the term, when param.soa_layoutP
+    void allocSoA();
+    void freeSoA();
+    void packSoA(int cb);
+    void unpackSoA(int cb);
+
   private:
 			Handle< FermBC<T,multi1d<U>,multi1d<U> > >      fbc;
     multi1d<U>  u;
@@ -154,7 +163,10 @@ namespace Chroma
                                  // on a particular checkerboard. 
 
     PrimitiveClovTriang<REALT>*  tri;
-    
+
+    // With the SoA layout the kernels run on soa[cb]. tri is kept in
+    // step so applySite, getTriBuffer and packForQUDA still work
+    PrimitiveClovTriangSoA<REALT>* soa[2];
   };
 
 
@@ -165,7 +177,45 @@ namespace Chroma
 	  int nodeSites = Layout::sitesOnNode();
 	  tri = (PrimitiveClovTriang<REALT>*)QDP::Allocator::theQDPAllocator::Instance().allocate(nodeSites*sizeof(PrimitiveClovTriang<REALT>),
 			  	  QDP::Allocator::DEFAULT);
+	  soa[0] = soa[1] = nullptr;
+  }
+
+
+  template<typename T, typename U>
+  void QDPCloverTermT<T,U>::allocSoA()
+  {
+    for(int cb=0; cb < 2; ++cb) {
+      if( soa[cb] == nullptr ) {
+	soa[cb] = (PrimitiveClovTriangSoA<REALT>*)QDP::Allocator::theQDPAllocator::Instance().allocate(
+	  QDPCloverEnv::numSoABlocks(cb)*sizeof(PrimitiveClovTriangSoA<REALT>),
+	  QDP::Allocator::DEFAULT);
+      }
+    }
+  }
+
+  template<typename T, typename U>
+  void QDPCloverTermT<T,U>::freeSoA()
+  {
+    for(int cb=0; cb < 2; ++cb) {
+      if( soa[cb] != nullptr ) {
+	QDP::Allocator::theQDPAllocator::Instance().free(soa[cb]);
+	soa[cb] = nullptr;
+      }
+    }
+  }
+
+  template<typename T, typename U>
+  void QDPCloverTermT<T,U>::packSoA(int cb)
+  {
+    QDPCloverEnv::SoAPackArgs<REALT> a = { tri, soa[cb], cb };
+    dispatch_to_threads(QDPCloverEnv::numSoABlocks(cb), a, QDPCloverEnv::soaPackSiteLoop<REALT>);
+  }
 
+  template<typename T, typename U>
+  void QDPCloverTermT<T,U>::unpackSoA(int cb)
+  {
+    QDPCloverEnv::SoAPackArgs<REALT> a = { tri, soa[cb], cb };
+    dispatch_to_threads(QDPCloverEnv::numSoABlocks(cb), a, QDPCloverEnv::soaUnpackSiteLoop<REALT>);
   }
 
   // Now copy
@@ -234,6 +284,15 @@ namespace Chroma
     	}
     }
 
+    if( param.soa_layoutP ) {
+      allocSoA();
+      packSoA(0);
+      packSoA(1);
+    }
+    else {
+      freeSoA();
+    }
+
 
     END_CODE();  
 #endif
@@ -281,6 +340,15 @@ namespace Chroma
     multi1d<U> f;
     mesField(f, u);
     makeClov(f, diag_mass);
+
+    if( param.soa_layoutP ) {
+      allocSoA();
+      packSoA(0);
+      packSoA(1);
+    }
+    else {
+      freeSoA();
+    }
     
 
     choles_done.resize(rb.numSubsets());
@@ -833,9 +901,16 @@ namespace Chroma
     // Zero trace log
     tr_log_diag[rb[cb]] = zero;
 
-    QDPCloverEnv::LDagDLInvArgs<U> a = { tr_log_diag, tri, cb };
-    int num_site_table = rb[cb].numSiteTable();
-    dispatch_to_threads(num_site_table, a, QDPCloverEnv::LDagDLInvSiteLoop<U>);
+    if( soa[cb] != nullptr ) {
+      QDPCloverEnv::LDagDLInvSoAArgs<U> a = { tr_log_diag, soa[cb], cb };
+      dispatch_to_threads(QDPCloverEnv::numSoABlocks(cb), a, QDPCloverEnv::LDagDLInvSoASiteLoop<U>);
+      unpackSoA(cb);
+    }
+    else {
+      QDPCloverEnv::LDagDLInvArgs<U> a = { tr_log_diag, tri, cb };
+      int num_site_table = rb[cb].numSiteTable();
+      dispatch_to_threads(num_site_table, a, QDPCloverEnv::LDagDLInvSiteLoop<U>);
+    }
 
     
     // This comes from the days when we used to do Cholesky
@@ -1026,8 +1101,16 @@ namespace Chroma
     }
   
     tr_log_diag = zero;
-    QDPCloverEnv::LDagDLInvArgs<U> a = { tr_log_diag, tri, cb};
-    dispatch_to_threads(rb[cb].numSiteTable(), a, QDPCloverEnv::cholesSiteLoop<U>);
+
+    if( soa[cb] != nullptr ) {
+      QDPCloverEnv::LDagDLInvSoAArgs<U> a = { tr_log_diag, soa[cb], cb };
+      dispatch_to_threads(QDPCloverEnv::numSoABlocks(cb), a, QDPCloverEnv::cholesSoASiteLoop<U>);
+      unpackSoA(cb);
+    }
+    else {
+      QDPCloverEnv::LDagDLInvArgs<U> a = { tr_log_diag, tri, cb};
+      dispatch_to_threads(rb[cb].numSiteTable(), a, QDPCloverEnv::cholesSiteLoop<U>);
+    }
     
     choles_done[cb] = true;
     END_CODE();
@@ -1513,9 +1596,16 @@ namespace Chroma
       QDP_abort(1);
     }
 
-    QDPCloverEnv::TriaCntrArgs<U> a = { B, tri, mat, cb };
-    dispatch_to_threads(rb[cb].numSiteTable(), a, 
-			QDPCloverEnv::triaCntrSiteLoop<U>);
+    if( soa[cb] != nullptr ) {
+      QDPCloverEnv::TriaCntrSoAArgs<U> a = { B, soa[cb], mat, cb };
+      dispatch_to_threads(QDPCloverEnv::numSoABlocks(cb), a,
+			  QDPCloverEnv::triaCntrSoASiteLoop<U>);
+    }
+    else {
+      QDPCloverEnv::TriaCntrArgs<U> a = { B, tri, mat, cb };
+      dispatch_to_threads(rb[cb].numSiteTable(), a, 
+			  QDPCloverEnv::triaCntrSiteLoop<U>);
+    }
 
     END_CODE();
 #endif
@@ -2149,12 +2239,24 @@ namespace Chroma
       QDP_abort(1);
     }
 
-    QDPCloverEnv::ApplyArgs<T> arg = { chi,psi,tri,cb };
-    int num_sites = rb[cb].siteTable().size();
+    // Two packed 6x6 blocks and a spinor in, one spinor out per site
+    const double cbsites = rb[cb].numSiteTable();
+    ProfileScope scope("clover");
+    profileFlops(this->nFlops()*cbsites);
+    profileBytes(cbsites*(2*36 + 2*24)*sizeof(typename WordType<T>::Type_t));
 
-    // The dispatch function is at the end of the file
-    // ought to work for non-threaded targets too...
-    dispatch_to_threads(num_sites, arg, QDPCloverEnv::applySiteLoop<T>);
+    if( soa[cb] != nullptr ) {
+      QDPCloverEnv::ApplySoAArgs<T> arg = { chi,psi,soa[cb],cb };
+      dispatch_to_threads(QDPCloverEnv::numSoABlocks(cb), arg, QDPCloverEnv::applySoASiteLoop<T>);
+    }
+    else {
+      QDPCloverEnv::ApplyArgs<T> arg = { chi,psi,tri,cb };
+      int num_sites = rb[cb].siteTable().size();
+
+      // The dispatch function is at the end of the file
+      // ought to work for non-threaded targets too...
+      dispatch_to_threads(num_sites, arg, QDPCloverEnv::applySiteLoop<T>);
+    }
     (*this).getFermBC().modifyF(chi, QDP::rb[cb]);
 
     END_CODE();
@@ -3,6 +3,7 @@
  */
 
 #include "actions/ferm/linop/eoprec_clover_linop_w.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 
 
@@ -11,6 +12,17 @@ namespace Chroma
 
    using namespace QDP::Hints;
 
+  //! Anonymous namespace
+  namespace
+  {
+    //! Clover term and its inverse kept with a fermion state
+    struct CloverAttachment : public FermStateAttachment
+    {
+      Handle<CloverTerm>  clov;
+      Handle<CloverTerm>  invclov;
+    };
+  }
+
  //! Creation routine with Anisotropy
   /*!
    * \param u_ 	    gauge field     	       (Read)
@@ -24,10 +36,35 @@ namespace Chroma
 
     param = param_;
 
-    clov.create(fs, param);
+    // Other operators made on this state with the same params, e.g. by
+    // other monomials through the FermStateCache, reuse the clover terms
+    XMLBufferWriter key;
+    write(key, "EvenOddPrecCloverLinOp", param);
+
+    Handle<FermStateAttachment> a;
+    bool hit = fs->findAttachment(key.str(), a);
+    TheFermStateCache::Instance().countAttachment(hit);
+
+    if (hit)
+    {
+      const CloverAttachment& c = dynamic_cast<const CloverAttachment&>(*a);
+      clov = c.clov;
+      invclov = c.invclov;
+    }
+    else
+    {
+      clov = new CloverTerm;
+      clov->create(fs, param);
  
-    invclov.create(fs,param,clov);  // make a copy
-    invclov.choles(0);  // invert the cb=0 part
+      invclov = new CloverTerm;
+      invclov->create(fs,param,*clov);  // make a copy
+      invclov->choles(0);  // invert the cb=0 part
+
+      CloverAttachment* c = new CloverAttachment;
+      c->clov = clov;
+      c->invclov = invclov;
+      fs->setAttachment(key.str(), Handle<FermStateAttachment>(c));
+    }
 
     D.create(fs, param.anisoParam);
 
@@ -46,7 +83,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    clov.apply(chi, psi, isign, 1);
+    clov->apply(chi, psi, isign, 1);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
 
@@ -63,7 +100,7 @@ namespace Chroma
 
     // Nuke for testing
     swatch.reset(); swatch.start();
-    clov.apply(chi, psi, isign, 0);
+    clov->apply(chi, psi, isign, 0);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
     
@@ -78,7 +115,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    invclov.apply(chi, psi, isign, 0);
+    invclov->apply(chi, psi, isign, 0);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
     
@@ -156,7 +193,7 @@ namespace Chroma
     D.apply(tmp1, psi, isign, 0);
 
     swatch.reset(); swatch.start();
-    invclov.apply(tmp2, tmp1, isign, 0);
+    invclov->apply(tmp2, tmp1, isign, 0);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
 
@@ -164,7 +201,7 @@ namespace Chroma
 
     //  chi_o  =  A_oo  psi_o  -  tmp1_o
     swatch.reset(); swatch.start();
-    clov.apply(chi, psi, isign, 1);
+    clov->apply(chi, psi, isign, 1);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
 
@@ -196,7 +233,7 @@ namespace Chroma
     START_CODE();
     
     swatch.reset(); swatch.start();
-    clov.deriv(ds_u, chi, psi, isign, 0);
+    clov->deriv(ds_u, chi, psi, isign, 0);
     swatch.stop();
     clov_deriv_time  += swatch.getTimeInSeconds();
 
@@ -212,7 +249,7 @@ namespace Chroma
     START_CODE();
     
     swatch.reset(); swatch.start();
-    clov.derivMultipole(ds_u, chi, psi, isign, 0);
+    clov->derivMultipole(ds_u, chi, psi, isign, 0);
     swatch.stop();
     clov_deriv_time  += swatch.getTimeInSeconds();
 
@@ -227,7 +264,7 @@ namespace Chroma
     START_CODE();
 
     // Testing Odd Odd Term - get nothing from even even term
-    invclov.derivTrLn(ds_u, isign, 0);
+    invclov->derivTrLn(ds_u, isign, 0);
     
     END_CODE();
   }
@@ -273,7 +310,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    clov.deriv(ds_u, chi, psi, isign, 1);
+    clov->deriv(ds_u, chi, psi, isign, 1);
     swatch.stop();
     clov_deriv_time += swatch.getTimeInSeconds();
     
@@ -288,7 +325,7 @@ namespace Chroma
     START_CODE();
     
     swatch.reset(); swatch.start();
-    clov.derivMultipole(ds_u, chi, psi, isign, 1);
+    clov->derivMultipole(ds_u, chi, psi, isign, 1);
     swatch.stop();
     clov_deriv_time  += swatch.getTimeInSeconds();
 
@@ -298,7 +335,7 @@ namespace Chroma
   //! Return flops performed by the operator()
   unsigned long EvenOddPrecCloverLinOp::nFlops() const
   {
-    unsigned long cbsite_flops = 2*D.nFlops()+2*clov.nFlops()+4*Nc*Ns;
+    unsigned long cbsite_flops = 2*D.nFlops()+2*clov->nFlops()+4*Nc*Ns;
     if(  param.twisted_m_usedP ) { 
       cbsite_flops += 4*Nc*Ns; // a + mu*b : a = chi, b = g_5 I psi
     }
@@ -308,6 +345,6 @@ namespace Chroma
   //! Get the log det of the even even part
   // BUt for now, return zero for testing.
   Double EvenOddPrecCloverLinOp::logDetEvenEvenLinOp(void) const  {
-    return invclov.cholesDet(0);
+    return invclov->cholesDet(0);
   }
 } // End Namespace Chroma
@@ -124,8 +124,8 @@ namespace Chroma
   private:
     CloverFermActParams param;
     WilsonDslash D;
-    CloverTerm   clov;
-    CloverTerm   invclov;  // uggh, only needed for evenEvenLinOp
+    Handle<CloverTerm>   clov;
+    Handle<CloverTerm>   invclov;  // uggh, only needed for evenEvenLinOp
     mutable double clov_apply_time;
     mutable double clov_deriv_time;
     mutable StopWatch swatch;
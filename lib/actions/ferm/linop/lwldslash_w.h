@@ -9,6 +9,7 @@
 #include "state.h"
 #include "io/aniso_io.h"
 #include "actions/ferm/linop/lwldslash_base_w.h"
+#include "util/info/profile_registry.h"
 
 
 namespace Chroma 
@@ -229,6 +230,13 @@ namespace Chroma
 			  enum PlusMinus isign, int cb) const
   {
     START_CODE();
+
+    // 8 links and 8 neighbours in, one spinor out per site
+    const double cbsites = rb[cb].numSiteTable();
+    ProfileScope scope("dslash");
+    profileFlops(this->nFlops()*cbsites);
+    profileBytes(cbsites*(8*18 + 9*24)*sizeof(typename WordType<T>::Type_t));
+
 #if (QDP_NC == 2) || (QDP_NC == 3)
     /*     F 
      *   a2  (x)  :=  U  (x) (1 - isign gamma  ) psi(x)
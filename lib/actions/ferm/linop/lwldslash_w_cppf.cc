@@ -6,6 +6,7 @@
 #include "actions/ferm/linop/lwldslash_w_cppf.h"
 #include "cpp_dslash.h"
 #include "cpp_dslash_qdp_packer.h"
+#include "util/info/profile_registry.h"
 
 
 using namespace CPlusPlusWilsonDslash;
@@ -198,6 +199,11 @@ namespace Chroma
     int target_cb = cb;
     int cbsites = QDP::Layout::sitesOnNode()/2;
 
+    // 8 links and 8 neighbours in, one spinor out per site
+    ProfileScope scope("dslash");
+    profileFlops(double(nFlops())*cbsites);
+    profileBytes(double(cbsites)*(8*18 + 9*24)*sizeof(float));
+
     (*D)((float *)&(chi.elem(all.start()).elem(0).elem(0).real()),	
 	 (float *)&(psi.elem(all.start()).elem(0).elem(0).real()),
 	 (float *)&(packed_gauge[0]),
@@ -32,6 +32,9 @@ namespace Chroma
     //! Return the subset on which the operator acts
     const Subset& subset() const {return all;}
 
+    //! Whether the inverter shares work between sources
+    bool blockP() const {return invA->blockP();}
+
     //! Solver the linear system
     /*!
      * \param psi      quark propagator ( Modify )
@@ -79,6 +82,61 @@ namespace Chroma
       return res;
     }
 
+    //! Solver the linear systems of several sources at once
+    /*!
+     * The odd checkerboard systems are handed to the inverter together.
+     *
+     * \param psi      quark propagators ( Modify )
+     * \param chi      sources ( Read )
+     * \return number of CG iterations of each source
+     */
+    multi1d<SystemSolverResults_t> operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+    {
+      START_CODE();
+
+      const int N = chi.size();
+
+      /* Step (i) */
+      /* chi_tmp =  chi_o - D_oe * A_ee^-1 * chi_e */
+      multi1d<T> chi_tmp(N);
+      for(int n=0; n < N; ++n)
+      {
+	T tmp1, tmp2;
+
+	A->evenEvenInvLinOp(tmp1, chi[n], PLUS);
+	A->oddEvenLinOp(tmp2, tmp1, PLUS);
+	chi_tmp[n][rb[1]] = chi[n] - tmp2;
+      }
+
+      // Call inverter
+      multi1d<SystemSolverResults_t> res = (*invA)(psi, chi_tmp);
+
+      for(int n=0; n < N; ++n)
+      {
+	/* Step (ii) */
+	/* psi_e = A_ee^-1 * [chi_e  -  D_eo * psi_o] */
+	{
+	  T tmp1, tmp2;
+
+	  A->evenOddLinOp(tmp1, psi[n], PLUS);
+	  tmp2[rb[0]] = chi[n] - tmp1;
+	  A->evenEvenInvLinOp(psi[n], tmp2, PLUS);
+	}
+
+	// Compute residual
+	{
+	  T  r;
+	  A->unprecLinOp(r, psi[n], PLUS);
+	  r -= chi[n];
+	  res[n].resid = sqrt(norm2(r));
+	}
+      }
+
+      END_CODE();
+
+      return res;
+    }
+
   private:
     // Hide default constructor
     PrecFermActQprop() {}
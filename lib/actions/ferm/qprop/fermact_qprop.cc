@@ -39,6 +39,9 @@ namespace Chroma
     //! Return the subset on which the operator acts
     const Subset& subset() const {return all;}
 
+    //! Whether the inverter shares work between sources
+    bool blockP() const {return invA->blockP();}
+
     //! Solver the linear system
     /*!
      * \param psi      quark propagator ( Modify )
@@ -65,6 +68,33 @@ namespace Chroma
       return res;
     }
 
+    //! Solver the linear systems of several sources at once
+    /*!
+     * \param psi      quark propagators ( Modify )
+     * \param chi      sources ( Read )
+     * \return number of CG iterations of each source
+     */
+    multi1d<SystemSolverResults_t> operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+    {
+      START_CODE();
+
+      // Call inverter
+      multi1d<SystemSolverResults_t> res = (*invA)(psi, chi);
+  
+      // Compute residual
+      for(int n=0; n < chi.size(); ++n)
+      {
+	T  r;
+	(*A)(r, psi[n], PLUS);
+	r -= chi[n];
+	res[n].resid = sqrt(norm2(r));
+      }
+
+      END_CODE();
+
+      return res;
+    }
+
   private:
     // Hide default constructor
     FermActQprop() {}
@@ -66,16 +66,29 @@ namespace Chroma
 
 //  LatticeFermion psi = zero;  // note this is ``zero'' and not 0
 
+    // A block solver gets all the color and spin sources in one call, so
+    // it can share its Krylov space between them. Any other solver gets
+    // one source at a time, and only one pair of fermions is kept.
+    const int num_spin  = end_spin - start_spin;
+    const int num_total = Nc*num_spin;
+    const int num_src   = qprop->blockP() ? num_total : 1;
+
+    multi1d<LatticeFermion> psi(num_src);
+    multi1d<LatticeFermion> chi(num_src);
+    multi1d<Real> fact(num_src);
+
     // This version loops over all color and spin indices
-    for(int color_source = 0; color_source < Nc; ++color_source)
+    for(int first = 0; first < num_total; first += num_src)
     {
-      for(int spin_source = start_spin; spin_source < end_spin; ++spin_source)
+      for(int n = 0; n < num_src; ++n)
       {
-	LatticeFermion psi = zero;  // note this is ``zero'' and not 0
-	LatticeFermion chi;
+	const int color_source = (first + n) / num_spin;
+	const int spin_source  = (first + n) % num_spin + start_spin;
+
+	psi[n] = zero;  // note this is ``zero'' and not 0
 
 	// Extract a fermion source
-	PropToFerm(q_src, chi, color_source, spin_source);
+	PropToFerm(q_src, chi[n], color_source, spin_source);
 
 	// Use the last initial guess as the current initial guess
 
@@ -83,38 +96,50 @@ namespace Chroma
 	 * Normalize the source in case it is really huge or small - 
 	 * a trick to avoid overflows or underflows
 	 */
-	Real fact = 1.0;
-	Real nrm = sqrt(norm2(chi));
+	fact[n] = 1.0;
+	Real nrm = sqrt(norm2(chi[n]));
 	if (toFloat(nrm) != 0.0)
-	  fact /= nrm;
+	  fact[n] /= nrm;
 
 	// Rescale
-	chi *= fact;
-
-	// Compute the propagator for given source color/spin.
-	{
-	  SystemSolverResults_t result = (*qprop)(psi,chi);
-	  ncg_had += result.n_count;
-
-	  push(xml_out,"Qprop");
-	  write(xml_out, "color_source", color_source);
-	  write(xml_out, "spin_source", spin_source);
-	  write(xml_out, "n_count", result.n_count);
-	  write(xml_out, "resid", result.resid);
-	  pop(xml_out);
-	}
+	chi[n] *= fact[n];
+      }
+
+      // Compute the propagator for these source colors/spins.
+      multi1d<SystemSolverResults_t> result;
+      if (num_src == 1)
+      {
+	result.resize(1);
+	result[0] = (*qprop)(psi[0],chi[0]);
+      }
+      else
+	result = (*qprop)(psi,chi);
+
+      for(int n = 0; n < num_src; ++n)
+      {
+	const int color_source = (first + n) / num_spin;
+	const int spin_source  = (first + n) % num_spin + start_spin;
+
+	ncg_had += result[n].n_count;
+
+	push(xml_out,"Qprop");
+	write(xml_out, "color_source", color_source);
+	write(xml_out, "spin_source", spin_source);
+	write(xml_out, "n_count", result[n].n_count);
+	write(xml_out, "resid", result[n].resid);
+	pop(xml_out);
 
 	// Unnormalize the source following the inverse of the normalization above
-	fact = Real(1) / fact;
-	psi *= fact;
+	Real unfact = Real(1) / fact[n];
+	psi[n] *= unfact;
 
 	/*
 	 * Move the solution to the appropriate components
 	 * of quark propagator.
 	 */
-	FermToProp(psi, q_sol, color_source, spin_source);
-      }	/* end loop over spin_source */
-    } /* end loop over color_source */
+	FermToProp(psi[n], q_sol, color_source, spin_source);
+      }
+    } /* end loop over color and spin sources */
 
 
     switch (quarkSpinType)
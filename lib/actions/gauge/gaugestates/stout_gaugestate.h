@@ -77,7 +77,8 @@ namespace Chroma
       
       for(int level=params.n_smear; level > 0; level--) {
 	QDPIO::cout << "Recursing level " << level << " to level " << level -1 << std::endl;
-	Stouting::deriv_recurse(F_thin, params.smear_in_this_dirP, params.rho, smeared_links[level-1]);
+	Stouting::deriv_recurse(F_thin, params.smear_in_this_dirP, params.rho, smeared_links[level-1],
+				smear_data[level-1]);
 	
 	// gbc->zero(F_thin);
 	
@@ -129,6 +130,7 @@ namespace Chroma
       for(int i=0; i <= params.n_smear; i++) { 
 	smeared_links[i].resize(Nd);
       }
+      smear_data.resize(params.n_smear);
       
       
       // Copy thin links into smeared_links[0]
@@ -143,7 +145,8 @@ namespace Chroma
       
       // Iterate up the smearings
       for(int i=1; i <= params.n_smear; i++) {
-	Stouting::smear_links(smeared_links[i-1], smeared_links[i], params.smear_in_this_dirP, params.rho);
+	Stouting::smear_links(smeared_links[i-1], smeared_links[i], params.smear_in_this_dirP, params.rho,
+			      smear_data[i-1]);
 
 	// If the gauge BC's are nontrivial 
 	// apply at every level - eg SF BC's
@@ -163,6 +166,7 @@ namespace Chroma
   private:
     Handle< GaugeBC<P,Q> >  gbc;
     multi1d<Q> smeared_links;
+    multi1d<Stouting::StoutLevelData> smear_data;  // for the force recursion
     StoutFermStateParams params;
   };
 
@@ -0,0 +1,278 @@
+/*! \file
+ *  \brief Parallel bulk reads and writes of the body of a gauge file
+ */
+
+#include "io/bulk_io.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Chroma
+{
+  namespace BulkIO
+  {
+    // Utility functions
+    namespace
+    {
+      //! Largest single read or write
+      const size_t max_chunk = 64*1024*1024;
+
+      //! Largest hole a read may step over rather than start a new read
+      const size_t max_gap = 1024*1024;
+
+      //! The bulk path is on
+      bool bulk_enabled = true;
+
+      //! Where a local element goes in the file and in the buffer
+      struct Entry
+      {
+	size_t  file;     /*!< element index in the file */
+	size_t  local;    /*!< element index in the buffer */
+
+	bool operator<(const Entry& e) const {return file < e.file;}
+      };
+
+      //! The elements of this node sorted by their place in the file
+      std::vector<Entry> localEntries(const BulkFileLayout& layout)
+      {
+	const int    sites = Layout::sitesOnNode();
+	const size_t vol   = Layout::vol();
+	std::vector<size_t> index(sites);
+
+	for(int site=0; site < sites; ++site)
+	  index[site] = layout.index(Layout::siteCoords(Layout::nodeNumber(), site));
+
+	std::vector<Entry> entries(size_t(layout.nrec)*sites);
+	for(int rec=0; rec < layout.nrec; ++rec)
+	  for(int site=0; site < sites; ++site)
+	  {
+	    Entry& e = entries[size_t(rec)*sites + site];
+	    e.file  = size_t(rec)*vol + index[site];
+	    e.local = size_t(rec)*sites + site;
+	  }
+
+	std::sort(entries.begin(), entries.end());
+	return entries;
+      }
+
+      //! pread until done
+      bool preadAll(int fd, char* buf, size_t len, off_t off)
+      {
+	while (len > 0)
+	{
+	  ssize_t n = pread(fd, buf, len, off);
+	  if (n <= 0)
+	    return false;
+
+	  buf += n;
+	  len -= n;
+	  off += n;
+	}
+	return true;
+      }
+
+      //! pwrite until done
+      bool pwriteAll(int fd, const char* buf, size_t len, off_t off)
+      {
+	while (len > 0)
+	{
+	  ssize_t n = pwrite(fd, buf, len, off);
+	  if (n <= 0)
+	    return false;
+
+	  buf += n;
+	  len -= n;
+	  off += n;
+	}
+	return true;
+      }
+
+      //! Did every node succeed?
+      bool allOk(bool ok)
+      {
+	int bad = ok ? 0 : 1;
+	QDPInternal::globalSum(bad);
+	return bad == 0;
+      }
+    }
+
+
+    // Lexicographic site index
+    size_t lexicoIndex(const multi1d<int>& coord)
+    {
+      const multi1d<int>& nrow = Layout::lattSize();
+      size_t index = 0;
+
+      for(int mu=Nd-1; mu >= 0; --mu)
+	index = index*nrow[mu] + coord[mu];
+
+      return index;
+    }
+
+
+    // Checkerboarded site index
+    size_t checkerboardIndex(const multi1d<int>& coord)
+    {
+      int sum = 0;
+      for(int mu=0; mu < Nd; ++mu)
+	sum += coord[mu];
+
+      multi1d<int> coord_cb = coord;
+      coord_cb[0] /= 2;
+
+      multi1d<int> nrow_cb = Layout::lattSize();
+      nrow_cb[0] /= 2;
+
+      size_t index = 0;
+      for(int mu=Nd-1; mu >= 0; --mu)
+	index = index*nrow_cb[mu] + coord_cb[mu];
+
+      return size_t(sum & 1)*(Layout::vol()/2) + index;
+    }
+
+
+    // Size of a file as seen by the primary node
+    long fileSize(const std::string& file)
+    {
+      long size = -1;
+
+      if (Layout::primaryNode())
+      {
+	struct stat st;
+	if (stat(file.c_str(), &st) == 0)
+	  size = st.st_size;
+      }
+
+      QDPInternal::broadcast(size);
+      return size;
+    }
+
+
+    // Turn the bulk path on or off
+    void setEnabled(bool on)
+    {
+      bulk_enabled = on;
+    }
+
+
+    // Is the bulk path on?
+    bool enabled()
+    {
+      return bulk_enabled;
+    }
+
+
+    // Read the elements of the sites on this node
+    bool readBody(std::vector<char>& buf, const std::string& file, const BulkFileLayout& layout)
+    {
+      if (! bulk_enabled)
+	return false;
+
+      START_CODE();
+
+      bool ok = readLocal(buf, file, layout);
+
+      END_CODE();
+
+      return allOk(ok);
+    }
+
+
+    // Read the elements of the sites on this node, on this node alone
+    bool readLocal(std::vector<char>& buf, const std::string& file, const BulkFileLayout& layout)
+    {
+      int fd = open(file.c_str(), O_RDONLY);
+      if (fd < 0)
+	return false;
+
+      const size_t esize = layout.elem_bytes;
+      std::vector<Entry> entries = localEntries(layout);
+      buf.resize(entries.size()*esize);
+
+      std::vector<char> scratch;
+      bool ok = true;
+
+      // Each read covers a run of elements whose holes are small
+      for(size_t i=0; ok && i < entries.size(); )
+      {
+	size_t j = i + 1;
+	while (j < entries.size() &&
+	       (entries[j].file - entries[j-1].file - 1)*esize <= max_gap &&
+	       (entries[j].file - entries[i].file + 1)*esize <= max_chunk)
+	  ++j;
+
+	size_t first = entries[i].file;
+	size_t len   = (entries[j-1].file - first + 1)*esize;
+	scratch.resize(len);
+
+	ok = preadAll(fd, &scratch[0], len, off_t(layout.offset + first*esize));
+
+	for(size_t k=i; ok && k < j; ++k)
+	  memcpy(&buf[entries[k].local*esize], &scratch[(entries[k].file - first)*esize], esize);
+
+	i = j;
+      }
+
+      close(fd);
+
+      return ok;
+    }
+
+
+    // Write the elements of the sites on this node
+    bool writeBody(const std::string& file, const BulkFileLayout& layout, const std::vector<char>& buf)
+    {
+      if (! bulk_enabled)
+	return false;
+
+      START_CODE();
+
+      // Wait for the primary node to have written the header
+      allOk(true);
+
+      int fd = open(file.c_str(), O_WRONLY);
+      if (! allOk(fd >= 0))
+      {
+	if (fd >= 0)
+	  close(fd);
+	return false;
+      }
+
+      const size_t esize = layout.elem_bytes;
+      std::vector<Entry> entries = localEntries(layout);
+
+      std::vector<char> scratch;
+      bool ok = true;
+
+      // Holes belong to other nodes, so a write only covers a contiguous run
+      for(size_t i=0; ok && i < entries.size(); )
+      {
+	size_t j = i + 1;
+	while (j < entries.size() &&
+	       entries[j].file == entries[j-1].file + 1 &&
+	       (j - i + 1)*esize <= max_chunk)
+	  ++j;
+
+	scratch.resize((j - i)*esize);
+	for(size_t k=i; k < j; ++k)
+	  memcpy(&scratch[(k - i)*esize], &buf[entries[k].local*esize], esize);
+
+	ok = pwriteAll(fd, &scratch[0], scratch.size(), off_t(layout.offset + entries[i].file*esize));
+
+	i = j;
+      }
+
+      if (close(fd) != 0)
+	ok = false;
+
+      END_CODE();
+
+      return allOk(ok);
+    }
+
+  }  // end namespace BulkIO
+
+}  // end namespace Chroma
@@ -0,0 +1,157 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Parallel bulk reads and writes of the body of a gauge file
+ */
+
+#ifndef __bulk_io_h__
+#define __bulk_io_h__
+
+#include "chromabase.h"
+#include "qdp_util.h"    // from QDP
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Where the data of each site lives in the body of a file
+  /*!
+   * \ingroup io
+   *
+   * The body starts offset bytes into the file and holds nrec records,
+   * each of Layout::vol() elements of elem_bytes. The element of a site
+   * within a record is index(coord).
+   */
+  struct BulkFileLayout
+  {
+    size_t  offset;
+    int     nrec;
+    size_t  elem_bytes;
+    size_t  (*index)(const multi1d<int>& coord);
+  };
+
+
+  //! Bulk I/O of the legacy gauge formats
+  /*!
+   * \ingroup io
+   *
+   * The legacy readers go through a BinaryFileReader one site at a time
+   * on the primary node. Here every node opens the file itself and moves
+   * the bytes of its own sites with large positioned reads or writes,
+   * merging the runs of sites that sit close together in the file. The
+   * buffers are [rec][local site][element] in file byte order.
+   *
+   * This needs the file to be visible from every node. If any node cannot
+   * open it the calls return false everywhere and the caller should fall
+   * back to its serial path.
+   */
+  namespace BulkIO
+  {
+    //! Lexicographic site index, x running fastest
+    size_t lexicoIndex(const multi1d<int>& coord);
+
+    //! Checkerboarded site index: cb*vol/2 + lexicographic index on the half lattice
+    size_t checkerboardIndex(const multi1d<int>& coord);
+
+    //! Size of a file as seen by the primary node, -1 if it cannot be opened
+    long fileSize(const std::string& file);
+
+    //! Turn the bulk path on or off. Off, readBody and writeBody return false
+    /*! Must be the same on every node. Lets the serial paths be checked against it */
+    void setEnabled(bool on);
+
+    //! Is the bulk path on?
+    bool enabled();
+
+    //! Read the elements of the sites on this node. Collective
+    bool readBody(std::vector<char>& buf, const std::string& file, const BulkFileLayout& layout);
+
+    //! Read the elements of the sites on this node. Not collective
+    /*!
+     * Only does POSIX I/O into buf, so it may run on a thread of its own
+     * while QDP is busy elsewhere. The result is for this node alone; the
+     * caller has to agree on it across the nodes.
+     */
+    bool readLocal(std::vector<char>& buf, const std::string& file, const BulkFileLayout& layout);
+
+    //! Write the elements of the sites on this node into an existing file. Collective
+    bool writeBody(const std::string& file, const BulkFileLayout& layout, const std::vector<char>& buf);
+
+
+#ifndef QDP_IS_QDPJIT
+    //! Unpack links from [rec][site][matrix][Nc][Nc][re,im], swapping bytes first if needed
+    /*!
+     * Link mu is matrix mu % (Nd/nrec) of record mu / (Nd/nrec). A u that
+     * already holds Nd fields is filled in place, without allocating.
+     */
+    template<typename REAL, typename U>
+    void unpackLinks(multi1d<U>& u, std::vector<char>& buf, int nrec, bool byterev)
+    {
+      const int    sites = Layout::sitesOnNode();
+      const int    mats  = Nd / nrec;
+      const size_t mat   = Nc*Nc*2;
+      REAL* p = reinterpret_cast<REAL*>(&buf[0]);
+
+      if (byterev)
+	QDPUtil::byte_swap((void *)p, sizeof(REAL), size_t(Nd)*sites*mat);
+
+      if (u.size() != Nd)
+	u.resize(Nd);
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	const int rec = mu / mats;
+	const int m   = mu % mats;
+
+	for(int site=0; site < sites; ++site)
+	{
+	  const REAL* q = p + ((size_t(rec)*sites + site)*mats + m)*mat;
+
+	  for(int i=0; i < Nc; ++i)
+	    for(int j=0; j < Nc; ++j)
+	    {
+	      u[mu].elem(site).elem().elem(i,j).real() = q[2*(i*Nc+j)];
+	      u[mu].elem(site).elem().elem(i,j).imag() = q[2*(i*Nc+j)+1];
+	    }
+	}
+      }
+    }
+
+    //! Pack links into [rec][site][matrix][Nc][Nc][re,im], swapping bytes after if needed
+    template<typename REAL, typename U>
+    void packLinks(std::vector<char>& buf, const multi1d<U>& u, int nrec, bool byterev)
+    {
+      const int    sites = Layout::sitesOnNode();
+      const int    mats  = Nd / nrec;
+      const size_t mat   = Nc*Nc*2;
+
+      buf.resize(size_t(Nd)*sites*mat*sizeof(REAL));
+      REAL* p = reinterpret_cast<REAL*>(&buf[0]);
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	const int rec = mu / mats;
+	const int m   = mu % mats;
+
+	for(int site=0; site < sites; ++site)
+	{
+	  REAL* q = p + ((size_t(rec)*sites + site)*mats + m)*mat;
+
+	  for(int i=0; i < Nc; ++i)
+	    for(int j=0; j < Nc; ++j)
+	    {
+	      q[2*(i*Nc+j)]   = u[mu].elem(site).elem().elem(i,j).real();
+	      q[2*(i*Nc+j)+1] = u[mu].elem(site).elem().elem(i,j).imag();
+	    }
+	}
+      }
+
+      if (byterev)
+	QDPUtil::byte_swap((void *)p, sizeof(REAL), size_t(Nd)*sites*mat);
+    }
+#endif
+
+  }  // end namespace BulkIO
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,38 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Gauge fixing type enum
+ */
+
+#include "enum_gfixtype_io.h"
+
+#include <string>
+
+namespace Chroma { 
+
+  namespace GFixTypeEnv { 
+
+    bool registerAll(void) 
+    {
+      bool success; 
+      success = theGFixTypeMap::Instance().registerPair(std::string("RELAX"), GFIX_TYPE_RELAX);
+      success &=theGFixTypeMap::Instance().registerPair(std::string("FOURIER_SD"), GFIX_TYPE_FOURIER_SD);
+      success &=theGFixTypeMap::Instance().registerPair(std::string("FOURIER_CG"), GFIX_TYPE_FOURIER_CG);
+      
+      return success;
+    }
+
+    const std::string typeIDString ="GFixType";
+    bool registered = registerAll();
+  }
+
+  using namespace GFixTypeEnv;
+  //! Read an GFixType enum
+  void read(XMLReader& xml_in,  const std::string& path, GFixType& t) {
+    theGFixTypeMap::Instance().read(typeIDString, xml_in, path,t);
+  }
+  
+  //! Write an GFixType enum
+  void write(XMLWriter& xml_out, const std::string& path, const GFixType& t) {
+    theGFixTypeMap::Instance().write(typeIDString, xml_out, path, t);
+  }
+}
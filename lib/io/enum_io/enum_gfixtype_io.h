@@ -0,0 +1,45 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Gauge fixing type enum
+ */
+
+#ifndef enum_gfixtype_io_h
+#define enum_gfixtype_io_h
+
+#include "chromabase.h"
+#include <string>
+#include "singleton.h"
+#include "io/enum_io/enum_type_map.h"
+#include "meas/gfix/coulgauge.h"
+
+
+namespace Chroma {
+
+  /*!
+   * Types and structures
+   *
+   * \ingroup io
+   *
+   * @{
+   */
+  //! Gauge fixing type
+  namespace GFixTypeEnv { 
+    extern const std::string typeIDString;
+    extern bool registered; 
+    bool registerAll(void);   // Forward declaration
+  }
+
+  // A singleton to hold the typemap
+  typedef SingletonHolder<EnumTypeMap<GFixType> > theGFixTypeMap;
+
+  // Reader and writer
+
+  //! Read an GFixType enum
+  void read(XMLReader& r, const std::string& path, GFixType& t);
+
+  //! Write an GFixType enum
+  void write(XMLWriter& w, const std::string& path, const GFixType& t);
+
+  /*! @} */   // end of group io
+}
+#endif
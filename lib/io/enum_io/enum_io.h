@@ -28,6 +28,7 @@
 #include "enum_qdpvolfmt_io.h"
 #include "enum_wavetype_io.h"
 #include "enum_heatbathtype_io.h"
+#include "enum_gfixtype_io.h"
 #include "enum_md_integrator_type_io.h"
 #include "enum_inner_solver_type_io.h"
 #include "enum_quarkspintype_io.h"
@@ -0,0 +1,86 @@
+/*! \file
+ *  \brief Background readahead of a file into the operating system cache
+ */
+
+#include "io/file_readahead.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+namespace Chroma 
+{
+
+  // Nothing in flight
+  FileReadahead::FileReadahead() : running(false), finished(false), bytes(0) {}
+
+  // Waits for any outstanding readahead
+  FileReadahead::~FileReadahead()
+  {
+    wait();
+  }
+
+
+  // Thread body
+  void* FileReadahead::run(void* arg)
+  {
+    FileReadahead& me = *static_cast<FileReadahead*>(arg);
+
+    int fd = open(me.filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      me.finished = true;
+      return NULL;
+    }
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+
+    // Large reads keep parallel filesystems streaming
+    std::vector<char> buf(16*1024*1024);
+    ssize_t n;
+    while ((n = read(fd, &buf[0], buf.size())) > 0)
+      me.bytes += n;
+
+    close(fd);
+    me.finished = true;
+    return NULL;
+  }
+
+
+  // Start reading ahead a file
+  void FileReadahead::start(const std::string& filename_)
+  {
+    wait();
+
+    filename = filename_;
+    bytes    = 0;
+    finished = false;
+
+    if (! Layout::primaryNode())
+      return;
+
+    if (pthread_create(&thread, NULL, &FileReadahead::run, this) != 0)
+    {
+      // Not fatal - the file will simply be read in the foreground
+      QDPIO::cerr << __func__ << ": could not start readahead thread for " << filename << std::endl;
+      return;
+    }
+    running = true;
+  }
+
+
+  // Block until the current readahead is done
+  size_t FileReadahead::wait()
+  {
+    if (running)
+    {
+      pthread_join(thread, NULL);
+      running = false;
+    }
+    return bytes;
+  }
+
+}  // end namespace Chroma
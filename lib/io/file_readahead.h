@@ -0,0 +1,75 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Background readahead of a file into the operating system cache
+ */
+
+#ifndef __file_readahead_h__
+#define __file_readahead_h__
+
+#include "chromabase.h"
+#include <pthread.h>
+#include <atomic>
+
+namespace Chroma 
+{
+
+  //! Read a file in a background thread so a later read is served from memory
+  /*!
+   * \ingroup io
+   *
+   * Most gauge readers (QIO, NERSC, ...) are collective and go through
+   * QDP, so they cannot run concurrently with measurements. MILC and SZIN
+   * files can be read and checked in the background by StagedGaugeRead;
+   * for the others what can overlap is pulling the bytes off the
+   * filesystem. This class streams the whole file through a scratch
+   * buffer on a private thread, using only POSIX I/O, so that a later
+   * read of it on the same host hits the page cache.
+   *
+   * It is only a readahead: the bytes are thrown away and the reader reads
+   * the file again, so there is nothing to gain on a file that is about to
+   * be read anyway. Only the primary node reads ahead, so it helps the
+   * readers that go through the primary node, and the bulk readers only as
+   * far as their nodes share its host or the filesystem caches. QIO does
+   * its own reads and is not helped.
+   */
+  class FileReadahead
+  {
+  public:
+    //! Nothing in flight
+    FileReadahead();
+
+    //! Waits for any outstanding readahead
+    ~FileReadahead();
+
+    //! Start reading ahead a file. Any readahead in flight is waited for first.
+    void start(const std::string& filename);
+
+    //! Block until the current readahead is done
+    /*! \return number of bytes read on this node */
+    size_t wait();
+
+    //! Is a readahead in flight?
+    bool active() const {return running;}
+
+    //! Has the thread finished reading? Does not block
+    bool done() const {return ! running || finished.load();}
+
+  private:
+    //! Thread body
+    static void* run(void* arg);
+
+    // Hide copies - the thread holds a pointer to this
+    FileReadahead(const FileReadahead&) {}
+    void operator=(const FileReadahead&) {}
+
+  private:
+    pthread_t    thread;
+    bool         running;
+    std::atomic<bool> finished;
+    std::string  filename;
+    size_t       bytes;
+  };
+
+}  // end namespace Chroma
+
+#endif
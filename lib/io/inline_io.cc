@@ -1,10 +1,35 @@
 #include "chromabase.h"
 #include "io/inline_io.h"
 #include "meas/inline/abs_inline_measurement_factory.h"
+#include "util/info/profile_registry.h"
 
 
 namespace Chroma { 
 
+  namespace {
+    //! Times a measurement in the run profile under its name
+    class ProfiledInlineMeasurement : public AbsInlineMeasurement 
+    {
+    public:
+      ProfiledInlineMeasurement(const std::string& name_, 
+				Handle< AbsInlineMeasurement > meas_) : name(name_), meas(meas_) {}
+
+      unsigned long getFrequency(void) const {return meas->getFrequency();}
+
+      void operator()(unsigned long update_no,
+		      XMLWriter& xml_out) 
+      {
+	ProfileScope scope(name);
+	(*meas)(update_no, xml_out);
+      }
+
+    private:
+      std::string                     name;
+      Handle< AbsInlineMeasurement >  meas;
+    };
+  }
+
+
   // Read an inline measurement
   void read(XMLReader& xml,
 	    const std::string& path,
@@ -21,10 +46,11 @@ namespace Chroma {
       QDP_abort(1);
     }
     
-    meas_handle = TheInlineMeasurementFactory::Instance().createObject(
+    Handle< AbsInlineMeasurement > meas(TheInlineMeasurementFactory::Instance().createObject(
 								      measurement_name, 
 								      xml,
-								      path);
-    
+								      path));
+
+    meas_handle = new ProfiledInlineMeasurement(measurement_name, meas);
   }
 }
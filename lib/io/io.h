@@ -40,5 +40,7 @@
 #include "monomial_io.h"
 
 #include "inline_io.h"
+#include "file_readahead.h"
+#include "staged_gauge_read.h"
 
 #endif
@@ -5,7 +5,10 @@
 
 #include "chromabase.h"
 #include "io/milc_io.h"
+#include "io/bulk_io.h"
 #include <time.h>
+#include <cstring>
+#include <vector>
 
 namespace Chroma 
 {
@@ -62,4 +65,103 @@ namespace Chroma
     pop(xml);
   }
 
+
+  // Utility functions
+  namespace
+  {
+    //! Rotate left, with a rotation by 0 leaving the word alone
+    inline unsigned int rotl(unsigned int w, int r)
+    {
+      return (r == 0) ? w : ((w << r) | (w >> (32 - r)));
+    }
+
+    //! Fold the words of the links of one site into the sums
+    inline void siteChecksums(unsigned int& sum29, unsigned int& sum31, 
+			      const unsigned int* w, int words, size_t rank)
+    {
+      int rank29 = (size_t(words)*rank) % 29;
+      int rank31 = (size_t(words)*rank) % 31;
+
+      for(int k=0; k < words; ++k)
+      {
+	sum29 ^= rotl(w[k], rank29);
+	sum31 ^= rotl(w[k], rank31);
+	if (++rank29 >= 29) rank29 = 0;
+	if (++rank31 >= 31) rank31 = 0;
+      }
+    }
+  }
+
+
+  //! MILC checksums of single precision links
+  bool milcChecksums(unsigned int& sum29, unsigned int& sum31, const multi1d<LatticeColorMatrixF>& u)
+  {
+    START_CODE();
+
+    sum29 = 0;
+    sum31 = 0;
+
+#ifdef QDP_IS_QDPJIT
+    END_CODE();
+    return false;
+#else
+    const int words = Nc*Nc*2;     // words per link
+    std::vector<unsigned int> w(Nd*words);
+
+    for(int site=0; site < Layout::sitesOnNode(); ++site)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+	memcpy(&w[mu*words], &(u[mu].elem(site).elem().elem(0,0).real()), words*sizeof(unsigned int));
+
+      size_t rank = BulkIO::lexicoIndex(Layout::siteCoords(Layout::nodeNumber(), site));
+      siteChecksums(sum29, sum31, &w[0], Nd*words, rank);
+    }
+
+    milcGlobalChecksums(sum29, sum31);
+
+    END_CODE();
+
+    return true;
+#endif
+  }
+
+
+  //! The part of the MILC checksums from the sites of this node
+  void milcLocalChecksums(unsigned int& sum29, unsigned int& sum31, const void* links)
+  {
+    const int words = Nd*Nc*Nc*2;     // words per site
+    const unsigned int* w = static_cast<const unsigned int*>(links);
+
+    sum29 = 0;
+    sum31 = 0;
+
+    for(int site=0; site < Layout::sitesOnNode(); ++site)
+    {
+      size_t rank = BulkIO::lexicoIndex(Layout::siteCoords(Layout::nodeNumber(), site));
+      siteChecksums(sum29, sum31, w + size_t(words)*site, words, rank);
+    }
+  }
+
+
+  //! Combine the parts of the MILC checksums of every node
+  void milcGlobalChecksums(unsigned int& sum29, unsigned int& sum31)
+  {
+    // Xor over the nodes from the parity of the global bit counts
+    double bits[64];
+    for(int b=0; b < 32; ++b)
+    {
+      bits[b]    = (sum29 >> b) & 1;
+      bits[32+b] = (sum31 >> b) & 1;
+    }
+    QDPInternal::globalSumArray(bits, 64);
+
+    sum29 = 0;
+    sum31 = 0;
+    for(int b=0; b < 32; ++b)
+    {
+      if (int(bits[b]) & 1)    sum29 |= 1u << b;
+      if (int(bits[32+b]) & 1) sum31 |= 1u << b;
+    }
+  }
+
 }  // end namespace Chroma
@@ -27,6 +27,33 @@ void read(XMLReader& xml, const std::string& path, MILCGauge_t& header);
 //! Source header writer
 void write(XMLWriter& xml, const std::string& path, const MILCGauge_t& header);
 
+//! MILC checksums of single precision links
+/*!
+ * \ingroup io
+ *
+ * The checksums are taken over the 32 bit words of the links of each site
+ * in host byte order, each rotated by its position in the file. This is
+ * collective.
+ *
+ * \return false if the checksums cannot be computed in this build
+ */
+bool milcChecksums(unsigned int& sum29, unsigned int& sum31, const multi1d<LatticeColorMatrixF>& u);
+
+//! The part of the MILC checksums from the sites of this node
+/*!
+ * \ingroup io
+ *
+ * links holds the sites of this node in their order on the node, each
+ * as Nd links of Nc*Nc*2 single precision words in host byte order, as
+ * in the body of a MILC file. Not collective, and it does not touch any
+ * lattice field, so it may run on a thread of its own.
+ */
+void milcLocalChecksums(unsigned int& sum29, unsigned int& sum31, const void* links);
+
+//! Combine the parts of the MILC checksums of every node. Collective
+/*! \ingroup io */
+void milcGlobalChecksums(unsigned int& sum29, unsigned int& sum31);
+
 }  // end namespace Chroma
 
 #endif
@@ -6,6 +6,7 @@
 #include "chromabase.h"
 #include "io/cppacs_io.h"
 #include "io/readcppacs.h"
+#include "io/bulk_io.h"
 #include "qdp_util.h"    // from QDP
 
 namespace Chroma {
@@ -88,27 +89,51 @@ void readCPPACS(CPPACSGauge_t& header, multi1d<LatticeColorMatrix>& u, const std
 // (the fastest running direction is the 0th direction, corresponding to the 
 // x-direction)
 
-  u = zero ; 
-
-  LatticeColorMatrixD  uu ; 
-
-  ColorMatrixD  uuuD ; 
-  ColorMatrix  uuu ; 
-
-  for(int site=0; site < Layout::vol(); ++site)
+  bool bulk = false;
+#ifndef QDP_IS_QDPJIT
   {
-    multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
-    // read in a single site
-    for(int mu=0; mu < Nd; ++mu) 
-      {  
-	read(cfg_in, uuuD );  
-	if(byterev){
-	  QDPUtil::byte_swap((void *)&uuuD.elem(),sizeof(double),2*Nc*Nc);
-	}
-	uuu = uuuD ; 
-	pokeSite(u[mu],uuu,coord); 
-      }    
+    // A 1024 byte header, then the Nd double precision links of each site.
+    // The reads above already swap a big endian file, so the raw body
+    // needs a swap when exactly one of these applies
+    BulkFileLayout layout = {1024, 1, size_t(Nd*Nc*Nc*2*sizeof(REAL64)), BulkIO::lexicoIndex};
+    std::vector<char> buf;
+
+    if (BulkIO::readBody(buf, cfg_file, layout))
+    {
+      multi1d<LatticeColorMatrixD> uD;
+      BulkIO::unpackLinks<REAL64>(uD, buf, 1, byterev == QDPUtil::big_endian());
+
+      u.resize(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+	u[mu] = uD[mu];
+
+      bulk = true;
+    }
+  }
+#endif
 
+  if (! bulk)
+  {
+    u = zero ; 
+
+    ColorMatrixD  uuuD ; 
+    ColorMatrix  uuu ; 
+
+    for(int site=0; site < Layout::vol(); ++site)
+    {
+      multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
+      // read in a single site
+      for(int mu=0; mu < Nd; ++mu) 
+	{  
+	  read(cfg_in, uuuD );  
+	  if(byterev){
+	    QDPUtil::byte_swap((void *)&uuuD.elem(),sizeof(double),2*Nc*Nc);
+	  }
+	  uuu = uuuD ; 
+	  pokeSite(u[mu],uuu,coord); 
+	}    
+
+    }
   }
 
   cfg_in.close();
@@ -6,31 +6,33 @@
 #include "chromabase.h"
 #include "io/milc_io.h"
 #include "io/readmilc.h"
+#include "io/bulk_io.h"
 #include "qdp_util.h"    // from QDP
 
 namespace Chroma {
 
-//! Read a MILC configuration file
+//! Read the header of a MILC gauge configuration
 /*!
  * \ingroup io
  *
+ * \param cfg_in     file positioned at its start ( Modify )
  * \param header     structure holding config info ( Modify )
- * \param u          gauge configuration ( Modify )
- * \param cfg_file   path ( Read )
+ * \param byterev    the file is in the other byte order ( Write )
+ * \param sum29      checksum of the body, 0 if not written ( Write )
+ * \param sum31      checksum of the body, 0 if not written ( Write )
+ *
+ * \return where the links are in the body
  */    
 
-void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::string& cfg_file)
+BulkFileLayout readMILCHeader(BinaryFileReader& cfg_in, MILCGauge_t& header, 
+			      bool& byterev, unsigned int& sum29, unsigned int& sum31)
 {
   START_CODE();
 
-  u.resize(Nd);
-
-  BinaryFileReader cfg_in(cfg_file); // for now, cfg_io_location not used
-
   int magic_number;
   read(cfg_in, magic_number);
 
-  bool byterev = false ;
+  byterev = false ;
   if( magic_number != 20103){
     //need byte reversal
     byterev = true ;
@@ -66,8 +68,7 @@ void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::s
     QDP_error_exit("readMILC: only support non-sitelist format");
 
 
-  // Go ahead an read checksums, but will not use for now
-  unsigned int sum29, sum31;
+  // Checksums of the body, for the caller to verify
   read(cfg_in, sum29);
   read(cfg_in, sum31);
   if(byterev){
@@ -76,30 +77,94 @@ void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::s
   }
   QDPIO::cout<<"Global sums (sum29, sum31): "<<sum29<<" "<<sum31<<std::endl; 
 
+  // MILC format has the directions inside the sites. The body follows
+  // the header in lexicographic site order
+  BulkFileLayout layout = {size_t(4*(Nd+4) + 64), 1, size_t(Nd*Nc*Nc*2*sizeof(REAL32)),
+			   BulkIO::lexicoIndex};
+
+  END_CODE();
+
+  return layout;
+}
+
+
+//! Read a MILC configuration file
+/*!
+ * \ingroup io
+ *
+ * \param header     structure holding config info ( Modify )
+ * \param u          gauge configuration ( Modify )
+ * \param cfg_file   path ( Read )
+ */    
+
+void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::string& cfg_file)
+{
+  START_CODE();
+
+  u.resize(Nd);
+
+  BinaryFileReader cfg_in(cfg_file); // for now, cfg_io_location not used
+
+  bool byterev;
+  unsigned int sum29, sum31;
+  BulkFileLayout layout = readMILCHeader(cfg_in, header, byterev, sum29, sum31);
+
   /*
    * Read away...
    */
-  
-  // MILC format has the directions inside the sites
-  for(int site=0; site < Layout::vol(); ++site)
+
+  bool bulk = false;
+#ifndef QDP_IS_QDPJIT
+  {
+    // The body is in the byte order of the header
+    std::vector<char> buf;
+    if (BulkIO::readBody(buf, cfg_file, layout))
+    {
+      BulkIO::unpackLinks<REAL32>(u, buf, 1, byterev == QDPUtil::big_endian());
+      bulk = true;
+    }
+  }
+#endif
+
+  if (! bulk)
   {
-    multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
+    // Fall back to reading site by site through the primary node
+    for(int site=0; site < Layout::vol(); ++site)
+    {
+      multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
       
-    // Read in Nd SU(3) matrices. 
-    // NOTE: the su3_matrix layout should be the same as in QDP
-    for(int mu=0; mu < Nd; ++mu)
-      read(cfg_in, u[mu], coord);    // read in a single site
+      // Read in Nd SU(3) matrices. 
+      // NOTE: the su3_matrix layout should be the same as in QDP
+      for(int mu=0; mu < Nd; ++mu)
+	read(cfg_in, u[mu], coord);    // read in a single site
+    }
+
+    if(byterev){
+      QDPIO::cout<<"Doing bytereversal on the links...\n" ;
+      for(int mu(0);mu<Nd;mu++)
+	//slow but hopefully it works
+	for(int s(0); s < Layout::sitesOnNode(); s++)
+	  QDPUtil::byte_swap((void *)&u[mu].elem(s).elem(),sizeof(RealF),2*Nc*Nc);
+    }
   }
 
   cfg_in.close();
-  
-  //QDPUtil::byte_swap((void *)&buf[0], sizeof(Real64), latt_size[0]*Nc*Nc*2 );
-  if(byterev){
-    QDPIO::cout<<"Doing bytereversal on the links...\n" ;
-    for(int mu(0);mu<Nd;mu++)
-      //slow but hopefully it works
-      for(int s(0); s < Layout::sitesOnNode(); s++)
-	QDPUtil::byte_swap((void *)&u[mu].elem(s).elem(),sizeof(RealF),2*Nc*Nc);
+
+  // Verify the checksums. Old writers left them zero
+  unsigned int chk29, chk31;
+  if (sum29 == 0 && sum31 == 0)
+  {
+    QDPIO::cout << "readMILC: no checksums in file, not verified" << std::endl;
+  }
+  else if (milcChecksums(chk29, chk31, u))
+  {
+    if (chk29 != sum29 || chk31 != sum31)
+    {
+      QDPIO::cerr << "readMILC: checksum mismatch: file (sum29, sum31) = (" << sum29 << ", " << sum31 
+		  << ")  computed = (" << chk29 << ", " << chk31 << ")" << std::endl;
+      QDP_abort(1);
+    }
+    QDPIO::cout << "readMILC: checksums verified" << std::endl;
   }
 
   END_CODE();
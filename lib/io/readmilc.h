@@ -7,6 +7,7 @@
 #define __readmilc_h__
 
 #include "io/milc_io.h"
+#include "io/bulk_io.h"
 
 namespace Chroma {
 
@@ -43,6 +44,25 @@ void readMILC(XMLReader& xml, multi1d<LatticeColorMatrixD>& u, const std::string
 
 void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::string& cfg_file);
 
+//! Read the header of a MILC gauge configuration
+/*!
+ * \ingroup io
+ *
+ * Collective, like the reads of cfg_in. The body is left for the caller,
+ * in the byte order of the file.
+ *
+ * \param cfg_in     file positioned at its start ( Modify )
+ * \param header     structure holding config info ( Modify )
+ * \param byterev    the file is in the other byte order ( Write )
+ * \param sum29      checksum of the body, 0 if not written ( Write )
+ * \param sum31      checksum of the body, 0 if not written ( Write )
+ *
+ * \return where the links are in the body
+ */    
+
+BulkFileLayout readMILCHeader(BinaryFileReader& cfg_in, MILCGauge_t& header, 
+			      bool& byterev, unsigned int& sum29, unsigned int& sum31);
+
 
 }  // end namespace Chroma
 
@@ -6,6 +6,7 @@
 #include "chromabase.h"
 #include "io/szin_io.h"
 #include "io/readszin.h"
+#include "io/bulk_io.h"
 // #include "io/param_io.h"
 #include "qdp_util.h"    // from QDP
 
@@ -14,21 +15,20 @@ namespace Chroma {
 #define SZIN_WILSON_FERMIONS  1
 
 
-//! Read a SZIN configuration file
+//! Read the header of a SZIN configuration file
 /*!
  * \ingroup io
  *
- *   Gauge field layout is (fortran ordering)
- *     u(real/imag,color_row,color_col,site,cb,Nd)
- *         = u(2,Nc,Nc,VOL_CB,2,4)
- *
- *
+ * \param cfg_in     file positioned at its start ( Modify )
  * \param header     structure holding config info ( Modify )
- * \param u          gauge configuration ( Modify )
- * \param cfg_file   path ( Read )
+ * \param layout     where the links are in the body ( Write )
+ * \param cfg_file   path of cfg_in ( Read )
+ *
+ * \return true if the body is known to be complete at layout
  */    
 
-void readSzin(SzinGauge_t& header, multi1d<LatticeColorMatrix>& u, const std::string& cfg_file)
+bool readSzinHeader(BinaryFileReader& cfg_in, SzinGauge_t& header, 
+		    BulkFileLayout& layout, const std::string& cfg_file)
 {
   START_CODE();
 
@@ -37,9 +37,6 @@ void readSzin(SzinGauge_t& header, multi1d<LatticeColorMatrix>& u, const std::st
   int banner_size;
   Real32 bh = 0;       // old beta used for higgs term - not used
 
-  // Read in the configuration along with relevant information
-  BinaryFileReader cfg_in(cfg_file); // for now, cfg_io_location not used
-
   read(cfg_in,date_size);
   read(cfg_in,banner_size);
   read(cfg_in,cfg_record_size);
@@ -251,39 +248,106 @@ void readSzin(SzinGauge_t& header, multi1d<LatticeColorMatrix>& u, const std::st
   read(cfg_in, wstat, wstat.size());    // will not use
 
 
+  // The body starts right after the header just parsed, one record per
+  // direction, checkerboarded and big endian
+  const size_t body_bytes = size_t(Nd)*Layout::vol()*Nc*Nc*2*sizeof(REAL32);
+  long body_offset = long(cfg_in.currentPosition());
+  QDPInternal::broadcast(body_offset);
+  long file_size = BulkIO::fileSize(cfg_file);
+
+  layout.offset     = (body_offset > 0) ? size_t(body_offset) : 0;
+  layout.nrec       = Nd;
+  layout.elem_bytes = size_t(Nc*Nc*2*sizeof(REAL32));
+  layout.index      = BulkIO::checkerboardIndex;
+
+  END_CODE();
+
+  return body_offset > 0 && file_size >= body_offset + long(body_bytes);
+}
+
+
+//! Read a SZIN configuration file
+/*!
+ * \ingroup io
+ *
+ *   Gauge field layout is (fortran ordering)
+ *     u(real/imag,color_row,color_col,site,cb,Nd)
+ *         = u(2,Nc,Nc,VOL_CB,2,4)
+ *
+ *
+ * \param header     structure holding config info ( Modify )
+ * \param u          gauge configuration ( Modify )
+ * \param cfg_file   path ( Read )
+ */    
+
+void readSzin(SzinGauge_t& header, multi1d<LatticeColorMatrix>& u, const std::string& cfg_file)
+{
+  START_CODE();
+
+  // Read in the configuration along with relevant information
+  BinaryFileReader cfg_in(cfg_file); // for now, cfg_io_location not used
+
+  BulkFileLayout layout;
+  bool body_known = readSzinHeader(cfg_in, header, layout, cfg_file);
+
   /*
    *  Szin stores data "checkerboarded".  We must therefore "undo" the checkerboarding
    *  We use as a model the propagator routines
    */
   u.resize(Nd);
 
-  multi1d<int> lattsize_cb = Layout::lattSize();
-  lattsize_cb[0] /= 2;		// Evaluate the coords on the checkerboard lattice
+  bool bulk = false;
+#ifndef QDP_IS_QDPJIT
+  if (body_known)
+  {
+    std::vector<char> buf;
+
+    if (BulkIO::readBody(buf, cfg_file, layout))
+    {
+      multi1d<LatticeColorMatrixF> u_old;
+      BulkIO::unpackLinks<REAL32>(u_old, buf, Nd, ! QDPUtil::big_endian());
+
+      for(int j = 0; j < Nd; j++)
+      {
+	LatticeColorMatrix u_old_prec(u_old[j]);
+	u[j] = transpose(u_old_prec);            // Take the transpose
+      }
+
+      bulk = true;
+    }
+  }
+#endif
 
-  // The slowest moving index is the direction
-  for(int j = 0; j < Nd; j++)
+  if (! bulk)
   {
-    LatticeColorMatrixF u_old;
+    multi1d<int> lattsize_cb = Layout::lattSize();
+    lattsize_cb[0] /= 2;		// Evaluate the coords on the checkerboard lattice
+
+    // The slowest moving index is the direction
+    for(int j = 0; j < Nd; j++)
+    {
+      LatticeColorMatrixF u_old;
   
-    for(int cb=0; cb < 2; ++cb) { 
-      for(int sitecb=0; sitecb < Layout::vol()/2; ++sitecb)
-      {
-	multi1d<int> coord = crtesn(sitecb, lattsize_cb); // The coordinate
+      for(int cb=0; cb < 2; ++cb) { 
+	for(int sitecb=0; sitecb < Layout::vol()/2; ++sitecb)
+	{
+	  multi1d<int> coord = crtesn(sitecb, lattsize_cb); // The coordinate
       
-	// construct the checkerboard offset
-	int sum = 0;
-	for(int m=1; m<Nd; m++)
-	  sum += coord[m];
+	  // construct the checkerboard offset
+	  int sum = 0;
+	  for(int m=1; m<Nd; m++)
+	    sum += coord[m];
 
-	// The true lattice x-coord
-	coord[0] = 2*coord[0] + ((sum + cb) & 1);
+	  // The true lattice x-coord
+	  coord[0] = 2*coord[0] + ((sum + cb) & 1);
 
-	read(cfg_in, u_old, coord); 	// Read in an SU(3) matrix into coord
+	  read(cfg_in, u_old, coord); 	// Read in an SU(3) matrix into coord
+	}
       }
-    }
-    LatticeColorMatrix u_old_prec(u_old);
+      LatticeColorMatrix u_old_prec(u_old);
    
-    u[j] = transpose(u_old_prec);            // Take the transpose
+      u[j] = transpose(u_old_prec);            // Take the transpose
+    }
   }
 
   cfg_in.close();
@@ -7,6 +7,7 @@
 #define __readszin_h__
 
 #include "io/szin_io.h"
+#include "io/bulk_io.h"
 
 namespace Chroma {
 
@@ -40,6 +41,25 @@ void readSzin(XMLReader& xml, multi1d<LatticeColorMatrix>& u, const std::string&
 
 void readSzin(SzinGauge_t& header, multi1d<LatticeColorMatrix>& u, const std::string& cfg_file);
 
+//! Read the header of a SZIN configuration file
+/*!
+ * \ingroup io
+ *
+ * Collective, like the reads of cfg_in. The body is left for the caller:
+ * Nd big endian records of single precision links, checkerboarded, each
+ * link the transpose of the Chroma one.
+ *
+ * \param cfg_in     file positioned at its start ( Modify )
+ * \param header     structure holding config info ( Modify )
+ * \param layout     where the links are in the body ( Write )
+ * \param cfg_file   path of cfg_in ( Read )
+ *
+ * \return true if the body is known to be complete at layout
+ */    
+
+bool readSzinHeader(BinaryFileReader& cfg_in, SzinGauge_t& header, 
+		    BulkFileLayout& layout, const std::string& cfg_file);
+
 }  // end namespace Chroma
 
 #endif
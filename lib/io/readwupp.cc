@@ -6,6 +6,7 @@
 #include "chromabase.h"
 
 #include "io/readwupp.h"
+#include "io/bulk_io.h"
 // #include "io/param_io.h"
 #include "qdp_util.h"    // from QDP
 #include "util/gauge/unit_check.h"
@@ -82,37 +83,64 @@ namespace Chroma {
 // (the fastest running direction is the 0th direction, corresponding to the 
 // x-direction)
 
-  u = zero ; 
+  bool bulk = false;
+#ifndef QDP_IS_QDPJIT
+  {
+    // The four ints of the header, then the Nd single precision links of
+    // each site. The reads above already swap a big endian file, so the
+    // raw body needs a swap when exactly one of these applies
+    BulkFileLayout layout = {4*sizeof(int), 1, size_t(Nd*Nc*Nc*2*sizeof(REAL32)), BulkIO::lexicoIndex};
+    std::vector<char> buf;
+
+    QDPIO::cout<<"Reading the gauge fields...\n" ;
+    if (BulkIO::readBody(buf, cfg_file, layout))
+    {
+      multi1d<LatticeColorMatrixF> uF;
+      BulkIO::unpackLinks<REAL32>(uF, buf, 1, byterev == QDPUtil::big_endian());
+
+      u.resize(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+	u[mu] = uF[mu];
 
-  ColorMatrix  uu ; 
-  ColorMatrixF  uuF ; 
+      bulk = true;
+    }
+  }
+#endif
 
-  QDPIO::cout<<"Reading the gauge fields...\n" ;
-  for(int site=0; site < Layout::vol(); ++site)
+  if (! bulk)
   {
-     multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
-    // read in a single site
-    for(int mu=0; mu < Nd; ++mu) 
-      {  
-	read(cfg_in, uuF );  
-	if(byterev){
-	  QDPUtil::byte_swap((void *)&uuF.elem(),sizeof(float),2*Nc*Nc);
-	}
-	uu = uuF;
-	/*
-	if(site < 10 && mu == 0){
-	  QDPIO::cout << "site "<<site<<std::endl;
-	  for(int ic = 0; ic < Nc; ic++){
-	    for(int jc = 0; jc < Nc; jc++){
-	      QDPIO::cout << "ic "<<ic<<" "<< jc<<" "<< peekColor(uuF,ic,jc)<<std::endl;
-	      QDPIO::cout << "ic "<<ic<<" "<< jc<<" "<< peekColor(uu,ic,jc)<<std::endl;
+    u = zero ; 
+
+    ColorMatrix  uu ; 
+    ColorMatrixF  uuF ; 
+
+    QDPIO::cout<<"Reading the gauge fields...\n" ;
+    for(int site=0; site < Layout::vol(); ++site)
+    {
+       multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
+      // read in a single site
+      for(int mu=0; mu < Nd; ++mu) 
+        {  
+	  read(cfg_in, uuF );  
+	  if(byterev){
+	    QDPUtil::byte_swap((void *)&uuF.elem(),sizeof(float),2*Nc*Nc);
+	  }
+	  uu = uuF;
+	  /*
+	  if(site < 10 && mu == 0){
+	    QDPIO::cout << "site "<<site<<std::endl;
+	    for(int ic = 0; ic < Nc; ic++){
+	      for(int jc = 0; jc < Nc; jc++){
+	        QDPIO::cout << "ic "<<ic<<" "<< jc<<" "<< peekColor(uuF,ic,jc)<<std::endl;
+	        QDPIO::cout << "ic "<<ic<<" "<< jc<<" "<< peekColor(uu,ic,jc)<<std::endl;
+	      }
 	    }
 	  }
-	}
-	*/
-	pokeSite(u[mu],uu,coord); 
-      }    
+	  */
+	  pokeSite(u[mu],uu,coord); 
+        }    
 
+    }
   }
 
   cfg_in.close();
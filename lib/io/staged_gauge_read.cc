@@ -0,0 +1,207 @@
+/*! \file
+ *  \brief Read a gauge configuration in the background into a staging field
+ */
+
+#include "io/staged_gauge_read.h"
+
+namespace Chroma
+{
+
+  // Nothing in flight
+  StagedGaugeRead::StagedGaugeRead() : format(NONE), running(false), swap(false),
+				       sum29(0), sum31(0), chk29(0), chk31(0), ok(false) {}
+
+  // Waits for any read in flight
+  StagedGaugeRead::~StagedGaugeRead()
+  {
+    join();
+  }
+
+
+  // Can files of this cfg_type be staged?
+  bool StagedGaugeRead::canStage(const std::string& cfg_type)
+  {
+#ifndef QDP_IS_QDPJIT
+    return cfg_type == "MILC" || cfg_type == "SZIN";
+#else
+    return false;
+#endif
+  }
+
+
+  // Thread body. No QDP calls beyond the layout queries, no allocation of fields
+  void* StagedGaugeRead::run(void* arg)
+  {
+#ifndef QDP_IS_QDPJIT
+    StagedGaugeRead& me = *static_cast<StagedGaugeRead*>(arg);
+
+    me.ok = BulkIO::readLocal(me.buf, me.cfg_file, me.layout);
+    if (me.ok && ! me.buf.empty())
+    {
+      if (me.swap)
+	QDPUtil::byte_swap((void *)&me.buf[0], sizeof(REAL32), me.buf.size() / sizeof(REAL32));
+
+      // MILC has the Nd links of a site together, as the checksums want
+      if (me.format == MILC)
+	milcLocalChecksums(me.chk29, me.chk31, &me.buf[0]);
+
+      BulkIO::unpackLinks<REAL32>(me.u_stage, me.buf, me.layout.nrec, false);
+    }
+
+    // Give the body back straight away
+    std::vector<char>().swap(me.buf);
+#endif
+    return NULL;
+  }
+
+
+  // Join the thread, if there is one
+  void StagedGaugeRead::join()
+  {
+    if (running)
+    {
+      pthread_join(thread, NULL);
+      running = false;
+    }
+  }
+
+
+  // Start reading cfg_file in the background
+  bool StagedGaugeRead::start(const std::string& cfg_type, const std::string& cfg_file_)
+  {
+    join();
+    format = NONE;
+
+    if (! canStage(cfg_type) || ! BulkIO::enabled() || BulkIO::fileSize(cfg_file_) < 0)
+      return false;
+
+    START_CODE();
+
+    cfg_file = cfg_file_;
+    Format fmt = (cfg_type == "MILC") ? MILC : SZIN;
+    bool body_known = true;
+
+    // The headers go through the primary node like in the readers
+    BinaryFileReader cfg_in(cfg_file);
+
+    if (fmt == MILC)
+    {
+      bool byterev;
+      layout = readMILCHeader(cfg_in, milc_header, byterev, sum29, sum31);
+      swap = (byterev == QDPUtil::big_endian());
+    }
+    else
+    {
+      body_known = readSzinHeader(cfg_in, szin_header, layout, cfg_file);
+      swap = ! QDPUtil::big_endian();
+    }
+
+    cfg_in.close();
+
+    if (! body_known)
+    {
+      END_CODE();
+      return false;
+    }
+
+    // The thread may not allocate fields, so the staging field exists
+    // before it starts and is kept for the next read
+    if (u_stage.size() != Nd)
+      u_stage.resize(Nd);
+
+    ok     = false;
+    chk29  = 0;
+    chk31  = 0;
+    format = fmt;
+
+    if (pthread_create(&thread, NULL, &StagedGaugeRead::run, this) != 0)
+    {
+      // Not fatal - read it now, finish() works the same
+      QDPIO::cerr << __func__ << ": could not start read thread for " << cfg_file << std::endl;
+      run(this);
+    }
+    else
+      running = true;
+
+    END_CODE();
+
+    return true;
+  }
+
+
+  // Wait for the read and move it into u
+  bool StagedGaugeRead::finish(XMLReader& gauge_xml, multi1d<LatticeColorMatrix>& u)
+  {
+    if (format == NONE)
+      return false;
+
+    START_CODE();
+
+    join();
+    Format fmt = format;
+    format = NONE;
+
+    // Every node has to have its sites
+    int bad = ok ? 0 : 1;
+    QDPInternal::globalSum(bad);
+    if (bad > 0)
+    {
+      QDPIO::cout << __func__ << ": " << cfg_file << " could not be read on " << bad << " nodes" << std::endl;
+      END_CODE();
+      return false;
+    }
+
+    if (u.size() != Nd)
+      u.resize(Nd);
+
+    XMLBufferWriter  xml_buf;
+
+    if (fmt == MILC)
+    {
+      // Verify the checksums. Old writers left them zero
+      if (sum29 == 0 && sum31 == 0)
+      {
+	QDPIO::cout << __func__ << ": no checksums in " << cfg_file << ", not verified" << std::endl;
+      }
+      else
+      {
+	unsigned int c29 = chk29;
+	unsigned int c31 = chk31;
+	milcGlobalChecksums(c29, c31);
+
+	if (c29 != sum29 || c31 != sum31)
+	{
+	  std::ostringstream error_stream;
+	  error_stream << __func__ << ": checksum mismatch in " << cfg_file
+		       << ": file (sum29, sum31) = (" << sum29 << ", " << sum31
+		       << ")  computed = (" << c29 << ", " << c31 << ")";
+	  END_CODE();
+	  throw error_stream.str();
+	}
+	QDPIO::cout << __func__ << ": checksums verified" << std::endl;
+      }
+
+      for(int mu=0; mu < Nd; ++mu)
+	u[mu] = u_stage[mu];
+
+      write(xml_buf, "MILC", milc_header);
+    }
+    else
+    {
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	LatticeColorMatrix u_old_prec(u_stage[mu]);
+	u[mu] = transpose(u_old_prec);            // Take the transpose
+      }
+
+      write(xml_buf, "szin", szin_header);
+    }
+
+    gauge_xml.open(xml_buf);
+
+    END_CODE();
+
+    return true;
+  }
+
+}  // end namespace Chroma
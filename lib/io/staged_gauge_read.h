@@ -0,0 +1,104 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Read a gauge configuration in the background into a staging field
+ */
+
+#ifndef __staged_gauge_read_h__
+#define __staged_gauge_read_h__
+
+#include "chromabase.h"
+#include "io/readmilc.h"
+#include "io/readszin.h"
+#include <pthread.h>
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Read the next gauge configuration while the current one is measured
+  /*!
+   * \ingroup io
+   *
+   * start() reads the header on the calling thread, as the readers do,
+   * allocates a single precision staging field and then hands the body
+   * to a thread on every node. The thread reads the sites of its node
+   * with BulkIO::readLocal, puts the words in host order, computes this
+   * node's part of the MILC checksums and unpacks the links into the
+   * staging field. It only does POSIX I/O and writes into memory that
+   * already exists, so QDP may be busy with measurements meanwhile.
+   *
+   * finish() waits for the thread, agrees on the result across the
+   * nodes, verifies the checksums and moves the links into the gauge
+   * field. Only the MILC and SZIN formats can be staged, and only when
+   * the bulk path is on: the other readers are collective or live in
+   * QDP. The staging field is kept from one read to the next; a buffer
+   * of the file body of the same size only lives while the thread runs.
+   */
+  class StagedGaugeRead
+  {
+  public:
+    //! Nothing in flight
+    StagedGaugeRead();
+
+    //! Waits for any read in flight
+    ~StagedGaugeRead();
+
+    //! Can files of this cfg_type be staged?
+    static bool canStage(const std::string& cfg_type);
+
+    //! Start reading cfg_file in the background. Collective
+    /*!
+     * Any read in flight is dropped first.
+     * \return false if nothing was started; the file should then be read in the foreground
+     */
+    bool start(const std::string& cfg_type, const std::string& cfg_file);
+
+    //! Wait for the read and move it into u. Collective
+    /*!
+     * Throws a std::string if the checksums of the file do not match.
+     * \return false if the body could not be read; u is then untouched
+     *         and the file should be read in the foreground
+     */
+    bool finish(XMLReader& gauge_xml, multi1d<LatticeColorMatrix>& u);
+
+    //! Is a read in flight?
+    bool active() const {return format != NONE;}
+
+    //! File of the read in flight
+    const std::string& file() const {return cfg_file;}
+
+  private:
+    //! Thread body
+    static void* run(void* arg);
+
+    //! Join the thread, if there is one
+    void join();
+
+    // Hide copies - the thread holds a pointer to this
+    StagedGaugeRead(const StagedGaugeRead&) {}
+    void operator=(const StagedGaugeRead&) {}
+
+  private:
+    enum Format {NONE, MILC, SZIN};
+
+    Format          format;
+    bool            running;
+    pthread_t       thread;
+    std::string     cfg_file;
+    BulkFileLayout  layout;
+    bool            swap;             /*!< the body is not in host byte order */
+
+    MILCGauge_t     milc_header;
+    SzinGauge_t     szin_header;
+    unsigned int    sum29, sum31;     /*!< checksums in the MILC header */
+
+    // Written by the thread
+    std::vector<char>             buf;
+    multi1d<LatticeColorMatrixF>  u_stage;
+    unsigned int    chk29, chk31;     /*!< this node's part of the MILC checksums */
+    bool            ok;
+  };
+
+}  // end namespace Chroma
+
+#endif
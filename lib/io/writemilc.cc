@@ -6,6 +6,7 @@
 #include "chromabase.h"
 #include "io/milc_io.h"
 #include "io/writemilc.h"
+#include "io/bulk_io.h"
 #include "qdp_util.h"    // from QDP
 
 #include <string>
@@ -13,6 +14,35 @@ using std::string;
 
 namespace Chroma {
 
+// Utility functions
+namespace
+{
+  //! Write the header, including the checksums of the body
+  void writeMILCHeader(BinaryFileWriter& cfg_out, const MILCGauge_t& header, 
+		       unsigned int sum29, unsigned int sum31)
+  {
+    int magic_number = 20103;
+    write(cfg_out, magic_number);
+
+    write(cfg_out, header.nrow, Nd);
+
+    // Time stamp - write exactly 64 bytes padded with nulls
+    char date_tmp[65];
+    int len = (header.date.size() < 64) ? header.date.size() : 64;
+    memset(date_tmp, '\0', 65);
+    memcpy(date_tmp, header.date.data(), len);
+    cfg_out.writeArray(date_tmp, 1, 64);
+
+    // Site order - only support non-sitelist format
+    int order = 0;
+    write(cfg_out, order);
+ 
+    write(cfg_out, sum29);
+    write(cfg_out, sum31);
+  }
+}
+
+
 //! Write a MILC configuration file
 /*!
  * \ingroup io
@@ -27,47 +57,55 @@ void writeMILC(const MILCGauge_t& header, const multi1d<LatticeColorMatrix>& u,
 {
   START_CODE();
 
-  BinaryFileWriter cfg_out(cfg_file); // for now, cfg_io_location not used
+  // The format is single precision
+  multi1d<LatticeColorMatrixF> uu(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+    uu[mu] = u[mu];
 
-  int magic_number = 20103;
-  write(cfg_out, magic_number);
+  unsigned int sum29=0, sum31=0;
+  milcChecksums(sum29, sum31, uu);
 
-  write(cfg_out, header.nrow, Nd);
+  // MILC format has the directions inside the sites. The body follows
+  // the header in lexicographic site order
+  BulkFileLayout layout = {size_t(4*(Nd+4) + 64), 1, size_t(Nd*Nc*Nc*2*sizeof(REAL32)),
+			   BulkIO::lexicoIndex};
 
-  // Time stamp - write exactly 64 bytes padded with nulls
-  char date_tmp[65];
-  int len = (header.date.size() < 64) ? header.date.size() : 64;
-  memset(date_tmp, '\0', 65);
-  memcpy(date_tmp, header.date.data(), len);
-  cfg_out.writeArray(date_tmp, 1, 64);
+  {
+    BinaryFileWriter cfg_out(cfg_file); // for now, cfg_io_location not used
+    writeMILCHeader(cfg_out, header, sum29, sum31);
+    cfg_out.close();
+  }
 
-  // Site order - only support non-sitelist format
-  int order = 0;
-  write(cfg_out, order);
- 
-  // Go ahead and write checksums, but will not use for now
-  unsigned int sum29=0, sum31=0;  // WARNING: these are BOGUS
-  write(cfg_out, sum29);
-  write(cfg_out, sum31);
-
-  /*
-   * Write away...
-   */
-  
-  // MILC format has the directions inside the sites
-  for(int site=0; site < Layout::vol(); ++site)
+  bool bulk = false;
+#ifndef QDP_IS_QDPJIT
   {
-    multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
-      
-    // Write Nd SU(3) matrices. 
-    for(int j = 0; j < Nd; j++)
+    // The body is big endian like the header
+    std::vector<char> buf;
+    BulkIO::packLinks<REAL32>(buf, uu, 1, ! QDPUtil::big_endian());
+    bulk = BulkIO::writeBody(cfg_file, layout, buf);
+  }
+#endif
+
+  if (! bulk)
+  {
+    // Fall back to writing site by site through the primary node
+    BinaryFileWriter cfg_out(cfg_file);
+    writeMILCHeader(cfg_out, header, sum29, sum31);
+
+    for(int site=0; site < Layout::vol(); ++site)
     {
-      // NOTE: the su3_matrix layout should be the same as in QDP
-      write(cfg_out, u[j], coord); 
+      multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
+      
+      // Write Nd SU(3) matrices. 
+      for(int j = 0; j < Nd; j++)
+      {
+	// NOTE: the su3_matrix layout should be the same as in QDP
+	write(cfg_out, uu[j], coord); 
+      }
     }
-  }
 
-  cfg_out.close();
+    cfg_out.close();
+  }
 
   END_CODE();
 }
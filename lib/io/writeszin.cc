@@ -6,6 +6,7 @@
 #include "chromabase.h"
 #include "io/szin_io.h"
 #include "io/writeszin.h"
+#include "io/bulk_io.h"
 #include "qdp_util.h"    // from QDP
 
 #include <string>
@@ -114,6 +115,40 @@ void writeSzin(const SzinGauge_t& header, const multi1d<LatticeColorMatrix>& u,
 {
   START_CODE();
 
+  bool bulk = false;
+#ifndef QDP_IS_QDPJIT
+  {
+    // Dump the header, then each node writes its own sites after it
+    {
+      BinaryFileWriter cfg_out(cfg_file); // for now, cfg_io_location not used
+      writeSzinHeader(cfg_out, header);
+      cfg_out.close();
+    }
+
+    long file_size = BulkIO::fileSize(cfg_file);
+
+    if (file_size >= 0)
+    {
+      // One record per direction, checkerboarded, big endian
+      multi1d<LatticeColorMatrixF> u_old_prec(Nd);
+      for(int j = 0; j < Nd; j++)
+	u_old_prec[j] = transpose(u[j]);
+
+      BulkFileLayout layout = {size_t(file_size), Nd, size_t(Nc*Nc*2*sizeof(REAL32)), 
+			       BulkIO::checkerboardIndex};
+      std::vector<char> buf;
+      BulkIO::packLinks<REAL32>(buf, u_old_prec, Nd, ! QDPUtil::big_endian());
+      bulk = BulkIO::writeBody(cfg_file, layout, buf);
+    }
+  }
+#endif
+
+  if (bulk)
+  {
+    END_CODE();
+    return;
+  }
+
   // The object where data is written
   BinaryFileWriter cfg_out(cfg_file); // for now, cfg_io_location not used
 
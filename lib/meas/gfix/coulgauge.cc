@@ -5,6 +5,7 @@
 #include "chromabase.h"
 #include "meas/gfix/coulgauge.h"
 #include "meas/gfix/grelax.h"
+#include "meas/gfix/fourier_gauge.h"
 #include "util/gauge/reunit.h"
 
 namespace Chroma {
@@ -246,4 +247,50 @@ void coulGauge(multi1d<LatticeColorMatrix>& u,
 }
 
 
+//! Coulomb (and Landau) gauge fixing with a choice of algorithm
+/*!
+ * \ingroup gfix
+ *
+ * \param xml_out    xml writer for the convergence history ( Modify )
+ * \param u          (gauge fixed) gauge field ( Modify )
+ * \param g          Gauge transformation matrices (Write)
+ * \param n_gf       number of gauge fixing iterations ( Write )
+ * \param j_decay    direction perpendicular to slices to be gauge fixed ( Read )
+ * \param GFAccu     desired accuracy for gauge fixing ( Read )
+ * \param GFMax      maximal number of gauge fixing iterations ( Read )
+ * \param gfix_type  gauge fixing algorithm ( Read )
+ * \param OrDo       use overrelaxation or not ( Read )
+ * \param OrPara     overrelaxation parameter ( Read )
+ * \param alpha      step size of the Fourier accelerated algorithms ( Read )
+ */
+
+void coulGauge(XMLWriter& xml_out,
+	       multi1d<LatticeColorMatrix>& u, 
+	       LatticeColorMatrix& g,
+	       int& n_gf, 
+	       int j_decay, const Real& GFAccu, int GFMax, 
+	       GFixType gfix_type,
+	       bool OrDo, const Real& OrPara, const Real& alpha)
+{
+  switch (gfix_type)
+  {
+  case GFIX_TYPE_RELAX:
+    coulGauge(u, g, n_gf, j_decay, GFAccu, GFMax, OrDo, OrPara);
+    break;
+
+  case GFIX_TYPE_FOURIER_SD:
+    fourierGauge(xml_out, u, g, n_gf, j_decay, GFAccu, GFMax, false, alpha);
+    break;
+
+  case GFIX_TYPE_FOURIER_CG:
+    fourierGauge(xml_out, u, g, n_gf, j_decay, GFAccu, GFMax, true, alpha);
+    break;
+
+  default:
+    QDPIO::cerr << __func__ << ": unknown gauge fixing type" << std::endl;
+    QDP_abort(1);
+  }
+}
+
+
 } // Namespace Chroma
@@ -7,6 +7,17 @@
 #define __coulgauge_h__
 
 namespace Chroma {
+
+//! Gauge fixing algorithms
+/*! \ingroup gfix */
+enum GFixType 
+{
+  GFIX_TYPE_RELAX,         /*!< checkerboarded SU(2) subgroup relaxation */
+  GFIX_TYPE_FOURIER_SD,    /*!< Fourier accelerated steepest descent */
+  GFIX_TYPE_FOURIER_CG     /*!< Fourier accelerated conjugate gradient */
+};
+
+
 //! Coulomb (and Landau) gauge fixing
 /*!
  * \ingroup gfix
@@ -55,6 +66,36 @@ void coulGauge(multi1d<LatticeColorMatrix>& u,
 	       int j_decay, const Real& GFAccu, int GFMax, 
 	       bool OrDo, const Real& OrPara);
 
+//! Coulomb (and Landau) gauge fixing with a choice of algorithm
+/*!
+ * \ingroup gfix
+ *
+ * As above, but gfix_type picks the algorithm. The relaxation uses OrDo
+ * and OrPara, the Fourier accelerated ones use alpha and stop when the
+ * gauge condition theta (see fourierGauge) drops below GFAccu, writing
+ * their convergence history to xml_out.
+
+ * \param xml_out    xml writer for the convergence history ( Modify )
+ * \param u          (gauge fixed) gauge field ( Modify )
+ * \param g          Gauge transformation matrices (Write)
+ * \param n_gf       number of gauge fixing iterations ( Write )
+ * \param j_decay    direction perpendicular to slices to be gauge fixed ( Read )
+ * \param GFAccu     desired accuracy for gauge fixing ( Read )
+ * \param GFMax      maximal number of gauge fixing iterations ( Read )
+ * \param gfix_type  gauge fixing algorithm ( Read )
+ * \param OrDo       use overrelaxation or not ( Read )
+ * \param OrPara     overrelaxation parameter ( Read )
+ * \param alpha      step size of the Fourier accelerated algorithms ( Read )
+ */
+
+void coulGauge(XMLWriter& xml_out,
+	       multi1d<LatticeColorMatrix>& u, 
+	       LatticeColorMatrix& g,
+	       int& n_gf, 
+	       int j_decay, const Real& GFAccu, int GFMax, 
+	       GFixType gfix_type,
+	       bool OrDo, const Real& OrPara, const Real& alpha);
+
 } // End namespace
 
 #endif
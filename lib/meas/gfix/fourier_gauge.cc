@@ -0,0 +1,282 @@
+/*! \file
+ *  \brief Fourier accelerated Coulomb (and Landau) gauge fixing
+ */
+
+#include "chromabase.h"
+#include "meas/gfix/fourier_gauge.h"
+#include "util/ft/lattice_fft.h"
+#include "util/gauge/reunit.h"
+#include "util/gauge/taproj.h"
+
+#include <vector>
+
+namespace Chroma {
+
+// Utility functions
+namespace
+{
+  //! Functional, normalized to 1 on unit links
+  Double functional(const multi1d<LatticeColorMatrix>& u,
+		    const multi1d<bool>& dirs)
+  {
+    Double f = 0;
+    int ndir = 0;
+
+    for(int mu=0; mu < Nd; ++mu)
+      if (dirs[mu])
+      {
+	f += sum(real(trace(u[mu])));
+	++ndir;
+      }
+
+    return f / Double(Layout::vol()*Nc*ndir);
+  }
+
+  //! Functional after the gauge rotation g
+  Double functional(const multi1d<LatticeColorMatrix>& u,
+		    const LatticeColorMatrix& g,
+		    const multi1d<bool>& dirs)
+  {
+    Double f = 0;
+    int ndir = 0;
+
+    for(int mu=0; mu < Nd; ++mu)
+      if (dirs[mu])
+      {
+	f += sum(real(trace(g * u[mu] * shift(adj(g), FORWARD, mu))));
+	++ndir;
+      }
+
+    return f / Double(Layout::vol()*Nc*ndir);
+  }
+
+  //! Half of Delta: the traceless antihermitian part of sum_mu U_mu(x-mu) - U_mu(x)
+  void divergence(LatticeColorMatrix& delta,
+		  const multi1d<LatticeColorMatrix>& u,
+		  const multi1d<bool>& dirs)
+  {
+    delta = zero;
+
+    for(int mu=0; mu < Nd; ++mu)
+      if (dirs[mu])
+	delta += shift(u[mu], BACKWARD, mu) - u[mu];
+
+    taproj(delta);
+  }
+
+  //! Apply F^-1 p^2_max/p^2 F
+  void precondition(LatticeColorMatrix& p,
+		    const LatticeColorMatrix& delta,
+		    const LatticeFFT& fft,
+		    const LatticeReal& weight)
+  {
+    p = delta;
+    fft(p, +1);
+    p = weight * p;
+    fft(p, -1);
+    taproj(p);
+  }
+
+  //! The gauge rotation 1 + a*s, reunitarized
+  void stepRotation(LatticeColorMatrix& g, const LatticeColorMatrix& s, const Real& a)
+  {
+    g = 1;
+    g += a * s;
+    reunit(g);
+  }
+
+  //! Step size along s from a parabola through the functional at 0, a and 2a
+  Real lineSearch(const multi1d<LatticeColorMatrix>& u,
+		  const LatticeColorMatrix& s,
+		  const multi1d<bool>& dirs,
+		  const Real& a, const Double& f0)
+  {
+    LatticeColorMatrix g;
+
+    stepRotation(g, s, a);
+    Double f1 = functional(u, g, dirs);
+
+    stepRotation(g, s, Real(2)*a);
+    Double f2 = functional(u, g, dirs);
+
+    // f(x) = f0 + b*x + c*x^2
+    Double c = (f2 - Double(2)*f1 + f0) / Double(2*a*a);
+    Double b = (Double(4)*f1 - f2 - Double(3)*f0) / Double(2*a);
+
+    if (toBool(c >= 0) || toBool(b <= 0))
+      return a;
+
+    // Do not trust the parabola too far out
+    Double x = -b / (Double(2)*c);
+    if (toBool(x > Double(4*a)))
+      x = Double(4*a);
+
+    return Real(x);
+  }
+}
+
+
+// Fourier accelerated Coulomb (and Landau) gauge fixing
+void fourierGauge(XMLWriter& xml_out,
+		  multi1d<LatticeColorMatrix>& u,
+		  LatticeColorMatrix& g,
+		  int& n_gf,
+		  int j_decay, const Real& GFAccu, int GFMax,
+		  bool cg, const Real& alpha)
+{
+  START_CODE();
+
+  const multi1d<int>& nrow = Layout::lattSize();
+
+  // Directions in the functional, and in the FFT
+  multi1d<bool> dirs(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+    dirs[mu] = (mu != j_decay);
+
+  LatticeFFT fft(dirs);
+
+  // p^2_max/p^2, with the 1/V of the backward transform and no zero mode
+  LatticeReal psq = zero;
+  Double psq_max = 0;
+  for(int mu=0; mu < Nd; ++mu)
+    if (dirs[mu])
+    {
+      LatticeReal sn = sin(Real(M_PI/nrow[mu]) * Layout::latticeCoordinate(mu));
+      psq += Real(4) * sn * sn;
+
+      double sn_max = sin(M_PI*(nrow[mu]/2)/nrow[mu]);
+      psq_max += 4*sn_max*sn_max;
+    }
+
+  LatticeReal weight = Real(psq_max / Double(fft.volume())) / where(psq > Real(0), psq, LatticeReal(Real(1)));
+  weight = where(psq > Real(0), weight, LatticeReal(zero));
+
+  // Work on a copy of the links in the functional
+  multi1d<LatticeColorMatrix> v(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+    if (dirs[mu])
+      v[mu] = u[mu];
+
+  const Double theta_norm = Double(4) / Double(Layout::vol()*Nc);
+
+  LatticeColorMatrix delta;
+  LatticeColorMatrix p;
+  LatticeColorMatrix p_old;
+  LatticeColorMatrix s;
+  LatticeColorMatrix gs;
+
+  divergence(delta, v, dirs);
+  precondition(p, delta, fft, weight);
+  s = p;
+
+  Double f     = functional(v, dirs);
+  Double theta = theta_norm * norm2(delta);
+  Double dp    = sum(real(trace(adj(delta) * p)));
+
+  QDPIO::cout << "FOURIERGAUGE: " << (cg ? "CG" : "SD")
+	      << "  iter= 0  functional= " << f
+	      << "  theta= " << theta << std::endl;
+
+  // Convergence history, starting with iteration 0
+  std::vector<Double> f_hist(1, f);
+  std::vector<Double> theta_hist(1, theta);
+  std::vector<Real>   step_hist;
+
+  // Gauge transf. matrices always start from identity
+  g = 1;
+  n_gf = 0;
+
+  while( toBool(theta > GFAccu)  &&  n_gf < GFMax )
+  {
+    n_gf = n_gf + 1;
+
+    Real step = alpha;
+    if (cg)
+      step = lineSearch(v, s, dirs, alpha, f);
+
+    stepRotation(gs, s, step);
+
+    for(int mu=0; mu < Nd; ++mu)
+      if (dirs[mu])
+      {
+	LatticeColorMatrix u_tmp = gs * v[mu];
+	v[mu] = u_tmp * shift(adj(gs), FORWARD, mu);
+      }
+
+    LatticeColorMatrix g_tmp = gs * g;
+    g = g_tmp;
+    reunit(g);
+
+    divergence(delta, v, dirs);
+
+    if (cg)
+      p_old = p;
+    precondition(p, delta, fft, weight);
+
+    f     = functional(v, dirs);
+    theta = theta_norm * norm2(delta);
+
+    if (cg)
+    {
+      // Polak-Ribiere, restarting along the gradient if it goes negative
+      Double dp_new = sum(real(trace(adj(delta) * p)));
+      Double beta = (dp_new - sum(real(trace(adj(delta) * p_old)))) / dp;
+      dp = dp_new;
+
+      if (toBool(beta < 0))
+	beta = 0;
+
+      LatticeColorMatrix s_tmp = p + Real(beta) * s;
+      s = s_tmp;
+    }
+    else
+      s = p;
+
+    QDPIO::cout << "FOURIERGAUGE: iter= " << n_gf
+		<< "  functional= " << f
+		<< "  theta= " << theta
+		<< "  step= " << step << std::endl;
+
+    f_hist.push_back(f);
+    theta_hist.push_back(theta);
+    step_hist.push_back(step);
+  }
+
+  QDPIO::cout << "FOURIERGAUGE: end: iter= " << n_gf
+	      << "  functional= " << f
+	      << "  theta= " << theta << std::endl;
+
+  {
+    multi1d<Double> f_out(f_hist.size());
+    multi1d<Double> theta_out(theta_hist.size());
+    multi1d<Real>   step_out(step_hist.size());
+    for(int i=0; i < f_out.size(); ++i)
+    {
+      f_out[i]     = f_hist[i];
+      theta_out[i] = theta_hist[i];
+    }
+    for(int i=0; i < step_out.size(); ++i)
+      step_out[i] = step_hist[i];
+
+    push(xml_out, "FourierGauge");
+    write(xml_out, "algorithm", std::string(cg ? "CG" : "SD"));
+    write(xml_out, "iterations", n_gf);
+    write(xml_out, "functional", f);
+    write(xml_out, "theta", theta);
+    write(xml_out, "functional_history", f_out);
+    write(xml_out, "theta_history", theta_out);
+    write(xml_out, "step_history", step_out);
+    pop(xml_out);
+  }
+
+  // Finally, gauge rotate the original matrices and overwrite them
+  for(int mu = 0; mu < Nd; ++mu)
+  {
+    LatticeColorMatrix u_tmp = g * u[mu];
+    u[mu] = u_tmp * shift(adj(g), FORWARD, mu);
+  }
+
+  END_CODE();
+}
+
+}  // end namespace Chroma
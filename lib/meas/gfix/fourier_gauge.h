@@ -0,0 +1,58 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Fourier accelerated Coulomb (and Landau) gauge fixing
+ */
+
+#ifndef __fourier_gauge_h__
+#define __fourier_gauge_h__
+
+namespace Chroma {
+
+//! Fourier accelerated Coulomb (and Landau) gauge fixing
+/*!
+ * \ingroup gfix
+ *
+ * Maximizes the functional sum_x sum_mu Re tr U_mu(x), mu running over
+ * the directions other than j_decay (all of them if j_decay >= Nd, i.e.
+ * Landau gauge), by gradient steps g(x) = exp(alpha/2 F^-1 [p^2_max/p^2
+ * F Delta](x)), where
+ *
+ *   Delta(x) = sum_mu [ U_mu(x-mu) - U_mu(x) - h.c. - trace ]
+ *
+ * and F is the FFT over the directions in the functional. The exponential
+ * is taken to first order and reunitarized. The preconditioner removes
+ * the critical slowing down of the long wavelength modes (Davies et al,
+ * Phys. Rev. D37 (1988) 1581).
+ *
+ * With cg the steps go along Polak-Ribiere conjugate directions built from
+ * the preconditioned gradients, with a parabolic line search around alpha
+ * for the step size (Hudspith, arXiv:1405.5812). Otherwise this is the
+ * plain steepest descent with the fixed step alpha, for which 0.08 is the
+ * usual choice.
+ *
+ * Iterates until theta = 1/(V Nc) sum_x tr[Delta(x) Delta^dag(x)] is below
+ * GFAccu. The functional and theta of every iteration, and the final
+ * ones, are written to xml_out under FourierGauge.
+ * Note: as written this works only for SU(3)!
+
+ * \param xml_out  xml writer for the convergence history ( Modify )
+ * \param u        (gauge fixed) gauge field ( Modify )
+ * \param g        Gauge transformation matrices (Write)
+ * \param n_gf     number of gauge fixing iterations ( Write )
+ * \param j_decay  direction perpendicular to slices to be gauge fixed ( Read )
+ * \param GFAccu   desired accuracy for gauge fixing ( Read )
+ * \param GFMax    maximal number of gauge fixing iterations ( Read )
+ * \param cg       conjugate gradient, else steepest descent ( Read )
+ * \param alpha    step size ( Read )
+ */
+
+void fourierGauge(XMLWriter& xml_out,
+		  multi1d<LatticeColorMatrix>& u,
+		  LatticeColorMatrix& g,
+		  int& n_gf,
+		  int j_decay, const Real& GFAccu, int GFMax,
+		  bool cg, const Real& alpha);
+
+}  // end namespace Chroma
+
+#endif
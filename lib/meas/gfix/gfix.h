@@ -16,6 +16,7 @@
 
 #include "axgauge.h"
 #include "coulgauge.h"
+#include "fourier_gauge.h"
 #include "grelax.h"
 #include "polar_dec.h"
 #include "rot_colvec.h"
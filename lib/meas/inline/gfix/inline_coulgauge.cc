@@ -5,6 +5,7 @@
 #include "meas/inline/gfix/inline_coulgauge.h"
 #include "meas/inline/abs_inline_measurement_factory.h"
 #include "meas/gfix/coulgauge.h"
+#include "io/enum_io/enum_gfixtype_io.h"
 #include "meas/glue/mesplq.h"
 #include "util/info/proginfo.h"
 #include "util/gauge/unit_check.h"
@@ -36,6 +37,15 @@ namespace Chroma
     read(paramtop, "GFMax", param.GFMax);
     read(paramtop, "OrDo", param.OrDo);
     read(paramtop, "OrPara", param.OrPara);
+
+    // The relaxation is the default
+    param.gfix_type = GFIX_TYPE_RELAX;
+    if (paramtop.count("GFixType") == 1)
+      read(paramtop, "GFixType", param.gfix_type);
+
+    param.alpha = 0.08;
+    if (paramtop.count("alpha") == 1)
+      read(paramtop, "alpha", param.alpha);
   }
 
   //! Parameters for running code
@@ -50,6 +60,8 @@ namespace Chroma
     write(xml, "OrDo", param.OrDo);
     write(xml, "OrPara", param.OrPara);
     write(xml, "j_decay", param.j_decay);
+    write(xml, "GFixType", param.gfix_type);
+    write(xml, "alpha", param.alpha);
 
     pop(xml);
   }
@@ -194,13 +206,15 @@ namespace Chroma
       LatticeColorMatrix g;  // the gauge rotation fields
 
       int n_gf;
-      coulGauge(u_gfix, g, n_gf, params.param.j_decay, params.param.GFAccu, params.param.GFMax,
-		params.param.OrDo, params.param. OrPara);
+      coulGauge(xml_out, u_gfix, g, n_gf, params.param.j_decay, params.param.GFAccu, params.param.GFMax,
+		params.param.gfix_type,
+		params.param.OrDo, params.param.OrPara, params.param.alpha);
     
       // Write out what is done
       push(xml_out,"Gauge_fixing_parameters");
       write(xml_out, "GFAccu",params.param.GFAccu);
       write(xml_out, "GFMax",params.param.GFMax);
+      write(xml_out, "GFixType",params.param.gfix_type);
       write(xml_out, "iterations",n_gf);
       pop(xml_out);
   
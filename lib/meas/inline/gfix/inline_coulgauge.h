@@ -8,6 +8,7 @@
 
 #include "chromabase.h"
 #include "meas/inline/abs_inline_measurement.h"
+#include "meas/gfix/coulgauge.h"
 
 namespace Chroma 
 { 
@@ -34,6 +35,8 @@ namespace Chroma
 	bool OrDo;        /*!< use overrelaxation or not */
 	Real OrPara;      /*!< overrelaxation parameter */
 	int  j_decay;     /*!< direction perpendicular to slices to be gauge fixed */
+	GFixType gfix_type; /*!< gauge fixing algorithm */
+	Real alpha;       /*!< step size of the Fourier accelerated algorithms */
       } param;
 
       struct NamedObject_t
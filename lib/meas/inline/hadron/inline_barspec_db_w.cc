@@ -859,11 +859,14 @@ namespace Chroma
 	      multi2d<ComplexD> hsum;
 	      hsum = phases.sft(latC) ;
 	    
+	      // All the momenta go into the DB in one batch
+	      std::vector< std::pair< SerialDBKey<KeyHadron2PtCorr_t>, SerialDBData<multi1d<ComplexD> > > > batch(phases.numMom());
+
 	      for(int mom(0);mom<phases.numMom();mom++){
 		key.mom = phases.numToMom(mom);    /*<! Momentum  */
-		SerialDBKey<KeyHadron2PtCorr_t> K;
+		SerialDBKey<KeyHadron2PtCorr_t>& K = batch[mom].first;
 		K.key() = key ;
-		SerialDBData<multi1d<ComplexD> >  V ;
+		SerialDBData<multi1d<ComplexD> >& V = batch[mom].second;
 		V.data().resize(Nt);
 		for(int t(0);t<Nt;t++){
 		  int t_eff = (t - t0 + Nt) % Nt;
@@ -872,8 +875,8 @@ namespace Chroma
 		  else
 		    V.data()[t_eff] =  hsum[mom][t];
 		}//loop over time
-		qdp_db.insert(K,V);
 	      }// loop over momenta
+	      insertSorted(qdp_db, batch);
 
 	    }// loop  over source ops
 	  }// loop over sink ops
@@ -12,6 +12,7 @@
 #include "meas/smear/disp_colvec_map.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/elemental_gemm.h"
 #include "util/ft/sftmom.h"
 #include "util/info/proginfo.h"
 #include "meas/inline/make_xml_file.h"
@@ -620,6 +621,17 @@ namespace Chroma
 
       push(xml_out, "ElementalOps");
 
+#ifndef QDP_IS_QDPJIT
+      //
+      // For each left vector i, the diquarks eps_{abc} v_i^a v_j^b are contracted
+      // with the phased right vectors in a single GEMM per time slice
+      //
+      ElementalGEMM contractor(phases.getSet());
+      ElementalGEMM::Panel left_panel(contractor, ElementalGEMM::Panel::COLOR_VECTOR);
+      ElementalGEMM::Panel right_panel(contractor, ElementalGEMM::Panel::COLOR_VECTOR);
+      ElementalGEMM::Result elems;
+#endif
+
       // Loop over all time slices for the source. This is the same 
       // as the subsets for  phases
 
@@ -665,6 +677,42 @@ namespace Chroma
 	  keyDispColorVector[1].displacement = displacement_list[l].middle;
 	  keyDispColorVector[2].displacement = displacement_list[l].right;
 
+#ifndef QDP_IS_QDPJIT
+	  right_panel.clear();
+	  for(int k = 0 ; k < params.param.num_vecs; ++k)
+	  {
+	    keyDispColorVector[2].colvec = k;
+	    right_panel.add(smrd_disp_vecs.getDispVector(keyDispColorVector[2]), phases[mom_num]);
+	  }
+
+	  for(int i = 0 ; i <  params.param.num_vecs; ++i)
+	  {
+	    keyDispColorVector[0].colvec = i;
+
+	    watch.reset();
+	    watch.start();
+
+	    left_panel.clear();
+	    for(int j = 0 ; j < params.param.num_vecs; ++j)
+	    {
+	      keyDispColorVector[1].colvec = j;
+	      left_panel.addCross(smrd_disp_vecs.getDispVector(keyDispColorVector[0]),
+				  smrd_disp_vecs.getDispVector(keyDispColorVector[1]));
+	    }
+
+	    // Contract over color indices and sum over each time slice
+	    contractor.contract(elems, left_panel, right_panel, ElementalGEMM::PLAIN_LEFT);
+
+	    watch.stop();
+
+	    for(int t=0; t < phases.numSubsets(); ++t)
+	    {
+	      for(int k = 0 ; k < params.param.num_vecs; ++k)
+		for(int j = 0 ; j < params.param.num_vecs; ++j)
+		  buf[t].val.data().op(i,j,k) = elems.elem(t,j,k);
+	    }
+	  } // end for i
+#else
 	  for(int i = 0 ; i <  params.param.num_vecs; ++i)
 	  {
 	    for(int j = 0 ; j < params.param.num_vecs; ++j)
@@ -697,6 +745,7 @@ namespace Chroma
 	      } // end for k
 	    } // end for j
 	  } // end for i
+#endif
 
 	  QDPIO::cout << "insert: mom_num= " << mom_num << " displacement num= " << l << std::endl; 
 	  for(int t=0; t < phases.numSubsets(); ++t)
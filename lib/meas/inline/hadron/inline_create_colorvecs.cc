@@ -346,19 +346,35 @@ namespace Chroma
       // Initialize the color vectors with gaussian numbers
       // Gaussian smear in an orthogonalization loop
       //
+      // Smearing is linear, so the vectors of a hit can be smeared together
+      // in blocks before they are orthogonalized
+      const int smear_block = 8;
+
       for(int hit=0; hit <= params.param.num_orthog; ++hit)
       {
-	for(int i=0; i < num_vecs; ++i)
-	{
-	  QDPIO::cout << name << ": Doing colorvec: "<<i << " hit no: "<<hit<<std::endl;
-	  if (hit == 0) {
+	if (hit == 0) {
+	  for(int i=0; i < num_vecs; ++i)
 	    gaussian(evecs[i]);
-	  }
-	  else {
+	}
+	else {
+	  for(int i0=0; i0 < num_vecs; i0 += smear_block)
+	  {
+	    multi1d<LatticeColorVector> block(std::min(smear_block, num_vecs - i0));
+	    for(int b=0; b < block.size(); ++b)
+	      block[b] = evecs[i0+b];
+
 	    gausSmear(u_smr, 
-		      evecs[i],
+		      block,
 		      params.param.width, params.param.num_iter, params.param.decay_dir);
+
+	    for(int b=0; b < block.size(); ++b)
+	      evecs[i0+b] = block[b];
 	  }
+	}
+
+	for(int i=0; i < num_vecs; ++i)
+	{
+	  QDPIO::cout << name << ": Doing colorvec: "<<i << " hit no: "<<hit<<std::endl;
 
 	  for(int k=0; k < i; ++k) {
 	    multi1d<DComplex> cc = 
@@ -396,13 +412,22 @@ namespace Chroma
 	push(xml_out,"SmearingEvals");
 
 
+	multi1d<LatticeColorVector> Svecs;
+
 	for(int i=0; i < num_vecs; ++i) {
-	  LatticeColorVector Svec;
-	  klein_gord(u_smr, evecs[i], Svec, Real(0), params.param.decay_dir);
+	  int b = i % smear_block;
+
+	  if (b == 0) {
+	    multi1d<LatticeColorVector> block(std::min(smear_block, num_vecs - i));
+	    for(int k=0; k < block.size(); ++k)
+	      block[k] = evecs[i+k];
+
+	    klein_gord(u_smr, block, Svecs, Real(0), params.param.decay_dir);
+	  }
 
 	  multi1d<DComplex> cc = 
 	    sumMulti(localInnerProduct(evecs[i], 
-				       Svec),  
+				       Svecs[b]),  
 		     phases.getSet());
 	  
 	  for(int t=0; t < phases.numSubsets(); ++t) {
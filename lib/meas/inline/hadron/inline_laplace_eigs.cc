@@ -1,6 +1,6 @@
 /*! \file
- * \brief Use the IRL method to solve for eigenvalues and eigenvectors 
- * of the gauge-covariant laplacian.  
+ * \brief Use the thick restarted Lanczos method with a Chebyshev filter to
+ * solve for eigenvalues and eigenvectors of the gauge-covariant laplacian.  
  */
 
 #include "fermact.h"
@@ -18,6 +18,7 @@
 #include "meas/inline/make_xml_file.h"
 #include "actions/boson/operator/klein_gord.h"
 #include <qdp-lapack.h>
+#include <algorithm>
 
 #include "meas/inline/io/named_objmap.h"
 
@@ -242,6 +243,79 @@ namespace Chroma
     }
     
     
+#ifndef QDP_IS_QDPJIT
+    namespace
+    {
+      struct RotateArgs
+      {
+	REAL* const*          v;      /*!< first real of each basis vector */
+	const double* const*  y;      /*!< rotation of each time slice, row major */
+	const int*            color;  /*!< time slice of each site */
+	int                   m;
+	int                   k;
+	int                   ld;     /*!< leading dimension of y, at least k */
+      };
+
+      //! v_i = sum_j v_j y(j,i) on the sites [lo,hi)
+      void rotateSiteLoop(int lo, int hi, int my_id, RotateArgs* a)
+      {
+	const int nreal = Nc*2;
+	std::vector<double> x(a->m * nreal);
+
+	for(int site=lo; site < hi; ++site)
+	{
+	  const double* y = a->y[a->color[site]];
+
+	  for(int j=0; j < a->m; ++j)
+	    for(int c=0; c < nreal; ++c)
+	      x[j*nreal+c] = a->v[j][site*nreal+c];
+
+	  for(int i=0; i < a->k; ++i)
+	    for(int c=0; c < nreal; ++c)
+	    {
+	      double s = 0;
+	      for(int j=0; j < a->m; ++j)
+		s += y[j*a->ld+i] * x[j*nreal+c];
+
+	      a->v[i][site*nreal+c] = s;
+	    }
+	}
+      }
+    }
+#endif
+
+    // Replace the basis vectors 0..k-1 by v*y(:,i)
+    void rotateBasis(multi1d<LatticeColorVector>& v, const multi1d< multi2d<double> >& y,
+		     int m, int k, const Set& tslices)
+    {
+#ifndef QDP_IS_QDPJIT
+      std::vector<REAL*> v_ptr(m);
+      std::vector<const double*> y_ptr(y.size());
+
+      for(int j=0; j < m; ++j)
+	v_ptr[j] = (REAL*)&(v[j].elem(0).elem().elem(0).real());
+      for(int t=0; t < y.size(); ++t)
+	y_ptr[t] = &(y[t](0,0));
+
+      // The matrices may have more columns than are used
+      RotateArgs args = {&(v_ptr[0]), &(y_ptr[0]), tslices.latticeColoring().slice(), m, k, y[0].size1()};
+      dispatch_to_threads(Layout::sitesOnNode(), args, rotateSiteLoop);
+#else
+      multi1d<LatticeColorVector> tmp(k);
+      for(int t=0; t < tslices.numSubsets(); ++t)
+	for(int i=0; i < k; ++i)
+	{
+	  tmp[i][tslices[t]] = zero;
+	  for(int j=0; j < m; ++j)
+	    tmp[i][tslices[t]] += Real(y[t](j,i)) * v[j];
+	}
+
+      for(int i=0; i < k; ++i)
+	v[i] = tmp[i];
+#endif
+    }
+    
+    
     // Real work done here
     void 
     InlineMeas::func(unsigned long update_no,
@@ -273,7 +347,7 @@ namespace Chroma
       push(xml_out, "LaplaceEigs");
       write(xml_out, "update_no", update_no);
       
-      QDPIO::cout << name << ": Use the IRL method to solve for laplace eigenpairs" << std::endl;
+      QDPIO::cout << name << ": Use thick restarted Lanczos to solve for laplace eigenpairs" << std::endl;
       
       proginfo(xml_out);    // Print out basic program info
       
@@ -373,402 +447,226 @@ namespace Chroma
 	  
       // Initialize the slow Fourier transform phases
       SftMom phases(0, true, params.param.decay_dir);
+      const Set& tslices = phases.getSet();
       
       int num_vecs = params.param.num_vecs;
       int nt = phases.numSubsets();
-      multi1d<EVPair<LatticeColorVector> >  ev_pairs(num_vecs);
-      for(int n=0; n < num_vecs; ++n) { 
-	ev_pairs[n].eigenValue.weights.resize(nt);
-      }
-      
-	  
-      // Choose the starting eigenvectors to have identical 
-      // components and unit norm. 
-      // The norm is evaluated time slice by time slice
-      LatticeColorVector starting_vectors;
-	  
-      /*
-	ColorVector ones;
-	pokeColor(ones, Complex(1.0), 0);
-	pokeColor(ones, Complex(1.0), 1);
-	pokeColor(ones, Complex(1.0), 2);
-	
-	starting_vectors = ones;
-      */			
-      
-      gaussian(starting_vectors);
-      
-      // Norm of the eigenvectors on each time slice
-      // vector_norms is declared complex, this allows 
-      // us to use partitionedInnerProduct but it may be a
-      // design flaw
-      multi1d<DComplex> vector_norms;
-      
-      
-      QDPIO::cout << "Normalizing starting std::vector" << std::endl;
-      
-      // This function gives the norms squared
-      partitionedInnerProduct(starting_vectors,starting_vectors,vector_norms,phases.getSet());
-      // Apply the square root to get the true norm
-      // and normalise the starting vectors
-      
+      int j_decay = params.param.decay_dir;
+      double tol = toDouble(params.param.tol);
+
+      // Thick restarted Lanczos on each time slice. The basis holds at most
+      // mdim vectors and the residual, and a restart keeps the kdim Ritz 
+      // vectors of largest filtered eigenvalue
+      int mdim = std::max(2*num_vecs, num_vecs + 4);
+      int kdim = num_vecs + (mdim - num_vecs) / 2;
+
       QDPIO::cout << "Nt = " << nt << std::endl;
-      
+      QDPIO::cout << "Basis size = " << mdim << "  kept on restart = " << kdim << std::endl; 
+
+      multi1d<LatticeColorVector> lanczos_vectors(mdim+1);
+
+      // Start from a gaussian vector of unit norm on each time slice
+      gaussian(lanczos_vectors[0]);
+
+      multi1d<DComplex> ip;
+      partitionedInnerProduct(lanczos_vectors[0], lanczos_vectors[0], ip, tslices);
+
+      for(int t=0; t<nt; ++t)
+	lanczos_vectors[0][tslices[t]] *= Real(1.0 / sqrt(toDouble(real(ip[t]))));
+
+      // The projected matrix of each time slice: alpha on the diagonal, the
+      // couplings s of the kept vectors to the first new one, then beta
+      multi1d< multi1d<double> > alpha(nt), beta(nt), s(nt), theta(nt);
+      multi1d< multi2d<double> > y(nt);
+      multi1d<int> nconv(nt);
+
       for(int t=0; t<nt; ++t) {
-	//QDPIO::cout << "vector_norms[" << t << "] = " << vector_norms[t] << std::endl; 
-	
-	vector_norms[t]  = Complex(sqrt(Real(real(vector_norms[t]))));
-	starting_vectors[phases.getSet()[t]] /= vector_norms[t];
-      }
-	  
-	  
-      //Build Krlov subspace
-      int kdim = 3 * params.param.num_vecs;
-      int j_decay = params.param.decay_dir;
-      
-      QDPIO::cout << "Krylov Dim = " << kdim << std::endl; 
-      
-      // beta should really be an array of Reals	
-      multi1d< multi1d<DComplex> > beta(kdim-1);	
-      multi1d< multi1d<DComplex> > alpha(kdim);
-      
-      multi1d<double*> d(nt);
-      multi1d<double*> e(nt);
-      multi1d<double*> z(nt);
-      
-      for (int t = 0 ; t < nt ; ++t) {
-	d[t] = new double[kdim];
-	e[t] = new double[kdim - 1];
-	z[t] = new double[(kdim) * (kdim)];
+	alpha[t].resize(mdim);
+	beta[t].resize(mdim);
+	s[t].resize(kdim);
+	theta[t].resize(mdim);
+	y[t].resize(mdim, mdim);
       }
-      
-      for (int k = 0 ; k < kdim ; ++k) {
-	
-	alpha[k].resize(nt);
-	
-	if (k < kdim - 1) {
-	  
-	  beta[k].resize(nt);
-	}
-      }
-	  
 
-      multi1d<LatticeColorVector> lanczos_vectors(kdim);
-      lanczos_vectors[0] = starting_vectors;
-      
-      // Yields alpha[0] ... alpha[kdim-2]
-      // 				beta[0] ... beta[kdim-2] 
-      // 				lanczos_vector[0] ... lanczos_vector[kdim-1]
-      // After the last iteration compute alpha[kdim-1]
-      for(int k=0; k<kdim-1; ++k) {
-	
-	//QDPIO::cout << "k = " << k << std::endl; 
-	
-	
-	//temporary seems to be defined as a single element but is used as both an array and a single element?
-	LatticeColorVector temporary;
-	// Apply the spatial Laplace operator; j_decay denotes the temporal direction		
-	//laplacian(u_smr,lanczos_vectors[k],temporary,j_decay); 
-	chebyshev(u_smr,lanczos_vectors[k],temporary,j_decay); 
-	
-	if(k > 0){	
-	  for(int t=0; t<nt; ++t){
-	    temporary[phases.getSet()[t]] -= beta[k-1][t]*lanczos_vectors[k-1];
+      int k = 0;         // number of kept vectors
+      int iter = 0;      // number of Lanczos steps
+      int restarts = 0;
+
+      for(;;) {
+	// Extend the basis from k to mdim vectors
+	for(int j=k; j<mdim; ++j, ++iter) {
+	  LatticeColorVector& w = lanczos_vectors[j+1];
+
+	  chebyshev(u_smr, lanczos_vectors[j], w, j_decay);
+
+	  for(int t=0; t<nt; ++t) {
+	    if (j == k) {
+	      for(int i=0; i<k; ++i)
+		w[tslices[t]] -= Real(s[t][i]) * lanczos_vectors[i];
+	    }
+	    else
+	      w[tslices[t]] -= Real(beta[t][j-1]) * lanczos_vectors[j-1];
 	  }
-	}
-	    
-	partitionedInnerProduct(lanczos_vectors[k],temporary,alpha[k],phases.getSet());
-	
-	for(int t=0; t<nt; ++t){
-	  //QDPIO::cout << "alpha[k][" << t << "] = " << alpha[k][t] << std::endl;
-	  temporary[phases.getSet()[t]] -= alpha[k][t]*lanczos_vectors[k];
-	}
-	    
-	    
-	QDPIO::cout << "Reorthogonalizing" << std::endl;	
-	multi1d<DComplex> alpha_temp(nt);
-	// Reorthogonalise - this may be unnecessary
-	if(k>0){
-	  
-	  partitionedInnerProduct(lanczos_vectors[k-1],temporary,alpha_temp,phases.getSet());
-	  for(int t=0; t<nt; ++t){
-	    temporary[phases.getSet()[t]] -= alpha_temp[t]*lanczos_vectors[k-1];
+
+	  partitionedInnerProduct(lanczos_vectors[j], w, ip, tslices);
+
+	  for(int t=0; t<nt; ++t) {
+	    alpha[t][j] = toDouble(real(ip[t]));
+	    w[tslices[t]] -= Real(alpha[t][j]) * lanczos_vectors[j];
 	  }
-	}
-	    
-	partitionedInnerProduct(lanczos_vectors[k],temporary,alpha_temp,phases.getSet());
-	
-	for(int t=0; t<nt; ++t){
-	  temporary[phases.getSet()[t]] -= alpha_temp[t]*lanczos_vectors[k];
-	} //
-	
-	    
-	// Global reorthogonalisation to go here?	
-	// .......
-	// .....	
-	
-	partitionedInnerProduct(temporary,temporary,beta[k],phases.getSet());
-	    
-	for(int t=0; t<nt; ++t) {
-	  //QDPIO::cout << "beta[k][" << t << "] = " << beta[k][t] << std::endl;
-	  beta[k][t] = Complex(sqrt(Real(real(beta[k][t]))));
-	  lanczos_vectors[k+1][phases.getSet()[t]] = temporary/beta[k][t];
-	  //if (k < kdim - 1)
-	  d[t][k] = toDouble(Real(real(alpha[k][t])));
-	  
-	  //if (k < kdim - 2)
-	  e[t][k] = toDouble(Real(real(beta[k][t])));
-	}
-	/*
-	  QDPIO::cout << "Checking orthogonality of std::vector " << k+1 << std::endl;
-	  for(int m = 0; m <= k; m++){
-	  multi1d<DComplex> tmp(nt);
-	  partitionedInnerProduct(lanczos_vectors[k+1],lanczos_vectors[m],tmp,phases.getSet());
-	  
-	  
-	  for(int t = 0; t < nt; t++){
-	  QDPIO::cout << "   t = " << t << ": " << tmp[t] << std::endl;
+
+	  // Full reorthogonalisation, twice is enough
+	  for(int pass=0; pass<2; ++pass) {
+	    for(int i=0; i<=j; ++i) {
+	      partitionedInnerProduct(lanczos_vectors[i], w, ip, tslices);
+	      for(int t=0; t<nt; ++t)
+		w[tslices[t]] -= ip[t] * lanczos_vectors[i];
+	    }
 	  }
+
+	  partitionedInnerProduct(w, w, ip, tslices);
+
+	  for(int t=0; t<nt; ++t) {
+	    beta[t][j] = sqrt(toDouble(real(ip[t])));
+	    if (beta[t][j] > 0)
+	      w[tslices[t]] *= Real(1.0 / beta[t][j]);
 	  }
-	*/
-	
-      }
-      // Loop over k is complete, now compute alpha[kdim-1]
-      
-      LatticeColorVector tmp;
-      
-      chebyshev(u_smr, lanczos_vectors[kdim-1], tmp, j_decay);
-      
-      for(int t = 0; t < nt; t++){
-	tmp[phases.getSet()[t]] -= beta[kdim-2][t]*lanczos_vectors[kdim-2];
-      }
-      
-      partitionedInnerProduct(lanczos_vectors[kdim-1],tmp,alpha[kdim-1],phases.getSet());
-      
-      // Finally compute eigenvectors and eigenvalues
-      
-      //Is AL = LT, up to small corrections? 
-      
-      
-      /*
-	QDPIO::cout << "Testing AL = LT" << std::endl;
-	
-	
-	for (int k = 0 ; k < kdim -1 ; ++k)
-	{
-	QDPIO::cout << "Row " << k << std::endl;
-	
-	LatticeColorVector al = zero;
-	
-	//laplacian(u_smr, lanczos_vectors[k], al, j_decay);
-	chebyshev(u_smr, lanczos_vectors[k], al, j_decay);
-	
-	LatticeColorVector lt = zero;
-	
-	for (int t = 0 ; t < nt ; ++t)
-	{	
-	if (k != 0)
-	{
-	lt[ phases.getSet()[t] ] += toDouble(Real(real(beta[k-1][t])))
-	* lanczos_vectors[k-1];
 	}
-	
-	if (k != (kdim - 2))
-	{
-	
-	lt[phases.getSet()[t]] += toDouble(Real(real(beta[k][t]))) * 
-	lanczos_vectors[k+1];
-	}
-	
-	lt[ phases.getSet()[t] ] += toDouble(Real(real(alpha[k][t]))) * 
-	lanczos_vectors[k];
-	} //t
-	
-	LatticeColorVector ldiff = al - lt; 
-	
-	multi1d<DComplex> ldcnt(nt); 
-	partitionedInnerProduct(ldiff, ldiff, ldcnt, phases.getSet());
-	
-	for (int t = 0 ; t < nt ; t++)
-	
-	if (toDouble(Real(real(ldcnt[t]))) > 1e-5)
-	QDPIO::cout << "   dcnt[" << t << "] = " << ldcnt[t] << std::endl; 
-	
-	} //k
-	    
-      */
-	  
-      //parameters for dsteqr
-      char compz = 'I';
-      
-      double* work  = new double[2*(kdim) - 2];
-      
-      int info = 0;
-      int ldz = kdim;
-      
-      
-      multi1d< multi1d< multi1d<double> > > evecs(nt);
-      multi1d< multi1d<double> > evals(nt);
-      
-      for(int t = 0; t < nt; t++) {
-	
-	//QDPIO::cout << "Starting QR factorization t = " << t << std::endl;
+
+	// Ritz pairs and their convergence on each time slice
 	fossil.reset();
 	fossil.start();
-	
-	QDPLapack::dsteqr(&compz, &ldz, d[t], e[t], z[t], &ldz, work, &info);
-	
+
+	bool converged = true;
+
+	for(int t=0; t<nt; ++t) {
+	  multi2d<DComplex> T(mdim, mdim);
+	  for(int i=0; i<mdim; ++i)
+	    for(int j=0; j<mdim; ++j)
+	      T(i,j) = zero;
+
+	  for(int j=0; j<mdim; ++j)
+	    T(j,j) = DComplex(Double(alpha[t][j]));
+
+	  for(int i=0; i<k; ++i) {
+	    T(i,k) = DComplex(Double(s[t][i]));
+	    T(k,i) = DComplex(Double(s[t][i]));
+	  }
+
+	  for(int j=k; j<mdim-1; ++j) {
+	    T(j,j+1) = DComplex(Double(beta[t][j]));
+	    T(j+1,j) = DComplex(Double(beta[t][j]));
+	  }
+
+	  multi1d<Double> evals;
+	  char V = 'V'; char U = 'U';
+	  QDPLapack::zheev(V, U, T, evals);
+
+	  // Largest first. Row n of T is the conjugate of eigenvector n
+	  for(int i=0; i<mdim; ++i) {
+	    int n = mdim - 1 - i;
+	    theta[t][i] = toDouble(evals[n]);
+	    for(int j=0; j<mdim; ++j)
+	      y[t](j,i) = toDouble(real(T(n,j)));
+	  }
+
+	  // Count the leading pairs with a small residual |beta y(m-1,i)|
+	  nconv[t] = 0;
+	  while (nconv[t] < num_vecs &&
+		 fabs(beta[t][mdim-1] * y[t](mdim-1,nconv[t])) < tol * fabs(theta[t][nconv[t]]))
+	    ++nconv[t];
+
+	  if (nconv[t] < num_vecs)
+	    converged = false;
+	}
+
 	fossil.stop();
-	
-	QDPIO::cout << "LAPACK routine completed: " << fossil.getTimeInSeconds() << " sec" << std::endl;
-	
-	QDPIO::cout << "info = " << info << std::endl;
-	
-	
-	evecs[t].resize(kdim);
-	evals[t].resize(kdim);
-	
-	for (int v = 0 ; v < kdim ; ++v) {
-	  evals[t][v] = d[t][v]; 
-	  
-	  //QDPIO::cout << "Eval[ " << v << "] = " << evals[t][v] << std::endl;
-	  
-	  evecs[t][v].resize(kdim);
-	  
-	  for (int n = 0 ; n < kdim ; ++n) {
-	    evecs[t][v][n] = z[t][v * (kdim ) + n ];
+
+	int min_conv = num_vecs;
+	for(int t=0; t<nt; ++t)
+	  min_conv = std::min(min_conv, nconv[t]);
+
+	QDPIO::cout << "Restart " << restarts << ": iter = " << iter 
+		    << "  fewest converged on a time slice = " << min_conv 
+		    << "  Ritz time = " << fossil.getTimeInSeconds() << " sec" << std::endl;
+
+	if (converged || iter >= params.param.max_iter) {
+	  if (! converged)
+	    QDPIO::cout << name << ": WARNING: not all eigenpairs converged after "
+			<< iter << " iterations" << std::endl;
+
+	  // The wanted Ritz vectors become the first num_vecs basis vectors
+	  rotateBasis(lanczos_vectors, y, mdim, num_vecs, tslices);
+	  break;
+	}
+
+	// Thick restart. Converged pairs are locked by dropping their coupling
+	rotateBasis(lanczos_vectors, y, mdim, kdim, tslices);
+	lanczos_vectors[kdim] = lanczos_vectors[mdim];
+
+	for(int t=0; t<nt; ++t) {
+	  for(int i=0; i<kdim; ++i) {
+	    alpha[t][i] = theta[t][i];
+	    s[t][i] = (i < nconv[t]) ? 0.0 : beta[t][mdim-1] * y[t](mdim-1,i);
 	  }
-	  
-	  //Apply matrix to std::vector
-	  multi1d<double> Av(kdim );
-	  
-	  double dcnt = 0;
-	  
-	  for (int n = 0 ; n < kdim  ; ++n) {
-	    Av[n] = 0;
-	    if (n != 0) {
-	      Av[n] += toDouble(Real(real(beta[n-1][t]))) * 
-		evecs[t][v][n-1];
-	    }
-	    
-	    if (n != (kdim - 1)) {
-	      
-	      Av[n] += toDouble(Real(real(beta[n][t]))) * 
-		evecs[t][v][n+1];
-	    }
-	    
-	    Av[n] += toDouble(Real(real(alpha[n][t]))) * 
-	      evecs[t][v][n];
-	    
-	    
-	    dcnt += (Av[n] - evals[t][v]*evecs[t][v][n]) *
-	      (Av[n] - evals[t][v]*evecs[t][v][n]);
-	  }//n
-	  
-	  //QDPIO::cout << "Vector " << v << " : dcnt = " << dcnt << std::endl;
-	  
-	}//v
-	    
-      }//t
-      
+	}
+
+	k = kdim;
+	++restarts;
+      }
+
+      write(xml_out, "iterations", iter);
+      write(xml_out, "restarts", restarts);
       
-      //Get Eigenvectors
+      // The eigenvalues of the laplacian, written with each vector
+      multi1d< multi1d<Real> > lap_evals(num_vecs);
 
       QDPIO::cout << "Obtaining eigenvectors of the laplacian" << std::endl;
-      for (int k = 0 ; k < params.param.num_vecs ; ++k) {
-	LatticeColorVector vec_k = zero;
-	
-	//LatticeColorVector lambda_v = zero;
-	    
-	for (int t = 0 ; t < nt ; ++t) {
-	  //QDPIO::cout << "t = " << t << std::endl;
-	  
-	  for (int n = 0 ; n < kdim  ; ++n) {
-	    vec_k[phases.getSet()[t] ] += 
-	      Real(evecs[t][kdim - 1 - k][n]) * lanczos_vectors[n];
-	  }
-	  
-	  //QDPIO::cout << "Made evector" << std::endl;
-	  
-	  //lambda_v[phases.getSet()[t] ] += 
-	  //	Real(evals[t][kdim - 3 - k]) * vec_k; 
-	  
-	  
-	  //QDPIO::cout << "Eval[" << k << "] = " <<
-	  
-	}
-	    
-	ev_pairs[k].eigenVector = vec_k;
-	    
-	//Test if this is an eigenstd::vector
-	//	LatticeColorVector avec = zero;
+      for (int n = 0 ; n < num_vecs ; ++n) {
+	EVPair<LatticeColorVector> ev_pair;
+	ev_pair.eigenVector = lanczos_vectors[n];
+	ev_pair.eigenValue.weights.resize(nt);
 	
-	/*
-	//laplacian(u_smr, vec_k, avec, j_decay);
-	chebyshev(u_smr, vec_k, avec, j_decay);
-	
-	multi1d< DComplex > dcnt_arr(nt);
-	
-	LatticeColorVector diffs = avec - lambda_v;
-	partitionedInnerProduct( diffs, diffs, dcnt_arr, phases.getSet());  
-	*/
-	
-	//QDPIO::cout << "Testing Lap. eigvec " << k << std::endl;
-	/*
-	  for (int t = 0 ; t < nt ; ++t)
-	  {
-	  if (toDouble(Real(real(dcnt_arr[t]))) > 1e-5) 
-	  QDPIO::cout << "dcnt[" << t << "] = " << dcnt_arr[t] 
-	  << std::endl;
-	  }
-	*/
-	    
+	const LatticeColorVector& vec_n = ev_pair.eigenVector;
+
 	multi1d< DComplex > temp(nt);
 	multi1d< DComplex > temp2(nt);
 	
 	LatticeColorVector bvec = zero;
-	laplacian(u_smr, vec_k, bvec, j_decay);
-	partitionedInnerProduct(vec_k, bvec, temp, phases.getSet());
-	partitionedInnerProduct(vec_k, vec_k, temp2, phases.getSet());
+	laplacian(u_smr, vec_n, bvec, j_decay);
+	partitionedInnerProduct(vec_n, bvec, temp, tslices);
+	partitionedInnerProduct(vec_n, vec_n, temp2, tslices);
 	
 	//Obtaining eigenvalues of the laplacian
+	LatticeColorVector lambda_v2 = zero;
+
 	for(int t = 0; t < nt; t++){
 	  Complex temp3 = temp[t] / temp2[t];
 	  
-	  evals[t][k] = -1.0 * toDouble(Real(real(temp3)));
-	  
-	  ev_pairs[k].eigenValue.weights[t] = 
-	    Real(evals[t][k]);
+	  ev_pair.eigenValue.weights[t] = -1.0 * Real(real(temp3));
+	  lambda_v2[tslices[t]] = ev_pair.eigenValue.weights[t] * vec_n;
 	  
 	  QDPIO::cout << "t = " << t << std::endl;
-	  QDPIO::cout << "lap_evals[" << k << "] = " << evals[t][k] << std::endl;
-	}
-	
-	LatticeColorVector lambda_v2 = zero;
-	
-	for(int t = 0; t < nt; t++){
-	  
-	  lambda_v2[phases.getSet()[t]] = Real(evals[t][k]) * vec_k;
-	  
+	  QDPIO::cout << "lap_evals[" << n << "] = " << ev_pair.eigenValue.weights[t] << std::endl;
 	}
 	
 	multi1d< DComplex > dcnt_arr2(nt);
 	
 	LatticeColorVector diffs2 = bvec + lambda_v2;
 	
-	partitionedInnerProduct(diffs2, diffs2, dcnt_arr2, phases.getSet());
+	partitionedInnerProduct(diffs2, diffs2, dcnt_arr2, tslices);
 	
-	QDPIO::cout << "Testing Laplace Eigenvalue " << k << std::endl;
+	QDPIO::cout << "Testing Laplace Eigenvalue " << n << std::endl;
 	for(int t = 0; t < nt; t++){
 	  if(toDouble(Real(real(dcnt_arr2[t]))) > 1e-5)
-	    QDPIO::cout << "dcnt[" << k << "] = " << dcnt_arr2[t] << std::endl;
+	    QDPIO::cout << "dcnt[" << n << "] = " << dcnt_arr2[t] << std::endl;
 	}
-	
-      }//k
 
-      for(int n=0; n < num_vecs; n++) { 
-	color_vecs.insert(n, ev_pairs[n]);
-      }
+	// Straight into the colorvec db
+	lap_evals[n] = ev_pair.eigenValue.weights;
+	color_vecs.insert(n, ev_pair);
+      }//n
+
       color_vecs.flush();
       
       //pop(xml_out);
@@ -797,7 +695,7 @@ namespace Chroma
 	for(int i(0);i<num_vecs;i++){
 	  push(record_xml, "EigenPair");
 	  write(record_xml, "EigenPairNumber", i); 
-	  write(record_xml, "EigenValues", ev_pairs[i].eigenValue.weights); 
+	  write(record_xml, "EigenValues", lap_evals[i]); 
 	  pop(record_xml);
 	}
 	pop(record_xml);
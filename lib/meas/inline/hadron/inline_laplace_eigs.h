@@ -1,6 +1,6 @@
 // -*- C++ -*-
 /*! \file
- * \brief Use the Implicitly Restarted Lanczos method with a Tchebyshev 
+ * \brief Use the thick restarted Lanczos method with a Chebyshev
  * polynomial preconditioner to solve for the lowest eigenvalues and 
  * eigenvectors of the gague-covariant Laplacian
  */
@@ -75,6 +75,17 @@ namespace Chroma
       Params params;
     };
 
+
+    //! Replace the basis vectors 0..k-1 by v*y(:,i), with y(j,i) for j < m the rotation of each time slice
+    /*!
+     * \ingroup inlinehadron
+     *
+     * Done in place site by site, so the restart needs no extra lattice
+     * fields. Each y[t] may have more than k columns.
+     */
+    void rotateBasis(multi1d<LatticeColorVector>& v, const multi1d< multi2d<double> >& y,
+		     int m, int k, const Set& tslices);
+
   } // namespace LaplaceEigsEnv
 
 }
@@ -20,6 +20,7 @@
 #include "util/ferm/key_prop_colorvec.h"
 #include "util/ferm/key_prop_matelem.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/timeslice_io_cache.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -138,6 +139,13 @@ namespace Chroma
 	  }
       }
 
+      input.colorvec_cache_mb = 0;
+      if (inputtop.count("colorvec_cache_mb") == 1)
+	read(inputtop, "colorvec_cache_mb", input.colorvec_cache_mb);
+
+      input.colorvec_single_prec = false;
+      if (inputtop.count("colorvec_single_prec") == 1)
+	read(inputtop, "colorvec_single_prec", input.colorvec_single_prec);
     }
 
     //! Propagator output
@@ -151,6 +159,8 @@ namespace Chroma
       write(xml, "Nt_forward", input.Nt_forward);
       write(xml, "Nt_backward", input.Nt_backward);
       write(xml, "mass_label", input.mass_label);
+      write(xml, "colorvec_cache_mb", input.colorvec_cache_mb);
+      write(xml, "colorvec_single_prec", input.colorvec_single_prec);
 
       pop(xml);
     }
@@ -549,7 +559,17 @@ namespace Chroma
 
       // The sub-lattice eigenstd::vector std::map
       QDPIO::cout << "Initialize sub-lattice std::map" << std::endl;
+#ifndef BUILD_JIT_CONTRACTION_KERNELS
+      TimeSliceIOCache colorvec_cache(eigen_source, params.param.contract.num_vecs,
+				      size_t(params.param.contract.colorvec_cache_mb)*1024*1024,
+				      params.param.contract.colorvec_single_prec);
+      colorvec_cache.setTimeOffset(t_offset, lt_orig);
+      colorvec_cache.setZeroVecs(params.param.contract.zero_colorvecs);
+      const Set& time_slice_set = colorvec_cache.getSet();
+#else
       SubEigenMap sub_eigen_map(eigen_source, decay_dir, params.param.contract.zero_colorvecs, t_offset , lt_orig );
+      const Set& time_slice_set = sub_eigen_map.getSet();
+#endif
       QDPIO::cout << "Finished initializing sub-lattice std::map" << std::endl;
 
 
@@ -704,7 +724,7 @@ namespace Chroma
 
 			      prop_obj.get( key , time_slice_io );
 			      
-			      ferm_out(spin_sink)[ sub_eigen_map.getSet()[t] ] = tmp;
+			      ferm_out(spin_sink)[ time_slice_set[t] ] = tmp;
 			    }
 			}
 
@@ -727,6 +747,8 @@ namespace Chroma
 		  // Loop over time
 
 #ifndef BUILD_JIT_CONTRACTION_KERNELS
+		  multi1d<ComplexD> prods;
+
 		  for(int t_slice = 0; t_slice < Lt; ++t_slice)
 		    {
 		      // Loop over all the keys
@@ -736,11 +758,12 @@ namespace Chroma
 			{
 			  if (key->t_slice != t_slice) {continue;}
 
-			  // Loop over the sink colorvec, form the innerproduct and the resulting perambulator
+			  // All the sink colorvecs of the time slice at once
+			  colorvec_cache.innerProducts(prods, t_slice, ferm_out(key->spin_snk));
+
 			  for(int colorvec_sink=0; colorvec_sink < num_vecs; ++colorvec_sink)
 			    {
-			      peram[*key].mat(colorvec_sink,colorvec_src) = innerProduct(sub_eigen_map.getVec(t_slice, colorvec_sink), 
-											 ferm_out(key->spin_snk));
+			      peram[*key].mat(colorvec_sink,colorvec_src) = prods[colorvec_sink];
 			    } // for colorvec_sink
 			} // for key
 		    } // for t_slice
@@ -878,6 +901,10 @@ namespace Chroma
       write(xml_out, "ncg_had", ncg_had);
       pop(xml_out);
 
+#ifndef BUILD_JIT_CONTRACTION_KERNELS
+      write(xml_out, "ColorVecCache", colorvec_cache);
+#endif
+
       pop(xml_out);  // prop_dist
 
       snoop.stop();
@@ -46,6 +46,8 @@ namespace Chroma
 
 	  bool          zero_colorvecs;
 	  bool          fuse_timeloop;  
+	  int           colorvec_cache_mb;     /*!< Memory budget in MB for the cached colorvecs, 0 for no limit */
+	  bool          colorvec_single_prec;  /*!< Cache the colorvecs in single precision */
 	};
 
 	Contract_t      contract;
@@ -13,6 +13,7 @@
 #include "meas/glue/mesplq.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/elemental_gemm.h"
 #include "util/ft/sftmom.h"
 #include "util/info/proginfo.h"
 #include "meas/inline/make_xml_file.h"
@@ -564,6 +565,22 @@ namespace Chroma
 
       push(xml_out, "ElementalOps");
 
+#ifndef QDP_IS_QDPJIT
+      //
+      // The left vectors are the same for every operator, so they are gathered once.
+      // Each operator is then a single GEMM per time slice and momentum.
+      //
+      ElementalGEMM contractor(phases.getSet());
+      ElementalGEMM::Panel left_panel(contractor, ElementalGEMM::Panel::COLOR_VECTOR);
+      ElementalGEMM::Panel right_panel(contractor, ElementalGEMM::Panel::COLOR_VECTOR);
+      ElementalGEMM::Result elems;
+
+      for(int i = 0 ; i < params.param.num_vecs; ++i)
+      {
+	EVPair<LatticeColorVector> tmpvec; eigen_source.get(i,tmpvec);
+	left_panel.add(tmpvec.eigenVector);
+      }
+#endif
 
       // Loop over all time slices for the source. This is the same 
       // as the subsets for  phases
@@ -584,6 +601,19 @@ namespace Chroma
 	swiss.reset();
 	swiss.start();
 
+#ifndef QDP_IS_QDPJIT
+	// Displace the right vectors once; the momentum phases are folded in when packing
+	multi1d<LatticeColorVector> shift_vecs(params.param.num_vecs);
+	for(int j = 0 ; j < params.param.num_vecs; ++j)
+	{
+	  EVPair<LatticeColorVector> tmpvec; eigen_source.get(j,tmpvec);
+	  shift_vecs[j] = displace(u_smr, 
+				   tmpvec.eigenVector, 
+				   params.param.displacement_length, 
+				   disp);
+	}
+#endif
+
 	// Big loop over the momentum projection
 	for(int mom_num = 0 ; mom_num < phases.numMom() ; ++mom_num) 
 	{
@@ -612,6 +642,28 @@ namespace Chroma
 	    }
 	  }
 
+#ifndef QDP_IS_QDPJIT
+	  right_panel.clear();
+	  for(int j = 0 ; j < params.param.num_vecs; ++j)
+	  {
+	    right_panel.add(shift_vecs[j], phases[mom_num]);
+	  }
+
+	  // Contract over color indices and sum over each time slice
+	  watch.reset();
+	  watch.start();
+
+	  contractor.contract(elems, left_panel, right_panel, ElementalGEMM::CONJ_LEFT);
+
+	  watch.stop();
+
+	  for(int t=0; t < phases.numSubsets(); ++t)
+	  {
+	    for(int j = 0 ; j < params.param.num_vecs; ++j)
+	      for(int i = 0 ; i < params.param.num_vecs; ++i)
+		buf[t].val.data().op(i,j) = elems.elem(t,i,j);
+	  }
+#else
 	  for(int j = 0 ; j < params.param.num_vecs; ++j)
 	  {
 	    // Displace the right std::vector and multiply by the momentum phase
@@ -644,6 +696,7 @@ namespace Chroma
 //	      write(xml_out, "elem", key.key());  // debugging
 	    } // end for j
 	  } // end for i
+#endif
 
 	  QDPIO::cout << "insert: mom= " << phases.numToMom(mom_num) << " displacement= " << disp << std::endl; 
 	  for(int t=0; t < phases.numSubsets(); ++t)
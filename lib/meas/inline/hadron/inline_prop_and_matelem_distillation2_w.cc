@@ -19,6 +19,7 @@
 #include "util/ferm/key_prop_colorvec.h"
 #include "util/ferm/key_prop_matelem.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/timeslice_io_cache.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -108,6 +109,14 @@ namespace Chroma
       read(inputtop, "mass_label", input.mass_label);
       read(inputtop, "num_tries", input.num_tries);
       read(inputtop, "src_spins", input.src_spins);
+
+      input.colorvec_cache_mb = 0;
+      if (inputtop.count("colorvec_cache_mb") == 1)
+	read(inputtop, "colorvec_cache_mb", input.colorvec_cache_mb);
+
+      input.colorvec_single_prec = false;
+      if (inputtop.count("colorvec_single_prec") == 1)
+	read(inputtop, "colorvec_single_prec", input.colorvec_single_prec);
     }
 
     //! Propagator output
@@ -122,6 +131,8 @@ namespace Chroma
       write(xml, "Nt_backward", input.Nt_backward);
       write(xml, "mass_label", input.mass_label);
       write(xml, "num_tries", input.num_tries);
+      write(xml, "colorvec_cache_mb", input.colorvec_cache_mb);
+      write(xml, "colorvec_single_prec", input.colorvec_single_prec);
 
       pop(xml);
     }
@@ -179,121 +190,9 @@ namespace Chroma
     // Convenience type
     typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MODS_t;
 
-    // Convenience type
-    typedef QDP::MapObjectMemory<KeyTimeSliceColorVec_t, SubLatticeColorVectorF> SUB_MOD_t;
-
     // Anonymous namespace
     namespace
     {
-      //----------------------------------------------------------------------------
-      //! Class to hold std::map of eigenvectors
-
-      class SubEigenMap
-      {
-      public:
-	struct Key_t {
-	  Key_t(int t_source, int colorvec_src): t_source(t_source), vec_num(colorvec_src) {}
-	  int t_source;
-	  int vec_num;
-	};
-
-	
-	//! Constructor
-	SubEigenMap(MODS_t& eigen_source_, int decay_dir) : eigen_source(eigen_source_), time_slice_set(decay_dir) {}
-
-	//! Getter
-	const SubLatticeColorVectorF& getVec(int t_source, int colorvec_src) const;
-	const SubLatticeColorVectorF& getVecConst(int t_source, int colorvec_src) const;
-	void cacheVec(int t_source, int colorvec_src) const;
-	
-	//! The set to be used in sumMulti
-	const Set& getSet() const {return time_slice_set.getSet();}
-
-      private:
-	//! Eigenvectors
-	MODS_t& eigen_source;
-
-	// The time-slice set
-	TimeSliceSet time_slice_set;
-
-      private:
-	//! Where we store the sublattice versions
-	//mutable SUB_MOD_t sub_eigen;
-	mutable std::map< Key_t , SubLatticeColorVectorF > sub_eigen;
-      };
-
-      bool operator<( const SubEigenMap::Key_t& l , const SubEigenMap::Key_t& r )
-      {
-	if ( l.vec_num < r.vec_num )
-	  return true;
-	if ( l.vec_num > r.vec_num )
-	  return false;
-	if ( l.t_source < r.t_source )
-	  return true;
-	return false;
-      }
-
-      
-      //----------------------------------------------------------------------------
-      //! Getter
-      const SubLatticeColorVectorF& SubEigenMap::getVec(int t_source, int colorvec_src) const
-      {
-	// The key
-	KeyTimeSliceColorVec_t src_key(t_source, colorvec_src);
-	Key_t map_key(t_source,colorvec_src);
-	
-	// If item does not exist, read from original std::map and put in memory std::map
-	if (sub_eigen.count( map_key ) == 0)
-	{
-	  QDPIO::cout << __func__ << ": on t_source= " << t_source << "  STL map colorvec_src= " << colorvec_src << std::endl;
-
-	  LatticeColorVectorF vec_srce = zero;
-
-	  TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source);
-	  eigen_source.get(src_key, time_slice_io);
-
-	  SubLatticeColorVectorF tmp(getSet()[t_source], vec_srce);
-
-	  //sub_eigen.insert(src_key, tmp);
-	  sub_eigen.insert( std::make_pair( map_key , tmp));
-	}
-	return sub_eigen[map_key];
-      }
-
-
-      const SubLatticeColorVectorF& SubEigenMap::getVecConst(int t_source, int colorvec_src) const
-      {
-	Key_t map_key(t_source,colorvec_src);
-	
-	return sub_eigen.at(map_key);
-      }
-
-      
-      void SubEigenMap::cacheVec(int t_source, int colorvec_src) const
-      {
-	// The key
-	KeyTimeSliceColorVec_t src_key(t_source, colorvec_src);
-	Key_t map_key(t_source,colorvec_src);
-	
-	// If item does not exist, read from original std::map and put in memory std::map
-	if (sub_eigen.count( map_key ) == 0)
-	{
-	  QDPIO::cout << __func__ << ": on t_source= " << t_source << "  STL map colorvec_src= " << colorvec_src << std::endl;
-
-	  LatticeColorVectorF vec_srce = zero;
-
-	  TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source);
-	  eigen_source.get(src_key, time_slice_io);
-
-	  SubLatticeColorVectorF tmp(getSet()[t_source], vec_srce);
-
-	  //sub_eigen.insert(src_key, tmp);
-	  sub_eigen.insert( std::make_pair( map_key , tmp));
-	}
-      }
-
-
-
       //----------------------------------------------------------------------------
       //! Get active time-slices
       std::vector<bool> getActiveTSlices(int t_source, int Nt_forward, int Nt_backward)
@@ -431,74 +330,6 @@ namespace Chroma
 
 
 
-    namespace local {
-
-      template<class T1,class C1,class T2,class C2>
-      typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Type_t
-      localInnerProduct(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
-      {
-	if (!l.getOwnsMemory())
-	  QDP_error_exit("localInnerProduct with subtype view called");
-
-	typename QDPSubTypeTrait< typename BinaryReturn<C1,C2,FnLocalInnerProduct>::Type_t >::Type_t ret;
-	ret.setSubset( l.subset() );
-
-	//QDP_info("localInnerProduct %d sites",l.subset().numSiteTable());
-
-	const int *tab = l.subset().siteTable().slice();
-	//#pragma omp parallel for
-	for(int j=0; j < l.subset().numSiteTable(); ++j)
-	  {
-	    int i = tab[j];
-	    FnLocalInnerProduct op;
-	    ret.getF()[j] = op( l.getF()[j] , r.elem(i) );
-	  }
-
-	return ret;
-      }
-
-      
-      template<class T1, class C1, class T2, class C2>
-      inline typename BinaryReturn<C1, C2, FnInnerProduct>::Type_t
-      innerProduct(const QDPSubType<T1,C1>& s1, const QDPType<T2,C2>& s2)
-      {
-	return sum(local::localInnerProduct(s1,s2));
-      }
-
-      
-      template<class T1,class C1,class T2,class C2>
-      typename UnaryReturn< OLattice< typename BinaryReturn<T1,T2,FnLocalInnerProduct>::Type_t >, FnSum>::Type_t
-      sumLocalInnerProduct(const QDPSubType<T1,C1> & l,const QDPType<T2,C2> & r)
-      {
-	if (!l.getOwnsMemory())
-	  QDP_error_exit("localInnerProduct with subtype view called");
-
-	typename UnaryReturn<OLattice< typename BinaryReturn<T1,T2,FnLocalInnerProduct>::Type_t >, FnSum>::Type_t ret;
-
-	zero_rep(ret.elem());
-
-	const int *tab = l.subset().siteTable().slice();
-
-	for(int j=0; j < l.subset().numSiteTable(); ++j)
-	  {
-	    int i = tab[j];
-	    FnLocalInnerProduct op;
-
-	    ret.elem() += op( l.getF()[j] , r.elem(i) );
-	  }
-
-
-	// The global sum is not thread-safe and we run this function in a parallel region
-	
-	//QDPInternal::globalSum(ret);
-
-	return ret;
-      }
-
-      
-    }
-
-
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
     // Function call
@@ -655,7 +486,9 @@ namespace Chroma
 
       // The sub-lattice eigenstd::vector std::map
       QDPIO::cout << "Initialize sub-lattice std::map" << std::endl;
-      SubEigenMap sub_eigen_map(eigen_source, decay_dir);
+      TimeSliceIOCache colorvec_cache(eigen_source, params.param.contract.num_vecs,
+				      size_t(params.param.contract.colorvec_cache_mb)*1024*1024,
+				      params.param.contract.colorvec_single_prec);
       QDPIO::cout << "Finished initializing sub-lattice std::map" << std::endl;
 
 
@@ -777,7 +610,7 @@ namespace Chroma
 
 	      // Get the source std::vector
 	      LatticeColorVector vec_srce = zero;
-	      vec_srce = sub_eigen_map.getVec(t_source, colorvec_src);
+	      colorvec_cache.getVec(vec_srce, t_source, colorvec_src);
 
 	      //
 	      // Loop over each spin source and invert. 
@@ -861,15 +694,13 @@ namespace Chroma
 		  tmp.mat.resize(num_vecs,num_vecs);
 		  tmp.mat = zero;
 
-		  // pre cache
-		  for(int colorvec_sink=0; colorvec_sink < num_vecs; ++colorvec_sink)
-		    sub_eigen_map.cacheVec(t_slice, colorvec_sink);
+		  // All the sink colorvecs of the time slice at once
+		  multi1d<ComplexD> prods;
+		  colorvec_cache.innerProducts(prods, t_slice, ferm_out(key->spin_snk));
 
-#pragma omp parallel for
 		  for(int colorvec_sink=0; colorvec_sink < num_vecs; ++colorvec_sink)
 		  {
-		    tmp.mat(colorvec_sink,colorvec_src) = local::sumLocalInnerProduct(sub_eigen_map.getVecConst(t_slice, colorvec_sink), 
-											       ferm_out(key->spin_snk));
+		    tmp.mat(colorvec_sink,colorvec_src) = prods[colorvec_sink];
 		  } // for colorvec_sink
 		  
 		  // write out
@@ -925,6 +756,8 @@ namespace Chroma
       write(xml_out, "ncg_had", ncg_had);
       pop(xml_out);
 
+      write(xml_out, "ColorVecCache", colorvec_cache);
+
       pop(xml_out);  // prop_dist
 
       snoop.stop();
@@ -45,6 +45,8 @@ namespace Chroma
 	  int           num_tries;      /*!< In case of bad things happening in the solution vectors, do retries */
 	  bool          zero_colorvecs;
 	  bool          fuse_timeloop;  
+	  int           colorvec_cache_mb;     /*!< Memory budget in MB for the cached colorvecs, 0 for no limit */
+	  bool          colorvec_single_prec;  /*!< Cache the colorvecs in single precision */
 	};
 
 	ChromaProp_t    prop;
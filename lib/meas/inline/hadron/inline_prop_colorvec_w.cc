@@ -60,6 +60,10 @@ namespace Chroma
       read(inputtop, "num_vecs", input.num_vecs);
       read(inputtop, "t_sources", input.t_sources);
       read(inputtop, "decay_dir", input.decay_dir);
+
+      input.batch_spins = false;
+      if (inputtop.count("batch_spins") == 1)
+	read(inputtop, "batch_spins", input.batch_spins);
     }
 
     //! Propagator output
@@ -70,6 +74,7 @@ namespace Chroma
       write(xml, "num_vecs", input.num_vecs);
       write(xml, "t_sources", input.t_sources);
       write(xml, "decay_dir", input.decay_dir);
+      write(xml, "batch_spins", input.batch_spins);
 
       pop(xml);
     }
@@ -444,28 +449,61 @@ namespace Chroma
 	    eigen_source.get(colorvec_source, tmpvec);
 	    vec_srce[phases.getSet()[t_source]] = tmpvec.eigenVector;
 	
-	    for(int spin_source=0; spin_source < Ns; ++spin_source)
+	    if (params.param.contract.batch_spins)
+	    {
+	      // All the spin sources in one call, so a block solver
+	      // can share its Krylov space between them
+	      multi1d<LatticeFermion> chi(Ns);
+	      multi1d<LatticeFermion> quark_soln(Ns);
+
+	      for(int spin_source=0; spin_source < Ns; ++spin_source)
+	      {
+		chi[spin_source] = zero;
+		CvToFerm(vec_srce, chi[spin_source], spin_source);
+
+		quark_soln[spin_source] = zero;
+	      }
+
+	      // Do the propagator inversions
+	      multi1d<SystemSolverResults_t> res = (*PP)(quark_soln, chi);
+
+	      for(int spin_source=0; spin_source < Ns; ++spin_source)
+	      {
+		ncg_had = res[spin_source].n_count;
+
+		KeyPropColorVec_t key;
+		key.t_source     = t_source;
+		key.colorvec_src = colorvec_source;
+		key.spin_src     = spin_source;
+
+		prop_obj.insert(key, quark_soln[spin_source]);
+	      }
+	    }
+	    else
 	    {
-	      QDPIO::cout << "spin_source = " << spin_source << std::endl; 
+	      for(int spin_source=0; spin_source < Ns; ++spin_source)
+	      {
+		QDPIO::cout << "spin_source = " << spin_source << std::endl; 
 
-	      // Insert a ColorVector into spin index spin_source
-	      // This only overwrites sections, so need to initialize first
-	      LatticeFermion chi = zero;
-	      CvToFerm(vec_srce, chi, spin_source);
+		// Insert a ColorVector into spin index spin_source
+		// This only overwrites sections, so need to initialize first
+		LatticeFermion chi = zero;
+		CvToFerm(vec_srce, chi, spin_source);
 
-	      LatticeFermion quark_soln = zero;
+		LatticeFermion quark_soln = zero;
 
-	      // Do the propagator inversion
-	      SystemSolverResults_t res = (*PP)(quark_soln, chi);
-	      ncg_had = res.n_count;
+		// Do the propagator inversion
+		SystemSolverResults_t res = (*PP)(quark_soln, chi);
+		ncg_had = res.n_count;
 
-	      KeyPropColorVec_t key;
-	      key.t_source     = t_source;
-	      key.colorvec_src = colorvec_source;
-	      key.spin_src     = spin_source;
+		KeyPropColorVec_t key;
+		key.t_source     = t_source;
+		key.colorvec_src = colorvec_source;
+		key.spin_src     = spin_source;
 		  
-	      prop_obj.insert(key, quark_soln);
-	    } // for spin_source
+		prop_obj.insert(key, quark_soln);
+	      } // for spin_source
+	    }
 	  } // for colorvec_source
 	} // for t_source
 
@@ -37,6 +37,7 @@ namespace Chroma
 	  int num_vecs;             /*!< Number of color vectors to use */
 	  int decay_dir;            /*!< Decay direction */
 	  multi1d<int> t_sources;   /*!< Array of time slice sources for props */
+	  bool batch_spins;         /*!< Hand the spin sources of a colorvec to the solver together */
 	};
 
 	ChromaProp_t    prop;
@@ -14,6 +14,7 @@
 #include "qdp_disk_map_slice.h"
 #include "util/ferm/key_prop_distillation.h"
 #include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ferm/timeslice_io_cache.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -65,6 +66,18 @@ namespace Chroma
       read(inputtop, "Nt_forward", input.Nt_forward);
       read(inputtop, "Nt_backward", input.Nt_backward);
       read(inputtop, "mass_label", input.mass_label);
+
+      input.colorvec_cache_mb = 0;
+      if (inputtop.count("colorvec_cache_mb") == 1)
+	read(inputtop, "colorvec_cache_mb", input.colorvec_cache_mb);
+
+      input.colorvec_single_prec = false;
+      if (inputtop.count("colorvec_single_prec") == 1)
+	read(inputtop, "colorvec_single_prec", input.colorvec_single_prec);
+
+      input.batch_spins = false;
+      if (inputtop.count("batch_spins") == 1)
+	read(inputtop, "batch_spins", input.batch_spins);
     }
 
     //! Propagator output
@@ -78,6 +91,9 @@ namespace Chroma
       write(xml, "Nt_forward", input.Nt_forward);
       write(xml, "Nt_backward", input.Nt_backward);
       write(xml, "mass_label", input.mass_label);
+      write(xml, "colorvec_cache_mb", input.colorvec_cache_mb);
+      write(xml, "colorvec_single_prec", input.colorvec_single_prec);
+      write(xml, "batch_spins", input.batch_spins);
 
       pop(xml);
     }
@@ -152,16 +168,13 @@ namespace Chroma
 	
       //----------------------------------------------------------------------------
       //! Read a source std::vector
-      LatticeColorVector getSrc(MODS_t& source_obj, int t_source, int colorvec_src)
+      LatticeColorVector getSrc(TimeSliceIOCache& colorvec_cache, int t_source, int colorvec_src)
       {
 	QDPIO::cout << __func__ << ": on t_source= " << t_source << "  colorvec_src= " << colorvec_src << std::endl;
 
 	// Get the source std::vector
-	KeyTimeSliceColorVec_t src_key = getSrcKey(t_source, colorvec_src);
-	LatticeColorVectorF vec_srce = zero;
-
-	TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source);
-	source_obj.get(src_key, time_slice_io);
+	LatticeColorVector vec_srce = zero;
+	colorvec_cache.getVec(vec_srce, t_source, colorvec_src);
 
 	return vec_srce;
       }
@@ -576,6 +589,10 @@ namespace Chroma
 
 	  QDPIO::cout << "Source successfully read and parsed" << std::endl;
 
+      // The sources, read a time slice at a time
+      TimeSliceIOCache colorvec_cache(source_obj, params.param.contract.num_vecs,
+				      size_t(params.param.contract.colorvec_cache_mb)*1024*1024,
+				      params.param.contract.colorvec_single_prec);
 
       //
       // Map-object-disk storage
@@ -686,7 +703,7 @@ namespace Chroma
 	    QDPIO::cout << "colorvec_src = " << colorvec_src << std::endl; 
 
 	    // Get the source std::vector
-	    LatticeColorVector vec_srce = getSrc(source_obj, t_source, colorvec_src);
+	    LatticeColorVector vec_srce = getSrc(colorvec_cache, t_source, colorvec_src);
 
 	    //
 	    // Loop over each spin source and invert. 
@@ -694,27 +711,59 @@ namespace Chroma
 	    //
 	    multi2d<LatticeColorVector> ferm_out(Ns,Ns);
 
-	    for(int spin_source=0; spin_source < Ns; ++spin_source)
+	    if (params.param.contract.batch_spins)
 	    {
-	      QDPIO::cout << "spin_source = " << spin_source << std::endl; 
+	      // All the spin sources in one call, so a block solver
+	      // can share its Krylov space between them
+	      multi1d<LatticeFermion> chi(Ns);
+	      multi1d<LatticeFermion> quark_soln(Ns);
 
-	      // Insert a ColorVector into spin index spin_source
-	      // This only overwrites sections, so need to initialize first
-	      LatticeFermion chi = zero;
-	      CvToFerm(vec_srce, chi, spin_source);
+	      for(int spin_source=0; spin_source < Ns; ++spin_source)
+	      {
+		chi[spin_source] = zero;
+		CvToFerm(vec_srce, chi[spin_source], spin_source);
 
-	      LatticeFermion quark_soln = zero;
+		quark_soln[spin_source] = zero;
+	      }
 
-	      // Do the propagator inversion
-	      SystemSolverResults_t res = (*PP)(quark_soln, chi);
-	      ncg_had = res.n_count;
+	      // Do the propagator inversions
+	      multi1d<SystemSolverResults_t> res = (*PP)(quark_soln, chi);
 
-	      // Extract into the temporary output array
-	      for(int spin_sink=0; spin_sink < Ns; ++spin_sink)
+	      for(int spin_source=0; spin_source < Ns; ++spin_source)
 	      {
-		ferm_out(spin_sink,spin_source) = peekSpin(quark_soln, spin_sink);
+		ncg_had = res[spin_source].n_count;
+
+		// Extract into the temporary output array
+		for(int spin_sink=0; spin_sink < Ns; ++spin_sink)
+		{
+		  ferm_out(spin_sink,spin_source) = peekSpin(quark_soln[spin_source], spin_sink);
+		}
 	      }
-	    } // for spin_source
+	    }
+	    else
+	    {
+	      for(int spin_source=0; spin_source < Ns; ++spin_source)
+	      {
+		QDPIO::cout << "spin_source = " << spin_source << std::endl; 
+
+		// Insert a ColorVector into spin index spin_source
+		// This only overwrites sections, so need to initialize first
+		LatticeFermion chi = zero;
+		CvToFerm(vec_srce, chi, spin_source);
+
+		LatticeFermion quark_soln = zero;
+
+		// Do the propagator inversion
+		SystemSolverResults_t res = (*PP)(quark_soln, chi);
+		ncg_had = res.n_count;
+
+		// Extract into the temporary output array
+		for(int spin_sink=0; spin_sink < Ns; ++spin_sink)
+		{
+		  ferm_out(spin_sink,spin_source) = peekSpin(quark_soln, spin_sink);
+		}
+	      } // for spin_source
+	    }
 
 
 #if 0
@@ -782,6 +831,8 @@ namespace Chroma
       write(xml_out, "ncg_had", ncg_had);
       pop(xml_out);
 
+      write(xml_out, "ColorVecCache", colorvec_cache);
+
       pop(xml_out);  // prop_dist
 
       snoop.stop();
@@ -39,6 +39,9 @@ namespace Chroma
 	  int           Nt_forward;     /*!< Time-slices in the forward direction */
 	  int           Nt_backward;    /*!< Time-slices in the backward direction */
 	  std::string   mass_label;     /*!< Some kind of mass label */
+	  int           colorvec_cache_mb;     /*!< Memory budget in MB for the cached colorvecs, 0 for no limit */
+	  bool          colorvec_single_prec;  /*!< Cache the colorvecs in single precision */
+	  bool          batch_spins;    /*!< Hand the spin sources of a colorvec to the solver together */
 	};
 
 	ChromaProp_t    prop;
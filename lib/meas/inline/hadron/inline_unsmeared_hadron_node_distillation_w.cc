@@ -19,8 +19,11 @@
 #include "meas/smear/link_smearing_aggregate.h"
 #include "meas/smear/link_smearing_factory.h"
 #include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ferm/timeslice_io_cache.h"
 #include "util/ferm/disp_soln_cache.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/async_db_writer.h"
+#include "util/ferm/elemental_gemm.h"
 #include "util/info/proginfo.h"
 #include "util/ft/sftmom.h"
 #include "util/ft/time_slice_set.h"
@@ -151,6 +154,18 @@ namespace Chroma
       read(inputtop, "displacement_length", input.displacement_length);
       read(inputtop, "mass_label", input.mass_label);
       read(inputtop, "num_tries", input.num_tries);
+
+      input.disp_cache_mb = 0;
+      if (inputtop.count("disp_cache_mb") == 1)
+	read(inputtop, "disp_cache_mb", input.disp_cache_mb);
+
+      input.colorvec_cache_mb = 0;
+      if (inputtop.count("colorvec_cache_mb") == 1)
+	read(inputtop, "colorvec_cache_mb", input.colorvec_cache_mb);
+
+      input.colorvec_single_prec = false;
+      if (inputtop.count("colorvec_single_prec") == 1)
+	read(inputtop, "colorvec_single_prec", input.colorvec_single_prec);
     }
 
     //! Propagator output
@@ -163,6 +178,9 @@ namespace Chroma
       write(xml, "displacement_length", input.displacement_length);
       write(xml, "mass_label", input.mass_label);
       write(xml, "num_tries", input.num_tries);
+      write(xml, "disp_cache_mb", input.disp_cache_mb);
+      write(xml, "colorvec_cache_mb", input.colorvec_cache_mb);
+      write(xml, "colorvec_single_prec", input.colorvec_single_prec);
 
       pop(xml);
     }
@@ -465,6 +483,18 @@ namespace Chroma
       write(bin, param.op);
     }
 
+    //! UnsmearedMesonElementalOperator DB bytes, straight from the storage of op
+    void writeDBBytes(std::string& output, const ValUnsmearedMesonElementalOperator_t& param)
+    {
+      Chroma::writeDBBytes(output, param.op);
+    }
+
+    //! UnsmearedMesonElementalOperator DB bytes, straight into the storage of op
+    void readDBBytes(const std::string& input, ValUnsmearedMesonElementalOperator_t& param)
+    {
+      Chroma::readDBBytes(input, param.op);
+    }
+
  
     //----------------------------------------------------------------------------------
     //----------------------------------------------------------------------------
@@ -593,7 +623,7 @@ namespace Chroma
     {
     public:
       SourcePropCache(const multi1d<LatticeColorMatrix>& u,
-		      const ChromaProp_t& prop, MODS_t& eigs, int num_tries);
+		      const ChromaProp_t& prop, TimeSliceIOCache& eigs, int num_tries);
 
       //! New t-slice
       void newTimeSource(const Params::Param_t::KeySolnProp_t& key_);
@@ -601,12 +631,15 @@ namespace Chroma
       //! The solution
       const LatticeColorVectorSpinMatrix& getSoln(int t_source, int colorvec_src);
 
+      //! Read the source vectors of t_source ahead, if any of its solutions are still to come. Collective
+      void prefetch(int t_source);
+
       //! Getters
       int getNumVecs(int t_source);
 
     private:
       //! Eigenvectors
-      MODS_t& eigen_source;
+      TimeSliceIOCache& eigen_source;
 
       //! Put it here
       int num_tries;
@@ -624,7 +657,7 @@ namespace Chroma
 
     //-------------------------------------------------------------------------------
     SourcePropCache::SourcePropCache(const multi1d<LatticeColorMatrix>& u,
-				     const ChromaProp_t& prop, MODS_t& eigs_, int num_tries_) : eigen_source(eigs_), num_tries(num_tries_)
+				     const ChromaProp_t& prop, TimeSliceIOCache& eigs_, int num_tries_) : eigen_source(eigs_), num_tries(num_tries_)
     {
       StopWatch swatch;
       swatch.reset();
@@ -679,6 +712,23 @@ namespace Chroma
     }
 
 
+    //-------------------------------------------------------------------------------
+    //! Read ahead
+    void SourcePropCache::prefetch(int t_slice)
+    {
+      std::map<int, Params::Param_t::KeySolnProp_t>::const_iterator k = keys.find(t_slice);
+      if (k == keys.end())
+	return;
+
+      // Every vector already solved - nothing more to read
+      if (int(cache[k->second].size()) >= k->second.num_vecs)
+	return;
+
+      if (! eigen_source.prefetch(t_slice))
+	QDPIO::cout << __func__ << ": colorvec cache budget too small to read t_slice= " << t_slice << " ahead" << std::endl;
+    }
+
+
     //-------------------------------------------------------------------------------
     //! New t-slice
     const LatticeColorVectorSpinMatrix& SourcePropCache::getSoln(int t_slice, int colorvec_ind)
@@ -706,9 +756,7 @@ namespace Chroma
       swatch.start();
 
       LatticeColorVectorF vec_srce = zero;
-      KeyTimeSliceColorVec_t src_key(t_slice, colorvec_ind);
-      TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_slice);
-      eigen_source.get(src_key, time_slice_io);
+      eigen_source.getVec(vec_srce, t_slice, colorvec_ind);
 
       // Loop over each spin source
       for(int spin_ind=0; spin_ind < Ns; ++spin_ind)
@@ -787,6 +835,63 @@ namespace Chroma
     } // void normDisp
 
 
+    //-------------------------------------------------------------------------------
+    //! The elementals on their way to the db
+    typedef AsyncDBWriter< SerialDBKey<KeyUnsmearedMesonElementalOperator_t>, SerialDBData<ValUnsmearedMesonElementalOperator_t> >  ElementalWriter_t;
+
+#ifndef QDP_IS_QDPJIT
+    //-------------------------------------------------------------------------------
+    //! Stream the sink vectors past the queued insertions
+    /*!
+     * All the insertions queued in ins_panel are contracted with the sink vectors
+     * in one GEMM per time slice. The elementals of the active time slices are moved
+     * into batch, and the queue is emptied.
+     */
+    void contractInsertions(ElementalWriter_t::Batch_t& batch,
+			    std::vector< multi1d<KeyValUnsmearedMesonElementalOperator_t> >& ins_bufs,
+			    const ElementalGEMM& contractor,
+			    const ElementalGEMM::Panel& snk_panel,
+			    ElementalGEMM::Panel& ins_panel)
+    {
+      const int g5 = Ns*Ns-1;
+      const int sink_num_vecs = snk_panel.numCols() / Ns;
+
+      ElementalGEMM::Result res;
+      contractor.contract(res, snk_panel, ins_panel, ElementalGEMM::CONJ_LEFT);
+
+      for(int b=0; b < ins_bufs.size(); ++b)
+      {
+	multi1d<KeyValUnsmearedMesonElementalOperator_t>& buf = ins_bufs[b];
+
+	for(int t=0; t < contractor.numSubsets(); ++t)
+	{
+	  if (! contractor.isActive(t)) {continue;}
+
+	  for(int colorvec_snk=0; colorvec_snk < sink_num_vecs; ++colorvec_snk)
+	  {
+	    SpinMatrixD fred = zero;
+	    for (int spin_snk = 0; spin_snk < Ns; ++spin_snk)
+	      for (int spin_src = 0; spin_src < Ns; ++spin_src)
+		pokeSpin(fred, res.elem(t, Ns*colorvec_snk + spin_snk, Ns*b + spin_src), spin_snk, spin_src);
+
+	    // Complete the gamma_5 hermitian adj on the sink by tacking on the gamma_5
+	    SpinMatrixD gred = Gamma(g5) * fred;
+
+	    for (int spin_snk = 0; spin_snk < Ns; ++spin_snk)
+	      for (int spin_src = 0; spin_src < Ns; ++spin_src)
+		buf[t].val.data().op(colorvec_snk,spin_snk,spin_src) = peekSpin(gred, spin_snk, spin_src);
+	  }
+
+	  batch.push_back(std::make_pair(buf[t].key, buf[t].val));
+	}
+      }
+
+      ins_bufs.clear();
+      ins_panel.clear();
+    }
+#endif
+
+
 
     //-------------------------------------------------------------------------------
     // Function call
@@ -1094,8 +1199,32 @@ namespace Chroma
 	qdp_db.open(params.named_obj.dist_op_file, O_RDWR, 0664);
       }
 
+      // Hand the file over to a writer thread, so the inserts overlap the contractions
+      qdp_db.close();
+
+      ElementalWriter_t db_writer;
+      db_writer.open(params.named_obj.dist_op_file);
+
       QDPIO::cout << "Finished opening distillation file" << std::endl;
 
+      // Per stage timings
+      double fetch_secs    = 0;
+      double contract_secs = 0;
+
+      // Displacement cache counters
+      unsigned long disp_hits      = 0;
+      unsigned long disp_misses    = 0;
+      unsigned long disp_evictions = 0;
+      size_t        disp_peak_bytes = 0;
+
+      // The source colorvecs, read a time slice at a time
+      int colorvec_num_vecs = 0;
+      for(auto key = params.param.prop_sources.begin(); key != params.param.prop_sources.end(); ++key)
+	colorvec_num_vecs = std::max(colorvec_num_vecs, key->num_vecs);
+
+      TimeSliceIOCache colorvec_cache(eigen_source, colorvec_num_vecs,
+				      size_t(params.param.contract.colorvec_cache_mb)*1024*1024,
+				      params.param.contract.colorvec_single_prec);
 
       //
       // Try the factories
@@ -1107,7 +1236,7 @@ namespace Chroma
 
 	// Cache manager
 	QDPIO::cout << name << ": initialize the prop cache" << std::endl;
-	SourcePropCache prop_cache(u, params.param.prop, eigen_source, params.param.contract.num_tries);
+	SourcePropCache prop_cache(u, params.param.prop, colorvec_cache, params.param.contract.num_tries);
 
 	// All the desired solutions
 	QDPIO::cout << name << ": initialize the time sources" << std::endl;
@@ -1123,6 +1252,9 @@ namespace Chroma
 	//
 	const int g5 = Ns*Ns-1;
 
+	// Elementals on their way to the db
+	ElementalWriter_t::Batch_t db_batch;
+
 	for(auto sink_source = params.param.sink_source_pairs.begin(); sink_source != params.param.sink_source_pairs.end(); ++sink_source)
 	{
 	  int t_sink         = sink_source->t_sink;
@@ -1130,6 +1262,8 @@ namespace Chroma
 	  int sink_num_vecs  = prop_cache.getNumVecs(t_sink);
 	  int srce_num_vecs  = prop_cache.getNumVecs(t_source);
 
+	  std::vector<Params::Param_t::SinkSource_t>::const_iterator next_pair = sink_source + 1;
+
 	  QDPIO::cout << "\n\n--------------------------\nSink-Source pair: t_sink = " << t_sink << " t_source = " << t_source << std::endl; 
 	  swatch.reset();
 	  swatch.start();
@@ -1163,13 +1297,49 @@ namespace Chroma
 	  }
 
 
+	  //
+	  // Fetch all the sink solutions up front. The reads and any inversions are
+	  // collective, so they cannot be threaded, but this takes them out of the
+	  // contraction loop. The references are stable within the prop cache.
+	  //
+	  StopWatch fetch_swatch;
+	  fetch_swatch.reset();
+	  fetch_swatch.start();
+
+	  std::vector<const LatticeColorVectorSpinMatrix*> soln_snks(sink_num_vecs);
+	  for(int colorvec_snk=0; colorvec_snk < sink_num_vecs; ++colorvec_snk)
+	  {
+	    soln_snks[colorvec_snk] = &(prop_cache.getSoln(t_sink, colorvec_snk));
+	  }
+
+	  fetch_swatch.stop();
+	  double pair_fetch_secs    = fetch_swatch.getTimeInSeconds();
+	  double pair_contract_secs = 0;
+
+#ifndef QDP_IS_QDPJIT
+	  //
+	  // Gather the sink vectors on the active time slices once. Insertions are queued
+	  // in a second panel, and contracted against them whenever there are as many
+	  // insertion columns as sink columns, which bounds the extra memory.
+	  //
+	  ElementalGEMM contractor(phases.getSet(), active_t_slices);
+	  ElementalGEMM::Panel snk_panel(contractor, ElementalGEMM::Panel::COLOR_VECTOR_SPIN_MATRIX);
+	  ElementalGEMM::Panel ins_panel(contractor, ElementalGEMM::Panel::COLOR_VECTOR_SPIN_MATRIX);
+	  std::vector< multi1d<KeyValUnsmearedMesonElementalOperator_t> > ins_bufs;
+
+	  for(int colorvec_snk=0; colorvec_snk < sink_num_vecs; ++colorvec_snk)
+	  {
+	    snk_panel.add(*soln_snks[colorvec_snk]);
+	  }
+#endif
+
 	  //
 	  // Look through sources, do the funny stuff through each soln, and stream the sink vectors past them
 	  //
 	  for(int colorvec_src=0; colorvec_src < srce_num_vecs; ++colorvec_src)
 	  {
 	    QDPIO::cout << "SOURCE: colorvec_src = " << colorvec_src << std::endl;
-	    
+
 	    StopWatch snarss1;
 	    snarss1.reset();
 	    snarss1.start();
@@ -1178,12 +1348,26 @@ namespace Chroma
 	    // Loop over each spin source and invert. 
 	    // Use the same color vector source. No spin dilution will be used.
 	    //
+	    fetch_swatch.reset();
+	    fetch_swatch.start();
+
 	    const LatticeColorVectorSpinMatrix& soln_srce = prop_cache.getSoln(t_source, colorvec_src);
 
+	    fetch_swatch.stop();
+	    pair_fetch_secs += fetch_swatch.getTimeInSeconds();
+
 	    //
 	    // Cache holding original solution vectors including displacements/derivatives
 	    //
-	    DispSolnCache disp_soln_cache(u_smr, soln_srce);
+	    DispSolnCache disp_soln_cache(u_smr, soln_srce, size_t(params.param.contract.disp_cache_mb)*1024*1024);
+
+	    // Tell the cache what is coming, so it keeps what will be reused
+	    for(auto dd = disp_gamma_moms.begin(); dd != disp_gamma_moms.end(); ++dd)
+	      for(auto gg = dd->second.begin(); gg != dd->second.end(); ++gg)
+		for(auto mm = gg->second.begin(); mm != gg->second.end(); ++mm)
+		  disp_soln_cache.schedule(params.param.contract.use_derivP, mm->first, dd->first.deriv);
+
+	    disp_soln_cache.prefetch();
 	    
 	    //
 	    // Loop over insertions for this source solutiuon vector
@@ -1227,10 +1411,18 @@ namespace Chroma
 		  // is a part of the sink solution vector, we will multiply here.
 		  //
 		  // NOTE: with suitable signs, the gamma_5 could be merged with the gamma
+#ifndef QDP_IS_QDPJIT
+		  // The phase is folded in when the insertion is packed
+		  LatticeColorVectorSpinMatrix tmp = 
+		    Gamma(g5) * (Gamma(gamma) * disp_soln_cache.getDispVector(params.param.contract.use_derivP,
+									      mom,
+									      disp));
+#else
 		  LatticeColorVectorSpinMatrix tmp = phases[mom_num] *
 		    (Gamma(g5) * (Gamma(gamma) * disp_soln_cache.getDispVector(params.param.contract.use_derivP,
 									       mom,
 									       disp)));
+#endif
 	      
 		  // Keys and stuff
 		  SerialDBKey<KeyUnsmearedMesonElementalOperator_t>  key;
@@ -1256,6 +1448,20 @@ namespace Chroma
 		    buf[t].val.data().op.resize(sink_num_vecs,Ns,Ns);
 		  }
 
+#ifndef QDP_IS_QDPJIT
+		  // Queue the insertion
+		  ins_panel.add(tmp, phases[mom_num]);
+		  ins_bufs.push_back(buf);
+
+		  if (ins_panel.numCols() >= snk_panel.numCols())
+		  {
+		    contractInsertions(db_batch, ins_bufs, contractor, snk_panel, ins_panel);
+		    db_writer.submit(db_batch);
+		  }
+
+		  snarss2.stop(); 
+		  pair_contract_secs += snarss2.getTimeInSeconds();
+#else
 		  // Stream the sink vectors past the insertion
 		  // Will save a column of the genprop - corresponding to the current colorvec_src
 		  for(int colorvec_snk=0; colorvec_snk < sink_num_vecs; ++colorvec_snk)
@@ -1263,7 +1469,7 @@ namespace Chroma
 		    //QDPIO::cout << "stream: colorvec_snk = " << colorvec_snk << std::endl;
 		    
 		    // Slow fourier-transform
-		    multi1d<SpinMatrixD> fred = sumMulti(localColorInnerProduct(prop_cache.getSoln(t_sink, colorvec_snk), tmp), phases.getSet());
+		    multi1d<SpinMatrixD> fred = sumMulti(localColorInnerProduct(*soln_snks[colorvec_snk], tmp), phases.getSet());
 
 		    for(int t=0; t < phases.numSubsets(); ++t)
 		    {
@@ -1278,7 +1484,11 @@ namespace Chroma
 		    }
 		  }
 
-		  // Insert these elementals into the db
+		  // Hand these elementals to the db writer
+		  snarss2.stop(); 
+		  pair_contract_secs += snarss2.getTimeInSeconds();
+
+		  db_batch.reserve(phases.numSubsets());
 		  for(int t=0; t < phases.numSubsets(); ++t)
 		  {
 		    if (! active_t_slices[t]) {continue;}
@@ -1286,10 +1496,11 @@ namespace Chroma
 		    //QDPIO::cout << "insert key= " << buf[t].key.key() << std::endl;
 		    //write(xml_out, "Insertion", buf[t].key.key());
 
-		    qdp_db.insert(buf[t].key, buf[t].val);
+		    db_batch.push_back(std::make_pair(buf[t].key, buf[t].val));
 		  }
+		  db_writer.submit(db_batch);
+#endif
 
-		  snarss2.stop(); 
 		  QDPIO::cout << " Time to build elemental: colorvec_src= " << colorvec_src
 			      << "  gamma= " << gamma
 			      << "  disp= " << disp
@@ -1299,12 +1510,60 @@ namespace Chroma
 	      } // gg
 	    } // dd
 
+#ifndef QDP_IS_QDPJIT
+	    // Whatever is left over
+	    if (ins_panel.numCols() > 0)
+	    {
+	      StopWatch snarss2;
+	      snarss2.reset();
+	      snarss2.start();
+
+	      contractInsertions(db_batch, ins_bufs, contractor, snk_panel, ins_panel);
+
+	      snarss2.stop();
+	      pair_contract_secs += snarss2.getTimeInSeconds();
+
+	      db_writer.submit(db_batch);
+	    }
+#endif
+
 	    snarss1.stop(); 
 	    QDPIO::cout << "Time to do all insertions for colorvec_src= " << colorvec_src << "  time = " << snarss1.getTimeInSeconds() << " secs " <<std::endl;
+	    QDPIO::cout << "Displacement cache: hits= " << disp_soln_cache.numHits()
+			<< "  misses= " << disp_soln_cache.numMisses()
+			<< "  evictions= " << disp_soln_cache.numEvictions()
+			<< "  peak MB= " << disp_soln_cache.peakBytes()/(1024.0*1024.0) << std::endl;
+
+	    disp_hits      += disp_soln_cache.numHits();
+	    disp_misses    += disp_soln_cache.numMisses();
+	    disp_evictions += disp_soln_cache.numEvictions();
+	    disp_peak_bytes = std::max(disp_peak_bytes, disp_soln_cache.peakBytes());
+
+	    //
+	    // Double buffering: the first elementals of this pair are now with the writer,
+	    // so read the source vectors of the next pair while they are inserted. The
+	    // read is collective, so it is issued here on every node rather than threaded.
+	    //
+	    if (colorvec_src == 0 && next_pair != params.param.sink_source_pairs.end())
+	    {
+	      fetch_swatch.reset();
+	      fetch_swatch.start();
+
+	      prop_cache.prefetch(next_pair->t_sink);
+	      prop_cache.prefetch(next_pair->t_source);
+
+	      fetch_swatch.stop();
+	      pair_fetch_secs += fetch_swatch.getTimeInSeconds();
+	    }
 	  } // for colorvec_src
 
 	  swatch.stop(); 
 	  QDPIO::cout << "SINK-SOURCE: time to compute all source solution vectors and insertions for t_sink= " << t_sink << "  t_source= " << t_source << "  time= " << swatch.getTimeInSeconds() << " secs" <<std::endl;
+	  QDPIO::cout << "SINK-SOURCE: fetch= " << pair_fetch_secs << " secs  contract= " << pair_contract_secs
+		      << " secs  write wait (so far)= " << db_writer.waitTime() << " secs" << std::endl;
+
+	  fetch_secs    += pair_fetch_secs;
+	  contract_secs += pair_contract_secs;
 	} // for sink_source
       }
       catch (const std::string& e) 
@@ -1313,8 +1572,29 @@ namespace Chroma
 	QDP_abort(1);
       }
 
-      // Close db
-      qdp_db.close();
+      // Drain the writer and close db
+      db_writer.close();
+
+      push(xml_out, "PipelineTiming");
+      write(xml_out, "fetch_secs", fetch_secs);
+      write(xml_out, "contract_secs", contract_secs);
+      write(xml_out, "write_wait_secs", db_writer.waitTime());
+      write(xml_out, "write_secs", db_writer.writeTime());
+      write(xml_out, "num_written", int(db_writer.numWritten()));
+      pop(xml_out);
+
+      write(xml_out, "ColorVecCache", colorvec_cache);
+
+      push(xml_out, "DispSolnCache");
+      write(xml_out, "budget_mb", params.param.contract.disp_cache_mb);
+      write(xml_out, "hits", int(disp_hits));
+      write(xml_out, "misses", int(disp_misses));
+      write(xml_out, "evictions", int(disp_evictions));
+      write(xml_out, "peak_mb", disp_peak_bytes/(1024.0*1024.0));
+      pop(xml_out);
+
+      QDPIO::cout << name << ": fetch = " << fetch_secs << " secs  contract = " << contract_secs
+		  << " secs  blocked on writes = " << db_writer.waitTime() << " secs  writes = " << db_writer.writeTime() << " secs" << std::endl;
 
       // Close the xml output file
       pop(xml_out);     // UnsmearedHadronNode
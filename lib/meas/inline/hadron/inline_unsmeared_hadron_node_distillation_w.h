@@ -66,6 +66,9 @@ namespace Chroma
 	  int                       displacement_length;    /*!< Displacement length for insertions */
 	  std::string               mass_label;             /*!< Some kind of mass label */
 	  int                       num_tries;              /*!< In case of bad things happening in the solution vectors, do retries */
+	  int                       disp_cache_mb;          /*!< Memory budget in MB for the displaced solutions, 0 for no limit */
+	  int                       colorvec_cache_mb;      /*!< Memory budget in MB for the cached colorvecs, 0 for no limit. Reading the next pair ahead needs room for three time slices */
+	  bool                      colorvec_single_prec;   /*!< Cache the colorvecs in single precision */
 	};
 
 	std::vector<KeySolnProp_t>  prop_sources;           /*!< Sources */
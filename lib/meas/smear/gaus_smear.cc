@@ -127,5 +127,35 @@ namespace Chroma
     gausSmear<LatticePropagator>(u, chi, width, ItrGaus, j_decay);
   }
 
+  //! Do a covariant Gaussian smearing of a block of lattice color vector fields
+  /*!
+   * \ingroup smear
+   *
+   * Arguments:
+   *
+   *  \param u        gauge field ( Read )
+   *  \param chi      color vector fields ( Modify )
+   *  \param width    width of "shell" wave function ( Read )
+   *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
+   *  \param j_decay  direction of decay ( Read )
+   */
+
+  void gausSmear(const multi1d<LatticeColorMatrix>& u, 
+		 multi1d<LatticeColorVector>& chi, 
+		 const Real& width, int ItrGaus, int j_decay)
+  {
+    multi1d<LatticeColorVector> psi(chi.size());
+
+    Real ftmp = - (width*width) / Real(4*ItrGaus);
+    Real ftmpi = Real(1) / ftmp;
+
+    for(int n = 0; n < ItrGaus; ++n)
+    {
+      for(int k = 0; k < chi.size(); ++k)
+	psi[k] = chi[k] * ftmp;
+
+      klein_gord(u, psi, chi, ftmpi, j_decay);
+    }
+  }
 
 }  // end namespace Chroma
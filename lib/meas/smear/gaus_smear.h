@@ -80,6 +80,25 @@ namespace Chroma
 		 LatticePropagator& chi, 
 		 const Real& width, int ItrGaus, int j_decay);
 
+
+  //! Do a covariant Gaussian smearing of a block of lattice color vector fields
+  /*!
+   * \ingroup smear
+   *
+   * The links are loaded once for the whole block.
+   *
+   * Arguments:
+   *
+   *  \param u        gauge field ( Read )
+   *  \param chi      color vector fields ( Modify )
+   *  \param width    width of "shell" wave function ( Read )
+   *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
+   *  \param j_decay  direction of decay ( Read )
+   */
+  void gausSmear(const multi1d<LatticeColorMatrix>& u, 
+		 multi1d<LatticeColorVector>& chi, 
+		 const Real& width, int ItrGaus, int j_decay);
+
 }  // end namespace Chroma
 
 #endif
@@ -4,10 +4,22 @@
 
 #include "chromabase.h"
 #include "meas/smear/jacobi_smear.h"
+#include "actions/boson/operator/klein_gord.h"
 
 namespace Chroma 
 {
 
+    // Utility functions
+    namespace
+    {
+	//! The diagonal term of the Klein-Gordon operator at zero mass
+	Real hoppingDiag(int no_smear_dir)
+	{
+	    return (no_smear_dir < Nd) ? Real(2*Nd-2) : Real(2*Nd);
+	}
+    }
+
+
     //! Do a covariant Jacobi smearing of a lattice field
     /*!
      * Arguments:
@@ -25,26 +37,18 @@ namespace Chroma
 		     const Real& kappa, int iter, int no_smear_dir)
     {
 	T psi;
-	Real norm;
 
 	T s_0,h_smear;
 	s_0 = chi;
 
+	// The Klein-Gordon operator with this mass is minus the hopping term
+	Real mass_sq = -hoppingDiag(no_smear_dir);
+
 	for(int n = 0; n < iter; ++n)
 	    {
 		psi = chi;
-		bool first = true;
-
-		for(int mu = 0; mu < Nd; ++mu )
-		    if( mu != no_smear_dir )
-			{
-			    if (first)
-				h_smear =  u[mu]*shift(psi, FORWARD, mu) + shift(adj(u[mu])*psi, BACKWARD, mu);
-			    else
-				h_smear += u[mu]*shift(psi, FORWARD, mu) + shift(adj(u[mu])*psi, BACKWARD, mu);
-			    first = false;
-			}
-		chi = s_0 + kappa * h_smear;
+		klein_gord(u, psi, h_smear, mass_sq, no_smear_dir);
+		chi = s_0 - kappa * h_smear;
 	    }
     }
 
@@ -137,4 +141,36 @@ namespace Chroma
     }
 
 
+    //! Do a covariant Jacobi smearing of a block of lattice color vector fields
+    /*!
+     * \ingroup smear
+     *
+     * Arguments:
+     *
+     *  \param u             gauge field ( Read )
+     *  \param chi           color vector fields ( Modify )
+     *  \param kappa         hopping parameter ( Read )
+     *  \param iter          number of iterations ( Read )
+     *  \param no_smear_dir  no smearing in this direction ( Read )
+     */
+
+    void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
+		     multi1d<LatticeColorVector>& chi, 
+		     const Real& kappa, int iter, int no_smear_dir)
+    {
+	multi1d<LatticeColorVector> s_0(chi), psi(chi.size()), h_smear(chi.size());
+
+	Real mass_sq = -hoppingDiag(no_smear_dir);
+
+	for(int n = 0; n < iter; ++n)
+	    {
+		psi = chi;
+		klein_gord(u, psi, h_smear, mass_sq, no_smear_dir);
+
+		for(int k = 0; k < chi.size(); ++k)
+		    chi[k] = s_0[k] - kappa * h_smear[k];
+	    }
+    }
+
+
 }  // end namespace Chroma
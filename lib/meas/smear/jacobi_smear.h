@@ -80,6 +80,25 @@ namespace Chroma
 		 LatticePropagator& chi, 
 		 const Real& kappa, int iter, int no_smear_dir);
 
+
+  //! Do a covariant Jacobi smearing of a block of lattice color vector fields
+  /*!
+   * \ingroup smear
+   *
+   * The links are loaded once for the whole block.
+   *
+   * Arguments:
+   *
+   *  \param u             gauge field ( Read )
+   *  \param chi           color vector fields ( Modify )
+   *  \param kappa         hopping parameter ( Read )
+   *  \param iter          number of iterations ( Read )
+   *  \param no_smear_dir  no smearing in this direction ( Read )
+   */
+  void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
+		   multi1d<LatticeColorVector>& chi, 
+		   const Real& kappa, int iter, int no_smear_dir);
+
 }  // end namespace Chroma
 
 #endif
@@ -53,5 +53,21 @@ namespace Chroma
     laplacian<LatticePropagator>(u, chi, j_decay, power);
   }
 
+  void laplacian(const multi1d<LatticeColorMatrix>& u, 
+		 multi1d<LatticeColorVector>& chi, 
+		 int j_decay,
+		 int power)
+  {
+    multi1d<LatticeColorVector> psi(chi.size());
+
+    for (int p=0; p<power; p++) {
+      for (int n=0; n<chi.size(); n++)
+	psi[n] = -1 * chi[n];
+
+      /* hit with laplacian (Klein-Gordon with m=0) */
+      klein_gord(u, psi, chi, 0, j_decay);
+    }
+  }
+
 }  // end namespace Chroma
 
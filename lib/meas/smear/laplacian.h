@@ -42,6 +42,25 @@ namespace Chroma
 		 int j_decay,
 		 int power);
 
+
+  //! Apply the laplacian to a block of color vectors
+  /*!
+   * \ingroup smear
+   *
+   * The links are loaded once for the whole block.
+   *
+   * Arguments:
+   *
+   *  \param u        gauge field ( Read )
+   *  \param chi      lattice color vector fields ( Modify )
+   *  \param j_decay  direction of decay ( Read )
+   *  \param power    number of times to apply laplacian ( Read )
+   */
+  void laplacian(const multi1d<LatticeColorMatrix>& u, 
+		 multi1d<LatticeColorVector>& chi, 
+		 int j_decay,
+		 int power);
+
 }  // end namespace Chroma
 
 #endif
@@ -17,6 +17,7 @@
 #include "handle.h"
 #include <map>
 #include <string>
+#include <vector>
 
 namespace Chroma
 {
@@ -270,7 +271,17 @@ namespace Chroma
       for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++) 
 	QDPIO::cout << j->first << std::endl;
     }
-  
+
+    //! Return the ids of all objects currently held
+    std::vector<std::string> keys() const
+    {
+      std::vector<std::string> ids;
+      for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++)
+	ids.push_back(j->first);
+
+      return ids;
+    }
+
   
     //! Look something up and return a NamedObjectBase reference
     NamedObjectBase& get(const std::string& id) const
@@ -15,6 +15,9 @@
 #include "fermbc.h"
 #include "handle.h"
 
+#include <map>
+#include <string>
+
 namespace Chroma
 {
   //! Support class for fermion actions and linear operators
@@ -83,6 +86,20 @@ namespace Chroma
 
 
 
+  //! Data derived from a fermion state and kept with it
+  /*! @ingroup state
+   *
+   * Linear operators attach what they build from the links, e.g. clover
+   * terms, so other operators made on the same state can reuse it.
+   */
+  class FermStateAttachment
+  {
+  public:
+    //! Virtual destructor to help with cleanup;
+    virtual ~FermStateAttachment() {}
+  };
+
+
   //! Support class for fermion actions and linear operators
   /*! @ingroup state
    *
@@ -103,7 +120,28 @@ namespace Chroma
     //! Return the ferm BC object for this state
     /*! This is to help the optimized linops */
     virtual Handle< FermBC<T,P,Q> > getFermBC() const = 0;
-   
+
+    //! Find the data attached under key
+    /*! Returns false if there is none */
+    bool findAttachment(const std::string& key, Handle<FermStateAttachment>& a) const
+    {
+      typename std::map< std::string, Handle<FermStateAttachment> >::const_iterator it = attachments.find(key);
+      if (it == attachments.end())
+	return false;
+
+      a = it->second;
+      return true;
+    }
+
+    //! Attach data under key
+    /*! The state is logically unchanged, so this is allowed on a const state */
+    void setAttachment(const std::string& key, Handle<FermStateAttachment> a) const
+    {
+      attachments[key] = a;
+    }
+
+  private:
+    mutable std::map< std::string, Handle<FermStateAttachment> > attachments;
   };
 
 }
@@ -45,6 +45,28 @@ namespace Chroma
      */
     virtual SystemSolverResults_t operator() (T& psi, const T& chi) const = 0;
 
+    //! Apply the operator onto several source vectors
+    /*!
+     * Solves   A*psi[n] = chi[n]  for every n. By default this is one solve
+     * per source. Block solvers override it to share a Krylov space across
+     * the sources.
+     *
+     * psi must have as many elements as chi.
+     */
+    virtual multi1d<SystemSolverResults_t> operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+    {
+      multi1d<SystemSolverResults_t> res(chi.size());
+
+      for(int n=0; n < chi.size(); ++n)
+	res[n] = (*this)(psi[n], chi[n]);
+
+      return res;
+    }
+
+    //! Does solving several sources at once share work between them?
+    /*! True for block solvers. Callers may then batch their sources. */
+    virtual bool blockP() const {return false;}
+
     //! Return the subset on which the operator acts
     virtual const Subset& subset() const = 0;
   };
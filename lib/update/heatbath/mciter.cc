@@ -7,6 +7,7 @@
 #include "update/heatbath/mciter.h"
 #include "update/heatbath/su3over.h"
 #include "update/heatbath/su2_hb_update.h"
+#include "update/heatbath/su3_site_hb.h"
 
 namespace Chroma 
 {
@@ -40,6 +41,9 @@ namespace Chroma
     const Set& gauge_set = S_g.getSet();
     const int num_subsets = gauge_set.numSubsets();
 
+    // One key per sweep. The site updates draw from it with the direction as stream
+    const SiteHeatbath::Key key = SiteHeatbath::newKey();
+
     for(int iter = 0; iter <= hbp.nOver; ++iter)
     {
       for(int cb = 0; cb < num_subsets; ++cb)
@@ -60,13 +64,30 @@ namespace Chroma
 	  if ( iter < hbp.nOver )
 	  {
 	    /* Do an overrelaxation step */
+#ifndef QDP_IS_QDPJIT
+	    SiteHeatbath::overrelax(u[mu], u_mu_staple, gauge_set[cb]);
+#else
 	    /*# Loop over SU(2) subgroup index */
 	    for(int su2_index = 0; su2_index < Nc*(Nc-1)/2; ++su2_index)
 	      su3over(u[mu], u_mu_staple, su2_index, gauge_set[cb]);
+#endif
 	  }
 	  else
 	  {
 	    /* Do a heatbath step */
+#ifndef QDP_IS_QDPJIT
+	    {
+	      int ntry = 0;
+	      int nfail = 0;
+
+	      // All SU(2) subgroups and tries within each site
+	      SiteHeatbath::heatbath(u[mu], u_mu_staple, Real(2.0/Nc), hbp.nmax(),
+				     key, mu, gauge_set[cb], ntry, nfail);
+
+	      ntrials += ntry;
+	      nfails += nfail;
+	    }
+#else
 	    /*# Loop over SU(2) subgroup index */
 	    for(int su2_index = 0; su2_index < Nc*(Nc-1)/2; ++su2_index)
 	    {
@@ -82,6 +103,7 @@ namespace Chroma
 	      ntrials += ntry;
 	      nfails += nfail;
 	    }
+#endif
           
 	    /* Reunitarize */
 	    reunit(u[mu]);
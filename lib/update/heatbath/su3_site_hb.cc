@@ -0,0 +1,402 @@
+/*! \file
+ *  \brief Site local SU(Nc) heatbath and overrelaxation
+ */
+
+#include "update/heatbath/su3_site_hb.h"
+
+#include <algorithm>
+
+namespace Chroma
+{
+  namespace SiteHeatbath
+  {
+    // Key of the counter based generator
+    Key newKey()
+    {
+      Double r0, r1;
+      random(r0);
+      random(r1);
+
+      Key key;
+      key.k0 = (unsigned int)(toDouble(r0) * 4294967296.0);
+      key.k1 = (unsigned int)(toDouble(r1) * 4294967296.0);
+
+      return key;
+    }
+
+#ifndef QDP_IS_QDPJIT
+
+    // Utility functions
+    namespace
+    {
+      //! Philox-4x32-10: four random words from a counter and a key
+      void philox(unsigned int x[4], const unsigned int ctr[4], const Key& key)
+      {
+	const unsigned long long M0 = 0xD2511F53ULL;
+	const unsigned long long M1 = 0xCD9E8D57ULL;
+
+	unsigned int c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+	unsigned int k0 = key.k0, k1 = key.k1;
+
+	for(int round=0; round < 10; ++round)
+	{
+	  unsigned long long p0 = M0 * c0;
+	  unsigned long long p1 = M1 * c2;
+
+	  c0 = (unsigned int)(p1 >> 32) ^ c1 ^ k0;
+	  c2 = (unsigned int)(p0 >> 32) ^ c3 ^ k1;
+	  c1 = (unsigned int)p1;
+	  c3 = (unsigned int)p0;
+
+	  k0 += 0x9E3779B9U;
+	  k1 += 0xBB67AE85U;
+	}
+
+	x[0] = c0;  x[1] = c1;  x[2] = c2;  x[3] = c3;
+      }
+
+      //! Four uniform numbers in (0,1)
+      void uniforms(double r[4], unsigned int site, unsigned int stream,
+		    unsigned int su2_index, unsigned int n, const Key& key)
+      {
+	unsigned int ctr[4] = {site, stream, su2_index, n};
+	unsigned int x[4];
+	philox(x, ctr, key);
+
+	for(int i=0; i < 4; ++i)
+	  r[i] = (double(x[i]) + 0.5) * (1.0 / 4294967296.0);
+      }
+
+      //! Counter of the draw for the direction of the SU(2) update
+      const unsigned int direction_draw = 0x80000000U;
+
+      //! Above this weight Kennedy-Pendleton accepts better than Creutz
+      const double kp_weight = 1.0;
+
+      //! Global lexicographic index of the sites on this node
+      const std::vector<unsigned int>& globalSites()
+      {
+	static std::vector<unsigned int> glob;
+
+	if (glob.size() != Layout::sitesOnNode())
+	{
+	  const multi1d<int>& nrow = Layout::lattSize();
+	  glob.resize(Layout::sitesOnNode());
+
+	  for(int site=0; site < Layout::sitesOnNode(); ++site)
+	  {
+	    multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), site);
+	    unsigned int index = 0;
+	    for(int mu=Nd-1; mu >= 0; --mu)
+	      index = index*nrow[mu] + coord[mu];
+
+	    glob[site] = index;
+	  }
+	}
+
+	return glob;
+      }
+
+      //! Rows (i1,i2) of the SU(2) subgroups, in the order of su2Extract
+      void su2Pairs(int i1[], int i2[])
+      {
+	int index = 0;
+	for(int del_i=1; del_i < Nc; ++del_i)
+	  for(int i=0; i < Nc-del_i; ++i)
+	  {
+	    i1[index] = i;
+	    i2[index] = i + del_i;
+	    ++index;
+	  }
+      }
+
+      //! A site matrix in double precision
+      struct SiteMatrix
+      {
+	double re[Nc][Nc];
+	double im[Nc][Nc];
+      };
+
+      void load(SiteMatrix& m, const LatticeColorMatrix& u, int site)
+      {
+	for(int i=0; i < Nc; ++i)
+	  for(int j=0; j < Nc; ++j)
+	  {
+	    m.re[i][j] = u.elem(site).elem().elem(i,j).real();
+	    m.im[i][j] = u.elem(site).elem().elem(i,j).imag();
+	  }
+      }
+
+      void store(LatticeColorMatrix& u, int site, const SiteMatrix& m)
+      {
+	for(int i=0; i < Nc; ++i)
+	  for(int j=0; j < Nc; ++j)
+	  {
+	    u.elem(site).elem().elem(i,j).real() = m.re[i][j];
+	    u.elem(site).elem().elem(i,j).imag() = m.im[i][j];
+	  }
+      }
+
+      //! v = u*w
+      void multiply(SiteMatrix& v, const SiteMatrix& u, const SiteMatrix& w)
+      {
+	for(int i=0; i < Nc; ++i)
+	  for(int j=0; j < Nc; ++j)
+	  {
+	    double re = 0, im = 0;
+	    for(int k=0; k < Nc; ++k)
+	    {
+	      re += u.re[i][k]*w.re[k][j] - u.im[i][k]*w.im[k][j];
+	      im += u.re[i][k]*w.im[k][j] + u.im[i][k]*w.re[k][j];
+	    }
+	    v.re[i][j] = re;
+	    v.im[i][j] = im;
+	  }
+      }
+
+      //! The components r_k of the SU(2) submatrix (i1,i2), as su2Extract
+      void extract(double r[4], const SiteMatrix& v, int i1, int i2)
+      {
+	r[0] = v.re[i1][i1] + v.re[i2][i2];
+	r[1] = v.im[i1][i2] + v.im[i2][i1];
+	r[2] = v.re[i1][i2] - v.re[i2][i1];
+	r[3] = v.im[i1][i1] - v.im[i2][i2];
+      }
+
+      //! m = S*m, with S the SU(2) matrix b in the subgroup (i1,i2), as sunFill
+      void leftMultiply(SiteMatrix& m, const double b[4], int i1, int i2)
+      {
+	for(int k=0; k < Nc; ++k)
+	{
+	  double r1 = m.re[i1][k], m1 = m.im[i1][k];
+	  double r2 = m.re[i2][k], m2 = m.im[i2][k];
+
+	  // S11 = (b0,b3)  S12 = (b2,b1)  S21 = (-b2,b1)  S22 = (b0,-b3)
+	  m.re[i1][k] =  b[0]*r1 - b[3]*m1 + b[2]*r2 - b[1]*m2;
+	  m.im[i1][k] =  b[0]*m1 + b[3]*r1 + b[2]*m2 + b[1]*r2;
+	  m.re[i2][k] = -b[2]*r1 - b[1]*m1 + b[0]*r2 + b[3]*m2;
+	  m.im[i2][k] = -b[2]*m1 + b[1]*r1 + b[0]*m2 - b[3]*r2;
+	}
+      }
+
+      //! Draw a_0 with density sqrt(1-a_0^2) exp(weight*a_0). False if never accepted
+      bool drawA0(double& a0, double weight, int nmax,
+		  unsigned int site, unsigned int stream, unsigned int su2_index, const Key& key)
+      {
+	double x[4];
+
+	if (weight > kp_weight)
+	{
+	  // Kennedy-Pendleton
+	  for(int n=0; nmax <= 0 || n < nmax; ++n)
+	  {
+	    uniforms(x, site, stream, su2_index, n, key);
+
+	    double c = cos(2*M_PI*x[2]);
+	    double delta = -(log(x[1]) + log(x[0])*c*c) / weight;
+
+	    if (x[3]*x[3] < 1 - 0.5*delta)
+	    {
+	      a0 = 1 - delta;
+	      return true;
+	    }
+	  }
+	}
+	else
+	{
+	  // Creutz
+	  double w_exp = exp(-2*weight);
+
+	  for(int n=0; nmax <= 0 || n < nmax; ++n)
+	  {
+	    uniforms(x, site, stream, su2_index, n, key);
+
+	    a0 = 1 + log(w_exp*(1 - x[0]) + x[0]) / weight;
+
+	    if (x[1]*x[1] < 1 - a0*a0)
+	      return true;
+	  }
+	}
+
+	return false;
+      }
+
+
+      struct SiteHBArgs
+      {
+	LatticeColorMatrix&        u;
+	const LatticeColorMatrix&  w;
+	double                     beta;
+	int                        nmax;
+	Key                        key;
+	unsigned int               stream;
+	const int*                 tab;     /*!< the site table */
+	const unsigned int*        glob;    /*!< global index of the sites */
+	int*                       nfail;   /*!< failures per thread */
+      };
+
+      //! Heatbath of the sites [lo,hi) of the table
+      void heatbathSiteLoop(int lo, int hi, int my_id, SiteHBArgs* a)
+      {
+	const int nsub = Nc*(Nc-1)/2;
+	int i1[nsub], i2[nsub];
+	su2Pairs(i1, i2);
+
+	int nfail = 0;
+
+	for(int j=lo; j < hi; ++j)
+	{
+	  int site = a->tab[j];
+	  unsigned int glob = a->glob[site];
+
+	  SiteMatrix u, w, v;
+	  load(u, a->u, site);
+	  load(w, a->w, site);
+	  multiply(v, u, w);
+
+	  for(int s=0; s < nsub; ++s)
+	  {
+	    // The subgroup of V, less the extra 2 of su(2)
+	    double r[4];
+	    extract(r, v, i1[s], i2[s]);
+	    for(int k=0; k < 4; ++k)
+	      r[k] *= 0.5;
+
+	    double sq_det = sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2] + r[3]*r[3]);
+	    double a0;
+
+	    if (sq_det < 1.0e-16 || ! drawA0(a0, a->beta*sq_det, a->nmax, glob, a->stream, s, a->key))
+	    {
+	      ++nfail;
+	      continue;
+	    }
+
+	    // The other components, uniform on the sphere of radius sqrt(1-a_0^2)
+	    double x[4];
+	    uniforms(x, glob, a->stream, s, direction_draw, a->key);
+
+	    double a_r = sqrt(std::max(1 - a0*a0, 0.0));
+	    double cos_theta = 1 - 2*x[0];
+	    double sin_theta = sqrt(std::max(1 - cos_theta*cos_theta, 0.0));
+	    double phi = 2*M_PI*x[1];
+
+	    double aa[4] = {a0, a_r*sin_theta*cos(phi), a_r*sin_theta*sin(phi), a_r*cos_theta};
+
+	    // b = a times the inverse of the normalised subgroup of V
+	    double ri[4] = {r[0]/sq_det, -r[1]/sq_det, -r[2]/sq_det, -r[3]/sq_det};
+	    double b[4];
+	    b[0] = aa[0]*ri[0] - aa[1]*ri[1] - aa[2]*ri[2] - aa[3]*ri[3];
+	    b[1] = aa[0]*ri[1] + aa[1]*ri[0] - aa[2]*ri[3] + aa[3]*ri[2];
+	    b[2] = aa[0]*ri[2] + aa[2]*ri[0] - aa[3]*ri[1] + aa[1]*ri[3];
+	    b[3] = aa[0]*ri[3] + aa[3]*ri[0] - aa[1]*ri[2] + aa[2]*ri[1];
+
+	    // U = S*U and, since V = U*W, V = S*V
+	    leftMultiply(u, b, i1[s], i2[s]);
+	    leftMultiply(v, b, i1[s], i2[s]);
+	  }
+
+	  store(a->u, site, u);
+	}
+
+	a->nfail[my_id] += nfail;
+      }
+
+
+      struct SiteORArgs
+      {
+	LatticeColorMatrix&        u;
+	const LatticeColorMatrix&  w;
+	const int*                 tab;
+      };
+
+      //! Overrelaxation of the sites [lo,hi) of the table
+      void overrelaxSiteLoop(int lo, int hi, int my_id, SiteORArgs* a)
+      {
+	const int nsub = Nc*(Nc-1)/2;
+	int i1[nsub], i2[nsub];
+	su2Pairs(i1, i2);
+
+	for(int j=lo; j < hi; ++j)
+	{
+	  int site = a->tab[j];
+
+	  SiteMatrix u, w, v;
+	  load(u, a->u, site);
+	  load(w, a->w, site);
+	  multiply(v, u, w);
+
+	  for(int s=0; s < nsub; ++s)
+	  {
+	    double r[4];
+	    extract(r, v, i1[s], i2[s]);
+
+	    double r_l = sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2] + r[3]*r[3]);
+	    if (r_l <= toDouble(fuzz))
+	      continue;
+
+	    // The update is the square of the inverse of the normalised subgroup
+	    double aa[4] = {r[0]/r_l, -r[1]/r_l, -r[2]/r_l, -r[3]/r_l};
+	    double b[4] = {aa[0]*aa[0] - aa[1]*aa[1] - aa[2]*aa[2] - aa[3]*aa[3],
+			   2*aa[0]*aa[1], 2*aa[0]*aa[2], 2*aa[0]*aa[3]};
+
+	    leftMultiply(u, b, i1[s], i2[s]);
+	    leftMultiply(v, b, i1[s], i2[s]);
+	  }
+
+	  store(a->u, site, u);
+	}
+      }
+    }
+
+
+    // Heatbath of u on the sites of sub
+    void heatbath(LatticeColorMatrix& u, const LatticeColorMatrix& w,
+		  const Real& beta, int nmax,
+		  const Key& key, unsigned int stream, const Subset& sub,
+		  int& ntry, int& nfail)
+    {
+      START_CODE();
+
+      std::vector<int> fails(qdpNumThreads(), 0);
+      int len = sub.numSiteTable();
+
+      if (len > 0)
+      {
+	SiteHBArgs args = {u, w, toDouble(beta), nmax, key, stream,
+			   sub.siteTable().slice(), &(globalSites()[0]), &(fails[0])};
+	dispatch_to_threads(len, args, heatbathSiteLoop);
+      }
+
+      ntry = len * (Nc*(Nc-1)/2);
+      nfail = 0;
+      for(int t=0; t < fails.size(); ++t)
+	nfail += fails[t];
+
+      QDPInternal::globalSum(ntry);
+      QDPInternal::globalSum(nfail);
+
+      END_CODE();
+    }
+
+
+    // Overrelaxation of u on the sites of sub
+    void overrelax(LatticeColorMatrix& u, const LatticeColorMatrix& w, const Subset& sub)
+    {
+      START_CODE();
+
+      int len = sub.numSiteTable();
+
+      if (len > 0)
+      {
+	SiteORArgs args = {u, w, sub.siteTable().slice()};
+	dispatch_to_threads(len, args, overrelaxSiteLoop);
+      }
+
+      END_CODE();
+    }
+
+#endif
+
+  }  // end namespace SiteHeatbath
+
+}  // end namespace Chroma
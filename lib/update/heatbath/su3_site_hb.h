@@ -0,0 +1,67 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Site local SU(Nc) heatbath and overrelaxation
+ */
+
+#ifndef __su3_site_hb_h__
+#define __su3_site_hb_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Site local SU(Nc) heatbath and overrelaxation
+  /*! \ingroup heatbath
+   *
+   * The lattice wide updates (su2_hb_update, su3over) work on one SU(2)
+   * subgroup at a time and draw whole LatticeReal fields of random numbers
+   * for every accept/reject round, sweeping the full subset until the last
+   * site has accepted. Here each site of the subset is updated on its own:
+   * V = U*W is formed once and then all the SU(2) subgroups and all the
+   * accept/reject tries run inside the site. The sites are threaded.
+   *
+   * Random numbers come from a counter based generator (Philox-4x32-10).
+   * A draw is a function only of the key, the global site index, a stream
+   * number and the subgroup and try, so the result does not depend on the
+   * number of threads or on the layout over the nodes.
+   */
+  namespace SiteHeatbath
+  {
+    //! Key of the counter based generator
+    struct Key
+    {
+      unsigned int k0;
+      unsigned int k1;
+    };
+
+    //! A new key drawn from the global random number generator
+    /*! Collective - every node gets the same key */
+    Key newKey();
+
+#ifndef QDP_IS_QDPJIT
+    //! Heatbath of u on the sites of sub, all SU(2) subgroups in turn
+    /*!
+     * \param u        link field to be updated ( Modify )
+     * \param w        staple, including any couplings ( Read )
+     * \param beta     coupling of the SU(2) heatbath ( Read )
+     * \param nmax     maximum tries per subgroup, <= 0 is unlimited ( Read )
+     * \param key      generator key ( Read )
+     * \param stream   distinguishes the calls made with one key ( Read )
+     * \param sub      subset of the sites ( Read )
+     * \param ntry     number of subgroup updates tried, summed over nodes ( Write )
+     * \param nfail    number of them that never accepted ( Write )
+     */
+    void heatbath(LatticeColorMatrix& u, const LatticeColorMatrix& w,
+		  const Real& beta, int nmax,
+		  const Key& key, unsigned int stream, const Subset& sub,
+		  int& ntry, int& nfail);
+
+    //! Microcanonical overrelaxation of u on the sites of sub, all SU(2) subgroups in turn
+    void overrelax(LatticeColorMatrix& u, const LatticeColorMatrix& w, const Subset& sub);
+#endif
+  }
+
+}  // end namespace Chroma
+
+#endif
@@ -16,6 +16,19 @@
 
 namespace Chroma 
 {
+  //! A fresh coordinate version
+  /*! @ingroup molecdyn
+   *
+   * Versions are unique across all field states, see
+   * AbsFieldState::getQVersion
+   */
+  inline unsigned long newFieldStateQVersion()
+  {
+    static unsigned long version = 0;
+    return ++version;
+  }
+
+
   //! Abstract field state
   /*! @ingroup molecdyn
    *
@@ -42,6 +55,15 @@ namespace Chroma
     virtual P& getP(void) = 0;
     virtual Q& getQ(void) = 0;
 
+    //! Version of the coordinates
+    /*! 
+     * Changes whenever the coordinates may have been modified, i.e. on
+     * every call of the mutable getQ. Two states with the same version
+     * hold the same coordinates, so it can key caches of things built
+     * from Q.
+     */
+    virtual unsigned long getQVersion(void) const = 0;
+
     // And that is all we can do here
   };
   
@@ -86,6 +108,7 @@ namespace Chroma
     // Constructor
     GaugeFieldState(const multi1d<LatticeColorMatrix>& p_,
 		    const multi1d<LatticeColorMatrix>& q_) {
+      q_version = newFieldStateQVersion();
       p.resize(Nd);
       q.resize(Nd);
       for(int mu=0; mu < Nd; mu++) { 
@@ -96,6 +119,7 @@ namespace Chroma
       
     // Copy Constructor
     GaugeFieldState(const GaugeFieldState& s)  {
+      q_version = s.q_version;
       p.resize(Nd);
       q.resize(Nd);
       for(int mu=0; mu < Nd; mu++) { 
@@ -119,11 +143,14 @@ namespace Chroma
       
     // Mutators
     multi1d<LatticeColorMatrix>& getP(void)  { return p; }
-    multi1d<LatticeColorMatrix>& getQ(void)  { return q; }
+    multi1d<LatticeColorMatrix>& getQ(void)  { q_version = newFieldStateQVersion(); return q; }
+
+    unsigned long getQVersion(void) const { return q_version; }
       
   private:
     multi1d<LatticeColorMatrix> p;
     multi1d<LatticeColorMatrix> q;
+    unsigned long q_version;
   };
   
 }  // End namespace Chroma
@@ -14,6 +14,7 @@
 #include "update/molecdyn/integrator/abs_integrator.h"
 #include "update/molecdyn/hmc/global_metropolis_accrej.h"
 #include "actions/ferm/invert/mg_solver_exception.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 
 namespace Chroma 
@@ -270,6 +271,11 @@ namespace Chroma
 	s.getP() = s_old->getP();
 	
       }
+
+      // Fermion states are only shared within a trajectory
+      TheFermStateCache::Instance().writeStats(xml_log, "FermStateCache");
+      TheFermStateCache::Instance().resetStats();
+      TheFermStateCache::Instance().flush();
             
       pop(xml_log); // HMCTrajectory
       pop(xml_out); // HMCTrajectory
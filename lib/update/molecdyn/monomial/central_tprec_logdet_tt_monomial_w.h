@@ -17,6 +17,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "io/xmllog_io.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 
 namespace Chroma 
@@ -44,7 +45,7 @@ namespace Chroma
 	const CentralTimePrecFermAct<Phi,P,Q>& FA = getFermAct();
       
 	// Create a state for linop
-	Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+	Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
 	//Create LinOp
 	Handle< CentralTimePrecLinearOperator<Phi,P,Q> > lin(FA.linOp(state));
@@ -70,7 +71,7 @@ namespace Chroma
 
 	push(xml_out, "CentralTimePrecLogDetTTMonomial");
 	const CentralTimePrecFermAct<Phi,P,Q>& FA = getFermAct();
-	Handle< FermState<Phi,P,Q> > bc_g_state = FA.createState(s.getQ());
+	Handle< FermState<Phi,P,Q> > bc_g_state = TheFermStateCache::Instance().createState(FA, s);
 
 	// Need way to get gauge state from AbsFieldState<P,Q>
 	Handle< CentralTimePrecLinearOperator<Phi,P,Q> > lin(FA.linOp(bc_g_state));
@@ -12,6 +12,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/monomial/remez_coeff.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 #include <typeinfo>
 
@@ -66,7 +67,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA = getFermAct();
       
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Start the force
       F.resize(Nd);
@@ -167,7 +168,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA = getFermAct();
       
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(FA, s));
       
       // Force terms
       const int N5 = FA.size();
@@ -285,7 +286,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA = getFermAct();
 
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > bc_g_state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > bc_g_state(TheFermStateCache::Instance().createState(FA, s));
 
       // Force terms
       const int N5 = FA.size();
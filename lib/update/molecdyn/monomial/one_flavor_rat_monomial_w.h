@@ -13,6 +13,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/monomial/remez_coeff.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 #include <typeinfo>
 
 namespace Chroma
@@ -72,7 +73,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
       
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< DiffLinearOperator<Phi,P,Q> > lin(FA.linOp(state));
@@ -186,7 +187,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
       
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(FA, s));
       
       // Create a linear operator
       Handle< DiffLinearOperator<Phi,P,Q> > M(FA.linOp(f_state));
@@ -283,7 +284,7 @@ namespace Chroma
 
       const WilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
 
-      Handle< FermState<Phi,P,Q> > bc_g_state = FA.createState(s.getQ());
+      Handle< FermState<Phi,P,Q> > bc_g_state = TheFermStateCache::Instance().createState(FA, s);
 
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< DiffLinearOperator<Phi,P,Q> > lin(FA.linOp(bc_g_state));
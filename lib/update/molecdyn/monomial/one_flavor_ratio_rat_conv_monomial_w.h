@@ -12,6 +12,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/monomial/remez_coeff.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 #include <typeinfo>
 
 namespace Chroma
@@ -74,7 +75,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA_num = getNumerFermAct();
       
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA_num.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA_num, s));
 	
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< DiffLinearOperator<Phi,P,Q> > M_num(FA_num.linOp(state));
@@ -176,7 +177,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA_num = getNumerFermAct();
       
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > state(FA_num.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA_num, s));
       
       // Create a linear operator
       Handle< DiffLinearOperator<Phi,P,Q> > M_num(FA_num.linOp(state));
@@ -270,7 +271,7 @@ namespace Chroma
 
       const WilsonTypeFermAct<Phi,P,Q>& FA_num = getNumerFermAct();
 
-      Handle< FermState<Phi,P,Q> > state = FA_num.createState(s.getQ());
+      Handle< FermState<Phi,P,Q> > state = TheFermStateCache::Instance().createState(FA_num, s);
 
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< DiffLinearOperator<Phi,P,Q> > M_num(FA_num.linOp(state));
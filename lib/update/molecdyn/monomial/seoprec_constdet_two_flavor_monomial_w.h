@@ -9,6 +9,7 @@
 #include "update/molecdyn/field_state.h"
 #include "update/molecdyn/monomial/two_flavor_monomial_w.h"
 #include "update/molecdyn/monomial/two_flavor_monomial_params_w.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 namespace Chroma 
 {
@@ -61,7 +62,7 @@ namespace Chroma
 
       const SymEvenOddPrecWilsonTypeFermAct<T,P,Q>& FA = getFermAct();
 
-      Handle< FermState<T,P,Q> > state = FA.createState(s.getQ());
+      Handle< FermState<T,P,Q> > state = TheFermStateCache::Instance().createState(FA, s);
 
       // Get system solver
       Handle< MdagMSystemSolver<T> > invMdagM(FA.invMdagM(state, getInvParams()));
@@ -11,6 +11,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "io/xmllog_io.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 
 namespace Chroma 
@@ -38,7 +39,7 @@ namespace Chroma
       const SymEvenOddPrecLogDetWilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
       
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       //Create LinOp
       Handle< SymEvenOddPrecLogDetLinearOperator<Phi,P,Q> > lin(FA.linOp(state));
@@ -71,7 +72,7 @@ namespace Chroma
 
       push(xml_out, "SymEvenOddPrecLogDetDiagMonomial");
       const SymEvenOddPrecLogDetWilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
-      Handle< FermState<Phi,P,Q> > bc_g_state = FA.createState(s.getQ());
+      Handle< FermState<Phi,P,Q> > bc_g_state = TheFermStateCache::Instance().createState(FA, s);
 
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< SymEvenOddPrecLogDetLinearOperator<Phi,P,Q> > lin(FA.linOp(bc_g_state));
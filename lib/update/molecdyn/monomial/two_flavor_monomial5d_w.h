@@ -12,6 +12,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/predictor/chrono_predictor.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 #include <typeinfo>
 
@@ -67,7 +68,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA = getFermAct();
       
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Get linear operator
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M(FA.linOp(state));
@@ -109,6 +110,7 @@ namespace Chroma
 
       state->deriv(F);
       write(xml_out, "n_count", n_count);
+      getMDSolutionPredictor().writeStats(xml_out, "Predictor", n_count);
       monitorForces(xml_out, "Forces", F);
       pop(xml_out);
     
@@ -126,7 +128,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA = getFermAct();
       
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(FA.createState(field_state.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(FA, field_state));
       
       // Create a linear operator
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M(FA.linOp(f_state));
@@ -232,7 +234,7 @@ namespace Chroma
 
       const WilsonTypeFermAct5D<Phi,P,Q>& FA = getFermAct();
 
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 
       // Get system solver
       Handle< MdagMSystemSolverArray<Phi> > invMdagM(FA.invMdagM(state, getInvParams()));
@@ -310,7 +312,7 @@ namespace Chroma
 
       const EvenOddPrecWilsonTypeFermAct5D<Phi,P,Q>& FA = getFermAct();
 
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 
       // Get system solver
       Handle< MdagMSystemSolverArray<Phi> > invMdagM(FA.invMdagM(state, getInvParams()));
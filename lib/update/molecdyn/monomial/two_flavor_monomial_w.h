@@ -15,6 +15,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/predictor/chrono_predictor.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 #include <typeinfo>
 
@@ -68,7 +69,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
       
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Get system solver
       Handle< MdagMSystemSolver<Phi> > invMdagM(FA.invMdagM(state, getInvParams()));
@@ -109,6 +110,7 @@ namespace Chroma
       state->deriv(F);
       
       write(xml_out, "n_count", res.n_count);
+      getMDSolutionPredictor().writeStats(xml_out, "Predictor", res.n_count);
       monitorForces(xml_out, "Forces", F);
 
       pop(xml_out);
@@ -127,7 +129,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& S_f = getFermAct();
       
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(S_f.createState(field_state.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(S_f, field_state));
       
       // Create a linear operator
       Handle< DiffLinearOperator<Phi,P,Q> > M(S_f.linOp(f_state));
@@ -223,7 +225,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
 
       // Make the state
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 
       // Get system solver
       Handle< MdagMSystemSolver<Phi> > invMdagM(FA.invMdagM(state, getInvParams()));
@@ -298,7 +300,7 @@ namespace Chroma
 
       const EOFermActT<Phi,P,Q>& FA = getFermAct();
 
-      Handle< FermState<Phi,P,Q> > state = FA.createState(s.getQ());
+      Handle< FermState<Phi,P,Q> > state = TheFermStateCache::Instance().createState(FA, s);
 
       // Get system solver
       Handle< MdagMSystemSolver<Phi> > invMdagM(FA.invMdagM(state, getInvParams()));
@@ -435,7 +437,7 @@ namespace Chroma
       START_CODE();
 
       const EOFermActT<Phi,P,Q>& FA = getFermAct();
-      Handle< FermState<Phi,P,Q> > state = FA.createState(s.getQ());
+      Handle< FermState<Phi,P,Q> > state = TheFermStateCache::Instance().createState(FA, s);
 
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< EOLinOpT<Phi,P,Q> > M(FA.linOp(state));
@@ -497,7 +499,7 @@ namespace Chroma
       const EOFermActT<Phi,P,Q>& FA = getFermAct();
       
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Get system solver
       Handle< MdagMSystemSolver<Phi> > invMdagM(FA.invMdagM(state, getInvParams()));
@@ -545,6 +547,7 @@ namespace Chroma
       
       state->deriv(F);
       write(xml_out, "n_count", res.n_count);
+      getMDSolutionPredictor().writeStats(xml_out, "Predictor", res.n_count);
       monitorForces(xml_out, "Forces", F);
       pop(xml_out);
 
@@ -20,6 +20,7 @@
 #include "update/molecdyn/predictor/chrono_predictor_factory.h"
 #include "update/molecdyn/predictor/zero_guess_predictor.h"
 #include "update/molecdyn/monomial/two_flavor_multihasen_cancel_monomial_params_w.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 
 namespace Chroma
@@ -63,7 +64,7 @@ namespace Chroma
 				push(xml_out, "S");
 
 				const FAType<T,P,Q>& FA = getFermAct();
-				Handle<FermState<T,P,Q> > state = FA.createState(s.getQ());
+				Handle<FermState<T,P,Q> > state = TheFermStateCache::Instance().createState(FA, s);
 
 				// Get the X fields
 				T X;
@@ -106,7 +107,7 @@ namespace Chroma
 				push(xml_out, "TwoFlavorWilsonTypeMultihasenCancelMonomial");
 
 				const FAType<T,P,Q>& FA = getFermAct();
-				Handle<FermState<T,P,Q> > state = FA.createState(s.getQ());
+				Handle<FermState<T,P,Q> > state = TheFermStateCache::Instance().createState(FA, s);
 
 				Handle<LOType<T,P,Q> > base_op(FA.linOp(state));
 
@@ -144,6 +145,7 @@ namespace Chroma
 				state->deriv(F);
 
 				write(xml_out, "n_count", res.n_count);
+				getMDSolutionPredictor().writeStats(xml_out, "Predictor", res.n_count);
 				monitorForces(xml_out, "Forces", F);
 
 				pop(xml_out);
@@ -155,7 +157,7 @@ namespace Chroma
 				START_CODE();
 
 				const FAType<T,P,Q>& FA = getFermAct();
-				Handle<FermState<T,P,Q> > state = FA.createState(s.getQ());
+				Handle<FermState<T,P,Q> > state = TheFermStateCache::Instance().createState(FA, s);
 
 				Handle<LOType<T,P,Q> > base_op(FA.linOp(state));
 
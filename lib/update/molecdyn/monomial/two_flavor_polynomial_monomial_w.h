@@ -11,6 +11,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/predictor/chrono_predictor.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 #include <typeinfo>
 
@@ -64,7 +65,7 @@ namespace Chroma
       const PolyWilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
       
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< DiffLinearOperator<Phi,P,Q> > lin(FA.polyLinOp(state));
@@ -96,7 +97,7 @@ namespace Chroma
       const PolyWilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
       
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(FA.createState(field_state.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(FA, field_state));
       
       // Create a linear operator
       Handle< DiffLinearOperator<Phi,P,Q> > MdagM(FA.lMdagM(f_state));
@@ -193,7 +194,7 @@ namespace Chroma
       const PolyWilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
 
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
       
       // Create a linear operator
       Handle< DiffLinearOperator<Phi,P,Q> > Poly(FA.polyLinOp(state));
@@ -259,7 +260,7 @@ namespace Chroma
 
       const PolyWilsonTypeFermAct<Phi,P,Q>& FA = getFermAct();
 
-      Handle< FermState<Phi,P,Q> > state = FA.createState(s.getQ());
+      Handle< FermState<Phi,P,Q> > state = TheFermStateCache::Instance().createState(FA, s);
 
       // Create a linear operator
       Handle< DiffLinearOperator<Phi,P,Q> > Poly(FA.polyLinOp(state));
@@ -12,6 +12,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/predictor/chrono_predictor.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 #include <typeinfo> // For std::bad_cast
 namespace Chroma
 {
@@ -79,7 +80,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& precFA = getDenomFermAct();
 
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Get linear operator
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M(FA.linOp(state));
@@ -117,6 +118,7 @@ namespace Chroma
       state->deriv(F);
 
       write(xml_out, "n_count", n_count);
+      getMDSolutionPredictor().writeStats(xml_out, "Predictor", n_count);
       monitorForces(xml_out, "Forces", F);
 
       pop(xml_out);
@@ -136,7 +138,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& precFA = getDenomFermAct();
       
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(FA.createState(field_state.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(FA, field_state));
       
       // Create a linear operator
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M(FA.linOp(f_state));
@@ -250,7 +252,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA_prec = getDenomFermAct();
 
       // Make the state
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 
       // Get linop
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M(FA.linOp(state));
@@ -311,7 +313,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA_prec = getDenomFermAct();
 
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(FA_prec.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(FA_prec, s));
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M_prec(FA_prec.linOp(f_state));
  
       multi1d<Phi> X(FA_prec.size());
@@ -398,7 +400,7 @@ namespace Chroma
       const EvenOddPrecWilsonTypeFermAct5D<Phi,P,Q>& FA = getNumerFermAct();
       const EvenOddPrecWilsonTypeFermAct5D<Phi,P,Q>& FA_prec = getDenomFermAct();
       
-      Handle< FermState<Phi,P,Q> > bc_g_state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > bc_g_state(TheFermStateCache::Instance().createState(FA, s));
 
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< EvenOddPrecLinearOperatorArray<Phi,P,Q> > lin(FA.linOp(bc_g_state));
@@ -13,6 +13,7 @@
 #include "update/molecdyn/monomial/abs_monomial.h"
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/predictor/chrono_predictor.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 #include <typeinfo>
 
@@ -72,7 +73,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA_prec = getDenomFermAct();  // for M_prec
 
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Get system solver
       Handle< MdagMSystemSolver<Phi> > invMdagM(FA.invMdagM(state,getNumerInvParams()));
@@ -121,6 +122,7 @@ namespace Chroma
       state->deriv(F);
 
       write(xml_out, "n_count", res.n_count);
+      getMDSolutionPredictor().writeStats(xml_out, "Predictor", res.n_count);
       monitorForces(xml_out, "Forces", F);
 
       pop(xml_out);
@@ -142,7 +144,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA_prec = getDenomFermAct();
 
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > state(FA.createState(field_state.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, field_state));
       
       // Create a linear operator for the Expensive op
       Handle< DiffLinearOperator<Phi,P,Q> > M(FA.linOp(state));
@@ -291,7 +293,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA_prec = getDenomFermAct();  // for M_prec
 
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Get the fermion action for the preconditioner
       Handle< DiffLinearOperator<Phi,P,Q> > M(FA.linOp(state));	
@@ -385,7 +387,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA_prec = getDenomFermAct();  // for M_prec
 
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle<  EOLinOpT<Phi,P,Q> > M(FA.linOp(state));
@@ -23,6 +23,7 @@
 #include "eoprec_logdet_wilstype_fermact_w.h"
 #include "update/molecdyn/predictor/chrono_predictor_factory.h"
 #include "update/molecdyn/predictor/zero_guess_predictor.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 namespace Chroma
 {
@@ -62,7 +63,7 @@ namespace Chroma
 				Double S=0;
 				// Get the X fields
 				T X;
-				Handle<FermState<T,P,Q> > state(FA.createState(s.getQ()));
+				Handle<FermState<T,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 				Handle<LOType<T,P,Q> > base_op(FA.linOp(state));
 
 				for(int i=0; i<numHasenTerms; ++i){
@@ -136,7 +137,7 @@ namespace Chroma
 				// M_dag_prec_phi = M^\dag_prec \phi
 				T M_dag_prec_phi;
 
-				Handle<FermState<T,P,Q> > state(FA.createState(s.getQ()));
+				Handle<FermState<T,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 				Handle<LOType<T,P,Q> > base_op(FA.linOp(state));
 
 				for(int i=0; i<numHasenTerms; ++i){
@@ -187,6 +188,7 @@ namespace Chroma
 					std::string force = "Forces_hasenterm_" + std::to_string(i+1);
 
 					write(xml_out, n_count, res.n_count);
+					getMDSolutionPredictor().writeStats(xml_out, "Predictor_hasenterm_" + std::to_string(i+1), res.n_count);
 					monitorForces(xml_out, force, F_t);
 				}
 				// Total force from all Hasenbusch terms
@@ -200,7 +202,7 @@ namespace Chroma
 				START_CODE();
 				const FAType<T,P,Q>& FA = getFermAct();
 
-				Handle<FermState<T,P,Q> > state(FA.createState(s.getQ()));
+				Handle<FermState<T,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 				Handle<LOType<T,P,Q> > base_op(FA.linOp(state));
 				for(int i=0; i<numHasenTerms; ++i){
 					Handle<LinearOperator<T> > 
@@ -13,6 +13,7 @@
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/monomial/remez_coeff.h"
 #include "update/molecdyn/predictor/chrono_predictor.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 #include <typeinfo> // For std::bad_cast
 
@@ -82,7 +83,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& precFA = getDenomFermAct();
 
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Get linear operator
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M(FA.linOp(state));
@@ -120,6 +121,7 @@ namespace Chroma
       state->deriv(F);
 
       write(xml_out, "n_count", n_count);
+      getMDSolutionPredictor().writeStats(xml_out, "Predictor", n_count);
       monitorForces(xml_out, "Forces", F);
 
       pop(xml_out);
@@ -139,7 +141,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& precFA = getDenomFermAct();
       
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(FA.createState(field_state.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(FA, field_state));
       
       // Create a linear operator
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M(FA.linOp(f_state));
@@ -267,7 +269,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA_prec = getDenomFermAct();
 
       // Make the state
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 
       // Get linop
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M(FA.linOp(state));
@@ -328,7 +330,7 @@ namespace Chroma
       const WilsonTypeFermAct5D<Phi,P,Q>& FA_prec = getDenomFermAct();
 
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(FA_prec.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(FA_prec, s));
       Handle< DiffLinearOperatorArray<Phi,P,Q> > M_prec(FA_prec.linOp(f_state));
  
       multi1d<Phi> X(FA_prec.size());
@@ -412,7 +414,7 @@ namespace Chroma
       const EvenOddPrecWilsonTypeFermAct5D<Phi,P,Q>& FA = getNumerFermAct();
       const EvenOddPrecWilsonTypeFermAct5D<Phi,P,Q>& FA_prec = getDenomFermAct();
       
-      Handle< FermState<Phi,P,Q> > bc_g_state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > bc_g_state(TheFermStateCache::Instance().createState(FA, s));
 
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< EvenOddPrecLinearOperatorArray<Phi,P,Q> > lin(FA.linOp(bc_g_state));
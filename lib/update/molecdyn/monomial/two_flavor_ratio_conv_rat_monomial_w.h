@@ -13,6 +13,7 @@
 #include "update/molecdyn/monomial/force_monitors.h"
 #include "update/molecdyn/monomial/remez_coeff.h"
 #include "update/molecdyn/predictor/chrono_predictor.h"
+#include "actions/ferm/fermstates/fermstate_cache_w.h"
 
 #include <typeinfo>
 
@@ -73,7 +74,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FAPrec = getDenomFermAct();  // for M_prec
 
       // Create a state for linop
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 	
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< DiffLinearOperator<Phi,P,Q> > lin(FA.linOp(state));	
@@ -109,6 +110,7 @@ namespace Chroma
       state->deriv(F);
 
       write(xml_out, "n_count", n_count);
+      getMDSolutionPredictor().writeStats(xml_out, "Predictor", n_count);
       monitorForces(xml_out, "Forces", F);
 
       pop(xml_out);
@@ -130,7 +132,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& S_prec = getDenomFermAct();
 
       // Create a Connect State, apply fermionic boundaries
-      Handle< FermState<Phi,P,Q> > f_state(S_f.createState(field_state.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(S_f, field_state));
       
       // Create a linear operator for the Expensive op
       Handle< DiffLinearOperator<Phi,P,Q> > M(S_f.linOp(f_state));
@@ -229,7 +231,7 @@ namespace Chroma
       const WilsonTypeFermAct<Phi,P,Q>& FA_prec = getDenomFermAct();
 
       // Make the state
-      Handle< FermState<Phi,P,Q> > state(FA.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > state(TheFermStateCache::Instance().createState(FA, s));
 
       // Get linop
       Handle< DiffLinearOperator<Phi,P,Q> > M(FA.linOp(state));
@@ -349,7 +351,7 @@ namespace Chroma
 
       // Get the fermion action for the preconditioner
       const WilsonTypeFermAct<Phi,P,Q>& S_prec = getDenomFermAct();
-      Handle< FermState<Phi,P,Q> > f_state(S_prec.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(S_prec, s));
       Handle< DiffLinearOperator<Phi,P,Q> > M_prec(S_prec.linOp(f_state));      
 
       Phi phi_tmp=zero;
@@ -414,7 +416,7 @@ namespace Chroma
 
       const EvenOddPrecWilsonTypeFermAct<Phi,P,Q>& FA = getNumerFermAct();
 
-      Handle< FermState<Phi,P,Q> > bc_g_state = FA.createState(s.getQ());
+      Handle< FermState<Phi,P,Q> > bc_g_state = TheFermStateCache::Instance().createState(FA, s);
 
       // Need way to get gauge state from AbsFieldState<P,Q>
       Handle< EvenOddPrecLinearOperator<Phi,P,Q> > lin(FA.linOp(bc_g_state));
@@ -431,7 +433,7 @@ namespace Chroma
       int n_count = this->getX(X, s);
 
       const WilsonTypeFermAct<Phi,P,Q>& S_prec = getDenomFermAct();
-      Handle< FermState<Phi,P,Q> > f_state(S_prec.createState(s.getQ()));
+      Handle< FermState<Phi,P,Q> > f_state(TheFermStateCache::Instance().createState(S_prec, s));
       Handle< DiffLinearOperator<Phi,P,Q> > M_prec(S_prec.linOp(f_state));      
 
       Phi phi_tmp=zero;
@@ -49,6 +49,11 @@ namespace Chroma
     // Present new std::vector for use in future chronological
     // Predictors
     virtual void newVector(const T& psi) = 0;
+
+    // Write the cost of the predictor and its effect on the last
+    // solve, which took n_count iterations. Predictors that keep
+    // no statistics write nothing
+    virtual void writeStats(XMLWriter& xml, const std::string& path, int n_count) {}
   };
 
   //! Abstract interface for a Chronological Solution predictor
@@ -170,6 +175,11 @@ namespace Chroma
     // Present new std::vector for use in future chronological
     // Predictors
     virtual void newVector(const multi1d<T>& psi) = 0;
+
+    // Write the cost of the predictor and its effect on the last
+    // solve, which took n_count iterations. Predictors that keep
+    // no statistics write nothing
+    virtual void writeStats(XMLWriter& xml, const std::string& path, int n_count) {}
   };
 
 } // End namespace
@@ -1,13 +1,65 @@
 #include "chromabase.h"
 #include "update/molecdyn/predictor/mre_extrap_predictor.h"
-#include "meas/eig/gramschm.h"
-#include "meas/eig/gramschm_array.h"
 #include "update/molecdyn/predictor/lu_solve.h"
+#include "update/molecdyn/predictor/mre_kernels.h"
 
 
 namespace Chroma 
 { 
-  
+
+  void MREPredictorStats::residual(const Double& chi_norm, const multi1d<DComplex>& a,
+				   const multi1d<DComplex>& c, const multi2d<DComplex>& H)
+  {
+    if (! toBool(chi_norm > Double(0)))
+      return;
+
+    Double r2 = chi_norm;
+    for(int n=0; n < a.size(); ++n)
+    {
+      r2 -= Double(2)*real(conj(a[n])*c[n]);
+      for(int m=0; m < a.size(); ++m)
+	r2 += real(conj(a[n])*H(n,m)*a[m]);
+    }
+
+    rel_resid = toDouble(sqrt(fabs(r2)/chi_norm));
+    QDPIO::cout << "MRE Predictor: predicted || r || / || b || = " << rel_resid << std::endl;
+  }
+
+
+  void MREPredictorStats::report(XMLWriter& xml, const std::string& path, int n_count)
+  {
+    // A solve started from a zero guess is the baseline
+    if (n_predict > 0 && max_nvec == 0)
+    {
+      zero_guess_iters += n_count;
+      ++zero_guess_solves;
+    }
+
+    push(xml, path);
+    write(xml, "NumPredictions", n_predict);
+    write(xml, "PredictTime", predict_secs);
+    write(xml, "NumRegistrations", n_register);
+    write(xml, "RegistrationTime", register_secs);
+    write(xml, "NumVectors", max_nvec);
+    if (rel_resid >= 0)
+      write(xml, "PredictedRelResid", rel_resid);
+
+    if (zero_guess_solves > 0)
+    {
+      double zero_guess = double(zero_guess_iters) / double(zero_guess_solves);
+      write(xml, "ZeroGuessIters", zero_guess);
+      write(xml, "IterSavings", zero_guess - double(n_count));
+    }
+    pop(xml);
+
+    n_predict     = 0;
+    predict_secs  = 0;
+    n_register    = 0;
+    register_secs = 0;
+    max_nvec      = 0;
+    rel_resid     = -1;
+  }
+
   namespace MinimalResidualExtrapolation4DChronoPredictorEnv 
   {
     namespace
@@ -108,6 +160,9 @@ namespace Chroma
 		    const multi1d<LatticeFermion>& chi) 
   {
     START_CODE();
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
 
     int Nvec = chrono_buf->size();
     switch(Nvec) { 
@@ -130,11 +185,33 @@ namespace Chroma
       }
       break;
     }
+
+    swatch.stop();
+    stats.predicted(Nvec, swatch.getTimeInSeconds());
     
     END_CODE();
   }
 
 
+  // Utility functions
+  namespace
+  {
+    //! Normalise a 5D vector given as N5 fields
+    void normalize5D(const std::vector<LatticeFermion*>& x, const Subset& s)
+    {
+      Double norm = norm2(*x[0], s);
+      for(int d5=1; d5 < x.size(); d5++) { 
+	norm += norm2(*x[d5], s);
+      }
+
+      Double root_norm = sqrt(norm);
+      for(int d5=0; d5 < x.size(); d5++) { 
+	(*x[d5])[s] /= root_norm;
+      }
+    }
+  }
+
+
   void 
   MinimalResidualExtrapolation5DChronoPredictor::find_extrap_solution(
 		       	  multi1d<LatticeFermion>& psi,
@@ -150,92 +227,77 @@ namespace Chroma
 
     // Construct an orthonormal basis from the 
     // vectors in the buffer. Stick to notation of paper and call these
-    // v
+    // v. Each is N5 consecutive fields in the lists of pointers.
     multi2d<LatticeFermion> v(Nvec, N5);
+    std::vector<const LatticeFermion*> basis;
     
     for(int i=0; i < Nvec; i++) { 
-      // Zero out the non subsetted part
-      for(int d5=0; d5 < N5; d5++) { 
-	v[i][d5] = zero;
-      }
-
       // Grab the relevant std::vector from the chronobuf
       multi1d<LatticeFermion> tmpvec(N5);
       chrono_buf->get(i, tmpvec);
 
-      if( i == 0 ) { 
-	// First std::vector we just take
-	// Loop over 5th dim
-	for(int d5=0; d5 < N5; d5++) { 
-	  v[i][d5][s] = tmpvec[d5];
-	}
-      }
-      else { 
-	// i-th std::vector. Orthogonalise against i-1 previous
-	// std::vector, but i is an index running from 0. So I need
-	// to pass i+1-1=i as the number of vectors to orthog against
-	//
-	// This is a very dumb GramSchmidt process and possibly
-	// unstable, however apparently (according to the paper)
-	// this is OK.
-	GramSchmArray(tmpvec, v, i, s);
-
-	// Loop over 5th dim
-	for(int d5=0; d5 < N5; d5++) {
-	  v[i][d5][s] = tmpvec[d5];
-	}
+      std::vector<LatticeFermion*> x(N5);
+      for(int d5=0; d5 < N5; d5++) { 
+	// Zero out the non subsetted part
+	v[i][d5] = zero;
+	v[i][d5][s] = tmpvec[d5];
+	x[d5] = &(v[i][d5]);
       }
+      std::vector<const LatticeFermion*> w(x.begin(), x.end());
 
-      // Normalise v[i]
-      Double norm = norm2(v[i][0], s);
+      // Normalise, orthogonalise against the i previous vectors
+      // by classical Gram Schmidt done twice with blocked passes,
+      // and normalise again
+      normalize5D(x, s);
 
-      // Loop over 5th dim and accumulate
-      for(int d5=1; d5 < N5; d5++) { 
-	norm += norm2(v[i][d5], s);
-      }
+      for(int pass=0; pass < 2 && i > 0; pass++) {
+	multi2d<DComplex> ip;
+	MREKernels::inner_products(ip, basis, w, N5, s);
 
-      // Square root
-      Double root_norm = sqrt(norm);
-
-      // Normalise -- Loop over 5th dim
-      for(int d5=0; d5 < N5; d5++) { 
-	v[i][d5][s] /= root_norm;
+	multi1d<DComplex> coeff(i);
+	for(int j=0; j < i; j++) {
+	  coeff[j] = -ip(j,0);
+	}
+	MREKernels::caxpy(x, coeff, basis, s);
       }
 
-			 
+      normalize5D(x, s);
+      basis.insert(basis.end(), w.begin(), w.end());
     }
 
-    // Now I need to form G_n m = v_[n]^{dag} A v[m]
-    multi2d<DComplex> G(Nvec,Nvec);
+    // Apply the 5D operator to the basis
+    multi1d< multi1d<LatticeFermion> > Av(Nvec);
+    std::vector<const LatticeFermion*> w;
 
     for(int m = 0 ; m < Nvec; m++) { 
-      multi1d<LatticeFermion> tmpvec(N5);
-
-      // 5D Matrix application
-      A(tmpvec, v[m], PLUS);
-
-
-      for(int n = 0; n < Nvec; n++) { 
-
-	// Compute 5D ioner product
-	G(n,m) = innerProduct(v[n][0], tmpvec[0], s);
-	for(int d5=1; d5 < N5; d5++) {
-	  G(n,m) += innerProduct(v[n][d5], tmpvec[d5], s);
-	}
+      Av[m].resize(N5);
+      A(Av[m], v[m], PLUS);
 
+      for(int d5=0; d5 < N5; d5++) {
+	w.push_back(&(Av[m][d5]));
       }
     }
+    for(int d5=0; d5 < N5; d5++) {
+      w.push_back(&(chi[d5]));
+    }
 
-    // Now I need to form b_n = v[n]^{dag} chi
-    multi1d<DComplex> b(Nvec);
+    // One pass for G_nm = <v_n|A v_m>, b_n = <v_n|chi>,
+    // H_nm = <A v_n|A v_m>, c_n = <A v_n|chi> and |chi|^2
+    std::vector<const LatticeFermion*> vw(basis);
+    vw.insert(vw.end(), w.begin(), w.end());
 
-    for(int n = 0; n < Nvec; n++) { 
+    multi2d<DComplex> ip;
+    MREKernels::inner_products(ip, vw, w, N5, s);
 
-      // Loop over 5th Dim
-      b[n] = innerProduct(v[n][0], chi[0], s);
-      for(int d5=1; d5 < N5; d5++) { 
-	b[n] += innerProduct(v[n][d5], chi[d5], s);
+    multi2d<DComplex> G(Nvec,Nvec), H(Nvec,Nvec);
+    multi1d<DComplex> b(Nvec), c(Nvec);
+    for(int n = 0; n < Nvec; n++) { 
+      for(int m = 0; m < Nvec; m++) { 
+	G(n,m) = ip(n,m);
+	H(n,m) = ip(Nvec+n,m);
       }
+      b[n] = ip(n,Nvec);
+      c[n] = ip(Nvec+n,Nvec);
     }
 
     // Solve G_nm a_m = b_n:
@@ -244,42 +306,15 @@ namespace Chroma
     multi1d<DComplex> a(Nvec);
 
     LUSolve(a, G, b);
-
-#if 0
-    // Check solution 
-    multi1d<DComplex> Ga(Nvec);
-
-
-    for(int i=0; i < Nvec; i++) { 
-      Ga[i] = G(i,0)*a[0];
-      for(int j=1; j < Nvec; j++) { 
-	Ga[i] += G(i,j)*a[j];
-      }
-    }
-
-    multi1d<DComplex> r(Nvec);
-    for(int i=0; i < Nvec; i++) { 
-      r[i] = b[i]-Ga[i];
-    }
-
-    QDPIO::cout << "Constraint Eq Solution Check" << std::endl;
-    for(int i=0; i < Nvec; i++) { 
-      QDPIO::cout << "   r[ " << i << "] = " << r[i] << std::endl;
-    }
-#endif
+    stats.residual(real(ip(2*Nvec,Nvec)), a, c, H);
 
     // Create the lnear combination
-
-    // First piece
+    std::vector<LatticeFermion*> x(N5);
     for(int d5=0; d5 < N5; d5++) { 
-      psi[d5][s] = Complex(a[0])*v[0][d5];
-    
-
-      for(int n=1; n < Nvec; n++) { 
-	psi[d5][s] += Complex(a[n])*v[n][d5];
-      }
-
+      psi[d5][s] = zero;
+      x[d5] = &(psi[d5]);
     }
+    MREKernels::caxpy(x, a, basis, s);
     
     END_CODE();
   }
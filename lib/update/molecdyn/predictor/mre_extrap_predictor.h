@@ -14,7 +14,9 @@
 #include "update/molecdyn/predictor/chrono_predictor_factory.h"
 #include "update/molecdyn/predictor/circular_buffer.h"
 #include "update/molecdyn/predictor/lu_solve.h"
+#include "update/molecdyn/predictor/mre_kernels.h"
 #include "meas/eig/gramschm.h"
+#include <algorithm>
 
 namespace Chroma 
 { 
@@ -26,8 +28,65 @@ namespace Chroma
     bool registerAll();
   }
 
+  //! Cost of a minimal residual predictor and its effect on the solves
+  /*! @ingroup predictor
+   *
+   * Times and counts accumulate until report(). Solves started with no
+   * vectors in the buffers give a baseline for the iterations saved by
+   * the predictions made later.
+   */
+  struct MREPredictorStats
+  {
+    MREPredictorStats() : n_predict(0), predict_secs(0), n_register(0), register_secs(0),
+			  max_nvec(0), rel_resid(-1), zero_guess_iters(0), zero_guess_solves(0) {}
+
+    //! Account for a prediction from nvec vectors
+    void predicted(int nvec, double secs)
+    {
+      ++n_predict;
+      predict_secs += secs;
+      max_nvec = std::max(max_nvec, nvec);
+    }
+
+    //! Account for the registration of a new solution
+    void registered(double secs)
+    {
+      ++n_register;
+      register_secs += secs;
+    }
+
+    //! Record the residual of psi = sum_m a_m v_m for the system A psi = chi
+    /*! With c_m = <A v_m|chi> and H(n,m) = <A v_n|A v_m> its square is
+     *  |chi|^2 - 2 Re a^dag c + a^dag H a, so no operator is applied */
+    void residual(const Double& chi_norm, const multi1d<DComplex>& a,
+		  const multi1d<DComplex>& c, const multi2d<DComplex>& H);
+
+    //! Write the statistics for a solve of n_count iterations and start afresh
+    void report(XMLWriter& xml, const std::string& path, int n_count);
+
+    int     n_predict;
+    double  predict_secs;
+    int     n_register;
+    double  register_secs;
+    int     max_nvec;            /*!< most vectors used by a prediction */
+    double  rel_resid;           /*!< |chi - A psi|/|chi| of the last prediction, -1 if unknown */
+    long    zero_guess_iters;
+    int     zero_guess_solves;
+  };
+
+
   //! Minimal residual predictor
-  /*! @ingroup predictor */
+  /*! @ingroup predictor
+   *
+   * The two step interface keeps orthonormal buffers of solutions v_n and
+   * of M v_n, together with the projections G(n,m) = <v_n|M v_m> and
+   * H(n,m) = <M v_n|M v_m>. These are updated as vectors are pushed and
+   * evicted, so a prediction only needs one blocked pass for <v_n|chi>.
+   * H gives the residual of the prediction without applying M.
+   *
+   * The interface taking the operator at prediction time keeps the raw
+   * solutions, and has to build the basis and apply M to it each time.
+   */
   template<typename T>
   class MinimalResidualExtrapolation4DChronoPredictor  
     : public AbsTwoStepChronologicalPredictor4D<T> 
@@ -39,205 +98,240 @@ namespace Chroma
     Handle< CircularBuffer<T> > chrono_bufY;
     Handle< CircularBuffer<T> > chrono_bufMY;
 
-  void 
-  find_extrap_solutionM(
-			T& psi,
-			const T& chi,
-			const CircularBuffer<T>& chrono_buf, 
-			const CircularBuffer<T>& chrono_bufM,
-			const Subset& s
-			) const
+    //! Projections onto the buffers, indexed like the buffers
+    multi2d<DComplex> GX, HX;
+    multi2d<DComplex> GY, HY;
+
+    mutable MREPredictorStats stats;
+
+    //! Pointers to the first n vectors of a buffer
+    static std::vector<const T*> vectors(const CircularBuffer<T>& buf, int n)
+    {
+      std::vector<const T*> v(n);
+      for(int i=0; i < n; ++i)
+	v[i] = &(buf[i]);
+      return v;
+    }
+
+    void
+    find_extrap_solutionM(
+			  T& psi,
+			  const T& chi,
+			  const CircularBuffer<T>& chrono_buf,
+			  const CircularBuffer<T>& chrono_bufM,
+			  const multi2d<DComplex>& Gbuf,
+			  const multi2d<DComplex>& Hbuf,
+			  const Subset& s
+			  ) const
     {
       START_CODE();
-      
+
       int Nvec = chrono_buf.size();
-      
-      
-      // Now I need to form G_n m = v_[n]^{dag} A v[m]
-      multi2d<DComplex> G(Nvec,Nvec);
-      
-      for(int m = 0 ; m < Nvec; m++) { 
-	for(int n = 0; n < Nvec; n++) { 
-	  G(n,m) = innerProduct(chrono_buf[n], chrono_bufM[m], s);
+
+      // One pass for b_n = <v_n|chi>, c_n = <M v_n|chi> and |chi|^2
+      std::vector<const T*> v = vectors(chrono_buf, Nvec);
+      std::vector<const T*> mv = vectors(chrono_bufM, Nvec);
+      v.insert(v.end(), mv.begin(), mv.end());
+      v.push_back(&chi);
+
+      multi2d<DComplex> ip;
+      MREKernels::inner_products(ip, v, std::vector<const T*>(1, &chi), 1, s);
+
+      multi1d<DComplex> b(Nvec), c(Nvec);
+      multi2d<DComplex> G(Nvec,Nvec), H(Nvec,Nvec);
+      for(int n = 0; n < Nvec; n++) {
+	b[n] = ip(n,0);
+	c[n] = ip(Nvec+n,0);
+
+	for(int m = 0; m < Nvec; m++) {
+	  G(n,m) = Gbuf(n,m);
+	  H(n,m) = Hbuf(n,m);
 	}
       }
-      
-      // Now I need to form b_n = v[n]^{dag} chi
-      multi1d<DComplex> b(Nvec);
-      
-      for(int n = 0; n < Nvec; n++) { 
-	b[n] = innerProduct(chrono_buf[n], chi, s);
-      }
-      
-      // Solve G_nm a_m = b_n:
-      
-      // First LU decompose G in place 
+
+      // Solve G_nm a_m = b_n
       multi1d<DComplex> a(Nvec);
-      
       LUSolve(a, G, b);
-      
-      // Check solution 
-      multi1d<DComplex> Ga(Nvec);
-      
-      for(int i=0; i < Nvec; i++) { 
-	Ga[i] = G(i,0)*a[0];
-	for(int j=1; j < Nvec; j++) { 
-	  Ga[i] += G(i,j)*a[j];
-	}
-      }
-      
-      multi1d<DComplex> r(Nvec);
-      for(int i=0; i < Nvec; i++) { 
-	r[i] = b[i]-Ga[i];
-      }
-      
-      // Create teh lnear combination
-      psi[s] = Complex(a[0])*chrono_buf[0];
-      for(int n=1; n < Nvec; n++) { 
-	psi[s] += Complex(a[n])*chrono_buf[n];
-      }
-      
-      
-      
+      stats.residual(real(ip(2*Nvec,0)), a, c, H);
+
+      // Create the linear combination
+      psi[s] = zero;
+      v.resize(Nvec);
+      MREKernels::caxpy(std::vector<T*>(1, &psi), a, v, s);
+
       END_CODE();
     }
 
 
-  void 
-  find_extrap_solution(
-		       T& psi,
-		       const LinearOperator<T>& M,
-		       const T& chi,
-		       const Handle<CircularBuffer<T> >& chrono_buf, 
-		       enum PlusMinus isign) 
+    void
+    find_extrap_solution(
+			 T& psi,
+			 const LinearOperator<T>& M,
+			 const T& chi,
+			 const Handle<CircularBuffer<T> >& chrono_buf,
+			 enum PlusMinus isign)
     {
       START_CODE();
-      
+
       const Subset& s= M.subset();
-      
-      
-#if 0
-      {
-	T r;
-	r[s] = chi;
-	T tmp;
-	M(tmp, psi, isign);
-	r[s] -= tmp;
-	Double norm_r = sqrt(norm2(r,s));
-	Double norm_chi = sqrt(norm2(chi,s));
-	QDPIO::cout << "MRE Predictor: before prediction || r || / || b || =" << norm_r/norm_chi << std::endl;
-      }
-#endif
-      
+
       int Nvec = chrono_buf->size();
-      
-      
-      // Construct an orthonormal basis from the 
+
+      // Construct an orthonormal basis from the
       // vectors in the buffer. Stick to notation of paper and call these
       // v
       multi1d<T> v(Nvec);
-      
-      for(int i=0; i < Nvec; i++) { 
+      std::vector<const T*> basis;
+
+      for(int i=0; i < Nvec; i++) {
 	// Zero out the non subsetted part
 	v[i] = zero;
-	
-	// Grab the relevant std::vector from the chronobuf
-	T tmpvec;
-	chrono_buf->get(i, tmpvec);
-	
-	if( i == 0 ) { 
-	  // First std::vector we just take
-	  v[i][s] = tmpvec;
-	}
-	else { 
-	  // i-th std::vector. Orthogonalise against i-1 previous
-	  // std::vector, but i is an index running from 0. So I need
-	  // to pass i+1-1=i as the number of vectors to orthog against
-	  //
-	  // This is a very dumb GramSchmidt process and possibly
-	  // unstable, however apparently (according to the paper)
-	  // this is OK.
-	  GramSchm(tmpvec, v, i, s);
-	  v[i][s] = tmpvec;
-	}
-	// QDPIO::cout << "Norm v[i] = " << norm2(v[i],s) << std::endl;
-	// Normalise v[i]
-	Double norm = sqrt(norm2(v[i], s));
-	v[i][s] /= norm;
-	
+	v[i][s] = (*chrono_buf)[i];
+
+	// Orthonormalise against the i previous vectors
+	orthonormalize(v[i], basis, s);
+	basis.push_back(&(v[i]));
       }
-      
-      // Now I need to form G_n m = v_[n]^{dag} A v[m]
-      multi2d<DComplex> G(Nvec,Nvec);
-      
-      for(int m = 0 ; m < Nvec; m++) { 
-	T tmpvec;
-	M(tmpvec, v[m], isign);
-	
-	for(int n = 0; n < Nvec; n++) { 
-	  G(n,m) = innerProduct(v[n], tmpvec, s);
-	}
+
+      // Apply the operator to the basis
+      multi1d<T> Av(Nvec);
+      std::vector<const T*> w;
+
+      for(int m = 0 ; m < Nvec; m++) {
+	M(Av[m], v[m], isign);
+	w.push_back(&(Av[m]));
       }
-      
-      // Now I need to form b_n = v[n]^{dag} chi
-      multi1d<DComplex> b(Nvec);
-      
-      for(int n = 0; n < Nvec; n++) { 
-	b[n] = innerProduct(v[n], chi, s);
+      w.push_back(&chi);
+
+      // One pass for G_nm = <v_n|A v_m>, b_n = <v_n|chi>,
+      // H_nm = <A v_n|A v_m>, c_n = <A v_n|chi> and |chi|^2
+      std::vector<const T*> vw(basis);
+      vw.insert(vw.end(), w.begin(), w.end());
+
+      multi2d<DComplex> ip;
+      MREKernels::inner_products(ip, vw, w, 1, s);
+
+      multi2d<DComplex> G(Nvec,Nvec), H(Nvec,Nvec);
+      multi1d<DComplex> b(Nvec), c(Nvec);
+      for(int n = 0; n < Nvec; n++) {
+	for(int m = 0; m < Nvec; m++) {
+	  G(n,m) = ip(n,m);
+	  H(n,m) = ip(Nvec+n,m);
+	}
+	b[n] = ip(n,Nvec);
+	c[n] = ip(Nvec+n,Nvec);
       }
-      
-      // Solve G_nm a_m = b_n:
-      
-      // First LU decompose G in place 
+
+      // Solve G_nm a_m = b_n
       multi1d<DComplex> a(Nvec);
-      
       LUSolve(a, G, b);
-      
-      // Check solution 
-      multi1d<DComplex> Ga(Nvec);
-      
-      for(int i=0; i < Nvec; i++) { 
-	Ga[i] = G(i,0)*a[0];
-	for(int j=1; j < Nvec; j++) { 
-	  Ga[i] += G(i,j)*a[j];
+      stats.residual(real(ip(2*Nvec,Nvec)), a, c, H);
+
+      // Create the linear combination
+      psi[s] = zero;
+      MREKernels::caxpy(std::vector<T*>(1, &psi), a, basis, s);
+
+      END_CODE();
+    }
+
+
+    //! Orthonormalise x against an orthonormal basis
+    /*! Classical Gram Schmidt done twice, each time in a single blocked pass */
+    void orthonormalize(T& x, const std::vector<const T*>& basis, const Subset& s) const
+    {
+      // Normalize as we will make it orthogonal to other normalized vectors
+      // This is for stability and the correct thing to do for an empty basis
+      Double nx= Double(1)/sqrt(norm2(x,s));
+      x[s] *= nx;
+
+      if (basis.size() > 0)
+      {
+	std::vector<const T*> w(1, &x);
+	std::vector<T*> xv(1, &x);
+	multi1d<DComplex> coeff(basis.size());
+
+	for(int pass=0; pass < 2; ++pass)
+	{
+	  multi2d<DComplex> ip;
+	  MREKernels::inner_products(ip, basis, w, 1, s);
+
+	  for(int i=0; i < basis.size(); ++i)
+	    coeff[i] = -ip(i,0);
+
+	  MREKernels::caxpy(xv, coeff, basis, s);
 	}
       }
-      
-      multi1d<DComplex> r(Nvec);
-      for(int i=0; i < Nvec; i++) { 
-	r[i] = b[i]-Ga[i];
-      }
-      
-#if 0
-      QDPIO::cout << "Constraint Eq Solution Check" << std::endl;
-      for(int i=0; i < Nvec; i++) { 
-	QDPIO::cout << "   r[ " << i << "] = " << r[i] << std::endl;
+
+      // RE-normalize
+      nx= Double(1)/sqrt(norm2(x,s));
+      x[s] *= nx;
+    }
+
+
+    //! Push x and M x into the buffers and bring G and H up to date
+    void pushProjected(CircularBuffer<T>& buf, CircularBuffer<T>& bufM,
+		       multi2d<DComplex>& G, multi2d<DComplex>& H,
+		       const T& x_in, const LinearOperator<T>& M, enum PlusMinus isign)
+    {
+      const Subset& s = M.subset();
+
+      // If the buffer is full the least recent vector is kicked out
+      // on the push, so only the others are kept
+      int Nold = std::min(buf.size(), buf.sizeMax()-1);
+
+      // Orthonormalize x against the vectors that stay
+      T x = x_in;
+      std::vector<const T*> v = vectors(buf, Nold);
+      orthonormalize(x, v, s);
+
+      // Apply M
+      T mx = zero;
+      M(mx, x, isign);
+
+      // The new column <v_n|M x> and the check <v_n|x> in one pass,
+      // then the new row from <M v_m|M x>, <M v_m|x> in another
+      std::vector<const T*> w(2);
+      w[0] = &mx;
+      w[1] = &x;
+
+      multi2d<DComplex> col;
+      if (Nold > 0)
+	MREKernels::inner_products(col, v, w, 1, s);
+
+      std::vector<const T*> mv = vectors(bufM, Nold);
+      mv.push_back(&mx);
+
+      multi2d<DComplex> row;
+      MREKernels::inner_products(row, mv, w, 1, s);
+
+      for(int n=0; n < Nold; ++n) {
+	if( toBool( fabs(real(col(n,1))) > Double(1.0e-12) ) ||
+	    toBool( fabs(imag(col(n,1))) > Double(1.0e-12) ) ) {
+	  QDPIO::cout << "Lack of orthogonality: < v["<<n+1<<"] | v[0] > = " << col(n,1) << std::endl;
+	  QDP_abort(1);
+	}
       }
-#endif
-      
-      // Create teh lnear combination
-      psi[s] = Complex(a[0])*v[0];
-      for(int n=1; n < Nvec; n++) { 
-	psi[s] += Complex(a[n])*v[n];
+
+      // Age the kept entries by one
+      for(int n=Nold-1; n >= 0; --n) {
+	for(int m=Nold-1; m >= 0; --m) {
+	  G(n+1,m+1) = G(n,m);
+	  H(n+1,m+1) = H(n,m);
+	}
       }
-      
-      
-#if 0
-      {
-	T r;
-	r[s] = chi;
-	T tmp;
-	M(tmp, psi, isign);
-	r[s] -= tmp;
-	Double norm_r = sqrt(norm2(r,s));
-	Double norm_chi = sqrt(norm2(chi,s));
-	QDPIO::cout << "MRE Predictor: after prediction || r || / || b || =" << norm_r/norm_chi << std::endl;
+
+      G(0,0) = conj(row(Nold,1));
+      H(0,0) = row(Nold,0);
+      for(int m=0; m < Nold; ++m) {
+	G(0,m+1) = conj(row(m,1));
+	G(m+1,0) = col(m,0);
+	H(0,m+1) = conj(row(m,0));
+	H(m+1,0) = row(m,0);
       }
-#endif
-      
-      END_CODE();
-    }
 
+      buf.push(x);
+      bufM.push(mx);
+    }
 
 
   public:
@@ -246,7 +340,9 @@ namespace Chroma
       chrono_bufX(new CircularBuffer<T>(max_chrono)),
       chrono_bufY(new CircularBuffer<T>(max_chrono)),
       chrono_bufMX(new CircularBuffer<T>(max_chrono)),
-      chrono_bufMY(new CircularBuffer<T>(max_chrono)){}
+      chrono_bufMY(new CircularBuffer<T>(max_chrono)),
+      GX(max_chrono, max_chrono), HX(max_chrono, max_chrono),
+      GY(max_chrono, max_chrono), HY(max_chrono, max_chrono) {}
 
 
     void reset(void) {
@@ -288,12 +384,13 @@ namespace Chroma
 
           // Expect M is either  MdagM if we use chi                                                                                                                                 
           // or                   M    if we minimize against Y                                                                                                                      
-          find_extrap_solutionM(X,chi, (*chrono_bufX), (*chrono_bufMX), s);
+          find_extrap_solutionM(X,chi, (*chrono_bufX), (*chrono_bufMX), GX, HX, s);
         }
         break;
       }
 
       swatch.stop();
+      stats.predicted(Nvec, swatch.getTimeInSeconds());
       QDPIO::cout << "MRE_PREDICT_X_TIME = " << swatch.getTimeInSeconds() << " s" << std::endl;
 
       END_CODE();
@@ -326,12 +423,13 @@ namespace Chroma
 
           // Expect M is either  MdagM if we use chi                                                                                                                                 
           // or                   M    if we minimize against Y                                                                                                                      
-          find_extrap_solutionM(Y,chi, (*chrono_bufY), (*chrono_bufMY), s);
+          find_extrap_solutionM(Y,chi, (*chrono_bufY), (*chrono_bufMY), GY, HY, s);
         }
         break;
       }
 
       swatch.stop();
+      stats.predicted(Nvec, swatch.getTimeInSeconds());
       QDPIO::cout << "MRE_PREDICT_Y_TIME = " << swatch.getTimeInSeconds() << " s" << std::endl;
 
       END_CODE();
@@ -372,6 +470,7 @@ namespace Chroma
       }
       
       swatch.stop();
+      stats.predicted(Nvec, swatch.getTimeInSeconds());
       QDPIO::cout << "MRE_PREDICT_X_TIME = " << swatch.getTimeInSeconds() << " s" << std::endl;
       
       END_CODE();
@@ -412,74 +511,12 @@ namespace Chroma
       }
       
       swatch.stop();
+      stats.predicted(Nvec, swatch.getTimeInSeconds());
       QDPIO::cout << "MRE_PREDICT_Y_TIME = " << swatch.getTimeInSeconds() << " s" << std::endl;
       
       END_CODE();
     }
 
-    void checkOrthoNormal( const CircularBuffer<T>& buffer, const Subset& s) const
-    {
-      for(int i=0; i < buffer.size(); ++i) { 
-	for(int j=0; j < buffer.size(); ++j ) {
-	  DComplex ip = innerProduct(buffer[i], buffer[j], s);
-	  if( i==j ) {
-	    if( toBool( fabs(Double(1)-real(ip)) > Double(1.0e-12) ) ) {
-	      QDPIO::cout << "Lack of normalization: < v["<<i<<"] | v[" << j <<"] > = " << ip << std::endl;
-	      QDP_abort(1);
-	    }
-	    if( toBool( fabs(imag(ip)) > Double(1.0e-12) ) ) {
-	      QDPIO::cout << "Lack of normalization: < v["<<i<<"] | v[" << j <<"] > = " << ip << std::endl;
-
-	      QDP_abort(1);
-	    }
-	  }
-	  else {
-	    if( toBool( fabs(real(ip)) > Double(1.0e-12) ) ) {
-	      QDPIO::cout << "Lack of orthogonality: < v["<<i<<"] | v[" << j <<"] > = " << ip << std::endl;
-	      QDP_abort(1);
-	    }
-	    if( toBool( fabs(imag(ip)) > Double(1.0e-12) ) ) {
-	      QDPIO::cout << "Lack of orthogonality: < v["<<i<<"] | v[" << j <<"] > = " << ip << std::endl;
-	      QDP_abort(1);
-	    }
-	  }
-	}
-      }
-    }
-
-    // Orthonormalize x against previous buffer vectors
-    // Implication is that X will be pushed soon.
-    // So if the buffer is full N elements only orthogonalize against the last N-1
-    void orthonormPrevious(const CircularBuffer<T>& buffer, T& x, const Subset& s) const
-    {
-      // Normalize as we will make it orthogonal to other normalized vectors
-      // This is for stability and the correct thing to do for an empty buffer
-      // or a buffer with 1 entry (which will get pushed down)
-      Double nx= Double(1)/sqrt(norm2(x,s));
-      x[s] *= nx;
-
-      // If buffer doesn't yet contain the maximum number
-      // of vectors, the last vector will not be kicked out
-      // so orthog against all existing vectors
-
-      // Gram Schmidt against previous
-      for(int i=0; i < buffer.size(); ++i) {
-	DComplex iprod = innerProduct(buffer[i],x,s);
-	x[s] -= iprod*buffer[i];
-      }
-
-      // 2nd Gram Schmidt against previous
-      for(int i=0; i < buffer.size(); ++i) {
-	DComplex iprod = innerProduct(buffer[i],x,s);
-	x[s] -= iprod*buffer[i];
-      }
-
-      // RE-normalize
-      nx= Double(1)/sqrt(norm2(x,s));
-      x[s] *= nx;
-    }
-
-
     void newXVector(const T& X_in, const LinearOperator<T>& M) override
     {
       START_CODE();
@@ -488,24 +525,13 @@ namespace Chroma
       swatch.start();
       
       QDPIO::cout << "MREPredictor: registering new X solution. " << std::endl;
-      T X = X_in;
-
-      // Orthonormalize X against current vectors
-      orthonormPrevious(*chrono_bufX, X, M.subset());
-
-      // Push it into the buffer
-      chrono_bufX->push(X);
 
-      checkOrthoNormal(*chrono_bufX, M.subset());
-
-      // Apply M
-      T tmpvec=zero;
-
-      M(tmpvec,X,PLUS);
-      chrono_bufMX->push(tmpvec);
+      // Orthonormalize X against the vectors kept, push it and M X
+      pushProjected(*chrono_bufX, *chrono_bufMX, GX, HX, X_in, M, PLUS);
       
       QDPIO::cout << "MREPredictor: number of X vectors stored is = " << chrono_bufX->size() << " and MX vectors = " << chrono_bufMX->size() << std::endl;
       swatch.stop();
+      stats.registered(swatch.getTimeInSeconds());
       QDPIO::cout << "MRE Predictor: X_VEC_REGISTRATION_TIME = " << swatch.getTimeInSeconds() << " sec. \n";
 
       END_CODE();
@@ -548,23 +574,13 @@ namespace Chroma
       swatch.start();
       
       QDPIO::cout << "MREPredictor: registering new Y solution. " << std::endl;
-      T Y=Y_in;
-
-      // Orthonormalize Y against current vectors
-      orthonormPrevious(*chrono_bufY, Y, M.subset());
-
-      // Push it into the buffer
-      chrono_bufY->push(Y);
-
-      checkOrthoNormal(*chrono_bufY, M.subset());
 
-      // Apply M
-      T tmpvec=zero;
-      M(tmpvec,Y,MINUS);
-      chrono_bufMY->push(tmpvec);
+      // Orthonormalize Y against the vectors kept, push it and M^dag Y
+      pushProjected(*chrono_bufY, *chrono_bufMY, GY, HY, Y_in, M, MINUS);
       
       QDPIO::cout << "MREPredictor: number of Y vectors stored is = " << chrono_bufY->size() << " and MY vectors = " << chrono_bufMY->size() << std::endl;
       swatch.stop();
+      stats.registered(swatch.getTimeInSeconds());
       QDPIO::cout << "MRE Predictor: Y_VEC_REGISTRATION_TIME = " << swatch.getTimeInSeconds() << " sec. \n";
 
       END_CODE();
@@ -580,6 +596,12 @@ namespace Chroma
       chrono_bufY->replaceHead(v);
     }
 
+    //! Report the predictor cost for a solve of n_count iterations
+    void writeStats(XMLWriter& xml, const std::string& path, int n_count) override
+    {
+      stats.report(xml, path, n_count);
+    }
+
 
 
 
@@ -603,6 +625,7 @@ namespace Chroma
   private: 
     Handle< CircularBufferArray<LatticeFermion>  > chrono_buf;
     const int N5;
+    MREPredictorStats stats;
 
     void find_extrap_solution(multi1d<LatticeFermion>& psi, 
 			      const LinearOperatorArray<LatticeFermion>& A,
@@ -615,7 +638,7 @@ namespace Chroma
     ~MinimalResidualExtrapolation5DChronoPredictor(void) {}
     
     // Copying
-    MinimalResidualExtrapolation5DChronoPredictor(const MinimalResidualExtrapolation5DChronoPredictor& p) : chrono_buf(p.chrono_buf), N5(p.N5) {}
+    MinimalResidualExtrapolation5DChronoPredictor(const MinimalResidualExtrapolation5DChronoPredictor& p) : chrono_buf(p.chrono_buf), N5(p.N5), stats(p.stats) {}
 
     // Zero out psi -- it is a zero guess after all
     void operator()(multi1d<LatticeFermion>& psi,
@@ -634,13 +657,26 @@ namespace Chroma
     {
       START_CODE();
 
+      StopWatch swatch;
+      swatch.reset();
+      swatch.start();
+
       QDPIO::cout << "MRE Predictor: registering new solution. " << std::endl;
       chrono_buf->push(psi);
       QDPIO::cout << "MRE Predictor: number of vectors stored is = " << chrono_buf->size() << std::endl;
+
+      swatch.stop();
+      stats.registered(swatch.getTimeInSeconds());
     
       END_CODE();
     }
 
+    //! Report the predictor cost for a solve of n_count iterations
+    void writeStats(XMLWriter& xml, const std::string& path, int n_count) override
+    {
+      stats.report(xml, path, n_count);
+    }
+
   };
   
 } // End Namespace Chroma
@@ -0,0 +1,222 @@
+/*! \file
+ * \brief Blocked multi-vector kernels for the minimal residual predictors
+ */
+
+#include "update/molecdyn/predictor/mre_kernels.h"
+
+#ifndef QDP_IS_QDPJIT
+
+namespace Chroma
+{
+  namespace MREKernels
+  {
+    // Utility functions
+    namespace
+    {
+      //! Reals per site of a lattice fermion
+      const int fermion_atom = Ns*Nc*2;
+
+      template<typename REAL>
+      struct inner_products_arg
+      {
+	const int*          tab;     /*!< the site table */
+	const REAL* const*  v;
+	const REAL* const*  w;
+	int                 nv;
+	int                 nw;
+	int                 n5;
+	int                 stride;  /*!< reals of acc per thread */
+	REAL64*             acc;     /*!< [thread][n][k][re,im] */
+      };
+
+      template<typename REAL>
+      struct caxpy_arg
+      {
+	const int*          tab;
+	REAL* const*        x;
+	const REAL* const*  v;
+	const REAL64*       c;       /*!< [n][re,im] */
+	int                 nv;
+	int                 n5;
+      };
+
+      //! Partial <v_n|w_k> over the sites [lo,hi) of the table
+      template<typename REAL>
+      void innerProductsKernel(int lo, int hi, int my_id, inner_products_arg<REAL>* a)
+      {
+	const int nv = a->nv;
+	const int nw = a->nw;
+	const int n5 = a->n5;
+	REAL64* acc = a->acc + size_t(a->stride)*my_id;
+
+	for(int j=lo; j < hi; ++j)
+	{
+	  size_t off = size_t(fermion_atom)*a->tab[j];
+
+	  for(int n=0; n < nv; ++n)
+	  {
+	    for(int k=0; k < nw; ++k)
+	    {
+	      REAL64 re = 0, im = 0;
+
+	      for(int d5=0; d5 < n5; ++d5)
+	      {
+		const REAL* vp = a->v[n*n5+d5] + off;
+		const REAL* wp = a->w[k*n5+d5] + off;
+
+		for(int i=0; i < fermion_atom; i += 2)
+		{
+		  re += REAL64(vp[i])*REAL64(wp[i])   + REAL64(vp[i+1])*REAL64(wp[i+1]);
+		  im += REAL64(vp[i])*REAL64(wp[i+1]) - REAL64(vp[i+1])*REAL64(wp[i]);
+		}
+	      }
+
+	      acc[2*(n*nw+k)]   += re;
+	      acc[2*(n*nw+k)+1] += im;
+	    }
+	  }
+	}
+      }
+
+      //! x += sum_n c[n] v_n over the sites [lo,hi) of the table
+      template<typename REAL>
+      void caxpyKernel(int lo, int hi, int my_id, caxpy_arg<REAL>* a)
+      {
+	const int n5 = a->n5;
+
+	for(int j=lo; j < hi; ++j)
+	{
+	  size_t off = size_t(fermion_atom)*a->tab[j];
+
+	  for(int d5=0; d5 < n5; ++d5)
+	  {
+	    REAL* xp = a->x[d5] + off;
+
+	    for(int n=0; n < a->nv; ++n)
+	    {
+	      const REAL* vp = a->v[n*n5+d5] + off;
+	      const REAL cr = a->c[2*n];
+	      const REAL ci = a->c[2*n+1];
+
+	      for(int i=0; i < fermion_atom; i += 2)
+	      {
+		REAL vr = vp[i], vi = vp[i+1];
+		xp[i]   += cr*vr - ci*vi;
+		xp[i+1] += cr*vi + ci*vr;
+	      }
+	    }
+	  }
+	}
+      }
+
+      //! The first real of a field
+      template<typename REAL, typename T>
+      REAL* firstReal(const T& x)
+      {
+	return (REAL*)&(x.elem(0).elem(0).elem(0).real());
+      }
+
+      template<typename REAL, typename T>
+      void innerProductsImpl(multi2d<DComplex>& res,
+			     const std::vector<const T*>& v, const std::vector<const T*>& w,
+			     int n5, const Subset& s)
+      {
+	int nv = v.size() / n5;
+	int nw = w.size() / n5;
+	res.resize(nv, nw);
+
+	int stride = ((2*nv*nw + 7) / 8) * 8;
+	std::vector<REAL64> acc(size_t(stride)*qdpNumThreads(), 0.0);
+
+	std::vector<const REAL*> v_ptr(v.size()), w_ptr(w.size());
+	for(int i=0; i < v.size(); ++i)
+	  v_ptr[i] = firstReal<REAL>(*v[i]);
+	for(int i=0; i < w.size(); ++i)
+	  w_ptr[i] = firstReal<REAL>(*w[i]);
+
+	int len = s.numSiteTable();
+	if (len > 0 && nv > 0 && nw > 0)
+	{
+	  inner_products_arg<REAL> arg = {s.siteTable().slice(), &(v_ptr[0]), &(w_ptr[0]),
+					  nv, nw, n5, stride, &(acc[0])};
+	  dispatch_to_threads(len, arg, innerProductsKernel<REAL>);
+	}
+
+	// Sum over threads, then over nodes in one go
+	for(int t=1; t < qdpNumThreads(); ++t)
+	  for(int i=0; i < 2*nv*nw; ++i)
+	    acc[i] += acc[size_t(stride)*t + i];
+
+	if (nv*nw > 0)
+	  QDPInternal::globalSumArray(&(acc[0]), 2*nv*nw);
+
+	for(int n=0; n < nv; ++n)
+	  for(int k=0; k < nw; ++k)
+	    res(n,k) = cmplx(Double(acc[2*(n*nw+k)]), Double(acc[2*(n*nw+k)+1]));
+      }
+
+      template<typename REAL, typename T>
+      void caxpyImpl(const std::vector<T*>& x, const multi1d<DComplex>& c,
+		     const std::vector<const T*>& v, const Subset& s)
+      {
+	int n5 = x.size();
+	int nv = c.size();
+	int len = s.numSiteTable();
+	if (len == 0 || nv == 0 || n5 == 0)
+	  return;
+
+	std::vector<REAL*> x_ptr(n5);
+	std::vector<const REAL*> v_ptr(nv*n5);
+	std::vector<REAL64> c_r(2*nv);
+
+	for(int d5=0; d5 < n5; ++d5)
+	  x_ptr[d5] = firstReal<REAL>(*x[d5]);
+	for(int i=0; i < nv*n5; ++i)
+	  v_ptr[i] = firstReal<REAL>(*v[i]);
+	for(int n=0; n < nv; ++n)
+	{
+	  c_r[2*n]   = toDouble(real(c[n]));
+	  c_r[2*n+1] = toDouble(imag(c[n]));
+	}
+
+	caxpy_arg<REAL> arg = {s.siteTable().slice(), &(x_ptr[0]), &(v_ptr[0]), &(c_r[0]), nv, n5};
+	dispatch_to_threads(len, arg, caxpyKernel<REAL>);
+      }
+    }
+
+
+    //----------------------------------------------------------------------------
+    void inner_products(multi2d<DComplex>& res,
+			const std::vector<const LatticeFermionF*>& v,
+			const std::vector<const LatticeFermionF*>& w,
+			int n5, const Subset& s)
+    {
+      innerProductsImpl<REAL32>(res, v, w, n5, s);
+    }
+
+    void inner_products(multi2d<DComplex>& res,
+			const std::vector<const LatticeFermionD*>& v,
+			const std::vector<const LatticeFermionD*>& w,
+			int n5, const Subset& s)
+    {
+      innerProductsImpl<REAL64>(res, v, w, n5, s);
+    }
+
+
+    void caxpy(const std::vector<LatticeFermionF*>& x, const multi1d<DComplex>& c,
+	       const std::vector<const LatticeFermionF*>& v, const Subset& s)
+    {
+      caxpyImpl<REAL32>(x, c, v, s);
+    }
+
+    void caxpy(const std::vector<LatticeFermionD*>& x, const multi1d<DComplex>& c,
+	       const std::vector<const LatticeFermionD*>& v, const Subset& s)
+    {
+      caxpyImpl<REAL64>(x, c, v, s);
+    }
+
+  }  // end namespace MREKernels
+
+}  // end namespace Chroma
+
+#endif
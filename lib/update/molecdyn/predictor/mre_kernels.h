@@ -0,0 +1,97 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Blocked multi-vector kernels for the minimal residual predictors
+ */
+
+#ifndef __mre_kernels_h__
+#define __mre_kernels_h__
+
+#include "chromabase.h"
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Multi-vector inner products and linear combinations
+  /*! @ingroup predictor
+   *
+   * The minimal residual predictors need the inner products of every
+   * vector in their buffers with a few right hand sides. Taken one at a
+   * time each of these is a pass over two fields and a global sum. The
+   * functions here do a whole block in one pass with one global sum.
+   *
+   * A vector may span n5 fields (the 5D predictor), in which case the
+   * inner product sums over them. Vector n of a list v is then the fields
+   * v[n*n5] ... v[n*n5+n5-1].
+   *
+   * The templates are the plain QDP versions. For lattice fermions there
+   * are overloads that run a threaded single pass over the sites.
+   */
+  namespace MREKernels
+  {
+
+    //! res(n,k) = <v_n | w_k> on s
+    template<typename T>
+    inline
+    void inner_products(multi2d<DComplex>& res,
+			const std::vector<const T*>& v, const std::vector<const T*>& w,
+			int n5, const Subset& s)
+    {
+      int nv = v.size() / n5;
+      int nw = w.size() / n5;
+      res.resize(nv, nw);
+
+      for(int n=0; n < nv; ++n)
+      {
+	for(int k=0; k < nw; ++k)
+	{
+	  DComplex ip = innerProduct(*v[n*n5], *w[k*n5], s);
+	  for(int d5=1; d5 < n5; ++d5)
+	    ip += innerProduct(*v[n*n5+d5], *w[k*n5+d5], s);
+
+	  res(n,k) = ip;
+	}
+      }
+    }
+
+    //! x += sum_n c[n] v_n on s, where x is a vector of x.size() fields
+    template<typename T>
+    inline
+    void caxpy(const std::vector<T*>& x, const multi1d<DComplex>& c,
+	       const std::vector<const T*>& v, const Subset& s)
+    {
+      int n5 = x.size();
+
+      for(int n=0; n < c.size(); ++n)
+      {
+	Complex cn = Complex(c[n]);
+	for(int d5=0; d5 < n5; ++d5)
+	  (*x[d5])[s] += cn * (*v[n*n5+d5]);
+      }
+    }
+
+
+#ifndef QDP_IS_QDPJIT
+    //! Single pass versions
+    void inner_products(multi2d<DComplex>& res,
+			const std::vector<const LatticeFermionF*>& v,
+			const std::vector<const LatticeFermionF*>& w,
+			int n5, const Subset& s);
+
+    void inner_products(multi2d<DComplex>& res,
+			const std::vector<const LatticeFermionD*>& v,
+			const std::vector<const LatticeFermionD*>& w,
+			int n5, const Subset& s);
+
+    void caxpy(const std::vector<LatticeFermionF*>& x, const multi1d<DComplex>& c,
+	       const std::vector<const LatticeFermionF*>& v, const Subset& s);
+
+    void caxpy(const std::vector<LatticeFermionD*>& x, const multi1d<DComplex>& c,
+	       const std::vector<const LatticeFermionD*>& v, const Subset& s);
+#endif
+
+  }  // end namespace MREKernels
+
+}  // end namespace Chroma
+
+#endif
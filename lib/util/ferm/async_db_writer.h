@@ -0,0 +1,244 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Write key/value pairs to a DB on a background thread
+ */
+
+#ifndef __async_db_writer_h__
+#define __async_db_writer_h__
+
+#include "chromabase.h"
+#include "qdp_db.h"
+#include "util/ferm/key_val_db.h"
+#include <pthread.h>
+#include <fcntl.h>
+#include <vector>
+#include <utility>
+
+namespace Chroma
+{
+
+  //---------------------------------------------------------------------
+  //! Double buffered, asynchronous DB inserts
+  /*!
+   * \ingroup ferm
+   *
+   * The QDP BinaryStoreDB wrapper broadcasts the status of every insert,
+   * so it may only be called from the main thread and every insert is a
+   * synchronization point. The values written by the measurements are
+   * already global, and only the primary node touches the file. This
+   * class therefore opens the underlying FILEDB store on the primary node
+   * only, and a private thread does the serialization and inserts there.
+   *
+   * The caller fills a batch and hands it over with submit(). One batch
+   * can be in flight while the next is being filled. submit() only blocks
+   * when the previous batch is still being written. Errors are gathered by
+   * the writer thread and reported, collectively, by flush() and close().
+   *
+   * The file must already exist with its user data; create it with
+   * BinaryStoreDB as usual and close that before calling open() here.
+   */
+  template<typename K, typename D>
+  class AsyncDBWriter
+  {
+  public:
+    typedef std::vector< std::pair<K,D> > Batch_t;
+
+    //! Nothing open
+    AsyncDBWriter() : opened(false), busy(false), shutdown(false), status(0),
+		      num_written(0), write_secs(0), wait_secs(0)
+    {
+      pthread_mutex_init(&mutex, NULL);
+      pthread_cond_init(&cond, NULL);
+    }
+
+    //! Flushes and closes
+    ~AsyncDBWriter()
+    {
+      close();
+      pthread_cond_destroy(&cond);
+      pthread_mutex_destroy(&mutex);
+    }
+
+    //! Open an existing DB. Collective.
+    void open(const std::string& file)
+    {
+      int ret = 0;
+      if (Layout::primaryNode())
+	ret = db.open(file, O_RDWR, 0664);
+      QDPInternal::broadcast(ret);
+
+      if (ret != 0)
+      {
+	QDPIO::cerr << __func__ << ": error opening " << file << std::endl;
+	QDP_abort(1);
+      }
+
+      opened   = true;
+      shutdown = false;
+      status   = 0;
+
+      if (Layout::primaryNode())
+      {
+	if (pthread_create(&thread, NULL, &AsyncDBWriter::run, this) != 0)
+	{
+	  QDPIO::cerr << __func__ << ": could not start DB writer thread" << std::endl;
+	  QDP_abort(1);
+	}
+      }
+    }
+
+    //! Hand over a batch, which is left empty. Blocks while the previous batch is in flight.
+    void submit(Batch_t& batch)
+    {
+      if (! Layout::primaryNode())
+      {
+	batch.clear();
+	return;
+      }
+
+      StopWatch swatch;
+      swatch.reset();
+      swatch.start();
+
+      pthread_mutex_lock(&mutex);
+      while (busy)
+	pthread_cond_wait(&cond, &mutex);
+
+      back.swap(batch);
+      busy = true;
+      pthread_cond_broadcast(&cond);
+      pthread_mutex_unlock(&mutex);
+
+      batch.clear();
+
+      swatch.stop();
+      wait_secs += swatch.getTimeInSeconds();
+    }
+
+    //! Wait until everything submitted is written, and check for errors. Collective.
+    void flush()
+    {
+      int ret = 0;
+
+      if (Layout::primaryNode() && opened)
+      {
+	StopWatch swatch;
+	swatch.reset();
+	swatch.start();
+
+	pthread_mutex_lock(&mutex);
+	while (busy)
+	  pthread_cond_wait(&cond, &mutex);
+	ret = status;
+	pthread_mutex_unlock(&mutex);
+
+	swatch.stop();
+	wait_secs += swatch.getTimeInSeconds();
+      }
+      QDPInternal::broadcast(ret);
+
+      if (ret != 0)
+      {
+	QDPIO::cerr << __func__ << ": error inserting into DB, status = " << ret << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    //! Flush, stop the writer and close the DB. Collective.
+    void close()
+    {
+      if (! opened)
+	return;
+
+      flush();
+
+      if (Layout::primaryNode())
+      {
+	pthread_mutex_lock(&mutex);
+	shutdown = true;
+	pthread_cond_broadcast(&cond);
+	pthread_mutex_unlock(&mutex);
+
+	pthread_join(thread, NULL);
+	db.close();
+      }
+      opened = false;
+    }
+
+    //! Number of pairs written on this node
+    unsigned long numWritten() const {return num_written;}
+
+    //! Seconds the writer thread spent writing
+    double writeTime() const {return write_secs;}
+
+    //! Seconds the caller spent blocked on the writer
+    double waitTime() const {return wait_secs;}
+
+  private:
+    //! Writer thread
+    static void* run(void* arg)
+    {
+      AsyncDBWriter& me = *static_cast<AsyncDBWriter*>(arg);
+      Batch_t batch;
+
+      for(;;)
+      {
+	pthread_mutex_lock(&me.mutex);
+	while (! me.busy && ! me.shutdown)
+	  pthread_cond_wait(&me.cond, &me.mutex);
+
+	if (! me.busy && me.shutdown)
+	{
+	  pthread_mutex_unlock(&me.mutex);
+	  break;
+	}
+	batch.swap(me.back);
+	pthread_mutex_unlock(&me.mutex);
+
+	StopWatch swatch;
+	swatch.reset();
+	swatch.start();
+
+	int ret = insertSorted(me.db, batch);
+
+	swatch.stop();
+
+	pthread_mutex_lock(&me.mutex);
+	me.write_secs  += swatch.getTimeInSeconds();
+	me.num_written += batch.size();
+	if (ret != 0 && me.status == 0)
+	  me.status = ret;
+	me.busy = false;
+	pthread_cond_broadcast(&me.cond);
+	pthread_mutex_unlock(&me.mutex);
+
+	batch.clear();
+      }
+      return NULL;
+    }
+
+    // Hide copies - the thread holds a pointer to this
+    AsyncDBWriter(const AsyncDBWriter&) {}
+    void operator=(const AsyncDBWriter&) {}
+
+  private:
+    FILEDB::ConfDataStoreDB<K,D> db;   /*!< only used on the primary node */
+
+    pthread_t        thread;
+    pthread_mutex_t  mutex;
+    pthread_cond_t   cond;
+
+    Batch_t          back;          /*!< batch handed to the writer */
+    bool             opened;
+    bool             busy;          /*!< back holds a batch not yet written */
+    bool             shutdown;
+    int              status;
+
+    unsigned long    num_written;
+    double           write_secs;
+    double           wait_secs;
+  };
+
+} // namespace Chroma
+
+#endif
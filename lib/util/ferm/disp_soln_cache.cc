@@ -7,6 +7,7 @@
 
 #include "util/ferm/disp_soln_cache.h"
 #include "meas/smear/displace.h"
+#include <algorithm>
 
 
 namespace Chroma 
@@ -49,82 +50,246 @@ namespace Chroma
 
   
 
+  // Ordering
+  bool operator<(const KeyDispSolnVector_t& a, const KeyDispSolnVector_t& b)
+  {
+    if (a.use_derivP != b.use_derivP)
+      return a.use_derivP < b.use_derivP;
+
+    if (a.displacement != b.displacement)
+      return a.displacement < b.displacement;
+
+    if (a.mom.size() != b.mom.size())
+      return a.mom.size() < b.mom.size();
+
+    for(int i=0; i < a.mom.size(); ++i)
+    {
+      if (a.mom[i] != b.mom[i])
+	return a.mom[i] < b.mom[i];
+    }
+
+    return false;
+  }
+
+  
+
   //----------------------------------------------------------------------------
   // Constructor from smeared map 
   DispSolnCache::DispSolnCache(const multi1d<LatticeColorMatrix>& u_smr,
-			       const LatticeColorVectorSpinMatrix& soln_)
-    : displacement_length(1), u(u_smr), soln(soln_)
+			       const LatticeColorVectorSpinMatrix& soln_,
+			       size_t max_bytes_)
+    : displacement_length(1), u(u_smr), soln(soln_), max_bytes(max_bytes_), peak_bytes(0),
+      use_clock(0), hits(0), misses(0), evictions(0)
   {
+    entry_bytes = size_t(Layout::sitesOnNode()) * Ns*Ns*Nc * 2*sizeof(REAL);
+
+    if (max_bytes > 0 && max_bytes < entry_bytes)
+    {
+      QDPIO::cerr << __func__ << ": cache budget of " << max_bytes << " bytes cannot hold a single vector of "
+		  << entry_bytes << " bytes" << std::endl;
+      QDP_abort(1);
+    }
   }
 
 
-  //! Accessor
-  const LatticeColorVectorSpinMatrix&
-  DispSolnCache::getDispVector(bool use_derivP, const multi1d<int>& mom,
-			       const std::vector<int>& disp)
+  //! Key as used by the cache
+  KeyDispSolnVector_t
+  DispSolnCache::makeKey(bool use_derivP, const multi1d<int>& mom,
+			 const std::vector<int>& disp) const
   {
     KeyDispSolnVector_t key;
     key.use_derivP     = use_derivP;
-    key.mom            = mom;
     key.displacement   = disp;
 
-    return displaceObject(key);
+    // The momentum only enters through the derivatives
+    if (use_derivP)
+      key.mom          = mom;
+
+    return key;
   }
 
 
   //! Accessor
   const LatticeColorVectorSpinMatrix&
-  DispSolnCache::displaceObject(const KeyDispSolnVector_t& key)
+  DispSolnCache::getDispVector(bool use_derivP, const multi1d<int>& mom,
+			       const std::vector<int>& disp)
   {
+    KeyDispSolnVector_t key = makeKey(use_derivP, mom, disp);
 
-    // If no entry, then create a displaced version of the quark
-    if (! disp_src_map.exist(key))
+    if (disp_src_map.find(key) != disp_src_map.end())
+      ++hits;
+
+    addPending(key, -1);
+
+    return displaceObject(key);
+  }
+
+
+  //! Announce a request
+  void DispSolnCache::schedule(bool use_derivP, const multi1d<int>& mom,
+			       const std::vector<int>& disp)
+  {
+    addPending(makeKey(use_derivP, mom, disp), 1);
+  }
+
+
+  //! Count a request for the key and its prefixes
+  void DispSolnCache::addPending(const KeyDispSolnVector_t& key, int n)
+  {
+    KeyDispSolnVector_t k = key;
+
+    while (k.displacement.size() > 0)
     {
-      // Only need to do more if there are displacements
-      if (key.displacement.size() == 0)
+      std::map<KeyDispSolnVector_t, int>::iterator p = pending.find(k);
+
+      if (p != pending.end())
       {
-	// Pull out the soln vector
-	//	disp_src_map.insert(key, soln);
-	return soln;
+	p->second += n;
+	if (p->second <= 0)
+	  pending.erase(p);
       }
-      else
+      else if (n > 0)
       {
-	// Have at least one displacement. Pull that one off the end of the list
-	KeyDispSolnVector_t prev_key = key;
+	pending.insert(std::make_pair(k, n));
+      }
 
-	int d = key.displacement.back();
-	prev_key.displacement.pop_back();
+      k.displacement.pop_back();
+    }
+  }
 
-	// Recursively get a reference to the object to be shifted 
-	const LatticeColorVectorSpinMatrix& disp_q = this->displaceObject(prev_key);
 
-	// Displace or deriv the old vector
-	if (d > 0)
-	{
-	  int disp_dir = d - 1;
-	  int disp_len = displacement_length;
-	  if (key.use_derivP)
-	    disp_src_map.insert(key, leftRightNabla(disp_q, u, disp_dir, disp_len, key.mom[disp_dir]));
-	  else
-	    disp_src_map.insert(key, displace(u, disp_q, disp_len, disp_dir));
-	}
-	else if (d < 0)
+  //! Build scheduled paths in advance
+  void DispSolnCache::prefetch()
+  {
+    // The keys are ordered, so prefixes come before the paths through them
+    for(std::map<KeyDispSolnVector_t, int>::const_iterator p = pending.begin(); p != pending.end(); ++p)
+    {
+      if (disp_src_map.find(p->first) != disp_src_map.end())
+	continue;
+
+      if (max_bytes > 0 && (disp_src_map.size() + 1)*entry_bytes > max_bytes)
+	break;
+
+      displaceObject(p->first);
+    }
+  }
+
+
+  //! Evict until another entry fits
+  void DispSolnCache::makeRoom(const KeyDispSolnVector_t& keep)
+  {
+    if (max_bytes == 0)
+      return;
+
+    while ((disp_src_map.size() + 1)*entry_bytes > max_bytes && disp_src_map.size() > 0)
+    {
+      typedef std::map<KeyDispSolnVector_t, Entry>::iterator Iter_t;
+
+      Iter_t victim = disp_src_map.end();
+      int    victim_rank = 0;
+
+      for(Iter_t e = disp_src_map.begin(); e != disp_src_map.end(); ++e)
+      {
+	if (! (e->first < keep) && ! (keep < e->first))
+	  continue;
+
+	// Still needed by a scheduled request?
+	int rank = (pending.find(e->first) != pending.end()) ? 2 : 0;
+
+	// A prefix of another cached path?
+	for(Iter_t c = disp_src_map.begin(); c != disp_src_map.end(); ++c)
 	{
-	  if (key.use_derivP)
+	  if (c->first.displacement.size() != e->first.displacement.size() + 1)
+	    continue;
+
+	  KeyDispSolnVector_t prefix = c->first;
+	  prefix.displacement.pop_back();
+
+	  if (! (prefix < e->first) && ! (e->first < prefix))
 	  {
-	    QDPIO::cerr << __func__ << ": do not support (rather do not want to support) negative displacements for rightNabla\n";
-	    QDP_abort(1);
+	    rank += 1;
+	    break;
 	  }
+	}
+
+	if (victim == disp_src_map.end() || rank < victim_rank ||
+	    (rank == victim_rank && e->second.last_use < victim->second.last_use))
+	{
+	  victim      = e;
+	  victim_rank = rank;
+	}
+      }
+
+      if (victim == disp_src_map.end())
+	break;
+
+      disp_src_map.erase(victim);
+      ++evictions;
+    }
+  }
 
-	  int disp_dir = -d - 1;
-	  int disp_len = -displacement_length;
-	  disp_src_map.insert(key, displace(u, disp_q, disp_len, disp_dir));
+
+  //! Accessor
+  const LatticeColorVectorSpinMatrix&
+  DispSolnCache::displaceObject(const KeyDispSolnVector_t& key)
+  {
+    // Only need to do more if there are displacements
+    if (key.displacement.size() == 0)
+    {
+      // Pull out the soln vector
+      return soln;
+    }
+
+    std::map<KeyDispSolnVector_t, Entry>::iterator e = disp_src_map.find(key);
+
+    // If no entry, then create a displaced version of the quark
+    if (e == disp_src_map.end())
+    {
+      // Have at least one displacement. Pull that one off the end of the list
+      KeyDispSolnVector_t prev_key = key;
+
+      int d = key.displacement.back();
+      prev_key.displacement.pop_back();
+
+      // Recursively get a reference to the object to be shifted 
+      const LatticeColorVectorSpinMatrix& disp_q = this->displaceObject(prev_key);
+
+      // Make space, but keep the object being shifted
+      makeRoom(prev_key);
+
+      ++misses;
+      e = disp_src_map.insert(std::make_pair(key, Entry())).first;
+
+      // Displace or deriv the old vector
+      if (d > 0)
+      {
+	int disp_dir = d - 1;
+	int disp_len = displacement_length;
+	if (key.use_derivP)
+	  e->second.vec = leftRightNabla(disp_q, u, disp_dir, disp_len, key.mom[disp_dir]);
+	else
+	  e->second.vec = displace(u, disp_q, disp_len, disp_dir);
+      }
+      else if (d < 0)
+      {
+	if (key.use_derivP)
+	{
+	  QDPIO::cerr << __func__ << ": do not support (rather do not want to support) negative displacements for rightNabla\n";
+	  QDP_abort(1);
 	}
+
+	int disp_dir = -d - 1;
+	int disp_len = -displacement_length;
+	e->second.vec = displace(u, disp_q, disp_len, disp_dir);
       }
+
+      peak_bytes = std::max(peak_bytes, disp_src_map.size()*entry_bytes);
     } // if find in map
 
     // The key now must exist in the map, so return the vector
-    return disp_src_map[key];
+    e->second.last_use = ++use_clock;
+
+    return e->second.vec;
   }
 
   
@@ -17,6 +17,7 @@
 //#include "util/ferm/distillation_soln_cache.h"
 
 #include <vector>
+#include <map>
 
 namespace Chroma
 {
@@ -39,6 +40,9 @@ namespace Chroma
 
   // Quark write
   void write(BinaryWriter& bin, const KeyDispSolnVector_t& param);
+
+  //! Ordering, so the keys can be used in a std::map
+  bool operator<(const KeyDispSolnVector_t& a, const KeyDispSolnVector_t& b);
   
 
   //---------------------------------------------------------------------
@@ -47,13 +51,22 @@ namespace Chroma
    * \ingroup ferm 
    *
    * Holds unsmeared distillation solution vectors
+   *
+   * Displacements are built recursively, so every prefix of a path is
+   * cached on the way. With a byte budget the cache evicts to stay within
+   * it. The victim is chosen in this order: entries with no scheduled
+   * use before those that are still needed, leaves before prefixes of
+   * other cached paths, then least recently used. A reference returned by
+   * getDispVector is only valid until the next call.
    */
   class DispSolnCache
   {
   public:
     //! Default constructor
+    /*! \param max_bytes  budget for the cached vectors on this node, 0 for no limit */
     DispSolnCache(const multi1d<LatticeColorMatrix>& u_smr,
-		  const LatticeColorVectorSpinMatrix& soln_);
+		  const LatticeColorVectorSpinMatrix& soln_,
+		  size_t max_bytes = 0);
 
     //! Destructor
     virtual ~DispSolnCache() {} 
@@ -62,11 +75,48 @@ namespace Chroma
     const LatticeColorVectorSpinMatrix& getDispVector(bool use_derivP, const multi1d<int>& mom,
 					const std::vector<int>& disp);
 
+    //! Announce a later getDispVector call
+    /*! Scheduled paths, and their prefixes, are evicted last */
+    void schedule(bool use_derivP, const multi1d<int>& mom, const std::vector<int>& disp);
+
+    //! Build scheduled paths in advance, as far as the budget allows without evicting
+    void prefetch();
+
+    //! Requests served from the cache
+    unsigned long numHits() const {return hits;}
+
+    //! Displacements computed
+    unsigned long numMisses() const {return misses;}
+
+    //! Entries evicted
+    unsigned long numEvictions() const {return evictions;}
+
+    //! High water mark of the cached vectors on this node
+    size_t peakBytes() const {return peak_bytes;}
+
   protected:
     //! Displace an object
     const LatticeColorVectorSpinMatrix& displaceObject(const KeyDispSolnVector_t& key);
+
+    //! Key as used by the cache
+    KeyDispSolnVector_t makeKey(bool use_derivP, const multi1d<int>& mom,
+				const std::vector<int>& disp) const;
+
+    //! Evict until another entry fits, never touching keep
+    void makeRoom(const KeyDispSolnVector_t& keep);
+
+    //! Count a request for key, and the prefixes needed to build it
+    void addPending(const KeyDispSolnVector_t& key, int n);
 			
   private:
+    //! A cached vector
+    struct Entry
+    {
+      LatticeColorVectorSpinMatrix  vec;
+      unsigned long                 last_use;
+    };
+
+
     //! Displacement length
     int displacement_length;
 			
@@ -77,7 +127,20 @@ namespace Chroma
     const LatticeColorVectorSpinMatrix& soln;
 
     //! Unsmeared vectors
-    QDP::MapObjectMemory<KeyDispSolnVector_t, LatticeColorVectorSpinMatrix>  disp_src_map;
+    std::map<KeyDispSolnVector_t, Entry>  disp_src_map;
+
+    //! Outstanding scheduled requests that need each path
+    std::map<KeyDispSolnVector_t, int>    pending;
+
+    //! Bytes per vector, and the budget
+    size_t  entry_bytes;
+    size_t  max_bytes;
+    size_t  peak_bytes;
+
+    unsigned long  use_clock;
+    unsigned long  hits;
+    unsigned long  misses;
+    unsigned long  evictions;
   };
 
   /*! @} */  // end of group ferm
@@ -0,0 +1,362 @@
+/*! \file
+ * \brief Time slice elementals of colorvector objects as complex GEMMs
+ */
+
+#include "chromabase.h"
+
+#ifndef QDP_IS_QDPJIT
+
+#include "util/ferm/elemental_gemm.h"
+#include <algorithm>
+
+#ifdef BUILD_LAPACK
+extern "C"
+{
+  void zgemm_(const char* transa, const char* transb,
+	      const int* m, const int* n, const int* k,
+	      const std::complex<double>* alpha,
+	      const std::complex<double>* a, const int* lda,
+	      const std::complex<double>* b, const int* ldb,
+	      const std::complex<double>* beta,
+	      std::complex<double>* c, const int* ldc);
+}
+#endif
+
+
+namespace Chroma
+{
+  namespace
+  {
+    typedef ElementalGEMM::Cmplx_t  Cmplx_t;
+
+    //----------------------------------------------------------------------------
+    //! What is being packed
+    enum PackKind {
+      PACK_VEC,
+      PACK_SPIN,
+      PACK_CROSS
+    };
+
+    struct PackArgs
+    {
+      PackKind  kind;
+      const int* tab;
+      size_t     rows;         /*!< column stride */
+      Cmplx_t*   col;
+      const LatticeColorVector*            v;
+      const LatticeColorVector*            b;
+      const LatticeColorVectorSpinMatrix*  s;
+      const LatticeComplex*                phase;
+    };
+
+    //! Pack sites [lo,hi) of a subset
+    void packSiteLoop(int lo, int hi, int myId, PackArgs* a)
+    {
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->tab[j];
+
+	Cmplx_t ph(1.0, 0.0);
+	if (a->phase)
+	{
+	  ph = Cmplx_t(a->phase->elem(site).elem().elem().real(),
+		       a->phase->elem(site).elem().elem().imag());
+	}
+
+	switch (a->kind)
+	{
+	case PACK_VEC:
+	{
+	  Cmplx_t* p = a->col + size_t(j)*Nc;
+	  for(int c=0; c < Nc; ++c)
+	    p[c] = ph * Cmplx_t(a->v->elem(site).elem().elem(c).real(),
+				a->v->elem(site).elem().elem(c).imag());
+	}
+	break;
+
+	case PACK_SPIN:
+	{
+	  for(int s=0; s < Ns; ++s)
+	  {
+	    Cmplx_t* p = a->col + s*a->rows + size_t(j)*Ns*Nc;
+	    for(int k=0; k < Ns; ++k)
+	      for(int c=0; c < Nc; ++c)
+		p[k*Nc+c] = ph * Cmplx_t(a->s->elem(site).elem(k,s).elem(c).real(),
+					 a->s->elem(site).elem(k,s).elem(c).imag());
+	  }
+	}
+	break;
+
+	case PACK_CROSS:
+	{
+	  // Only Nc = 3 has a cross product
+	  Cmplx_t x[3], y[3];
+	  for(int c=0; c < 3; ++c)
+	  {
+	    x[c] = Cmplx_t(a->v->elem(site).elem().elem(c).real(),
+			   a->v->elem(site).elem().elem(c).imag());
+	    y[c] = Cmplx_t(a->b->elem(site).elem().elem(c).real(),
+			   a->b->elem(site).elem().elem(c).imag());
+	  }
+	  Cmplx_t* p = a->col + size_t(j)*3;
+	  p[0] = ph * (x[1]*y[2] - x[2]*y[1]);
+	  p[1] = ph * (x[2]*y[0] - x[0]*y[2]);
+	  p[2] = ph * (x[0]*y[1] - x[1]*y[0]);
+	}
+	break;
+	}
+      }
+    }
+
+
+    //----------------------------------------------------------------------------
+    //! Rows of the panels per cache block
+    const int gemm_kb = 64;
+
+    //! Register tile of c
+    const int gemm_mr = 2;
+    const int gemm_nr = 4;
+
+    struct GemmArgs
+    {
+      const Cmplx_t* a;        /*!< k x m, column major */
+      const Cmplx_t* b;        /*!< k x n, column major */
+      Cmplx_t*       c;        /*!< m x n, column major */
+      int            m;
+      int            n;
+      int            k;
+      int            tiles_m;
+    };
+
+    //! c(i,j) += sum_k op(a(k,i)) b(k,j) over a row block, for a tile of up to MR x NR
+    /*! The loops have compile time bounds for the full tiles, so the
+     *  accumulators stay in registers */
+    template<bool Conj, int MR, int NR>
+    inline void gemmTile(const GemmArgs* g, int k0, int kl, int i0, int mi, int j0, int nj)
+    {
+      const double* a[MR];
+      const double* b[NR];
+      double re[NR][MR];
+      double im[NR][MR];
+
+      for(int ii=0; ii < mi; ++ii)
+	a[ii] = reinterpret_cast<const double*>(g->a + size_t(i0+ii)*g->k + k0);
+      for(int jj=0; jj < nj; ++jj)
+	b[jj] = reinterpret_cast<const double*>(g->b + size_t(j0+jj)*g->k + k0);
+
+      for(int jj=0; jj < NR; ++jj)
+	for(int ii=0; ii < MR; ++ii)
+	  re[jj][ii] = im[jj][ii] = 0;
+
+      for(int k=0; k < kl; ++k)
+      {
+	double ar[MR], ai[MR];
+	for(int ii=0; ii < mi; ++ii)
+	{
+	  ar[ii] = a[ii][2*k];
+	  ai[ii] = Conj ? -a[ii][2*k+1] : a[ii][2*k+1];
+	}
+
+	for(int jj=0; jj < nj; ++jj)
+	{
+	  double br = b[jj][2*k];
+	  double bi = b[jj][2*k+1];
+
+	  for(int ii=0; ii < mi; ++ii)
+	  {
+	    re[jj][ii] += ar[ii]*br - ai[ii]*bi;
+	    im[jj][ii] += ar[ii]*bi + ai[ii]*br;
+	  }
+	}
+      }
+
+      for(int jj=0; jj < nj; ++jj)
+	for(int ii=0; ii < mi; ++ii)
+	  g->c[size_t(j0+jj)*g->m + i0+ii] += Cmplx_t(re[jj][ii], im[jj][ii]);
+    }
+
+    //! The tiles [lo,hi) of c
+    template<bool Conj>
+    void gemmTileLoop(int lo, int hi, int myId, GemmArgs* g)
+    {
+      for(int k0=0; k0 < g->k; k0 += gemm_kb)
+      {
+	int kl = std::min(gemm_kb, g->k - k0);
+
+	for(int tile=lo; tile < hi; ++tile)
+	{
+	  int i0 = gemm_mr*(tile % g->tiles_m);
+	  int j0 = gemm_nr*(tile / g->tiles_m);
+	  int mi = std::min(gemm_mr, g->m - i0);
+	  int nj = std::min(gemm_nr, g->n - j0);
+
+	  if (mi == gemm_mr && nj == gemm_nr)
+	    gemmTile<Conj,gemm_mr,gemm_nr>(g, k0, kl, i0, gemm_mr, j0, gemm_nr);
+	  else
+	    gemmTile<Conj,gemm_mr,gemm_nr>(g, k0, kl, i0, mi, j0, nj);
+	}
+      }
+    }
+
+
+    //! c = op(a)^T b
+    void panelGEMM(Cmplx_t* c, const Cmplx_t* a, const Cmplx_t* b, int m, int n, int k, bool conj)
+    {
+#ifdef BUILD_LAPACK
+      const char transa = (conj) ? 'C' : 'T';
+      const char transb = 'N';
+      const Cmplx_t one(1.0, 0.0);
+      const Cmplx_t zip(0.0, 0.0);
+
+      zgemm_(&transa, &transb, &m, &n, &k, &one, a, &k, b, &k, &zip, c, &m);
+#else
+      for(size_t i=0; i < size_t(m)*n; ++i)
+	c[i] = Cmplx_t(0.0, 0.0);
+
+      GemmArgs g = {a, b, c, m, n, k, (m + gemm_mr - 1)/gemm_mr};
+      int num_tiles = g.tiles_m * ((n + gemm_nr - 1)/gemm_nr);
+
+      if (conj)
+	dispatch_to_threads(num_tiles, g, gemmTileLoop<true>);
+      else
+	dispatch_to_threads(num_tiles, g, gemmTileLoop<false>);
+#endif
+    }
+  }
+
+
+  //----------------------------------------------------------------------------
+  // Empty panel
+  ElementalGEMM::Panel::Panel(const ElementalGEMM& gemm_, Inner inner_) :
+    gemm(gemm_), num_cols(0), data(gemm_.numSubsets())
+  {
+    inner = (inner_ == COLOR_VECTOR_SPIN_MATRIX) ? Ns*Nc : Nc;
+  }
+
+  // Start n more columns
+  void ElementalGEMM::Panel::grow(int n)
+  {
+    for(int t=0; t < gemm.numSubsets(); ++t)
+    {
+      if (! gemm.isActive(t)) {continue;}
+
+      size_t rows = size_t(gemm.numSites(t))*inner;
+      if (data[t].size() < rows*(num_cols + n))
+	data[t].resize(rows*(num_cols + n));
+    }
+    num_cols += n;
+  }
+
+  // First of the new columns
+  ElementalGEMM::Cmplx_t* ElementalGEMM::Panel::newColumns(int t, int n)
+  {
+    size_t rows = size_t(gemm.numSites(t))*inner;
+    return &(data[t][0]) + rows*(num_cols - n);
+  }
+
+  // Pack n new columns on every active subset
+  void ElementalGEMM::Panel::pack(int kind, int n,
+				  const LatticeColorVector* v, const LatticeColorVector* b,
+				  const LatticeColorVectorSpinMatrix* sm, const LatticeComplex* phase)
+  {
+    PackArgs a = {PackKind(kind), 0, 0, 0, v, b, sm, phase};
+    grow(n);
+
+    for(int t=0; t < gemm.numSubsets(); ++t)
+    {
+      if (! gemm.isActive(t) || gemm.numSites(t) == 0) {continue;}
+
+      a.tab  = gemm.set[t].siteTable().slice();
+      a.rows = size_t(gemm.numSites(t))*inner;
+      a.col  = newColumns(t, n);
+      dispatch_to_threads(gemm.numSites(t), a, packSiteLoop);
+    }
+  }
+
+  // Append a vector
+  void ElementalGEMM::Panel::add(const LatticeColorVector& v)
+  {
+    pack(PACK_VEC, 1, &v, 0, 0, 0);
+  }
+
+  // Append phase * v
+  void ElementalGEMM::Panel::add(const LatticeColorVector& v, const LatticeComplex& phase)
+  {
+    pack(PACK_VEC, 1, &v, 0, 0, &phase);
+  }
+
+  // Append the spin columns of v
+  void ElementalGEMM::Panel::add(const LatticeColorVectorSpinMatrix& v)
+  {
+    pack(PACK_SPIN, Ns, 0, 0, &v, 0);
+  }
+
+  // Append the spin columns of phase * v
+  void ElementalGEMM::Panel::add(const LatticeColorVectorSpinMatrix& v, const LatticeComplex& phase)
+  {
+    pack(PACK_SPIN, Ns, 0, 0, &v, &phase);
+  }
+
+  // Append the cross product
+  void ElementalGEMM::Panel::addCross(const LatticeColorVector& x, const LatticeColorVector& y)
+  {
+    if (Nc != 3 || inner != Nc)
+    {
+      QDPIO::cerr << __func__ << ": cross product needs Nc=3 colour vectors" << std::endl;
+      QDP_abort(1);
+    }
+
+    pack(PACK_CROSS, 1, &x, &y, 0, 0);
+  }
+
+
+  //----------------------------------------------------------------------------
+  // All subsets
+  ElementalGEMM::ElementalGEMM(const Set& set_) : set(set_), active(set_.numSubsets(), true), last_flops(0) {}
+
+  // Only some subsets
+  ElementalGEMM::ElementalGEMM(const Set& set_, const std::vector<bool>& active_) :
+    set(set_), active(active_), last_flops(0)
+  {
+    if (active.size() != set.numSubsets())
+    {
+      QDPIO::cerr << __func__ << ": active subsets do not match the set" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+
+  // The elementals
+  void ElementalGEMM::contract(Result& res, const Panel& left, const Panel& right, Conj conj) const
+  {
+    if (left.inner != right.inner)
+    {
+      QDPIO::cerr << __func__ << ": left and right panels hold different objects" << std::endl;
+      QDP_abort(1);
+    }
+
+    res.m = left.numCols();
+    res.n = right.numCols();
+    res.c.assign(size_t(numSubsets())*res.m*res.n, Cmplx_t(0.0, 0.0));
+    last_flops = 0;
+
+    if (res.m == 0 || res.n == 0)
+      return;
+
+    for(int t=0; t < numSubsets(); ++t)
+    {
+      if (! active[t] || numSites(t) == 0) {continue;}
+
+      int k = numSites(t)*left.inner;
+      panelGEMM(&(res.c[size_t(t)*res.m*res.n]), &(left.data[t][0]), &(right.data[t][0]),
+		res.m, res.n, k, conj == CONJ_LEFT);
+
+      last_flops += 8.0*res.m*res.n*k;
+    }
+
+    QDPInternal::globalSumArray(reinterpret_cast<double*>(&(res.c[0])), int(2*res.c.size()));
+  }
+
+} // namespace Chroma
+
+#endif // QDP_IS_QDPJIT
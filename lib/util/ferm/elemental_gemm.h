@@ -0,0 +1,160 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Time slice elementals of colorvector objects as complex GEMMs
+ */
+
+#ifndef __elemental_gemm_h__
+#define __elemental_gemm_h__
+
+#include "chromabase.h"
+
+#ifndef QDP_IS_QDPJIT
+
+#include <complex>
+#include <vector>
+
+namespace Chroma
+{
+  //----------------------------------------------------------------------------
+  /*!
+   * \ingroup ferm
+   * @{
+   */
+
+  //! Elementals of colorvector objects over the subsets of a set
+  /*!
+   * The distillation elementals are all of the form
+   *
+   *   C_t(i,j) = sum_{x in t} sum_a  L_i(x,a)^*  R_j(x,a)
+   *
+   * where a runs over the colour (and spin row) components. Done one pair
+   * at a time with localInnerProduct and sumMulti these are a long series
+   * of lattice wide BLAS-1 operations. Here the vectors on each subset are
+   * gathered into dense column major panels, so that all the elementals of
+   * a subset come out of a single complex GEMM. Momentum phases are folded
+   * into the right panel as it is packed.
+   *
+   * The GEMM is zgemm from the BLAS when chroma is built with lapack, and
+   * a built in cache blocked, threaded kernel otherwise. The results are
+   * summed over nodes.
+   */
+  class ElementalGEMM
+  {
+  public:
+    typedef std::complex<double>  Cmplx_t;
+
+    //! Columns of packed vectors, one panel per subset
+    class Panel
+    {
+    public:
+      //! The objects the columns are made of
+      enum Inner {
+	COLOR_VECTOR = 1,
+	COLOR_VECTOR_SPIN_MATRIX = 2
+      };
+
+      //! Empty panel for the subsets of gemm
+      Panel(const ElementalGEMM& gemm, Inner inner);
+
+      //! Drop the columns, keep the storage
+      void clear() {num_cols = 0;}
+
+      //! Number of columns
+      int numCols() const {return num_cols;}
+
+      //! Append the vector
+      void add(const LatticeColorVector& v);
+
+      //! Append phase * v
+      void add(const LatticeColorVector& v, const LatticeComplex& phase);
+
+      //! Append the Ns spin columns of v
+      /*! Column s holds the components v(k,s) for all spin rows k, so
+       *  that the elementals are those of localColorInnerProduct */
+      void add(const LatticeColorVectorSpinMatrix& v);
+
+      //! Append the Ns spin columns of phase * v
+      void add(const LatticeColorVectorSpinMatrix& v, const LatticeComplex& phase);
+
+      //! Append the colour cross product  eps_{abc} a_a b_b
+      /*! Contracted with a vector c without conjugation this is colorContract(a,b,c) */
+      void addCross(const LatticeColorVector& a, const LatticeColorVector& b);
+
+    private:
+      friend class ElementalGEMM;
+
+      //! First of the last n columns on subset t
+      Cmplx_t* newColumns(int t, int n);
+
+      //! Start n more columns on all subsets
+      void grow(int n);
+
+      //! Pack n more columns from the given objects
+      void pack(int kind, int n,
+		const LatticeColorVector* v, const LatticeColorVector* b,
+		const LatticeColorVectorSpinMatrix* sm, const LatticeComplex* phase);
+
+      const ElementalGEMM&   gemm;
+      int                    inner;       /*!< complex components per site */
+      int                    num_cols;
+      std::vector< std::vector<Cmplx_t> >  data;   /*!< data[t] is numRows(t) x num_cols */
+    };
+
+    //! Elementals for all subsets
+    struct Result
+    {
+      int  m;
+      int  n;
+      std::vector<Cmplx_t> c;      /*!< c[(t*n + j)*m + i] */
+
+      //! Element (i,j) on subset t
+      const Cmplx_t& operator()(int t, int i, int j) const {return c[(size_t(t)*n + j)*m + i];}
+
+      //! As a QDP complex
+      ComplexD elem(int t, int i, int j) const
+      {
+	const Cmplx_t& z = (*this)(t,i,j);
+	return cmplx(RealD(z.real()), RealD(z.imag()));
+      }
+    };
+
+    //! How the left panel enters
+    enum Conj {
+      CONJ_LEFT,      /*!< L^dag R, the inner products */
+      PLAIN_LEFT      /*!< L^T R, the epsilon contractions */
+    };
+
+    //! Elementals over all subsets of set
+    explicit ElementalGEMM(const Set& set);
+
+    //! Elementals over the active subsets of set only
+    /*! Inactive subsets are neither packed nor contracted, and give zero */
+    ElementalGEMM(const Set& set, const std::vector<bool>& active);
+
+    //! Number of subsets
+    int numSubsets() const {return active.size();}
+
+    //! Is subset t contracted?
+    bool isActive(int t) const {return active[t];}
+
+    //! C_t = op(left)^T right on every active subset, summed over nodes
+    void contract(Result& res, const Panel& left, const Panel& right, Conj conj) const;
+
+    //! Flops in the last contraction on this node
+    double flops() const {return last_flops;}
+
+  private:
+    //! Number of local sites of subset t
+    int numSites(int t) const {return set[t].numSiteTable();}
+
+    const Set&          set;
+    std::vector<bool>   active;
+    mutable double      last_flops;
+  };
+
+  /*! @} */  // end of group ferm
+
+} // namespace Chroma
+
+#endif // QDP_IS_QDPJIT
+#endif // HEADER GUARD
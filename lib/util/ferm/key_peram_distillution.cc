@@ -114,4 +114,16 @@ namespace Chroma
     }
   }
 
+  //! PeramDist DB bytes, straight from the storage of mat
+  void writeDBBytes(std::string& output, const ValPeramDistillution_t& param)
+  {
+    writeDBBytes(output, param.mat);
+  }
+
+  //! PeramDist DB bytes, straight into the storage of mat
+  void readDBBytes(const std::string& input, ValPeramDistillution_t& param)
+  {
+    readDBBytes(input, param.mat);
+  }
+
 } // namespace Chroma
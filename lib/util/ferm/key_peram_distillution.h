@@ -69,6 +69,12 @@ namespace Chroma
   //! PeramDist write
   void write(BinaryWriter& bin, const ValPeramDistillution_t& param);
 
+  //! PeramDist DB bytes, straight from the storage of mat
+  void writeDBBytes(std::string& output, const ValPeramDistillution_t& param);
+
+  //! PeramDist DB bytes, straight into the storage of mat
+  void readDBBytes(const std::string& input, ValPeramDistillution_t& param);
+
   /*! @} */  // end of group ferm
 
 } // namespace Chroma
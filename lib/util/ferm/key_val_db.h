@@ -8,6 +8,11 @@
 
 #include "chromabase.h"
 #include "qdp_db.h"
+#include "qdp_util.h"    // from QDP
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <utility>
 
 namespace Chroma
 {
@@ -61,6 +66,210 @@ namespace Chroma
   };
 
 
+  //---------------------------------------------------------------------
+  //! Bytes of a DB value
+  /*!
+   * \ingroup ferm
+   *
+   * SerialDBData turns its value into bytes with these. The default goes
+   * through a BinaryBufferWriter. The overloads for arrays of ComplexD
+   * below copy straight from the array storage into the output, producing
+   * the same bytes as BinaryWriter: the sizes, then the numbers, all big
+   * endian. A value type that only holds such an array can overload these
+   * in its own namespace and forward to the array.
+   */
+  template<typename D>
+  inline void writeDBBytes(std::string& output, const D& d)
+  {
+    BinaryBufferWriter bin;
+    write(bin, d);
+    output = bin.strPrimaryNode();
+  }
+
+  //! Inverse of writeDBBytes
+  template<typename D>
+  inline void readDBBytes(const std::string& input, D& d)
+  {
+    BinaryBufferReader bin(input);
+    read(bin, d);
+  }
+
+
+  //! Raw packing of the arrays in writeDBBytes
+  namespace DBBytes
+  {
+    //! Whether T is laid out as just its words, which is what BinaryWriter writes
+    template<typename T>
+    inline bool rawP()
+    {
+      return sizeof(T) == 2*sizeof(REAL64);   // only used for ComplexD
+    }
+
+    //! Sizes and then n elements of T starting at p
+    template<typename T>
+    inline void pack(std::string& output, const int* dims, int ndims, const T* p, size_t n)
+    {
+      const size_t head = ndims*sizeof(int);
+
+      output.resize(head + n*sizeof(T));
+      char* q = &output[0];
+
+      std::memcpy(q, dims, head);
+      if (n > 0)
+	std::memcpy(q + head, p, n*sizeof(T));
+
+      if (! QDPUtil::big_endian())
+      {
+	QDPUtil::byte_swap(q, sizeof(int), ndims);
+	QDPUtil::byte_swap(q + head, sizeof(REAL64), n*sizeof(T)/sizeof(REAL64));
+      }
+    }
+
+    //! Read the sizes; false unless the input holds exactly that many elements of T
+    template<typename T>
+    inline bool unpackDims(int* dims, int ndims, const std::string& input)
+    {
+      const size_t head = ndims*sizeof(int);
+      if (input.size() < head)
+	return false;
+
+      std::memcpy(dims, input.data(), head);
+      if (! QDPUtil::big_endian())
+	QDPUtil::byte_swap(dims, sizeof(int), ndims);
+
+      size_t n = 1;
+      for(int i=0; i < ndims; ++i)
+      {
+	if (dims[i] < 0)
+	  return false;
+	n *= dims[i];
+      }
+      return input.size() == head + n*sizeof(T);
+    }
+
+    //! Orders (key bytes, index) pairs on the key bytes only
+    struct KeyLess
+    {
+      bool operator()(const std::pair<std::string, size_t>& a, 
+		      const std::pair<std::string, size_t>& b) const {return a.first < b.first;}
+    };
+
+    //! Whether DB has int insertBinary(key bytes, value bytes)
+    template<typename DB>
+    struct HasInsertBinary
+    {
+      typedef char Yes_t[1];
+      typedef char No_t[2];
+
+      template<typename U, int (U::*)(const std::string&, const std::string&)> struct Check;
+      template<typename U> static Yes_t& test(Check<U, &U::insertBinary>*);
+      template<typename U> static No_t&  test(...);
+
+      enum {value = (sizeof(test<DB>(0)) == sizeof(Yes_t))};
+    };
+
+    template<bool B> struct Bool_t {};
+
+    //! Insert bytes already serialized
+    template<typename DB, typename K, typename D>
+    inline int insertBytes(DB& db, const std::string& key, const std::string& val,
+			   std::pair<K,D>& p, Bool_t<true>)
+    {
+      return db.insertBinary(key, val);
+    }
+
+    //! No binary insert, so the DB serializes the pair again
+    template<typename DB, typename K, typename D>
+    inline int insertBytes(DB& db, const std::string& key, const std::string& val,
+			   std::pair<K,D>& p, Bool_t<false>)
+    {
+      return db.insert(p.first, p.second);
+    }
+
+    //! The n elements following the sizes
+    template<typename T>
+    inline void unpack(T* p, size_t n, int ndims, const std::string& input)
+    {
+      if (n == 0)
+	return;
+
+      std::memcpy(p, input.data() + ndims*sizeof(int), n*sizeof(T));
+      if (! QDPUtil::big_endian())
+	QDPUtil::byte_swap(p, sizeof(REAL64), n*sizeof(T)/sizeof(REAL64));
+    }
+  }
+
+  //! Straight from the array storage
+  inline void writeDBBytes(std::string& output, const multi1d<ComplexD>& d)
+  {
+    if (! DBBytes::rawP<ComplexD>())
+      return writeDBBytes< multi1d<ComplexD> >(output, d);
+
+    int dims[1] = {d.size()};
+    DBBytes::pack(output, dims, 1, (d.size() > 0) ? &d[0] : 0, d.size());
+  }
+
+  //! Straight from the array storage
+  inline void writeDBBytes(std::string& output, const multi2d<ComplexD>& d)
+  {
+    if (! DBBytes::rawP<ComplexD>())
+      return writeDBBytes< multi2d<ComplexD> >(output, d);
+
+    int dims[2] = {d.size2(), d.size1()};
+    size_t n = size_t(d.size2())*d.size1();
+    DBBytes::pack(output, dims, 2, (n > 0) ? &d(0,0) : 0, n);
+  }
+
+  //! Straight from the array storage
+  inline void writeDBBytes(std::string& output, const multi3d<ComplexD>& d)
+  {
+    if (! DBBytes::rawP<ComplexD>())
+      return writeDBBytes< multi3d<ComplexD> >(output, d);
+
+    int dims[3] = {d.size3(), d.size2(), d.size1()};
+    size_t n = size_t(d.size3())*d.size2()*d.size1();
+    DBBytes::pack(output, dims, 3, (n > 0) ? &d(0,0,0) : 0, n);
+  }
+
+  //! Straight into the array storage
+  inline void readDBBytes(const std::string& input, multi1d<ComplexD>& d)
+  {
+    int dims[1];
+    if (! DBBytes::rawP<ComplexD>() || ! DBBytes::unpackDims<ComplexD>(dims, 1, input))
+      return readDBBytes< multi1d<ComplexD> >(input, d);
+
+    d.resize(dims[0]);
+    if (d.size() > 0)
+      DBBytes::unpack(&d[0], d.size(), 1, input);
+  }
+
+  //! Straight into the array storage
+  inline void readDBBytes(const std::string& input, multi2d<ComplexD>& d)
+  {
+    int dims[2];
+    if (! DBBytes::rawP<ComplexD>() || ! DBBytes::unpackDims<ComplexD>(dims, 2, input))
+      return readDBBytes< multi2d<ComplexD> >(input, d);
+
+    d.resize(dims[0], dims[1]);
+    size_t n = size_t(dims[0])*dims[1];
+    if (n > 0)
+      DBBytes::unpack(&d(0,0), n, 2, input);
+  }
+
+  //! Straight into the array storage
+  inline void readDBBytes(const std::string& input, multi3d<ComplexD>& d)
+  {
+    int dims[3];
+    if (! DBBytes::rawP<ComplexD>() || ! DBBytes::unpackDims<ComplexD>(dims, 3, input))
+      return readDBBytes< multi3d<ComplexD> >(input, d);
+
+    d.resize(dims[0], dims[1], dims[2]);
+    size_t n = size_t(dims[0])*dims[1]*dims[2];
+    if (n > 0)
+      DBBytes::unpack(&d(0,0,0), n, 3, input);
+  }
+
+
   //---------------------------------------------------------------------
   //! Serializable value harness
   /*! \ingroup ferm */
@@ -84,20 +293,67 @@ namespace Chroma
     const unsigned short serialID (void) const {return 123;}
 
     void writeObject (std::string& output) const throw (SerializeException) {
-      BinaryBufferWriter bin;
-      write(bin, data());
-      output = bin.strPrimaryNode();
+      writeDBBytes(output, data());
     }
 
     void readObject (const std::string& input) throw (SerializeException) {
-      BinaryBufferReader bin(input);
-      read(bin, data());
+      readDBBytes(input, data());
     }
 
   private:
     D  data_;
   };
 
+
+  //---------------------------------------------------------------------
+  //! Insert a batch of key/value pairs in key order, one insert per pair
+  /*!
+   * \ingroup ferm
+   *
+   * A convenience loop, not a bulk or transactional insert: FILEDB, which
+   * lives in QDP++, has neither, and every pair is still a B-tree insert
+   * of its own. What it saves is work around the inserts. Each key and
+   * value is serialized once, and the pairs go in in the order of their
+   * key bytes, so that neighbouring inserts touch neighbouring pages. The
+   * sort is stable, so of several pairs with the same key the last one is
+   * still what ends up in the DB.
+   *
+   * A DB with insertBinary, like the QDP BinaryStoreDB, gets the bytes
+   * made here. Any other DB with insert(K,D) serializes each pair again.
+   * For a BinaryStoreDB every insert is collective and broadcasts its own
+   * status, so this must be called on all nodes.
+   *
+   * \return the first nonzero status of the inserts, or 0
+   */
+  template<typename DB, typename K, typename D>
+  int insertSorted(DB& db, std::vector< std::pair<K,D> >& batch)
+  {
+    typedef std::pair<std::string, size_t>  Order_t;
+    typedef DBBytes::Bool_t<DBBytes::HasInsertBinary<DB>::value>  Binary_t;
+
+    std::vector<Order_t> order(batch.size());
+    std::vector<std::string> vals(batch.size());
+    for(size_t n=0; n < batch.size(); ++n)
+    {
+      batch[n].first.writeObject(order[n].first);
+      if (DBBytes::HasInsertBinary<DB>::value)
+	batch[n].second.writeObject(vals[n]);
+      order[n].second = n;
+    }
+
+    std::stable_sort(order.begin(), order.end(), DBBytes::KeyLess());
+
+    int ret = 0;
+    for(size_t n=0; n < order.size(); ++n)
+    {
+      const size_t i = order[n].second;
+      int r = DBBytes::insertBytes(db, order[n].first, vals[i], batch[i], Binary_t());
+      if (r != 0 && ret == 0)
+	ret = r;
+    }
+    return ret;
+  }
+
 } // namespace Chroma
 
 #endif
@@ -5,76 +5,389 @@
  */
 
 #include "util/ferm/timeslice_io_cache.h"
+#include "util/info/profile_registry.h"
+#include <algorithm>
 
-namespace Chroma 
-{  
-  //----------------------------------------------------------------------------
-  // Constructor
-  TimeSliceIOCache::TimeSliceIOCache(QDP::MapObjectDisk< KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVector> >& eigen_source_)
-    : eigen_source(eigen_source_)
+namespace Chroma
+{
+  // Utility functions
+  namespace
   {
-    const int Lt = Layout::lattSize()[Nd-1];
+#ifndef QDP_IS_QDPJIT
+    //! Copy v on a subset into buf as [site][color][re,im]
+    template<typename T, typename V>
+    void packSlice(T* buf, const V& v, const Subset& sub)
+    {
+      const int* tab = sub.siteTable().slice();
+
+      for(int j=0; j < sub.numSiteTable(); ++j)
+      {
+	int site = tab[j];
+	T* p = buf + size_t(j)*2*Nc;
+
+	for(int c=0; c < Nc; ++c)
+	{
+	  p[2*c]   = v.elem(site).elem().elem(c).real();
+	  p[2*c+1] = v.elem(site).elem().elem(c).imag();
+	}
+      }
+    }
+
+    //! Copy buf back into v on a subset
+    template<typename T, typename V>
+    void unpackSlice(V& v, const T* buf, const Subset& sub)
+    {
+      const int* tab = sub.siteTable().slice();
+
+      for(int j=0; j < sub.numSiteTable(); ++j)
+      {
+	int site = tab[j];
+	const T* p = buf + size_t(j)*2*Nc;
+
+	for(int c=0; c < Nc; ++c)
+	{
+	  v.elem(site).elem().elem(c).real() = p[2*c];
+	  v.elem(site).elem().elem(c).imag() = p[2*c+1];
+	}
+      }
+    }
+
+    template<typename T>
+    struct DotArgs
+    {
+      const T*       vecs;     /*!< the vectors, len apart */
+      const double*  psi;
+      size_t         len;
+      double*        res;      /*!< [colorvec][re,im] */
+    };
+
+    //! <v_i|psi> for the vectors [lo,hi)
+    template<typename T>
+    void dotLoop(int lo, int hi, int myId, DotArgs<T>* a)
+    {
+      for(int i=lo; i < hi; ++i)
+      {
+	const T* v = a->vecs + size_t(i)*a->len;
+	double re = 0, im = 0;
+
+	for(size_t k=0; k < a->len; k += 2)
+	{
+	  double vr = v[k], vi = v[k+1];
+	  double pr = a->psi[k], pi = a->psi[k+1];
+	  re += vr*pr + vi*pi;
+	  im += vr*pi - vi*pr;
+	}
+
+	a->res[2*i]   = re;
+	a->res[2*i+1] = im;
+      }
+    }
 
-    // Figure out how many vectors are in the source
-    // We know time slice 0 has to be a part of the sources
-    num_vecs = 0;
-    while(1)
+    //! Inner products of all the vectors of a slice with psi, summed over nodes
+    template<typename T, typename V>
+    void sliceInnerProducts(multi1d<ComplexD>& res, const std::vector<T>& vecs, int num_vecs,
+			    const V& psi, const Subset& sub)
     {
-      KeyTimeSliceColorVec_t key;
-      key.t_slice  = 0;
-      key.colorvec = num_vecs;
+      const size_t len = size_t(sub.numSiteTable())*2*Nc;
+      std::vector<double> r(2*num_vecs, 0.0);
 
-      if (! eigen_source.exist(key)) {break;}
+      if (len > 0)
+      {
+	std::vector<double> p(len);
+	packSlice(&(p[0]), psi, sub);
 
-      ++num_vecs;
+	DotArgs<T> a = {&(vecs[0]), &(p[0]), len, &(r[0])};
+	dispatch_to_threads(num_vecs, a, dotLoop<T>);
+      }
+
+      QDPInternal::globalSumArray(&(r[0]), 2*num_vecs);
+
+      res.resize(num_vecs);
+      for(int i=0; i < num_vecs; ++i)
+	res[i] = cmplx(RealD(r[2*i]), RealD(r[2*i+1]));
     }
+#endif
+  }
 
-    if (num_vecs == 0)
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  TimeSliceIOCache::TimeSliceIOCache(MODS_t& eigen_source_, int num_vecs_,
+				     size_t max_bytes_, bool single_prec_)
+    : eigen_source(eigen_source_), time_slice_set(Nd-1), num_vecs(num_vecs_),
+      t_offset(0), lt_orig(Layout::lattSize()[Nd-1]), single_prec(single_prec_), zero_vecs(false),
+      max_bytes(max_bytes_), peak_bytes(0), use_clock(0), hits(0), misses(0), evictions(0), prefetches(0), read_secs(0)
+  {
+#ifdef QDP_IS_QDPJIT
+    single_prec = true;
+#endif
+
+    // The same on all nodes, so the eviction decisions agree
+    const size_t slice_sites = Layout::sitesOnNode() / Layout::subgridLattSize()[Nd-1];
+    slice_bytes = size_t(num_vecs) * slice_sites * Nc * 2 * (single_prec ? sizeof(float) : sizeof(double));
+
+    if (max_bytes > 0 && max_bytes < slice_bytes)
     {
-      QDPIO::cerr << __func__ << ": this is bad - did not find any eigenvectors in eigen_source\n";
+      QDPIO::cerr << __func__ << ": cache budget of " << max_bytes << " bytes cannot hold a single time slice of "
+		  << slice_bytes << " bytes" << std::endl;
       QDP_abort(1);
     }
-    else
+  }
+
+
+  // Time offset into the files
+  void TimeSliceIOCache::setTimeOffset(int t_offset_, int lt_orig_)
+  {
+    if (! slices.empty())
     {
-      QDPIO::cout << __func__ << ": found in eigenstd::vector source num_vecs= " << num_vecs << std::endl;
+      QDPIO::cerr << __func__ << ": cannot change the time offset of a cache in use" << std::endl;
+      QDP_abort(1);
     }
 
-    eigen_cache.resize(num_vecs);
-    cache_marker.resize(Lt,num_vecs);
+    t_offset = t_offset_;
+    lt_orig  = lt_orig_;
+  }
+
+
+  // Key in the files
+  KeyTimeSliceColorVec_t TimeSliceIOCache::makeKey(int t, int colorvec) const
+  {
+    return KeyTimeSliceColorVec_t((t + t_offset) % lt_orig, colorvec);
+  }
+
+
+  // Make a slice resident
+  void TimeSliceIOCache::fetch(int t)
+  {
+    lookup(t);
+  }
+
+
+  // Read a slice ahead of its use
+  bool TimeSliceIOCache::prefetch(int t, int keep)
+  {
+    if (slices.find(t) != slices.end())
+      return true;
+
+    // The least recently used slices go first, so the keep most recent
+    // survive as long as the budget holds more than keep slices
+    if (max_bytes > 0 && max_bytes/slice_bytes <= size_t(keep))
+      return false;
+
+    ++use_clock;
+    ++prefetches;
+
+    makeRoom();
+
+    Slice& s = slices[t];
+    readSlice(s, t);
+    s.last_use = use_clock;
+
+    peak_bytes = std::max(peak_bytes, slices.size()*slice_bytes);
+
+    return true;
+  }
+
+
+  // The resident slice
+  TimeSliceIOCache::Slice& TimeSliceIOCache::lookup(int t)
+  {
+    ++use_clock;
 
-    for(int n=0; n < num_vecs; ++n)
+    std::map<int, Slice>::iterator p = slices.find(t);
+    if (p != slices.end())
     {
-      eigen_cache[n] = zero;
-      
-      for(int t=0; t < Lt; ++t)
-	cache_marker(t,n) = false;
+      ++hits;
+      p->second.last_use = use_clock;
+      return p->second;
     }
+
+    makeRoom();
+
+    Slice& s = slices[t];
+    readSlice(s, t);
+    s.last_use = use_clock;
+
+    peak_bytes = std::max(peak_bytes, slices.size()*slice_bytes);
+
+    return s;
   }
 
 
-  // Get a std::vector
-  LatticeColorVector& TimeSliceIOCache::getVec(int colorvec)
+  // Read all the vectors of a slice
+  void TimeSliceIOCache::readSlice(Slice& s, int t)
   {
-    return eigen_cache[colorvec];
+    ProfileScope scope("colorvec_read");
+    profileBytes(slice_bytes);
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    ++misses;
+
+    const Subset& sub = getSet()[t];
+
+#ifndef QDP_IS_QDPJIT
+    const size_t len = size_t(sub.numSiteTable())*2*Nc;
+
+    if (single_prec)
+      s.f.assign(num_vecs*len, 0.0f);
+    else
+      s.d.assign(num_vecs*len, 0.0);
+#else
+    s.sub.clear();
+    s.sub.reserve(num_vecs);
+#endif
+
+    // No need to initialize with 'zero' - only the slice is kept
+    LatticeColorVectorF vec;
+    if (zero_vecs)
+      vec = zero;
+
+    for(int colorvec=0; colorvec < num_vecs; ++colorvec)
+    {
+      if (! zero_vecs)
+      {
+	TimeSliceIO<LatticeColorVectorF> time_slice_io(vec, t);
+	eigen_source.get(makeKey(t, colorvec), time_slice_io);
+      }
+
+#ifndef QDP_IS_QDPJIT
+      if (len == 0) {continue;}
+
+      if (single_prec)
+	packSlice(&(s.f[colorvec*len]), vec, sub);
+      else
+	packSlice(&(s.d[colorvec*len]), vec, sub);
+#else
+      s.sub.push_back(SubLatticeColorVectorF(sub, vec));
+#endif
+    }
+
+    swatch.stop();
+    read_secs += swatch.getTimeInSeconds();
+
+    QDPIO::cout << __func__ << ": read t_slice= " << t << "  num_vecs= " << num_vecs
+		<< "  time= " << swatch.getTimeInSeconds() << " secs" << std::endl;
   }
 
-  // Get a std::vector
-  LatticeColorVector& TimeSliceIOCache::getVec(int t_actual, int colorvec)
+
+  // Drop least recently used slices until another one fits
+  void TimeSliceIOCache::makeRoom()
   {
-    // If not in cache, then retrieve
-    if (! cache_marker(t_actual,colorvec))
+    if (max_bytes == 0)
+      return;
+
+    while ((slices.size() + 1)*slice_bytes > max_bytes && slices.size() > 0)
     {
-      KeyTimeSliceColorVec_t key_vec;
-      key_vec.t_slice  = t_actual;
-      key_vec.colorvec = colorvec;
+      std::map<int, Slice>::iterator victim = slices.begin();
 
-      TimeSliceIO<LatticeColorVector> time_slice_io(eigen_cache[colorvec], t_actual);
+      for(std::map<int, Slice>::iterator p = slices.begin(); p != slices.end(); ++p)
+      {
+	if (p->second.last_use < victim->second.last_use)
+	  victim = p;
+      }
 
-      eigen_source.get(key_vec, time_slice_io);
-      cache_marker(t_actual,colorvec) = true;
+      slices.erase(victim);
+      ++evictions;
     }
+  }
+
+
+  // Copy a vector out
+  void TimeSliceIOCache::getVec(LatticeColorVectorF& v, int t, int colorvec)
+  {
+    Slice& s = lookup(t);
+
+#ifndef QDP_IS_QDPJIT
+    const Subset& sub = getSet()[t];
+    const size_t len = size_t(sub.numSiteTable())*2*Nc;
+
+    if (len == 0) {return;}
+
+    if (single_prec)
+      unpackSlice(v, &(s.f[colorvec*len]), sub);
+    else
+      unpackSlice(v, &(s.d[colorvec*len]), sub);
+#else
+    v = s.sub[colorvec];
+#endif
+  }
+
+
+  // Copy a vector out
+  void TimeSliceIOCache::getVec(LatticeColorVectorD& v, int t, int colorvec)
+  {
+    Slice& s = lookup(t);
+
+#ifndef QDP_IS_QDPJIT
+    const Subset& sub = getSet()[t];
+    const size_t len = size_t(sub.numSiteTable())*2*Nc;
+
+    if (len == 0) {return;}
+
+    if (single_prec)
+      unpackSlice(v, &(s.f[colorvec*len]), sub);
+    else
+      unpackSlice(v, &(s.d[colorvec*len]), sub);
+#else
+    v = s.sub[colorvec];
+#endif
+  }
+
+
+  // Inner products with all the vectors of a slice
+  void TimeSliceIOCache::innerProducts(multi1d<ComplexD>& res, int t, const LatticeColorVectorF& psi)
+  {
+    Slice& s = lookup(t);
+
+#ifndef QDP_IS_QDPJIT
+    if (single_prec)
+      sliceInnerProducts(res, s.f, num_vecs, psi, getSet()[t]);
+    else
+      sliceInnerProducts(res, s.d, num_vecs, psi, getSet()[t]);
+#else
+    res.resize(num_vecs);
+    for(int i=0; i < num_vecs; ++i)
+      res[i] = innerProduct(s.sub[i], psi);
+#endif
+  }
+
+
+  // Inner products with all the vectors of a slice
+  void TimeSliceIOCache::innerProducts(multi1d<ComplexD>& res, int t, const LatticeColorVectorD& psi)
+  {
+    Slice& s = lookup(t);
+
+#ifndef QDP_IS_QDPJIT
+    if (single_prec)
+      sliceInnerProducts(res, s.f, num_vecs, psi, getSet()[t]);
+    else
+      sliceInnerProducts(res, s.d, num_vecs, psi, getSet()[t]);
+#else
+    res.resize(num_vecs);
+    for(int i=0; i < num_vecs; ++i)
+      res[i] = innerProduct(s.sub[i], psi);
+#endif
+  }
+
+
+  //----------------------------------------------------------------------------
+  // Cache statistics output
+  void write(XMLWriter& xml, const std::string& path, const TimeSliceIOCache& cache)
+  {
+    push(xml, path);
+
+    write(xml, "budget_mb", cache.maxBytes()/(1024.0*1024.0));
+    write(xml, "hits", int(cache.numHits()));
+    write(xml, "misses", int(cache.numMisses()));
+    write(xml, "evictions", int(cache.numEvictions()));
+    write(xml, "prefetches", int(cache.numPrefetches()));
+    write(xml, "peak_mb", cache.peakBytes()/(1024.0*1024.0));
+    write(xml, "read_secs", cache.readTime());
 
-    return eigen_cache[colorvec];
+    pop(xml);
   }
 
 } // namespace Chroma
@@ -9,43 +9,165 @@
 #define __timeslice_io_cache_h__
 
 #include "chromabase.h"
-#include "qdp_map_obj_disk.h"
+#include "qdp_map_obj_disk_multiple.h"
 #include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ft/time_slice_set.h"
 
-namespace Chroma 
-{ 
+#include <vector>
+#include <map>
+
+namespace Chroma
+{
   /*! \ingroup inlinehadron */
   //----------------------------------------------------------------------------
   //----------------------------------------------------------------------------
   //! Cache for holding time slice eigenvectors
+  /*!
+   * Colorvectors are kept per time slice: all num_vecs vectors of a slice
+   * are read together the first time any of them is asked for, and only
+   * the sites of that slice are stored, one contiguous buffer per slice.
+   * With a byte budget the least recently used slice is dropped to make
+   * room for a new one. The vectors can be held in single precision, which
+   * is what the colorvec files hold anyway.
+   *
+   * All the slice bookkeeping is the same on every node, so the collective
+   * reads stay in step. In QDP-JIT builds the slices are held as
+   * sublattice objects in single precision.
+   */
   class TimeSliceIOCache
   {
   public:
+    //! The colorvec files
+    typedef QDP::MapObjectDiskMultiple< KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVectorF> > MODS_t;
+
     //! Constructor
-    TimeSliceIOCache(QDP::MapObjectDisk<KeyTimeSliceColorVec_t,LatticeColorVector>& eigen_source_);
+    /*!
+     * \param num_vecs     vectors used on each time slice
+     * \param max_bytes    budget for the cached slices on this node, 0 for no limit
+     * \param single_prec  hold the vectors in single precision
+     */
+    TimeSliceIOCache(MODS_t& eigen_source_, int num_vecs_,
+		     size_t max_bytes = 0, bool single_prec = false);
 
     //! Virtual destructor
     virtual ~TimeSliceIOCache() {}
 
+    //! Time slice t of the lattice is time slice (t + t_offset) % lt_orig in the files
+    void setTimeOffset(int t_offset_, int lt_orig_);
+
+    //! Timing mode: do not read, all the vectors are zero
+    void setZeroVecs(bool zero) {zero_vecs = zero;}
+
     //! Get number of vectors
-    virtual int getNumVecs() const {return num_vecs;}
+    int getNumVecs() const {return num_vecs;}
+
+    //! The time slice set
+    const Set& getSet() const {return time_slice_set.getSet();}
+
+    //! Make time slice t resident, reading all its vectors on a miss
+    void fetch(int t);
+
+    //! Read time slice t ahead of its use. Collective
+    /*!
+     * The slice is read only if it can be made to fit without evicting one
+     * of the keep most recently used slices, so reading the next block of
+     * slices never drops the block in use. The decision is the same on all
+     * nodes.
+     *
+     * \return true if the slice is resident
+     */
+    bool prefetch(int t, int keep = 2);
+
+    //! Copy a vector into v on time slice t. The rest of v is untouched.
+    void getVec(LatticeColorVectorF& v, int t, int colorvec);
+
+    //! Copy a vector into v on time slice t. The rest of v is untouched.
+    void getVec(LatticeColorVectorD& v, int t, int colorvec);
+
+    //! res[i] = <v_i|psi> on time slice t for all the vectors, summed over nodes
+    void innerProducts(multi1d<ComplexD>& res, int t, const LatticeColorVectorF& psi);
+
+    //! res[i] = <v_i|psi> on time slice t for all the vectors, summed over nodes
+    void innerProducts(multi1d<ComplexD>& res, int t, const LatticeColorVectorD& psi);
+
+    //! Requests served from the cache
+    unsigned long numHits() const {return hits;}
+
+    //! Time slices read
+    unsigned long numMisses() const {return misses;}
+
+    //! Time slices evicted
+    unsigned long numEvictions() const {return evictions;}
 
-    //! Get the whole std::vector
-    virtual LatticeColorVector& getVec(int colorvec);
+    //! Time slices read ahead of their use
+    unsigned long numPrefetches() const {return prefetches;}
 
-    //! Get a std::vector
-    virtual LatticeColorVector& getVec(int t_actual, int colorvec);
+    //! High water mark of the cached slices on this node
+    size_t peakBytes() const {return peak_bytes;}
+
+    //! The budget, 0 for no limit
+    size_t maxBytes() const {return max_bytes;}
+
+    //! Seconds spent reading
+    double readTime() const {return read_secs;}
+
+  private:
+    //! The vectors of one time slice
+    struct Slice
+    {
+#ifndef QDP_IS_QDPJIT
+      std::vector<float>   f;      /*!< [colorvec][site][color][re,im], single precision */
+      std::vector<double>  d;      /*!< same, double precision */
+#else
+      std::vector<SubLatticeColorVectorF>  sub;
+#endif
+      unsigned long        last_use;
+    };
+
+    //! The resident slice t
+    Slice& lookup(int t);
+
+    //! Read all the vectors of slice t
+    void readSlice(Slice& s, int t);
+
+    //! Drop least recently used slices until another one fits
+    void makeRoom();
+
+    //! Key in the files
+    KeyTimeSliceColorVec_t makeKey(int t, int colorvec) const;
+
+    // Hide copies
+    TimeSliceIOCache(const TimeSliceIOCache&);
+    void operator=(const TimeSliceIOCache&);
 
   private:
     // Arguments
-    QDP::MapObjectDisk< KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVector> >& eigen_source;
+    MODS_t&         eigen_source;
+    TimeSliceSet    time_slice_set;
+    int             num_vecs;
+    int             t_offset;
+    int             lt_orig;
+    bool            single_prec;
+    bool            zero_vecs;
 
     // Local
-    multi1d<LatticeColorVector>  eigen_cache;
-    multi2d<bool>                cache_marker;
-    int                          num_vecs;
+    std::map<int, Slice>  slices;
+
+    size_t          slice_bytes;
+    size_t          max_bytes;
+    size_t          peak_bytes;
+
+    unsigned long   use_clock;
+    unsigned long   hits;
+    unsigned long   misses;
+    unsigned long   evictions;
+    unsigned long   prefetches;
+    double          read_secs;
   };
 
+  //! Cache statistics output
+  void write(XMLWriter& xml, const std::string& path, const TimeSliceIOCache& cache);
+
 }
 
 #endif
@@ -0,0 +1,156 @@
+/*! \file
+ *  \brief Fast Fourier transform of lattice fields
+ */
+
+#include "util/ft/lattice_fft.h"
+
+namespace Chroma
+{
+
+  // Utility functions
+  namespace
+  {
+    //! Prime factors of n
+    std::vector<int> primeFactors(int n)
+    {
+      std::vector<int> f;
+
+      for(int p=2; p*p <= n; ++p)
+	while (n % p == 0)
+	{
+	  f.push_back(p);
+	  n /= p;
+	}
+
+      if (n > 1)
+	f.push_back(n);
+
+      return f;
+    }
+
+
+    //! Gather for term t of a Stockham stage along dir
+    /*!
+     * After the stages so far, position p = j + m*k along dir holds the
+     * length n = L/m transform of the stride m sequence starting at j.
+     * A stage of radix r takes m -> m/r, and the new value at
+     * p = j + m*(k1 + (n/r)*k2) needs the old values at j + m*(t + r*k1)
+     * for all t < r. Term t fetches t' = (t + k2) % r, which makes every
+     * term a permutation of the sites.
+     */
+    class StageFunc : public MapFunc
+    {
+    public:
+      StageFunc(int dir_, int L_, int m_, int r_, int t_) :
+	dir(dir_), m(m_), r(r_), t(t_), nprev(L_/(m_*r_)) {}
+
+      //! Source of the site x (sign > 0) or its inverse (sign < 0)
+      multi1d<int> operator()(const multi1d<int>& x, int sign) const
+      {
+	multi1d<int> y = x;
+	const int p = x[dir];
+	const int j = p % m;
+
+	if (sign > 0)
+	{
+	  const int k  = p / m;
+	  const int k1 = k % nprev;
+	  const int k2 = k / nprev;
+	  y[dir] = j + m*((t + k2) % r + r*k1);
+	}
+	else
+	{
+	  const int q  = p / m;
+	  const int tp = q % r;
+	  const int k1 = q / r;
+	  const int k2 = (tp - t + r) % r;
+	  y[dir] = j + m*(k1 + nprev*k2);
+	}
+
+	return y;
+      }
+
+    private:
+      int dir;
+      int m;
+      int r;
+      int t;
+      int nprev;
+    };
+  }
+
+
+  // Set up the stages of every transformed direction
+  LatticeFFT::LatticeFFT(const multi1d<bool>& dirs)
+  {
+    START_CODE();
+
+    if (dirs.size() != Nd)
+    {
+      QDPIO::cerr << __func__ << ": dirs not of size = " << Nd << std::endl;
+      QDP_abort(1);
+    }
+
+    const multi1d<int>& nrow = Layout::lattSize();
+    const double twopi = 6.283185307179586476925286;
+
+    vol = 1;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (! dirs[mu])
+	continue;
+
+      const int L = nrow[mu];
+      vol *= L;
+
+      std::vector<int> radix = primeFactors(L);
+      int m = L;
+
+      for(int s=0; s < radix.size(); ++s)
+      {
+	const int r = radix[s];
+	m /= r;
+
+	const int n     = L / m;
+	const int nprev = n / r;
+
+	Stage stage;
+	stage.maps.resize(r);
+	stage.phase.resize(r);
+#if BASE_PRECISION==32
+	stage.phase_d.resize(r);
+#endif
+
+	for(int t=0; t < r; ++t)
+	{
+	  stage.maps[t] = new Map;
+	  stage.maps[t]->make(StageFunc(mu, L, m, r, t));
+
+	  // The phase only depends on the coordinate along mu
+	  LatticeComplexD phase = zero;
+	  for(int p=0; p < L; ++p)
+	  {
+	    const int k  = p / m;
+	    const int tp = (t + k / nprev) % r;
+	    const double arg = -twopi * double((tp * k) % n) / double(n);
+
+	    phase = where(Layout::latticeCoordinate(mu) == p,
+			  cmplx(Real64(cos(arg)), Real64(sin(arg))),
+			  phase);
+	  }
+
+	  stage.phase[t] = phase;
+#if BASE_PRECISION==32
+	  stage.phase_d[t] = phase;
+#endif
+	}
+
+	stages.push_back(stage);
+      }
+    }
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,98 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Fast Fourier transform of lattice fields
+ */
+
+#ifndef __lattice_fft_h__
+#define __lattice_fft_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Fast Fourier transform of lattice fields
+  /*!
+   * \ingroup ft
+   *
+   * Transforms a lattice field along a chosen set of directions,
+   *
+   *   f(p) = sum_x exp(-isign i p.x) f(x) ,   p_mu = 2 pi n_mu / L_mu
+   *
+   * with the momentum n stored at the site of coordinate n. There is no
+   * normalisation, so a forward and a backward transform multiply by the
+   * number of sites in the transformed directions.
+   *
+   * Each direction is done as a mixed radix Stockham FFT over the prime
+   * factors of its length. A stage of radix r is r gathers with QDP maps,
+   * each multiplied by a precomputed phase field, so nothing has to be
+   * moved onto one node and a transform over L sites costs of order
+   * L*sum(prime factors) rather than L^2. Directions left out are not
+   * mixed, e.g. a transform over the spatial directions works on every
+   * time slice independently. The phases are kept in the precision of the
+   * field, so a double precision field is transformed in double precision
+   * whatever the base precision is.
+   */
+  class LatticeFFT
+  {
+  public:
+    //! Transform along every direction mu with dirs[mu] true
+    LatticeFFT(const multi1d<bool>& dirs);
+
+    //! In place transform, isign = +1 forward, -1 backward
+    template<typename T>
+    void operator()(T& f, int isign) const
+    {
+      T tmp;
+
+      for(int n=0; n < stages.size(); ++n)
+      {
+	const Stage& s = stages[n];
+
+	const typename WordType<T>::Type_t w = 0;
+
+	if (isign > 0)
+	{
+	  tmp = s.phaseOf(0, w) * (*s.maps[0])(f);
+	  for(int t=1; t < s.maps.size(); ++t)
+	    tmp += s.phaseOf(t, w) * (*s.maps[t])(f);
+	}
+	else
+	{
+	  tmp = conj(s.phaseOf(0, w)) * (*s.maps[0])(f);
+	  for(int t=1; t < s.maps.size(); ++t)
+	    tmp += conj(s.phaseOf(t, w)) * (*s.maps[t])(f);
+	}
+
+	f = tmp;
+      }
+    }
+
+    //! Number of sites in the transformed directions
+    int volume() const {return vol;}
+
+  private:
+    //! One radix r stage: f(x) <- sum_t phase[t](x) f(maps[t](x))
+    struct Stage
+    {
+      std::vector< Handle<Map> >    maps;
+      std::vector<LatticeComplex>   phase;
+#if BASE_PRECISION==32
+      std::vector<LatticeComplexD>  phase_d;   /*!< for double precision fields */
+
+      const LatticeComplex&  phaseOf(int t, REAL32) const {return phase[t];}
+      const LatticeComplexD& phaseOf(int t, REAL64) const {return phase_d[t];}
+#else
+      const LatticeComplex&  phaseOf(int t, REAL) const {return phase[t];}
+#endif
+    };
+
+    std::vector<Stage>  stages;
+    int                 vol;
+  };
+
+}  // end namespace Chroma
+
+#endif
@@ -98,8 +98,8 @@
 //
 
 #include "util/ft/sftmom.h"
-#include "util/ft/single_phase.h"
 #include "qdp_util.h"                 // part of QDP++, for crtesn()
+#include <algorithm>
 
 namespace Chroma 
 {
@@ -190,14 +190,23 @@ namespace Chroma
     num_mom = moms.size2();
     mom_list = moms;
 
-    phases.resize(num_mom);
-
+    mom_degen.resize(num_mom);
+    mom_degen = 0;
 
-    for (int m = 0 ; m < num_mom ; ++m)
+    if (moms.size1() != int(dir_mu.size()))
     {
-      phases[m] = singlePhase(orig, mom_list[m], decay_dir);
+      QDPIO::cerr << __func__ << ": momenta not of size = " << dir_mu.size() << std::endl;
+      QDP_abort(1);
     }
 
+    // One term per momentum
+    term_mom.clear();
+    term_comp.clear();
+
+    for (int m = 0 ; m < num_mom ; ++m)
+      addTerm(m, mom_list[m]);
+
+    makeTables();
   }
 
   SftMom::SftMom(int mom2_max, multi1d<int> origin_offset_, bool avg_mom,
@@ -331,15 +340,10 @@ namespace Chroma
       }
     }
 
-    // Now resize and initialize the Fourier phase table.  Then, loop over
-    // allowed momenta, optionally averaging over equivalent momenta.
-    phases.resize(num_mom) ;
-    phases = 0. ;
-
-    // Coordinates for sink momenta
-    multi1d<LatticeInteger> my_coord(Nd);
-    for (int mu=0; mu < Nd; ++mu)
-      my_coord[mu] = Layout::latticeCoordinate(mu);
+    // Now loop over allowed momenta, optionally averaging over equivalent
+    // momenta, and record the terms that make up each phase.
+    term_mom.clear();
+    term_comp.clear();
 
     // Keep track of |mom| degeneracy for averaging
     mom_degen.resize(num_mom);
@@ -425,36 +429,139 @@ namespace Chroma
       } // end if (avg_equiv_mom)
 
       //
-      // Build the phase. 
+      // Record the phase. 
       // RGE: the origin_offset works with or without momentum averaging
       //
+      addTerm(mom_num, mom);
+
+      // increment mom_num for next valid momenta
+      ++mom_num ;
+
+    } // end for (int n=0; n < mom_vol; ++n)
+
+    // Averaging is finished by dividing by mom_degen
+    // Momentum averaging works even in the presence of an origin_offset
+    makeTables();
+  }
+
+
+  // Add one momentum to the phase of mom_num
+  void
+  SftMom::addTerm(int mom_num, const multi1d<int>& mom)
+  {
+    term_mom.push_back(mom_num);
+    for(int j=0; j < mom.size(); ++j)
+      term_comp.push_back(mom[j]);
+  }
+
+
+  // Per-direction phase tables and local site coordinates
+  void
+  SftMom::makeTables()
+  {
+    phases.resize(0);
+    phases_made = false;
+    fft_made = false;
+
+    dir_mu.clear();
+    for(int mu=0; mu < Nd; ++mu)
+      if (mu != decay_dir)
+	dir_mu.push_back(mu);
+
+    const int ndir  = dir_mu.size();
+    const int nterm = term_mom.size();
+
+    // exp(i 2 pi p (x - x0)/L) for every component p in use and every x
+    const double twopi = 6.283185307179586476925286;
+
+    dir_pmin.resize(ndir);
+    dir_off.resize(ndir);
+    phase_table.clear();
+
+    for(int j=0; j < ndir; ++j)
+    {
+      const int mu = dir_mu[j];
+      const int L  = Layout::lattSize()[mu];
+
+      int pmin = 0, pmax = 0;
+      for(int k=0; k < nterm; ++k)
+      {
+	pmin = std::min(pmin, term_comp[k*ndir+j]);
+	pmax = std::max(pmax, term_comp[k*ndir+j]);
+      }
+
+      dir_pmin[j] = pmin;
+      dir_off[j]  = phase_table.size();
+      phase_table.resize(phase_table.size() + 2*(pmax-pmin+1)*L);
+
+      for(int p=pmin; p <= pmax; ++p)
+	for(int x=0; x < L; ++x)
+	{
+	  double arg = twopi * double(p) * double(x - origin_offset[mu]) / double(L);
+	  double* e  = &(phase_table[dir_off[j] + 2*((p-pmin)*L + x)]);
+	  e[0] = std::cos(arg);
+	  e[1] = std::sin(arg);
+	}
+    }
+
+#if ! defined(QDP_IS_QDPJIT)
+    // The coordinates of the local sites in the momentum directions and their subset
+    const int nsites = Layout::sitesOnNode();
+    site_coord.resize(nsites*(ndir+1));
+
+    multi1d<LatticeInteger> my_coord(Nd);
+    for (int mu=0; mu < Nd; ++mu)
+      my_coord[mu] = Layout::latticeCoordinate(mu);
+
+    for(int site=0; site < nsites; ++site)
+    {
+      int* c = &(site_coord[site*(ndir+1)]);
+      for(int j=0; j < ndir; ++j)
+	c[j] = my_coord[dir_mu[j]].elem(site).elem().elem().elem();
+
+      c[ndir] = (decay_dir < 0 || decay_dir >= Nd) ? 0 : my_coord[decay_dir].elem(site).elem().elem().elem();
+    }
+#endif
+  }
+
+
+  // Build the lattice phase fields
+  void
+  SftMom::makePhases() const
+  {
+    phases.resize(num_mom) ;
+    phases = 0. ;
+
+    // Coordinates for sink momenta
+    multi1d<LatticeInteger> my_coord(Nd);
+    for (int mu=0; mu < Nd; ++mu)
+      my_coord[mu] = Layout::latticeCoordinate(mu);
+
+    const int ndir = dir_mu.size();
+
+    for(int k=0; k < term_mom.size(); ++k)
+    {
       LatticeReal p_dot_x ;
       p_dot_x = 0. ;
 
-      int j = 0;
-      for(int mu = 0; mu < Nd; ++mu) {
+      for(int j=0; j < ndir; ++j) {
 	const Real twopi = 6.283185307179586476925286;
-
-	if (mu == j_decay) continue ;
+	const int mu = dir_mu[j];
 
 	p_dot_x += LatticeReal(my_coord[mu] - origin_offset[mu]) * twopi *
-          Real(mom[j]) / Layout::lattSize()[mu];
-	++j ;
-      } // end for(mu)
-
-      phases[mom_num] += cmplx(cos(p_dot_x), sin(p_dot_x)) ;
-
-      // increment mom_num for next valid momenta
-      ++mom_num ;
+          Real(term_comp[k*ndir+j]) / Layout::lattSize()[mu];
+      }
 
-    } // end for (int n=0; n < mom_vol; ++n)
+      phases[term_mom[k]] += cmplx(cos(p_dot_x), sin(p_dot_x)) ;
+    }
 
     // Finish averaging
-    // Momentum averaging works even in the presence of an origin_offset
     if (avg_equiv_mom) {
       for (int mom_num=0; mom_num < num_mom; ++mom_num)
 	phases[mom_num] /= mom_degen[mom_num] ;
     }
+
+    phases_made = true;
   }
 
 
@@ -520,83 +627,414 @@ namespace Chroma
     return -1;
   }
 
+  // Slow phase field version of sft
+  template<typename T>
   multi2d<DComplex>
-  SftMom::sft(const LatticeComplex& cf) const
+  SftMom::sftPhases(const T& cf, int subset_color) const
   {
+    if (! phases_made)
+      makePhases();
+
     multi2d<DComplex> hsum(num_mom, sft_set.numSubsets()) ;
 
     for (int mom_num=0; mom_num < num_mom; ++mom_num)
-      hsum[mom_num] = sumMulti(phases[mom_num]*cf, sft_set) ;
+    {
+      if (subset_color < 0)
+	hsum[mom_num] = sumMulti(phases[mom_num]*cf, sft_set) ;
+      else
+      {
+	hsum[mom_num] = zero;
+	hsum[mom_num][subset_color] = sum(phases[mom_num]*cf, sft_set[subset_color]);
+      }
+    }
 
     return hsum ;
   }
 
-  multi2d<DComplex>
-  SftMom::sft(const LatticeComplex& cf, int subset_color) const
+
+#if ! defined(QDP_IS_QDPJIT)
+  // Anonymous namespace
+  namespace
   {
-    int length = sft_set.numSubsets();
-    multi2d<DComplex> hsum(num_mom, length);
+    //! Value of a field at a site as a complex number
+    inline void siteValue(const LatticeComplex& cf, int site, double& re, double& im)
+    {
+      re = cf.elem(site).elem().elem().real();
+      im = cf.elem(site).elem().elem().imag();
+    }
 
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
+    inline void siteValue(const LatticeReal& cf, int site, double& re, double& im)
     {
-      hsum[mom_num] = zero;
-      hsum[mom_num][subset_color] = sum(phases[mom_num]*cf, sft_set[subset_color]);
+      re = cf.elem(site).elem().elem().elem();
+      im = 0;
     }
 
-    return hsum ;
+#if BASE_PRECISION==32
+    inline void siteValue(const LatticeComplexD& cf, int site, double& re, double& im)
+    {
+      re = cf.elem(site).elem().elem().real();
+      im = cf.elem(site).elem().elem().imag();
+    }
+#endif
+
+    //! Arguments of the one pass projection
+    template<typename T>
+    struct SftArgs
+    {
+      const T&        cf;
+      const int*      sites;       /*!< site table, or all local sites if null */
+      const int*      site_coord;  /*!< [site][dir] coordinates, then the subset */
+      const double*   table;       /*!< per-direction phase tables */
+      const int*      term_row;    /*!< [term][dir] start of the term's row in table */
+      int             ndir;
+      int             nterm;
+      int             nslot;       /*!< slots per thread, 1 for a single subset */
+      double*         acc;         /*!< [thread][slot][term][re,im] */
+    };
+
+    //! Accumulate cf(x) exp(i p.x) of every term over the sites [lo,hi)
+    template<typename T>
+    void sftSiteLoop(int lo, int hi, int myId, SftArgs<T>* a)
+    {
+      const int ndir  = a->ndir;
+      const int nterm = a->nterm;
+      double* acc = a->acc + size_t(myId)*a->nslot*nterm*2;
+
+      for(int i=lo; i < hi; ++i)
+      {
+	const int site = (a->sites != 0) ? a->sites[i] : i;
+	const int* c = a->site_coord + site*(ndir+1);
+
+	double re, im;
+	siteValue(a->cf, site, re, im);
+
+	double* s = acc + ((a->nslot > 1) ? c[ndir]*nterm*2 : 0);
+
+	for(int k=0; k < nterm; ++k)
+	{
+	  // The phase is a product of one table entry per direction
+	  const int* row = a->term_row + k*ndir;
+	  double pr = re, pi = im;
+	  for(int j=0; j < ndir; ++j)
+	  {
+	    const double* e = a->table + row[j] + 2*c[j];
+	    double tr = pr*e[0] - pi*e[1];
+	    pi = pr*e[1] + pi*e[0];
+	    pr = tr;
+	  }
+
+	  s[2*k]   += pr;
+	  s[2*k+1] += pi;
+	}
+      }
+    }
   }
 
-  multi2d<DComplex>
-  SftMom::sft(const LatticeReal& cf) const
+
+  // Accumulate cf*phase of every term into acc[slot][term][re,im]
+  template<typename T>
+  void
+  SftMom::sumTerms(std::vector<double>& acc, const T& cf, int subset_color) const
   {
-    multi2d<DComplex> hsum(num_mom, sft_set.numSubsets()) ;
+    const int ndir  = dir_mu.size();
+    const int nterm = term_mom.size();
+    const int nslot = (subset_color < 0) ? sft_set.numSubsets() : 1;
+    const int nthr  = qdpNumThreads();
+
+    std::vector<int> term_row(nterm*ndir);
+    for(int k=0; k < nterm; ++k)
+      for(int j=0; j < ndir; ++j)
+      {
+	const int L = Layout::lattSize()[dir_mu[j]];
+	term_row[k*ndir+j] = dir_off[j] + 2*(term_comp[k*ndir+j] - dir_pmin[j])*L;
+      }
 
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
-      hsum[mom_num] = sumMulti(phases[mom_num]*cf, sft_set) ;
+    // Each thread has its own sums
+    std::vector<double> buf(size_t(nthr)*nslot*nterm*2, 0.0);
 
-    return hsum ;
+    const int* sites = 0;
+    int num_sites = Layout::sitesOnNode();
+    if (subset_color >= 0)
+    {
+      sites     = sft_set[subset_color].siteTable().slice();
+      num_sites = sft_set[subset_color].numSiteTable();
+    }
+
+    SftArgs<T> args = {cf, sites, &(site_coord[0]), &(phase_table[0]), &(term_row[0]),
+		       ndir, nterm, nslot, &(buf[0])};
+    dispatch_to_threads(num_sites, args, sftSiteLoop<T>);
+
+    acc.assign(size_t(nslot)*nterm*2, 0.0);
+    for(int t=0; t < nthr; ++t)
+    {
+      const double* b = &(buf[size_t(t)*acc.size()]);
+      for(size_t n=0; n < acc.size(); ++n)
+	acc[n] += b[n];
+    }
   }
 
-  multi2d<DComplex>
-  SftMom::sft(const LatticeReal& cf, int subset_color) const
+
+  // Are there enough momenta to make a spatial FFT cheaper?
+  bool
+  SftMom::useFFT() const
+  {
+    int spatial_vol = 1;
+    for(int j=0; j < dir_mu.size(); ++j)
+      spatial_vol *= Layout::lattSize()[dir_mu[j]];
+
+    // A term costs a few flops per site out of cache, while a radix r
+    // stage of the FFT is r gathers of the whole field. Only switch
+    // once the terms are a sizeable part of all the momenta.
+    return 8*int(term_mom.size()) >= spatial_vol;
+  }
+
+
+  // Build the FFT and the lookup from its sites to the momenta
+  void
+  SftMom::makeFFT() const
+  {
+    const int ndir  = dir_mu.size();
+    const int nterm = term_mom.size();
+
+    multi1d<bool> dirs(Nd);
+    dirs = false;
+    for(int j=0; j < ndir; ++j)
+      dirs[dir_mu[j]] = true;
+
+    fft = new LatticeFFT(dirs);
+
+    // Momentum p is at the site with coordinates p mod L
+    int spatial_vol = 1;
+    for(int j=0; j < ndir; ++j)
+      spatial_vol *= Layout::lattSize()[dir_mu[j]];
+
+    std::vector<int> term_site(nterm);
+    for(int k=0; k < nterm; ++k)
+    {
+      int s = 0;
+      for(int j=ndir-1; j >= 0; --j)
+      {
+	const int L = Layout::lattSize()[dir_mu[j]];
+	s = s*L + ((term_comp[k*ndir+j] % L) + L) % L;
+      }
+      term_site[k] = s;
+    }
+
+    fft_start.assign(spatial_vol+1, 0);
+    for(int k=0; k < nterm; ++k)
+      ++fft_start[term_site[k]+1];
+    for(int s=0; s < spatial_vol; ++s)
+      fft_start[s+1] += fft_start[s];
+
+    fft_term.resize(nterm);
+    std::vector<int> next(fft_start.begin(), fft_start.end()-1);
+    for(int k=0; k < nterm; ++k)
+      fft_term[next[term_site[k]]++] = k;
+
+    fft_made = true;
+  }
+
+
+  // The FFT version of sumTerms over all subsets
+  void
+  SftMom::sumTermsFFT(std::vector<double>& acc, LatticeComplexD& f) const
+  {
+    if (! fft_made)
+      makeFFT();
+
+    const int ndir  = dir_mu.size();
+    const int nterm = term_mom.size();
+    const int nslot = sft_set.numSubsets();
+
+    // sum_x exp(+i p.x) f(x) on each time slice
+    (*fft)(f, -1);
+
+    acc.assign(size_t(nslot)*nterm*2, 0.0);
+
+    const int nsites = Layout::sitesOnNode();
+    for(int site=0; site < nsites; ++site)
+    {
+      const int* c = &(site_coord[site*(ndir+1)]);
+
+      int s = 0;
+      for(int j=ndir-1; j >= 0; --j)
+	s = s*Layout::lattSize()[dir_mu[j]] + c[j];
+
+      if (fft_start[s] == fft_start[s+1])
+	continue;
+
+      double re, im;
+      siteValue(f, site, re, im);
+
+      for(int n=fft_start[s]; n < fft_start[s+1]; ++n)
+      {
+	const int k = fft_term[n];
+
+	// The phase of the origin, exp(-i p.x0), is the table entry at x = 0
+	double pr = re, pi = im;
+	for(int j=0; j < ndir; ++j)
+	{
+	  const int L = Layout::lattSize()[dir_mu[j]];
+	  const double* e = &(phase_table[dir_off[j] + 2*(term_comp[k*ndir+j] - dir_pmin[j])*L]);
+	  double tr = pr*e[0] - pi*e[1];
+	  pi = pr*e[1] + pi*e[0];
+	  pr = tr;
+	}
+
+	double* a = &(acc[2*(c[ndir]*nterm + k)]);
+	a[0] += pr;
+	a[1] += pi;
+      }
+    }
+  }
+
+
+  // Global sum of acc and combine the terms into the momenta
+  void
+  SftMom::combineTerms(multi2d<DComplex>& hsum, std::vector<double>& acc, int subset_color) const
   {
-    int length = sft_set.numSubsets();
-    multi2d<DComplex> hsum(num_mom, length);
+    const int nterm  = term_mom.size();
+    const int length = sft_set.numSubsets();
+    const int nslot  = (subset_color < 0) ? length : 1;
 
+    // One reduction for every momentum and subset
+    if (acc.size() > 0)
+      QDPInternal::globalSumArray(&(acc[0]), int(acc.size()));
+
+    hsum.resize(num_mom, length);
     for (int mom_num=0; mom_num < num_mom; ++mom_num)
+      for (int t=0; t < length; ++t)
+	hsum[mom_num][t] = zero;
+
+    for (int slot=0; slot < nslot; ++slot)
     {
-      hsum[mom_num] = zero;
-      hsum[mom_num][subset_color] = sum(phases[mom_num]*cf, sft_set[subset_color]);
+      const int t = (subset_color < 0) ? slot : subset_color;
+      for (int k=0; k < nterm; ++k)
+      {
+	const double* a = &(acc[2*(slot*nterm + k)]);
+	hsum[term_mom[k]][t] += cmplx(Double(a[0]), Double(a[1]));
+      }
     }
 
+    if (avg_equiv_mom) {
+      for (int mom_num=0; mom_num < num_mom; ++mom_num)
+	for (int t=0; t < length; ++t)
+	  hsum[mom_num][t] /= Double(mom_degen[mom_num]);
+    }
+  }
+#endif
+
+
+  multi2d<DComplex>
+  SftMom::sft(const LatticeComplex& cf) const
+  {
+#if defined(QDP_IS_QDPJIT)
+    return sftPhases(cf, -1);
+#else
+    std::vector<double> acc;
+    if (useFFT())
+    {
+      LatticeComplexD f;
+      f = cf;
+      sumTermsFFT(acc, f);
+    }
+    else
+      sumTerms(acc, cf, -1);
+
+    multi2d<DComplex> hsum;
+    combineTerms(hsum, acc, -1);
     return hsum ;
+#endif
   }
 
-#if BASE_PRECISION==32
   multi2d<DComplex>
-  SftMom::sft(const LatticeComplexD& cf) const
+  SftMom::sft(const LatticeComplex& cf, int subset_color) const
   {
-    multi2d<DComplex> hsum(num_mom, sft_set.numSubsets()) ;
+#if defined(QDP_IS_QDPJIT)
+    return sftPhases(cf, subset_color);
+#else
+    std::vector<double> acc;
+    sumTerms(acc, cf, subset_color);
+
+    multi2d<DComplex> hsum;
+    combineTerms(hsum, acc, subset_color);
+    return hsum ;
+#endif
+  }
 
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
-      hsum[mom_num] = sumMulti(phases[mom_num]*cf, sft_set) ;
+  multi2d<DComplex>
+  SftMom::sft(const LatticeReal& cf) const
+  {
+#if defined(QDP_IS_QDPJIT)
+    return sftPhases(cf, -1);
+#else
+    std::vector<double> acc;
+    if (useFFT())
+    {
+      LatticeRealD re, im = zero;
+      re = cf;
+      LatticeComplexD f = cmplx(re, im);
+      sumTermsFFT(acc, f);
+    }
+    else
+      sumTerms(acc, cf, -1);
 
+    multi2d<DComplex> hsum;
+    combineTerms(hsum, acc, -1);
     return hsum ;
+#endif
   }
 
   multi2d<DComplex>
-  SftMom::sft(const LatticeComplexD& cf, int subset_color) const
+  SftMom::sft(const LatticeReal& cf, int subset_color) const
   {
-    int length = sft_set.numSubsets();
-    multi2d<DComplex> hsum(num_mom, length);
+#if defined(QDP_IS_QDPJIT)
+    return sftPhases(cf, subset_color);
+#else
+    std::vector<double> acc;
+    sumTerms(acc, cf, subset_color);
+
+    multi2d<DComplex> hsum;
+    combineTerms(hsum, acc, subset_color);
+    return hsum ;
+#endif
+  }
 
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
+#if BASE_PRECISION==32
+  multi2d<DComplex>
+  SftMom::sft(const LatticeComplexD& cf) const
+  {
+#if defined(QDP_IS_QDPJIT)
+    return sftPhases(cf, -1);
+#else
+    std::vector<double> acc;
+    if (useFFT())
     {
-      hsum[mom_num] = zero;
-      hsum[mom_num][subset_color] = sum(phases[mom_num]*cf, sft_set[subset_color]);
+      LatticeComplexD f = cf;
+      sumTermsFFT(acc, f);
     }
+    else
+      sumTerms(acc, cf, -1);
+
+    multi2d<DComplex> hsum;
+    combineTerms(hsum, acc, -1);
+    return hsum ;
+#endif
+  }
 
+  multi2d<DComplex>
+  SftMom::sft(const LatticeComplexD& cf, int subset_color) const
+  {
+#if defined(QDP_IS_QDPJIT)
+    return sftPhases(cf, subset_color);
+#else
+    std::vector<double> acc;
+    sumTerms(acc, cf, subset_color);
+
+    multi2d<DComplex> hsum;
+    combineTerms(hsum, acc, subset_color);
     return hsum ;
+#endif
   }
 #endif
 
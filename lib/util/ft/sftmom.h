@@ -8,6 +8,9 @@
 #define __sftmom_h__
 
 #include "chromabase.h"
+#include "handle.h"
+#include "util/ft/lattice_fft.h"
+#include <vector>
 
 namespace Chroma 
 {
@@ -30,6 +33,14 @@ namespace Chroma
   //! Fourier transform phase factor support
   /*!
    * \ingroup ft
+   *
+   * The phase of a momentum is a product over directions, so only small
+   * per-direction tables of exp(i 2 pi p (x-x0)/L) are kept. sft() reads
+   * the field once, accumulates every momentum on every time slice, and
+   * does one global sum for all of them. When the number of momenta is
+   * a sizeable fraction of the spatial volume a spatial FFT of each time
+   * slice, in double precision, is used instead. The lattice phase fields
+   * of operator[] are only built if asked for.
    */
   class SftMom
   {
@@ -87,7 +98,7 @@ namespace Chroma
 
     //! Return the phase for this particular momenta id
     const LatticeComplex& operator[](int mom_num) const
-      { return phases[mom_num]; }
+      { if (! phases_made) makePhases(); return phases[mom_num]; }
 
     //! Return the the multiplicity for this momenta id.
     /*! Only nonzero if momentum averaging is turned on */
@@ -118,15 +129,60 @@ namespace Chroma
     void init(int mom2_max, multi1d<int> origin_offset, multi1d<int> mom_offset,
 	      bool avg_mom_=false, int j_decay=-1);
 
+    //! Add one momentum to the phase of mom_num
+    void addTerm(int mom_num, const multi1d<int>& mom);
+
+    //! Per-direction phase tables and local site coordinates
+    void makeTables();
+
+    //! Build the lattice phase fields
+    void makePhases() const;
+
+    //! Are there enough momenta to make a spatial FFT cheaper?
+    bool useFFT() const;
+
+    //! Build the FFT and the lookup from its sites to the momenta
+    void makeFFT() const;
+
+    //! Accumulate cf*phase of every term into acc[slot][term][re,im]
+    template<typename T>
+    void sumTerms(std::vector<double>& acc, const T& cf, int subset_color) const;
+
+    //! The FFT version of sumTerms over all subsets, done in double precision on a copy f of the field
+    void sumTermsFFT(std::vector<double>& acc, LatticeComplexD& f) const;
+
+    //! Global sum of acc and combine the terms into the momenta
+    void combineTerms(multi2d<DComplex>& hsum, std::vector<double>& acc, int subset_color) const;
+
+    //! Slow phase field version of sft
+    template<typename T>
+    multi2d<DComplex> sftPhases(const T& cf, int subset_color) const;
+
     multi2d<int> mom_list;
     bool         avg_equiv_mom;
     int          decay_dir;
     int          num_mom;
     multi1d<int> origin_offset;
     multi1d<int> mom_offset;
-    multi1d<LatticeComplex> phases;
     multi1d<int> mom_degen;
     Set sft_set;
+
+    // Each momentum is a sum of terms, more than one if averaging
+    std::vector<int>    term_mom;     /*!< momentum id of each term */
+    std::vector<int>    term_comp;    /*!< [term][dir] momentum components */
+    std::vector<int>    dir_mu;       /*!< lattice direction of each momentum component */
+    std::vector<int>    dir_pmin;     /*!< smallest component in each direction */
+    std::vector<int>    dir_off;      /*!< start of each direction in phase_table */
+    std::vector<double> phase_table;  /*!< [dir][p-pmin][x][re,im] of exp(i 2 pi p (x-x0)/L) */
+    std::vector<int>    site_coord;   /*!< [site][dir] local coordinates, then the subset */
+
+    mutable multi1d<LatticeComplex> phases;
+    mutable bool                    phases_made;
+
+    mutable Handle<LatticeFFT>      fft;
+    mutable bool                    fft_made;
+    mutable std::vector<int>        fft_start;  /*!< terms of spatial site s are fft_term[fft_start[s]..fft_start[s+1]) */
+    mutable std::vector<int>        fft_term;
   };
 
 }  // end namespace Chroma
@@ -80,4 +80,16 @@ namespace Chroma
     }
   }
 
+  //! GlueElementalOperator DB bytes, straight from the storage of op
+  void writeDBBytes(std::string& output, const ValGlueElementalOperator_t& param)
+  {
+    writeDBBytes(output, param.op);
+  }
+
+  //! GlueElementalOperator DB bytes, straight into the storage of op
+  void readDBBytes(const std::string& input, ValGlueElementalOperator_t& param)
+  {
+    readDBBytes(input, param.op);
+  }
+
 } // namespace Chroma
@@ -63,6 +63,12 @@ namespace Chroma
   //! GlueElementalOperator write
   void write(BinaryWriter& bin, const ValGlueElementalOperator_t& param);
 
+  //! GlueElementalOperator DB bytes, straight from the storage of op
+  void writeDBBytes(std::string& output, const ValGlueElementalOperator_t& param);
+
+  //! GlueElementalOperator DB bytes, straight into the storage of op
+  void readDBBytes(const std::string& input, ValGlueElementalOperator_t& param);
+
   /*! @} */  // end of group ferm
 
 } // namespace Chroma
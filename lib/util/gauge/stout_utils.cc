@@ -102,12 +102,11 @@ namespace Chroma
 
 
     /*! \ingroup gauge */
-    void getQsandCs(const multi1d<LatticeColorMatrix>& u, LatticeColorMatrix& Q, 
-		    LatticeColorMatrix& QQ,
-		    LatticeColorMatrix& C, 
-		    int mu,
-		    const multi1d<bool>& smear_in_this_dirP,
-		    const multi2d<Real>& rho)
+    void getCs(const multi1d<LatticeColorMatrix>& u, 
+	       LatticeColorMatrix& C, 
+	       int mu,
+	       const multi1d<bool>& smear_in_this_dirP,
+	       const multi2d<Real>& rho)
     {
       START_CODE();
       
@@ -165,6 +164,22 @@ namespace Chroma
 	}
       }
       
+      END_CODE();
+    }
+
+
+    /*! \ingroup gauge */
+    void getQsandCs(const multi1d<LatticeColorMatrix>& u, LatticeColorMatrix& Q, 
+		    LatticeColorMatrix& QQ,
+		    LatticeColorMatrix& C, 
+		    int mu,
+		    const multi1d<bool>& smear_in_this_dirP,
+		    const multi2d<Real>& rho)
+    {
+      START_CODE();
+      
+      getCs(u, C, mu, smear_in_this_dirP, rho);
+      
       // Now I can form the Q
       LatticeColorMatrix Omega;
       Omega = C*adj(u[mu]); // Q_mu is Omega mu here (eq 2 part 2)
@@ -190,192 +205,14 @@ namespace Chroma
     {
       START_CODE();
       
-      // Things I need
-      // C_{\mu} = staple multiplied appropriately by the rho
-      // Lambda matrices asper eq(73) 
-      multi1d<LatticeColorMatrix> F_plus(Nd);
-      
-      // Save the fat force
-      F_plus = F;
-      
-      
-      multi1d<LatticeColorMatrix> Lambda(Nd);
-      multi1d<LatticeColorMatrix> C(Nd);
-      
-      // The links at this level (unprimed in the paper).
-      //const multi1d<LatticeColorMatrix>& u = smeared_links[level];
-      
-      for(int mu=0; mu < Nd; mu++) 
-      {
-	if( smear_in_this_dirP[mu] ) 
-	{ 
-	  LatticeColorMatrix Q,QQ;   // This is the C U^{dag}_mu suitably antisymmetrized
-	  
-	  // Get Q, Q^2, C, c0 and c1 -- this code is the same as used in stout_smear()
-	  getQsandCs(u, Q, QQ, C[mu], mu, smear_in_this_dirP,rho);
-	  
-	  // Now work the f-s and b-s
-	  multi1d<LatticeComplex> f;
-	  multi1d<LatticeComplex> b_1;
-	  multi1d<LatticeComplex> b_2;
-	  
-	  // Get the fs and bs  -- does internal resize to make them arrays of length 3
-	  //	QDPIO::cout << __func__ << ": mu=" << mu << std::endl;
-	  getFsAndBs(Q,QQ, f, b_1, b_2, true);
-	  
-	  
-	  LatticeColorMatrix B_1 = b_1[0] + b_1[1]*Q + b_1[2]*QQ;
-	  LatticeColorMatrix B_2 = b_2[0] + b_2[1]*Q + b_2[2]*QQ;
-	  
-	  
-	  // Construct the Gamma ( eq 74 and 73 )
-	  LatticeColorMatrix USigma = u[mu]*F_plus[mu];
-	  LatticeColorMatrix Gamma = f[1]*USigma + f[2]*(USigma*Q + Q*USigma)
-	    + trace(B_1*USigma)*Q
-	    + trace(B_2*USigma)*QQ;
-	  
-	  // Take the traceless hermitian part to form Lambda_mu (eq 72)
-	  Lambda[mu] = Gamma + adj(Gamma);    // Make it hermitian
-	  LatticeColorMatrix tmp3 = (Double(1)/Double(Nc))*trace(Lambda[mu]); // Subtract off the trace
-	  Lambda[mu] -= tmp3;
-	  Lambda[mu] *= Double(0.5);         // overall factor of 1/2
-	  
-	  // The first 3 terms of eq 75
-	  // Now the Fat force * the exp(iQ)
-	  F[mu]  = F_plus[mu]*(f[0] + f[1]*Q + f[2]*QQ);
-	  
-#if 0
-	  QDPIO::cout << __func__ << ": F[" << mu << "]= " << norm2(F[mu]) 
-		      << "  F_plus[mu]=" << norm2(F_plus[mu])
-		      << "  f[0]=" << norm2(f[0]) 
-		      << "  f[1]=" << norm2(f[1]) 
-		      << "  f[2]=" << norm2(f[2]) 
-		      << "  B_1=" << norm2(B_1) 
-		      << "  B_2=" << norm2(B_2) 
-		      << "  Q=" << norm2(Q) 
-		      << "  QQ=" << norm2(QQ) 
-		      << std::endl;
-#endif
-	  
-	} // End of if( smear_in_this_dirP[mu] )
-	// else what is in F_mu is the right force
-      }
-      
-      // At this point we should have 
-      //
-      //  F[mu] = F_plus[mu]*exp(iQ) 
-      //
-      //  We need the 8 staple terms left in dOmega/dU (last 6 terms in eq 75 + the iC{+}Lambda
-      //  term in eq 75 which in reality just covers 2 staples.
-      
-      //  We have to make this a separate loop from the above, because we need to know the 
-      //  Lambda[mu] and [nu] for all the avaliable mu-nu combinations
-      for(int mu = 0; mu < Nd; mu++) 
-      { 
-	if( smear_in_this_dirP[mu] ) 
-	{ 
-	  LatticeColorMatrix staple_sum = zero;
-	  // LatticeColorMatrix staple_sum_dag = adj(C[mu])*Lambda[mu];
-	  for(int nu = 0; nu < Nd; nu++) { 
-	    if((mu != nu) && smear_in_this_dirP[nu] ) { 
-	      LatticeColorMatrix U_nu_plus_mu = shift(u[nu],FORWARD, mu);
-	      LatticeColorMatrix U_mu_plus_nu = shift(u[mu],FORWARD, nu);
-	      LatticeColorMatrix Lambda_nu_plus_mu = shift(Lambda[nu], FORWARD, mu);
-	      LatticeColorMatrix tmp_mat;
-	      LatticeColorMatrix tmp_mat2;
-	      
-	      
-	      //  THe three upward staples
-	      //  Staples 1 5 and 6 in the paper
-	      // 
-	      //  Staple 1
-	      //      rho(nu,mu)  *                ( [ U_nu(x+mu) U^+_mu(x+nu) ] U^+_nu(x) ) Lambda_nu(x)
-	      //  Staple 5 
-	      //    - rho(nu,mu) * Lambda_nu(x+mu)*( [ U_nu(x+mu) U^+_mu(x+nu) ] U^+_nu(x) )
-	      //  Staple 6
-	      //      rho(mu,nu) *                   [ U_nu(x+mu) U^+_mu(x+nu) ] Lambda_mu(x + nu) U^{+}_nu(x)
-	      //
-	      //
-	      //  Here the suggestive [] are common to all three terms.
-	      //  Also Staple 1 and 5 share the additional U^+_nu(x) as indicated by suggestive ()
-	      //  Staple 1 and 5 also share the same rho(nu,mu) but have different sign
-	      
-	      {
-		LatticeColorMatrix tmp_mat3;
-		LatticeColorMatrix tmp_mat4;
-		
-		tmp_mat = U_nu_plus_mu*adj(U_mu_plus_nu); // Term in square brackets common to all
-		tmp_mat2 = tmp_mat*adj(u[nu]);            // Term in round brackets common to staples 1 and 5
-		tmp_mat3 = tmp_mat2*Lambda[nu];           // Staple 1
-		tmp_mat4 = Lambda_nu_plus_mu*tmp_mat2;
-		tmp_mat3 -= tmp_mat4;                     // Staple 5 and minus sign
-		tmp_mat3 *= rho(nu,mu);            // Common factor on staple 1 and 5
-		
-		tmp_mat4 = shift(Lambda[mu],FORWARD,nu);
-		tmp_mat2 = tmp_mat*tmp_mat4;                     // Staple 6
-		tmp_mat = tmp_mat2*adj(u[nu]);                   // and again
-		tmp_mat *= rho(mu,nu);                    // rho(mu, nu) factor on staple 6
-		tmp_mat += tmp_mat3;                          // collect staples 1 5 and 6 onto staple sum
-		staple_sum += tmp_mat;                           // slap onto the staple sum
-		
-		// Tmp 3 disappears here
-	      }
-	      
-	      // The three downward staples
-	      //
-	      // Paper Staples 2, 3, and 4;
-	      //
-	      // Staple 2:
-	      //     rho_mu_nu * U^{+}_nu(x-nu+mu) [  U^+_mu(x-nu) Lambda_mu(x-nu)     ] U_nu(x-nu)
-	      // Staple 3
-	      //     rho_nu_mu * U^{+}_nu(x-nu+mu) [ Lambda_nu(x-nu+mu) U^{+}_mu(x-nu) ] U_nu(x-nu)
-	      // Staple 4
-	      //   - rho_nu_mu * U^{+}_nu(x-nu+mu) [ U^{+}_mu(x-nu) Lambda_nu(x-nu)    ] U_nu(x-nu)
-	      //
-	      // I have suggestively placed brackets to show that all these staples share a common
-	      // first and last term. Secondly staples 3 and 4 share the same value of rho (but opposite sign)
-	      //
-	      // Finally this can all be communicated on site and then shifted altoghether to x-nu
-	      {
-		LatticeColorMatrix tmp_mat4;
-		
-		tmp_mat  = Lambda_nu_plus_mu*adj(u[mu]);      // Staple 3 term in brackets
-		tmp_mat4 = adj(u[mu])*Lambda[nu];
-		tmp_mat -= tmp_mat4;                          // Staple 4 term in brackets and -ve sign
-		tmp_mat *= rho(nu,mu);                        // Staple 3 & 4 common rho value
-		tmp_mat2 = adj(u[mu])*Lambda[mu];             // Staple 2 term in brackets
-		tmp_mat2 *= rho(mu,nu);                       // Staple 2 rho factor
-		tmp_mat += tmp_mat2;                          // Combine terms in brackets, signs and rho factors
-		
-		tmp_mat2 = adj(U_nu_plus_mu)*tmp_mat;         // Common first matrix
-		tmp_mat = tmp_mat2*u[nu];                     // Common last matrix
-		
-		staple_sum += shift(tmp_mat, BACKWARD, nu);   // Shift it all back to x-nu
-	      }
-	      
-	    } // end of if mu != nu
-	  } // end nu loop
-	  
-	  // Add on this term - there is a relative minus sign which will be corrected by the sign on 
-	  // on accumulation to F
-	  staple_sum -= adj(C[mu])*Lambda[mu];
-	  
-	  F[mu] -= timesI(staple_sum);
-	  
-#if 0
-	  QDPIO::cout << __func__ << ":b,  F[" << mu << "]= " << norm2(F[mu]) 
-		      << "  staple=" << norm2(staple_sum)
-		      << "  Lambda=" << norm2(Lambda[mu]) 
-		      << "  C=" << norm2(C[mu]) 
-		      << std::endl;
-#endif
-	} // End of if(smear_in_this_dirP[mu]
-	// Else nothing needs done to the force
-      } // end mu loop
-      
-      
+      // Redo the smearing step to get the staples, Q-s and the f-s and b-s.
+      // Callers that keep the StoutLevelData from smear_links skip this.
+      StoutLevelData data;
+      multi1d<LatticeColorMatrix> next(Nd);
+      smear_links(u, next, smear_in_this_dirP, rho, data);
+
+      deriv_recurse(F, smear_in_this_dirP, rho, u, data);
       
-      // Done
       END_CODE();
     }
      
@@ -397,6 +234,7 @@ namespace Chroma
     }
 
 
+
     /* A namespace to hide the thread dispatcher in */
     namespace StoutUtils { 
       struct GetFsAndBsArgs { 
@@ -409,36 +247,14 @@ namespace Chroma
       };
 
 
-
-      
-    inline 
-    void getFsAndBsSiteLoop(int lo, int hi, int myId, 
-			      GetFsAndBsArgs* arg)
-    {
-#ifndef QDP_IS_QDPJIT
-      const LatticeColorMatrix& Q = arg->Q;
-      const LatticeColorMatrix& QQ = arg->QQ;
-      multi1d<LatticeComplex>& f = arg->f;
-      multi1d<LatticeComplex>& b1 = arg->b1;
-      multi1d<LatticeComplex>& b2 = arg->b2;
-      bool dobs=arg->dobs;
-      
-      for(int site=lo; site < hi; site++)  
-      { 
-	// Get the traces
-	PColorMatrix<QDP::RComplex<REAL>, Nc>  Q_site = Q.elem(site).elem();
-	PColorMatrix<QDP::RComplex<REAL>, Nc>  QQ_site = QQ.elem(site).elem();
-	PColorMatrix<QDP::RComplex<REAL>, Nc>  QQQ = QQ_site*Q_site;
-	
-	Real trQQQ; 
-	trQQQ.elem()  = realTrace(QQQ);
-	Real trQQ;
-	trQQ.elem()   = realTrace(QQ_site);
-	
-	REAL c0    = ((REAL)1/(REAL)3) * trQQQ.elem().elem().elem().elem();  // eq 13
-	REAL c1    = ((REAL)1/(REAL)2) * trQQ.elem().elem().elem().elem();	 // eq 15 
-	
-	
+      //! The f-s and (if dobs) the b-s of one site, given c0 and c1
+      inline
+      void getFsAndBsSite(REAL c0, REAL c1,
+			  REAL f_re[3], REAL f_im[3],
+			  REAL b1_re[3], REAL b1_im[3],
+			  REAL b2_re[3], REAL b2_im[3],
+			  bool dobs)
+      {
 	if( c1 < 4.0e-3  ) 
 	{ // RGE: set to 4.0e-3 (CM uses this value). I ran into nans with 1.0e-4
 	  // ================================================================================
@@ -513,63 +329,43 @@ namespace Chroma
 	  //  differences to be zero. At this point in time std::maple seems happy.
 	  //  ==================================================================================
 	  
-	  f[0].elem(site).elem().elem().real() = 1.0-c0*c0/720.0;
-	  f[0].elem(site).elem().elem().imag() =  -(c0/6.0)*(1.0-(c1/20.0)*(1.0-(c1/42.0))) ;
+	  f_re[0] = 1.0-c0*c0/720.0;
+	  f_im[0] =  -(c0/6.0)*(1.0-(c1/20.0)*(1.0-(c1/42.0))) ;
 	  
-	  f[1].elem(site).elem().elem().real() =  c0/24.0*(1.0-c1/15.0*(1.0-3.0*c1/112.0)) ;
-	  f[1].elem(site).elem().elem().imag() =  1.0-c1/6.0*(1.0-c1/20.0*(1.0-c1/42.0))-c0*c0/5040.0 ;
+	  f_re[1] =  c0/24.0*(1.0-c1/15.0*(1.0-3.0*c1/112.0)) ;
+	  f_im[1] =  1.0-c1/6.0*(1.0-c1/20.0*(1.0-c1/42.0))-c0*c0/5040.0 ;
 	  
-	  f[2].elem(site).elem().elem().real() = 0.5*(-1.0+c1/12.0*(1.0-c1/30.0*(1.0-c1/56.0))+c0*c0/20160.0);
-	  f[2].elem(site).elem().elem().imag() = 0.5*(c0/60.0*(1.0-c1/21.0*(1.0-c1/48.0)));
+	  f_re[2] = 0.5*(-1.0+c1/12.0*(1.0-c1/30.0*(1.0-c1/56.0))+c0*c0/20160.0);
+	  f_im[2] = 0.5*(c0/60.0*(1.0-c1/21.0*(1.0-c1/48.0)));
 	  
 	  if( dobs == true ) {
 	    //  partial f0/ partial c0
-	    b2[0].elem(site).elem().elem().real() = -c0/360.0;
-	    b2[0].elem(site).elem().elem().imag() =  -(1.0/6.0)*(1.0-(c1/20.0)*(1.0-c1/42.0));
+	    b2_re[0] = -c0/360.0;
+	    b2_im[0] =  -(1.0/6.0)*(1.0-(c1/20.0)*(1.0-c1/42.0));
 	    
 	    // partial f0 / partial c1
 	    //
-	    b1[0].elem(site).elem().elem().real() = 0;
-	    b1[0].elem(site).elem().elem().imag() = (c0/120.0)*(1.0-c1/21.0);
+	    b1_re[0] = 0;
+	    b1_im[0] = (c0/120.0)*(1.0-c1/21.0);
 	    
 	    // partial f1 / partial c0
 	    //
-	    b2[1].elem(site).elem().elem().real() = (1.0/24.0)*(1.0-c1/15.0*(1.0-3.0*c1/112.0));
-	    b2[1].elem(site).elem().elem().imag() = -c0/2520.0;
+	    b2_re[1] = (1.0/24.0)*(1.0-c1/15.0*(1.0-3.0*c1/112.0));
+	    b2_im[1] = -c0/2520.0;
 	    
 	    
 	    // partial f1 / partial c1
-	    b1[1].elem(site).elem().elem().real() = -c0/360.0*(1.0 - 3.0*c1/56.0 );
-	    b1[1].elem(site).elem().elem().imag() = -1.0/6.0*(1.0-c1/10.0*(1.0-c1/28.0));
+	    b1_re[1] = -c0/360.0*(1.0 - 3.0*c1/56.0 );
+	    b1_im[1] = -1.0/6.0*(1.0-c1/10.0*(1.0-c1/28.0));
 	    
 	    // partial f2/ partial c0
-	    b2[2].elem(site).elem().elem().real() = 0.5*c0/10080.0;
-	    b2[2].elem(site).elem().elem().imag() = 0.5*(  1.0/60.0*(1.0-c1/21.0*(1.0-c1/48.0)) );
+	    b2_re[2] = 0.5*c0/10080.0;
+	    b2_im[2] = 0.5*(  1.0/60.0*(1.0-c1/21.0*(1.0-c1/48.0)) );
 	    
 	    // partial f2/ partial c1
-	    b1[2].elem(site).elem().elem().real() = 0.5*(  1.0/12.0*(1.0-(2.0*c1/30.0)*(1.0-3.0*c1/112.0)) ); 
-	    b1[2].elem(site).elem().elem().imag() = 0.5*( -c0/1260.0*(1.0-c1/24.0) );
+	    b1_re[2] = 0.5*(  1.0/12.0*(1.0-(2.0*c1/30.0)*(1.0-3.0*c1/112.0)) ); 
+	    b1_im[2] = 0.5*( -c0/1260.0*(1.0-c1/24.0) );
 	    
-#if 0
-	    {
-	      multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), site);
-	      
-	      QMP_fprintf(stdout, 
-			  "%s: corner; site=%d coord=[%d,%d,%d,%d] f[0]=%g f[1]=%g f[2]=%g b1[0]=%g b1[1]=%g b1[2]=%g b2[0]=%g b2[1]=%g b2[2]=%g c0=%g c1=%g",
-			  
-			  __func__, site, coord[0], coord[1], coord[2], coord[3],
-			  toDouble(localNorm2(f[0].elem(site))),
-			  toDouble(localNorm2(f[1].elem(site))),
-			  toDouble(localNorm2(f[2].elem(site))),
-			  toDouble(localNorm2(b1[0].elem(site))),
-			  toDouble(localNorm2(b1[1].elem(site))),
-			  toDouble(localNorm2(b1[2].elem(site))),
-			  toDouble(localNorm2(b2[0].elem(site))),
-			  toDouble(localNorm2(b2[1].elem(site))),
-			  toDouble(localNorm2(b2[2].elem(site))),
-			  c0, c1);
-	    }
-#endif
 	  } // Dobs==true
 	}
 	else 
@@ -596,14 +392,6 @@ namespace Chroma
 	    // This can happen only when there is a rounding error in the ratio, and that the 
 	    // ratio is really 1. This implies theta = 0 which we'll just set.
 	    // ===============================================================================
-	    {
-	      multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), site);
-
-//	      fprintf(stdout, 
-//		      "%s: corner2; site=%d coord=[%d,%d,%d,%d] c0max=%g c0abs=%d eps=%g\n Setting theta=0",
-//		      __func__, site, coord[0], coord[1], coord[2], coord[3],
-//		      c0abs, c0max,eps);
-	    }
 	    theta = 0;
 	  }
 	  else if ( eps < 1.0e-3 ) {
@@ -624,18 +412,8 @@ namespace Chroma
 	    // 
 	    theta = acos( c0abs/c0max );
 	  }
-	  
-	  multi1d<REAL> f_site_re(3);
-	  multi1d<REAL> f_site_im(3);
-	  
-	  multi1d<REAL> b1_site_re(3);
-	  multi1d<REAL> b1_site_im(3);
-	  
-	  multi1d<REAL> b2_site_re(3);
-	  multi1d<REAL> b2_site_im(3);
-	  
-	  
-	  
+
+
 	  REAL u = sqrt(c1/3)*cos(theta/3);
 	  REAL w = sqrt(c1)*sin(theta/3);
 	  
@@ -681,30 +459,30 @@ namespace Chroma
 	    REAL subexp2 = 8*u_sq*cosw;
 	    REAL subexp3 = (3*u_sq + w_sq)*xi0;
 	    
-	    f_site_re[0] = ( (subexp1)*cos2u + cosu*subexp2 + 2*usinu*subexp3 ) / denum ;
-	    f_site_im[0] = ( (subexp1)*sin2u - sinu*subexp2 + 2*ucosu*subexp3 ) / denum ;
+	    f_re[0] = ( (subexp1)*cos2u + cosu*subexp2 + 2*usinu*subexp3 ) / denum ;
+	    f_im[0] = ( (subexp1)*sin2u - sinu*subexp2 + 2*ucosu*subexp3 ) / denum ;
 	  }
 	  {
 	    REAL subexp = (3*u_sq -w_sq)*xi0;
 	    
-	    f_site_re[1] = (2*(ucos2u - ucosu*cosw)+subexp*sinu)/denum;
-	    f_site_im[1] = (2*(usin2u + usinu*cosw)+subexp*cosu)/denum;
+	    f_re[1] = (2*(ucos2u - ucosu*cosw)+subexp*sinu)/denum;
+	    f_im[1] = (2*(usin2u + usinu*cosw)+subexp*cosu)/denum;
 	  }
 	  
 	  
 	  {
 	    REAL subexp=3*xi0;
 	    
-	    f_site_re[2] = (cos2u - cosu*cosw -usinu*subexp) /denum ;
-	    f_site_im[2] = (sin2u + sinu*cosw -ucosu*subexp) /denum ;
+	    f_re[2] = (cos2u - cosu*cosw -usinu*subexp) /denum ;
+	    f_im[2] = (sin2u + sinu*cosw -ucosu*subexp) /denum ;
 	  }
 	  
 	  if( dobs == true ) 
 	    {
-	      multi1d<REAL> r_1_re(3);
-	      multi1d<REAL> r_1_im(3);
-	      multi1d<REAL> r_2_re(3);
-	      multi1d<REAL> r_2_im(3);
+	      REAL r_1_re[3];
+	      REAL r_1_im[3];
+	      REAL r_2_re[3];
+	      REAL r_2_im[3];
 	      
 	      //	  r_1[0]=Double(2)*cmplx(u, u_sq-w_sq)*exp2iu
 	      //          + 2.0*expmiu*( cmplx(8.0*u*cosw, -4.0*u_sq*cosw)
@@ -771,16 +549,16 @@ namespace Chroma
 		  REAL subexp2 = 3*u_sq - w_sq;
 		  REAL subexp3 = 2*(15*u_sq + w_sq);
 		  
-		  b1_site_re[j]=( subexp1*r_1_re[j] + subexp2*r_2_re[j] - subexp3*f_site_re[j] )/b_denum;
-		  b1_site_im[j]=( subexp1*r_1_im[j] + subexp2*r_2_im[j] - subexp3*f_site_im[j] )/b_denum;
+		  b1_re[j]=( subexp1*r_1_re[j] + subexp2*r_2_re[j] - subexp3*f_re[j] )/b_denum;
+		  b1_im[j]=( subexp1*r_1_im[j] + subexp2*r_2_im[j] - subexp3*f_im[j] )/b_denum;
 		}
 		
 		{ 
 		  REAL subexp1 = 3*u;
 		  REAL subexp2 = 24*u;
 		  
-		  b2_site_re[j]=( r_1_re[j]- subexp1*r_2_re[j] - subexp2 * f_site_re[j] )/b_denum;
-		  b2_site_im[j]=( r_1_im[j] -subexp1*r_2_im[j] - subexp2 * f_site_im[j] )/b_denum;
+		  b2_re[j]=( r_1_re[j]- subexp1*r_2_re[j] - subexp2 * f_re[j] )/b_denum;
+		  b2_im[j]=( r_1_im[j] -subexp1*r_2_im[j] - subexp2 * f_im[j] )/b_denum;
 		}
 	      }
 
@@ -788,56 +566,24 @@ namespace Chroma
 	      if( c0_negativeP ) 
 	      {
 		//b1_site[0] = conj(b1_site[0]);
-		b1_site_im[0] *= -1;
+		b1_im[0] *= -1;
 		
 		//b1_site[1] = -conj(b1_site[1]);
-		b1_site_re[1] *= -1;
+		b1_re[1] *= -1;
 		
 		//b1_site[2] = conj(b1_site[2]);
-		b1_site_im[2] *= -1;
+		b1_im[2] *= -1;
 		
 		//b2_site[0] = -conj(b2_site[0]);
-		b2_site_re[0] *= -1;
+		b2_re[0] *= -1;
 		
 		//b2_site[1] = conj(b2_site[1]);
-		b2_site_im[1] *= -1;
+		b2_im[1] *= -1;
 		
 		//b2_site[2] = -conj(b2_site[2]);
-		b2_site_re[2] *= -1;
+		b2_re[2] *= -1;
 	      }
 	      
-	      // Load back into the lattice sized object
-	      for(int j=0; j < 3; j++) {
-		
-		b1[j].elem(site).elem().elem().real() = b1_site_re[j];
-		b1[j].elem(site).elem().elem().imag() = b1_site_im[j];
-		
-		b2[j].elem(site).elem().elem().real() = b2_site_re[j];
-		b2[j].elem(site).elem().elem().imag() = b2_site_im[j];
-	      }
-#if 0
-	      {
-		multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), site);
-		REAL rat = c0abs/c0max;
-		
-		QMP_fprintf(stdout, 
-			    "%s: site=%d coord=[%d,%d,%d,%d] f_site[0]=%g f_site[1]=%g f_site[2]=%g 1[0]=%g b1[1]=%g b1[2]=%g b2[0]=%g b2[1]=%g b2[2]=%g denum=%g c0=%g c1=%g c0max=%g rat=%g theta=%g",
-			    
-			    __func__, site, coord[0], coord[1], coord[2], coord[3],
-			    toDouble(localNorm2(cmplx(Real(f_site_re[0]),Real(f_site_im[0])))),
-			    toDouble(localNorm2(cmplx(Real(f_site_re[1]),Real(f_site_im[1])))),
-			    toDouble(localNorm2(cmplx(Real(f_site_re[2]),Real(f_site_im[2])))),
-			    toDouble(localNorm2(b1[0].elem(site))),
-			    toDouble(localNorm2(b1[1].elem(site))),
-			    toDouble(localNorm2(b1[2].elem(site))),
-			    toDouble(localNorm2(b2[0].elem(site))),
-			    toDouble(localNorm2(b2[1].elem(site))),
-			    toDouble(localNorm2(b2[2].elem(site))),
-			    denum, 
-			    c0, c1, c0max,
-			    rat, theta);
-	      }
-#endif
 	      
 	    } // end of if (dobs==true)
 	  
@@ -847,45 +593,368 @@ namespace Chroma
 	  if( c0_negativeP ) {
 	    
 	    // f_site[0] = conj(f_site[0]);
-	    f_site_im[0] *= -1;
+	    f_im[0] *= -1;
 	    
 	    //f_site[1] = -conj(f_site[1]);
-	    f_site_re[1] *= -1;
+	    f_re[1] *= -1;
 	    
 	    //f_site[2] = conj(f_site[2]);
-	    f_site_im[2] *= -1;
+	    f_im[2] *= -1;
 	    
 	  }
 	
-	  // Load back into the lattice sized object
-	  for(int j=0; j < 3; j++) { 
-	    f[j].elem(site).elem().elem().real() = f_site_re[j];
-	    f[j].elem(site).elem().elem().imag() = f_site_im[j];
-	  }
 	  
 	} // End of if( corner_caseP ) else {}
-      } // End site loop
-#endif
-    } // End Function
+      }
 
-    } // End Namespace
-	
-    /*! \ingroup gauge */
-    void getFsAndBs(const LatticeColorMatrix& Q,
-		    const LatticeColorMatrix& QQ,
-		    multi1d<LatticeComplex>& f,
-		    multi1d<LatticeComplex>& b1,
-		    multi1d<LatticeComplex>& b2,
-		    bool dobs)
+      
+    inline 
+    void getFsAndBsSiteLoop(int lo, int hi, int myId, 
+			      GetFsAndBsArgs* arg)
     {
-      START_CODE();
-      QDP::StopWatch swatch;
-      swatch.reset();
-      swatch.start();
+#ifndef QDP_IS_QDPJIT
+      const LatticeColorMatrix& Q = arg->Q;
+      const LatticeColorMatrix& QQ = arg->QQ;
+      multi1d<LatticeComplex>& f = arg->f;
+      multi1d<LatticeComplex>& b1 = arg->b1;
+      multi1d<LatticeComplex>& b2 = arg->b2;
+      bool dobs=arg->dobs;
       
-      f.resize(3);
-
-      b1.resize(3);
+      for(int site=lo; site < hi; site++)  
+      { 
+	// Get the traces
+	PColorMatrix<QDP::RComplex<REAL>, Nc>  Q_site = Q.elem(site).elem();
+	PColorMatrix<QDP::RComplex<REAL>, Nc>  QQ_site = QQ.elem(site).elem();
+	PColorMatrix<QDP::RComplex<REAL>, Nc>  QQQ = QQ_site*Q_site;
+	
+	Real trQQQ; 
+	trQQQ.elem()  = realTrace(QQQ);
+	Real trQQ;
+	trQQ.elem()   = realTrace(QQ_site);
+	
+	REAL c0    = ((REAL)1/(REAL)3) * trQQQ.elem().elem().elem().elem();  // eq 13
+	REAL c1    = ((REAL)1/(REAL)2) * trQQ.elem().elem().elem().elem();	 // eq 15 
+	
+	REAL f_re[3], f_im[3];
+	REAL b1_re[3], b1_im[3];
+	REAL b2_re[3], b2_im[3];
+
+	getFsAndBsSite(c0, c1, f_re, f_im, b1_re, b1_im, b2_re, b2_im, dobs);
+
+	// Load back into the lattice sized object
+	for(int j=0; j < 3; j++) { 
+	  f[j].elem(site).elem().elem().real() = f_re[j];
+	  f[j].elem(site).elem().elem().imag() = f_im[j];
+	}
+
+	if( dobs == true ) {
+	  for(int j=0; j < 3; j++) { 
+	    b1[j].elem(site).elem().elem().real() = b1_re[j];
+	    b1[j].elem(site).elem().elem().imag() = b1_im[j];
+	    
+	    b2[j].elem(site).elem().elem().real() = b2_re[j];
+	    b2[j].elem(site).elem().elem().imag() = b2_im[j];
+	  }
+	}
+      } // End site loop
+#endif
+    } // End Function
+
+
+#ifndef QDP_IS_QDPJIT
+      //! One color matrix, split in real and imaginary parts
+      struct SiteMatrix { 
+	REAL re[Nc][Nc];
+	REAL im[Nc][Nc];
+      };
+
+      inline
+      void loadSite(SiteMatrix& a, const LatticeColorMatrix& m, int site)
+      {
+	for(int i=0; i < Nc; i++)
+	  for(int j=0; j < Nc; j++) { 
+	    a.re[i][j] = m.elem(site).elem().elem(i,j).real();
+	    a.im[i][j] = m.elem(site).elem().elem(i,j).imag();
+	  }
+      }
+
+      inline
+      void storeSite(LatticeColorMatrix& m, int site, const SiteMatrix& a)
+      {
+	for(int i=0; i < Nc; i++)
+	  for(int j=0; j < Nc; j++) { 
+	    m.elem(site).elem().elem(i,j).real() = a.re[i][j];
+	    m.elem(site).elem().elem(i,j).imag() = a.im[i][j];
+	  }
+      }
+
+      //! c = a*b
+      inline
+      void multSite(SiteMatrix& c, const SiteMatrix& a, const SiteMatrix& b)
+      {
+	for(int i=0; i < Nc; i++)
+	  for(int j=0; j < Nc; j++) { 
+	    REAL re = 0;
+	    REAL im = 0;
+	    for(int k=0; k < Nc; k++) { 
+	      re += a.re[i][k]*b.re[k][j] - a.im[i][k]*b.im[k][j];
+	      im += a.re[i][k]*b.im[k][j] + a.im[i][k]*b.re[k][j];
+	    }
+	    c.re[i][j] = re;
+	    c.im[i][j] = im;
+	  }
+      }
+
+      //! c = a*adj(b)
+      inline
+      void multAdjSite(SiteMatrix& c, const SiteMatrix& a, const SiteMatrix& b)
+      {
+	for(int i=0; i < Nc; i++)
+	  for(int j=0; j < Nc; j++) { 
+	    REAL re = 0;
+	    REAL im = 0;
+	    for(int k=0; k < Nc; k++) { 
+	      re += a.re[i][k]*b.re[j][k] + a.im[i][k]*b.im[j][k];
+	      im += a.im[i][k]*b.re[j][k] - a.re[i][k]*b.im[j][k];
+	    }
+	    c.re[i][j] = re;
+	    c.im[i][j] = im;
+	  }
+      }
+
+      //! c += (re + i im)*a
+      inline
+      void caxpySite(SiteMatrix& c, REAL re, REAL im, const SiteMatrix& a)
+      {
+	for(int i=0; i < Nc; i++)
+	  for(int j=0; j < Nc; j++) { 
+	    c.re[i][j] += re*a.re[i][j] - im*a.im[i][j];
+	    c.im[i][j] += re*a.im[i][j] + im*a.re[i][j];
+	  }
+      }
+
+      //! c = x[0] + x[1]*Q + x[2]*QQ
+      inline
+      void polySite(SiteMatrix& c, const REAL x_re[3], const REAL x_im[3],
+		    const SiteMatrix& Q, const SiteMatrix& QQ)
+      {
+	for(int i=0; i < Nc; i++)
+	  for(int j=0; j < Nc; j++) { 
+	    c.re[i][j] = x_re[1]*Q.re[i][j] - x_im[1]*Q.im[i][j] + x_re[2]*QQ.re[i][j] - x_im[2]*QQ.im[i][j];
+	    c.im[i][j] = x_re[1]*Q.im[i][j] + x_im[1]*Q.re[i][j] + x_re[2]*QQ.im[i][j] + x_im[2]*QQ.re[i][j];
+	  }
+	for(int i=0; i < Nc; i++) { 
+	  c.re[i][i] += x_re[0];
+	  c.im[i][i] += x_im[0];
+	}
+      }
+
+      //! re + i im = trace(a*b)
+      inline
+      void traceMultSite(REAL& re, REAL& im, const SiteMatrix& a, const SiteMatrix& b)
+      {
+	re = 0;
+	im = 0;
+	for(int i=0; i < Nc; i++)
+	  for(int k=0; k < Nc; k++) { 
+	    re += a.re[i][k]*b.re[k][i] - a.im[i][k]*b.im[k][i];
+	    im += a.re[i][k]*b.im[k][i] + a.im[i][k]*b.re[k][i];
+	  }
+      }
+
+      inline
+      void loadCoeffs(REAL x_re[3], REAL x_im[3], const multi1d<LatticeComplex>& x, int site)
+      {
+	for(int j=0; j < 3; j++) { 
+	  x_re[j] = x[j].elem(site).elem().elem().real();
+	  x_im[j] = x[j].elem(site).elem().elem().imag();
+	}
+      }
+
+      inline
+      void storeCoeffs(multi1d<LatticeComplex>& x, int site, const REAL x_re[3], const REAL x_im[3])
+      {
+	for(int j=0; j < 3; j++) { 
+	  x[j].elem(site).elem().elem().real() = x_re[j];
+	  x[j].elem(site).elem().elem().imag() = x_im[j];
+	}
+      }
+#endif
+
+
+      struct StoutSmearArgs { 
+	const LatticeColorMatrix& C;
+	const LatticeColorMatrix& U;
+	LatticeColorMatrix& next;
+	LatticeColorMatrix& Q;
+	LatticeColorMatrix& QQ;
+	multi1d<LatticeComplex>& f;
+	multi1d<LatticeComplex>& b1;
+	multi1d<LatticeComplex>& b2;
+	bool dobs;
+      };
+
+      //! Q, Q^2, the f-s and b-s and exp(iQ)U in one pass over the sites
+      inline 
+      void stoutSmearSiteLoop(int lo, int hi, int myId, 
+			      StoutSmearArgs* arg)
+      {
+#ifndef QDP_IS_QDPJIT
+	const bool dobs = arg->dobs;
+
+	for(int site=lo; site < hi; site++)  
+	{ 
+	  SiteMatrix C, U, Omega, Q, QQ, E, V;
+	  loadSite(C, arg->C, site);
+	  loadSite(U, arg->U, site);
+
+	  // Omega = C U^dag and Q = (i/2)(Omega^dag - Omega) made traceless (eq 2)
+	  // The trace of Omega^dag - Omega is -2i Im tr(Omega)
+	  multAdjSite(Omega, C, U);
+
+	  REAL tr_im = 0;
+	  for(int i=0; i < Nc; i++)
+	    tr_im += Omega.im[i][i];
+
+	  for(int i=0; i < Nc; i++)
+	    for(int j=0; j < Nc; j++) { 
+	      Q.re[i][j] = (REAL)0.5*(Omega.im[j][i] + Omega.im[i][j]);
+	      Q.im[i][j] = (REAL)0.5*(Omega.re[j][i] - Omega.re[i][j]);
+	    }
+	  for(int i=0; i < Nc; i++)
+	    Q.re[i][i] -= tr_im/(REAL)Nc;
+
+	  multSite(QQ, Q, Q);
+
+	  REAL trQQQ_re, trQQQ_im;
+	  traceMultSite(trQQQ_re, trQQQ_im, QQ, Q);
+	  REAL trQQ = 0;
+	  for(int i=0; i < Nc; i++)
+	    trQQ += QQ.re[i][i];
+
+	  REAL c0 = ((REAL)1/(REAL)3) * trQQQ_re;  // eq 13
+	  REAL c1 = ((REAL)1/(REAL)2) * trQQ;      // eq 15 
+
+	  REAL f_re[3], f_im[3];
+	  REAL b1_re[3], b1_im[3];
+	  REAL b2_re[3], b2_im[3];
+
+	  getFsAndBsSite(c0, c1, f_re, f_im, b1_re, b1_im, b2_re, b2_im, dobs);
+
+	  // The stout link exp(iQ)U
+	  polySite(E, f_re, f_im, Q, QQ);
+	  multSite(V, E, U);
+
+	  storeSite(arg->next, site, V);
+	  storeSite(arg->Q, site, Q);
+	  storeSite(arg->QQ, site, QQ);
+	  storeCoeffs(arg->f, site, f_re, f_im);
+	  if( dobs ) { 
+	    storeCoeffs(arg->b1, site, b1_re, b1_im);
+	    storeCoeffs(arg->b2, site, b2_re, b2_im);
+	  }
+	}
+#endif
+      }
+
+
+      struct StoutDerivArgs { 
+	const LatticeColorMatrix& Q;
+	const LatticeColorMatrix& QQ;
+	const multi1d<LatticeComplex>& f;
+	const multi1d<LatticeComplex>& b1;
+	const multi1d<LatticeComplex>& b2;
+	const LatticeColorMatrix& U;
+	LatticeColorMatrix& F;
+	LatticeColorMatrix& Lambda;
+      };
+
+      //! Lambda (eqs 72-74) and F exp(iQ) in one pass over the sites
+      inline 
+      void stoutDerivSiteLoop(int lo, int hi, int myId, 
+			      StoutDerivArgs* arg)
+      {
+#ifndef QDP_IS_QDPJIT
+	for(int site=lo; site < hi; site++)  
+	{ 
+	  SiteMatrix Q, QQ, U, F_plus, B_1, B_2, USigma, T, Gamma, Lambda;
+	  loadSite(Q, arg->Q, site);
+	  loadSite(QQ, arg->QQ, site);
+	  loadSite(U, arg->U, site);
+	  loadSite(F_plus, arg->F, site);
+
+	  REAL f_re[3], f_im[3];
+	  REAL b1_re[3], b1_im[3];
+	  REAL b2_re[3], b2_im[3];
+	  loadCoeffs(f_re, f_im, arg->f, site);
+	  loadCoeffs(b1_re, b1_im, arg->b1, site);
+	  loadCoeffs(b2_re, b2_im, arg->b2, site);
+
+	  polySite(B_1, b1_re, b1_im, Q, QQ);
+	  polySite(B_2, b2_re, b2_im, Q, QQ);
+
+	  // Construct the Gamma ( eq 74 and 73 )
+	  multSite(USigma, U, F_plus);
+
+	  for(int i=0; i < Nc; i++)
+	    for(int j=0; j < Nc; j++) { 
+	      Gamma.re[i][j] = 0;
+	      Gamma.im[i][j] = 0;
+	    }
+	  caxpySite(Gamma, f_re[1], f_im[1], USigma);
+	  multSite(T, USigma, Q);
+	  caxpySite(Gamma, f_re[2], f_im[2], T);
+	  multSite(T, Q, USigma);
+	  caxpySite(Gamma, f_re[2], f_im[2], T);
+
+	  REAL tr_re, tr_im;
+	  traceMultSite(tr_re, tr_im, B_1, USigma);
+	  caxpySite(Gamma, tr_re, tr_im, Q);
+	  traceMultSite(tr_re, tr_im, B_2, USigma);
+	  caxpySite(Gamma, tr_re, tr_im, QQ);
+
+	  // The traceless hermitian part (Gamma + Gamma^dag)/2 is Lambda_mu (eq 72)
+	  REAL trGamma = 0;
+	  for(int i=0; i < Nc; i++)
+	    trGamma += Gamma.re[i][i];
+
+	  for(int i=0; i < Nc; i++)
+	    for(int j=0; j < Nc; j++) { 
+	      Lambda.re[i][j] = (REAL)0.5*(Gamma.re[i][j] + Gamma.re[j][i]);
+	      Lambda.im[i][j] = (REAL)0.5*(Gamma.im[i][j] - Gamma.im[j][i]);
+	    }
+	  for(int i=0; i < Nc; i++)
+	    Lambda.re[i][i] -= trGamma/(REAL)Nc;
+
+	  storeSite(arg->Lambda, site, Lambda);
+
+	  // The first 3 terms of eq 75: the fat force * the exp(iQ)
+	  polySite(T, f_re, f_im, Q, QQ);
+	  multSite(USigma, F_plus, T);
+	  storeSite(arg->F, site, USigma);
+	}
+#endif
+      }
+
+    } // End Namespace
+	
+	
+    /*! \ingroup gauge */
+    void getFsAndBs(const LatticeColorMatrix& Q,
+		    const LatticeColorMatrix& QQ,
+		    multi1d<LatticeComplex>& f,
+		    multi1d<LatticeComplex>& b1,
+		    multi1d<LatticeComplex>& b2,
+		    bool dobs)
+    {
+      START_CODE();
+      QDP::StopWatch swatch;
+      swatch.reset();
+      swatch.start();
+      
+      f.resize(3);
+
+      b1.resize(3);
       b2.resize(3);
 
       
@@ -932,6 +1001,95 @@ namespace Chroma
       END_CODE();
     }
 
+
+
+    namespace StoutUtils { 
+      //! One direction of a smearing step
+      /*!
+       * Leaves the staples in C, Q, Q^2, the f-s (and b-s if dobs)
+       * and the smeared link in next.
+       */
+      void smearStep(const multi1d<LatticeColorMatrix>& u,
+		     int mu,
+		     const multi1d<bool>& smear_in_this_dirP,
+		     const multi2d<Real>& rho,
+		     LatticeColorMatrix& C,
+		     LatticeColorMatrix& Q,
+		     LatticeColorMatrix& QQ,
+		     multi1d<LatticeComplex>& f,
+		     multi1d<LatticeComplex>& b1,
+		     multi1d<LatticeComplex>& b2,
+		     LatticeColorMatrix& next,
+		     bool dobs)
+      {
+#if defined(QDP_IS_QDPJIT)
+	getQsandCs(u, Q, QQ, C, mu, smear_in_this_dirP, rho);
+	getFsAndBs(Q, QQ, f, b1, b2, dobs);
+	next = (f[0] + f[1]*Q + f[2]*QQ)*u[mu];
+#else
+	getCs(u, C, mu, smear_in_this_dirP, rho);
+
+	QDP::StopWatch swatch;
+	swatch.reset();
+	swatch.start();
+
+	f.resize(3);
+	if( dobs ) { 
+	  b1.resize(3);
+	  b2.resize(3);
+	}
+
+	int num_sites = Layout::sitesOnNode();
+	StoutSmearArgs args={C,u[mu],next,Q,QQ,f,b1,b2,dobs};
+	dispatch_to_threads(num_sites, args, stoutSmearSiteLoop);
+
+	swatch.stop();
+	StoutLinkTimings::functions_secs += swatch.getTimeInSeconds();
+#endif
+      }
+
+      //! Lambda_mu and the first 3 terms of eq 75 for one direction
+      void derivStep(const StoutLevelData& data,
+		     int mu,
+		     const LatticeColorMatrix& U,
+		     LatticeColorMatrix& F,
+		     LatticeColorMatrix& Lambda)
+      {
+	const LatticeColorMatrix& Q = data.Q[mu];
+	const LatticeColorMatrix& QQ = data.QQ[mu];
+	const multi1d<LatticeComplex>& f = data.f[mu];
+	const multi1d<LatticeComplex>& b_1 = data.b1[mu];
+	const multi1d<LatticeComplex>& b_2 = data.b2[mu];
+
+#if defined(QDP_IS_QDPJIT)
+	LatticeColorMatrix B_1 = b_1[0] + b_1[1]*Q + b_1[2]*QQ;
+	LatticeColorMatrix B_2 = b_2[0] + b_2[1]*Q + b_2[2]*QQ;
+	  
+	// Construct the Gamma ( eq 74 and 73 )
+	LatticeColorMatrix USigma = U*F;
+	LatticeColorMatrix Gamma = f[1]*USigma + f[2]*(USigma*Q + Q*USigma)
+	  + trace(B_1*USigma)*Q
+	  + trace(B_2*USigma)*QQ;
+	  
+	// Take the traceless hermitian part to form Lambda_mu (eq 72)
+	Lambda = Gamma + adj(Gamma);    // Make it hermitian
+	LatticeColorMatrix tmp3 = (Double(1)/Double(Nc))*trace(Lambda); // Subtract off the trace
+	Lambda -= tmp3;
+	Lambda *= Double(0.5);         // overall factor of 1/2
+	  
+	// The first 3 terms of eq 75
+	// Now the Fat force * the exp(iQ)
+	LatticeColorMatrix F_plus = F;
+	F = F_plus*(f[0] + f[1]*Q + f[2]*QQ);
+#else
+	int num_sites = Layout::sitesOnNode();
+	StoutDerivArgs args={Q,QQ,f,b_1,b_2,U,F,Lambda};
+	dispatch_to_threads(num_sites, args, stoutDerivSiteLoop);
+#endif
+      }
+    }
+
+
     /*! \ingroup gauge */
     void smear_links(const multi1d<LatticeColorMatrix>& current, 
 		     multi1d<LatticeColorMatrix>& next,
@@ -939,22 +1097,62 @@ namespace Chroma
 		     const multi2d<Real>& rho)
     {
       START_CODE();
+
+      QDP::StopWatch swatch;
+      swatch.reset();
+      swatch.start();
       
       for(int mu = 0; mu < Nd; mu++) 
       {
 	if( smear_in_this_dirP[mu] ) 
 	{
-	  LatticeColorMatrix Q, QQ;
-	  
-	  // Q contains the staple term. C is a throwaway
-	  getQs(current, Q, QQ, mu, smear_in_this_dirP, rho);
-	  
-	  // Now compute the f's
-	  multi1d<LatticeComplex> f;   // routine will resize these
-	  getFs(Q,QQ,f);   // This routine computes the f-s
-	  
-	  // Assemble the stout links exp(iQ)U_{mu} 
-	  next[mu]=(f[0] + f[1]*Q + f[2]*QQ)*current[mu];      
+	  // Only the smeared links are wanted, the rest is a throwaway
+	  LatticeColorMatrix C, Q, QQ;
+	  multi1d<LatticeComplex> f, b_1, b_2;
+
+	  StoutUtils::smearStep(current, mu, smear_in_this_dirP, rho, 
+				C, Q, QQ, f, b_1, b_2, next[mu], false);
+	}
+	else { 
+	  next[mu]=current[mu];  // Unsmeared
+	}
+	
+      }
+      
+      swatch.stop();
+      StoutLinkTimings::smearing_secs += swatch.getTimeInSeconds();
+      END_CODE();
+    }
+
+
+    /*! \ingroup gauge */
+    void smear_links(const multi1d<LatticeColorMatrix>& current, 
+		     multi1d<LatticeColorMatrix>& next,
+		     const multi1d<bool>& smear_in_this_dirP,
+		     const multi2d<Real>& rho,
+		     StoutLevelData& data)
+    {
+      START_CODE();
+
+      QDP::StopWatch swatch;
+      swatch.reset();
+      swatch.start();
+
+      data.C.resize(Nd);
+      data.Q.resize(Nd);
+      data.QQ.resize(Nd);
+      data.f.resize(Nd);
+      data.b1.resize(Nd);
+      data.b2.resize(Nd);
+      
+      for(int mu = 0; mu < Nd; mu++) 
+      {
+	if( smear_in_this_dirP[mu] ) 
+	{
+	  StoutUtils::smearStep(current, mu, smear_in_this_dirP, rho, 
+				data.C[mu], data.Q[mu], data.QQ[mu], 
+				data.f[mu], data.b1[mu], data.b2[mu], 
+				next[mu], true);
 	}
 	else { 
 	  next[mu]=current[mu];  // Unsmeared
@@ -962,6 +1160,158 @@ namespace Chroma
 	
       }
       
+      swatch.stop();
+      StoutLinkTimings::smearing_secs += swatch.getTimeInSeconds();
+      END_CODE();
+    }
+    
+
+    /*! \ingroup gauge */
+    // Do the force recursion from level i+1, to level i
+    // The input fat_force F is modified.
+    void deriv_recurse(multi1d<LatticeColorMatrix>& F,
+		       const multi1d<bool>& smear_in_this_dirP,
+		       const multi2d<Real>& rho,
+		       const multi1d<LatticeColorMatrix>& u,
+		       const StoutLevelData& data)
+    {
+      START_CODE();
+
+      QDP::StopWatch swatch;
+      swatch.reset();
+      swatch.start();
+      
+      // Things I need
+      // C_{\mu} = staple multiplied appropriately by the rho -- kept in data
+      // Lambda matrices asper eq(73) 
+      multi1d<LatticeColorMatrix> Lambda(Nd);
+      
+      for(int mu=0; mu < Nd; mu++) 
+      {
+	if( smear_in_this_dirP[mu] ) 
+	{ 
+	  // Lambda[mu] and F[mu] = F_plus[mu]*exp(iQ) from the kept Q-s, f-s and b-s
+	  StoutUtils::derivStep(data, mu, u[mu], F[mu], Lambda[mu]);
+	} // End of if( smear_in_this_dirP[mu] )
+	// else what is in F_mu is the right force
+      }
+      
+      // At this point we should have 
+      //
+      //  F[mu] = F_plus[mu]*exp(iQ) 
+      //
+      //  We need the 8 staple terms left in dOmega/dU (last 6 terms in eq 75 + the iC{+}Lambda
+      //  term in eq 75 which in reality just covers 2 staples.
+      
+      //  We have to make this a separate loop from the above, because we need to know the 
+      //  Lambda[mu] and [nu] for all the avaliable mu-nu combinations
+      for(int mu = 0; mu < Nd; mu++) 
+      { 
+	if( smear_in_this_dirP[mu] ) 
+	{ 
+	  LatticeColorMatrix staple_sum = zero;
+	  // LatticeColorMatrix staple_sum_dag = adj(data.C[mu])*Lambda[mu];
+	  for(int nu = 0; nu < Nd; nu++) { 
+	    if((mu != nu) && smear_in_this_dirP[nu] ) { 
+	      LatticeColorMatrix U_nu_plus_mu = shift(u[nu],FORWARD, mu);
+	      LatticeColorMatrix U_mu_plus_nu = shift(u[mu],FORWARD, nu);
+	      LatticeColorMatrix Lambda_nu_plus_mu = shift(Lambda[nu], FORWARD, mu);
+	      LatticeColorMatrix tmp_mat;
+	      LatticeColorMatrix tmp_mat2;
+	      
+	      
+	      //  THe three upward staples
+	      //  Staples 1 5 and 6 in the paper
+	      // 
+	      //  Staple 1
+	      //      rho(nu,mu)  *                ( [ U_nu(x+mu) U^+_mu(x+nu) ] U^+_nu(x) ) Lambda_nu(x)
+	      //  Staple 5 
+	      //    - rho(nu,mu) * Lambda_nu(x+mu)*( [ U_nu(x+mu) U^+_mu(x+nu) ] U^+_nu(x) )
+	      //  Staple 6
+	      //      rho(mu,nu) *                   [ U_nu(x+mu) U^+_mu(x+nu) ] Lambda_mu(x + nu) U^{+}_nu(x)
+	      //
+	      //
+	      //  Here the suggestive [] are common to all three terms.
+	      //  Also Staple 1 and 5 share the additional U^+_nu(x) as indicated by suggestive ()
+	      //  Staple 1 and 5 also share the same rho(nu,mu) but have different sign
+	      
+	      {
+		LatticeColorMatrix tmp_mat3;
+		LatticeColorMatrix tmp_mat4;
+		
+		tmp_mat = U_nu_plus_mu*adj(U_mu_plus_nu); // Term in square brackets common to all
+		tmp_mat2 = tmp_mat*adj(u[nu]);            // Term in round brackets common to staples 1 and 5
+		tmp_mat3 = tmp_mat2*Lambda[nu];           // Staple 1
+		tmp_mat4 = Lambda_nu_plus_mu*tmp_mat2;
+		tmp_mat3 -= tmp_mat4;                     // Staple 5 and minus sign
+		tmp_mat3 *= rho(nu,mu);            // Common factor on staple 1 and 5
+		
+		tmp_mat4 = shift(Lambda[mu],FORWARD,nu);
+		tmp_mat2 = tmp_mat*tmp_mat4;                     // Staple 6
+		tmp_mat = tmp_mat2*adj(u[nu]);                   // and again
+		tmp_mat *= rho(mu,nu);                    // rho(mu, nu) factor on staple 6
+		tmp_mat += tmp_mat3;                          // collect staples 1 5 and 6 onto staple sum
+		staple_sum += tmp_mat;                           // slap onto the staple sum
+		
+		// Tmp 3 disappears here
+	      }
+	      
+	      // The three downward staples
+	      //
+	      // Paper Staples 2, 3, and 4;
+	      //
+	      // Staple 2:
+	      //     rho_mu_nu * U^{+}_nu(x-nu+mu) [  U^+_mu(x-nu) Lambda_mu(x-nu)     ] U_nu(x-nu)
+	      // Staple 3
+	      //     rho_nu_mu * U^{+}_nu(x-nu+mu) [ Lambda_nu(x-nu+mu) U^{+}_mu(x-nu) ] U_nu(x-nu)
+	      // Staple 4
+	      //   - rho_nu_mu * U^{+}_nu(x-nu+mu) [ U^{+}_mu(x-nu) Lambda_nu(x-nu)    ] U_nu(x-nu)
+	      //
+	      // I have suggestively placed brackets to show that all these staples share a common
+	      // first and last term. Secondly staples 3 and 4 share the same value of rho (but opposite sign)
+	      //
+	      // Finally this can all be communicated on site and then shifted altoghether to x-nu
+	      {
+		LatticeColorMatrix tmp_mat4;
+		
+		tmp_mat  = Lambda_nu_plus_mu*adj(u[mu]);      // Staple 3 term in brackets
+		tmp_mat4 = adj(u[mu])*Lambda[nu];
+		tmp_mat -= tmp_mat4;                          // Staple 4 term in brackets and -ve sign
+		tmp_mat *= rho(nu,mu);                        // Staple 3 & 4 common rho value
+		tmp_mat2 = adj(u[mu])*Lambda[mu];             // Staple 2 term in brackets
+		tmp_mat2 *= rho(mu,nu);                       // Staple 2 rho factor
+		tmp_mat += tmp_mat2;                          // Combine terms in brackets, signs and rho factors
+		
+		tmp_mat2 = adj(U_nu_plus_mu)*tmp_mat;         // Common first matrix
+		tmp_mat = tmp_mat2*u[nu];                     // Common last matrix
+		
+		staple_sum += shift(tmp_mat, BACKWARD, nu);   // Shift it all back to x-nu
+	      }
+	      
+	    } // end of if mu != nu
+	  } // end nu loop
+	  
+	  // Add on this term - there is a relative minus sign which will be corrected by the sign on 
+	  // on accumulation to F
+	  staple_sum -= adj(data.C[mu])*Lambda[mu];
+	  
+	  F[mu] -= timesI(staple_sum);
+	  
+#if 0
+	  QDPIO::cout << __func__ << ":b,  F[" << mu << "]= " << norm2(F[mu]) 
+		      << "  staple=" << norm2(staple_sum)
+		      << "  Lambda=" << norm2(Lambda[mu]) 
+		      << "  C=" << norm2(data.C[mu]) 
+		      << std::endl;
+#endif
+	} // End of if(smear_in_this_dirP[mu]
+	// Else nothing needs done to the force
+      } // end mu loop
+      
+      swatch.stop();
+      StoutLinkTimings::force_secs += swatch.getTimeInSeconds();
+      
+      // Done
       END_CODE();
     }
     
@@ -975,17 +1325,12 @@ namespace Chroma
     {
       START_CODE();
       
-      LatticeColorMatrix Q, QQ;
-	  
-      // Q contains the staple term. C is a throwaway
-      getQs(current, Q, QQ, mu, smear_in_this_dirP, rho);
-	  
-      // Now compute the f's
-      multi1d<LatticeComplex> f;   // routine will resize these
-      getFs(Q,QQ,f);   // This routine computes the f-s
-	  
-      // Assemble the stout links exp(iQ)U_{mu} 
-      next = (f[0] + f[1]*Q + f[2]*QQ)*current[mu];      
+      // Only the smeared link is wanted, the rest is a throwaway
+      LatticeColorMatrix C, Q, QQ;
+      multi1d<LatticeComplex> f, b_1, b_2;
+
+      StoutUtils::smearStep(current, mu, smear_in_this_dirP, rho, 
+			    C, Q, QQ, f, b_1, b_2, next, false);
       
       END_CODE();
     }
@@ -49,6 +49,30 @@ namespace Chroma
   /*! \ingroup gauge */
   namespace Stouting 
   {
+    //! What one level of stout smearing leaves behind for the force
+    /*!
+     * Filled by smear_links for the directions being smeared and read
+     * back by deriv_recurse, so the force recursion does not redo the
+     * staples and the f-s and b-s of the smearing step. All are
+     * indexed by direction; f, b1 and b2 hold 3 coefficients each.
+     */
+    struct StoutLevelData
+    {
+      multi1d<LatticeColorMatrix>  C;    /*!< rho weighted staple sum */
+      multi1d<LatticeColorMatrix>  Q;    /*!< the links are exp(iQ)U */
+      multi1d<LatticeColorMatrix>  QQ;   /*!< Q^2 */
+      multi1d< multi1d<LatticeComplex> >  f;
+      multi1d< multi1d<LatticeComplex> >  b1;
+      multi1d< multi1d<LatticeComplex> >  b2;
+    };
+
+    //! Given field U, construct the rho weighted staple sum C
+    void getCs(const multi1d<LatticeColorMatrix>& u, 
+	       LatticeColorMatrix& C, 
+	       int mu,
+	       const multi1d<bool>& smear_in_this_dirP,
+	       const multi2d<Real>& rho);
+
     //! Given field U, form Q and Q^2
     void getQs(const multi1d<LatticeColorMatrix>& u, 
 	       LatticeColorMatrix& Q, 
@@ -94,12 +118,27 @@ namespace Chroma
 		     const multi1d<bool>& smear_in_this_dirP,
 		     const multi2d<Real>& rho);
     
+    //! Do the smearing from level i to level i+1, keeping what the force needs
+    void smear_links(const multi1d<LatticeColorMatrix>& current,
+		     multi1d<LatticeColorMatrix>& next, 
+		     const multi1d<bool>& smear_in_this_dirP,
+		     const multi2d<Real>& rho,
+		     StoutLevelData& data);
+
     //! Do the force recursion from level i+1, to level i
     void deriv_recurse(multi1d<LatticeColorMatrix>&  F,
 		       const multi1d<bool>& smear_in_this_dirP,
 		       const multi2d<Real>& rho,
 		       const multi1d<LatticeColorMatrix>& u);
 
+    //! Do the force recursion from level i+1, to level i
+    /*! data must come from smear_links on the same u, smear_in_this_dirP and rho */
+    void deriv_recurse(multi1d<LatticeColorMatrix>&  F,
+		       const multi1d<bool>& smear_in_this_dirP,
+		       const multi2d<Real>& rho,
+		       const multi1d<LatticeColorMatrix>& u,
+		       const StoutLevelData& data);
+
   }
 
   /*! @} */   // end of group gauge
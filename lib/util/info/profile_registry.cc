@@ -0,0 +1,267 @@
+/*! \file
+ *  \brief Hierarchical timers and counters for a run profile
+ */
+
+#include "util/info/profile_registry.h"
+#include <algorithm>
+#include <sstream>
+
+namespace Chroma
+{
+
+  // Utility functions
+  namespace
+  {
+    //! Max over the nodes
+    double maxNodes(double x)
+    {
+      QDPInternal::globalMax(x);
+      return x;
+    }
+
+    //! Min over the nodes
+    double minNodes(double x)
+    {
+      double y = -x;
+      QDPInternal::globalMax(y);
+      return -y;
+    }
+
+    //! Sum over the nodes
+    double sumNodes(double x)
+    {
+      QDPInternal::globalSum(x);
+      return x;
+    }
+  }
+
+
+  //----------------------------------------------------------------------------
+  // Just the root
+  ProfileRegistry::ProfileRegistry() : on(true)
+  {
+    reset();
+  }
+
+
+  // Drop everything recorded
+  void ProfileRegistry::reset()
+  {
+    nodes.clear();
+    nodes.resize(1);
+
+    Node& root = nodes[0];
+    root.name     = "root";
+    root.parent   = -1;
+    root.calls    = 0;
+    root.secs     = 0;
+    root.min_secs = 0;
+    root.max_secs = 0;
+    root.flops    = 0;
+    root.bytes    = 0;
+
+    current = 0;
+  }
+
+
+  // Open a child of the innermost open node
+  int ProfileRegistry::enter(const std::string& name)
+  {
+    if (! on)
+      return -1;
+
+    std::map<std::string, int>::const_iterator p = nodes[current].children.find(name);
+    if (p != nodes[current].children.end())
+    {
+      current = p->second;
+      return current;
+    }
+
+    int n = nodes.size();
+    nodes[current].children[name] = n;
+
+    Node child;
+    child.name     = name;
+    child.parent   = current;
+    child.calls    = 0;
+    child.secs     = 0;
+    child.min_secs = 0;
+    child.max_secs = 0;
+    child.flops    = 0;
+    child.bytes    = 0;
+    nodes.push_back(child);
+
+    current = n;
+    return current;
+  }
+
+
+  // Close the innermost open node
+  void ProfileRegistry::leave(int n, double secs)
+  {
+    if (n < 0)
+      return;
+
+    Node& node = nodes[n];
+
+    node.min_secs = (node.calls == 0) ? secs : std::min(node.min_secs, secs);
+    node.max_secs = std::max(node.max_secs, secs);
+    node.secs    += secs;
+    ++node.calls;
+
+    current = node.parent;
+  }
+
+
+  // Counters of the innermost open node
+  void ProfileRegistry::addFlops(double n)
+  {
+    if (on)
+      nodes[current].flops += n;
+  }
+
+
+  void ProfileRegistry::addBytes(double n)
+  {
+    if (on)
+      nodes[current].bytes += n;
+  }
+
+
+  void ProfileRegistry::addCount(const std::string& counter, double n)
+  {
+    if (on)
+      nodes[current].counts[counter] += n;
+  }
+
+
+  //----------------------------------------------------------------------------
+  // Write node n and its children
+  void ProfileRegistry::writeNode(XMLWriter& xml, int n, bool reduce) const
+  {
+    const Node& node = nodes[n];
+
+    push(xml, "elem");
+    write(xml, "name", node.name);
+    write(xml, "calls", int(node.calls));
+
+    // Total time in this node on each MPI node, and per call on this MPI node
+    double secs   = node.secs;
+    double flops  = node.flops;
+    double bytes  = node.bytes;
+
+    push(xml, "secs");
+    if (reduce)
+    {
+      write(xml, "avg", sumNodes(secs) / Layout::numNodes());
+      write(xml, "min", minNodes(secs));
+      write(xml, "max", maxNodes(secs));
+      secs  = maxNodes(secs);
+      flops = sumNodes(flops);
+      bytes = sumNodes(bytes);
+    }
+    else
+    {
+      write(xml, "avg", secs);
+      write(xml, "min", secs);
+      write(xml, "max", secs);
+    }
+    write(xml, "call_min", node.min_secs);
+    write(xml, "call_max", node.max_secs);
+    pop(xml);
+
+    // Totals over all the MPI nodes; rates against the slowest one
+    write(xml, "flops", flops);
+    write(xml, "bytes", bytes);
+    write(xml, "gflops", (secs > 0) ? flops / secs * 1.0e-9 : 0.0);
+    write(xml, "gbytes_per_sec", (secs > 0) ? bytes / secs * 1.0e-9 : 0.0);
+
+    if (node.counts.size() > 0)
+    {
+      push(xml, "Counts");
+      for(std::map<std::string, double>::const_iterator p = node.counts.begin(); p != node.counts.end(); ++p)
+	write(xml, p->first, p->second);
+      pop(xml);
+    }
+
+    if (node.children.size() > 0)
+    {
+      push(xml, "Children");
+      for(std::map<std::string, int>::const_iterator p = node.children.begin(); p != node.children.end(); ++p)
+	writeNode(xml, p->second, reduce);
+      pop(xml);
+    }
+
+    pop(xml);
+  }
+
+
+  // The tree below node n, in the order writeNode visits it
+  void ProfileRegistry::describe(std::ostream& os, int n) const
+  {
+    const Node& node = nodes[n];
+
+    os << node.name << '(';
+    for(std::map<std::string, int>::const_iterator p = node.children.begin(); p != node.children.end(); ++p)
+      describe(os, p->second);
+    os << ')';
+  }
+
+
+  // Write the tree
+  void ProfileRegistry::write(XMLWriter& xml, const std::string& path) const
+  {
+    START_CODE();
+
+    // The reductions pair up the nodes in tree order, so every MPI node
+    // must have built the same tree. Each node compares its tree with the
+    // primary node's; if any differs, only the local times are written.
+    std::ostringstream os;
+    describe(os, 0);
+
+    std::string primary = os.str();
+    QDPInternal::broadcast_str(primary);
+
+    int differ = (primary == os.str()) ? 0 : 1;
+    QDPInternal::globalSum(differ);
+
+    const bool reduce = (differ == 0);
+
+    if (! reduce)
+      QDPIO::cerr << __func__ << ": profile trees differ between nodes - writing local times only" << std::endl;
+
+    push(xml, path);
+    write(xml, "num_nodes", Layout::numNodes());
+    write(xml, "reduced", reduce);
+
+    // The root is never timed itself, so start with its children
+    push(xml, "Children");
+    for(std::map<std::string, int>::const_iterator p = nodes[0].children.begin(); p != nodes[0].children.end(); ++p)
+      writeNode(xml, p->second, reduce);
+    pop(xml);
+
+    pop(xml);
+
+    END_CODE();
+  }
+
+
+  //----------------------------------------------------------------------------
+  // Open the scope
+  ProfileScope::ProfileScope(const std::string& name)
+  {
+    node = TheProfileRegistry::Instance().enter(name);
+
+    swatch.reset();
+    swatch.start();
+  }
+
+
+  // Close the scope
+  ProfileScope::~ProfileScope()
+  {
+    swatch.stop();
+    TheProfileRegistry::Instance().leave(node, swatch.getTimeInSeconds());
+  }
+
+}  // end namespace Chroma
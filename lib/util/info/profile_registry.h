@@ -0,0 +1,138 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Hierarchical timers and counters for a run profile
+ */
+
+#ifndef __profile_registry_h__
+#define __profile_registry_h__
+
+#include "chromabase.h"
+#include "singleton.h"
+
+#include <vector>
+#include <map>
+
+namespace Chroma
+{
+
+  //! Hierarchical timers and counters
+  /*!
+   * \ingroup info
+   *
+   * The registry is a tree of named nodes. A ProfileScope opens a child of
+   * the innermost open node, named by the caller, and times its lifetime.
+   * The same name under the same parent always refers to the same node, so
+   * the tree is keyed by call path: measurement, sub-phase, solver, and
+   * the operator applications within them. Each node holds the number of
+   * calls, the time spent, and the flops, bytes and named counts reported
+   * while it was the innermost open node.
+   *
+   * Scopes may only be opened on the main thread. Nothing here is collective
+   * except write(), which reduces the times over the nodes.
+   */
+  class ProfileRegistry
+  {
+  public:
+    //! Just the root
+    ProfileRegistry();
+
+    //! Turn the timers on or off. Scopes opened while off are not recorded.
+    void setEnabled(bool on_) {on = on_;}
+
+    //! Are the timers on?
+    bool enabled() const {return on;}
+
+    //! Open the child name of the innermost open node, and return it
+    int enter(const std::string& name);
+
+    //! Close the innermost open node, which took secs
+    void leave(int node, double secs);
+
+    //! Add flops to the innermost open node
+    void addFlops(double n);
+
+    //! Add bytes moved to the innermost open node
+    void addBytes(double n);
+
+    //! Add to a named count of the innermost open node
+    void addCount(const std::string& counter, double n);
+
+    //! Drop everything recorded
+    void reset();
+
+    //! Write the tree with min/max/avg times over the nodes. Collective.
+    void write(XMLWriter& xml, const std::string& path) const;
+
+  private:
+    //! A timer and its counters
+    struct Node
+    {
+      std::string                  name;
+      int                          parent;
+      std::map<std::string, int>   children;
+
+      unsigned long                calls;
+      double                       secs;
+      double                       min_secs;
+      double                       max_secs;
+      double                       flops;
+      double                       bytes;
+      std::map<std::string, double>  counts;
+    };
+
+    //! Write node n and its children
+    void writeNode(XMLWriter& xml, int n, bool reduce) const;
+
+    //! Names of node n and all below it, as nested lists
+    void describe(std::ostream& os, int n) const;
+
+    std::vector<Node>  nodes;      /*!< nodes[0] is the root */
+    int                current;    /*!< innermost open node */
+    bool               on;
+  };
+
+
+  //! The run profile
+  /*! \ingroup info */
+  typedef SingletonHolder<ProfileRegistry,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheProfileRegistry;
+
+
+  //! Times its lifetime as a child of the innermost open scope
+  /*! \ingroup info */
+  class ProfileScope
+  {
+  public:
+    //! Open the scope
+    explicit ProfileScope(const std::string& name);
+
+    //! Close the scope
+    ~ProfileScope();
+
+  private:
+    // Hide copies
+    ProfileScope(const ProfileScope&);
+    void operator=(const ProfileScope&);
+
+    int        node;
+    StopWatch  swatch;
+  };
+
+
+  //! Add flops to the innermost open scope
+  /*! \ingroup info */
+  inline void profileFlops(double n) {TheProfileRegistry::Instance().addFlops(n);}
+
+  //! Add bytes moved to the innermost open scope
+  /*! \ingroup info */
+  inline void profileBytes(double n) {TheProfileRegistry::Instance().addBytes(n);}
+
+  //! Add to a named count of the innermost open scope
+  /*! \ingroup info */
+  inline void profileCount(const std::string& counter, double n) {TheProfileRegistry::Instance().addCount(counter, n);}
+
+}  // end namespace Chroma
+
+#endif
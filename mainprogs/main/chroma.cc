@@ -3,6 +3,10 @@
  */
 
 #include "chroma.h"
+#include "util/info/profile_registry.h"
+#include <algorithm>
+#include <glob.h>
+#include <sys/stat.h>
 
 using namespace Chroma;
 extern "C" { 
@@ -18,10 +22,21 @@ struct Params_t
   std::string     inline_measurement_xml;
 };
 
+//! Parameters for running the measurements over many configurations
+struct CfgStream_t
+{
+  bool                      enabled;       /*!< stream mode is on if a CfgStream group is present */
+  multi1d<std::string>      cfg_files;     /*!< explicit list of configurations */
+  std::string               cfg_glob;      /*!< optional glob pattern appended to cfg_files */
+  std::string               xml_out_stem;  /*!< per-configuration output is xml_out_stem.<n>.xml */
+  bool                      prefetch;      /*!< read the next configuration file in the background */
+};
+
 struct Inline_input_t
 {
   Params_t        param;
   GroupXML_t      cfg;
+  CfgStream_t     stream;
   QDP::Seed       rng_seed;
 };
 
@@ -40,6 +55,26 @@ void read(XMLReader& xml, const std::string& path, Params_t& p)
 }
 
 
+void read(XMLReader& xml, const std::string& path, CfgStream_t& p) 
+{
+  XMLReader paramtop(xml, path);
+
+  p.enabled = true;
+
+  if (paramtop.count("cfg_files") > 0)
+    read(paramtop, "cfg_files", p.cfg_files);
+
+  if (paramtop.count("cfg_glob") > 0)
+    read(paramtop, "cfg_glob", p.cfg_glob);
+
+  read(paramtop, "xml_out_stem", p.xml_out_stem);
+
+  p.prefetch = true;
+  if (paramtop.count("prefetch") > 0)
+    read(paramtop, "prefetch", p.prefetch);
+}
+
+
 void read(XMLReader& xml, const std::string& path, Inline_input_t& p) 
 {
   try {
@@ -48,6 +83,10 @@ void read(XMLReader& xml, const std::string& path, Inline_input_t& p)
     read(paramtop, "Param", p.param);
     p.cfg = readXMLGroup(paramtop, "Cfg", "cfg_type");
 
+    p.stream.enabled = false;
+    if (paramtop.count("CfgStream") > 0)
+      read(paramtop, "CfgStream", p.stream);
+
     if (paramtop.count("RNG") > 0)
       read(paramtop, "RNG", p.rng_seed);
     else
@@ -73,6 +112,365 @@ bool linkageHack(void)
   return foo;
 }
 
+
+//! Expand the stream parameters into the list of configuration files
+/*! 
+ * The glob is expanded on the primary node only, sorted by glob(3), and
+ * the list broadcast, so every node sees the same files in the same order.
+ */
+std::vector<std::string> streamCfgFiles(const CfgStream_t& stream)
+{
+  std::vector<std::string> files;
+
+  for(int i=0; i < stream.cfg_files.size(); ++i)
+    files.push_back(stream.cfg_files[i]);
+
+  if (stream.cfg_glob != "")
+  {
+    // Matches one per line, or empty with stat nonzero on an error
+    std::string matches;
+    int stat = 0;
+
+    if (Layout::primaryNode())
+    {
+      glob_t gl;
+      stat = glob(stream.cfg_glob.c_str(), 0, NULL, &gl);
+      if (stat == 0)
+      {
+	for(size_t i=0; i < gl.gl_pathc; ++i)
+	  matches += std::string(gl.gl_pathv[i]) + "\n";
+      }
+      globfree(&gl);
+
+      if (stat == GLOB_NOMATCH)
+	stat = 0;
+    }
+
+    QDPInternal::broadcast(stat);
+    if (stat != 0)
+    {
+      std::ostringstream error_stream;
+      error_stream << "CHROMA: error expanding cfg_glob = " << stream.cfg_glob;
+      throw error_stream.str();
+    }
+
+    QDPInternal::broadcast_str(matches);
+
+    std::istringstream is(matches);
+    std::string file;
+    while (std::getline(is, file))
+      files.push_back(file);
+  }
+
+  return files;
+}
+
+
+//! Whether a configuration file exists, as seen by the primary node. Collective
+bool streamCfgExists(const std::string& cfg_file)
+{
+  int exists = 0;
+
+  if (Layout::primaryNode())
+  {
+    struct stat st;
+    exists = (stat(cfg_file.c_str(), &st) == 0 && S_ISREG(st.st_mode)) ? 1 : 0;
+  }
+
+  QDPInternal::broadcast(exists);
+  return exists != 0;
+}
+
+
+//! Return a copy of the Cfg group with its cfg_file replaced
+GroupXML_t streamCfgGroup(const GroupXML_t& cfg, const std::string& cfg_file)
+{
+  const std::string open_tag  = "<cfg_file>";
+  const std::string close_tag = "</cfg_file>";
+
+  std::string::size_type beg = cfg.xml.find(open_tag);
+  std::string::size_type end = cfg.xml.find(close_tag);
+  if (beg == std::string::npos || end == std::string::npos || end < beg)
+  {
+    throw std::string("CHROMA: CfgStream requires the Cfg group to contain a cfg_file element");
+  }
+  beg += open_tag.size();
+
+  GroupXML_t new_cfg = cfg;
+  new_cfg.xml = cfg.xml.substr(0, beg) + cfg_file + cfg.xml.substr(end);
+
+  return new_cfg;
+}
+
+
+//! Read a gauge field through the gauge init factory
+/*! Errors are thrown rather than aborting so the caller can decide */
+void readGauge(const GroupXML_t& cfg,
+	       XMLReader& gauge_file_xml,
+	       XMLReader& gauge_xml,
+	       multi1d<LatticeColorMatrix>& u)
+{
+  std::istringstream  xml_c(cfg.xml);
+  XMLReader  cfgtop(xml_c);
+  QDPIO::cout << "CHROMA: Gauge initialization: cfg_type = " << cfg.id << std::endl;
+
+  Handle< GaugeInit >
+    gaugeInit(TheGaugeInitFactory::Instance().createObject(cfg.id,
+							   cfgtop,
+							   cfg.path));
+  (*gaugeInit)(gauge_file_xml, gauge_xml, u);
+}
+
+
+//! Erase every named object that is not in the list of ids to keep
+/*! 
+ * Objects created by the measurements (propagators, eigenvectors, smeared
+ * fields, ...) are derived from the current gauge field and are therefore
+ * stale once it changes. Anything present before the stream started is kept.
+ */
+void eraseGaugeDependentObjects(const std::vector<std::string>& keep)
+{
+  std::vector<std::string> ids = TheNamedObjMap::Instance().keys();
+  for(std::vector<std::string>::const_iterator id = ids.begin(); id != ids.end(); ++id)
+  {
+    if (std::find(keep.begin(), keep.end(), *id) == keep.end())
+    {
+      QDPIO::cout << "CHROMA: erasing named object " << *id << std::endl;
+      TheNamedObjMap::Instance().erase(*id);
+    }
+  }
+}
+
+
+//! Run the measurements on a single, already read, gauge field
+void doMeasurements(multi1d< Handle<AbsInlineMeasurement> >& the_measurements,
+		    unsigned long cur_update,
+		    XMLWriter& xml_out)
+{
+  push(xml_out, "InlineObservables");
+  xml_out.flush();
+
+  for(int m=0; m < the_measurements.size(); m++) 
+  {
+    AbsInlineMeasurement& the_meas = *(the_measurements[m]);
+    if( cur_update % the_meas.getFrequency() == 0 ) 
+    {
+      // Caller writes elem rule
+      push(xml_out, "elem");
+      the_meas(cur_update, xml_out);
+      pop(xml_out); 
+
+      xml_out.flush();
+    }
+  }
+
+  pop(xml_out); // pop("InlineObservables");
+}
+
+
+//! Start reading the next configuration of the stream in the background
+/*! Staged if its format allows, otherwise only read ahead. Collective */
+void startNextCfg(StagedGaugeRead& staged, FileReadahead& readahead,
+		  const std::string& cfg_type, const std::string& cfg_file)
+{
+  if (staged.start(cfg_type, cfg_file))
+  {
+    QDPIO::cout << "CHROMA: staged read of " << cfg_file << " started" << std::endl;
+    return;
+  }
+
+  readahead.start(cfg_file);
+}
+
+
+//! Run the measurements over a stream of configurations
+/*!
+ * The measurements are parsed and constructed once. For each configuration
+ * the default gauge field is swapped and the measurements run, writing to
+ * a separate XML file.
+ *
+ * A configuration whose file is missing is reported and skipped; all nodes
+ * check this together before anything is read. So is one whose reader or
+ * measurements throw. The readers and most measurements QDP_abort on an
+ * error, which still ends the whole job.
+ *
+ * With prefetch on, configuration n+1 is read while the measurements on
+ * n run. MILC and SZIN files are read by threads on every node into a
+ * staging field and their checksums computed (StagedGaugeRead), so at
+ * the top of n+1 only the checks across the nodes and a copy are left.
+ * The other formats only get a readahead into the page cache of the
+ * primary node (FileReadahead), and their reader still reads the file
+ * in the foreground. QIO files (SZINQIO) get neither, since QIO does its
+ * own reads on its own nodes. The first configuration is always read in
+ * the foreground.
+ */
+void doStream(const Inline_input_t& input, XMLWriter& xml_out)
+{
+  StopWatch swatch;
+  swatch.reset();
+  swatch.start();
+
+  std::vector<std::string> cfg_files = streamCfgFiles(input.stream);
+
+  QDPIO::cout << "CHROMA: stream mode over " << cfg_files.size() << " configurations" << std::endl;
+
+  std::istringstream Measurements_is(input.param.inline_measurement_xml);
+  XMLReader MeasXML(Measurements_is);
+  multi1d < Handle< AbsInlineMeasurement > > the_measurements;
+  read(MeasXML, "/InlineMeasurements", the_measurements);
+
+  QDPIO::cout << "CHROMA: There are " << the_measurements.size() << " measurements " << std::endl;
+
+  swatch.stop();
+  QDPIO::cout << "CHROMA: parsing inline measurements time=" << swatch.getTimeInSeconds() << " secs" << std::endl;
+
+  // Anything existing now survives every configuration
+  const std::vector<std::string> keep = TheNamedObjMap::Instance().keys();
+
+  const bool prefetch = input.stream.prefetch && input.cfg.id != "SZINQIO";
+  if (input.stream.prefetch && ! prefetch)
+    QDPIO::cout << "CHROMA: no prefetch for cfg_type = " << input.cfg.id << std::endl;
+
+  StagedGaugeRead staged;
+  FileReadahead   readahead;
+
+  int num_failed = 0;
+  push(xml_out, "CfgStream");
+
+  for(int n=0; n < cfg_files.size(); ++n)
+  {
+    std::ostringstream xml_out_name;
+    xml_out_name << input.stream.xml_out_stem << "." << n << ".xml";
+
+    QDPIO::cout << "CHROMA: stream cfg " << n << " : " << cfg_files[n] 
+		<< "  output= " << xml_out_name.str() << std::endl;
+
+    push(xml_out, "elem");
+    write(xml_out, "cfg_file", cfg_files[n]);
+    write(xml_out, "xml_out", xml_out_name.str());
+
+    bool success = true;
+    StopWatch cfg_watch;
+    cfg_watch.reset();
+    cfg_watch.start();
+
+    try
+    {
+      XMLFileWriter cfg_xml_out(xml_out_name.str());
+      push(cfg_xml_out, "chroma");
+      write(cfg_xml_out, "cfg_file", cfg_files[n]);
+
+      multi1d<LatticeColorMatrix> u(Nd);
+      XMLReader gauge_file_xml, gauge_xml;
+
+      // A staged read was started only if the file was there
+      bool read = false;
+      if (staged.active())
+      {
+	swatch.reset();
+	swatch.start();
+	read = staged.finish(gauge_xml, u);
+	swatch.stop();
+
+	if (read)
+	  QDPIO::cout << "CHROMA: Gauge field taken from the staged read: time= " 
+		      << swatch.getTimeInSeconds() << " secs" << std::endl;
+      }
+
+      if (! read)
+      {
+	swatch.reset();
+	swatch.start();
+	size_t bytes = readahead.wait();
+	swatch.stop();
+	QDPIO::cout << "CHROMA: waited for readahead of " << bytes
+		    << " bytes: time= " << swatch.getTimeInSeconds() << " secs" << std::endl;
+
+	if (! streamCfgExists(cfg_files[n]))
+	{
+	  std::ostringstream error_stream;
+	  error_stream << "no such file " << cfg_files[n];
+	  throw error_stream.str();
+	}
+
+	swatch.reset();
+	swatch.start();
+	readGauge(streamCfgGroup(input.cfg, cfg_files[n]), gauge_file_xml, gauge_xml, u);
+	swatch.stop();
+
+	QDPIO::cout << "CHROMA: Gauge field successfully read: time= " 
+		    << swatch.getTimeInSeconds() 
+		    << " secs" << std::endl;
+      }
+
+      XMLBufferWriter config_xml;
+      config_xml << gauge_xml;
+
+      write(cfg_xml_out, "Config_info", gauge_xml);
+      MesPlq(cfg_xml_out, "Observables", u);
+
+      // Swap the default gauge field
+      InlineDefaultGaugeField::reset();
+      InlineDefaultGaugeField::set(u, config_xml);
+
+      // Overlap reading the next file with these measurements
+      if (prefetch && n+1 < cfg_files.size())
+	startNextCfg(staged, readahead, input.cfg.id, cfg_files[n+1]);
+
+      swatch.reset();
+      swatch.start();
+      doMeasurements(the_measurements, n, cfg_xml_out);
+      swatch.stop();
+
+      QDPIO::cout << "CHROMA: measurements: time= " 
+		  << swatch.getTimeInSeconds() 
+		  << " secs" << std::endl;
+
+      pop(cfg_xml_out);
+      cfg_xml_out.close();
+    }
+    catch(const std::string& e) 
+    {
+      QDPIO::cerr << "CHROMA: Caught Exception on cfg " << cfg_files[n] << ": " << e << std::endl;
+      success = false;
+    }
+    catch(const char* e) 
+    { 
+      QDPIO::cerr << "CHROMA: Caught const char * exception on cfg " << cfg_files[n] << ": " << e << std::endl;
+      success = false;
+    }
+    catch(std::exception& e) 
+    {
+      QDPIO::cerr << "CHROMA: Caught standard library exception on cfg " << cfg_files[n] << ": " << e.what() << std::endl;
+      success = false;
+    }
+
+    // Whatever happened, nothing derived from this gauge field may leak into the next
+    InlineDefaultGaugeField::reset();
+    eraseGaugeDependentObjects(keep);
+
+    // A failure before the next read was started must not stall it
+    if (prefetch && ! staged.active() && ! readahead.active() && n+1 < cfg_files.size())
+      startNextCfg(staged, readahead, input.cfg.id, cfg_files[n+1]);
+
+    cfg_watch.stop();
+    if (! success)
+      ++num_failed;
+
+    write(xml_out, "success", success);
+    write(xml_out, "time", cfg_watch.getTimeInSeconds());
+    pop(xml_out); // elem
+    xml_out.flush();
+  }
+
+  write(xml_out, "num_failed", num_failed);
+  pop(xml_out); // CfgStream
+
+  QDPIO::cout << "CHROMA: stream finished: " << cfg_files.size() - num_failed 
+	      << " of " << cfg_files.size() << " configurations succeeded" << std::endl;
+}
+
+
 //! Main program to run all measurement codes
 /*! \defgroup chromamain Main program to run all measurement codes.
  *  \ingroup main
@@ -133,6 +531,34 @@ int main(int argc, char *argv[])
   QDP::RNG::setrn(input.rng_seed);
   write(xml_out,"RNG", input.rng_seed);
 
+  // Many configurations: parse once, loop over the gauge fields
+  if (input.stream.enabled)
+  {
+    try
+    {
+      doStream(input, xml_out);
+    }
+    catch(const std::string& e) 
+    {
+      QDPIO::cerr << "CHROMA: Caught Exception: " << e << std::endl;
+      QDP_abort(1);
+    }
+    TheProfileRegistry::Instance().write(xml_out, "Profile");
+    pop(xml_out);
+
+    snoop.stop();
+    QDPIO::cout << "CHROMA: total time = "
+		<< snoop.getTimeInSeconds() 
+		<< " secs" << std::endl;
+
+    QDPIO::cout << "CHROMA: ran successfully" << std::endl;
+
+    END_CODE();
+
+    Chroma::finalize();
+    exit(0);
+  }
+
   // Start up the config
   StopWatch swatch;
   swatch.reset();
@@ -144,6 +570,7 @@ int main(int argc, char *argv[])
   swatch.start();
   try 
   {
+    ProfileScope scope("gauge_init");
     std::istringstream  xml_c(input.cfg.xml);
     XMLReader  cfgtop(xml_c);
     QDPIO::cout << "CHROMA: Gauge initialization: cfg_type = " << input.cfg.id << std::endl;
@@ -289,6 +716,7 @@ int main(int argc, char *argv[])
     std::cerr << "Rethrowing" << std::endl;
     throw;
   }
+  TheProfileRegistry::Instance().write(xml_out, "Profile");
   pop(xml_out);
 
   snoop.stop();
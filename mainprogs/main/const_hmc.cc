@@ -3,6 +3,7 @@
  */
 
 #include "chroma.h"
+#include "util/info/profile_registry.h"
 #include <string>
 
 using namespace Chroma;
@@ -459,7 +460,10 @@ namespace Chroma
 	  swatch.start();
 
 	  // This may do a reversibility check 
-	  theHMCTrj( gauge_state, warm_up_p, do_reverse ); 
+	  {
+	    ProfileScope scope("trajectory");
+	    theHMCTrj( gauge_state, warm_up_p, do_reverse );
+	  }
 	  swatch.stop(); 
 	  
 	  QDPIO::cout << "After HMC trajectory call: time= "
@@ -487,7 +491,10 @@ namespace Chroma
 	  swatch.reset(); 
 	  swatch.start();
 	  // Dont repeat the reversibility check in the repro test
-	  theHMCTrj( gauge_state, warm_up_p, false ); 
+	  {
+	    ProfileScope scope("trajectory");
+	    theHMCTrj( gauge_state, warm_up_p, false );
+	  }
 	  swatch.stop(); 
 	  
 	  QDPIO::cout << "After HMC repro trajectory call: time= "
@@ -532,7 +539,10 @@ namespace Chroma
 	  QDPIO::cout << "Before HMC trajectory call" << std::endl;
 	  swatch.reset();
 	  swatch.start();
-	  theHMCTrj( gauge_state, warm_up_p, do_reverse  );
+	  {
+	    ProfileScope scope("trajectory");
+	    theHMCTrj( gauge_state, warm_up_p, do_reverse  );
+	  }
 	  swatch.stop();
 	
 	  QDPIO::cout << "After HMC trajectory call: time= "
@@ -898,6 +908,7 @@ int main(int argc, char *argv[])
     QDP_abort(1);
   }
 
+  TheProfileRegistry::Instance().write(xml_out, "Profile");
   pop(xml_log);  // hmc
   pop(xml_out);  // hmc
 
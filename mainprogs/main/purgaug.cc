@@ -3,6 +3,7 @@
  */
 
 #include "chroma.h"
+#include "util/info/profile_registry.h"
 #include "actions/gauge/gaugeacts/gaugeacts_aggregate.h"
 
 using namespace Chroma;
@@ -415,7 +416,10 @@ namespace Chroma
       write(xml_out, "WarmUpP", true);
 
       // Do the update, but with no measurements
-      mciter(u, S_g, hb_control.hbitr_params.hb_params); //one hb sweep
+      {
+	ProfileScope scope("heatbath");
+	mciter(u, S_g, hb_control.hbitr_params.hb_params); //one hb sweep
+      }
 
       // Do measurements
       doMeas(xml_out, u, hb_control, true, cur_update,
@@ -476,7 +480,10 @@ namespace Chroma
       write(xml_out, "WarmUpP", false);
 
       // Do the update
-      mciter(u, S_g, hb_control.hbitr_params.hb_params); //one hb sweep
+      {
+	ProfileScope scope("heatbath");
+	mciter(u, S_g, hb_control.hbitr_params.hb_params); //one hb sweep
+      }
 
       // Do measurements
       doMeas(xml_out, u, hb_control, false, cur_update,
@@ -739,6 +746,7 @@ int main(int argc, char *argv[])
     QDP_abort(1);
   }
 
+  TheProfileRegistry::Instance().write(xml_out, "Profile");
   pop(xml_out);
 
   END_CODE();
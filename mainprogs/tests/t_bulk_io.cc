@@ -0,0 +1,138 @@
+/*! \file
+ *  \brief Round trip the MILC and SZIN gauge formats through the bulk and serial paths
+ *
+ *  Every file is written once by the bulk path and once by the serial
+ *  path, and each is read back by both. The two readers have to agree
+ *  exactly and give back the links that were written, up to the single
+ *  precision of the formats.
+ */
+
+#include "chroma.h"
+#include "io/bulk_io.h"
+
+#include <cstdio>
+
+using namespace Chroma;
+
+namespace
+{
+  //! Relative difference of two gauge fields, and a failure if it is above tol
+  template<typename U1, typename U2>
+  int compare(const multi1d<U1>& a, const multi1d<U2>& b, double tol, const std::string& what)
+  {
+    Double diff = zero;
+    Double ref  = zero;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      U1 bb(b[mu]);
+      diff += norm2(a[mu] - bb);
+      ref  += norm2(bb);
+    }
+
+    double rel = toDouble(sqrt(diff / ref));
+    QDPIO::cout << "  " << what << ": relative difference = " << rel << std::endl;
+
+    return (rel > tol) ? 1 : 0;
+  }
+
+  //! Write with one path, read with both
+  int checkMILC(const multi1d<LatticeColorMatrix>& u, bool bulk_write, const std::string& file)
+  {
+    MILCGauge_t header;
+    BulkIO::setEnabled(bulk_write);
+    writeMILC(header, u, file);
+
+    multi1d<LatticeColorMatrixF> u_bulk, u_serial;
+
+    BulkIO::setEnabled(true);
+    readMILC(header, u_bulk, file);
+
+    BulkIO::setEnabled(false);
+    readMILC(header, u_serial, file);
+
+    BulkIO::setEnabled(true);
+
+    int fail = 0;
+    fail += compare(u_bulk, u_serial, 0, "bulk vs serial read  ");
+    fail += compare(u_bulk, u, 1.0e-6, "bulk read vs written ");
+
+    return fail;
+  }
+
+  //! Write with one path, read with both
+  int checkSzin(const multi1d<LatticeColorMatrix>& u, bool bulk_write, const std::string& file)
+  {
+    SzinGauge_t header;
+    BulkIO::setEnabled(bulk_write);
+    writeSzin(header, u, file);
+
+    multi1d<LatticeColorMatrix> u_bulk, u_serial;
+
+    BulkIO::setEnabled(true);
+    readSzin(header, u_bulk, file);
+
+    BulkIO::setEnabled(false);
+    readSzin(header, u_serial, file);
+
+    BulkIO::setEnabled(true);
+
+    int fail = 0;
+    fail += compare(u_bulk, u_serial, 0, "bulk vs serial read  ");
+    fail += compare(u_bulk, u, 1.0e-6, "bulk read vs written ");
+
+    return fail;
+  }
+}
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 6, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  multi1d<LatticeColorMatrix> u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  const std::string milc_file = "t_bulk_io.milc";
+  const std::string szin_file = "t_bulk_io.szin";
+  int fail = 0;
+
+  for(int bulk_write=1; bulk_write >= 0; --bulk_write)
+  {
+    const char* how = bulk_write ? "bulk" : "serial";
+
+    QDPIO::cout << "MILC, " << how << " write:" << std::endl;
+    fail += checkMILC(u, bulk_write, milc_file);
+
+    QDPIO::cout << "SZIN, " << how << " write:" << std::endl;
+    fail += checkSzin(u, bulk_write, szin_file);
+  }
+
+  if (Layout::primaryNode())
+  {
+    std::remove(milc_file.c_str());
+    std::remove(szin_file.c_str());
+  }
+
+  if (fail > 0)
+  {
+    QDPIO::cerr << "t_bulk_io: " << fail << " fields differ between the bulk and serial paths" << std::endl;
+    QDP_abort(1);
+  }
+
+  QDPIO::cout << "t_bulk_io: all round trips agree" << std::endl;
+
+  Chroma::finalize();
+  exit(0);
+}
@@ -13,6 +13,89 @@ typedef multi1d<LatticeColorMatrix> Q;
 typedef multi1d<LatticeColorMatrix> P;
 
 
+//! Time apply, choles and triacntr of QDPCloverTerm with one storage layout
+/*! Leaves behind the term and its inverse applied to src, and the log det */
+void timeLayout(Handle< FermState<T,P,Q> > fs, CloverFermActParams params,
+		bool soa, const LatticeFermion& src, LatticeFermion& dest,
+		LatticeFermion& dest_inv, Double& logdet)
+{
+  params.soa_layoutP = soa;
+  const std::string name = soa ? "SoA" : "AoS";
+
+  QDPCloverTerm clov;
+  clov.create(fs, params);
+
+  const int cb = 0;
+  const double sites = (double)rb[cb].numSiteTable();
+  const int n_iters = 200;
+  StopWatch swatch;
+  double time;
+
+  // Bytes per site of clover storage, and streamed by one apply
+  typedef WordType<T>::Type_t REALT;
+  double clov_bytes = soa
+    ? (double)(QDPCloverEnv::numSoABlocks(cb)*sizeof(PrimitiveClovTriangSoA<REALT>))/sites
+    : (double)sizeof(PrimitiveClovTriang<REALT>);
+  double spinor_bytes = (double)(Ns*Nc*2*sizeof(REALT));
+
+  dest = zero;
+  swatch.reset();
+  swatch.start();
+  for(int i=0; i < n_iters; i++) {
+    clov.apply(dest, src, PLUS, cb);
+  }
+  swatch.stop();
+  time = swatch.getTimeInSeconds();
+  QDPInternal::globalSum(time);
+  time /= (double)Layout::numNodes();
+
+  double gflops = (double)clov.nFlops()*sites*(double)n_iters/time/1.0e9;
+  QDPIO::cout << name << " apply:    " << gflops << " GFLOP/s per node, "
+	      << clov_bytes << " clover bytes/site, "
+	      << clov_bytes + 2*spinor_bytes << " bytes/site streamed, "
+	      << gflops*(clov_bytes + 2*spinor_bytes)/(double)clov.nFlops()
+	      << " GB/s" << std::endl;
+
+  swatch.reset();
+  swatch.start();
+  for(int i=0; i < n_iters/10; i++) {
+    // Inverting the inverse gets back the original, so repeat freely
+    clov.choles(cb);
+  }
+  swatch.stop();
+  time = swatch.getTimeInSeconds();
+  QDPInternal::globalSum(time);
+  time /= (double)Layout::numNodes();
+  QDPIO::cout << name << " choles:   " << 1.0e6*time/(double)(n_iters/10)/sites
+	      << " usec/site" << std::endl;
+
+  LatticeColorMatrix B;
+  const int mats[7] = { 0, 3, 5, 6, 9, 10, 12 };
+  swatch.reset();
+  swatch.start();
+  for(int i=0; i < n_iters/10; i++) {
+    for(int m=0; m < 7; m++) {
+      clov.triacntr(B, mats[m], cb);
+    }
+  }
+  swatch.stop();
+  time = swatch.getTimeInSeconds();
+  QDPInternal::globalSum(time);
+  time /= (double)Layout::numNodes();
+  QDPIO::cout << name << " triacntr: " << 1.0e6*time/(double)(7*(n_iters/10))/sites
+	      << " usec/site" << std::endl;
+
+  // Leave the results behind for the cross check
+  dest = zero;
+  clov.apply(dest, src, PLUS, cb);
+
+  clov.choles(cb);
+  logdet = clov.cholesDet(cb);
+  dest_inv = zero;
+  clov.apply(dest_inv, src, PLUS, cb);
+}
+
+
 int main(int argc, char *argv[]) 
 {
   // Put the machine into a known state
@@ -104,6 +187,36 @@ int main(int argc, char *argv[])
 
   }
 
+  {
+    // Compare the two storage layouts of the QDP clover term
+    LatticeFermion inv1, inv2;
+    Double logdet1, logdet2;
+    timeLayout(fs, params, false, src, dest1, inv1, logdet1);
+    timeLayout(fs, params, true, src, dest2, inv2, logdet2);
+
+    int fail = 0;
+    Double diff = sqrt(norm2(dest1 - dest2, rb[0]) / norm2(dest1, rb[0]));
+    QDPIO::cout << "AoS vs SoA apply:   relative difference = " << diff << std::endl;
+    if (toDouble(diff) > 1.0e-5)
+      ++fail;
+
+    diff = sqrt(norm2(inv1 - inv2, rb[0]) / norm2(inv1, rb[0]));
+    QDPIO::cout << "AoS vs SoA inverse: relative difference = " << diff << std::endl;
+    if (toDouble(diff) > 1.0e-5)
+      ++fail;
+
+    diff = fabs(logdet1 - logdet2) / fabs(logdet1);
+    QDPIO::cout << "AoS vs SoA log det: relative difference = " << diff << std::endl;
+    if (toDouble(diff) > 1.0e-5)
+      ++fail;
+
+    if (fail > 0)
+    {
+      QDPIO::cerr << "t_clover: " << fail << " results of the SoA layout differ from AoS" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
   CloverTerm opt_clov;
   opt_clov.create(fs, params);
 
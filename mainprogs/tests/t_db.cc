@@ -0,0 +1,253 @@
+/*! \file
+ *  \brief Time serialization and inserts of elemental sized DB values
+ *
+ *  Compares the BinaryBufferWriter serialization with writeDBBytes, checks
+ *  both give the same bytes, and times the two ways the measurements insert:
+ *  a BinaryStoreDB on every node, one pair at a time or with insertSorted,
+ *  and the AsyncDBWriter the distillation measurements use.
+ */
+
+#include "chroma.h"
+#include "util/ferm/key_val_db.h"
+#include "util/ferm/key_prop_matelem.h"
+#include "util/ferm/async_db_writer.h"
+#include <fcntl.h>
+#include <cstdio>
+
+using namespace Chroma;
+
+namespace
+{
+  typedef SerialDBKey<KeyPropElementalOperator_t>  Key_t;
+  typedef SerialDBData< multi2d<ComplexD> >        Val_t;
+  typedef std::vector< std::pair<Key_t, Val_t> >   Batch_t;
+
+  //! num elementals of nvec x nvec
+  void makeBatch(Batch_t& batch, int num, int nvec)
+  {
+    batch.resize(num);
+    for(int n=0; n < num; ++n)
+    {
+      KeyPropElementalOperator_t& key = batch[n].first.key();
+      key.t_slice    = n / 16;
+      key.t_source   = 0;
+      key.spin_src   = (n / 4) % 4;
+      key.spin_snk   = n % 4;
+      key.mass_label = "U0.1";
+
+      multi2d<ComplexD>& mat = batch[n].second.data();
+      mat.resize(nvec, nvec);
+      for(int i=0; i < nvec; ++i)
+	for(int j=0; j < nvec; ++j)
+	  mat(i,j) = cmplx(Double(n + 0.5*i), Double(-0.25*j));
+    }
+  }
+
+  //! Create a DB with its user data, and leave it open
+  void create(BinaryStoreDB<Key_t, Val_t>& db, const std::string& file)
+  {
+    if (Layout::primaryNode())
+      std::remove(file.c_str());
+
+    std::string user_data("<t_db/>");
+    db.setMaxUserInfoLen(user_data.size());
+    db.open(file, O_RDWR | O_CREAT, 0664);
+    db.insertUserdata(user_data);
+  }
+
+  //! Abort on a failed insert
+  void check(int ret, const char* what)
+  {
+    if (ret != 0)
+    {
+      QDPIO::cerr << what << ": insert failed, status = " << ret << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+  //! Seconds to insert the batch into a fresh BinaryStoreDB, one pair at a time or with insertSorted
+  double timeInserts(const std::string& file, Batch_t& batch, bool sorted)
+  {
+    BinaryStoreDB<Key_t, Val_t> db;
+    create(db, file);
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    int ret = 0;
+    if (sorted)
+      ret = insertSorted(db, batch);
+    else
+    {
+      for(int n=0; n < batch.size(); ++n)
+      {
+	int r = db.insert(batch[n].first, batch[n].second);
+	if (r != 0 && ret == 0)
+	  ret = r;
+      }
+    }
+    db.close();
+
+    swatch.stop();
+    if (Layout::primaryNode())
+      std::remove(file.c_str());
+
+    check(ret, __func__);
+    return swatch.getTimeInSeconds();
+  }
+
+  //! Seconds to write the batch through an AsyncDBWriter in batches of nsub, and the time the caller waited
+  double timeAsync(const std::string& file, const Batch_t& batch, int nsub, double& wait_secs)
+  {
+    {
+      BinaryStoreDB<Key_t, Val_t> db;
+      create(db, file);
+      db.close();
+    }
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    AsyncDBWriter<Key_t, Val_t> writer;
+    writer.open(file);
+
+    Batch_t sub;
+    for(int n=0; n < batch.size(); ++n)
+    {
+      sub.push_back(batch[n]);
+      if (sub.size() == nsub || n+1 == batch.size())
+	writer.submit(sub);
+    }
+    writer.close();
+
+    swatch.stop();
+    wait_secs = writer.waitTime();
+
+    if (Layout::primaryNode())
+      std::remove(file.c_str());
+
+    return swatch.getTimeInSeconds();
+  }
+}
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  multi1d<int> nrow(Nd);
+  nrow = 4;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // Elementals of typical numbers of vectors
+  const int num_nvec = 3;
+  const int nvecs[num_nvec] = {32, 64, 128};
+  const int num = 256;
+
+  bool pass = true;
+
+  for(int k=0; k < num_nvec; ++k)
+  {
+    const int nvec = nvecs[k];
+    Batch_t batch;
+    makeBatch(batch, num, nvec);
+
+    const double mbytes = double(num)*nvec*nvec*sizeof(ComplexD) / (1024.0*1024.0);
+
+    // Serialization through a BinaryBufferWriter, as SerialDBData used to
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    std::vector<std::string> old_bytes(num);
+    for(int n=0; n < num; ++n)
+    {
+      BinaryBufferWriter bin;
+      write(bin, batch[n].second.data());
+      old_bytes[n] = bin.strPrimaryNode();
+    }
+
+    swatch.stop();
+    double old_secs = swatch.getTimeInSeconds();
+
+    // Straight from the storage
+    swatch.reset();
+    swatch.start();
+
+    std::vector<std::string> new_bytes(num);
+    for(int n=0; n < num; ++n)
+      batch[n].second.writeObject(new_bytes[n]);
+
+    swatch.stop();
+    double new_secs = swatch.getTimeInSeconds();
+
+    // Only the primary node has the BinaryBufferWriter bytes
+    if (Layout::primaryNode())
+    {
+      for(int n=0; n < num; ++n)
+      {
+	if (old_bytes[n] != new_bytes[n])
+	{
+	  QDPIO::cerr << "nvec= " << nvec << ": bytes differ for elemental " << n << std::endl;
+	  pass = false;
+	  break;
+	}
+      }
+    }
+
+    // And back
+    for(int n=0; n < num; ++n)
+    {
+      Val_t val;
+      val.readObject(new_bytes[n]);
+
+      const multi2d<ComplexD>& a = val.data();
+      const multi2d<ComplexD>& b = batch[n].second.data();
+      bool same = (a.size2() == b.size2()) && (a.size1() == b.size1());
+      for(int i=0; same && i < a.size2(); ++i)
+	for(int j=0; same && j < a.size1(); ++j)
+	  same = (toDouble(norm2(a(i,j) - b(i,j))) == 0.0);
+
+      if (! same)
+      {
+	QDPIO::cerr << "nvec= " << nvec << ": read back differs for elemental " << n << std::endl;
+	pass = false;
+	break;
+      }
+    }
+
+    QDPIO::cout << "nvec= " << nvec << "  num= " << num << "  MB= " << mbytes
+		<< "  serialize: BinaryBufferWriter= " << old_secs << " s  writeDBBytes= " << new_secs << " s"
+		<< std::endl;
+
+    // The paths of the measurements, on every node
+    {
+      std::ostringstream file;
+      file << "t_db_" << nvec << ".sdb";
+
+      double one_secs    = timeInserts(file.str(), batch, false);
+      double sorted_secs = timeInserts(file.str(), batch, true);
+
+      double wait_secs;
+      double async_secs  = timeAsync(file.str(), batch, 16, wait_secs);
+
+      QDPIO::cout << "nvec= " << nvec
+		  << "  BinaryStoreDB: one at a time= " << one_secs << " s (" << mbytes/one_secs << " MB/s)"
+		  << "  insertSorted= " << sorted_secs << " s (" << mbytes/sorted_secs << " MB/s)"
+		  << "  AsyncDBWriter: total= " << async_secs << " s (" << mbytes/async_secs << " MB/s)"
+		  << "  caller waited= " << wait_secs << " s"
+		  << std::endl;
+    }
+  }
+
+  QDPIO::cout << (pass ? "PASSED" : "FAILED") << std::endl;
+
+  // Time to bolt
+  Chroma::finalize();
+
+  exit(pass ? 0 : 1);
+}
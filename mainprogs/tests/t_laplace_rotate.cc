@@ -0,0 +1,83 @@
+/*! \file
+ *  \brief Check the in place Ritz rotation of the Laplace eigenvector Lanczos
+ *
+ *  Rotates a random basis with a random matrix of each time slice, keeping
+ *  fewer vectors than the matrices have columns as the thick restart does,
+ *  and compares with the same sum done on whole lattice fields.
+ */
+
+#include "chroma.h"
+#include "meas/inline/hadron/inline_laplace_eigs.h"
+
+using namespace Chroma;
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  SftMom phases(0, true, Nd-1);
+  const Set& tslices = phases.getSet();
+  const int  lt      = tslices.numSubsets();
+
+  const int mdim = 6;
+  int fail = 0;
+
+  // k = mdim is a plain rotation, the others keep part of the basis
+  for(int k=1; k <= mdim; k += 2)
+  {
+    multi1d<LatticeColorVector> v(mdim);
+    for(int j=0; j < mdim; ++j)
+      gaussian(v[j]);
+
+    // Same on every node, like the restart does after its LAPACK call
+    multi1d< multi2d<double> > y(lt);
+    for(int t=0; t < lt; ++t)
+    {
+      y[t].resize(mdim, mdim);
+      for(int j=0; j < mdim; ++j)
+	for(int i=0; i < mdim; ++i)
+	  y[t](j,i) = std::sin(1.0 + t + 0.7*j - 1.3*i);
+    }
+
+    // Reference
+    multi1d<LatticeColorVector> ref(k);
+    for(int i=0; i < k; ++i)
+    {
+      ref[i] = zero;
+      for(int t=0; t < lt; ++t)
+	for(int j=0; j < mdim; ++j)
+	  ref[i][tslices[t]] += Real(y[t](j,i)) * v[j];
+    }
+
+    InlineLaplaceEigsEnv::rotateBasis(v, y, mdim, k, tslices);
+
+    for(int i=0; i < k; ++i)
+    {
+      Double diff = sqrt(norm2(v[i] - ref[i]) / norm2(ref[i]));
+      QDPIO::cout << "k = " << k << "  vector " << i
+		  << ": relative difference = " << diff << std::endl;
+
+      if (toDouble(diff) > 1.0e-5)
+	++fail;
+    }
+  }
+
+  if (fail > 0)
+  {
+    QDPIO::cerr << "t_laplace_rotate: " << fail << " vectors differ from the reference" << std::endl;
+    QDP_abort(1);
+  }
+
+  QDPIO::cout << "t_laplace_rotate: all rotations agree" << std::endl;
+
+  Chroma::finalize();
+  exit(0);
+}
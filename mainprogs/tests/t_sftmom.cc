@@ -0,0 +1,114 @@
+/*! \file
+ *  \brief Check the momentum projections of SftMom against its phase fields
+ *
+ *  For a few momentum sets, with and without averaging over equivalent
+ *  momenta, compares sft over all time slices, which takes the spatial FFT
+ *  once there are enough momenta, and sft on each time slice, which sums
+ *  the terms directly, with sumMulti over the phase fields of operator[].
+ */
+
+#include "chroma.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! Largest |a-b| over the largest |b|
+  double relDiff(const multi2d<DComplex>& a, const multi2d<DComplex>& b)
+  {
+    double diff = 0, scale = 0;
+    for(int m=0; m < b.size2(); ++m)
+      for(int t=0; t < b.size1(); ++t)
+      {
+	diff  = std::max(diff,  toDouble(sqrt(norm2(a[m][t] - b[m][t]))));
+	scale = std::max(scale, toDouble(sqrt(norm2(b[m][t]))));
+      }
+
+    return (scale > 0) ? diff / scale : diff;
+  }
+
+  //! Compare every sft path with the phase fields on one field
+  template<typename T>
+  int check(const SftMom& phases, const T& cf, const std::string& what)
+  {
+    const int nt = phases.numSubsets();
+    const double tol = 1.0e-5;
+    int fail = 0;
+
+    multi2d<DComplex> ref(phases.numMom(), nt);
+    for(int m=0; m < phases.numMom(); ++m)
+      ref[m] = sumMulti(phases[m]*cf, phases.getSet());
+
+    // All time slices at once
+    double diff = relDiff(phases.sft(cf), ref);
+    QDPIO::cout << "  " << what << " all slices: relative difference = " << diff << std::endl;
+    if (diff > tol)
+      ++fail;
+
+    // One time slice at a time
+    multi2d<DComplex> sub(phases.numMom(), nt);
+    for(int t=0; t < nt; ++t)
+    {
+      multi2d<DComplex> one = phases.sft(cf, t);
+      for(int m=0; m < phases.numMom(); ++m)
+	sub[m][t] = one[m][t];
+    }
+
+    diff = relDiff(sub, ref);
+    QDPIO::cout << "  " << what << " per slice:  relative difference = " << diff << std::endl;
+    if (diff > tol)
+      ++fail;
+
+    return fail;
+  }
+}
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  LatticeComplex cf;
+  gaussian(cf);
+
+  LatticeReal rf;
+  gaussian(rf);
+
+  multi1d<int> origin(Nd);
+  origin[0] = 1; origin[1] = 0; origin[2] = 3; origin[3] = 2;
+
+  int fail = 0;
+
+  // On 4^3 mom2_max 0 sums the terms directly and 3 goes through the FFT
+  const int mom2s[] = {0, 1, 3};
+  for(int n=0; n < 3; ++n)
+    for(int avg=0; avg < 2; ++avg)
+    {
+      SftMom phases(mom2s[n], origin, avg == 1, Nd-1);
+
+      QDPIO::cout << "mom2_max = " << mom2s[n] << (avg ? ", averaged" : "")
+		  << ": " << phases.numMom() << " momenta" << std::endl;
+
+      fail += check(phases, cf, "complex");
+      fail += check(phases, rf, "real   ");
+    }
+
+  if (fail > 0)
+  {
+    QDPIO::cerr << "t_sftmom: " << fail << " projections differ from the phase fields" << std::endl;
+    QDP_abort(1);
+  }
+
+  QDPIO::cout << "t_sftmom: all projections agree" << std::endl;
+
+  Chroma::finalize();
+  exit(0);
+}
@@ -0,0 +1,185 @@
+/*! \file
+ *  \brief Check the site local heatbath and overrelaxation against the lattice wide updates
+ *
+ *  The overrelaxation is deterministic and is compared with su3over over
+ *  all SU(2) subgroups. For the heatbath the staple is the same on every
+ *  site, so after some sweeps the links of a checkerboard are independent
+ *  draws from one distribution. Its moments are compared with those of
+ *  su2_hb_update for a small and a large weight, which go through the
+ *  Creutz and the Kennedy-Pendleton draws.
+ */
+
+#include "chroma.h"
+#include "update/heatbath/su3_site_hb.h"
+
+using namespace Chroma;
+
+#ifndef QDP_IS_QDPJIT
+namespace
+{
+  //! Mean and variance over the sites of sub
+  void moments(double& mean, double& var, const LatticeReal& x, const Subset& sub)
+  {
+    double n = sub.numSiteTable();
+    QDPInternal::globalSum(n);
+
+    mean = toDouble(sum(x, sub)) / n;
+    var  = toDouble(sum(x*x, sub)) / n - mean*mean;
+  }
+
+  //! Both updates from the same start, with the staple w on every site
+  int checkHeatbath(const LatticeColorMatrix& u0, const LatticeColorMatrix& w, const std::string& what)
+  {
+    const Subset& sub = rb[0];
+    const int nsweep = 20;
+    const int nmax = 1000;
+    const Real beta = Real(2.0/Nc);
+    const double nsigma = 5;
+
+    LatticeColorMatrix u_site = u0;
+    LatticeColorMatrix u_ref  = u0;
+    int ntry, nfail, nfail_tot = 0;
+
+    for(int sweep=0; sweep < nsweep; ++sweep)
+    {
+      SiteHeatbath::heatbath(u_site, w, beta, nmax, SiteHeatbath::newKey(), 0, sub, ntry, nfail);
+      reunit(u_site);
+      nfail_tot += nfail;
+
+      for(int su2_index=0; su2_index < Nc*(Nc-1)/2; ++su2_index)
+	su2_hb_update(u_ref, w, beta, su2_index, sub, nmax);
+      reunit(u_ref);
+    }
+
+    int fail = 0;
+    if (nfail_tot > 0)
+    {
+      QDPIO::cout << "  " << what << ": " << nfail_tot << " subgroup updates never accepted" << std::endl;
+      ++fail;
+    }
+
+    // Re tr(U W) and Re tr(U W U W) per site
+    LatticeColorMatrix v_site = u_site * w;
+    LatticeColorMatrix v_ref  = u_ref * w;
+
+    LatticeReal obs_site[2], obs_ref[2];
+    obs_site[0] = real(trace(v_site));
+    obs_site[1] = real(trace(v_site*v_site));
+    obs_ref[0]  = real(trace(v_ref));
+    obs_ref[1]  = real(trace(v_ref*v_ref));
+    const char* names[2] = { "Re tr(UW)    ", "Re tr(UWUW)  " };
+
+    double n = sub.numSiteTable();
+    QDPInternal::globalSum(n);
+
+    for(int k=0; k < 2; ++k)
+    {
+      double m_site, v_s, m_ref, v_r;
+      moments(m_site, v_s, obs_site[k], sub);
+      moments(m_ref,  v_r, obs_ref[k],  sub);
+
+      double sigma = sqrt((v_s + v_r) / n);
+      double z = (sigma > 0) ? fabs(m_site - m_ref) / sigma : 0;
+
+      QDPIO::cout << "  " << what << " " << names[k] << ": site = " << m_site
+		  << "  reference = " << m_ref << "  difference = " << z << " sigma" << std::endl;
+
+      if (z > nsigma)
+	++fail;
+    }
+
+    // The same key gives the same links
+    SiteHeatbath::Key key = SiteHeatbath::newKey();
+    LatticeColorMatrix u1 = u0;
+    LatticeColorMatrix u2 = u0;
+    SiteHeatbath::heatbath(u1, w, beta, nmax, key, 1, sub, ntry, nfail);
+    SiteHeatbath::heatbath(u2, w, beta, nmax, key, 1, sub, ntry, nfail);
+
+    double diff = toDouble(norm2(u1 - u2));
+    QDPIO::cout << "  " << what << " repeated with the same key: norm2 difference = " << diff << std::endl;
+    if (diff != 0)
+      ++fail;
+
+    return fail;
+  }
+}
+#endif
+
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {8, 8, 8, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+#ifndef QDP_IS_QDPJIT
+  int fail = 0;
+
+  // Random SU(Nc) links and staples
+  LatticeColorMatrix u;
+  gaussian(u);
+  reunit(u);
+
+  LatticeColorMatrix g, w;
+  w = zero;
+  for(int k=0; k < 2*(Nd-1); ++k)
+  {
+    gaussian(g);
+    reunit(g);
+    w += g;
+  }
+
+  // Overrelaxation
+  {
+    LatticeColorMatrix u_site = u;
+    LatticeColorMatrix u_ref  = u;
+
+    SiteHeatbath::overrelax(u_site, w, rb[0]);
+    for(int su2_index=0; su2_index < Nc*(Nc-1)/2; ++su2_index)
+      su3over(u_ref, w, su2_index, rb[0]);
+
+    Double diff = sqrt(norm2(u_site - u_ref) / norm2(u_ref));
+    QDPIO::cout << "overrelax: relative difference = " << diff << std::endl;
+    if (toDouble(diff) > 1.0e-5)
+      ++fail;
+
+    Double action = sqrt(norm2(real(trace(u_site*w)) - real(trace(u*w)), rb[0])
+			 / norm2(real(trace(u*w)), rb[0]));
+    QDPIO::cout << "overrelax: relative change of Re tr(UW) = " << action << std::endl;
+    if (toDouble(action) > 1.0e-5)
+      ++fail;
+  }
+
+  // Heatbath, one staple on every site
+  {
+    multi1d<int> origin(Nd);
+    origin = 0;
+    ColorMatrix w0 = peekSite(w, origin);
+
+    LatticeColorMatrix w_small, w_large;
+    w_small = Real(0.3) * w0;
+    w_large = Real(3) * w0;
+
+    QDPIO::cout << "heatbath:" << std::endl;
+    fail += checkHeatbath(u, w_small, "small weight");
+    fail += checkHeatbath(u, w_large, "large weight");
+  }
+
+  if (fail > 0)
+  {
+    QDPIO::cerr << "t_site_hb: " << fail << " checks differ from the lattice wide updates" << std::endl;
+    QDP_abort(1);
+  }
+
+  QDPIO::cout << "t_site_hb: all updates agree" << std::endl;
+#endif
+
+  Chroma::finalize();
+  exit(0);
+}
@@ -3,7 +3,9 @@
 
 
 #include <dslash_config.h>
-#if (DSLASH_USE_SSE2 || DSLASH_USE_SSE3)
+#if defined(DSLASH_MATVEC_AVX)
+#include "cpp_clover_site_apply_32bit_avx.h"
+#elif (DSLASH_USE_SSE2 || DSLASH_USE_SSE3)
 // No single prec SSE yet.
 #include "cpp_clover_site_apply_32bit_sse.h"
 #else
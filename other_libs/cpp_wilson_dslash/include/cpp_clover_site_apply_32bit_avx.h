@@ -0,0 +1,112 @@
+#ifndef CPP_CLOVER_SITE_APPLY_32_BIT_AVX_H
+#define CPP_CLOVER_SITE_APPLY_32_BIT_AVX_H
+
+/* AVX2+FMA version of cpp_clover_site_apply_32bit_c.h. It is used in
+ * place of that one (and of the SSE one) when DSLASH_MATVEC_AVX is
+ * defined, which only the translation units built with -mavx2 -mfma
+ * do (see lib/isa_variant.h) */
+
+#include <cpp_clover_types.h>
+#include <cpp_dslash_types.h>
+#include <immintrin.h>
+
+namespace CPlusPlusClover {
+
+  // Use 32bit types
+  using namespace Clover32BitTypes;
+  using namespace CPlusPlusWilsonDslash::Dslash32BitTypes;
+
+  namespace CPlusPlusClover32Bit {
+
+    namespace CloverApply32BitAVX {
+
+      // Each block of the clover term is a hermitian 6x6 matrix A.
+      // Only the diagonal and the lower triangle are stored, with
+      // A(i,j) = off_diag[ i*(i-1)/2 + j ] for i > j. elem() gives
+      // A(I,J) as [ re, im, 0, 0 ]; the branches go away at compile time
+      template<int I, int J>
+      inline
+      __m128 elem(const CloverStruct& c)
+      {
+	if( I == J ) {
+	  return _mm_load_ss(&c.diag[I]);
+	}
+	if( I > J ) {
+	  return _mm_castpd_ps(_mm_load_sd((const double *)c.off_diag[I*(I-1)/2+J]));
+	}
+	return _mm_xor_ps(_mm_castpd_ps(_mm_load_sd((const double *)c.off_diag[J*(J-1)/2+I])),
+			  _mm_set_ps(0.0f, 0.0f, -0.0f, 0.0f));
+      }
+
+      // A(I,J) and A(I,J+1) in one register
+      template<int I, int J>
+      inline
+      __m128 elemPair(const CloverStruct& c)
+      {
+	return _mm_movelh_ps(elem<I,J>(c), elem<I,J+1>(c));
+      }
+
+      // Row I of A times v, where v holds complex numbers 0-3 and v45
+      // numbers 4 and 5. The lanes of t hold the A.re*v.re and
+      // A.im*v.im terms, those of w the A.re*v.im and A.im*v.re ones
+      template<int I>
+      inline
+      void row(const CloverStruct& c, __m256 v, __m256 vs, __m128 v45, __m128 vs45,
+	       __m128& t, __m128& w)
+      {
+	__m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(elemPair<I,0>(c)), elemPair<I,2>(c), 1);
+	__m256 t4 = _mm256_mul_ps(a, v);
+	__m256 w4 = _mm256_mul_ps(a, vs);
+
+	__m128 a45 = elemPair<I,4>(c);
+	t = _mm_fmadd_ps(a45, v45,  _mm_add_ps(_mm256_castps256_ps128(t4), _mm256_extractf128_ps(t4, 1)));
+	w = _mm_fmadd_ps(a45, vs45, _mm_add_ps(_mm256_castps256_ps128(w4), _mm256_extractf128_ps(w4, 1)));
+      }
+
+      // Rows I and I+1 of A times v, summed across the lanes and
+      // stored to res[0..3]
+      template<int I>
+      inline
+      void rowPair(float* res, const CloverStruct& c, __m256 v, __m256 vs, __m128 v45, __m128 vs45)
+      {
+	__m128 t0, w0, t1, w1;
+	row<I>(c, v, vs, v45, vs45, t0, w0);
+	row<I+1>(c, v, vs, v45, vs45, t1, w1);
+
+	// [ re_I, re_I+1, im_I, im_I+1 ]
+	__m128 r = _mm_hadd_ps(_mm_hsub_ps(t0, t1), _mm_hadd_ps(w0, w1));
+	_mm_storeu_ps(res, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3,1,2,0)));
+      }
+
+      // res = A src for the 6 complex numbers of one block. The source
+      // is read completely before anything is stored
+      inline
+      void blockApply(float* res, const CloverStruct& c, const float* src)
+      {
+	__m256 v = _mm256_loadu_ps(src);
+	__m256 vs = _mm256_permute_ps(v, 0xb1);
+	__m128 v45 = _mm_loadu_ps(src + 8);
+	__m128 vs45 = _mm_permute_ps(v45, 0xb1);
+
+	rowPair<0>(res,   c, v, vs, v45, vs45);
+	rowPair<2>(res+4, c, v, vs, v45, vs45);
+	rowPair<4>(res+8, c, v, vs, v45, vs45);
+      }
+
+    }
+
+    // Spins 0,1 go through clov[0] and spins 2,3 through clov[1]
+    inline
+    void cloverSiteApply(FourSpinor result, const CloverTerm clov, const FourSpinor src)
+    {
+      using namespace CloverApply32BitAVX;
+
+      blockApply(result[0][0], clov[0], src[0][0]);
+      blockApply(result[2][0], clov[1], src[2][0]);
+    }
+
+  }
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef CPP_CLOVER_SITE_APPLY_64_BIT_AVX_H
+#define CPP_CLOVER_SITE_APPLY_64_BIT_AVX_H
+
+/* AVX2+FMA version of cpp_clover_site_apply_64bit_c.h. It is used in
+ * place of that one (and of the SSE one) when DSLASH_MATVEC_AVX is
+ * defined, which only the translation units built with -mavx2 -mfma
+ * do (see lib/isa_variant.h) */
+
+#include <cpp_clover_types.h>
+#include <cpp_dslash_types.h>
+#include <immintrin.h>
+
+namespace CPlusPlusClover {
+
+  // Use 64bit types
+  using namespace Clover64BitTypes;
+  using namespace CPlusPlusWilsonDslash::Dslash64BitTypes;
+
+  namespace CPlusPlusClover64Bit {
+
+    namespace CloverApply64BitAVX {
+
+      // Each block of the clover term is a hermitian 6x6 matrix A.
+      // Only the diagonal and the lower triangle are stored, with
+      // A(i,j) = off_diag[ i*(i-1)/2 + j ] for i > j. elem() gives
+      // A(I,J) as [ re, im ]; the branches go away at compile time
+      template<int I, int J>
+      inline
+      __m128d elem(const CloverStruct& c)
+      {
+	if( I == J ) {
+	  return _mm_load_sd(&c.diag[I]);
+	}
+	if( I > J ) {
+	  return _mm_loadu_pd(c.off_diag[I*(I-1)/2+J]);
+	}
+	return _mm_xor_pd(_mm_loadu_pd(c.off_diag[J*(J-1)/2+I]), _mm_set_pd(-0.0, 0.0));
+      }
+
+      // A(I,J) and A(I,J+1) in one register
+      template<int I, int J>
+      inline
+      __m256d elemPair(const CloverStruct& c)
+      {
+	return _mm256_insertf128_pd(_mm256_castpd128_pd256(elem<I,J>(c)), elem<I,J+1>(c), 1);
+      }
+
+      // Row I of A times v. The lanes of t hold the A.re*v.re and
+      // A.im*v.im terms, those of w the A.re*v.im and A.im*v.re ones
+      template<int I>
+      inline
+      void row(const CloverStruct& c, const __m256d v[3], const __m256d vs[3],
+	       __m256d& t, __m256d& w)
+      {
+	__m256d a = elemPair<I,0>(c);
+	t = _mm256_mul_pd(a, v[0]);
+	w = _mm256_mul_pd(a, vs[0]);
+
+	a = elemPair<I,2>(c);
+	t = _mm256_fmadd_pd(a, v[1], t);
+	w = _mm256_fmadd_pd(a, vs[1], w);
+
+	a = elemPair<I,4>(c);
+	t = _mm256_fmadd_pd(a, v[2], t);
+	w = _mm256_fmadd_pd(a, vs[2], w);
+      }
+
+      // Rows I and I+1 of A times v, summed across the lanes and
+      // stored to res[0..3]
+      template<int I>
+      inline
+      void rowPair(double* res, const CloverStruct& c, const __m256d v[3], const __m256d vs[3])
+      {
+	__m256d t0, w0, t1, w1;
+	row<I>(c, v, vs, t0, w0);
+	row<I+1>(c, v, vs, t1, w1);
+
+	// [ re_I, re_I+1, re_I, re_I+1 ] and the same for im, in halves
+	__m256d re = _mm256_hsub_pd(t0, t1);
+	__m256d im = _mm256_hadd_pd(w0, w1);
+
+	__m256d r0 = _mm256_unpacklo_pd(re, im);
+	__m256d r1 = _mm256_unpackhi_pd(re, im);
+	_mm_storeu_pd(res,   _mm_add_pd(_mm256_castpd256_pd128(r0), _mm256_extractf128_pd(r0, 1)));
+	_mm_storeu_pd(res+2, _mm_add_pd(_mm256_castpd256_pd128(r1), _mm256_extractf128_pd(r1, 1)));
+      }
+
+      // res = A src for the 6 complex numbers of one block. The source
+      // is read completely before anything is stored
+      inline
+      void blockApply(double* res, const CloverStruct& c, const double* src)
+      {
+	__m256d v[3], vs[3];
+	for(int k=0; k < 3; k++) {
+	  v[k] = _mm256_loadu_pd(src + 4*k);
+	  vs[k] = _mm256_permute_pd(v[k], 0x5);
+	}
+
+	rowPair<0>(res,   c, v, vs);
+	rowPair<2>(res+4, c, v, vs);
+	rowPair<4>(res+8, c, v, vs);
+      }
+
+    }
+
+    // Spins 0,1 go through clov[0] and spins 2,3 through clov[1]
+    inline
+    void cloverSiteApply(FourSpinor result, const CloverTerm clov, const FourSpinor src)
+    {
+      using namespace CloverApply64BitAVX;
+
+      blockApply(result[0][0], clov[0], src[0][0]);
+      blockApply(result[2][0], clov[1], src[2][0]);
+    }
+
+  }
+
+}
+
+#endif
@@ -127,7 +127,7 @@ namespace CPlusPlusClover {
       CMADD(result[1][2],    clov[0].off_diag[11], src[0][1]);
       CMADD(result[1][2],    clov[0].off_diag[12], src[0][2]);
       CMADD(result[1][2],    clov[0].off_diag[13], src[1][0]);
-      CONJMADD(result[1][2], clov[0].off_diag[14], src[1][1]);
+      CMADD(result[1][2],    clov[0].off_diag[14], src[1][1]);
     
  
       // result[2][0] =clov[1].diag[ 0]  * src[2][0]
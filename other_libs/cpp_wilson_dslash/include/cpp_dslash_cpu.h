@@ -0,0 +1,43 @@
+#ifndef CPP_DSLASH_CPU_H
+#define CPP_DSLASH_CPU_H
+
+#include <cstdlib>         /* for size_t */
+
+namespace CPlusPlusWilsonDslash {
+
+  /* Site worker signature, as passed to dispatchToThreads */
+  typedef void (*SiteFunc)(size_t, size_t, int, const void *);
+
+  /* Instruction sets the site kernels are built for.
+   *
+   * With --enable-avx the site loops of every Dslash and Dslash3D, and
+   * of the scalar clover operators, are compiled a second time for
+   * AVX2+FMA, with intrinsic SU(3) and clover matvecs, and the variant
+   * is picked at run time from CPUID. The environment variable
+   * CPP_DSLASH_ISA=generic|avx2 can lower (never raise) the choice,
+   * e.g. to compare variants.
+   *
+   * There is no AVX-512 variant. The kernels work on one site at a
+   * time, and the 12 and 24 number half and four spinors do not fill
+   * 512 bit registers; that would need several sites per register,
+   * i.e. a different spinor and gauge layout.
+   */
+  enum SiteISA {
+    SITE_ISA_GENERIC = 0,
+    SITE_ISA_AVX2
+  };
+
+  /* Best ISA that both this build and this CPU support */
+  SiteISA maxSiteISA(void);
+
+  /* ISA currently used by the site kernels */
+  SiteISA getSiteISA(void);
+
+  /* Select an ISA. Anything beyond maxSiteISA() is clamped to it */
+  void setSiteISA(SiteISA isa);
+
+  const char* siteISAName(SiteISA isa);
+
+}; // namespace
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef CPP_DSLASH_MATVEC_32BIT_AVX_H
+#define CPP_DSLASH_MATVEC_32BIT_AVX_H
+
+/* AVX2+FMA versions of the functions in cpp_dslash_matvec32bit_c.h.
+ * The C site kernels include this instead of that one when
+ * DSLASH_MATVEC_AVX is defined, which only the translation units built
+ * with -mavx2 -mfma do (see lib/isa_variant.h) */
+
+#include <cpp_dslash_types.h>
+#include <immintrin.h>
+
+namespace CPlusPlusWilsonDslash {
+
+    using namespace Dslash32BitTypes;
+
+    // Gauge Matrix is 3x3x2 (Natural ordering)
+    // HalfSpinor is 3x2x2 (color, spin, reim), so one colour of both
+    // spins is a single 128 bit vector [ s0.re, s0.im, s1.re, s1.im ]
+    //
+    // res[row][s] = sum_col u[col][row] * src[col][s]
+    inline 
+    void su3_mult(HalfSpinor res, const GaugeMatrix u, const HalfSpinor src) 
+    {
+      __m128 v[3], vs[3];
+      for(int col=0; col < 3; col++) { 
+	v[col] = _mm_loadu_ps(&src[col][0][0]);
+	vs[col] = _mm_permute_ps(v[col], 0xB1);
+      }
+
+      for(int row=0; row < 3; row++) { 
+	__m128 t = _mm_mul_ps(_mm_broadcast_ss(&u[0][row][0]), v[0]);
+	__m128 w = _mm_mul_ps(_mm_broadcast_ss(&u[0][row][1]), vs[0]);
+	for(int col=1; col < 3; col++) { 
+	  t = _mm_fmadd_ps(_mm_broadcast_ss(&u[col][row][0]), v[col], t);
+	  w = _mm_fmadd_ps(_mm_broadcast_ss(&u[col][row][1]), vs[col], w);
+	}
+	_mm_storeu_ps(&res[row][0][0], _mm_addsub_ps(t, w));
+      }
+    }
+
+    // res[row][s] = sum_col conj(u[row][col]) * src[col][s]
+    inline 
+    void su3_adj_mult(HalfSpinor res, GaugeMatrix u, HalfSpinor src)
+    {
+      __m128 v[3], vs[3];
+      for(int col=0; col < 3; col++) { 
+	v[col] = _mm_loadu_ps(&src[col][0][0]);
+	vs[col] = _mm_permute_ps(v[col], 0xB1);
+      }
+
+      for(int row=0; row < 3; row++) { 
+	__m128 t = _mm_mul_ps(_mm_broadcast_ss(&u[row][0][0]), v[0]);
+	__m128 w = _mm_mul_ps(_mm_broadcast_ss(&u[row][0][1]), vs[0]);
+	for(int col=1; col < 3; col++) { 
+	  t = _mm_fmadd_ps(_mm_broadcast_ss(&u[row][col][0]), v[col], t);
+	  w = _mm_fmadd_ps(_mm_broadcast_ss(&u[row][col][1]), vs[col], w);
+	}
+	// conj(u): re = t0 + w0, im = t1 - w1
+	_mm_storeu_ps(&res[row][0][0], _mm_addsub_ps(t, _mm_sub_ps(_mm_setzero_ps(), w)));
+      }
+    }
+
+}
+
+#endif
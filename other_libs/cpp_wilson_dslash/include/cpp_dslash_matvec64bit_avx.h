@@ -0,0 +1,88 @@
+#ifndef CPP_DSLASH_MATVEC_64BIT_AVX_H
+#define CPP_DSLASH_MATVEC_64BIT_AVX_H
+
+/* AVX2+FMA versions of the functions in cpp_dslash_matvec64bit_c.h.
+ * The C site kernels include this instead of that one when
+ * DSLASH_MATVEC_AVX is defined, which only the translation units built
+ * with -mavx2 -mfma do (see lib/isa_variant.h) */
+
+#include <cpp_dslash_types.h>
+#include <immintrin.h>
+
+namespace CPlusPlusWilsonDslash {
+  using namespace Dslash64BitTypes;
+
+  namespace MatVec64BitAVX {
+
+    /* Colour component c of both spins: [ s0.re, s0.im, s1.re, s1.im ] */
+    inline
+    __m256d load_color(const HalfSpinor src, int c)
+    {
+      return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(src[0][c])),
+				  _mm_loadu_pd(src[1][c]), 1);
+    }
+
+    inline
+    void store_color(HalfSpinor res, int c, __m256d v)
+    {
+      _mm_storeu_pd(res[0][c], _mm256_castpd256_pd128(v));
+      _mm_storeu_pd(res[1][c], _mm256_extractf128_pd(v, 1));
+    }
+
+  }
+
+    // Gauge Matrix is 3x3x2 (Natural ordering)
+    // HalfSpinor is 2x3x2 (spin, color, reim)
+    //
+    // res[s][row] = sum_col u[col][row] * src[s][col]
+    // Both spins go through one register, the real and imaginary parts
+    // of u are accumulated separately and combined with one addsub
+    inline 
+    void su3_mult(HalfSpinor res, const GaugeMatrix u, const HalfSpinor src) 
+    {
+      using namespace MatVec64BitAVX;
+
+      __m256d v[3], vs[3];
+      for(int col=0; col < 3; col++) { 
+	v[col] = load_color(src, col);
+	vs[col] = _mm256_permute_pd(v[col], 0x5);
+      }
+
+      for(int row=0; row < 3; row++) { 
+	__m256d t = _mm256_mul_pd(_mm256_broadcast_sd(&u[0][row][0]), v[0]);
+	__m256d w = _mm256_mul_pd(_mm256_broadcast_sd(&u[0][row][1]), vs[0]);
+	for(int col=1; col < 3; col++) { 
+	  t = _mm256_fmadd_pd(_mm256_broadcast_sd(&u[col][row][0]), v[col], t);
+	  w = _mm256_fmadd_pd(_mm256_broadcast_sd(&u[col][row][1]), vs[col], w);
+	}
+	store_color(res, row, _mm256_addsub_pd(t, w));
+      }
+    }
+
+    // res[s][row] = sum_col conj(u[row][col]) * src[s][col]
+    inline 
+    void su3_adj_mult(HalfSpinor res, GaugeMatrix u, HalfSpinor src)
+    {
+      using namespace MatVec64BitAVX;
+
+      __m256d v[3], vs[3];
+      for(int col=0; col < 3; col++) { 
+	v[col] = load_color(src, col);
+	vs[col] = _mm256_permute_pd(v[col], 0x5);
+      }
+
+      for(int row=0; row < 3; row++) { 
+	__m256d t = _mm256_mul_pd(_mm256_broadcast_sd(&u[row][0][0]), v[0]);
+	__m256d w = _mm256_mul_pd(_mm256_broadcast_sd(&u[row][0][1]), vs[0]);
+	for(int col=1; col < 3; col++) { 
+	  t = _mm256_fmadd_pd(_mm256_broadcast_sd(&u[row][col][0]), v[col], t);
+	  w = _mm256_fmadd_pd(_mm256_broadcast_sd(&u[row][col][1]), vs[col], w);
+	}
+	// conj(u): re = t0 + w0, im = t1 - w1
+	store_color(res, row, _mm256_addsub_pd(t, _mm256_sub_pd(_mm256_setzero_pd(), w)));
+      }
+    }
+
+}
+
+#endif
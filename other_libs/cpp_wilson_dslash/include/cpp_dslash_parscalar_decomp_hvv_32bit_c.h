@@ -4,7 +4,11 @@
 #include <cpp_dslash_types.h>
 using namespace CPlusPlusWilsonDslash::Dslash32BitTypes;
 
+#ifdef DSLASH_MATVEC_AVX
+#include <cpp_dslash_matvec32bit_avx.h>
+#else
 #include <cpp_dslash_matvec32bit_c.h>
+#endif
 namespace CPlusPlusWilsonDslash { 
 
   namespace  DslashParscalar32Bit { 
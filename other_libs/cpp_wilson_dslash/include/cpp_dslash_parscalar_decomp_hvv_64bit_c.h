@@ -3,7 +3,11 @@
 
 
 #include <cpp_dslash_types.h>
+#ifdef DSLASH_MATVEC_AVX
+#include <cpp_dslash_matvec64bit_avx.h>
+#else
 #include <cpp_dslash_matvec64bit_c.h>
+#endif
 
 using namespace CPlusPlusWilsonDslash::Dslash64BitTypes;
 
@@ -21,6 +21,18 @@ namespace CPlusPlusWilsonDslash {
 
   void qdp_pack_gauge_3d(const multi1d<LatticeColorMatrixD>&_u, multi1d<PrimitiveSU3MatrixD>& u_tmp);
 
+  /* Interleave nrhs = psi.size() fermions site by site for the multi
+   * right hand side dslash: psi_tmp[site*nrhs + n] = psi[n] at site.
+   * Only the scalar build has that dslash */
+  void qdp_pack_spinors(const multi1d<LatticeFermionF>& psi, PrimitiveSpinorF* psi_tmp);
+
+  void qdp_pack_spinors(const multi1d<LatticeFermionD>& psi, PrimitiveSpinorD* psi_tmp);
+
+  /* The inverse of qdp_pack_spinors, psi must already have nrhs elements */
+  void qdp_unpack_spinors(const PrimitiveSpinorF* psi_tmp, multi1d<LatticeFermionF>& psi);
+
+  void qdp_unpack_spinors(const PrimitiveSpinorD* psi_tmp, multi1d<LatticeFermionD>& psi);
+
 };
 
 #endif
@@ -52,6 +52,16 @@ namespace CPlusPlusWilsonDslash {
 		    int isign,
 		    int cb);
 
+    /* Apply the operator to nrhs spinors interleaved site by site,
+     * psi[site*nrhs + n]. The links of a site are loaded once for
+     * all the right hand sides */
+    void operator()(float* res, 
+		    float* psi, 
+		    float* u, 
+		    int isign,
+		    int cb,
+		    int nrhs);
+
     //   int getPathSite(int site) const;
 
   private:
@@ -93,6 +103,16 @@ namespace CPlusPlusWilsonDslash {
 		    int isign,
 		    int cb);
 
+    /* Apply the operator to nrhs spinors interleaved site by site,
+     * psi[site*nrhs + n]. The links of a site are loaded once for
+     * all the right hand sides */
+    void operator()(double* res, 
+		    double* psi, 
+		    double* u, 
+		    int isign,
+		    int cb,
+		    int nrhs);
+
 
     //   int getPathSite(int site) const;
 
@@ -9,7 +9,11 @@
 #endif
 
 #include <cpp_dslash_types.h>
+#ifdef DSLASH_MATVEC_AVX
+#include <cpp_dslash_matvec32bit_avx.h>
+#else
 #include <cpp_dslash_matvec32bit_c.h>
+#endif
 
 namespace CPlusPlusWilsonDslash {
 
@@ -8,4 +8,16 @@
 #include "cpp_dslash_scalar_64bit_c.h"
 #endif
 
+#include <cstddef>
+
+namespace CPlusPlusWilsonDslash {
+  namespace DslashScalar64Bit {
+
+    /* Thread dispatch functions for D and D^\dagger on nrhs interleaved spinors */
+    void DPsiPlusMulti(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiMinusMulti(size_t lo, size_t hi, int id, const void *ptr);
+
+  }
+}
+
 #endif
@@ -8,7 +8,11 @@
 #include <cpp_dslash_types.h>
 #warning "Using C stuff for 64 bit"
 
+#ifdef DSLASH_MATVEC_AVX
+#include <cpp_dslash_matvec64bit_avx.h>
+#else
 #include "cpp_dslash_matvec64bit_c.h"
+#endif
 
 namespace CPlusPlusWilsonDslash {
 
@@ -0,0 +1,65 @@
+#ifndef DISPATCH_POOL_H
+#define DISPATCH_POOL_H
+
+#include <cstdlib>         /* for size_t */
+
+namespace CPlusPlusWilsonDslash {
+
+  /* Site worker: processes sites [lo,hi) as thread id with args */
+  typedef void (*DispatchFunc)(size_t, size_t, int, const void *);
+
+  /* How the OpenMP dispatchers share out sites
+   *
+   *  DISPATCH_STATIC: a new parallel region per call, with n_sites split
+   *                   into equal contiguous chunks (the original scheme)
+   *  DISPATCH_POOL:   a persistent pool of pinned threads. Each thread
+   *                   starts on its own contiguous range, in chunks, and
+   *                   steals chunks from its nearest neighbours when done,
+   *                   those on its own NUMA node first
+   *
+   * The default is taken from the environment variable
+   * CPP_DSLASH_SCHEDULER=static|pool and is static if unset.
+   *
+   * The caller is pool thread 0. When the OpenMP runtime binds its
+   * threads, pool thread t runs on the CPUs of OpenMP thread t, so the
+   * two never compete for a core and each pool thread starts on the
+   * sites its OpenMP counterpart touched first. Otherwise the threads,
+   * the caller included, are pinned one per CPU of the process mask in
+   * order of NUMA node when the pool is created. The node map is read
+   * from /sys/devices/system/node. CPP_DSLASH_PIN_THREADS=0 turns the
+   * pinning off. Idle pool threads spin for a few microseconds and then
+   * sleep until the next call.
+   */
+  enum DispatchScheduler {
+    DISPATCH_STATIC = 0,
+    DISPATCH_POOL
+  };
+
+  void setDispatchScheduler(DispatchScheduler s);
+  DispatchScheduler getDispatchScheduler(void);
+
+  /* Number of threads the pool runs (including the caller).
+   * From CPP_DSLASH_NUM_THREADS, else omp_get_max_threads() */
+  int dispatchPoolNumThreads(void);
+
+  /* Run func over n_sites with the static OpenMP split */
+  void dispatchStatic(DispatchFunc func, const void* args, int n_sites);
+
+  /* Run func over n_sites on the work stealing pool */
+  void dispatchPool(DispatchFunc func, const void* args, int n_sites);
+
+  /* Run func over n_sites with the current scheduler */
+  inline
+  void dispatchSites(DispatchFunc func, const void* args, int n_sites)
+  {
+    if( getDispatchScheduler() == DISPATCH_POOL ) {
+      dispatchPool(func, args, n_sites);
+    }
+    else {
+      dispatchStatic(func, args, n_sites);
+    }
+  }
+
+}; // namespace
+
+#endif
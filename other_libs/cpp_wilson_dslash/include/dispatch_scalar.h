@@ -16,7 +16,7 @@ namespace CPlusPlusWilsonDslash {
     void *u;             /*!< Gauge field - suitably packed */
     void *s;             /* Shift table */
     int cb;              /*!< Checkerboard (source) */
-
+    int nrhs;            /*!< Number of interleaved right hand sides */
   };
 
   /* Functions: Thread Dispatch */
@@ -28,6 +28,16 @@ namespace CPlusPlusWilsonDslash {
 			 int cb,
 			 int n_sites);
 
+  /* Thread dispatch of a site loop over nrhs interleaved spinors */
+  void dispatchToThreads(void (*func)(size_t, size_t, int, const void *),
+			 void* source,
+			 void* result, 
+			 void* u,
+			 void* s,
+			 int cb,
+			 int nrhs,
+			 int n_sites);
+
 }; // namespace
 
 namespace CPlusPlusClover { 
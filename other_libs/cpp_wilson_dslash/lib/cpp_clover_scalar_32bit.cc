@@ -13,7 +13,22 @@ using namespace CPlusPlusWilsonDslash::DslashScalar32Bit;
 using namespace CPlusPlusWilsonDslash::Dslash32BitTypes;
 using namespace CPlusPlusWilsonDslash::Cache;
 
+#ifndef CPP_CLOVER_SITE_KERNELS_ONLY
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_clover_scalar_32bit_avx2.cc */
+namespace CPlusPlusCloverAVX2 {
+  namespace CloverScalar32Bit {
+    void DClovPsiPlus(size_t lo, size_t hi, int id, const void *ptr);
+    void DClovPsiMinus(size_t lo, size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+#endif
+
 namespace CPlusPlusClover {
+#ifndef CPP_CLOVER_SITE_KERNELS_ONLY
  
 
   /* Constructor */
@@ -56,6 +71,21 @@ namespace CPlusPlusClover {
 
   using namespace CloverScalar32Bit;
 
+  /* Site loop for isign on the ISA chosen at run time */
+  static CPlusPlusWilsonDslash::SiteFunc cloverKernel(int isign)
+  {
+#ifdef DSLASH_USE_AVX
+    switch( CPlusPlusWilsonDslash::getSiteISA() ) {
+    case CPlusPlusWilsonDslash::SITE_ISA_AVX2:
+      return ( isign == 1 ) ? &CPlusPlusCloverAVX2::CloverScalar32Bit::DClovPsiPlus : &CPlusPlusCloverAVX2::CloverScalar32Bit::DClovPsiMinus;
+    default:
+      break;
+    }
+#endif
+    return ( isign == 1 ) ? &DClovPsiPlus : &DClovPsiMinus;
+  }
+
+
   // The operator 
   void CloverSchur4D<float>::operator() (float* res, 
 					 const float* psi, 
@@ -69,7 +99,7 @@ namespace CPlusPlusClover {
     if (isign == 1) {
       
 
-      CPlusPlusClover::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DClovPsiPlus, 
+      CPlusPlusClover::dispatchToThreads(cloverKernel(1), 
 					       (void*)psi,
 					       (void*)res,
 					       (void *)u,
@@ -84,7 +114,7 @@ namespace CPlusPlusClover {
 
     if( isign == -1) {
 
-      CPlusPlusClover::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DClovPsiMinus, 
+      CPlusPlusClover::dispatchToThreads(cloverKernel(-1), 
 					       (void *)psi,
 					       (void *)res,
 					       (void *)u,
@@ -97,6 +127,8 @@ namespace CPlusPlusClover {
     }
   }
 
+#endif // CPP_CLOVER_SITE_KERNELS_ONLY
+
   using namespace DslashScalar32Bit;
   using namespace CPlusPlusClover32Bit;
   namespace CloverScalar32Bit {
@@ -0,0 +1,10 @@
+/* AVX2+FMA build of the scalar 32 bit clover site loops.
+ * Same source as cpp_clover_scalar_32bit.cc, with the C dslash site kernels,
+ * the intrinsic matvec of cpp_dslash_matvec32bit_avx.h and the intrinsic
+ * clover apply of cpp_clover_site_apply_32bit_avx.h */
+#define CPlusPlusWilsonDslash CPlusPlusWilsonDslashAVX2
+#define CPlusPlusClover CPlusPlusCloverAVX2
+#define CPP_CLOVER_SITE_KERNELS_ONLY
+#include "isa_variant.h"
+
+#include "cpp_clover_scalar_32bit.cc"
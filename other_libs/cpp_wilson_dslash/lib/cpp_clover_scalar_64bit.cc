@@ -13,7 +13,22 @@ using namespace CPlusPlusWilsonDslash::DslashScalar64Bit;
 using namespace CPlusPlusWilsonDslash::Dslash64BitTypes;
 using namespace CPlusPlusClover::Clover64BitTypes;
 
+#ifndef CPP_CLOVER_SITE_KERNELS_ONLY
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_clover_scalar_64bit_avx2.cc */
+namespace CPlusPlusCloverAVX2 {
+  namespace CloverScalar64Bit {
+    void ClovDPsiPlus(size_t lo, size_t hi, int id, const void *ptr);
+    void ClovDPsiMinus(size_t lo, size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+#endif
+
 namespace CPlusPlusClover {
+#ifndef CPP_CLOVER_SITE_KERNELS_ONLY
  
 
   /* Constructor */
@@ -61,6 +76,21 @@ namespace CPlusPlusClover {
   }
 
   using  namespace CloverScalar64Bit;
+
+  /* Site loop for isign on the ISA chosen at run time */
+  static CPlusPlusWilsonDslash::SiteFunc cloverKernel(int isign)
+  {
+#ifdef DSLASH_USE_AVX
+    switch( CPlusPlusWilsonDslash::getSiteISA() ) {
+    case CPlusPlusWilsonDslash::SITE_ISA_AVX2:
+      return ( isign == 1 ) ? &CPlusPlusCloverAVX2::CloverScalar64Bit::ClovDPsiPlus : &CPlusPlusCloverAVX2::CloverScalar64Bit::ClovDPsiMinus;
+    default:
+      break;
+    }
+#endif
+    return ( isign == 1 ) ? &ClovDPsiPlus : &ClovDPsiMinus;
+  }
+
   // The operator 
   void CloverSchur4D<double>::operator() (double* res, 
 					  const double* psi, 
@@ -73,7 +103,7 @@ namespace CPlusPlusClover {
   {
     if (isign == 1) {  
 
-      CPlusPlusClover::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&ClovDPsiPlus, 
+      CPlusPlusClover::dispatchToThreads(cloverKernel(1), 
 					 (void*)psi,
 					 (void*)res,
 					 (void *)u,
@@ -88,7 +118,7 @@ namespace CPlusPlusClover {
 
     if( isign == -1) {
 
-      CPlusPlusClover::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&ClovDPsiMinus, 
+      CPlusPlusClover::dispatchToThreads(cloverKernel(-1), 
 					 (void *)psi,
 					 (void *)res,
 					 (void *)u,
@@ -101,6 +131,8 @@ namespace CPlusPlusClover {
     }    
   }
 
+#endif // CPP_CLOVER_SITE_KERNELS_ONLY
+
   using namespace DslashScalar64Bit;
   using namespace CPlusPlusClover64Bit;
   namespace CloverScalar64Bit {
@@ -0,0 +1,10 @@
+/* AVX2+FMA build of the scalar 64 bit clover site loops.
+ * Same source as cpp_clover_scalar_64bit.cc, with the C dslash site kernels,
+ * the intrinsic matvec of cpp_dslash_matvec64bit_avx.h and the intrinsic
+ * clover apply of cpp_clover_site_apply_64bit_avx.h */
+#define CPlusPlusWilsonDslash CPlusPlusWilsonDslashAVX2
+#define CPlusPlusClover CPlusPlusCloverAVX2
+#define CPP_CLOVER_SITE_KERNELS_ONLY
+#include "isa_variant.h"
+
+#include "cpp_clover_scalar_64bit.cc"
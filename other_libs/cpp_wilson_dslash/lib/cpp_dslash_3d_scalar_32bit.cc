@@ -6,7 +6,49 @@
 using namespace CPlusPlusWilsonDslash::DslashScalar32Bit;
 using namespace CPlusPlusWilsonDslash::Dslash32BitTypes;
 
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_dslash_3d_scalar_32bit_avx2.cc */
+namespace CPlusPlusWilsonDslashAVX2 {
+  namespace DslashScalar32Bit {
+    void DPsiPlus3D(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiMinus3D(size_t lo, size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+#endif
+
 namespace CPlusPlusWilsonDslash {
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+
+  namespace DslashScalar32Bit {
+
+    /* The 3D site loops for one ISA */
+    struct SiteLoops3D {
+      SiteFunc plus, minus;
+    };
+
+#define SCALAR_32BIT_3D_SITE_LOOPS(NS) {					\
+    NS::DslashScalar32Bit::DPsiPlus3D,	\
+    NS::DslashScalar32Bit::DPsiMinus3D }
+
+    /* The 3D site loops for the ISA chosen at run time */
+    static const SiteLoops3D& siteLoops3D(void)
+    {
+      static const SiteLoops3D generic = SCALAR_32BIT_3D_SITE_LOOPS(::CPlusPlusWilsonDslash);
+#ifdef DSLASH_USE_AVX
+      static const SiteLoops3D avx2 = SCALAR_32BIT_3D_SITE_LOOPS(::CPlusPlusWilsonDslashAVX2);
+
+      if( getSiteISA() == SITE_ISA_AVX2 ) {
+	return avx2;
+      }
+#endif
+      return generic;
+    }
+
+  }
  
 
   /* Constructor */
@@ -32,9 +74,11 @@ namespace CPlusPlusWilsonDslash {
 				    int isign,
 				    int cb) 
   {
+    const DslashScalar32Bit::SiteLoops3D& loops = DslashScalar32Bit::siteLoops3D();
+
     if (isign == 1) {  
       
-      CPlusPlusWilsonDslash::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DPsiPlus3D, 
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.plus, 
 					       (void*)psi,
 					       (void*)res,
 					       (void *)u,
@@ -47,7 +91,7 @@ namespace CPlusPlusWilsonDslash {
 
     if( isign == -1) {
 
-      CPlusPlusWilsonDslash::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DPsiMinus3D, 
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.minus, 
 					       (void *)psi,
 					       (void *)res,
 					       (void *)u,
@@ -59,6 +103,8 @@ namespace CPlusPlusWilsonDslash {
   }
 
 
+#endif // CPP_DSLASH_SITE_KERNELS_ONLY
+
   namespace DslashScalar32Bit {
     
     void DPsiPlus3D(size_t lo, size_t hi, int id, const void *ptr)
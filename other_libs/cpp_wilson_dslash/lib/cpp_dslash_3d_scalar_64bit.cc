@@ -6,7 +6,49 @@
 using namespace CPlusPlusWilsonDslash::DslashScalar64Bit;
 using namespace CPlusPlusWilsonDslash::Dslash64BitTypes;
 
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_dslash_3d_scalar_64bit_avx2.cc */
+namespace CPlusPlusWilsonDslashAVX2 {
+  namespace DslashScalar64Bit {
+    void DPsiPlus3D(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiMinus3D(size_t lo, size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+#endif
+
 namespace CPlusPlusWilsonDslash {
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+
+  namespace DslashScalar64Bit {
+
+    /* The 3D site loops for one ISA */
+    struct SiteLoops3D {
+      SiteFunc plus, minus;
+    };
+
+#define SCALAR_64BIT_3D_SITE_LOOPS(NS) {					\
+    NS::DslashScalar64Bit::DPsiPlus3D,	\
+    NS::DslashScalar64Bit::DPsiMinus3D }
+
+    /* The 3D site loops for the ISA chosen at run time */
+    static const SiteLoops3D& siteLoops3D(void)
+    {
+      static const SiteLoops3D generic = SCALAR_64BIT_3D_SITE_LOOPS(::CPlusPlusWilsonDslash);
+#ifdef DSLASH_USE_AVX
+      static const SiteLoops3D avx2 = SCALAR_64BIT_3D_SITE_LOOPS(::CPlusPlusWilsonDslashAVX2);
+
+      if( getSiteISA() == SITE_ISA_AVX2 ) {
+	return avx2;
+      }
+#endif
+      return generic;
+    }
+
+  }
  
 
   /* Constructor */
@@ -32,9 +74,11 @@ namespace CPlusPlusWilsonDslash {
 				    int isign,
 				    int cb) 
   {
+    const DslashScalar64Bit::SiteLoops3D& loops = DslashScalar64Bit::siteLoops3D();
+
     if (isign == 1) {  
       
-      CPlusPlusWilsonDslash::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DPsiPlus3D, 
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.plus, 
 					       (void*)psi,
 					       (void*)res,
 					       (void *)u,
@@ -47,7 +91,7 @@ namespace CPlusPlusWilsonDslash {
 
     if( isign == -1) {
 
-      CPlusPlusWilsonDslash::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DPsiMinus3D, 
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.minus, 
 					       (void *)psi,
 					       (void *)res,
 					       (void *)u,
@@ -59,6 +103,8 @@ namespace CPlusPlusWilsonDslash {
   }
 
 
+#endif // CPP_DSLASH_SITE_KERNELS_ONLY
+
   namespace DslashScalar64Bit {
     
     void DPsiPlus3D(size_t lo, size_t hi, int id, const void *ptr)
@@ -0,0 +1,8 @@
+/* AVX2+FMA build of the scalar 64 bit 3D dslash site loops.
+ * Same source as cpp_dslash_3d_scalar_64bit.cc, with the C site kernels and the
+ * intrinsic matvec of cpp_dslash_matvec64bit_avx.h */
+#define CPlusPlusWilsonDslash CPlusPlusWilsonDslashAVX2
+#define CPP_DSLASH_SITE_KERNELS_ONLY
+#include "isa_variant.h"
+
+#include "cpp_dslash_3d_scalar_64bit.cc"
@@ -0,0 +1,67 @@
+#include <dslash_config.h>
+#include <cpp_dslash_cpu.h>
+
+#include <string>
+
+namespace CPlusPlusWilsonDslash {
+
+  namespace {
+
+    SiteISA cpuSiteISA(void)
+    {
+#if defined(DSLASH_USE_AVX) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+      __builtin_cpu_init();
+      if( __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ) {
+	return SITE_ISA_AVX2;
+      }
+#endif
+      return SITE_ISA_GENERIC;
+    }
+
+    SiteISA envSiteISA(void)
+    {
+      SiteISA isa = cpuSiteISA();
+      const char* e = std::getenv("CPP_DSLASH_ISA");
+      if( e != 0x0 ) {
+	std::string s(e);
+	SiteISA want = isa;
+	if( s == "generic" ) want = SITE_ISA_GENERIC;
+	if( s == "avx2" ) want = SITE_ISA_AVX2;
+	if( want < isa ) isa = want;
+      }
+      return isa;
+    }
+
+    SiteISA the_isa = envSiteISA();
+
+  } // anonymous namespace
+
+
+  SiteISA maxSiteISA(void)
+  {
+    static const SiteISA max_isa = cpuSiteISA();
+    return max_isa;
+  }
+
+  SiteISA getSiteISA(void)
+  {
+    return the_isa;
+  }
+
+  void setSiteISA(SiteISA isa)
+  {
+    the_isa = ( isa > maxSiteISA() ) ? maxSiteISA() : isa;
+  }
+
+  const char* siteISAName(SiteISA isa)
+  {
+    switch(isa) {
+    case SITE_ISA_AVX2:
+      return "avx2";
+    default:
+      break;
+    }
+    return "generic";
+  }
+
+}; // End Namespace
@@ -13,6 +13,60 @@ using namespace CPlusPlusWilsonDslash::Dslash32BitTypes;
 
 #define QMP_COMMS 
 
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_dslash_parscalar_utils_32bit_avx2.cc */
+namespace CPlusPlusWilsonDslashAVX2 {
+  namespace DslashParscalar32Bit {
+    void decomp_plus(size_t lo,size_t hi, int id, const void *ptr);
+    void decomp_hvv_plus(size_t lo,size_t hi, int id, const void *ptr);
+    void mvv_recons_plus(size_t lo,size_t hi, int id, const void *ptr);
+    void recons_plus(size_t lo,size_t hi, int id, const void *ptr);
+    void decomp_minus(size_t lo,size_t hi, int id, const void *ptr);
+    void decomp_hvv_minus(size_t lo,size_t hi, int id, const void *ptr);
+    void mvv_recons_minus(size_t lo,size_t hi, int id, const void *ptr);
+    void recons_minus(size_t lo,size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+
+namespace CPlusPlusWilsonDslash { 
+  namespace DslashParscalar32Bit {
+
+    /* The 4D site loops for one ISA */
+    struct SiteLoops {
+      SiteFunc decomp_plus, decomp_hvv_plus, mvv_recons_plus, recons_plus;
+      SiteFunc decomp_minus, decomp_hvv_minus, mvv_recons_minus, recons_minus;
+    };
+
+#define PARSCALAR_32BIT_SITE_LOOPS(NS) {					\
+    NS::DslashParscalar32Bit::decomp_plus,	\
+    NS::DslashParscalar32Bit::decomp_hvv_plus,	\
+    NS::DslashParscalar32Bit::mvv_recons_plus,	\
+    NS::DslashParscalar32Bit::recons_plus,	\
+    NS::DslashParscalar32Bit::decomp_minus,	\
+    NS::DslashParscalar32Bit::decomp_hvv_minus,	\
+    NS::DslashParscalar32Bit::mvv_recons_minus,	\
+    NS::DslashParscalar32Bit::recons_minus }
+
+    /* Site loops for the ISA chosen at run time */
+    static const SiteLoops& siteLoops(void)
+    {
+      static const SiteLoops generic = PARSCALAR_32BIT_SITE_LOOPS(::CPlusPlusWilsonDslash);
+#ifdef DSLASH_USE_AVX
+      static const SiteLoops avx2 = PARSCALAR_32BIT_SITE_LOOPS(::CPlusPlusWilsonDslashAVX2);
+
+      if( getSiteISA() == SITE_ISA_AVX2 ) {
+	return avx2;
+      }
+#endif
+      return generic;
+    }
+
+  }
+}
+
 namespace CPlusPlusWilsonDslash { 
 
 // Your actual operator
@@ -25,6 +79,7 @@ void Dslash<float>::operator()(float* res,
   HalfSpinor* chi1 = tab->getChi1();
   HalfSpinor* chi2 = tab->getChi2();
   int subgrid_vol_cb = s_tab->subgridVolCB();
+  const DslashParscalar32Bit::SiteLoops& loops = DslashParscalar32Bit::siteLoops();
 
 
   if(isign==1) {
@@ -34,7 +89,7 @@ void Dslash<float>::operator()(float* res,
 #endif
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar32Bit::decomp_plus,
+    dispatchToThreads(loops.decomp_plus,
 		      (void *)psi,
 		      (void *)chi1,
 		      (void *)u,
@@ -48,7 +103,7 @@ void Dslash<float>::operator()(float* res,
 #endif
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar32Bit::decomp_hvv_plus,
+    dispatchToThreads(loops.decomp_hvv_plus,
 		      (void*)psi,
 		      (void*)chi2,
 		      (void*)u,
@@ -65,7 +120,7 @@ void Dslash<float>::operator()(float* res,
 #endif   // NOCOMMS
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar32Bit::mvv_recons_plus,
+    dispatchToThreads(loops.mvv_recons_plus,
 		      (void*)res,
 		      (void *)chi1,
 		      (void *)u,
@@ -81,7 +136,7 @@ void Dslash<float>::operator()(float* res,
 
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar32Bit::recons_plus,
+    dispatchToThreads(loops.recons_plus,
 		      (void*)res, 
 		      (void*)chi2,
 		      (void*)u,	
@@ -102,7 +157,7 @@ void Dslash<float>::operator()(float* res,
 
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar32Bit::decomp_minus,
+    dispatchToThreads(loops.decomp_minus,
 		      (void*)psi,
 		      (void *)chi1,
 		      (void *)u,
@@ -116,7 +171,7 @@ void Dslash<float>::operator()(float* res,
 #endif
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar32Bit::decomp_hvv_minus,
+    dispatchToThreads(loops.decomp_hvv_minus,
 		      (void*)psi,
 		      (void*)chi2,
 		      (void*)u,
@@ -132,7 +187,7 @@ void Dslash<float>::operator()(float* res,
 #endif
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar32Bit::mvv_recons_minus,
+    dispatchToThreads(loops.mvv_recons_minus,
 		      (void*)res,
 		      (void *)chi1,
 		      (void *)u,
@@ -147,7 +202,7 @@ void Dslash<float>::operator()(float* res,
 #endif // #ifndef NOCOMMS
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar32Bit::recons_minus,
+    dispatchToThreads(loops.recons_minus,
 		      (void*)res, 
 		      (void *)chi2,
 		      (void *)u,	
@@ -18,6 +18,26 @@ using namespace CPlusPlusWilsonDslash::Dslash32BitTypes;
 
 #define QMP_COMMS 
 
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_dslash_parscalar_3d_32bit_avx2.cc */
+namespace CPlusPlusWilsonDslashAVX2 {
+  namespace DslashParscalar32Bit {
+    void decomp_plus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void decomp_hvv_plus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void mvv_recons_plus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void recons_plus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void decomp_minus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void decomp_hvv_minus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void mvv_recons_minus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void recons_minus_3d(size_t lo, size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+#endif
+
 namespace CPlusPlusWilsonDslash {
 
   namespace DslashParscalar32Bit {
@@ -482,6 +502,42 @@ namespace CPlusPlusWilsonDslash {
 
 
 
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+
+  namespace DslashParscalar32Bit {
+
+    /* The 3D site loops for one ISA */
+    struct SiteLoops3D {
+      SiteFunc decomp_plus, decomp_hvv_plus, mvv_recons_plus, recons_plus;
+      SiteFunc decomp_minus, decomp_hvv_minus, mvv_recons_minus, recons_minus;
+    };
+
+#define PARSCALAR_32BIT_3D_SITE_LOOPS(NS) {					\
+    NS::DslashParscalar32Bit::decomp_plus_3d,	\
+    NS::DslashParscalar32Bit::decomp_hvv_plus_3d,	\
+    NS::DslashParscalar32Bit::mvv_recons_plus_3d,	\
+    NS::DslashParscalar32Bit::recons_plus_3d,	\
+    NS::DslashParscalar32Bit::decomp_minus_3d,	\
+    NS::DslashParscalar32Bit::decomp_hvv_minus_3d,	\
+    NS::DslashParscalar32Bit::mvv_recons_minus_3d,	\
+    NS::DslashParscalar32Bit::recons_minus_3d }
+
+    /* The 3D site loops for the ISA chosen at run time */
+    static const SiteLoops3D& siteLoops3D(void)
+    {
+      static const SiteLoops3D generic = PARSCALAR_32BIT_3D_SITE_LOOPS(::CPlusPlusWilsonDslash);
+#ifdef DSLASH_USE_AVX
+      static const SiteLoops3D avx2 = PARSCALAR_32BIT_3D_SITE_LOOPS(::CPlusPlusWilsonDslashAVX2);
+
+      if( getSiteISA() == SITE_ISA_AVX2 ) {
+	return avx2;
+      }
+#endif
+      return generic;
+    }
+
+  }
+
   // Your actual operator
   void Dslash3D<float>::operator()(float* res, 
 				   float* psi, 
@@ -492,6 +548,7 @@ namespace CPlusPlusWilsonDslash {
     HalfSpinor* chi1 = tab->getChi1();
     HalfSpinor* chi2 = tab->getChi2();
     int subgrid_vol_cb = s_tab->subgridVolCB();
+    const DslashParscalar32Bit::SiteLoops3D& loops = DslashParscalar32Bit::siteLoops3D();
     
     
     if(isign==1) {
@@ -501,7 +558,7 @@ namespace CPlusPlusWilsonDslash {
 #endif
       
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-      dispatchToThreads(DslashParscalar32Bit::decomp_plus_3d,
+      dispatchToThreads(loops.decomp_plus,
 			(void *)psi,
 			(void *)chi1,
 			(void *)u,
@@ -515,7 +572,7 @@ namespace CPlusPlusWilsonDslash {
 #endif
       
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-      dispatchToThreads(DslashParscalar32Bit::decomp_hvv_plus_3d,
+      dispatchToThreads(loops.decomp_hvv_plus,
 			(void*)psi,
 			(void*)chi2,
 			(void*)u,
@@ -532,7 +589,7 @@ namespace CPlusPlusWilsonDslash {
 #endif   // NOCOMMS
       
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-      dispatchToThreads(DslashParscalar32Bit::mvv_recons_plus_3d,
+      dispatchToThreads(loops.mvv_recons_plus,
 			(void*)res,
 			(void *)chi1,
 			(void *)u,
@@ -548,7 +605,7 @@ namespace CPlusPlusWilsonDslash {
       
       
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-      dispatchToThreads(DslashParscalar32Bit::recons_plus_3d,
+      dispatchToThreads(loops.recons_plus,
 			(void*)res, 
 			(void*)chi2,
 			(void*)u,	
@@ -568,7 +625,7 @@ namespace CPlusPlusWilsonDslash {
       
       
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-      dispatchToThreads(DslashParscalar32Bit::decomp_minus_3d,
+      dispatchToThreads(loops.decomp_minus,
 			(void*)psi,
 			(void *)chi1,
 			(void *)u,
@@ -582,7 +639,7 @@ namespace CPlusPlusWilsonDslash {
 #endif
       
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-      dispatchToThreads(DslashParscalar32Bit::decomp_hvv_minus_3d,
+      dispatchToThreads(loops.decomp_hvv_minus,
 			(void*)psi,
 			(void*)chi2,
 			(void*)u,
@@ -598,7 +655,7 @@ namespace CPlusPlusWilsonDslash {
 #endif
       
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-      dispatchToThreads(DslashParscalar32Bit::mvv_recons_minus_3d,
+      dispatchToThreads(loops.mvv_recons_minus,
 			(void*)res,
 			(void *)chi1,
 			(void *)u,
@@ -613,7 +670,7 @@ namespace CPlusPlusWilsonDslash {
 #endif // #ifndef NOCOMMS
       
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-      dispatchToThreads(DslashParscalar32Bit::recons_minus_3d,
+      dispatchToThreads(loops.recons_minus,
 			(void*)res, 
 			(void *)chi2,
 			(void *)u,	
@@ -697,4 +754,6 @@ namespace CPlusPlusWilsonDslash {
   }
 
 
+#endif // CPP_DSLASH_SITE_KERNELS_ONLY
+
 } // Namespace
@@ -15,6 +15,26 @@ using namespace CPlusPlusWilsonDslash::Dslash64BitTypes;
 #include <shift_table_3d_parscalar.h>
 
 
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_dslash_parscalar_3d_64bit_avx2.cc */
+namespace CPlusPlusWilsonDslashAVX2 {
+  namespace DslashParscalar64Bit {
+    void decomp_plus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void decomp_hvv_plus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void mvv_recons_plus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void recons_plus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void decomp_minus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void decomp_hvv_minus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void mvv_recons_minus_3d(size_t lo, size_t hi, int id, const void *ptr);
+    void recons_minus_3d(size_t lo, size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+#endif
+
 namespace CPlusPlusWilsonDslash {
 
   namespace DslashParscalar64Bit {
@@ -360,6 +380,42 @@ namespace CPlusPlusWilsonDslash {
 
 
 
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+
+  namespace DslashParscalar64Bit {
+
+    /* The 3D site loops for one ISA */
+    struct SiteLoops3D {
+      SiteFunc decomp_plus, decomp_hvv_plus, mvv_recons_plus, recons_plus;
+      SiteFunc decomp_minus, decomp_hvv_minus, mvv_recons_minus, recons_minus;
+    };
+
+#define PARSCALAR_64BIT_3D_SITE_LOOPS(NS) {					\
+    NS::DslashParscalar64Bit::decomp_plus_3d,	\
+    NS::DslashParscalar64Bit::decomp_hvv_plus_3d,	\
+    NS::DslashParscalar64Bit::mvv_recons_plus_3d,	\
+    NS::DslashParscalar64Bit::recons_plus_3d,	\
+    NS::DslashParscalar64Bit::decomp_minus_3d,	\
+    NS::DslashParscalar64Bit::decomp_hvv_minus_3d,	\
+    NS::DslashParscalar64Bit::mvv_recons_minus_3d,	\
+    NS::DslashParscalar64Bit::recons_minus_3d }
+
+    /* The 3D site loops for the ISA chosen at run time */
+    static const SiteLoops3D& siteLoops3D(void)
+    {
+      static const SiteLoops3D generic = PARSCALAR_64BIT_3D_SITE_LOOPS(::CPlusPlusWilsonDslash);
+#ifdef DSLASH_USE_AVX
+      static const SiteLoops3D avx2 = PARSCALAR_64BIT_3D_SITE_LOOPS(::CPlusPlusWilsonDslashAVX2);
+
+      if( getSiteISA() == SITE_ISA_AVX2 ) {
+	return avx2;
+      }
+#endif
+      return generic;
+    }
+
+  }
+
 // Your actual operator
 void Dslash3D<double>::operator()(double* res, 
 			double* psi, 
@@ -370,6 +426,7 @@ void Dslash3D<double>::operator()(double* res,
   HalfSpinor* chi1 = tab->getChi1();
   HalfSpinor* chi2 = tab->getChi2();
   int subgrid_vol_cb = s_tab->subgridVolCB();
+  const DslashParscalar64Bit::SiteLoops3D& loops = DslashParscalar64Bit::siteLoops3D();
 
 
   if(isign==1) {
@@ -379,7 +436,7 @@ void Dslash3D<double>::operator()(double* res,
 #endif
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar64Bit::decomp_plus_3d,
+    dispatchToThreads(loops.decomp_plus,
 		      (void *)psi,
 		      (void *)chi1,
 		      (void *)u,
@@ -393,7 +450,7 @@ void Dslash3D<double>::operator()(double* res,
 #endif
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar64Bit::decomp_hvv_plus_3d,
+    dispatchToThreads(loops.decomp_hvv_plus,
 		      (void*)psi,
 		      (void*)chi2,
 		      (void*)u,
@@ -410,7 +467,7 @@ void Dslash3D<double>::operator()(double* res,
 #endif   // NOCOMMS
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar64Bit::mvv_recons_plus_3d,
+    dispatchToThreads(loops.mvv_recons_plus,
 		      (void*)res,
 		      (void *)chi1,
 		      (void *)u,
@@ -426,7 +483,7 @@ void Dslash3D<double>::operator()(double* res,
 
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar64Bit::recons_plus_3d,
+    dispatchToThreads(loops.recons_plus,
 		      (void*)res, 
 		      (void*)chi2,
 		      (void*)u,	
@@ -447,7 +504,7 @@ void Dslash3D<double>::operator()(double* res,
 
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar64Bit::decomp_minus_3d,
+    dispatchToThreads(loops.decomp_minus,
 		      (void*)psi,
 		      (void *)chi1,
 		      (void *)u,
@@ -461,7 +518,7 @@ void Dslash3D<double>::operator()(double* res,
 #endif
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar64Bit::decomp_hvv_minus_3d,
+    dispatchToThreads(loops.decomp_hvv_minus,
 		      (void*)psi,
 		      (void*)chi2,
 		      (void*)u,
@@ -477,7 +534,7 @@ void Dslash3D<double>::operator()(double* res,
 #endif
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar64Bit::mvv_recons_minus_3d,
+    dispatchToThreads(loops.mvv_recons_minus,
 		      (void*)res,
 		      (void *)chi1,
 		      (void *)u,
@@ -492,7 +549,7 @@ void Dslash3D<double>::operator()(double* res,
 #endif // #ifndef NOCOMMS
 
 #ifndef SSEDSLASH_4D_NOCOMPUTE
-    dispatchToThreads(DslashParscalar64Bit::recons_minus_3d,
+    dispatchToThreads(loops.recons_minus,
 		      (void*)res, 
 		      (void *)chi2,
 		      (void *)u,	
@@ -581,4 +638,6 @@ void Dslash3D<double>::operator()(double* res,
   }
 
 
+#endif // CPP_DSLASH_SITE_KERNELS_ONLY
+
 } // Namespace
@@ -0,0 +1,7 @@
+/* AVX2+FMA build of the parscalar 64 bit decomp/hvv/mvv/recons site loops.
+ * Same source as cpp_dslash_parscalar_utils_64bit.cc, with the C site
+ * kernels and the intrinsic matvec of cpp_dslash_matvec64bit_avx.h */
+#define CPlusPlusWilsonDslash CPlusPlusWilsonDslashAVX2
+#include "isa_variant.h"
+
+#include "cpp_dslash_parscalar_utils_64bit.cc"
@@ -7,7 +7,56 @@
 using namespace CPlusPlusWilsonDslash::DslashScalar32Bit;
 using namespace CPlusPlusWilsonDslash::Dslash32BitTypes;
 
+/* Right hand sides whose half spinor sums are held at once */
+#define MULTI_RHS_BLOCK 16
+
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_dslash_scalar_32bit_avx2.cc */
+namespace CPlusPlusWilsonDslashAVX2 {
+  namespace DslashScalar32Bit {
+    void DPsiPlus(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiMinus(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiPlusMulti(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiMinusMulti(size_t lo, size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+#endif
+
 namespace CPlusPlusWilsonDslash {
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+
+  namespace DslashScalar32Bit {
+
+    /* The 4D site loops for one ISA */
+    struct SiteLoops {
+      SiteFunc plus, minus, plus_multi, minus_multi;
+    };
+
+#define SCALAR_32BIT_SITE_LOOPS(NS) {					\
+    NS::DslashScalar32Bit::DPsiPlus,	\
+    NS::DslashScalar32Bit::DPsiMinus,	\
+    NS::DslashScalar32Bit::DPsiPlusMulti,	\
+    NS::DslashScalar32Bit::DPsiMinusMulti }
+
+    /* The 4D site loops for the ISA chosen at run time */
+    static const SiteLoops& siteLoops(void)
+    {
+      static const SiteLoops generic = SCALAR_32BIT_SITE_LOOPS(::CPlusPlusWilsonDslash);
+#ifdef DSLASH_USE_AVX
+      static const SiteLoops avx2 = SCALAR_32BIT_SITE_LOOPS(::CPlusPlusWilsonDslashAVX2);
+
+      if( getSiteISA() == SITE_ISA_AVX2 ) {
+	return avx2;
+      }
+#endif
+      return generic;
+    }
+
+  }
  
 
   /* Constructor */
@@ -38,9 +87,11 @@ namespace CPlusPlusWilsonDslash {
 				  int isign,
 				  int cb) 
   {
+    const DslashScalar32Bit::SiteLoops& loops = DslashScalar32Bit::siteLoops();
+
     if (isign == 1) {  
 
-      CPlusPlusWilsonDslash::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DPsiPlus, 
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.plus, 
 					       (void*)psi,
 					       (void*)res,
 					       (void *)u,
@@ -53,7 +104,7 @@ namespace CPlusPlusWilsonDslash {
 
     if( isign == -1) {
 
-      CPlusPlusWilsonDslash::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DPsiMinus, 
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.minus, 
 					       (void *)psi,
 					       (void *)res,
 					       (void *)u,
@@ -65,6 +116,44 @@ namespace CPlusPlusWilsonDslash {
   }
 
 
+  // The operator on nrhs interleaved spinors
+  void Dslash<float>::operator() (float* res, 
+				  float* psi, 
+				  float *u, /* Gauge field suitably packed */
+				  int isign,
+				  int cb,
+				  int nrhs) 
+  {
+    const DslashScalar32Bit::SiteLoops& loops = DslashScalar32Bit::siteLoops();
+
+    if (isign == 1) {  
+
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.plus_multi, 
+					       (void*)psi,
+					       (void*)res,
+					       (void *)u,
+					       (void *)s,
+					       1-cb,
+					       nrhs,
+					       s->totalVolCB());
+    }
+
+    if( isign == -1) {
+
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.minus_multi, 
+					       (void *)psi,
+					       (void *)res,
+					       (void *)u,
+					       (void *)s,
+					       1-cb,
+					       nrhs,
+					       s->totalVolCB());
+    }    
+  }
+
+
+#endif // CPP_DSLASH_SITE_KERNELS_ONLY
+
   namespace DslashScalar32Bit {
     
     void DPsiPlus(size_t lo, size_t hi, int id, const void *ptr)
@@ -267,7 +356,159 @@ namespace CPlusPlusWilsonDslash {
       }
       
     }
-    
+
+    /* The site loops on nrhs interleaved spinors: for each direction
+     * the link and the neighbour offset are fetched once and applied to
+     * all the right hand sides of the site, which sit next to each other.
+     * The half spinor sums are kept for MULTI_RHS_BLOCK of them at a time */
+
+    void DPsiPlusMulti(size_t lo, size_t hi, int id, const void *ptr)
+    {
+      const ThreadWorkerArgs *a = (const ThreadWorkerArgs*)ptr;
+      ShiftTable *s = (ShiftTable *)(a->s);
+      const int total_vol_cb = s->totalVolCB();
+      const int cb = a->cb;
+      const int nrhs = a->nrhs;
+      const int low  = cb*total_vol_cb+lo;
+      const int high = cb*total_vol_cb+hi;
+
+      GaugeMatrix (*gauge_field)[4] = (GaugeMatrix (*)[4])a->u;
+      FourSpinor *psi = (FourSpinor *)a->psi;
+      FourSpinor *res = (FourSpinor *)a->res;
+
+      GaugeMatrix *up1 ALIGN;
+      GaugeMatrix *um1 ALIGN;
+      FourSpinor *sp1 ALIGN;
+      FourSpinor *sm1 ALIGN;
+      FourSpinor *sn1 ALIGN;
+      int iy1;
+
+      /* Half spinor sums for a block of right hand sides */
+      HalfSpinor r12_1[MULTI_RHS_BLOCK] ALIGN;
+      HalfSpinor r34_1[MULTI_RHS_BLOCK] ALIGN;
+
+      for (int ix1 = low; ix1 < high; ix1++) {
+	for (int n0 = 0; n0 < nrhs; n0 += MULTI_RHS_BLOCK) {
+	  const int nb = (nrhs - n0 < MULTI_RHS_BLOCK) ? nrhs - n0 : MULTI_RHS_BLOCK;
+	  sn1 = &res[ ix1*nrhs + n0 ];
+
+	  /* Direction 0 */
+	  sp1 = &psi[ s->forwardNeighbor(ix1,0)*nrhs + n0 ];
+	  up1 = &(gauge_field[ix1][0]);
+	  for(int n=0; n < nb; n++) dslash_plus_dir0_forward(sp1[n], *up1, r12_1[n], r34_1[n]);
+
+	  iy1 = s->backwardNeighbor(ix1,0);
+	  sm1 = &psi[ iy1*nrhs + n0 ];
+	  um1 = &(gauge_field[iy1][0]);
+	  for(int n=0; n < nb; n++) dslash_plus_dir0_backward_add(sm1[n], *um1, r12_1[n], r34_1[n]);
+
+	  /* Direction 1 */
+	  sp1 = &psi[ s->forwardNeighbor(ix1,1)*nrhs + n0 ];
+	  up1 = &(gauge_field[ix1][1]);
+	  for(int n=0; n < nb; n++) dslash_plus_dir1_forward_add(sp1[n], *up1, r12_1[n], r34_1[n]);
+
+	  iy1 = s->backwardNeighbor(ix1,1);
+	  sm1 = &psi[ iy1*nrhs + n0 ];
+	  um1 = &(gauge_field[iy1][1]);
+	  for(int n=0; n < nb; n++) dslash_plus_dir1_backward_add(sm1[n], *um1, r12_1[n], r34_1[n]);
+
+	  /* Direction 2 */
+	  sp1 = &psi[ s->forwardNeighbor(ix1,2)*nrhs + n0 ];
+	  up1 = &(gauge_field[ix1][2]);
+	  for(int n=0; n < nb; n++) dslash_plus_dir2_forward_add(sp1[n], *up1, r12_1[n], r34_1[n]);
+
+	  iy1 = s->backwardNeighbor(ix1,2);
+	  sm1 = &psi[ iy1*nrhs + n0 ];
+	  um1 = &(gauge_field[iy1][2]);
+	  for(int n=0; n < nb; n++) dslash_plus_dir2_backward_add(sm1[n], *um1, r12_1[n], r34_1[n]);
+
+	  /* Direction 3 */
+	  sp1 = &psi[ s->forwardNeighbor(ix1,3)*nrhs + n0 ];
+	  up1 = &(gauge_field[ix1][3]);
+	  for(int n=0; n < nb; n++) dslash_plus_dir3_forward_add(sp1[n], *up1, r12_1[n], r34_1[n]);
+
+	  iy1 = s->backwardNeighbor(ix1,3);
+	  sm1 = &psi[ iy1*nrhs + n0 ];
+	  um1 = &(gauge_field[iy1][3]);
+	  for(int n=0; n < nb; n++) dslash_plus_dir3_backward_add_store(sm1[n], *um1, r12_1[n], r34_1[n], sn1[n]);
+	}
+      }
+    }
+
+
+    void DPsiMinusMulti(size_t lo, size_t hi, int id, const void *ptr)
+    {
+      const ThreadWorkerArgs *a = (const ThreadWorkerArgs*)ptr;
+      ShiftTable *s = (ShiftTable *)(a->s);
+      const int total_vol_cb = s->totalVolCB();
+      const int cb = a->cb;
+      const int nrhs = a->nrhs;
+      const int low  = cb*total_vol_cb+lo;
+      const int high = cb*total_vol_cb+hi;
+
+      GaugeMatrix (*gauge_field)[4] = (GaugeMatrix (*)[4])a->u;
+      FourSpinor *psi = (FourSpinor *)a->psi;
+      FourSpinor *res = (FourSpinor *)a->res;
+
+      GaugeMatrix *up1 ALIGN;
+      GaugeMatrix *um1 ALIGN;
+      FourSpinor *sp1 ALIGN;
+      FourSpinor *sm1 ALIGN;
+      FourSpinor *sn1 ALIGN;
+      int iy1;
+
+      /* Half spinor sums for a block of right hand sides */
+      HalfSpinor r12_1[MULTI_RHS_BLOCK] ALIGN;
+      HalfSpinor r34_1[MULTI_RHS_BLOCK] ALIGN;
+
+      for (int ix1 = low; ix1 < high; ix1++) {
+	for (int n0 = 0; n0 < nrhs; n0 += MULTI_RHS_BLOCK) {
+	  const int nb = (nrhs - n0 < MULTI_RHS_BLOCK) ? nrhs - n0 : MULTI_RHS_BLOCK;
+	  sn1 = &res[ ix1*nrhs + n0 ];
+
+	  /* Direction 0 */
+	  sp1 = &psi[ s->forwardNeighbor(ix1,0)*nrhs + n0 ];
+	  up1 = &(gauge_field[ix1][0]);
+	  for(int n=0; n < nb; n++) dslash_minus_dir0_forward(sp1[n], *up1, r12_1[n], r34_1[n]);
+
+	  iy1 = s->backwardNeighbor(ix1,0);
+	  sm1 = &psi[ iy1*nrhs + n0 ];
+	  um1 = &(gauge_field[iy1][0]);
+	  for(int n=0; n < nb; n++) dslash_minus_dir0_backward_add(sm1[n], *um1, r12_1[n], r34_1[n]);
+
+	  /* Direction 1 */
+	  sp1 = &psi[ s->forwardNeighbor(ix1,1)*nrhs + n0 ];
+	  up1 = &(gauge_field[ix1][1]);
+	  for(int n=0; n < nb; n++) dslash_minus_dir1_forward_add(sp1[n], *up1, r12_1[n], r34_1[n]);
+
+	  iy1 = s->backwardNeighbor(ix1,1);
+	  sm1 = &psi[ iy1*nrhs + n0 ];
+	  um1 = &(gauge_field[iy1][1]);
+	  for(int n=0; n < nb; n++) dslash_minus_dir1_backward_add(sm1[n], *um1, r12_1[n], r34_1[n]);
+
+	  /* Direction 2 */
+	  sp1 = &psi[ s->forwardNeighbor(ix1,2)*nrhs + n0 ];
+	  up1 = &(gauge_field[ix1][2]);
+	  for(int n=0; n < nb; n++) dslash_minus_dir2_forward_add(sp1[n], *up1, r12_1[n], r34_1[n]);
+
+	  iy1 = s->backwardNeighbor(ix1,2);
+	  sm1 = &psi[ iy1*nrhs + n0 ];
+	  um1 = &(gauge_field[iy1][2]);
+	  for(int n=0; n < nb; n++) dslash_minus_dir2_backward_add(sm1[n], *um1, r12_1[n], r34_1[n]);
+
+	  /* Direction 3 */
+	  sp1 = &psi[ s->forwardNeighbor(ix1,3)*nrhs + n0 ];
+	  up1 = &(gauge_field[ix1][3]);
+	  for(int n=0; n < nb; n++) dslash_minus_dir3_forward_add(sp1[n], *up1, r12_1[n], r34_1[n]);
+
+	  iy1 = s->backwardNeighbor(ix1,3);
+	  sm1 = &psi[ iy1*nrhs + n0 ];
+	  um1 = &(gauge_field[iy1][3]);
+	  for(int n=0; n < nb; n++) dslash_minus_dir3_backward_add_store(sm1[n], *um1, r12_1[n], r34_1[n], sn1[n]);
+	}
+      }
+    }
+
   }
 
 } // Namespace
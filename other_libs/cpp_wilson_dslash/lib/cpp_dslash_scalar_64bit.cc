@@ -7,7 +7,53 @@
 using namespace CPlusPlusWilsonDslash::DslashScalar64Bit;
 using namespace CPlusPlusWilsonDslash::Dslash64BitTypes;
 
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+#include <cpp_dslash_cpu.h>
+
+#ifdef DSLASH_USE_AVX
+/* The same site loops built for AVX2, see cpp_dslash_scalar_64bit_avx2.cc */
+namespace CPlusPlusWilsonDslashAVX2 {
+  namespace DslashScalar64Bit {
+    void DPsiPlus(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiMinus(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiPlusMulti(size_t lo, size_t hi, int id, const void *ptr);
+    void DPsiMinusMulti(size_t lo, size_t hi, int id, const void *ptr);
+  }
+}
+#endif
+#endif
+
 namespace CPlusPlusWilsonDslash {
+#ifndef CPP_DSLASH_SITE_KERNELS_ONLY
+
+  namespace DslashScalar64Bit {
+
+    /* The 4D site loops for one ISA */
+    struct SiteLoops {
+      SiteFunc plus, minus, plus_multi, minus_multi;
+    };
+
+#define SCALAR_64BIT_SITE_LOOPS(NS) {					\
+    NS::DslashScalar64Bit::DPsiPlus,	\
+    NS::DslashScalar64Bit::DPsiMinus,	\
+    NS::DslashScalar64Bit::DPsiPlusMulti,	\
+    NS::DslashScalar64Bit::DPsiMinusMulti }
+
+    /* The 4D site loops for the ISA chosen at run time */
+    static const SiteLoops& siteLoops(void)
+    {
+      static const SiteLoops generic = SCALAR_64BIT_SITE_LOOPS(::CPlusPlusWilsonDslash);
+#ifdef DSLASH_USE_AVX
+      static const SiteLoops avx2 = SCALAR_64BIT_SITE_LOOPS(::CPlusPlusWilsonDslashAVX2);
+
+      if( getSiteISA() == SITE_ISA_AVX2 ) {
+	return avx2;
+      }
+#endif
+      return generic;
+    }
+
+  }
  
 
   /* Constructor */
@@ -38,9 +84,11 @@ namespace CPlusPlusWilsonDslash {
 				   int isign,
 				   int cb) 
   {
+    const DslashScalar64Bit::SiteLoops& loops = DslashScalar64Bit::siteLoops();
+
     if (isign == 1) {  
 
-      CPlusPlusWilsonDslash::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DPsiPlus, 
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.plus, 
 					       (void*)psi,
 					       (void*)res,
 					       (void *)u,
@@ -53,7 +101,7 @@ namespace CPlusPlusWilsonDslash {
 
     if( isign == -1) {
 
-      CPlusPlusWilsonDslash::dispatchToThreads((void (*)(size_t, size_t, int, const void *))&DPsiMinus, 
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.minus, 
 					       (void *)psi,
 					       (void *)res,
 					       (void *)u,
@@ -65,6 +113,44 @@ namespace CPlusPlusWilsonDslash {
   }
 
 
+  // The operator on nrhs interleaved spinors
+  void Dslash<double>::operator() (double* res, 
+				   double* psi, 
+				   double *u, /* Gauge field suitably packed */
+				   int isign,
+				   int cb,
+				   int nrhs) 
+  {
+    const DslashScalar64Bit::SiteLoops& loops = DslashScalar64Bit::siteLoops();
+
+    if (isign == 1) {  
+
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.plus_multi, 
+					       (void*)psi,
+					       (void*)res,
+					       (void *)u,
+					       (void *)s,
+					       1-cb,
+					       nrhs,
+					       s->totalVolCB());
+    }
+
+    if( isign == -1) {
+
+      CPlusPlusWilsonDslash::dispatchToThreads(loops.minus_multi, 
+					       (void *)psi,
+					       (void *)res,
+					       (void *)u,
+					       (void *)s,
+					       1-cb,
+					       nrhs,
+					       s->totalVolCB());
+    }    
+  }
+
+
+#endif // CPP_DSLASH_SITE_KERNELS_ONLY
+
   namespace DslashScalar64Bit {
        void DPsiPlus(size_t lo, size_t hi, int id, const void *ptr)
        {
@@ -350,6 +436,134 @@ namespace CPlusPlusWilsonDslash {
       }
     }
 
+    /* The site loops on nrhs interleaved spinors: for each direction
+     * the link and the neighbour offset are fetched once and applied to
+     * all the right hand sides of the site, which sit next to each other */
+    void DPsiPlusMulti(size_t lo, size_t hi, int id, const void *ptr)
+    {
+      const ThreadWorkerArgs *a = (const ThreadWorkerArgs*)ptr;
+      ShiftTable *shift = (ShiftTable *)a->s;
+      const int total_vol_cb = shift->totalVolCB();
+      const int cb = a->cb;
+      const int nrhs = a->nrhs;
+      const int low = cb*total_vol_cb+lo;
+      const int high = cb*total_vol_cb+hi;
+
+      GaugeMatrix (*gauge_field)[4] ALIGN = (GaugeMatrix (*)[4])a->u;
+      FourSpinor *psi = (FourSpinor *)a->psi;
+      FourSpinor *res = (FourSpinor *)a->res;
+
+      for (int ix=low; ix < high; ix++) {
+	FourSpinor *rn = &res[ix*nrhs];
+	FourSpinor *sp, *sm;
+	GaugeMatrix *up, *um;
+	int iy;
+
+	/* Direction 0 */
+	sp = &psi[ shift->forwardNeighbor(ix,0)*nrhs ];
+	up = &(gauge_field[ix][0]);
+	for(int n=0; n < nrhs; n++) dslash_plus_dir0_forward(sp[n], *up, rn[n]);
+
+	iy = shift->backwardNeighbor(ix,0);
+	sm = &psi[ iy*nrhs ];
+	um = &(gauge_field[iy][0]);
+	for(int n=0; n < nrhs; n++) dslash_plus_dir0_backward_add(sm[n], *um, rn[n]);
+
+	/* Direction 1 */
+	sp = &psi[ shift->forwardNeighbor(ix,1)*nrhs ];
+	up = &(gauge_field[ix][1]);
+	for(int n=0; n < nrhs; n++) dslash_plus_dir1_forward_add(sp[n], *up, rn[n]);
+
+	iy = shift->backwardNeighbor(ix,1);
+	sm = &psi[ iy*nrhs ];
+	um = &(gauge_field[iy][1]);
+	for(int n=0; n < nrhs; n++) dslash_plus_dir1_backward_add(sm[n], *um, rn[n]);
+
+	/* Direction 2 */
+	sp = &psi[ shift->forwardNeighbor(ix,2)*nrhs ];
+	up = &(gauge_field[ix][2]);
+	for(int n=0; n < nrhs; n++) dslash_plus_dir2_forward_add(sp[n], *up, rn[n]);
+
+	iy = shift->backwardNeighbor(ix,2);
+	sm = &psi[ iy*nrhs ];
+	um = &(gauge_field[iy][2]);
+	for(int n=0; n < nrhs; n++) dslash_plus_dir2_backward_add(sm[n], *um, rn[n]);
+
+	/* Direction 3 */
+	sp = &psi[ shift->forwardNeighbor(ix,3)*nrhs ];
+	up = &(gauge_field[ix][3]);
+	for(int n=0; n < nrhs; n++) dslash_plus_dir3_forward_add(sp[n], *up, rn[n]);
+
+	iy = shift->backwardNeighbor(ix,3);
+	sm = &psi[ iy*nrhs ];
+	um = &(gauge_field[iy][3]);
+	for(int n=0; n < nrhs; n++) dslash_plus_dir3_backward_add_store(sm[n], *um, rn[n]);
+      }
+    }
+
+
+    void DPsiMinusMulti(size_t lo, size_t hi, int id, const void *ptr)
+    {
+      const ThreadWorkerArgs *a = (const ThreadWorkerArgs*)ptr;
+      ShiftTable *shift = (ShiftTable *)a->s;
+      const int total_vol_cb = shift->totalVolCB();
+      const int cb = a->cb;
+      const int nrhs = a->nrhs;
+      const int low = cb*total_vol_cb+lo;
+      const int high = cb*total_vol_cb+hi;
+
+      GaugeMatrix (*gauge_field)[4] ALIGN = (GaugeMatrix (*)[4])a->u;
+      FourSpinor *psi = (FourSpinor *)a->psi;
+      FourSpinor *res = (FourSpinor *)a->res;
+
+      for (int ix=low; ix < high; ix++) {
+	FourSpinor *rn = &res[ix*nrhs];
+	FourSpinor *sp, *sm;
+	GaugeMatrix *up, *um;
+	int iy;
+
+	/* Direction 0 */
+	sp = &psi[ shift->forwardNeighbor(ix,0)*nrhs ];
+	up = &(gauge_field[ix][0]);
+	for(int n=0; n < nrhs; n++) dslash_minus_dir0_forward(sp[n], *up, rn[n]);
+
+	iy = shift->backwardNeighbor(ix,0);
+	sm = &psi[ iy*nrhs ];
+	um = &(gauge_field[iy][0]);
+	for(int n=0; n < nrhs; n++) dslash_minus_dir0_backward_add(sm[n], *um, rn[n]);
+
+	/* Direction 1 */
+	sp = &psi[ shift->forwardNeighbor(ix,1)*nrhs ];
+	up = &(gauge_field[ix][1]);
+	for(int n=0; n < nrhs; n++) dslash_minus_dir1_forward_add(sp[n], *up, rn[n]);
+
+	iy = shift->backwardNeighbor(ix,1);
+	sm = &psi[ iy*nrhs ];
+	um = &(gauge_field[iy][1]);
+	for(int n=0; n < nrhs; n++) dslash_minus_dir1_backward_add(sm[n], *um, rn[n]);
+
+	/* Direction 2 */
+	sp = &psi[ shift->forwardNeighbor(ix,2)*nrhs ];
+	up = &(gauge_field[ix][2]);
+	for(int n=0; n < nrhs; n++) dslash_minus_dir2_forward_add(sp[n], *up, rn[n]);
+
+	iy = shift->backwardNeighbor(ix,2);
+	sm = &psi[ iy*nrhs ];
+	um = &(gauge_field[iy][2]);
+	for(int n=0; n < nrhs; n++) dslash_minus_dir2_backward_add(sm[n], *um, rn[n]);
+
+	/* Direction 3 */
+	sp = &psi[ shift->forwardNeighbor(ix,3)*nrhs ];
+	up = &(gauge_field[ix][3]);
+	for(int n=0; n < nrhs; n++) dslash_minus_dir3_forward_add(sp[n], *up, rn[n]);
+
+	iy = shift->backwardNeighbor(ix,3);
+	sm = &psi[ iy*nrhs ];
+	um = &(gauge_field[iy][3]);
+	for(int n=0; n < nrhs; n++) dslash_minus_dir3_backward_add_store(sm[n], *um, rn[n]);
+      }
+    }
+
   }
 
 } // Namespace
@@ -1,5 +1,5 @@
 #include <dispatch_parscalar.h>
-#include <omp.h>
+#include <dispatch_pool.h>
 
 
 namespace CPlusPlusWilsonDslash {
@@ -12,26 +12,13 @@ namespace CPlusPlusWilsonDslash {
 			 int n_sites)
   {
     ThreadWorkerArgs a;
-    int threads_num;
-    int myId;
-    int low;
-    int high;
     
     a.spinor = the_spinor;
     a.half_spinor = the_halfspinor;
     a.u = u;
     a.cb = cb;
     a.s = s;
-#pragma omp parallel shared(func, n_sites, a)				\
-  private(threads_num, myId, low, high) default(none)
-    {
-      
-      threads_num = omp_get_num_threads();
-      myId = omp_get_thread_num();
-      low = n_sites * myId/threads_num;
-      high = n_sites * (myId+1)/threads_num;
-      (*func)(low, high, myId, &a);
-    }
+    dispatchSites(func, &a, n_sites);
   }
 
 }; // End Namespace
@@ -56,22 +43,7 @@ void dispatchToThreads(void (*func)(size_t, size_t, int, const void *),
   a.s = s;
   a.half = half;
 
-
-  int threads_num;
-  int myId;
-  int low;
-  int high;
-  
- #pragma omp parallel shared(func, n_sites, a)				\
-  private(threads_num, myId, low, high) default(none)
-    {
-      
-      threads_num = omp_get_num_threads();
-      myId = omp_get_thread_num();
-      low = n_sites*myId/threads_num;
-      high = n_sites*(myId+1)/threads_num;
-      (*func)(low, high, myId, &a);
-    }
+  CPlusPlusWilsonDslash::dispatchSites(func, &a, n_sites);
 }
 
  
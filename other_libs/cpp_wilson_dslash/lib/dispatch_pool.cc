@@ -0,0 +1,454 @@
+#include <dispatch_pool.h>
+#include <omp.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>     /* for _mm_pause */
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace CPlusPlusWilsonDslash {
+
+  namespace {
+
+    /* Scheduler from the environment, static if unset */
+    DispatchScheduler envScheduler(void)
+    {
+      const char* s = std::getenv("CPP_DSLASH_SCHEDULER");
+      if( s != 0x0 && std::string(s) == "pool" ) {
+	return DISPATCH_POOL;
+      }
+      return DISPATCH_STATIC;
+    }
+
+    DispatchScheduler the_scheduler = envScheduler();
+
+
+    /* Body of a spin loop: lets the other hyperthread of the core run
+     * and keeps the loop from flooding the memory system */
+    inline void cpuRelax(void)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      _mm_pause();
+#elif defined(__aarch64__)
+      __asm__ __volatile__("yield");
+#endif
+    }
+
+
+    /* Parse a sysfs CPU or node list such as "0-3,8-11" */
+    std::vector<int> parseList(const std::string& s)
+    {
+      std::vector<int> ret;
+      std::istringstream in(s);
+      std::string item;
+      while( std::getline(in, item, ',') ) {
+	int lo, hi;
+	char dash;
+	std::istringstream r(item);
+	if( !(r >> lo) ) continue;
+	hi = lo;
+	if( r >> dash && dash == '-' ) r >> hi;
+	for(int c=lo; c <= hi; c++) ret.push_back(c);
+      }
+      return ret;
+    }
+
+    /* First line of a sysfs file, empty if it cannot be read */
+    std::string readSysfs(const std::string& path)
+    {
+      std::ifstream f(path.c_str());
+      std::string line;
+      if( f ) std::getline(f, line);
+      return line;
+    }
+
+    /* NUMA node of each CPU from /sys/devices/system/node, indexed by
+     * CPU number. Empty if the kernel does not export the node map */
+    std::vector<int> numaNodeOfCpu(void)
+    {
+      std::vector<int> node_of;
+      std::vector<int> nodes = parseList(readSysfs("/sys/devices/system/node/online"));
+
+      for(size_t i=0; i < nodes.size(); i++) {
+	std::ostringstream path;
+	path << "/sys/devices/system/node/node" << nodes[i] << "/cpulist";
+	std::vector<int> cpus = parseList(readSysfs(path.str()));
+
+	for(size_t j=0; j < cpus.size(); j++) {
+	  if( cpus[j] >= (int)node_of.size() ) node_of.resize(cpus[j]+1, 0);
+	  node_of[cpus[j]] = nodes[i];
+	}
+      }
+      return node_of;
+    }
+
+
+    /* One contiguous range of sites per thread. Owner and thieves
+     * both take chunks off the front with a fetch_add, so a range
+     * is drained exactly once whoever gets there. Padded so that
+     * each counter has its own cache line */
+    struct SiteRange {
+      std::atomic<int> next;
+      int end;
+      char pad[64 - sizeof(std::atomic<int>) - sizeof(int)];
+    };
+
+
+    class ThreadPool {
+    public:
+      static ThreadPool& instance(void) {
+	static ThreadPool pool;
+	return pool;
+      }
+
+      int numThreads(void) const { return n_threads; }
+
+      void run(DispatchFunc f, const void* a, int n_sites) {
+	if( n_sites <= 0 ) return;
+
+	func = f;
+	args = a;
+
+	/* Contiguous initial split, the same as the static OpenMP
+	 * schedule, so each thread starts on the sites its OpenMP
+	 * counterpart touched first */
+	for(int t=0; t < n_threads; t++) {
+	  ranges[t].next.store(  (int)(((long)n_sites*t)/n_threads), std::memory_order_relaxed);
+	  ranges[t].end = (int)(((long)n_sites*(t+1))/n_threads);
+	}
+	chunk = n_sites/(chunks_per_thread*n_threads);
+	if( chunk < 1 ) chunk = 1;
+
+	remaining.store(n_threads-1, std::memory_order_relaxed);
+
+	pthread_mutex_lock(&mutex);
+	generation.fetch_add(1, std::memory_order_release);
+	pthread_cond_broadcast(&wake);
+	pthread_mutex_unlock(&mutex);
+
+	/* The caller is thread 0 */
+	work(0);
+
+	while( remaining.load(std::memory_order_acquire) > 0 ) {
+	  /* the stragglers are at most one chunk away */
+	  cpuRelax();
+	}
+      }
+
+    private:
+      ThreadPool(void) : shutdown(false), generation(0), remaining(0) {
+	n_threads = omp_get_max_threads();
+	const char* nt = std::getenv("CPP_DSLASH_NUM_THREADS");
+	if( nt != 0x0 && std::atoi(nt) > 0 ) {
+	  n_threads = std::atoi(nt);
+	}
+
+	ranges = new SiteRange[n_threads];
+	pthread_mutex_init(&mutex, NULL);
+	pthread_cond_init(&wake, NULL);
+
+	bool pin = true;
+	const char* p = std::getenv("CPP_DSLASH_PIN_THREADS");
+	if( p != 0x0 && std::string(p) == "0" ) pin = false;
+
+	pin_caller = false;
+	std::vector<int> node(n_threads, 0);
+
+#ifdef __linux__
+	if( pin ) placeThreads(node);
+#endif
+
+	/* Steal from threads on the same NUMA node first, nearest id
+	 * first, and only then from the other nodes */
+	steal_order.resize(n_threads);
+	for(int t=0; t < n_threads; t++) {
+	  for(int d=1; d < n_threads; d++) {
+	    int victim = ( d & 1 ) ? t + (d+1)/2 : t - d/2;
+	    victim = (victim % n_threads + n_threads) % n_threads;
+	    steal_order[t].push_back(victim);
+	  }
+	  std::stable_partition(steal_order[t].begin(), steal_order[t].end(),
+				SameNode(node, node[t]));
+	}
+
+	/* The caller is thread 0. If the OpenMP runtime has not already
+	 * bound it there it is pinned here, once: the OpenMP team exists
+	 * by now and keeps its own masks, but threads the caller creates
+	 * later inherit its CPU */
+#ifdef __linux__
+	if( pin_caller ) {
+	  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &masks[0]);
+	}
+#endif
+
+	threads.resize(n_threads);
+	starts.resize(n_threads);
+	for(int t=1; t < n_threads; t++) {
+	  starts[t].pool = this;
+	  starts[t].id = t;
+	  pthread_create(&threads[t], NULL, &ThreadPool::worker, &starts[t]);
+#ifdef __linux__
+	  if( !masks.empty() ) {
+	    pthread_setaffinity_np(threads[t], sizeof(cpu_set_t), &masks[t]);
+	  }
+#endif
+	}
+      }
+
+#ifdef __linux__
+      /* Choose the CPUs of each thread and record their NUMA nodes.
+       *
+       * If the OpenMP runtime binds its threads (OMP_PROC_BIND, OMP_PLACES
+       * or the launcher), pool thread t takes the mask of OpenMP thread t.
+       * The pool and the OpenMP regions never run at the same time, so the
+       * two sets of threads then share cores one to one rather than
+       * colliding, and thread t's initial range is the part of the lattice
+       * OpenMP thread t touched first, i.e. memory on its own NUMA node.
+       *
+       * Otherwise the CPUs of the caller's mask, which is what the MPI
+       * launcher gave the process, are handed out one per thread in order
+       * of NUMA node, so that neighbouring thread ids share a node */
+      void placeThreads(std::vector<int>& node) {
+	std::vector<cpu_set_t> omp_masks(n_threads);
+	std::vector<char> got(n_threads, 0);
+
+#pragma omp parallel num_threads(n_threads)
+	{
+	  int t = omp_get_thread_num();
+	  if( t < n_threads &&
+	      sched_getaffinity(0, sizeof(cpu_set_t), &omp_masks[t]) == 0 ) {
+	    got[t] = 1;
+	  }
+	}
+
+	/* Read after the parallel region, which binds the caller if the
+	 * runtime binds at all */
+	CPU_ZERO(&caller_mask);
+	if( sched_getaffinity(0, sizeof(caller_mask), &caller_mask) != 0 ) return;
+
+	/* Unbound OpenMP threads all have the same mask */
+	bool omp_bound = false;
+	for(int t=0; t < n_threads; t++) {
+	  if( !got[t] ) {
+	    placeFromMask(caller_mask, node);
+	    return;
+	  }
+	  if( !CPU_EQUAL(&omp_masks[t], &omp_masks[0]) ) omp_bound = true;
+	}
+
+	if( !omp_bound ) {
+	  placeFromMask(caller_mask, node);
+	  return;
+	}
+
+	masks = omp_masks;
+	setNodes(node);
+      }
+
+      /* One CPU of mask per thread, in order of NUMA node */
+      void placeFromMask(const cpu_set_t& mask, std::vector<int>& node) {
+	const std::vector<int> node_of = numaNodeOfCpu();
+
+	std::vector< std::pair<int,int> > cpus;
+	for(int c=0; c < CPU_SETSIZE; c++) {
+	  if( CPU_ISSET(c, &mask) ) {
+	    int n = ( c < (int)node_of.size() ) ? node_of[c] : 0;
+	    cpus.push_back(std::make_pair(n, c));
+	  }
+	}
+	if( (int)cpus.size() < n_threads ) return;
+
+	std::sort(cpus.begin(), cpus.end());
+
+	masks.resize(n_threads);
+	for(int t=0; t < n_threads; t++) {
+	  CPU_ZERO(&masks[t]);
+	  CPU_SET(cpus[t].second, &masks[t]);
+	}
+	setNodes(node);
+      }
+
+      /* NUMA node of each thread, from the first CPU of its mask */
+      void setNodes(std::vector<int>& node) {
+	const std::vector<int> node_of = numaNodeOfCpu();
+
+	/* The caller only needs pinning if it is not already on its CPUs */
+	pin_caller = !CPU_EQUAL(&masks[0], &caller_mask);
+
+	for(int t=0; t < n_threads; t++) {
+	  for(int c=0; c < CPU_SETSIZE; c++) {
+	    if( CPU_ISSET(c, &masks[t]) ) {
+	      node[t] = ( c < (int)node_of.size() ) ? node_of[c] : 0;
+	      break;
+	    }
+	  }
+	}
+      }
+#endif
+
+      /* Predicate for the steal order: victim on a given node */
+      struct SameNode {
+	SameNode(const std::vector<int>& node_, int n_) : node(node_), n(n_) {}
+	bool operator()(int victim) const { return node[victim] == n; }
+	const std::vector<int>& node;
+	int n;
+      };
+
+      ~ThreadPool(void) {
+	pthread_mutex_lock(&mutex);
+	shutdown = true;
+	generation.fetch_add(1, std::memory_order_release);
+	pthread_cond_broadcast(&wake);
+	pthread_mutex_unlock(&mutex);
+
+	for(int t=1; t < n_threads; t++) {
+	  pthread_join(threads[t], NULL);
+	}
+	pthread_cond_destroy(&wake);
+	pthread_mutex_destroy(&mutex);
+	delete [] ranges;
+      }
+
+      /* Drain a range in chunks */
+      void drain(int victim, int id) {
+	SiteRange& r = ranges[victim];
+	const int end = r.end;
+	for(;;) {
+	  int lo = r.next.fetch_add(chunk, std::memory_order_relaxed);
+	  if( lo >= end ) break;
+	  int hi = lo + chunk;
+	  if( hi > end ) hi = end;
+	  (*func)(lo, hi, id, args);
+	}
+      }
+
+      /* Own range first, then steal in the precomputed order */
+      void work(int id) {
+	drain(id, id);
+	const std::vector<int>& order = steal_order[id];
+	for(size_t d=0; d < order.size(); d++) {
+	  drain(order[d], id);
+	}
+      }
+
+      struct Start {
+	ThreadPool* pool;
+	int id;
+      };
+
+      static void* worker(void* arg) {
+	Start* s = (Start *)arg;
+	ThreadPool& me = *(s->pool);
+	unsigned long seen = 0;
+
+	for(;;) {
+	  /* Spin briefly before sleeping, so that back-to-back dslash
+	   * calls do not pay for a wakeup. Kept short because the worker
+	   * shares its core with an OpenMP thread, which needs it as
+	   * soon as the code between the calls runs an OpenMP region */
+	  unsigned long gen = me.generation.load(std::memory_order_acquire);
+	  for(int i=0; i < spin_count && gen == seen; i++) {
+	    cpuRelax();
+	    gen = me.generation.load(std::memory_order_acquire);
+	  }
+	  if( gen == seen ) {
+	    pthread_mutex_lock(&me.mutex);
+	    while( (gen = me.generation.load(std::memory_order_acquire)) == seen ) {
+	      pthread_cond_wait(&me.wake, &me.mutex);
+	    }
+	    pthread_mutex_unlock(&me.mutex);
+	  }
+	  seen = gen;
+
+	  if( me.shutdown ) break;
+
+	  me.work(s->id);
+	  me.remaining.fetch_sub(1, std::memory_order_release);
+	}
+	return NULL;
+      }
+
+      static const int chunks_per_thread = 8;
+      static const int spin_count = 2000;      /* a few microseconds of pauses */
+
+      int n_threads;
+      int chunk;
+      DispatchFunc func;
+      const void* args;
+      SiteRange* ranges;
+
+      std::vector<pthread_t> threads;
+      std::vector<Start> starts;
+      std::vector< std::vector<int> > steal_order;
+
+      /* CPUs of each thread, empty if not pinned. The caller's mask is
+       * the one it had before the pool pinned it, if pin_caller is set */
+#ifdef __linux__
+      std::vector<cpu_set_t> masks;
+      cpu_set_t caller_mask;
+#else
+      std::vector<int> masks;
+#endif
+      bool pin_caller;
+
+      pthread_mutex_t mutex;
+      pthread_cond_t wake;
+      volatile bool shutdown;
+      std::atomic<unsigned long> generation;
+      std::atomic<int> remaining;
+    };
+
+  } // anonymous namespace
+
+
+  void setDispatchScheduler(DispatchScheduler s)
+  {
+    the_scheduler = s;
+  }
+
+  DispatchScheduler getDispatchScheduler(void)
+  {
+    return the_scheduler;
+  }
+
+  int dispatchPoolNumThreads(void)
+  {
+    return ThreadPool::instance().numThreads();
+  }
+
+  void dispatchStatic(DispatchFunc func, const void* args, int n_sites)
+  {
+    int threads_num;
+    int myId;
+    int low;
+    int high;
+
+#pragma omp parallel shared(func, n_sites, args)			\
+  private(threads_num, myId, low, high) default(none)
+    {
+      threads_num = omp_get_num_threads();
+      myId = omp_get_thread_num();
+      low = n_sites * myId/threads_num;
+      high = n_sites * (myId+1)/threads_num;
+      (*func)(low, high, myId, args);
+    }
+  }
+
+  void dispatchPool(DispatchFunc func, const void* args, int n_sites)
+  {
+    ThreadPool::instance().run(func, args, n_sites);
+  }
+
+}; // End Namespace
@@ -10,6 +10,18 @@ void dispatchToThreads(void (*func)(size_t, size_t, int, const void *),
 		       void *s,
 		       int cb,
 		       int n_sites)
+{
+  dispatchToThreads(func, source, result, u, s, cb, 1, n_sites);
+}
+
+void dispatchToThreads(void (*func)(size_t, size_t, int, const void *),
+		       void* source,
+		       void* result, 
+		       void *u,
+		       void *s,
+		       int cb,
+		       int nrhs,
+		       int n_sites)
 {
   struct ThreadWorkerArgs a;
   a.psi = source;
@@ -17,6 +29,7 @@ void dispatchToThreads(void (*func)(size_t, size_t, int, const void *),
   a.u = u;
   a.cb = cb;
   a.s = s;
+  a.nrhs = nrhs;
   /* Call dispatch function, with lo=0, hi=n_sites */
   (*func)(0, n_sites, 0, &a);
 }
@@ -1,5 +1,5 @@
 #include <dispatch_scalar.h>
-#include <omp.h>
+#include <dispatch_pool.h>
 
 
 namespace CPlusPlusWilsonDslash {
@@ -10,28 +10,28 @@ namespace CPlusPlusWilsonDslash {
 			 void *s,
 			 int cb,
 			 int n_sites)
+  {
+    dispatchToThreads(func, source, result, u, s, cb, 1, n_sites);
+  }
+
+  void dispatchToThreads(void (*func)(size_t, size_t, int, const void *),
+			 void* source,
+			 void* result, 
+			 void *u,
+			 void *s,
+			 int cb,
+			 int nrhs,
+			 int n_sites)
   {
     ThreadWorkerArgs a;
-     int threads_num;
-    int myId;
-    int low;
-    int high;
    
     a.psi = source;
     a.res = result;
     a.u = u;
     a.cb = cb;
     a.s = s;
-#pragma omp parallel shared(func, n_sites, a)				\
-  private(threads_num, myId, low, high) default(none)
-    {
-      
-      threads_num = omp_get_num_threads();
-      myId = omp_get_thread_num();
-      low = n_sites * myId/threads_num;
-      high = n_sites * (myId+1)/threads_num;
-      (*func)(low, high, myId, &a);
-    }
+    a.nrhs = nrhs;
+    dispatchSites(func, &a, n_sites);
   }
 
 }; // End Namespace
@@ -59,21 +59,7 @@ namespace CPlusPlusClover {
   a.t_spinor = t_spinor;
   a.s = s;
 
-
-  int threads_num;
-  int myId;
-  int low;
-  int high;
-#pragma omp parallel shared(func, n_sites, a)				\
-  private(threads_num, myId, low, high) default(none)
-    {
-      
-      threads_num = omp_get_num_threads();
-      myId = omp_get_thread_num();
-      low = n_sites * myId/threads_num;
-      high = n_sites * (myId+1)/threads_num;
-      (*func)(low, high, myId, &a);
-    }
+  CPlusPlusWilsonDslash::dispatchSites(func, &a, n_sites);
   } 
 
 } // End namespace
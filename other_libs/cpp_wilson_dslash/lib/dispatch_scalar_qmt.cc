@@ -10,6 +10,18 @@ namespace CPlusPlusWilsonDslash {
 		       void *s,
 		       int cb,
 		       int n_sites)
+  {
+    dispatchToThreads(func, source, result, u, s, cb, 1, n_sites);
+  }
+
+  void dispatchToThreads(void (*func)(size_t, size_t, int, const void *),
+		       void* source,
+		       void* result, 
+		       void *u,
+		       void *s,
+		       int cb,
+		       int nrhs,
+		       int n_sites)
   {
     ThreadWorkerArgs a;
     int threads_num;
@@ -23,6 +35,7 @@ namespace CPlusPlusWilsonDslash {
     a.u = u;
     a.cb = cb;
     a.s = s;
+    a.nrhs = nrhs;
     qmt_call((qmt_userfunc_t)func, n_sites, &a);
   }
 
@@ -0,0 +1,37 @@
+#ifndef ISA_VARIANT_H
+#define ISA_VARIANT_H
+
+/* Common set up for the translation units that recompile the site loops
+ * for a wider instruction set (the *_avx2.cc files).
+ *
+ * Those units are built with extra -m flags (see Makefile.am) and
+ * #define CPlusPlusWilsonDslash (and CPlusPlusClover) to a per-ISA
+ * name before including this, so that no inline function compiled for
+ * the wider ISA can be merged with its generic twin at link time. They also #define the
+ * guard of the source they include, so that only its site loops are
+ * built again. The variants are selected at run time, see
+ * cpp_dslash_cpu.h.
+ */
+
+#include <dslash_config.h>
+
+/* The variants start from the portable C site kernels, never from the
+ * SSE ones, with the intrinsic SU(3) matvec of
+ * cpp_dslash_matvec{32,64}bit_avx.h in place of the C one, and the
+ * clover apply of cpp_clover_site_apply_{32,64}bit_avx.h. They must
+ * not pull QDP++ in under the wider flags */
+#undef DSLASH_USE_SSE2
+#undef SSE_USE_QDPXX
+#define DSLASH_MATVEC_AVX
+
+/* System headers first, outside the renamed namespaces */
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <immintrin.h>
+
+#ifdef CPP_DSLASH_PARSCALAR
+#include <qmp.h>
+#endif
+
+#endif
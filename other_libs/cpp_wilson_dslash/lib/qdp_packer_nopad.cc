@@ -31,4 +31,56 @@ void qdp_pack_gauge(const multi1d<LatticeColorMatrixD>&_u, PrimitiveSU3MatrixD*
     qdpPackGauge<>(_u, u_tmp);
   }
 
+  template<typename T1, typename T2>
+void qdpPackSpinors(const multi1d<T1>& psi, T2* psi_tmp)
+{
+	int volume = Layout::sitesOnNode();
+	int nrhs = psi.size();
+
+#pragma omp parallel for
+	for(int ix = 0; ix < volume; ix++) 
+	{
+		for(int n = 0; n < nrhs; n++) 
+		{ 
+			psi_tmp[ n + nrhs*(ix) ] = psi[n].elem(ix);
+		}
+	}
+}
+
+  template<typename T1, typename T2>
+void qdpUnpackSpinors(const T2* psi_tmp, multi1d<T1>& psi)
+{
+	int volume = Layout::sitesOnNode();
+	int nrhs = psi.size();
+
+#pragma omp parallel for
+	for(int ix = 0; ix < volume; ix++) 
+	{
+		for(int n = 0; n < nrhs; n++) 
+		{ 
+			psi[n].elem(ix) = psi_tmp[ n + nrhs*(ix) ];
+		}
+	}
+}
+
+void qdp_pack_spinors(const multi1d<LatticeFermionF>& psi, PrimitiveSpinorF* psi_tmp)
+  {
+    qdpPackSpinors<>(psi, psi_tmp);
+  }
+
+void qdp_pack_spinors(const multi1d<LatticeFermionD>& psi, PrimitiveSpinorD* psi_tmp)
+  {
+    qdpPackSpinors<>(psi, psi_tmp);
+  }
+
+void qdp_unpack_spinors(const PrimitiveSpinorF* psi_tmp, multi1d<LatticeFermionF>& psi)
+  {
+    qdpUnpackSpinors<>(psi_tmp, psi);
+  }
+
+void qdp_unpack_spinors(const PrimitiveSpinorD* psi_tmp, multi1d<LatticeFermionD>& psi)
+  {
+    qdpUnpackSpinors<>(psi_tmp, psi);
+  }
+
 }
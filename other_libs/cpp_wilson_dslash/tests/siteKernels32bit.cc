@@ -0,0 +1,81 @@
+/* The 32 bit parscalar decomp_hvv and mvv_recons site kernels and the
+ * clover site apply, for testSiteISA. Built generic here and again with
+ * the AVX2 matvecs in siteKernels32bit_avx2.cc. Only the C kernel
+ * headers are used, so this needs neither QDP++ nor QMP */
+#include <cstring>
+
+#include "cpp_dslash_parscalar_decomp_hvv_32bit_c.h"
+#include "cpp_dslash_parscalar_mvv_recons_32bit_c.h"
+
+/* The C clover apply names the dslash types without their namespace */
+using namespace CPlusPlusWilsonDslash;
+
+#ifdef DSLASH_MATVEC_AVX
+#include "cpp_clover_site_apply_32bit_avx.h"
+#else
+#include "cpp_clover_site_apply_32bit_c.h"
+#endif
+
+namespace SiteKernels {
+
+  using namespace CPlusPlusWilsonDslash::DslashParscalar32Bit;
+
+  void decompHvv32(const float* spinor, const float* links, float* dst)
+  {
+    FourSpinor src;
+    GaugeMatrix u[4];
+    HalfSpinor res[2][4];
+    std::memcpy(src, spinor, sizeof(src));
+    std::memcpy(u, links, sizeof(u));
+
+    decomp_hvv_gamma0_plus(src, u[0], res[0][0]);
+    decomp_hvv_gamma1_plus(src, u[1], res[0][1]);
+    decomp_hvv_gamma2_plus(src, u[2], res[0][2]);
+    decomp_hvv_gamma3_plus(src, u[3], res[0][3]);
+
+    decomp_hvv_gamma0_minus(src, u[0], res[1][0]);
+    decomp_hvv_gamma1_minus(src, u[1], res[1][1]);
+    decomp_hvv_gamma2_minus(src, u[2], res[1][2]);
+    decomp_hvv_gamma3_minus(src, u[3], res[1][3]);
+
+    std::memcpy(dst, res, sizeof(res));
+  }
+
+  void mvvRecons32(const float* half, const float* links, float* dst)
+  {
+    HalfSpinor hs[4];
+    GaugeMatrix u[4];
+    FourSpinor res[2];
+    HalfSpinor upper, lower;
+    std::memcpy(hs, half, sizeof(hs));
+    std::memcpy(u, links, sizeof(u));
+
+    mvv_recons_gamma0_plus(hs[0], u[0], upper, lower);
+    mvv_recons_gamma1_plus_add(hs[1], u[1], upper, lower);
+    mvv_recons_gamma2_plus_add(hs[2], u[2], upper, lower);
+    mvv_recons_gamma3_plus_add_store(hs[3], u[3], upper, lower, res[0]);
+
+    mvv_recons_gamma0_minus(hs[0], u[0], upper, lower);
+    mvv_recons_gamma1_minus_add(hs[1], u[1], upper, lower);
+    mvv_recons_gamma2_minus_add(hs[2], u[2], upper, lower);
+    mvv_recons_gamma3_minus_add_store(hs[3], u[3], upper, lower, res[1]);
+
+    std::memcpy(dst, res, sizeof(res));
+  }
+
+  void cloverApply32(const float* spinor, const float* clov, float* dst)
+  {
+    using namespace CPlusPlusClover::Clover32BitTypes;
+    using namespace CPlusPlusClover::CPlusPlusClover32Bit;
+
+    FourSpinor src, res;
+    CloverTerm c;
+    std::memcpy(src, spinor, sizeof(src));
+    std::memcpy(c, clov, sizeof(c));
+
+    cloverSiteApply(res, c, src);
+
+    std::memcpy(dst, res, sizeof(res));
+  }
+
+}
@@ -0,0 +1,9 @@
+/* AVX2+FMA build of siteKernels32bit.cc, with the intrinsic matvecs of
+ * cpp_dslash_matvec32bit_avx.h and cpp_clover_site_apply_32bit_avx.h as
+ * in the library's *_avx2.cc files */
+#define CPlusPlusWilsonDslash CPlusPlusWilsonDslashAVX2
+#define CPlusPlusClover CPlusPlusCloverAVX2
+#define SiteKernels SiteKernelsAVX2
+#define DSLASH_MATVEC_AVX
+
+#include "siteKernels32bit.cc"
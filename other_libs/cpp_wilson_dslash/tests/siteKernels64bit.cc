@@ -0,0 +1,81 @@
+/* The 64 bit parscalar decomp_hvv and mvv_recons site kernels and the
+ * clover site apply, for testSiteISA. Built generic here and again with
+ * the AVX2 matvecs in siteKernels64bit_avx2.cc. Only the C kernel
+ * headers are used, so this needs neither QDP++ nor QMP */
+#include <cstring>
+
+#include "cpp_dslash_parscalar_decomp_hvv_64bit_c.h"
+#include "cpp_dslash_parscalar_mvv_recons_64bit_c.h"
+
+/* The C clover apply names the dslash types without their namespace */
+using namespace CPlusPlusWilsonDslash;
+
+#ifdef DSLASH_MATVEC_AVX
+#include "cpp_clover_site_apply_64bit_avx.h"
+#else
+#include "cpp_clover_site_apply_64bit_c.h"
+#endif
+
+namespace SiteKernels {
+
+  using namespace CPlusPlusWilsonDslash::DslashParscalar64Bit;
+
+  void decompHvv64(const double* spinor, const double* links, double* dst)
+  {
+    FourSpinor src;
+    GaugeMatrix u[4];
+    HalfSpinor res[2][4];
+    std::memcpy(src, spinor, sizeof(src));
+    std::memcpy(u, links, sizeof(u));
+
+    decomp_hvv_gamma0_plus(src, u[0], res[0][0]);
+    decomp_hvv_gamma1_plus(src, u[1], res[0][1]);
+    decomp_hvv_gamma2_plus(src, u[2], res[0][2]);
+    decomp_hvv_gamma3_plus(src, u[3], res[0][3]);
+
+    decomp_hvv_gamma0_minus(src, u[0], res[1][0]);
+    decomp_hvv_gamma1_minus(src, u[1], res[1][1]);
+    decomp_hvv_gamma2_minus(src, u[2], res[1][2]);
+    decomp_hvv_gamma3_minus(src, u[3], res[1][3]);
+
+    std::memcpy(dst, res, sizeof(res));
+  }
+
+  void mvvRecons64(const double* half, const double* links, double* dst)
+  {
+    HalfSpinor hs[4];
+    GaugeMatrix u[4];
+    FourSpinor res[2];
+    FourSpinor sum;
+    std::memcpy(hs, half, sizeof(hs));
+    std::memcpy(u, links, sizeof(u));
+
+    mvv_recons_gamma0_plus(hs[0], u[0], sum);
+    mvv_recons_gamma1_plus_add(hs[1], u[1], sum);
+    mvv_recons_gamma2_plus_add(hs[2], u[2], sum);
+    mvv_recons_gamma3_plus_add_store(hs[3], u[3], sum, res[0]);
+
+    mvv_recons_gamma0_minus(hs[0], u[0], sum);
+    mvv_recons_gamma1_minus_add(hs[1], u[1], sum);
+    mvv_recons_gamma2_minus_add(hs[2], u[2], sum);
+    mvv_recons_gamma3_minus_add_store(hs[3], u[3], sum, res[1]);
+
+    std::memcpy(dst, res, sizeof(res));
+  }
+
+  void cloverApply64(const double* spinor, const double* clov, double* dst)
+  {
+    using namespace CPlusPlusClover::Clover64BitTypes;
+    using namespace CPlusPlusClover::CPlusPlusClover64Bit;
+
+    FourSpinor src, res;
+    CloverTerm c;
+    std::memcpy(src, spinor, sizeof(src));
+    std::memcpy(c, clov, sizeof(c));
+
+    cloverSiteApply(res, c, src);
+
+    std::memcpy(dst, res, sizeof(res));
+  }
+
+}
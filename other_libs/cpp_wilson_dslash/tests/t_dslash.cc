@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <cstdio>
+#include <string>
 
 #include "qdp.h"
 #include "unittest.h"
@@ -16,7 +17,13 @@ int main(int argc, char **argv)
 {
   // Initialize UnitTest jig
   TestRunner  tests(&argc, &argv, nrow_in);
-  tests.addTest(new testDslashFull(), "testDslashFull" );
+  // One per instruction set the site kernels are built for
+  for(int isa=CPlusPlusWilsonDslash::SITE_ISA_GENERIC;
+      isa <= CPlusPlusWilsonDslash::maxSiteISA(); isa++) {
+    CPlusPlusWilsonDslash::SiteISA s = (CPlusPlusWilsonDslash::SiteISA)isa;
+    tests.addTest(new testDslashFull(s),
+		  std::string("testDslashFull_")+CPlusPlusWilsonDslash::siteISAName(s) );
+  }
 
   // Run all tests
   tests.run();
@@ -0,0 +1,41 @@
+// Checks the decomp_hvv and mvv_recons site kernels and the clover site
+// apply built for each instruction set against the generic C ones
+
+#include <iostream>
+#include <cstdio>
+#include <string>
+
+#include "qdp.h"
+#include "unittest.h"
+
+#include "testSiteISA.h"
+
+using namespace QDP;
+
+int main(int argc, char **argv)
+{
+  // The kernels work on one site, so any small lattice will do
+  const int latdims[] = {4,4,4,4};
+
+  // Initialize UnitTest jig
+  TestRunner  tests(&argc, &argv, latdims);
+
+  // Every instruction set this build and this CPU have, past the generic one
+  for(int isa=CPlusPlusWilsonDslash::SITE_ISA_GENERIC+1;
+      isa <= CPlusPlusWilsonDslash::maxSiteISA(); isa++) {
+    CPlusPlusWilsonDslash::SiteISA s = (CPlusPlusWilsonDslash::SiteISA)isa;
+    tests.addTest(new testDecompHvvISA(s),
+		  std::string("testDecompHvv_")+CPlusPlusWilsonDslash::siteISAName(s) );
+    tests.addTest(new testMvvReconsISA(s),
+		  std::string("testMvvRecons_")+CPlusPlusWilsonDslash::siteISAName(s) );
+    tests.addTest(new testCloverApplyISA(s),
+		  std::string("testCloverApply_")+CPlusPlusWilsonDslash::siteISAName(s) );
+  }
+
+  // Run all tests
+  tests.run();
+
+  // Testjig is destroyed
+  tests.summary();
+
+}
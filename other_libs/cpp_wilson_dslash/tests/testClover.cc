@@ -31,6 +31,8 @@ using namespace Dslash32BitTypes;
 void
 testClover::run(void) 
 {
+  setSiteISA(isa);
+  QDPIO::cout << "Site kernels: " << siteISAName(getSiteISA()) << std::endl;
 
   LatticeFermionF3 chi, Dpsi, ADpsi;
   LatticeFermionF3 chi2,psi;
@@ -200,8 +202,10 @@ testClover::run(void)
     }
     chi2[rb[1]] -= Dpsi;
     LatticeFermionF3 diff_float = chi2 - chi;
+    Double diff_norm = sqrt(norm2(diff_float, rb[1])) / ( Real(4*3*2*Layout::vol()) / Real(2));
     QDPIO::cout << std::endl;
-    QDPIO::cout << "\t isign = " << isign << "\t norm2(chi2,rb[1])=" << norm2(chi2, rb[1]) << "\t || diff || = "<< sqrt(norm2(diff_float, rb[1])) / ( Real(4*3*2*Layout::vol()) / Real(2))  << std::endl;
+    QDPIO::cout << "\t isign = " << isign << "\t norm2(chi2,rb[1])=" << norm2(chi2, rb[1]) << "\t || diff || = "<< diff_norm << std::endl;
+    assertion( toBool( diff_norm < small32 ) );
   }
   
 
@@ -234,9 +238,11 @@ testClover::run(void)
 
 
     LatticeFermionF3 diff_float = chi2 - chi;
+    Double diff_norm = sqrt(norm2(diff_float, rb[1])) / ( Real(4*3*2*Layout::vol()) / Real(2));
 
     QDPIO::cout << std::endl;
-    QDPIO::cout << "\t isign = " << isign << "\t || diff || = "<< sqrt(norm2(diff_float, rb[1])) / ( Real(4*3*2*Layout::vol()) / Real(2))  << std::endl;
+    QDPIO::cout << "\t isign = " << isign << "\t || diff || = "<< diff_norm << std::endl;
+    assertion( toBool( diff_norm < small32 ) );
 
   }
   free(xclovd);
@@ -23,6 +23,8 @@ using namespace CPlusPlusWilsonDslash;
 void
 testDslash3D::run(void) 
 {
+  setSiteISA(isa);
+  QDPIO::cout << "Site kernels: " << siteISAName(getSiteISA()) << std::endl;
 
   LatticeFermionF3 chi, chi2, psi;
   LatticeFermionD3 chid, chi2d, psid;
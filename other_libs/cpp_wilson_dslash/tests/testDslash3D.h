@@ -6,6 +6,15 @@
 #include "unittest.h"
 #endif
 
-class testDslash3D : public TestFixture { public: void run(void); };
+#include "cpp_dslash_cpu.h"
+
+/* Runs with the site kernels for the given instruction set */
+class testDslash3D : public TestFixture {
+public:
+  testDslash3D(CPlusPlusWilsonDslash::SiteISA isa_ = CPlusPlusWilsonDslash::SITE_ISA_GENERIC) : isa(isa_) {}
+  void run(void);
+private:
+  CPlusPlusWilsonDslash::SiteISA isa;
+};
 
 #endif
@@ -20,9 +20,59 @@ using namespace QDP;
 using namespace Assertions;
 using namespace CPlusPlusWilsonDslash;
 
+namespace {
+
+#ifdef CPP_DSLASH_SCALAR
+  /* Largest difference between the multi right hand side dslash and
+   * the single one, applied to each right hand side in turn */
+  template<typename FT, typename Spinor, typename Fermion, typename D, typename Gauge>
+  Double multiRHSDiff(D& dslash, Gauge* packed_gauge, int isign, int source_cb, int nrhs)
+  {
+    multi1d<Fermion> psis(nrhs), chis(nrhs);
+    for(int n=0; n < nrhs; n++) {
+      gaussian(psis[n]);
+      chis[n] = zero;
+    }
+
+    Spinor* psi_v = (Spinor *)QDP::Allocator::theQDPAllocator::Instance().allocate(
+      nrhs*Layout::sitesOnNode()*sizeof(Spinor), QDP::Allocator::DEFAULT);
+    Spinor* chi_v = (Spinor *)QDP::Allocator::theQDPAllocator::Instance().allocate(
+      nrhs*Layout::sitesOnNode()*sizeof(Spinor), QDP::Allocator::DEFAULT);
+
+    qdp_pack_spinors(psis, psi_v);
+    qdp_pack_spinors(chis, chi_v);
+
+    dslash((FT *)chi_v, (FT *)psi_v, (FT *)&(packed_gauge[0]), isign, source_cb, nrhs);
+    qdp_unpack_spinors(chi_v, chis);
+
+    Double diff_max = zero;
+    for(int n=0; n < nrhs; n++) {
+      Fermion chi = zero;
+      dslash((FT *)&(chi.elem(all.start()).elem(0).elem(0).real()),
+	     (FT *)&(psis[n].elem(all.start()).elem(0).elem(0).real()),
+	     (FT *)&(packed_gauge[0]),
+	     isign, source_cb);
+
+      Fermion diff = chis[n] - chi;
+      Double diff_norm = sqrt( norm2( diff, rb[1-source_cb] ) )
+	/ ( Real(4*3*2*Layout::vol()) / Real(2));
+      if( toBool( diff_norm > diff_max ) ) diff_max = diff_norm;
+    }
+
+    QDP::Allocator::theQDPAllocator::Instance().free(chi_v);
+    QDP::Allocator::theQDPAllocator::Instance().free(psi_v);
+
+    return diff_max;
+  }
+#endif
+
+}
+
 void
 testDslashFull::run(void) 
 {
+  setSiteISA(isa);
+  QDPIO::cout << "Site kernels: " << siteISAName(getSiteISA()) << std::endl;
 
   // If we have openmp then do this
 
@@ -96,6 +146,17 @@ testDslashFull::run(void)
 
     }
   }
+
+#ifdef CPP_DSLASH_SCALAR
+  // The multi right hand side dslash must agree with the single one
+  for(int isign=1; isign >= -1; isign -=2) {
+    for(int cb=0; cb < 2; cb++) { 
+      Double diff_norm = multiRHSDiff<float, PrimitiveSpinorF, LatticeFermionF>(D32, packed_gauge, isign, 1-cb, 3);
+      QDPIO::cout << "\t nrhs = 3  cb = " << 1-cb << "  isign = " << isign << "  diff_norm = " << diff_norm << std::endl;      
+      assertion( toBool( diff_norm < small32 ) );
+    }
+  }
+#endif
   QDP::Allocator::theQDPAllocator::Instance().free(packed_gauge);
 
   Dslash<double> D64(Layout::lattSize().slice(),
@@ -145,5 +206,16 @@ testDslashFull::run(void)
 
     }
    }
+
+#ifdef CPP_DSLASH_SCALAR
+   // The multi right hand side dslash must agree with the single one
+   for(int isign=1; isign >= -1; isign -=2) {
+     for(int cb=0; cb < 2; cb++) { 
+       Double diff_norm = multiRHSDiff<double, PrimitiveSpinorD, LatticeFermionD>(D64, packed_gauged, isign, 1-cb, 3);
+       QDPIO::cout << "\t nrhs = 3  cb = " << 1-cb << "  isign = " << isign << "  diff_norm = " << diff_norm << std::endl;      
+       assertion( toBool( diff_norm < small32 ) );
+     }
+   }
+#endif
    QDP::Allocator::theQDPAllocator::Instance().free(packed_gauged);
 }
@@ -0,0 +1,119 @@
+#include "unittest.h"
+#include "testSiteISA.h"
+
+#include "qdp.h"
+using namespace QDP;
+
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+using namespace Assertions;
+using namespace CPlusPlusWilsonDslash;
+
+namespace {
+
+  /* Kernels of one precision for one instruction set */
+  template<typename FT>
+  struct Kernels {
+    void (*decompHvv)(const FT*, const FT*, FT*);
+    void (*mvvRecons)(const FT*, const FT*, FT*);
+    void (*cloverApply)(const FT*, const FT*, FT*);
+  };
+
+  Kernels<float> kernels32(SiteISA isa)
+  {
+    Kernels<float> k = { SiteKernels::decompHvv32, SiteKernels::mvvRecons32, SiteKernels::cloverApply32 };
+#ifdef DSLASH_USE_AVX
+    if( isa == SITE_ISA_AVX2 ) {
+      k.decompHvv = SiteKernelsAVX2::decompHvv32;
+      k.mvvRecons = SiteKernelsAVX2::mvvRecons32;
+      k.cloverApply = SiteKernelsAVX2::cloverApply32;
+    }
+#endif
+    return k;
+  }
+
+  Kernels<double> kernels64(SiteISA isa)
+  {
+    Kernels<double> k = { SiteKernels::decompHvv64, SiteKernels::mvvRecons64, SiteKernels::cloverApply64 };
+#ifdef DSLASH_USE_AVX
+    if( isa == SITE_ISA_AVX2 ) {
+      k.decompHvv = SiteKernelsAVX2::decompHvv64;
+      k.mvvRecons = SiteKernelsAVX2::mvvRecons64;
+      k.cloverApply = SiteKernelsAVX2::cloverApply64;
+    }
+#endif
+    return k;
+  }
+
+  template<typename FT>
+  void fillRandom(FT* v, int n)
+  {
+    for(int i=0; i < n; i++) {
+      v[i] = (FT)(rand() - RAND_MAX/2)/(FT)(RAND_MAX/2);
+    }
+  }
+
+  /* Largest difference between a kernel and the generic one over some
+   * random sites, relative to the largest result */
+  template<typename FT>
+  double maxRelDiff(void (*kernel)(const FT*, const FT*, FT*),
+		    void (*generic)(const FT*, const FT*, FT*),
+		    int n_in, int n_u, int n_out)
+  {
+    FT in[48], u[2*(8+32)], res[96], ref[96];  // u: 4 links or a clover term
+    double diff = 0, scale = 0;
+
+    for(int site=0; site < 64; site++) {
+      fillRandom(in, n_in);
+      fillRandom(u, n_u);
+
+      (*generic)(in, u, ref);
+      (*kernel)(in, u, res);
+
+      for(int i=0; i < n_out; i++) {
+	diff = std::max(diff, (double)std::fabs(res[i] - ref[i]));
+	scale = std::max(scale, (double)std::fabs(ref[i]));
+      }
+    }
+
+    return diff / scale;
+  }
+
+  void check(const char* what, double diff, double small)
+  {
+    QDPIO::cout << std::endl << "\t " << what << ": max rel. diff = " << diff << std::endl;
+    assertion( diff < small );
+  }
+
+}
+
+void
+testDecompHvvISA::run(void)
+{
+  QDPIO::cout << "Site kernels: " << siteISAName(isa) << std::endl;
+
+  check("32 bit", maxRelDiff(kernels32(isa).decompHvv, kernels32(SITE_ISA_GENERIC).decompHvv, 24, 4*18, 96), 1.0e-6);
+  check("64 bit", maxRelDiff(kernels64(isa).decompHvv, kernels64(SITE_ISA_GENERIC).decompHvv, 24, 4*18, 96), 1.0e-14);
+}
+
+void
+testMvvReconsISA::run(void)
+{
+  QDPIO::cout << "Site kernels: " << siteISAName(isa) << std::endl;
+
+  check("32 bit", maxRelDiff(kernels32(isa).mvvRecons, kernels32(SITE_ISA_GENERIC).mvvRecons, 48, 4*18, 48), 1.0e-6);
+  check("64 bit", maxRelDiff(kernels64(isa).mvvRecons, kernels64(SITE_ISA_GENERIC).mvvRecons, 48, 4*18, 48), 1.0e-14);
+}
+
+void
+testCloverApplyISA::run(void)
+{
+  QDPIO::cout << "Site kernels: " << siteISAName(isa) << std::endl;
+
+  // Two blocks of 8 diagonal and 16 complex off diagonal numbers, all
+  // random: the padding is never read
+  check("32 bit", maxRelDiff(kernels32(isa).cloverApply, kernels32(SITE_ISA_GENERIC).cloverApply, 24, 2*(8+32), 24), 1.0e-6);
+  check("64 bit", maxRelDiff(kernels64(isa).cloverApply, kernels64(SITE_ISA_GENERIC).cloverApply, 24, 2*(8+32), 24), 1.0e-14);
+}
@@ -0,0 +1,62 @@
+#ifndef TEST_SITE_ISA
+#define TEST_SITE_ISA
+
+
+#ifndef UNITTEST_H
+#include "unittest.h"
+#endif
+
+#include "dslash_config.h"
+#include "cpp_dslash_cpu.h"
+
+/* The decomp_hvv and mvv_recons site kernels, the ones with the SU(3)
+ * matvec, and the clover site apply, built once per instruction set
+ * (see siteKernels32bit.cc). The first two apply every direction and
+ * sign to one site:
+ *
+ *   decompHvv: spinor[4*3*2], u[4 dirs][3*3*2] -> dst[plus,minus][4 dirs][3*2*2]
+ *   mvvRecons: hs[4 dirs][3*2*2], u[4 dirs][3*3*2] -> dst[plus,minus][4*3*2]
+ *   cloverApply: spinor[4*3*2], clov[2 blocks][8+16*2] -> dst[4*3*2]
+ *
+ * where mvvRecons sums the 4 directions as the dslash does */
+#define DECLARE_SITE_KERNELS(NS)					\
+  namespace NS {							\
+    void decompHvv32(const float* spinor, const float* u, float* dst);	\
+    void mvvRecons32(const float* hs, const float* u, float* dst);	\
+    void cloverApply32(const float* spinor, const float* clov, float* dst); \
+    void decompHvv64(const double* spinor, const double* u, double* dst); \
+    void mvvRecons64(const double* hs, const double* u, double* dst);	\
+    void cloverApply64(const double* spinor, const double* clov, double* dst); \
+  }
+
+DECLARE_SITE_KERNELS(SiteKernels)
+#ifdef DSLASH_USE_AVX
+DECLARE_SITE_KERNELS(SiteKernelsAVX2)
+#endif
+
+/* Compares the kernels for the given instruction set with the generic C ones */
+class testDecompHvvISA : public TestFixture {
+public:
+  testDecompHvvISA(CPlusPlusWilsonDslash::SiteISA isa_) : isa(isa_) {}
+  void run(void);
+private:
+  CPlusPlusWilsonDslash::SiteISA isa;
+};
+
+class testMvvReconsISA : public TestFixture {
+public:
+  testMvvReconsISA(CPlusPlusWilsonDslash::SiteISA isa_) : isa(isa_) {}
+  void run(void);
+private:
+  CPlusPlusWilsonDslash::SiteISA isa;
+};
+
+class testCloverApplyISA : public TestFixture {
+public:
+  testCloverApplyISA(CPlusPlusWilsonDslash::SiteISA isa_) : isa(isa_) {}
+  void run(void);
+private:
+  CPlusPlusWilsonDslash::SiteISA isa;
+};
+
+#endif
@@ -21,10 +21,116 @@ using namespace QDP;
 
 #include "cpp_dslash.h"
 #include "cpp_dslash_qdp_packer.h"
+#include "cpp_dslash_cpu.h"
+
+#ifdef DSLASH_USE_OMP_THREADS
+#include "dispatch_pool.h"
+#endif
 
 using namespace Assertions;
 using namespace CPlusPlusWilsonDslash;
 
+namespace {
+
+#ifdef CPP_DSLASH_SCALAR
+  /* GFLOP/s of the multi right hand side dslash as a function of the
+   * number of right hand sides. The work per call grows with nrhs so
+   * the number of calls shrinks to keep the total about fixed */
+  template<typename FT, typename Spinor, typename Fermion, typename D, typename Gauge>
+  void timeMultiRHS(D& dslash, Gauge* packed_gauge, const Fermion& psi, const char* prec)
+  {
+    const int nrhs_max = 8;
+    const int sites = Layout::sitesOnNode();
+
+    Spinor* psi_v = (Spinor *)QDP::Allocator::theQDPAllocator::Instance().allocate(
+      nrhs_max*sites*sizeof(Spinor), QDP::Allocator::DEFAULT);
+    Spinor* chi_v = (Spinor *)QDP::Allocator::theQDPAllocator::Instance().allocate(
+      nrhs_max*sites*sizeof(Spinor), QDP::Allocator::DEFAULT);
+
+    StopWatch swatch;
+
+    for(int nrhs=1; nrhs <= nrhs_max; nrhs *= 2) {
+      /* Every right hand side is a copy of psi, which does not matter for the timing */
+      for(int site=0; site < sites; site++) {
+	for(int n=0; n < nrhs; n++) {
+	  psi_v[n + nrhs*site] = psi.elem(site);
+	}
+      }
+
+      int n_iters = iters / nrhs;
+      if( n_iters < 1 ) n_iters = 1;
+
+      swatch.reset();
+      swatch.start();
+      for(int i=0; i < n_iters; ++i) {
+	dslash((FT *)chi_v, (FT *)psi_v, (FT *)&(packed_gauge[0]), 1, 0, nrhs);
+      }
+      swatch.stop();
+      double time=swatch.getTimeInSeconds();
+      QDPInternal::globalSum(time);
+      time /= (double)Layout::numNodes();
+
+      double Gflops = 1320.0*(double)nrhs*(double)(n_iters)*(double)(Layout::vol()/2)/1.0e9;
+      QDPIO::cout << "\t dslash " << prec << " nrhs=" << nrhs
+		  << ": " << Gflops/time << " GFLOP/s in Total, "
+		  << Gflops/time/(double)nrhs << " per right hand side" << std::endl;
+    }
+    QDPIO::cout << std::endl;
+
+    QDP::Allocator::theQDPAllocator::Instance().free(chi_v);
+    QDP::Allocator::theQDPAllocator::Instance().free(psi_v);
+  }
+#endif
+
+}
+
+#ifdef DSLASH_USE_OMP_THREADS
+namespace {
+
+  /* A dslash-shaped site kernel for the scheduler sweep:
+   * res = sum_mu U_mu psi, applied to all 4 spins. The real dslash is
+   * tied to the QDP layout so cannot be rerun at other volumes */
+  struct SweepArgs {
+    float* res;
+    const float* psi;
+    const float* u;
+  };
+
+  void sweepSites(size_t lo, size_t hi, int id, const void* ptr)
+  {
+    const SweepArgs* a = (const SweepArgs *)ptr;
+    for(size_t site=lo; site < hi; site++) {
+      float* r = a->res + 24*site;
+      const float* p = a->psi + 24*site;
+      for(int i=0; i < 24; i++) r[i] = 0;
+
+      for(int mu=0; mu < 4; mu++) {
+	const float* m = a->u + 18*(4*site+mu);
+	for(int spin=0; spin < 4; spin++) {
+	  for(int row=0; row < 3; row++) {
+	    float re=0, im=0;
+	    for(int col=0; col < 3; col++) {
+	      float mr = m[6*row+2*col], mi = m[6*row+2*col+1];
+	      float pr = p[6*spin+2*col], pi = p[6*spin+2*col+1];
+	      re += mr*pr - mi*pi;
+	      im += mr*pi + mi*pr;
+	    }
+	    r[6*spin+2*row] += re;
+	    r[6*spin+2*row+1] += im;
+	  }
+	}
+      }
+    }
+  }
+
+  const char* schedulerName(DispatchScheduler s)
+  {
+    return ( s == DISPATCH_POOL ) ? "pool" : "static";
+  }
+
+}
+#endif
+
 
 void
 timeDslash::run(void) 
@@ -117,6 +223,103 @@ timeDslash::run(void)
   QDPIO::cout << "\t Performance is: " << perf << " Mflops (sp) in Total" << std::endl;
   QDPIO::cout << "\t Performance is: " << perf / (double)Layout::numNodes() << " per MPI Process" << std::endl;
   QDPIO::cout << std::endl;
+
+#ifdef DSLASH_USE_OMP_THREADS
+  {
+    /* Compare the static OpenMP split with the work stealing pool:
+     * first the real dslash, then the site kernel over shrinking
+     * volumes where fork/join overhead and imbalance show up */
+    const DispatchScheduler orig_sched = getDispatchScheduler();
+    const DispatchScheduler scheds[2] = { DISPATCH_STATIC, DISPATCH_POOL };
+
+    QDPIO::cout << "\t Scheduler comparison, pool threads = " << dispatchPoolNumThreads() << std::endl;
+    for(int sc=0; sc < 2; sc++) {
+      setDispatchScheduler(scheds[sc]);
+
+      swatch.reset();
+      swatch.start();
+      for(int i=0; i < iters; ++i) {
+	D32( (float *)&(chi.elem(all.start()).elem(0).elem(0).real()),
+	     (float *)&(psi.elem(all.start()).elem(0).elem(0).real()),
+	     (float *)&(packed_gauge[0]),
+	     1, 0);
+      }
+      swatch.stop();
+      time=swatch.getTimeInSeconds();
+      QDPInternal::globalSum(time);
+      time /= (double)Layout::numNodes();
+
+      Mflops = 1320.0f*(double)(iters)*(double)(Layout::vol()/2)/1.0e6;
+      QDPIO::cout << "\t dslash sp " << schedulerName(scheds[sc]) 
+		  << ": " << Mflops/time << " Mflops in Total" << std::endl;
+    }
+
+    const int max_sites = Layout::sitesOnNode()/2;
+    SweepArgs sa;
+    sa.res = (float *)&(chi.elem(all.start()).elem(0).elem(0).real());
+    sa.psi = (const float *)&(psi.elem(all.start()).elem(0).elem(0).real());
+    sa.u = (const float *)&(packed_gauge[0]);
+
+    for(int n_sites = max_sites; n_sites >= 16; n_sites /= 4) {
+      /* Keep the total work roughly fixed */
+      int n_iters = iters * (max_sites / n_sites);
+
+      for(int sc=0; sc < 2; sc++) {
+	swatch.reset();
+	swatch.start();
+	for(int i=0; i < n_iters; ++i) {
+	  if( scheds[sc] == DISPATCH_POOL ) {
+	    dispatchPool(sweepSites, &sa, n_sites);
+	  }
+	  else {
+	    dispatchStatic(sweepSites, &sa, n_sites);
+	  }
+	}
+	swatch.stop();
+	time=swatch.getTimeInSeconds();
+
+	QDPIO::cout << "\t sites=" << n_sites << " " << schedulerName(scheds[sc])
+		    << ": " << 1.0e6*time/(double)n_iters << " u sec/call" << std::endl;
+      }
+    }
+    QDPIO::cout << std::endl;
+
+    setDispatchScheduler(orig_sched);
+  }
+#endif
+
+  {
+    /* The same dslash with each set of site kernels built in */
+    const SiteISA orig_isa = getSiteISA();
+    for(int isa=SITE_ISA_GENERIC; isa <= maxSiteISA(); isa++) {
+      setSiteISA((SiteISA)isa);
+
+      swatch.reset();
+      swatch.start();
+      for(int i=0; i < iters; ++i) {
+	D32( (float *)&(chi.elem(all.start()).elem(0).elem(0).real()),
+	     (float *)&(psi.elem(all.start()).elem(0).elem(0).real()),
+	     (float *)&(packed_gauge[0]),
+	     1, 0);
+      }
+      swatch.stop();
+      time=swatch.getTimeInSeconds();
+      QDPInternal::globalSum(time);
+      time /= (double)Layout::numNodes();
+
+      Mflops = 1320.0f*(double)(iters)*(double)(Layout::vol()/2)/1.0e6;
+      QDPIO::cout << "\t dslash sp " << siteISAName((SiteISA)isa)
+		  << ": " << Mflops/time << " Mflops in Total" << std::endl;
+    }
+    QDPIO::cout << std::endl;
+    setSiteISA(orig_isa);
+  }
+
+#ifdef CPP_DSLASH_SCALAR
+  /* The multi right hand side dslash */
+  timeMultiRHS<float, PrimitiveSpinorF>(D32, packed_gauge, psi, "sp");
+#endif
+
   QDP::Allocator::theQDPAllocator::Instance().free(packed_gauge);
   PrimitiveSU3MatrixD* packed_gauged =(PrimitiveSU3MatrixD *)QDP::Allocator::theQDPAllocator::Instance().allocate(
      		  	  	  	  	  	  	  	  	  	  	  4*Layout::sitesOnNode()*sizeof(PrimitiveSU3MatrixD), QDP::Allocator::DEFAULT);
@@ -148,5 +351,12 @@ timeDslash::run(void)
   perf = Mflops/time;
   QDPIO::cout << "\t Performance is: " << perf << " Mflops (dp) in Total" << std::endl;
   QDPIO::cout << "\t Performance is: " << perf / (double)Layout::numNodes() << " per MPI Process" << std::endl;
+  QDPIO::cout << std::endl;
+
+#ifdef CPP_DSLASH_SCALAR
+  /* The multi right hand side dslash */
+  timeMultiRHS<double, PrimitiveSpinorD>(D64, packed_gauged, psid, "dp");
+#endif
+
   QDP::Allocator::theQDPAllocator::Instance().free(packed_gauged);
 }